@@ -247,6 +247,28 @@ CpaStatus icp_adf_transPutMsg(icp_comms_trans_handle trans_handle,
                               Cpa32U bufLen,
                               Cpa64U *seq_num);
 
+/*
+ * icp_adf_transPutMsgs
+ *
+ * Description:
+ * Put a batch of messages onto the transport handle with a single tail
+ * update. The messages are put in order and the number put is returned
+ * in pNumPut. A ring takes all or none of them; a shared queue may take
+ * only the first ones.
+ * Note: Not all transports support method.
+ *
+ * Returns:
+ *   CPA_STATUS_SUCCESS   if at least one message was put
+ *   CPA_STATUS_RETRY     if the transport cannot take the batch
+ *   CPA_STATUS_FAIL      on failure
+ */
+CpaStatus icp_adf_transPutMsgs(icp_comms_trans_handle trans_handle,
+                               Cpa32U **inBufs,
+                               Cpa32U bufLen,
+                               Cpa32U numMsgs,
+                               Cpa64U *seq_nums,
+                               Cpa32U *pNumPut);
+
 /*
  * icp_adf_transPutMsgSync
  *
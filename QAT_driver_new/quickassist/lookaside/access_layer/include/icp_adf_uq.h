@@ -125,4 +125,14 @@ CpaStatus adf_uq_put_msg(adf_dev_ring_handle_t *ring);
  * Submit DP request via enqcmd
  */
 CpaStatus adf_uq_push_dp_msg(adf_dev_ring_handle_t *ring);
+
+/*
+ * adf_uq_push_single_desc
+ *
+ * Description
+ * Submit the nr_req requests written from the CSR tail offset, which must
+ * not wrap around the ring, as a single descriptor via enqcmd
+ */
+CpaStatus adf_uq_push_single_desc(adf_dev_ring_handle_t *ring,
+                                  uint32_t nr_req);
 #endif /* ICP_ADF_UQ_H */
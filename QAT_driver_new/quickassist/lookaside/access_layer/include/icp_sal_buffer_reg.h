@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file icp_sal_buffer_reg.h
+ *
+ * @description
+ *        This is the list of registered buffer list APIs. The firmware
+ *        descriptor of a registered buffer list is built once, physical
+ *        addresses included, and later requests on the same list only
+ *        patch the buffer lengths and translate the buffers whose address
+ *        changed. This suits applications that recycle their buffer
+ *        lists, such as buffer pools and rings.
+ *
+ ****************************************************************************/
+#ifndef ICP_SAL_BUFFER_REG_H
+#define ICP_SAL_BUFFER_REG_H
+
+#include "cpa.h"
+
+/*
+ ******************************************************************
+ * @ingroup SalUserBufferReg
+ *        Metadata size of a registered buffer list
+ *
+ * @description
+ *        This function returns the size of the pPrivateMetaData of a
+ *        buffer list registered with numBuffers buffers. It replaces
+ *        cpaCyBufferListGetMetaSize and cpaDcBufferListGetMetaSize for
+ *        the lists passed to icp_sal_BufferListRegister.
+ *
+ * @param[in]  instanceHandle Crypto or compression instance handle
+ * @param[in]  numBuffers     Number of buffers in the list
+ * @param[out] pSizeInBytes   Size of the metadata in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_FAIL            Wrong instance type
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_BufferListRegMetaSize(const CpaInstanceHandle instanceHandle,
+                                        Cpa32U numBuffers,
+                                        Cpa32U *pSizeInBytes);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserBufferReg
+ *        Register a buffer list
+ *
+ * @description
+ *        This function writes the firmware descriptor of the buffer list
+ *        into its metadata and marks the list as registered with the
+ *        instance. The metadata must be sized with
+ *        icp_sal_BufferListRegMetaSize and be 8 byte aligned physically.
+ *
+ *        The buffers of the list may change between requests; only the
+ *        buffers whose address changed are translated again. A list that
+ *        grows beyond the number of buffers it was registered with loses
+ *        its registration. Stopping the instance or changing its address
+ *        translation function drops the cached physical addresses, and a
+ *        list used with another instance is written from scratch, as is
+ *        an unregistered list.
+ *
+ * @param[in]  instanceHandle Crypto or compression instance handle
+ * @param[in]  pBufferList    Buffer list to register
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_FAIL            Wrong instance type or address
+ *                                    translation failed
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_BufferListRegister(const CpaInstanceHandle instanceHandle,
+                                     CpaBufferList *pBufferList);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserBufferReg
+ *        Unregister a buffer list
+ *
+ * @description
+ *        This function drops the registration of the buffer list. It
+ *        must be called before the metadata is freed or reused for
+ *        another list. Unregistering a list that is not registered has
+ *        no effect.
+ *
+ * @param[in]  pBufferList    Buffer list to unregister
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_BufferListUnregister(CpaBufferList *pBufferList);
+#endif
@@ -0,0 +1,223 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file icp_sal_dc_adaptive.h
+ *
+ * @description
+ *        This is the list of adaptive destination sizing APIs. Instead of
+ *        sizing every destination buffer for incompressible data, the
+ *        destination is sized from the running compression ratio of the
+ *        session and an overflow is recovered by compressing the
+ *        unconsumed remainder into a continuation buffer.
+ *
+ ****************************************************************************/
+#ifndef ICP_SAL_DC_ADAPTIVE_H
+#define ICP_SAL_DC_ADAPTIVE_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+
+/* Largest safety margin accepted by icp_sal_DcAdaptiveDestEnable */
+#define ICP_SAL_DC_ADAPTIVE_MAX_MARGIN_PERCENT (400)
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcAdaptive
+ *        Adaptive destination sizing statistics of a session
+ *
+ * @description
+ *        Requests and overflows are counted for every compression
+ *        request of the session; pinned memory only covers the buffers
+ *        allocated by icp_sal_DcAdaptiveCompressData.
+ *
+ ******************************************************************
+ */
+typedef struct icp_sal_dc_adaptive_stats_s
+{
+    Cpa64U numRequests;
+    /**< Compression requests completed */
+    Cpa64U numOverflows;
+    /**< Compression requests that completed with CPA_DC_OVERFLOW */
+    Cpa64U numContinuations;
+    /**< Continuation requests submitted to recover from an overflow */
+    Cpa64U pinnedBytes;
+    /**< Pinned memory currently held by adaptive destinations */
+    Cpa64U peakPinnedBytes;
+    /**< High water mark of pinnedBytes */
+    Cpa32U ratioPercent;
+    /**< Current predicted ratio of produced to consumed bytes, in
+     * percent. Zero until the first request completes */
+} icp_sal_dc_adaptive_stats_t;
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcAdaptive
+ *        Enable adaptive destination sizing on a session
+ *
+ * @description
+ *        This function opts a compression session in for adaptive
+ *        destination sizing. From then on every completed compression
+ *        request updates the running ratio of the session. It may be
+ *        called again to change the margin; the ratio is kept.
+ *
+ * @param[in]  pSessionHandle Compression session handle
+ * @param[in]  marginPercent  Safety margin, in percent, added on top
+ *                            of the predicted size
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcAdaptiveDestEnable(CpaDcSessionHandle pSessionHandle,
+                                       Cpa32U marginPercent);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcAdaptive
+ *        Predicted destination size
+ *
+ * @description
+ *        This function returns the destination size to allocate for
+ *        compressing inputSize bytes on the session: the running ratio
+ *        plus the safety margin, never less than the minimum
+ *        destination size of the device and never more than the worst
+ *        case bound of the compression type. The worst case bound is
+ *        returned until adaptive sizing is enabled and a first request
+ *        has completed.
+ *
+ *        A destination sized this way can overflow. Asynchronous
+ *        applications have to handle CPA_DC_OVERFLOW themselves by
+ *        resubmitting the unconsumed data.
+ *
+ * @param[in]  dcInstance     Instance handle
+ * @param[in]  pSessionHandle Compression session handle
+ * @param[in]  inputSize      Size of the source data in bytes
+ * @param[out] pOutputSize    Destination size to allocate in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_UNSUPPORTED     Unsupported compression type
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcAdaptiveDestBound(CpaInstanceHandle dcInstance,
+                                      CpaDcSessionHandle pSessionHandle,
+                                      Cpa32U inputSize,
+                                      Cpa32U *pOutputSize);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcAdaptive
+ *        Compress into an adaptively sized destination
+ *
+ * @description
+ *        This function allocates a destination of the predicted size,
+ *        compresses the source data into it and, on CPA_DC_OVERFLOW,
+ *        compresses the unconsumed remainder into a continuation buffer
+ *        sized for the worst case of the remainder. The session must be
+ *        a synchronous, stateless deflate compression session with
+ *        adaptive sizing enabled.
+ *
+ *        On success *ppDestBuff holds one flat buffer per request, in
+ *        order, each dataLenInBytes being the bytes produced into it.
+ *        The checksum is carried across the requests, so pResults holds
+ *        the totals and the checksum of the whole source. The list must
+ *        be released with icp_sal_DcAdaptiveFreeDest.
+ *
+ *        If a request completes with an error other than an overflow,
+ *        pResults->status reports it, CPA_STATUS_FAIL is returned and no
+ *        list is allocated.
+ *
+ * @param[in]  dcInstance     Instance handle
+ * @param[in]  pSessionHandle Compression session handle
+ * @param[in]  pSrcBuff       Source data
+ * @param[out] ppDestBuff     Allocated destination buffer list
+ * @param[in,out] pResults    Results of the operation, checksum being
+ *                            the seed as for cpaDcCompressData
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE        Error allocating memory
+ * @retval CPA_STATUS_FAIL            Operation failed
+ * @retval CPA_STATUS_RETRY           Resubmit the request
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcAdaptiveCompressData(CpaInstanceHandle dcInstance,
+                                         CpaDcSessionHandle pSessionHandle,
+                                         CpaBufferList *pSrcBuff,
+                                         CpaBufferList **ppDestBuff,
+                                         CpaDcRqResults *pResults);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcAdaptive
+ *        Release an adaptive destination
+ *
+ * @description
+ *        This function frees a destination buffer list returned by
+ *        icp_sal_DcAdaptiveCompressData and releases its pinned memory
+ *        from the session accounting.
+ *
+ * @param[in]  pSessionHandle Session the destination was allocated on
+ * @param[in]  pDestBuff      Destination buffer list
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcAdaptiveFreeDest(CpaDcSessionHandle pSessionHandle,
+                                     CpaBufferList *pDestBuff);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcAdaptive
+ *        Query adaptive destination sizing statistics
+ *
+ * @param[in]  pSessionHandle Compression session handle
+ * @param[out] pStats         Statistics of the session
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcAdaptiveDestQueryStats(CpaDcSessionHandle pSessionHandle,
+                                           icp_sal_dc_adaptive_stats_t *pStats);
+#endif
@@ -0,0 +1,178 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file icp_sal_dc_chain.h
+ *
+ * @description
+ *        This is the list of compression chaining throughput APIs. They
+ *        let an application keep many chained requests in flight by
+ *        putting a group of requests on the ring with a single tail
+ *        update, and report where the time of a chained request is spent.
+ *
+ ****************************************************************************/
+#ifndef ICP_SAL_DC_CHAIN_H
+#define ICP_SAL_DC_CHAIN_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "cpa_dc_chain.h"
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcChain
+ *        Chaining request of a batch
+ *
+ * @description
+ *        This structure describes one request of a batch submitted
+ *        with icp_sal_DcChainPerformOpBatch. The fields have the same
+ *        meaning as the cpaDcChainPerformOp parameters of the same name.
+ *
+ ******************************************************************
+ */
+typedef struct icp_sal_dc_chain_batch_op_s
+{
+    CpaBufferList *pSrcBuff;
+    /**< Source buffer list */
+    CpaBufferList *pDestBuff;
+    /**< Destination buffer list */
+    CpaDcChainOpData *pChainOpData;
+    /**< Array of numOpDatas chaining operation data structures */
+    CpaDcChainRqResults *pResults;
+    /**< Results of the request */
+    void *callbackTag;
+    /**< Opaque data passed back to the session callback */
+} icp_sal_dc_chain_batch_op_t;
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcChain
+ *        Chaining statistics
+ *
+ * @description
+ *        Per-stage counters of the chaining service of an instance.
+ *        Cycle counts are timestamp counter cycles summed over all the
+ *        requests; divide them by numRequests or numCompleted to get
+ *        the average cost of a stage.
+ *
+ ******************************************************************
+ */
+typedef struct icp_sal_dc_chain_stats_s
+{
+    Cpa64U numRequests;
+    /**< Requests put on the ring */
+    Cpa64U numSubmits;
+    /**< Ring tail updates used to put the requests */
+    Cpa64U numRetries;
+    /**< Submissions rejected because the ring was full */
+    Cpa64U numCompleted;
+    /**< Responses processed */
+    Cpa64U buildCycles;
+    /**< Cycles spent building request descriptors */
+    Cpa64U submitCycles;
+    /**< Cycles spent putting requests on the ring */
+    Cpa64U deviceCycles;
+    /**< Cycles between ring submission and response processing */
+    Cpa64U completeCycles;
+    /**< Cycles spent processing responses, client callback included */
+} icp_sal_dc_chain_stats_t;
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcChain
+ *        Submit a batch of chaining requests
+ *
+ * @description
+ *        This function builds numRequests chaining requests of the same
+ *        session and operation and puts them on the ring in groups, each
+ *        group with a single tail update. The session must have been
+ *        initialised with a callback; every request that is submitted
+ *        completes through it with its own callbackTag.
+ *
+ *        Submission stops at the first request that cannot be built or
+ *        put on the ring. The requests before it are in flight and
+ *        pNumSubmitted reports how many; the caller resubmits the rest.
+ *
+ * @param[in]  dcInstance     Instance handle
+ * @param[in]  pSessionHandle Chaining session handle
+ * @param[in]  operation      Chaining operation
+ * @param[in]  numOpDatas     Number of entries in each pChainOpData array
+ * @param[in]  numRequests    Number of entries in pBatchOpData
+ * @param[in]  pBatchOpData   Array of requests to submit
+ * @param[out] pNumSubmitted  Number of requests put on the ring
+ *
+ * @retval CPA_STATUS_SUCCESS         At least one request was submitted
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE        Error allocating memory
+ * @retval CPA_STATUS_RETRY           No request could be submitted,
+ *                                    resubmit the batch
+ * @retval CPA_STATUS_FAIL            Operation failed
+ * @retval CPA_STATUS_UNSUPPORTED     Chaining is not supported
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcChainPerformOpBatch(
+    CpaInstanceHandle dcInstance,
+    CpaDcSessionHandle pSessionHandle,
+    CpaDcChainOperations operation,
+    Cpa8U numOpDatas,
+    Cpa32U numRequests,
+    icp_sal_dc_chain_batch_op_t *pBatchOpData,
+    Cpa32U *pNumSubmitted);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcChain
+ *        Get chaining statistics
+ *
+ * @description
+ *        This function returns the per-stage counters of the chaining
+ *        service of the instance. The counters are only maintained
+ *        when compression statistics are enabled in the configuration.
+ *
+ * @param[in]  dcInstance     Instance handle
+ * @param[out] pStats         Chaining statistics
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE        Compression statistics are disabled
+ * @retval CPA_STATUS_UNSUPPORTED     Chaining is not supported
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcChainGetStats(CpaInstanceHandle dcInstance,
+                                  icp_sal_dc_chain_stats_t *pStats);
+#endif
@@ -0,0 +1,148 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file icp_sal_dc_zstd.h
+ *
+ * @description
+ *        This is the list of zstd compression APIs. The accelerator finds
+ *        the matches and produces LZ4s; these functions re-encode the LZ4s
+ *        sequences into standard zstd frames on the CPU.
+ *
+ ****************************************************************************/
+#ifndef ICP_SAL_DC_ZSTD_H
+#define ICP_SAL_DC_ZSTD_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcZstd
+ *        zstd compression bound
+ *
+ * @description
+ *        This function returns the maximum size of the zstd frame
+ *        produced for inputSize bytes of data. It covers the case where
+ *        every block of the frame has to be stored uncompressed.
+ *
+ * @param[in]  inputSize      Size of the uncompressed data in bytes
+ * @param[out] pOutputSize    Maximum size of the zstd frame in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcZstdCompressBound(Cpa32U inputSize, Cpa32U *pOutputSize);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcZstd
+ *        Convert LZ4s output into a zstd frame
+ *
+ * @description
+ *        This function parses the LZ4s sequences produced by a
+ *        CPA_DC_LZ4S compression of srcLen bytes of data and encodes
+ *        them into a single zstd frame. Literals are Huffman coded and
+ *        sequences use the predefined or block specific FSE tables. A
+ *        block that does not shrink is stored uncompressed, which is why
+ *        the source data of the compression is also required.
+ *
+ * @param[in]  pLz4sBuff      LZ4s data, dataLenInBytes being the number
+ *                            of bytes produced by the compression
+ * @param[in]  minMatch       Min match the LZ4s data was produced with
+ * @param[in]  pSrcBuff       Source data of the compression
+ * @param[in]  srcLen         Number of bytes consumed by the compression
+ * @param[in]  pDestBuff      Destination of the zstd frame
+ * @param[out] pProduced      Size of the zstd frame in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in or the
+ *                                    LZ4s data is malformed
+ * @retval CPA_STATUS_RESOURCE        Error allocating memory
+ * @retval CPA_STATUS_FAIL            The destination buffer is too small,
+ *                                    see icp_sal_DcZstdCompressBound
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcLZ4SToZstd(const CpaFlatBuffer *pLz4sBuff,
+                               CpaDcCompMinMatch minMatch,
+                               const CpaBufferList *pSrcBuff,
+                               Cpa32U srcLen,
+                               CpaFlatBuffer *pDestBuff,
+                               Cpa32U *pProduced);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserDcZstd
+ *        Compress data into a zstd frame
+ *
+ * @description
+ *        This function compresses the source data with the accelerator
+ *        into the intermediate buffer list and converts the resulting
+ *        LZ4s into a zstd frame in the destination buffer. The session
+ *        must be a synchronous, stateless CPA_DC_LZ4S compression
+ *        session. The intermediate list must hold a single flat buffer
+ *        sized with cpaDcLZ4SCompressBound and the destination buffer
+ *        must be sized with icp_sal_DcZstdCompressBound.
+ *
+ *        On success pResults->produced holds the size of the zstd frame.
+ *        If the compression itself does not complete, pResults->status
+ *        reports the error and no frame is produced.
+ *
+ * @param[in]  dcInstance     Instance handle
+ * @param[in]  pSessionHandle LZ4s session handle
+ * @param[in]  pSrcBuff       Source data
+ * @param[in]  pLz4sBuff      Intermediate buffer list for the LZ4s data
+ * @param[in]  pDestBuff      Destination of the zstd frame
+ * @param[out] pResults       Results of the operation
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE        Error allocating memory
+ * @retval CPA_STATUS_FAIL            Operation failed
+ * @retval CPA_STATUS_RETRY           Resubmit the request
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_DcZstdCompressData(CpaInstanceHandle dcInstance,
+                                     CpaDcSessionHandle pSessionHandle,
+                                     CpaBufferList *pSrcBuff,
+                                     CpaBufferList *pLz4sBuff,
+                                     CpaFlatBuffer *pDestBuff,
+                                     CpaDcRqResults *pResults);
+#endif
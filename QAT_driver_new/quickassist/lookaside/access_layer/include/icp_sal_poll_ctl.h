@@ -0,0 +1,148 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file icp_sal_poll_ctl.h
+ *
+ * @description
+ *        This is the list of adaptive poll interval APIs. A poll controller
+ *        picks the time to wait before the next poll of an instance from
+ *        the rate at which responses have been arriving on it and the
+ *        latency the application is willing to add to each response. It
+ *        does not poll by itself: the caller reports how many responses
+ *        every poll returned and sleeps, or keeps submitting, for the
+ *        period it is given back. The controller uses no memory of its
+ *        own and may be used in user and kernel space.
+ *
+ ****************************************************************************/
+#ifndef ICP_SAL_POLL_CTL_H
+#define ICP_SAL_POLL_CTL_H
+
+#include "cpa.h"
+
+#define ICP_SAL_POLL_CTL_DEFAULT_MIN_PERIOD_NS (1000)
+#define ICP_SAL_POLL_CTL_DEFAULT_MAX_PERIOD_NS (1000000)
+#define ICP_SAL_POLL_CTL_DEFAULT_MAX_BATCH (32)
+
+/*
+ ******************************************************************
+ * @ingroup SalPollCtl
+ *        Poll controller
+ *
+ * @description
+ *        The first fields are set by icp_sal_PollCtlInit, the statistics
+ *        may be read at any time and the rest is private to the
+ *        controller. A response waits on the ring for half a period on
+ *        average, so the period is kept below twice the target latency.
+ *        When responses arrive fast enough for more than maxBatch of
+ *        them to pile up in that time, the period is shortened to keep
+ *        the batches, and the ring occupancy, at maxBatch. Once the
+ *        instance stops returning responses the period doubles with
+ *        every empty poll, up to maxPeriodNs.
+ *
+ ******************************************************************
+ */
+typedef struct icp_sal_poll_ctl_s
+{
+    Cpa64U targetLatencyNs;
+    /**< Mean time a response may wait to be polled */
+    Cpa64U minPeriodNs;
+    Cpa64U maxPeriodNs;
+    Cpa32U maxBatch;
+    /**< Responses allowed to accumulate between two polls */
+    Cpa64U polls;
+    Cpa64U emptyPolls;
+    Cpa64U responses;
+    Cpa64U periodNs;
+    /**< Period returned by the last update */
+    Cpa64U gapNs;
+    /**< Smoothed time between two responses, 0 before the first one */
+    Cpa64U idleNs;
+    /**< Time since the last poll that returned responses */
+    Cpa64U lastPollNs;
+} icp_sal_poll_ctl_t;
+
+/*
+ ******************************************************************
+ * @ingroup SalPollCtl
+ *        Initialise a poll controller
+ *
+ * @description
+ *        The first period is minPeriodNs, so that the controller learns
+ *        the arrival rate quickly.
+ *
+ * @param[out] pCtl             Controller, owned by the caller
+ * @param[in]  targetLatencyNs  Mean time a response may wait, non zero
+ * @param[in]  minPeriodNs      Shortest period, 0 for the default
+ * @param[in]  maxPeriodNs      Longest period, 0 for the default
+ * @param[in]  maxBatch         Responses allowed between two polls, 0
+ *                              for the default
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_PollCtlInit(icp_sal_poll_ctl_t *pCtl,
+                              Cpa64U targetLatencyNs,
+                              Cpa64U minPeriodNs,
+                              Cpa64U maxPeriodNs,
+                              Cpa32U maxBatch);
+
+/*
+ ******************************************************************
+ * @ingroup SalPollCtl
+ *        Report a poll and get the next poll period
+ *
+ * @description
+ *        Called after every poll of the instance. A caller that cannot
+ *        count the responses passes 1 for a poll that found some; the
+ *        controller then overestimates the time between responses and
+ *        relies on the latency bound alone. The function is not thread
+ *        safe, each controller must be updated by one thread at a time.
+ *
+ * @param[in,out] pCtl       Controller
+ * @param[in]     responses  Responses returned by the poll
+ * @param[in]     nowNs      Time of the poll on a monotonic clock
+ *
+ * @retval Time to wait before the next poll, in nanoseconds
+ *
+ ******************************************************************
+ */
+Cpa64U icp_sal_PollCtlUpdate(icp_sal_poll_ctl_t *pCtl,
+                             Cpa32U responses,
+                             Cpa64U nowNs);
+#endif
@@ -0,0 +1,269 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file icp_sal_reactor.h
+ *
+ * @description
+ *        This is the list of completion reactor APIs. A reactor owns a
+ *        few threads which poll the instances registered with it and run
+ *        their callbacks. An instance that keeps completing requests is
+ *        busy polled; once it has been idle for a while its file
+ *        descriptor is armed and its thread sleeps in epoll until the
+ *        device raises an interrupt or the application notifies it.
+ *        Instances in poll mode have no file descriptor and are polled
+ *        periodically instead while idle.
+ *
+ ****************************************************************************/
+#ifndef ICP_SAL_REACTOR_H
+#define ICP_SAL_REACTOR_H
+
+#include "cpa.h"
+
+#define ICP_SAL_REACTOR_MAX_THREADS (64)
+#define ICP_SAL_REACTOR_DEFAULT_BUSY_POLL_US (50)
+#define ICP_SAL_REACTOR_DEFAULT_IDLE_POLL_US (1000)
+/* Latency histograms have a bucket per power of 2 nanoseconds */
+#define ICP_SAL_REACTOR_LATENCY_BUCKETS (32)
+
+typedef void *icp_sal_reactor_handle_t;
+typedef void *icp_sal_reactor_entry_t;
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Reactor configuration
+ *
+ * @description
+ *        A busyPollUs of 0 arms the file descriptor as soon as a poll
+ *        finds no response.
+ *
+ ******************************************************************
+ */
+typedef struct icp_sal_reactor_config_s
+{
+    Cpa32U numThreads;
+    /**< Reactor threads, 1 to ICP_SAL_REACTOR_MAX_THREADS */
+    Cpa32U busyPollUs;
+    /**< Time an instance keeps being polled after its last response */
+    Cpa32U idlePollUs;
+    /**< Poll period of idle instances that have no file descriptor */
+    Cpa32U responseQuota;
+    /**< Responses per poll, 0 for all */
+    Cpa32S firstCore;
+    /**< Thread i runs on core firstCore + i, -1 to leave them unbound */
+} icp_sal_reactor_config_t;
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Reactor statistics, summed over its threads
+ *
+ * @description
+ *        Latencies are only known for the requests the application
+ *        reported with icp_sal_ReactorNotify: the wake latency runs from
+ *        the notification to the thread polling a sleeping instance, the
+ *        completion latency from the notification to the first poll
+ *        that found responses on the instance. Bucket i of a histogram
+ *        counts the latencies from 2^i to 2^(i+1) - 1 nanoseconds.
+ *
+ ******************************************************************
+ */
+typedef struct icp_sal_reactor_stats_s
+{
+    Cpa64U polls;
+    /**< Polls of the instances */
+    Cpa64U emptyPolls;
+    /**< Polls that found no response */
+    Cpa64U sleeps;
+    /**< Times a thread blocked in epoll_wait */
+    Cpa64U irqWakeups;
+    /**< Instances woken by their file descriptor */
+    Cpa64U notifyWakeups;
+    /**< Instances woken by icp_sal_ReactorNotify */
+    Cpa64U timerWakeups;
+    /**< Idle polls of instances without file descriptor */
+    Cpa64U armed;
+    /**< Transitions from busy polling to sleeping */
+    Cpa64U wakeLatencyCount;
+    Cpa64U wakeLatencyTotalNs;
+    Cpa64U wakeLatencyMaxNs;
+    Cpa64U wakeLatencyHist[ICP_SAL_REACTOR_LATENCY_BUCKETS];
+    Cpa64U complLatencyCount;
+    Cpa64U complLatencyTotalNs;
+    Cpa64U complLatencyMaxNs;
+    Cpa64U complLatencyHist[ICP_SAL_REACTOR_LATENCY_BUCKETS];
+    Cpa64U cpuNs;
+    /**< CPU time used by the reactor threads */
+    Cpa64U wallNs;
+    /**< Time since the reactor was created, times its threads */
+    Cpa32U numInstances;
+    Cpa32U numArmed;
+    /**< Instances currently sleeping */
+} icp_sal_reactor_stats_t;
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Create a reactor
+ *
+ * @description
+ *        This function starts the reactor threads. Each thread owns an
+ *        epoll set.
+ *
+ * @param[in]  pConfig   Configuration, NULL for one thread and the
+ *                       default poll intervals
+ * @param[out] pReactor  Reactor handle
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE        Error allocating memory, threads or
+ *                                    file descriptors
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_ReactorCreate(const icp_sal_reactor_config_t *pConfig,
+                                icp_sal_reactor_handle_t *pReactor);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Destroy a reactor
+ *
+ * @description
+ *        This function stops the reactor threads and unregisters the
+ *        instances still registered. Requests still in flight complete
+ *        when the application polls the instances itself.
+ *
+ * @param[in]  reactor   Reactor handle
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_ReactorDestroy(icp_sal_reactor_handle_t reactor);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Hand an instance over to a reactor
+ *
+ * @description
+ *        From then on the reactor polls the instance and runs its
+ *        callbacks; the application must not poll it. Instances in
+ *        epoll mode are put on the thread that already watches their
+ *        file descriptor if any, other instances on the thread with the
+ *        fewest instances. Must not be called from a callback.
+ *
+ * @param[in]  reactor   Reactor handle
+ * @param[in]  instance  Started compression or crypto instance
+ * @param[out] pEntry    Entry for icp_sal_ReactorNotify and
+ *                       icp_sal_ReactorUnregister
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE        Error allocating memory
+ * @retval CPA_STATUS_FAIL            The file descriptor could not be
+ *                                    added to the epoll set
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_ReactorRegister(icp_sal_reactor_handle_t reactor,
+                                  CpaInstanceHandle instance,
+                                  icp_sal_reactor_entry_t *pEntry);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Take an instance back from a reactor
+ *
+ * @description
+ *        Once this function returns the reactor no longer polls the
+ *        instance and the entry is freed. Must not be called from a
+ *        callback. The application must not call icp_sal_ReactorNotify
+ *        on the entry once it has called this function; the calls still
+ *        running at that point are waited for.
+ *
+ * @param[in]  reactor   Reactor handle
+ * @param[in]  entry     Entry returned by icp_sal_ReactorRegister
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_ReactorUnregister(icp_sal_reactor_handle_t reactor,
+                                    icp_sal_reactor_entry_t entry);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Report a submission to a reactor
+ *
+ * @description
+ *        Optional. Called after submitting requests to the instance, it
+ *        wakes a sleeping instance at once instead of waiting for the
+ *        interrupt, and timestamps the submission for the latency
+ *        statistics. It may be called from any thread, including a
+ *        callback, but not once icp_sal_ReactorUnregister or
+ *        icp_sal_ReactorDestroy has been called for the entry.
+ *
+ * @param[in]  entry     Entry returned by icp_sal_ReactorRegister
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_ReactorNotify(icp_sal_reactor_entry_t entry);
+
+/*
+ ******************************************************************
+ * @ingroup SalUserReactor
+ *        Query reactor statistics
+ *
+ * @param[in]  reactor   Reactor handle
+ * @param[out] pStats    Statistics summed over the reactor threads
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ ******************************************************************
+ */
+CpaStatus icp_sal_ReactorQueryStats(icp_sal_reactor_handle_t reactor,
+                                    icp_sal_reactor_stats_t *pStats);
+#endif
@@ -0,0 +1,608 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file dc_adaptive_dest.c
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Adaptive destination sizing. Destinations are sized from the running
+ *      compression ratio of the session instead of the incompressible worst
+ *      case, which keeps pinned memory proportional to the data actually
+ *      produced. Overflows are recovered by compressing the unconsumed
+ *      remainder into a continuation buffer.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_dc_adaptive.h"
+
+#include "dc_session.h"
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_sync.h"
+#include "sal_types_compression.h"
+
+/* Requests a destination may be split into: the predicted one and a
+ * continuation sized for the worst case of the remainder, which cannot
+ * overflow */
+#define DC_ADAPTIVE_DEST_MAX_SEGMENTS (2)
+/* Room for block headers and the end of block code of small requests */
+#define DC_ADAPTIVE_DEST_EXTRA_BYTES (64)
+/* A sample above the running ratio moves it halfway, one below only by a
+ * sixteenth: a run of less compressible data must not keep overflowing
+ * while a run of more compressible data can be trusted slowly */
+#define DC_ADAPTIVE_DEST_RISE_SHIFT (1)
+#define DC_ADAPTIVE_DEST_RISE_ROUND ((1 << DC_ADAPTIVE_DEST_RISE_SHIFT) - 1)
+#define DC_ADAPTIVE_DEST_DECAY_SHIFT (4)
+/* Samples are clamped so that a tiny stored request cannot blow up the
+ * ratio */
+#define DC_ADAPTIVE_DEST_MAX_SAMPLE (2 * DC_ADAPTIVE_DEST_RATIO_ONE)
+
+/* Destination handed to the application by icp_sal_DcAdaptiveCompressData */
+typedef struct dc_adaptive_dest_buff_s
+{
+    CpaBufferList bufferList;
+    /**< Buffer list returned to the application, must be the first member */
+    CpaFlatBuffer flatBuffers[DC_ADAPTIVE_DEST_MAX_SEGMENTS];
+    /**< One flat buffer per request */
+    Cpa64U pinnedBytes;
+    /**< Pinned memory held by the flat buffers and the metadata */
+} dc_adaptive_dest_buff_t;
+
+void dcAdaptiveDestUpdate(dc_session_desc_t *pSessionDesc,
+                          const CpaDcRqResults *pResults)
+{
+    dc_adaptive_dest_t *pAdaptive = &pSessionDesc->adaptiveDest;
+    Cpa64U sample = 0;
+    Cpa32U ratio = 0;
+
+    osalAtomicInc(&pAdaptive->numRequests);
+    if (CPA_DC_OVERFLOW == pResults->status)
+    {
+        osalAtomicInc(&pAdaptive->numOverflows);
+    }
+
+    if (0 == pResults->consumed)
+    {
+        return;
+    }
+
+    sample = ((Cpa64U)pResults->produced * DC_ADAPTIVE_DEST_RATIO_ONE) /
+             pResults->consumed;
+    if (sample > DC_ADAPTIVE_DEST_MAX_SAMPLE)
+    {
+        sample = DC_ADAPTIVE_DEST_MAX_SAMPLE;
+    }
+
+    /* Completions of concurrent requests may race on the ratio. It is only
+     * a prediction: a lost update delays convergence, nothing more */
+    ratio = pAdaptive->ratio;
+    if (0 == ratio)
+    {
+        ratio = (Cpa32U)sample;
+    }
+    else if (sample > ratio)
+    {
+        /* Rounded up so that the ratio always reaches the sample */
+        ratio += ((Cpa32U)sample - ratio + DC_ADAPTIVE_DEST_RISE_ROUND) >>
+                 DC_ADAPTIVE_DEST_RISE_SHIFT;
+    }
+    else
+    {
+        ratio -= (ratio - (Cpa32U)sample) >> DC_ADAPTIVE_DEST_DECAY_SHIFT;
+    }
+    pAdaptive->ratio = ratio;
+}
+
+STATIC void dcAdaptiveDestPin(dc_adaptive_dest_t *pAdaptive, Cpa64U bytes)
+{
+    INT64 pinned = osalAtomicAdd((INT64)bytes, &pAdaptive->pinnedBytes);
+    INT64 previous = 0;
+
+    /* Raise the high water mark without a compare and swap: swap in our
+     * value and put back the previous one if it was higher */
+    while (pinned > osalAtomicGet(&pAdaptive->peakPinnedBytes))
+    {
+        previous = osalAtomicTestAndSet(pinned, &pAdaptive->peakPinnedBytes);
+        if (previous <= pinned)
+        {
+            break;
+        }
+        pinned = previous;
+    }
+}
+
+STATIC void dcAdaptiveDestUnpin(dc_adaptive_dest_t *pAdaptive, Cpa64U bytes)
+{
+    osalAtomicSub((INT64)bytes, &pAdaptive->pinnedBytes);
+}
+
+STATIC CpaStatus dcAdaptiveDestWorstCase(CpaInstanceHandle dcInstance,
+                                         const dc_session_desc_t *pSessionDesc,
+                                         Cpa32U inputSize,
+                                         Cpa32U *pOutputSize)
+{
+    switch (pSessionDesc->compType)
+    {
+        case CPA_DC_DEFLATE:
+            return cpaDcDeflateCompressBound(
+                dcInstance, pSessionDesc->huffType, inputSize, pOutputSize);
+        case CPA_DC_LZ4:
+            return cpaDcLZ4CompressBound(dcInstance, inputSize, pOutputSize);
+        case CPA_DC_LZ4S:
+            return cpaDcLZ4SCompressBound(dcInstance, inputSize, pOutputSize);
+        default:
+            LAC_INVALID_PARAM_LOG("Unsupported compression type");
+            return CPA_STATUS_UNSUPPORTED;
+    }
+}
+
+CpaStatus icp_sal_DcAdaptiveDestEnable(CpaDcSessionHandle pSessionHandle,
+                                       Cpa32U marginPercent)
+{
+    dc_session_desc_t *pSessionDesc = NULL;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+#endif
+
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+#endif
+
+    if (CPA_DC_DIR_DECOMPRESS == pSessionDesc->sessDirection)
+    {
+        LAC_INVALID_PARAM_LOG("Adaptive sizing requires a compression "
+                              "session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (marginPercent > ICP_SAL_DC_ADAPTIVE_MAX_MARGIN_PERCENT)
+    {
+        LAC_INVALID_PARAM_LOG1("The margin needs to be less than or equal to "
+                               "%d percent",
+                               ICP_SAL_DC_ADAPTIVE_MAX_MARGIN_PERCENT);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    pSessionDesc->adaptiveDest.marginPercent = marginPercent;
+    pSessionDesc->adaptiveDest.enabled = CPA_TRUE;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcAdaptiveDestBound(CpaInstanceHandle dcInstance,
+                                      CpaDcSessionHandle pSessionHandle,
+                                      Cpa32U inputSize,
+                                      Cpa32U *pOutputSize)
+{
+    sal_compression_service_t *pService = NULL;
+    CpaInstanceHandle insHandle = NULL;
+    dc_session_desc_t *pSessionDesc = NULL;
+    Cpa64U predicted = 0;
+    Cpa32U worstCase = 0;
+    Cpa32U minSize = 0;
+    Cpa32U ratio = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(insHandle);
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pOutputSize);
+    /* Ensure this is a compression instance */
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+#endif
+
+    pService = (sal_compression_service_t *)insHandle;
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+#endif
+
+    status = dcAdaptiveDestWorstCase(
+        insHandle, pSessionDesc, inputSize, &worstCase);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    ratio = pSessionDesc->adaptiveDest.ratio;
+    if ((CPA_TRUE != pSessionDesc->adaptiveDest.enabled) || (0 == ratio))
+    {
+        *pOutputSize = worstCase;
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (CPA_DC_HT_FULL_DYNAMIC == pSessionDesc->huffType)
+    {
+        minSize = pService->comp_device_data.minOutputBuffSizeDynamic;
+    }
+    else
+    {
+        minSize = pService->comp_device_data.minOutputBuffSize;
+    }
+
+    predicted = ((Cpa64U)inputSize * ratio) / DC_ADAPTIVE_DEST_RATIO_ONE;
+    predicted += (predicted * pSessionDesc->adaptiveDest.marginPercent) / 100;
+    predicted += DC_ADAPTIVE_DEST_EXTRA_BYTES;
+    if (predicted < minSize)
+    {
+        predicted = minSize;
+    }
+
+    *pOutputSize = (predicted < worstCase) ? (Cpa32U)predicted : worstCase;
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Points pView at the data of pSrcBuff following its first offset bytes */
+STATIC void dcAdaptiveDestSkip(CpaBufferList *pView,
+                               const CpaBufferList *pSrcBuff,
+                               Cpa32U offset)
+{
+    Cpa32U i = 0;
+
+    pView->numBuffers = 0;
+    for (i = 0; i < pSrcBuff->numBuffers; i++)
+    {
+        CpaFlatBuffer *pFlat = &pSrcBuff->pBuffers[i];
+
+        if (offset >= pFlat->dataLenInBytes)
+        {
+            offset -= pFlat->dataLenInBytes;
+            continue;
+        }
+        pView->pBuffers[pView->numBuffers].pData = pFlat->pData + offset;
+        pView->pBuffers[pView->numBuffers].dataLenInBytes =
+            pFlat->dataLenInBytes - offset;
+        pView->numBuffers++;
+        offset = 0;
+    }
+}
+
+STATIC void dcAdaptiveDestRelease(dc_adaptive_dest_t *pAdaptive,
+                                  dc_adaptive_dest_buff_t *pDest)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < DC_ADAPTIVE_DEST_MAX_SEGMENTS; i++)
+    {
+        if (NULL != pDest->flatBuffers[i].pData)
+        {
+            LAC_OS_CAFREE(pDest->flatBuffers[i].pData);
+        }
+    }
+    if (NULL != pDest->bufferList.pPrivateMetaData)
+    {
+        LAC_OS_CAFREE(pDest->bufferList.pPrivateMetaData);
+    }
+    dcAdaptiveDestUnpin(pAdaptive, pDest->pinnedBytes);
+    LAC_OS_FREE(pDest);
+}
+
+CpaStatus icp_sal_DcAdaptiveCompressData(CpaInstanceHandle dcInstance,
+                                         CpaDcSessionHandle pSessionHandle,
+                                         CpaBufferList *pSrcBuff,
+                                         CpaBufferList **ppDestBuff,
+                                         CpaDcRqResults *pResults)
+{
+    sal_compression_service_t *pService = NULL;
+    CpaInstanceHandle insHandle = NULL;
+    dc_session_desc_t *pSessionDesc = NULL;
+    dc_adaptive_dest_t *pAdaptive = NULL;
+    dc_adaptive_dest_buff_t *pDest = NULL;
+    CpaBufferList segment = {0};
+    CpaBufferList remainder = {0};
+    CpaBufferList *pSubmitSrc = pSrcBuff;
+    Cpa64U remainderPinned = 0;
+    Cpa32U srcLen = 0;
+    Cpa32U destSize = 0;
+    Cpa32U metaSize = 0;
+    Cpa32U consumed = 0;
+    Cpa32U produced = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(insHandle);
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pSrcBuff);
+    LAC_CHECK_NULL_PARAM(pSrcBuff->pBuffers);
+    LAC_CHECK_NULL_PARAM(ppDestBuff);
+    LAC_CHECK_NULL_PARAM(pResults);
+    /* Ensure this is a compression instance */
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+#endif
+
+    pService = (sal_compression_service_t *)insHandle;
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+#endif
+    pAdaptive = &pSessionDesc->adaptiveDest;
+    *ppDestBuff = NULL;
+
+    /* Only deflate output of a stateless overflow can be continued by an
+     * independent request */
+    if ((CPA_DC_DEFLATE != pSessionDesc->compType) ||
+        (CPA_DC_STATELESS != pSessionDesc->sessState) ||
+        (CPA_DC_DIR_DECOMPRESS == pSessionDesc->sessDirection))
+    {
+        LAC_INVALID_PARAM_LOG("Adaptive compression requires a stateless "
+                              "deflate compression session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (LacSync_GenWakeupSyncCaller != pSessionDesc->pCompressionCb)
+    {
+        LAC_INVALID_PARAM_LOG("Adaptive compression requires a synchronous "
+                              "session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (CPA_TRUE != pAdaptive->enabled)
+    {
+        LAC_INVALID_PARAM_LOG("Adaptive sizing is not enabled on the "
+                              "session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    for (i = 0; i < pSrcBuff->numBuffers; i++)
+    {
+        srcLen += pSrcBuff->pBuffers[i].dataLenInBytes;
+    }
+    if (0 == srcLen)
+    {
+        LAC_INVALID_PARAM_LOG("The source buffer list is empty");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    status = icp_sal_DcAdaptiveDestBound(
+        insHandle, pSessionHandle, srcLen, &destSize);
+    /* The metadata is handed back with the list, which may hold every
+     * segment */
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcBufferListGetMetaSize(
+            insHandle, DC_ADAPTIVE_DEST_MAX_SEGMENTS, &metaSize);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LAC_OS_MALLOC(&pDest, sizeof(dc_adaptive_dest_buff_t));
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    LAC_OS_BZERO(pDest, sizeof(dc_adaptive_dest_buff_t));
+    pDest->bufferList.pBuffers = pDest->flatBuffers;
+
+    status = LAC_OS_CAMALLOC(&pDest->bufferList.pPrivateMetaData,
+                             metaSize,
+                             LAC_64BYTE_ALIGNMENT,
+                             pService->nodeAffinity);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pDest->pinnedBytes += metaSize;
+        dcAdaptiveDestPin(pAdaptive, metaSize);
+    }
+
+    segment.numBuffers = 1;
+    segment.pPrivateMetaData = pDest->bufferList.pPrivateMetaData;
+
+    for (i = 0; (CPA_STATUS_SUCCESS == status) &&
+                (i < DC_ADAPTIVE_DEST_MAX_SEGMENTS);
+         i++)
+    {
+        status = LAC_OS_CAMALLOC(&pDest->flatBuffers[i].pData,
+                                 destSize,
+                                 LAC_64BYTE_ALIGNMENT,
+                                 pService->nodeAffinity);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+        pDest->flatBuffers[i].dataLenInBytes = destSize;
+        pDest->pinnedBytes += destSize;
+        dcAdaptiveDestPin(pAdaptive, destSize);
+
+        segment.pBuffers = &pDest->flatBuffers[i];
+        status = cpaDcCompressData(insHandle,
+                                   pSessionHandle,
+                                   pSubmitSrc,
+                                   &segment,
+                                   pResults,
+                                   CPA_DC_FLUSH_FINAL,
+                                   NULL);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+
+        pDest->flatBuffers[i].dataLenInBytes = pResults->produced;
+        pDest->bufferList.numBuffers = i + 1;
+        consumed += pResults->consumed;
+        produced += pResults->produced;
+
+        if (CPA_DC_OK == pResults->status)
+        {
+            break;
+        }
+        if ((CPA_DC_OVERFLOW != pResults->status) ||
+            (0 == pResults->consumed) ||
+            (i + 1 == DC_ADAPTIVE_DEST_MAX_SEGMENTS))
+        {
+            status = CPA_STATUS_FAIL;
+            break;
+        }
+
+        /* Continue with the unconsumed remainder. The checksum returned in
+         * pResults seeds the next request */
+        if (NULL == remainder.pBuffers)
+        {
+            status = cpaDcBufferListGetMetaSize(
+                insHandle, pSrcBuff->numBuffers, &metaSize);
+            if (CPA_STATUS_SUCCESS == status)
+            {
+                status = LAC_OS_MALLOC(&remainder.pBuffers,
+                                       pSrcBuff->numBuffers *
+                                           sizeof(CpaFlatBuffer));
+            }
+            if (CPA_STATUS_SUCCESS == status)
+            {
+                status = LAC_OS_CAMALLOC(&remainder.pPrivateMetaData,
+                                         metaSize,
+                                         LAC_64BYTE_ALIGNMENT,
+                                         pService->nodeAffinity);
+            }
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                break;
+            }
+            remainderPinned = metaSize;
+            dcAdaptiveDestPin(pAdaptive, remainderPinned);
+        }
+        dcAdaptiveDestSkip(&remainder, pSrcBuff, consumed);
+        pSubmitSrc = &remainder;
+
+        status = dcAdaptiveDestWorstCase(
+            insHandle, pSessionDesc, srcLen - consumed, &destSize);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            osalAtomicInc(&pAdaptive->numContinuations);
+        }
+    }
+
+    if (NULL != remainder.pPrivateMetaData)
+    {
+        LAC_OS_CAFREE(remainder.pPrivateMetaData);
+        dcAdaptiveDestUnpin(pAdaptive, remainderPinned);
+    }
+    if (NULL != remainder.pBuffers)
+    {
+        LAC_OS_FREE(remainder.pBuffers);
+    }
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        dcAdaptiveDestRelease(pAdaptive, pDest);
+        return status;
+    }
+
+    pResults->consumed = consumed;
+    pResults->produced = produced;
+    *ppDestBuff = &pDest->bufferList;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcAdaptiveFreeDest(CpaDcSessionHandle pSessionHandle,
+                                     CpaBufferList *pDestBuff)
+{
+    dc_session_desc_t *pSessionDesc = NULL;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pDestBuff);
+#endif
+
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+#endif
+
+    dcAdaptiveDestRelease(&pSessionDesc->adaptiveDest,
+                          (dc_adaptive_dest_buff_t *)pDestBuff);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcAdaptiveDestQueryStats(CpaDcSessionHandle pSessionHandle,
+                                           icp_sal_dc_adaptive_stats_t *pStats)
+{
+    dc_session_desc_t *pSessionDesc = NULL;
+    dc_adaptive_dest_t *pAdaptive = NULL;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pStats);
+#endif
+
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+#endif
+    pAdaptive = &pSessionDesc->adaptiveDest;
+
+    pStats->numRequests = (Cpa64U)osalAtomicGet(&pAdaptive->numRequests);
+    pStats->numOverflows = (Cpa64U)osalAtomicGet(&pAdaptive->numOverflows);
+    pStats->numContinuations =
+        (Cpa64U)osalAtomicGet(&pAdaptive->numContinuations);
+    pStats->pinnedBytes = (Cpa64U)osalAtomicGet(&pAdaptive->pinnedBytes);
+    pStats->peakPinnedBytes =
+        (Cpa64U)osalAtomicGet(&pAdaptive->peakPinnedBytes);
+    pStats->ratioPercent =
+        (pAdaptive->ratio * 100 + DC_ADAPTIVE_DEST_RATIO_ONE / 2) /
+        DC_ADAPTIVE_DEST_RATIO_ONE;
+
+    return CPA_STATUS_SUCCESS;
+}
@@ -119,11 +119,9 @@ CpaStatus cpaDcBnpBufferListGetMetaSize(const CpaInstanceHandle instanceHandle,
                                         Cpa32U numJobs,
                                         Cpa32U *pSizeInBytes)
 {
-    LAC_UNUSED_VARIABLE(instanceHandle);
-    LAC_UNUSED_VARIABLE(numJobs);
-    LAC_UNUSED_VARIABLE(pSizeInBytes);
-
-    return CPA_STATUS_UNSUPPORTED;
+    /* Batch and Pack requests are described to the firmware with regular
+     * buffer list descriptors */
+    return cpaDcBufferListGetMetaSize(instanceHandle, numJobs, pSizeInBytes);
 }
 
 STATIC INLINE CpaStatus dcDeflateBoundGen2(CpaDcHuffType huffType,
@@ -79,6 +79,7 @@
 #include "lac_sym_alg_chain.h"
 #include "lac_sym_auth_enc.h"
 #include "sal_hw_gen.h"
+#include "icp_sal_dc_chain.h"
 
 
 static const dc_chain_cmd_tbl_t dc_chain_cmd_table[] = {
@@ -1351,7 +1352,6 @@ STATIC CpaStatus dcChainPrepare_CompRequest(CpaInstanceHandle dcInstance,
     dc_session_desc_t *pDcSessDesc = NULL;
     sal_compression_service_t *pDcService =
         (sal_compression_service_t *)dcInstance;
-    sal_dc_chain_service_t *pChainService = pDcService->pDcChainService;
     CpaDcOpData *pDcOpData = NULL;
     dc_request_dir_t compDecomp;
     CpaDcRqResults dcResults = { 0 };
@@ -1360,7 +1360,6 @@ STATIC CpaStatus dcChainPrepare_CompRequest(CpaInstanceHandle dcInstance,
     Cpa8U asbFlag = ICP_QAT_FW_COMP_CHAIN_NO_ASB;
     Cpa8U cnvFlag = ICP_QAT_FW_COMP_CHAIN_NO_CNV;
     Cpa8U cnvnrFlag = ICP_QAT_FW_COMP_CHAIN_NO_CNV_RECOVERY;
-    void *pDcLinkRsp = NULL;
     icp_qat_fw_comp_chain_req_t *pChainReq = NULL;
     icp_qat_fw_chain_stor2_req_t *pChainStor2Req = NULL;
     icp_qat_fw_comp_req_t *pMsg = NULL;
@@ -1456,19 +1455,9 @@ STATIC CpaStatus dcChainPrepare_CompRequest(CpaInstanceHandle dcInstance,
 
     LAC_CHECK_STATUS(status);
 
-    pDcLinkRsp = Lac_MemPoolEntryAlloc(pChainService->dc_chain_serv_resp_pool);
-    if (NULL == pDcLinkRsp)
-    {
-        return CPA_STATUS_RESOURCE;
-    }
-    else if ((void *)CPA_STATUS_RETRY == pDcLinkRsp)
-    {
-        return CPA_STATUS_RETRY;
-    }
-
-    rspDescPhyAddr = (icp_qat_addr_width_t)LAC_OS_VIRT_TO_PHYS_INTERNAL(
-        &pDcService->generic_service_info, pDcLinkRsp);
-    pChainCookie->pDcRspAddr = pDcLinkRsp;
+    /* The response descriptor is linked to the chaining cookie when the
+     * service starts */
+    rspDescPhyAddr = pChainCookie->dcRspPhyAddr;
     pChainCookie->pDcCookieAddr = pDcCookie;
 
     if (isDcGen2x(pDcService))
@@ -1564,9 +1553,7 @@ STATIC CpaStatus dcChainPrepare_SymRequest(CpaInstanceHandle dcInstance,
     /*compression service and chain service*/
     sal_compression_service_t *pDcService =
         (sal_compression_service_t *)dcInstance;
-    sal_dc_chain_service_t *pChainService = pDcService->pDcChainService;
     lac_session_desc_t *pCySessDesc = NULL;
-    void *pCyLinkRsp = NULL;
     Cpa64U rspDescPhyAddr = 0;
     icp_qat_fw_comp_chain_req_t *pChainReq = NULL;
     icp_qat_fw_chain_stor2_req_t *pChainStor2Req = NULL;
@@ -1635,35 +1622,20 @@ STATIC CpaStatus dcChainPrepare_SymRequest(CpaInstanceHandle dcInstance,
     }
     LAC_CHECK_STATUS(status);
 
-    pCyLinkRsp = Lac_MemPoolEntryAlloc(pChainService->dc_chain_serv_resp_pool);
-    if (NULL == pCyLinkRsp)
-    {
-        return CPA_STATUS_RESOURCE;
-    }
-    else if ((void *)CPA_STATUS_RETRY == pCyLinkRsp)
-    {
-        return CPA_STATUS_RETRY;
-    }
-
-    rspDescPhyAddr = (icp_qat_addr_width_t)LAC_OS_VIRT_TO_PHYS_INTERNAL(
-        &pDcService->generic_service_info, pCyLinkRsp);
-    pChainCookie->pCyRspAddr = pCyLinkRsp;
-    pChainCookie->pCyCookieAddr = pCyCookie;
+    /* The crypto cookie and response descriptor are linked to the chaining
+     * cookie when the service starts, with their addresses translated */
+    rspDescPhyAddr = pChainCookie->cyRspPhyAddr;
 
     if (isDcGen2x(pDcService))
     {
         pChainReq = (icp_qat_fw_comp_chain_req_t *)&pChainCookie->request;
-        pChainReq->symCryptoReqAddr =
-            (icp_qat_addr_width_t)LAC_OS_VIRT_TO_PHYS_INTERNAL(
-                &pDcService->generic_service_info, &pCyCookie->qatMsg);
+        pChainReq->symCryptoReqAddr = pChainCookie->cyReqPhyAddr;
         pChainReq->symCryptoRespAddr = rspDescPhyAddr;
     }
     else
     {
         pChainStor2Req = (icp_qat_fw_chain_stor2_req_t *)&pChainCookie->request;
-        pChainStor2Req->symCryptoReqAddr =
-            (icp_qat_addr_width_t)LAC_OS_VIRT_TO_PHYS_INTERNAL(
-                &pDcService->generic_service_info, &pCyCookie->qatMsg);
+        pChainStor2Req->symCryptoReqAddr = pChainCookie->cyReqPhyAddr;
         pChainStor2Req->symCryptoRespAddr = rspDescPhyAddr;
     }
 
@@ -1685,11 +1657,13 @@ STATIC void dcChainOp_MemPoolEntryFree(void *pEntry)
 /**
  *****************************************************************************
  * @ingroup Dc_Chaining
- *      Chaining perform operation
+ *      Build a chaining request
  *
  * @description
- *      Chaining perform operation, it is called at cpaDcChainPerformOp,
- *      which is used to perform chaining requests.
+ *      Builds the chaining request and its linked compression and crypto
+ *      requests without putting it on the ring. On success the request
+ *      is counted as pending on the session and must either be put on
+ *      the ring or released with dcChainOpRelease.
  *
  * @param[in]       dcInstance         Instance handle derived from discovery
  *                                     functions.
@@ -1705,6 +1679,7 @@ STATIC void dcChainOp_MemPoolEntryFree(void *pEntry)
  * @param[in,out]   pResultsExt        Extensible chaining response result
  * @param[in]       callbackTag        For synchronous operation this callback
  *                                     shall be a null pointer.
+ * @param[out]      ppChainCookie      Chaining cookie holding the request
  *
  * @retval CPA_STATUS_SUCCESS        Function executed successfully
  * @retval CPA_STATUS_FAIL           Function failed to find device
@@ -1714,17 +1689,17 @@ STATIC void dcChainOp_MemPoolEntryFree(void *pEntry)
  * @retval CPA_STATUS_UNSUPPORTED    Function is not supported.
  *
  *****************************************************************************/
-CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
-                           CpaDcSessionHandle pSessionHandle,
-                           CpaBufferList *pSrcBuff,
-                           CpaBufferList *pDestBuff,
-                           CpaBufferList *pInterBuff,
-                           CpaDcChainOperations operation,
-                           Cpa8U numOperations,
-                           dc_chain_opdata_ext_t *pChainOpDataExt,
-                           dc_chain_results_ext_t *pResultsExt,
-                           void *callbackTag)
-
+STATIC CpaStatus dcChainBuildOp(CpaInstanceHandle dcInstance,
+                                CpaDcSessionHandle pSessionHandle,
+                                CpaBufferList *pSrcBuff,
+                                CpaBufferList *pDestBuff,
+                                CpaBufferList *pInterBuff,
+                                CpaDcChainOperations operation,
+                                Cpa8U numOperations,
+                                dc_chain_opdata_ext_t *pChainOpDataExt,
+                                dc_chain_results_ext_t *pResultsExt,
+                                void *callbackTag,
+                                dc_chain_cookie_t **ppChainCookie)
 {
     /* Compression service and chain service */
     sal_compression_service_t *pDcService =
@@ -1829,12 +1804,14 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
         return CPA_STATUS_RETRY;
     }
 
-    /* Populate chaining cookie */
-    LAC_OS_BZERO(pChainCookie, sizeof(dc_chain_cookie_t));
+    /* Populate chaining cookie. The links prepared when the service
+     * started are kept, so the cookie is not cleared as a whole */
     pChainCookie->dcInstance = dcInstance;
     pChainCookie->pSessionHandle = pSessionHandle;
     pChainCookie->extResults = *pResultsExt;
     pChainCookie->callbackTag = callbackTag;
+    pChainCookie->pDcCookieAddr = NULL;
+    pChainCookie->submitTimestamp = 0;
 
     /* Build chaining common header */
     if (isDcGen2x(pDcService))
@@ -1973,19 +1950,7 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
         else
         {
             pTemp += sizeof(CpaDcChainSessionType);
-            pCyCookie = (lac_sym_bulk_cookie_t *)Lac_MemPoolEntryAlloc(
-                pChainService->lac_sym_cookie_pool);
-            if (NULL == pCyCookie)
-            {
-                LAC_LOG_ERROR("Cannot get symmetric crypto mem pool entry\n");
-                status = CPA_STATUS_RESOURCE;
-                goto out_err;
-            }
-            else if ((void *)CPA_STATUS_RETRY == pCyCookie)
-            {
-                status = CPA_STATUS_RETRY;
-                goto out_err;
-            }
+            pCyCookie = (lac_sym_bulk_cookie_t *)pChainCookie->pCyCookieAddr;
 
             if (DC_CHAIN_OPDATA_TYPE0 == pChainOpDataExt->opDataType)
             {
@@ -2034,17 +1999,36 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
             0);
     }
 
-    /*Put message on the ring*/
-    status = SalQatMsg_transPutMsg(pDcService->trans_handle_compression_tx,
-                                   (void *)&pChainCookie->request,
-                                   LAC_QAT_DC_REQ_SZ_LW,
-                                   LAC_LOG_MSG_DC,
-                                   NULL);
+    *ppChainCookie = pChainCookie;
+    return CPA_STATUS_SUCCESS;
 
-    /*update stats*/
+out_err:
+    osalAtomicDec(&(pSessHead->pendingChainCbCount));
+    dcChainOp_MemPoolEntryFree(pDcCookie);
+    dcChainOp_MemPoolEntryFree(pChainCookie);
+    return status;
+}
+
+/* Release a chaining request that was built but not put on the ring */
+STATIC void dcChainOpRelease(dc_chain_cookie_t *pChainCookie)
+{
+    dc_chain_session_head_t *pSessHead =
+        (dc_chain_session_head_t *)pChainCookie->pSessionHandle;
+
+    osalAtomicDec(&(pSessHead->pendingChainCbCount));
+    dcChainOp_MemPoolEntryFree(pChainCookie->pDcCookieAddr);
+    dcChainOp_MemPoolEntryFree(pChainCookie);
+}
+
+/* Update the compression statistics for a chaining request put on the
+ * ring, or rejected by it */
+STATIC void dcChainOpCountRequest(sal_compression_service_t *pDcService,
+                                  dc_chain_session_head_t *pSessHead,
+                                  CpaStatus status)
+{
     if (CPA_STATUS_SUCCESS == status)
     {
-        if (pDcSessDesc->sessDirection == CPA_DC_DIR_COMPRESS)
+        if (pSessHead->pDcSessionDesc->sessDirection == CPA_DC_DIR_COMPRESS)
         {
             COMPRESSION_STAT_INC(numCompRequests, pDcService);
         }
@@ -2055,7 +2039,7 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
     }
     else
     {
-        if (pDcSessDesc->sessDirection == CPA_DC_DIR_COMPRESS)
+        if (pSessHead->pDcSessionDesc->sessDirection == CPA_DC_DIR_COMPRESS)
         {
             COMPRESSION_STAT_INC(numCompRequestsErrors, pDcService);
         }
@@ -2063,18 +2047,123 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
         {
             COMPRESSION_STAT_INC(numDecompRequestsErrors, pDcService);
         }
-        goto out_err;
     }
-    return CPA_STATUS_SUCCESS;
+}
 
-out_err:
-    osalAtomicDec(&(pSessHead->pendingChainCbCount));
-    dcChainOp_MemPoolEntryFree(pDcCookie);
-    dcChainOp_MemPoolEntryFree(pCyCookie);
-    dcChainOp_MemPoolEntryFree(pChainCookie->pDcRspAddr);
-    dcChainOp_MemPoolEntryFree(pChainCookie->pCyRspAddr);
-    dcChainOp_MemPoolEntryFree(pChainCookie);
-    return status;
+/**
+ *****************************************************************************
+ * @ingroup Dc_Chaining
+ *      Chaining perform operation
+ *
+ * @description
+ *      Chaining perform operation, it is called at cpaDcChainPerformOp,
+ *      which is used to perform chaining requests.
+ *
+ * @param[in]       dcInstance         Instance handle derived from discovery
+ *                                     functions.
+ * @param[in]       pSessionHandle     Pointer to a session handle.
+ * @param[in]       pSrcBuff           Source buffer
+ * @param[in]       pDestBuff          Destination buffer
+ * @param[in]       pInterBuff         Pointer to intermediate buffer to be
+ *                                     used as internal staging area for
+ *                                     chaining operations.
+ * @param[in]       operation          Chaining operation
+ * @param[in]       numOperations      Number of operations for the chaining
+ * @param[in]       pChainOpDataExt    Extensible chaining operation data
+ * @param[in,out]   pResultsExt        Extensible chaining response result
+ * @param[in]       callbackTag        For synchronous operation this callback
+ *                                     shall be a null pointer.
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed to find device
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE       Failed to allocate required resources
+ * @retval CPA_STATUS_RETRY          Request re-submission needed
+ * @retval CPA_STATUS_UNSUPPORTED    Function is not supported.
+ *
+ *****************************************************************************/
+CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
+                           CpaDcSessionHandle pSessionHandle,
+                           CpaBufferList *pSrcBuff,
+                           CpaBufferList *pDestBuff,
+                           CpaBufferList *pInterBuff,
+                           CpaDcChainOperations operation,
+                           Cpa8U numOperations,
+                           dc_chain_opdata_ext_t *pChainOpDataExt,
+                           dc_chain_results_ext_t *pResultsExt,
+                           void *callbackTag)
+
+{
+    sal_compression_service_t *pDcService =
+        (sal_compression_service_t *)dcInstance;
+    sal_dc_chain_service_t *pChainService = pDcService->pDcChainService;
+    dc_chain_cookie_t *pChainCookie = NULL;
+    CpaBoolean statsEnabled = DC_CHAIN_STATS_ENABLED(pDcService);
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa64U startTs = 0;
+    Cpa64U submitTs = 0;
+
+    if (statsEnabled)
+    {
+        startTs = osalTimestampGet();
+    }
+
+    status = dcChainBuildOp(dcInstance,
+                            pSessionHandle,
+                            pSrcBuff,
+                            pDestBuff,
+                            pInterBuff,
+                            operation,
+                            numOperations,
+                            pChainOpDataExt,
+                            pResultsExt,
+                            callbackTag,
+                            &pChainCookie);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        if (statsEnabled && (CPA_STATUS_RETRY == status))
+        {
+            DC_CHAIN_STAT_ADD(numRetries, 1, pChainService);
+        }
+        return status;
+    }
+
+    if (statsEnabled)
+    {
+        submitTs = osalTimestampGet();
+        DC_CHAIN_STAT_ADD(buildCycles, submitTs - startTs, pChainService);
+        pChainCookie->submitTimestamp = submitTs;
+    }
+
+    /*Put message on the ring*/
+    status = SalQatMsg_transPutMsg(pDcService->trans_handle_compression_tx,
+                                   (void *)&pChainCookie->request,
+                                   LAC_QAT_DC_REQ_SZ_LW,
+                                   LAC_LOG_MSG_DC,
+                                   NULL);
+
+    /*update stats*/
+    dcChainOpCountRequest(
+        pDcService, (dc_chain_session_head_t *)pSessionHandle, status);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        if (statsEnabled && (CPA_STATUS_RETRY == status))
+        {
+            DC_CHAIN_STAT_ADD(numRetries, 1, pChainService);
+        }
+        dcChainOpRelease(pChainCookie);
+        return status;
+    }
+
+    if (statsEnabled)
+    {
+        /* The cookie may already be completed, only local data is used */
+        DC_CHAIN_STAT_ADD(
+            submitCycles, osalTimestampGet() - submitTs, pChainService);
+        DC_CHAIN_STAT_ADD(numRequests, 1, pChainService);
+        DC_CHAIN_STAT_ADD(numSubmits, 1, pChainService);
+    }
+    return CPA_STATUS_SUCCESS;
 }
 
 CpaStatus cpaDcChainPerformOp(CpaInstanceHandle dcInstance,
@@ -2209,6 +2298,233 @@ CpaStatus cpaDcChainPerformOp2(CpaInstanceHandle dcInstance,
                             callbackTag);
 }
 
+CpaStatus icp_sal_DcChainPerformOpBatch(
+    CpaInstanceHandle dcInstance,
+    CpaDcSessionHandle pSessionHandle,
+    CpaDcChainOperations operation,
+    Cpa8U numOpDatas,
+    Cpa32U numRequests,
+    icp_sal_dc_chain_batch_op_t *pBatchOpData,
+    Cpa32U *pNumSubmitted)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaInstanceHandle insHandle = NULL;
+    sal_compression_service_t *pService = NULL;
+    sal_dc_chain_service_t *pChainService = NULL;
+    dc_chain_session_head_t *pSessHead = NULL;
+    dc_chain_opdata_ext_t chainOpDataExt;
+    dc_chain_results_ext_t chainResultsExt;
+    dc_chain_cookie_t *pChainCookies[DC_CHAIN_BATCH_MAX_REQUESTS];
+    void *pMsgs[DC_CHAIN_BATCH_MAX_REQUESTS];
+    Cpa64U seqNums[DC_CHAIN_BATCH_MAX_REQUESTS];
+    icp_sal_dc_chain_batch_op_t *pOp = NULL;
+    CpaBoolean statsEnabled = CPA_FALSE;
+    Cpa64U startTs = 0;
+    Cpa64U submitTs = 0;
+    Cpa32U numBuilt = 0;
+    Cpa32U numPut = 0;
+    Cpa32U first = 0;
+    Cpa32U i = 0;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(insHandle);
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pBatchOpData);
+    LAC_CHECK_NULL_PARAM(pNumSubmitted);
+    SAL_CHECK_ADDR_TRANS_SETUP(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    if (0 == numRequests)
+    {
+        LAC_INVALID_PARAM_LOG("numRequests must be greater than zero");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    for (i = 0; i < numRequests; i++)
+    {
+        LAC_CHECK_NULL_PARAM(pBatchOpData[i].pSrcBuff);
+        LAC_CHECK_NULL_PARAM(pBatchOpData[i].pDestBuff);
+        LAC_CHECK_NULL_PARAM(pBatchOpData[i].pChainOpData);
+        LAC_CHECK_NULL_PARAM(pBatchOpData[i].pResults);
+    }
+    status = dcChainSession_CheckChainSessDesc(
+        (dc_chain_session_head_t *)pSessionHandle, operation, numOpDatas);
+    LAC_CHECK_STATUS(status);
+#endif
+    pService = (sal_compression_service_t *)insHandle;
+    pChainService = pService->pDcChainService;
+    if (NULL == pChainService)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    /* Check if SAL is initialised otherwise return an error */
+    SAL_RUNNING_CHECK(insHandle);
+
+    /* A synchronous caller would block on the first request */
+    pSessHead = (dc_chain_session_head_t *)pSessionHandle;
+    if (LacSync_GenWakeupSyncCaller == pSessHead->pdcChainCb)
+    {
+        LAC_INVALID_PARAM_LOG("Batched chaining requires an asynchronous "
+                              "session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    *pNumSubmitted = 0;
+    statsEnabled = DC_CHAIN_STATS_ENABLED(pService);
+    chainOpDataExt.opDataType = DC_CHAIN_OPDATA_TYPE0;
+    chainResultsExt.resultsType = DC_CHAIN_RESULTS_TYPE0;
+
+    for (first = 0; first < numRequests; first += numPut)
+    {
+        if (statsEnabled)
+        {
+            startTs = osalTimestampGet();
+        }
+
+        for (numBuilt = 0; (numBuilt < DC_CHAIN_BATCH_MAX_REQUESTS) &&
+                           (first + numBuilt < numRequests);
+             numBuilt++)
+        {
+            pOp = &pBatchOpData[first + numBuilt];
+            chainOpDataExt.pOpData = pOp->pChainOpData;
+            chainResultsExt.pResults = pOp->pResults;
+            status = dcChainBuildOp(insHandle,
+                                    pSessionHandle,
+                                    pOp->pSrcBuff,
+                                    pOp->pDestBuff,
+                                    NULL,
+                                    operation,
+                                    numOpDatas,
+                                    &chainOpDataExt,
+                                    &chainResultsExt,
+                                    pOp->callbackTag,
+                                    &pChainCookies[numBuilt]);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                break;
+            }
+            pMsgs[numBuilt] = &pChainCookies[numBuilt]->request;
+        }
+
+        if (0 == numBuilt)
+        {
+            break;
+        }
+
+        if (statsEnabled)
+        {
+            submitTs = osalTimestampGet();
+            DC_CHAIN_STAT_ADD(buildCycles, submitTs - startTs, pChainService);
+            for (i = 0; i < numBuilt; i++)
+            {
+                pChainCookies[i]->submitTimestamp = submitTs;
+            }
+        }
+
+        /* The whole batch goes behind a single tail update */
+        numPut = 0;
+        if (CPA_STATUS_SUCCESS !=
+            SalQatMsg_transPutMsgs(pService->trans_handle_compression_tx,
+                                   pMsgs,
+                                   LAC_QAT_DC_REQ_SZ_LW,
+                                   numBuilt,
+                                   LAC_LOG_MSG_DC,
+                                   seqNums,
+                                   &numPut))
+        {
+            status = CPA_STATUS_RETRY;
+        }
+
+        for (i = 0; i < numPut; i++)
+        {
+            dcChainOpCountRequest(pService, pSessHead, CPA_STATUS_SUCCESS);
+        }
+        for (i = numPut; i < numBuilt; i++)
+        {
+            dcChainOpCountRequest(pService, pSessHead, CPA_STATUS_RETRY);
+            dcChainOpRelease(pChainCookies[i]);
+        }
+        *pNumSubmitted += numPut;
+
+        if (statsEnabled)
+        {
+            DC_CHAIN_STAT_ADD(
+                submitCycles, osalTimestampGet() - submitTs, pChainService);
+            DC_CHAIN_STAT_ADD(numRequests, numPut, pChainService);
+            if (numPut > 0)
+            {
+                DC_CHAIN_STAT_ADD(numSubmits, 1, pChainService);
+            }
+        }
+
+        /* Stop at the first request that could not be built or put */
+        if ((CPA_STATUS_SUCCESS != status) || (numPut < numBuilt))
+        {
+            break;
+        }
+    }
+
+    if (statsEnabled && (CPA_STATUS_RETRY == status))
+    {
+        DC_CHAIN_STAT_ADD(numRetries, 1, pChainService);
+    }
+
+    return (*pNumSubmitted > 0) ? CPA_STATUS_SUCCESS : status;
+}
+
+CpaStatus icp_sal_DcChainGetStats(CpaInstanceHandle dcInstance,
+                                  icp_sal_dc_chain_stats_t *pStats)
+{
+    CpaInstanceHandle insHandle = NULL;
+    sal_compression_service_t *pService = NULL;
+    dc_chain_stats_t *pChainStats = NULL;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(insHandle);
+    LAC_CHECK_NULL_PARAM(pStats);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+#endif
+    pService = (sal_compression_service_t *)insHandle;
+    if (NULL == pService->pDcChainService)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+    if (CPA_TRUE != pService->generic_service_info.stats->bDcStatsEnabled)
+    {
+        LAC_INVALID_PARAM_LOG("Compression statistics are disabled");
+        return CPA_STATUS_RESOURCE;
+    }
+
+    pChainStats = &pService->pDcChainService->stats;
+    pStats->numRequests = pChainStats->numRequests;
+    pStats->numSubmits = pChainStats->numSubmits;
+    pStats->numRetries = pChainStats->numRetries;
+    pStats->numCompleted = pChainStats->numCompleted;
+    pStats->buildCycles = pChainStats->buildCycles;
+    pStats->submitCycles = pChainStats->submitCycles;
+    pStats->deviceCycles = pChainStats->deviceCycles;
+    pStats->completeCycles = pChainStats->completeCycles;
+
+    return CPA_STATUS_SUCCESS;
+}
+
 /**
  ************************************************************************
  * @ingroup Dc_Chaining
@@ -2293,7 +2609,10 @@ void dcChainProcessResults(void *pRespMsg)
     lac_sym_bulk_cookie_t *pCyCookie = NULL;
     CpaBoolean chainSubReqFail = CPA_FALSE;
     sal_compression_service_t *pDcService = NULL;
+    sal_compression_service_t *pChainDcService = NULL;
     Cpa8U respStatus = 0;
+    Cpa64U submitTs = 0;
+    Cpa64U startTs = 0;
 
     pChainRespMsg = (icp_qat_fw_comp_chain_resp_t *)pRespMsg;
 #ifdef ICP_PARAM_CHECK
@@ -2312,6 +2631,12 @@ void dcChainProcessResults(void *pRespMsg)
         goto dcChainProcessResultsExit;
     }
 #endif
+    pChainDcService = (sal_compression_service_t *)pChainCookie->dcInstance;
+    submitTs = pChainCookie->submitTimestamp;
+    if (0 != submitTs)
+    {
+        startTs = osalTimestampGet();
+    }
     pSessHead = (dc_chain_session_head_t *)pChainCookie->pSessionHandle;
     callbackTag = pChainCookie->callbackTag;
     pCySessionDesc = pSessHead->pCySessionDesc;
@@ -2456,31 +2781,28 @@ void dcChainProcessResults(void *pRespMsg)
 #ifdef ICP_PARAM_CHECK
 dcChainProcessResultsExit:
 #endif
-    if (NULL != pChainCookie)
-    {
-        if (NULL != pChainCookie->pDcRspAddr)
-        {
-            Lac_MemPoolEntryFree(pChainCookie->pDcRspAddr);
-        }
-        if (NULL != pChainCookie->pCyRspAddr)
-        {
-            Lac_MemPoolEntryFree(pChainCookie->pCyRspAddr);
-        }
-    }
+    /* The crypto cookie and the response descriptors stay linked to the
+     * chaining cookie */
     if (NULL != pDcCookie)
     {
         Lac_MemPoolEntryFree(pDcCookie);
     }
-    if (NULL != pCyCookie)
-    {
-        Lac_MemPoolEntryFree(pCyCookie);
-    }
     if (NULL != pChainCookie)
     {
         Lac_MemPoolEntryFree(pChainCookie);
     }
     osalAtomicDec(&(pSessHead->pendingChainCbCount));
 
+    if (0 != submitTs)
+    {
+        DC_CHAIN_STAT_ADD(
+            deviceCycles, startTs - submitTs, pChainDcService->pDcChainService);
+        DC_CHAIN_STAT_ADD(completeCycles,
+                          osalTimestampGet() - startTs,
+                          pChainDcService->pDcChainService);
+        DC_CHAIN_STAT_ADD(numCompleted, 1, pChainDcService->pDcChainService);
+    }
+
     /*pCbFunc can never be NULL, its default is LacSync_GenWakeupSyncCaller*/
     pCbFunc(callbackTag, status);
 }
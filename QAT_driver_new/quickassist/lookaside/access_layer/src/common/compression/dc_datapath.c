@@ -88,6 +88,9 @@
 #include "sal_misc_error_stats.h"
 #include "sal_hw_gen.h"
 
+/* Requests of trusted callers skip the checks of what was validated at
+ * session init */
+#define DC_TRUSTED_CALLER(pService) ((pService)->trustedCaller)
 
 STATIC OsalAtomic dcErrorCount[MAX_DC_ERROR_TYPE];
 
@@ -522,7 +525,9 @@ CpaStatus dcCompression_CommonProcessCallback(
     {
         pSessionDesc = pCookie->pSessionDesc;
         callbackTag = pCookie->callbackTag;
-        pCbFunc = pCookie->pSessionDesc->pCompressionCb;
+        pCbFunc = (NULL != pCookie->pCbFunc)
+                      ? pCookie->pCbFunc
+                      : pCookie->pSessionDesc->pCompressionCb;
         compDecomp = pCookie->compDecomp;
         pOpData = pCookie->pDcOpData;
     }
@@ -778,6 +783,12 @@ CpaStatus dcCompression_CommonProcessCallback(
                 dcResetXxhashState(pSessionDesc, pCookie);
         }
 
+        if ((DC_COMPRESSION_REQUEST == compDecomp) &&
+            (CPA_TRUE == pSessionDesc->adaptiveDest.enabled))
+        {
+            dcAdaptiveDestUpdate(pSessionDesc, pResults);
+        }
+
         if (DC_DECOMPRESSION_REQUEST == compDecomp)
         {
             pResults->endOfLastBlock =
@@ -1012,7 +1023,9 @@ CpaStatus dcCompression_SwRespMsgCallback(lac_memblk_bucket_t *pBucket)
         {
             osalAtomicDec(&(pCookie->pSessionDesc->pendingStatefulCbCount));
         }
-        pCbFunc = pCookie->pSessionDesc->pCompressionCb;
+        pCbFunc = (NULL != pCookie->pCbFunc)
+                      ? pCookie->pCbFunc
+                      : pCookie->pSessionDesc->pCompressionCb;
         pCbFunc(pCookie->callbackTag, CPA_STATUS_FAIL);
         Lac_MemPoolEntryFree(pCookie);
     }
@@ -1096,6 +1109,13 @@ CpaStatus dcCheckOpData(sal_compression_service_t *pService,
         return CPA_STATUS_INVALID_PARAM;
     }
 
+    if (pOpData->compressAndVerifyAndRecover != CPA_TRUE &&
+        pOpData->compressAndVerifyAndRecover != CPA_FALSE)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid cnvnr value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
     if (CPA_TRUE == pOpData->integrityCrcCheck &&
         CPA_FALSE == pService->generic_service_info.integrityCrcCheck)
     {
@@ -1314,6 +1334,116 @@ STATIC CpaStatus dcCheckDestinationData(sal_compression_service_t *pService,
     }
     return CPA_STATUS_SUCCESS;
 }
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Check the parameters of a request from a trusted caller
+ *
+ * @description
+ *      Check only the request fields that can change from one request to the
+ *      next. What depends on the session alone was validated by
+ *      dcInitSession, and the buffer sizes are checked by dcCreateRequest
+ *      from the totals it computes while writing the descriptors. The
+ *      fields of pOpData are checked as dcCheckOpData does, in fewer
+ *      branches; debug builds call dcCheckOpData to log the wrong field.
+ *
+ * @param[in]   pService              Pointer to the compression service
+ * @param[in]   pSessionHandle        Session handle
+ * @param[in]   pSrcBuff              Pointer to the source buffer list
+ * @param[in]   pDestBuff             Pointer to the destination buffer list
+ * @param[in]   pResults              Pointer to results structure
+ * @param[in]   flushFlag             Type of flush to be performed
+ * @param[in]   pOpData               Pointer to the request information
+ *                                    structure, NULL if not provided
+ * @param[in]   compDecomp            Direction of the operation
+ *
+ * @retval CPA_STATUS_SUCCESS         Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ *
+ *****************************************************************************/
+STATIC CpaStatus dcCheckTrustedRequest(sal_compression_service_t *pService,
+                                       CpaDcSessionHandle pSessionHandle,
+                                       CpaBufferList *pSrcBuff,
+                                       CpaBufferList *pDestBuff,
+                                       CpaDcRqResults *pResults,
+                                       CpaDcFlush flushFlag,
+                                       CpaDcOpData *pOpData,
+                                       dc_request_dir_t compDecomp)
+{
+    dc_session_desc_t *pSessionDesc = NULL;
+
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pResults);
+    LAC_CHECK_NULL_PARAM(pDestBuff);
+    LAC_CHECK_NULL_PARAM(pDestBuff->pBuffers);
+    LAC_CHECK_NULL_PARAM(pDestBuff->pPrivateMetaData);
+
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+    if ((NULL == pSessionDesc) || (CPA_TRUE == pSessionDesc->isDcDp))
+    {
+        LAC_INVALID_PARAM_LOG("Session handle not as expected");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (((DC_COMPRESSION_REQUEST == compDecomp) &&
+         (CPA_DC_DIR_DECOMPRESS == pSessionDesc->sessDirection)) ||
+        ((DC_DECOMPRESSION_REQUEST == compDecomp) &&
+         (CPA_DC_DIR_COMPRESS == pSessionDesc->sessDirection)))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid sessDirection value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (NULL != pOpData)
+    {
+        flushFlag = pOpData->flushFlag;
+
+#ifdef ICP_DEBUG
+        if (CPA_STATUS_SUCCESS != dcCheckOpData(pService, pOpData))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+#else
+        /* CpaBoolean fields hold CPA_FALSE or CPA_TRUE and the skip modes
+         * start at 0, so each group is a single unsigned compare */
+        if ((((Cpa32U)pOpData->integrityCrcCheck |
+              (Cpa32U)pOpData->verifyHwIntegrityCrcs |
+              (Cpa32U)pOpData->compressAndVerify |
+              (Cpa32U)pOpData->compressAndVerifyAndRecover) > CPA_TRUE) ||
+            ((Cpa32U)pOpData->inputSkipData.skipMode > CPA_DC_SKIP_STRIDE) ||
+            ((Cpa32U)pOpData->outputSkipData.skipMode > CPA_DC_SKIP_STRIDE))
+        {
+            LAC_INVALID_PARAM_LOG("Invalid CpaDcOpData value");
+            return CPA_STATUS_INVALID_PARAM;
+        }
+
+        if (((CPA_TRUE == pOpData->integrityCrcCheck) &&
+             ((CPA_FALSE == pService->generic_service_info.integrityCrcCheck) ||
+              (NULL == pOpData->pCrcData))) ||
+            ((CPA_FALSE == pOpData->integrityCrcCheck) &&
+             (CPA_TRUE == pOpData->verifyHwIntegrityCrcs)))
+        {
+            LAC_INVALID_PARAM_LOG("Invalid integrity CRC check parameters");
+            return CPA_STATUS_INVALID_PARAM;
+        }
+#endif
+    }
+
+    if ((flushFlag < CPA_DC_FLUSH_NONE) || (flushFlag > CPA_DC_FLUSH_FULL))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid flushFlag value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if ((pSrcBuff == pDestBuff) || (0 == pDestBuff->numBuffers))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid destination buffer list parameter");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
 #endif
 
 /**
@@ -1424,6 +1554,40 @@ CpaStatus dcCreateRequest(dc_compression_cookie_t *pCookie,
         return status;
     }
 
+#ifdef ICP_PARAM_CHECK
+    /* The sizes of the requests of trusted callers are checked here, from
+     * the totals computed with the descriptors, rather than by walking the
+     * buffer lists again beforehand */
+    if (CPA_TRUE == DC_TRUSTED_CALLER(pService))
+    {
+        if ((srcTotalDataLenInBytes > DC_BUFFER_MAX_SIZE) ||
+            (dstTotalDataLenInBytes > DC_BUFFER_MAX_SIZE))
+        {
+            LAC_INVALID_PARAM_LOG("The buffer sizes need to be less than or "
+                                  "equal to 2^32-1 bytes");
+            return CPA_STATUS_INVALID_PARAM;
+        }
+
+        if (dstTotalDataLenInBytes <
+            ((DC_COMPRESSION_REQUEST == compDecomp)
+                 ? pSessionDesc->minCompDestBuffSize
+                 : DC_DEST_BUFFER_DEC_MIN_SIZE))
+        {
+            LAC_INVALID_PARAM_LOG("Destination buffer too small");
+            return CPA_STATUS_INVALID_PARAM;
+        }
+
+        if ((CPA_DC_STATELESS == pSessionDesc->sessState) &&
+            (0 == srcTotalDataLenInBytes))
+        {
+            LAC_INVALID_PARAM_LOG("The source buffer size needs to be "
+                                  "greater than zero bytes for stateless "
+                                  "sessions");
+            return CPA_STATUS_INVALID_PARAM;
+        }
+    }
+#endif
+
     /* Populate the compression cookie */
     pCookie->dcInstance = pService;
     pCookie->pSessionHandle = pSessionHandle;
@@ -1432,6 +1596,7 @@ CpaStatus dcCreateRequest(dc_compression_cookie_t *pCookie,
     pCookie->pDcOpData = pOpData;
     pCookie->pResults = pResults;
     pCookie->compDecomp = compDecomp;
+    pCookie->pCbFunc = NULL;
 #ifdef ICP_DC_ERROR_SIMULATION
     /* Inject DC error in cookie if simulation is active */
     if (dcErrorSimEnabled())
@@ -2144,25 +2309,6 @@ STATIC CpaBoolean dcZeroLengthRequests(sal_compression_service_t *pService,
     return CPA_FALSE;
 }
 
-CpaStatus cpaDcBPCompressData(CpaInstanceHandle dcInstance,
-                              CpaDcSessionHandle pSessionHandle,
-                              const Cpa32U numRequests,
-                              CpaDcBatchOpData *pBatchOpData,
-                              CpaBufferList *pDestBuff,
-                              CpaDcRqResults *pResults,
-                              void *callbackTag)
-{
-    LAC_UNUSED_VARIABLE(dcInstance);
-    LAC_UNUSED_VARIABLE(pSessionHandle);
-    LAC_UNUSED_VARIABLE(numRequests);
-    LAC_UNUSED_VARIABLE(pBatchOpData);
-    LAC_UNUSED_VARIABLE(pDestBuff);
-    LAC_UNUSED_VARIABLE(pResults);
-    LAC_UNUSED_VARIABLE(callbackTag);
-
-    return CPA_STATUS_UNSUPPORTED;
-}
-
 #ifdef ICP_PARAM_CHECK
 STATIC CpaStatus dcParamCheck(const CpaInstanceHandle dcInstance,
                               const CpaDcSessionHandle pSessionHandle,
@@ -2201,112 +2347,802 @@ STATIC CpaStatus dcParamCheck(const CpaInstanceHandle dcInstance,
 }
 #endif
 
-CpaStatus cpaDcCompressData(CpaInstanceHandle dcInstance,
-                            CpaDcSessionHandle pSessionHandle,
-                            CpaBufferList *pSrcBuff,
-                            CpaBufferList *pDestBuff,
-                            CpaDcRqResults *pResults,
-                            CpaDcFlush flushFlag,
-                            void *callbackTag)
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Get the destination slot size of a Batch and Pack request
+ *
+ * @description
+ *      The slot of each request is sized to the compress bound of its source
+ *      data so that no request of the batch can overflow into the next one.
+ *
+ * @param[in]   pService              Pointer to the compression service
+ * @param[in]   pSessionDesc          Pointer to the session descriptor
+ * @param[in]   srcBuffSize           Size of the source buffer
+ * @param[out]  pSlotSize             Size of the destination slot
+ *
+ * @retval CPA_STATUS_SUCCESS         Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_UNSUPPORTED     Compression type not supported
+ *
+ *****************************************************************************/
+STATIC CpaStatus dcBPSlotSizeGet(sal_compression_service_t *pService,
+                                 dc_session_desc_t *pSessionDesc,
+                                 Cpa32U srcBuffSize,
+                                 Cpa32U *pSlotSize)
 {
-    sal_compression_service_t *pService = NULL;
-    dc_session_desc_t *pSessionDesc = NULL;
-    CpaInstanceHandle insHandle = NULL;
-    Cpa64U srcBuffSize = 0;
-
-#ifdef ICP_TRACE
-    LAC_LOG7("Called with params (0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx, "
-             "0x%x, 0x%lx)\n",
-             (LAC_ARCH_UINT)dcInstance,
-             (LAC_ARCH_UINT)pSessionHandle,
-             (LAC_ARCH_UINT)pSrcBuff,
-             (LAC_ARCH_UINT)pDestBuff,
-             (LAC_ARCH_UINT)pResults,
-             flushFlag,
-             (LAC_ARCH_UINT)callbackTag);
-#endif
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U minSize = pService->comp_device_data.minOutputBuffSize;
 
-    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    switch (pSessionDesc->compType)
     {
-        insHandle = dcGetFirstHandle();
+        case CPA_DC_LZ4:
+            status = cpaDcLZ4CompressBound(pService, srcBuffSize, pSlotSize);
+            break;
+        case CPA_DC_LZ4S:
+            status = cpaDcLZ4SCompressBound(pService, srcBuffSize, pSlotSize);
+            break;
+        default:
+            status = cpaDcDeflateCompressBound(
+                pService, pSessionDesc->huffType, srcBuffSize, pSlotSize);
+            break;
     }
-    else
+
+    if (CPA_DC_HT_FULL_DYNAMIC == pSessionDesc->huffType)
     {
-        insHandle = dcInstance;
+        minSize = pService->comp_device_data.minOutputBuffSizeDynamic;
     }
 
-    pService = (sal_compression_service_t *)insHandle;
+    if ((CPA_STATUS_SUCCESS == status) && (*pSlotSize < minSize))
+    {
+        *pSlotSize = minSize;
+    }
 
-#ifdef ICP_PARAM_CHECK
-    LAC_CHECK_NULL_PARAM(insHandle);
-    LAC_CHECK_NULL_PARAM(pSessionHandle);
-    SAL_CHECK_ADDR_TRANS_SETUP(insHandle);
-#endif
+    return status;
+}
 
-    /* Check if SAL is initialised otherwise return an error */
-    SAL_RUNNING_CHECK(insHandle);
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Carve the next Batch and Pack slot out of the destination buffer list
+ *
+ * @description
+ *      The data area of the destination buffer list is made of the flat
+ *      buffers following the header buffer. Slots are allocated in order
+ *      from this area; pBuffIndex and pBuffOffset track the start of the
+ *      next free slot.
+ *
+ * @param[out]     pSlot              Slot to populate
+ * @param[in]      pDestBuff          User destination buffer list
+ * @param[in,out]  pBuffIndex         Index of the flat buffer of the cursor
+ * @param[in,out]  pBuffOffset        Offset of the cursor in that buffer
+ * @param[in]      slotSize           Size of the slot in bytes
+ *
+ * @retval CPA_TRUE                   The slot was allocated
+ * @retval CPA_FALSE                  The destination buffer list is full
+ *
+ *****************************************************************************/
+STATIC CpaBoolean dcBPSlotBuild(dc_bp_slot_t *pSlot,
+                                CpaBufferList *pDestBuff,
+                                Cpa32U *pBuffIndex,
+                                Cpa32U *pBuffOffset,
+                                Cpa32U slotSize)
+{
+    CpaFlatBuffer *pFlatBuff = NULL;
+    Cpa32U buffIndex = *pBuffIndex;
+    Cpa32U buffOffset = *pBuffOffset;
+    Cpa32U remaining = slotSize;
+    Cpa32U numBuffers = 0;
+    Cpa32U len = 0;
 
-    /* This check is outside the parameter checking as it is needed to manage
-     * zero length requests */
-    if (LacBuffDesc_BufferListVerifyNull(
-            pSrcBuff, &srcBuffSize, LAC_NO_ALIGNMENT_SHIFT) !=
-        CPA_STATUS_SUCCESS)
+    while (remaining > 0)
     {
-        LAC_INVALID_PARAM_LOG("Invalid source buffer list parameter");
-        return CPA_STATUS_INVALID_PARAM;
+        if ((buffIndex >= pDestBuff->numBuffers) ||
+            (DC_BP_MAX_SLOT_BUFFERS == numBuffers))
+        {
+            return CPA_FALSE;
+        }
+
+        pFlatBuff = &pDestBuff->pBuffers[buffIndex];
+        len = pFlatBuff->dataLenInBytes - buffOffset;
+        if (len > remaining)
+        {
+            len = remaining;
+        }
+
+        if (len > 0)
+        {
+            pSlot->destBuffers[numBuffers].pData = pFlatBuff->pData + buffOffset;
+            pSlot->destBuffers[numBuffers].dataLenInBytes = len;
+            numBuffers++;
+            buffOffset += len;
+            remaining -= len;
+        }
+
+        if (buffOffset == pFlatBuff->dataLenInBytes)
+        {
+            buffIndex++;
+            buffOffset = 0;
+        }
     }
 
-#ifdef ICP_PARAM_CHECK
-    /* Ensure this is a compression instance */
-    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
-#endif
+    pSlot->destList.numBuffers = numBuffers;
+    pSlot->destList.pBuffers = pSlot->destBuffers;
+    pSlot->destList.pUserData = NULL;
+    pSlot->destList.pPrivateMetaData = pSlot->destMetaData;
 
-    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+    *pBuffIndex = buffIndex;
+    *pBuffOffset = buffOffset;
 
-#ifdef ICP_PARAM_CHECK
-    if (CPA_STATUS_SUCCESS != dcParamCheck(insHandle,
-                                           pSessionHandle,
-                                           pService,
-                                           pSrcBuff,
-                                           pDestBuff,
-                                           pResults,
-                                           pSessionDesc,
-                                           flushFlag,
-                                           srcBuffSize))
+    return CPA_TRUE;
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Move data within the data area of a Batch and Pack destination
+ *
+ * @description
+ *      Moves len bytes from srcOffset to dstOffset of the data area of the
+ *      destination buffer list. The copy runs in ascending order, so it is
+ *      safe for overlapping regions as long as dstOffset <= srcOffset, which
+ *      always holds when packing.
+ *
+ * @param[in]   pDestBuff             User destination buffer list
+ * @param[in]   dstOffset             Offset of the destination
+ * @param[in]   srcOffset             Offset of the source
+ * @param[in]   len                   Number of bytes to move
+ *
+ *****************************************************************************/
+STATIC void dcBPDataMove(CpaBufferList *pDestBuff,
+                         Cpa64U dstOffset,
+                         Cpa64U srcOffset,
+                         Cpa32U len)
+{
+    CpaFlatBuffer *pBuffers = pDestBuff->pBuffers;
+    Cpa32U dstIndex = 1, srcIndex = 1;
+    Cpa32U chunk = 0;
+
+    if ((dstOffset == srcOffset) || (0 == len))
     {
-        return CPA_STATUS_INVALID_PARAM;
+        return;
     }
-#endif
 
-#ifdef ICP_DC_DYN_NOT_SUPPORTED
-    if (CPA_DC_HT_FULL_DYNAMIC == pSessionDesc->huffType)
+    while (dstOffset >= pBuffers[dstIndex].dataLenInBytes)
     {
-        LAC_INVALID_PARAM_LOG("Invalid huffType value, dynamic sessions "
-                              "not supported");
-        return CPA_STATUS_INVALID_PARAM;
+        dstOffset -= pBuffers[dstIndex].dataLenInBytes;
+        dstIndex++;
+    }
+    while (srcOffset >= pBuffers[srcIndex].dataLenInBytes)
+    {
+        srcOffset -= pBuffers[srcIndex].dataLenInBytes;
+        srcIndex++;
     }
-#endif
 
-    if (CPA_DC_STATEFUL == pSessionDesc->sessState)
+    while (len > 0)
     {
-        LAC_INVALID_PARAM_LOG("Invalid session state, stateful sessions "
-                              "are not supported");
-        return CPA_STATUS_UNSUPPORTED;
+        chunk = len;
+        if (chunk > pBuffers[dstIndex].dataLenInBytes - dstOffset)
+        {
+            chunk = pBuffers[dstIndex].dataLenInBytes - (Cpa32U)dstOffset;
+        }
+        if (chunk > pBuffers[srcIndex].dataLenInBytes - srcOffset)
+        {
+            chunk = pBuffers[srcIndex].dataLenInBytes - (Cpa32U)srcOffset;
+        }
+
+        memmove(pBuffers[dstIndex].pData + dstOffset,
+                pBuffers[srcIndex].pData + srcOffset,
+                chunk);
+
+        len -= chunk;
+        dstOffset += chunk;
+        srcOffset += chunk;
+
+        while ((len > 0) &&
+               (dstOffset == pBuffers[dstIndex].dataLenInBytes))
+        {
+            dstIndex++;
+            dstOffset = 0;
+        }
+        while ((len > 0) &&
+               (srcOffset == pBuffers[srcIndex].dataLenInBytes))
+        {
+            srcIndex++;
+            srcOffset = 0;
+        }
     }
+}
 
-    if (!(pService->generic_service_info.dcExtendedFeatures &
-          DC_CNV_EXTENDED_CAPABILITY))
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Complete a Batch and Pack request
+ *
+ * @description
+ *      Called once every request of the batch has completed. The compressed
+ *      outputs are packed back to back at the start of the data area, the
+ *      size of each output is written to the header buffer and the user
+ *      callback is invoked. A request that failed contributes no data.
+ *
+ * @param[in]   pBatch                Pointer to the batch context
+ *
+ *****************************************************************************/
+STATIC void dcBPBatchComplete(dc_bp_batch_t *pBatch)
+{
+    CpaBufferList *pDestBuff = pBatch->pDestBuff;
+    Cpa32U *pHeader = (Cpa32U *)pDestBuff->pBuffers[0].pData;
+    CpaDcCallbackFn pCbFunc = pBatch->pCbFunc;
+    void *callbackTag = pBatch->callbackTag;
+    CpaStatus status = pBatch->status;
+    CpaDcRqResults *pResults = NULL;
+    Cpa64U packedOffset = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBatch->numRequests; i++)
     {
-        LAC_INVALID_PARAM_LOG("CompressAndVerify feature not supported");
-        return CPA_STATUS_UNSUPPORTED;
+        pResults = &pBatch->pResults[i];
+        if (CPA_DC_OK != pResults->status)
+        {
+            pResults->produced = 0;
+        }
+
+        dcBPDataMove(pDestBuff,
+                     packedOffset,
+                     pBatch->slots[i].offset,
+                     pResults->produced);
+        pHeader[i] = pResults->produced;
+        packedOffset += pResults->produced;
     }
 
-    if (!(pService->generic_service_info.dcExtendedFeatures &
-          DC_CNVNR_EXTENDED_CAPABILITY))
+    Lac_MemPoolEntryFree(pBatch);
+
+    if (NULL != pCbFunc)
     {
-        LAC_INVALID_PARAM_LOG(
-            "CompressAndVerifyAndRecovery feature not supported");
-        return CPA_STATUS_UNSUPPORTED;
+        pCbFunc(callbackTag, status);
+    }
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Callback of a request that is part of a batch
+ *
+ * @description
+ *      Called from the common compression callback in place of the session
+ *      callback. The batch is completed when its last request comes back.
+ *
+ * @param[in]   callbackTag           Pointer to the batch context
+ * @param[in]   status                Status of the request
+ *
+ *****************************************************************************/
+STATIC void dcBPCallback(void *callbackTag, CpaStatus status)
+{
+    dc_bp_batch_t *pBatch = (dc_bp_batch_t *)callbackTag;
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        pBatch->status = status;
+    }
+
+    if (0 == osalAtomicDec(&pBatch->pendingCbCount))
+    {
+        dcBPBatchComplete(pBatch);
+    }
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Submit a Batch and Pack request
+ *
+ * @description
+ *      Each request of the batch is built as a regular stateless compression
+ *      request writing into its own slot of the destination buffer list. All
+ *      the requests are then put on the ring together so that the device is
+ *      notified once for the whole batch. The batch is truncated if the
+ *      destination buffer list or the memory pool runs out; the requests
+ *      that were not submitted report zero bytes consumed and produced.
+ *
+ * @param[in]   pService              Pointer to the compression service
+ * @param[in]   pSessionDesc          Pointer to the session descriptor
+ * @param[in]   pSessionHandle        Session handle
+ * @param[in]   numRequests           Number of requests in the batch
+ * @param[in]   pBatchOpData          Array of request descriptions
+ * @param[in]   pDestBuff             User destination buffer list
+ * @param[in]   pResults              Array of results structures
+ * @param[in]   callbackTag           Pointer to the callback tag
+ *
+ * @retval CPA_STATUS_SUCCESS         Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM   Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE        Resource error
+ * @retval CPA_STATUS_RETRY           Resubmit the request
+ *
+ *****************************************************************************/
+STATIC CpaStatus dcBPCompressData(sal_compression_service_t *pService,
+                                  dc_session_desc_t *pSessionDesc,
+                                  CpaDcSessionHandle pSessionHandle,
+                                  Cpa32U numRequests,
+                                  CpaDcBatchOpData *pBatchOpData,
+                                  CpaBufferList *pDestBuff,
+                                  CpaDcRqResults *pResults,
+                                  void *callbackTag)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    dc_bp_batch_t *pBatch = NULL;
+    dc_bp_slot_t *pSlot = NULL;
+    dc_compression_cookie_t *pCookie = NULL;
+    dc_compression_cookie_t *pCookies[DC_BP_MAX_REQUESTS];
+    void *pMsgs[DC_BP_MAX_REQUESTS];
+    Cpa64U seqNums[DC_BP_MAX_REQUESTS];
+    CpaDcOpData *pOpData = NULL;
+    Cpa32U *pHeader = (Cpa32U *)pDestBuff->pBuffers[0].pData;
+    Cpa64U srcBuffSize = 0;
+    Cpa64U slotOffset = 0;
+    Cpa32U slotSize = 0;
+    Cpa32U buffIndex = 1;
+    Cpa32U buffOffset = 0;
+    Cpa32U numBatch = 0;
+    Cpa32U numPut = 0;
+    Cpa32U i = 0;
+    dc_cnv_mode_t cnvMode = DC_NO_CNV;
+
+    pBatch =
+        (dc_bp_batch_t *)Lac_MemPoolEntryAlloc(pService->bp_batch_mem_pool);
+    if (NULL == pBatch)
+    {
+        LAC_LOG_ERROR("Cannot get mem pool entry for batch and pack");
+        return CPA_STATUS_RESOURCE;
+    }
+    else if ((void *)CPA_STATUS_RETRY == pBatch)
+    {
+        return CPA_STATUS_RETRY;
+    }
+
+    for (i = 0; (i < numRequests) && (i < DC_BP_MAX_REQUESTS); i++)
+    {
+        pSlot = &pBatch->slots[i];
+        pOpData = &pBatchOpData[i].opData;
+
+        if (CPA_STATUS_SUCCESS !=
+            LacBuffDesc_BufferListVerifyNull(pBatchOpData[i].pSrcBuff,
+                                             &srcBuffSize,
+                                             LAC_NO_ALIGNMENT_SHIFT))
+        {
+            LAC_INVALID_PARAM_LOG("Invalid source buffer list parameter");
+            status = CPA_STATUS_INVALID_PARAM;
+            break;
+        }
+
+        status = dcBPSlotSizeGet(
+            pService, pSessionDesc, (Cpa32U)srcBuffSize, &slotSize);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+
+        /* Out of destination space, the batch is truncated here */
+        if (CPA_FALSE ==
+            dcBPSlotBuild(pSlot, pDestBuff, &buffIndex, &buffOffset, slotSize))
+        {
+            break;
+        }
+        pSlot->offset = slotOffset;
+        slotOffset += slotSize;
+
+#ifdef ICP_PARAM_CHECK
+        if ((CPA_STATUS_SUCCESS != dcParamCheck(pService,
+                                                pSessionHandle,
+                                                pService,
+                                                pBatchOpData[i].pSrcBuff,
+                                                &pSlot->destList,
+                                                &pResults[i],
+                                                pSessionDesc,
+                                                pOpData->flushFlag,
+                                                srcBuffSize)) ||
+            (CPA_STATUS_SUCCESS != dcCheckOpData(pService, pOpData)))
+        {
+            status = CPA_STATUS_INVALID_PARAM;
+            break;
+        }
+#endif
+
+        if (!(pService->generic_service_info.dcExtendedFeatures &
+              DC_CNV_EXTENDED_CAPABILITY) &&
+            (CPA_TRUE == pOpData->compressAndVerify))
+        {
+            LAC_INVALID_PARAM_LOG("CompressAndVerify feature not supported");
+            status = CPA_STATUS_UNSUPPORTED;
+            break;
+        }
+
+        cnvMode = DC_NO_CNV;
+        if (CPA_TRUE == pOpData->compressAndVerifyAndRecover)
+        {
+            cnvMode = DC_CNVNR;
+        }
+        else if (CPA_TRUE == pOpData->compressAndVerify)
+        {
+            cnvMode = DC_CNV;
+        }
+
+        pCookie = (dc_compression_cookie_t *)Lac_MemPoolEntryAlloc(
+            pService->compression_mem_pool);
+        if (NULL == pCookie)
+        {
+            LAC_LOG_ERROR("Cannot get mem pool entry for compression");
+            status = CPA_STATUS_RESOURCE;
+            break;
+        }
+        else if ((void *)CPA_STATUS_RETRY == pCookie)
+        {
+            /* Out of cookies, the batch is truncated here */
+            if (0 == numBatch)
+            {
+                status = CPA_STATUS_RETRY;
+            }
+            break;
+        }
+
+        pCookie->dcChain.isDcChaining = CPA_FALSE;
+
+        status = dcCreateRequest(pCookie,
+                                 pService,
+                                 pSessionDesc,
+                                 pSessionHandle,
+                                 pBatchOpData[i].pSrcBuff,
+                                 &pSlot->destList,
+                                 &pResults[i],
+                                 pOpData->flushFlag,
+                                 pOpData,
+                                 pBatch,
+                                 DC_COMPRESSION_REQUEST,
+                                 cnvMode);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            Lac_MemPoolEntryFree(pCookie);
+            break;
+        }
+
+        pCookie->pCbFunc = dcBPCallback;
+        pCookies[numBatch] = pCookie;
+        pMsgs[numBatch] = &(pCookie->request);
+        numBatch++;
+    }
+
+    if ((CPA_STATUS_SUCCESS == status) && (0 == numBatch))
+    {
+        LAC_INVALID_PARAM_LOG("Destination buffer too small for the first "
+                              "request of the batch");
+        status = CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        for (i = 0; i < numBatch; i++)
+        {
+            Lac_MemPoolEntryFree(pCookies[i]);
+        }
+        Lac_MemPoolEntryFree(pBatch);
+        return status;
+    }
+
+    pBatch->status = CPA_STATUS_SUCCESS;
+    pBatch->numRequests = numBatch;
+    pBatch->pCbFunc = pSessionDesc->pCompressionCb;
+    pBatch->callbackTag = callbackTag;
+    pBatch->pDestBuff = pDestBuff;
+    pBatch->pResults = pResults;
+
+    /* The submitter holds one extra reference so that the batch cannot
+     * complete before the unsent requests have been accounted for */
+    osalAtomicSet(numBatch + 1, &pBatch->pendingCbCount);
+    osalAtomicAdd(numBatch, &(pSessionDesc->pendingStatelessCbCount));
+
+    status = SalQatMsg_transPutMsgs(pService->trans_handle_compression_tx,
+                                    pMsgs,
+                                    LAC_QAT_DC_REQ_SZ_LW,
+                                    numBatch,
+                                    LAC_LOG_MSG_DC,
+                                    seqNums,
+                                    &numPut);
+
+    for (i = 0; i < numPut; i++)
+    {
+        LAC_MEM_POOL_BLK_SET_OPAQUE(pCookies[i], seqNums[i]);
+        COMPRESSION_STAT_INC(numCompRequests, pService);
+    }
+
+    for (i = numPut; i < numBatch; i++)
+    {
+        COMPRESSION_STAT_INC(numCompRequestsErrors, pService);
+        osalAtomicDec(&(pSessionDesc->pendingStatelessCbCount));
+        Lac_MemPoolEntryFree(pCookies[i]);
+    }
+
+    if (0 == numPut)
+    {
+        Lac_MemPoolEntryFree(pBatch);
+        return status;
+    }
+
+    pBatch->numRequests = numPut;
+    for (i = numPut; i < numRequests; i++)
+    {
+        pResults[i].status = CPA_DC_OK;
+        pResults[i].consumed = 0;
+        pResults[i].produced = 0;
+        pHeader[i] = 0;
+    }
+
+    if (0 == osalAtomicSub(numBatch - numPut + 1, &pBatch->pendingCbCount))
+    {
+        dcBPBatchComplete(pBatch);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus cpaDcBPCompressData(CpaInstanceHandle dcInstance,
+                              CpaDcSessionHandle pSessionHandle,
+                              const Cpa32U numRequests,
+                              CpaDcBatchOpData *pBatchOpData,
+                              CpaBufferList *pDestBuff,
+                              CpaDcRqResults *pResults,
+                              void *callbackTag)
+{
+    sal_compression_service_t *pService = NULL;
+    dc_session_desc_t *pSessionDesc = NULL;
+    CpaInstanceHandle insHandle = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+#ifdef ICP_TRACE
+    LAC_LOG7("Called with params (0x%lx, 0x%lx, %d, 0x%lx, 0x%lx, "
+             "0x%lx, 0x%lx)\n",
+             (LAC_ARCH_UINT)dcInstance,
+             (LAC_ARCH_UINT)pSessionHandle,
+             numRequests,
+             (LAC_ARCH_UINT)pBatchOpData,
+             (LAC_ARCH_UINT)pDestBuff,
+             (LAC_ARCH_UINT)pResults,
+             (LAC_ARCH_UINT)callbackTag);
+#endif
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+    pService = (sal_compression_service_t *)insHandle;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(insHandle);
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pBatchOpData);
+    LAC_CHECK_NULL_PARAM(pDestBuff);
+    LAC_CHECK_NULL_PARAM(pResults);
+    SAL_CHECK_ADDR_TRANS_SETUP(insHandle);
+#endif
+
+    /* Check if SAL is initialised otherwise return an error */
+    SAL_RUNNING_CHECK(insHandle);
+
+#ifdef ICP_PARAM_CHECK
+    /* Ensure this is a compression instance */
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+#endif
+
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+#endif
+
+    if (0 == numRequests)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid numRequests value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (CPA_DC_STATELESS != pSessionDesc->sessState)
+    {
+        LAC_INVALID_PARAM_LOG("Batch and Pack requires a stateless session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (CPA_DC_DIR_DECOMPRESS == pSessionDesc->sessDirection)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid sessDirection value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* The first flat buffer holds the header, the others the data */
+    if ((pDestBuff->numBuffers < 2) || (NULL == pDestBuff->pBuffers) ||
+        (NULL == pDestBuff->pBuffers[0].pData) ||
+        (pDestBuff->pBuffers[0].dataLenInBytes <
+         (numRequests * sizeof(Cpa32U))))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid destination buffer list parameter");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (LacSync_GenWakeupSyncCaller == pSessionDesc->pCompressionCb)
+    {
+        lac_sync_op_data_t *pSyncCallbackData = NULL;
+        CpaStatus syncStatus = CPA_STATUS_SUCCESS;
+
+        status = LacSync_CreateSyncCookie(&pSyncCallbackData);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+
+        status = dcBPCompressData(pService,
+                                  pSessionDesc,
+                                  pSessionHandle,
+                                  numRequests,
+                                  pBatchOpData,
+                                  pDestBuff,
+                                  pResults,
+                                  pSyncCallbackData);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            syncStatus = LacSync_WaitForCallback(
+                pSyncCallbackData, DC_SYNC_CALLBACK_TIMEOUT, &status, NULL);
+
+            /* If callback doesn't come back */
+            if (CPA_STATUS_SUCCESS != syncStatus)
+            {
+                COMPRESSION_STAT_INC(numCompCompletedErrors, pService);
+                LAC_LOG_ERROR("Callback timed out");
+                status = syncStatus;
+            }
+        }
+        else
+        {
+            /* As the Request was not sent the Callback will never
+             * be called, so need to indicate that we're finished
+             * with cookie so it can be destroyed. */
+            LacSync_SetSyncCookieComplete(pSyncCallbackData);
+        }
+
+        LacSync_DestroySyncCookie(&pSyncCallbackData);
+        return status;
+    }
+
+    return dcBPCompressData(pService,
+                            pSessionDesc,
+                            pSessionHandle,
+                            numRequests,
+                            pBatchOpData,
+                            pDestBuff,
+                            pResults,
+                            callbackTag);
+}
+
+CpaStatus cpaDcCompressData(CpaInstanceHandle dcInstance,
+                            CpaDcSessionHandle pSessionHandle,
+                            CpaBufferList *pSrcBuff,
+                            CpaBufferList *pDestBuff,
+                            CpaDcRqResults *pResults,
+                            CpaDcFlush flushFlag,
+                            void *callbackTag)
+{
+    sal_compression_service_t *pService = NULL;
+    dc_session_desc_t *pSessionDesc = NULL;
+    CpaInstanceHandle insHandle = NULL;
+    Cpa64U srcBuffSize = 0;
+
+#ifdef ICP_TRACE
+    LAC_LOG7("Called with params (0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx, "
+             "0x%x, 0x%lx)\n",
+             (LAC_ARCH_UINT)dcInstance,
+             (LAC_ARCH_UINT)pSessionHandle,
+             (LAC_ARCH_UINT)pSrcBuff,
+             (LAC_ARCH_UINT)pDestBuff,
+             (LAC_ARCH_UINT)pResults,
+             flushFlag,
+             (LAC_ARCH_UINT)callbackTag);
+#endif
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+    pService = (sal_compression_service_t *)insHandle;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(insHandle);
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    SAL_CHECK_ADDR_TRANS_SETUP(insHandle);
+#endif
+
+    /* Check if SAL is initialised otherwise return an error */
+    SAL_RUNNING_CHECK(insHandle);
+
+    /* This check is outside the parameter checking as it is needed to manage
+     * zero length requests */
+    if (LacBuffDesc_BufferListVerifyNull(
+            pSrcBuff, &srcBuffSize, LAC_NO_ALIGNMENT_SHIFT) !=
+        CPA_STATUS_SUCCESS)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid source buffer list parameter");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    /* Ensure this is a compression instance */
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+#endif
+
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+
+#ifdef ICP_PARAM_CHECK
+    if (CPA_TRUE == DC_TRUSTED_CALLER(pService))
+    {
+        if (CPA_STATUS_SUCCESS != dcCheckTrustedRequest(pService,
+                                                        pSessionHandle,
+                                                        pSrcBuff,
+                                                        pDestBuff,
+                                                        pResults,
+                                                        flushFlag,
+                                                        NULL,
+                                                        DC_COMPRESSION_REQUEST))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+    }
+    else if (CPA_STATUS_SUCCESS != dcParamCheck(insHandle,
+                                                pSessionHandle,
+                                                pService,
+                                                pSrcBuff,
+                                                pDestBuff,
+                                                pResults,
+                                                pSessionDesc,
+                                                flushFlag,
+                                                srcBuffSize))
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+
+#ifdef ICP_DC_DYN_NOT_SUPPORTED
+    if (CPA_DC_HT_FULL_DYNAMIC == pSessionDesc->huffType)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid huffType value, dynamic sessions "
+                              "not supported");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+
+    if (CPA_DC_STATEFUL == pSessionDesc->sessState)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid session state, stateful sessions "
+                              "are not supported");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    if (!(pService->generic_service_info.dcExtendedFeatures &
+          DC_CNV_EXTENDED_CAPABILITY))
+    {
+        LAC_INVALID_PARAM_LOG("CompressAndVerify feature not supported");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    if (!(pService->generic_service_info.dcExtendedFeatures &
+          DC_CNVNR_EXTENDED_CAPABILITY))
+    {
+        LAC_INVALID_PARAM_LOG(
+            "CompressAndVerifyAndRecovery feature not supported");
+        return CPA_STATUS_UNSUPPORTED;
     }
 
     return dcCompDecompData(pService,
@@ -2487,22 +3323,39 @@ CpaStatus cpaDcCompressData2(CpaInstanceHandle dcInstance,
         }
     }
 #ifdef ICP_PARAM_CHECK
-    if (CPA_STATUS_SUCCESS != dcParamCheck(insHandle,
-                                           pSessionHandle,
-                                           pService,
-                                           pSrcBuff,
-                                           pDestBuff,
-                                           pResults,
-                                           pSessionDesc,
-                                           pOpData->flushFlag,
-                                           srcBuffSize))
+    if (CPA_TRUE == DC_TRUSTED_CALLER(pService))
     {
-        return CPA_STATUS_INVALID_PARAM;
+        if (CPA_STATUS_SUCCESS != dcCheckTrustedRequest(pService,
+                                                        pSessionHandle,
+                                                        pSrcBuff,
+                                                        pDestBuff,
+                                                        pResults,
+                                                        CPA_DC_FLUSH_NONE,
+                                                        pOpData,
+                                                        DC_COMPRESSION_REQUEST))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
     }
-
-    if (CPA_STATUS_SUCCESS != dcCheckOpData(pService, pOpData))
+    else
     {
-        return CPA_STATUS_INVALID_PARAM;
+        if (CPA_STATUS_SUCCESS != dcParamCheck(insHandle,
+                                               pSessionHandle,
+                                               pService,
+                                               pSrcBuff,
+                                               pDestBuff,
+                                               pResults,
+                                               pSessionDesc,
+                                               pOpData->flushFlag,
+                                               srcBuffSize))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+
+        if (CPA_STATUS_SUCCESS != dcCheckOpData(pService, pOpData))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
     }
 #endif
 #ifdef ICP_DC_DYN_NOT_SUPPORTED
@@ -2627,23 +3480,42 @@ CpaStatus cpaDcDecompressData(CpaInstanceHandle dcInstance,
     /* Ensure this is a compression instance */
     SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
 
-    if (dcCheckSourceData(pSessionHandle,
-                          pSrcBuff,
-                          pDestBuff,
-                          pResults,
-                          flushFlag,
-                          srcBuffSize,
-                          NULL) != CPA_STATUS_SUCCESS)
+    if (CPA_TRUE == DC_TRUSTED_CALLER(pService))
     {
-        return CPA_STATUS_INVALID_PARAM;
+        if (CPA_STATUS_SUCCESS !=
+            dcCheckTrustedRequest(pService,
+                                  pSessionHandle,
+                                  pSrcBuff,
+                                  pDestBuff,
+                                  pResults,
+                                  flushFlag,
+                                  NULL,
+                                  DC_DECOMPRESSION_REQUEST))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
     }
-
-    if (dcCheckDestinationData(pService,
-                               pSessionHandle,
-                               pDestBuff,
-                               DC_DECOMPRESSION_REQUEST) != CPA_STATUS_SUCCESS)
+    else
     {
-        return CPA_STATUS_INVALID_PARAM;
+        if (dcCheckSourceData(pSessionHandle,
+                              pSrcBuff,
+                              pDestBuff,
+                              pResults,
+                              flushFlag,
+                              srcBuffSize,
+                              NULL) != CPA_STATUS_SUCCESS)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+
+        if (dcCheckDestinationData(pService,
+                                   pSessionHandle,
+                                   pDestBuff,
+                                   DC_DECOMPRESSION_REQUEST) !=
+            CPA_STATUS_SUCCESS)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
     }
 #endif
     pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
@@ -2775,27 +3647,44 @@ CpaStatus cpaDcDecompressData2(CpaInstanceHandle dcInstance,
     /* Ensure this is a compression instance */
     SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
 
-    if (CPA_STATUS_SUCCESS != dcCheckSourceData(pSessionHandle,
-                                                pSrcBuff,
-                                                pDestBuff,
-                                                pResults,
-                                                CPA_DC_FLUSH_NONE,
-                                                srcBuffSize,
-                                                NULL))
+    if (CPA_TRUE == DC_TRUSTED_CALLER(pService))
     {
-        return CPA_STATUS_INVALID_PARAM;
+        if (CPA_STATUS_SUCCESS !=
+            dcCheckTrustedRequest(pService,
+                                  pSessionHandle,
+                                  pSrcBuff,
+                                  pDestBuff,
+                                  pResults,
+                                  CPA_DC_FLUSH_NONE,
+                                  pOpData,
+                                  DC_DECOMPRESSION_REQUEST))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
     }
-    if (CPA_STATUS_SUCCESS != dcCheckDestinationData(pService,
-                                                     pSessionHandle,
-                                                     pDestBuff,
-                                                     DC_DECOMPRESSION_REQUEST))
+    else
     {
-        return CPA_STATUS_INVALID_PARAM;
-    }
+        if (CPA_STATUS_SUCCESS != dcCheckSourceData(pSessionHandle,
+                                                    pSrcBuff,
+                                                    pDestBuff,
+                                                    pResults,
+                                                    CPA_DC_FLUSH_NONE,
+                                                    srcBuffSize,
+                                                    NULL))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        if (CPA_STATUS_SUCCESS !=
+            dcCheckDestinationData(
+                pService, pSessionHandle, pDestBuff, DC_DECOMPRESSION_REQUEST))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
 
-    if (CPA_STATUS_SUCCESS != dcCheckOpData(pService, pOpData))
-    {
-        return CPA_STATUS_INVALID_PARAM;
+        if (CPA_STATUS_SUCCESS != dcCheckOpData(pService, pOpData))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
     }
 #endif
 
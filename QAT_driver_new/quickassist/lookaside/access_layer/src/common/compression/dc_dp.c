@@ -67,6 +67,7 @@
 #include "dc_session.h"
 #include "dc_datapath.h"
 #include "dc_ns_datapath.h"
+#include "dc_inter_buff_pool.h"
 #include "lac_common.h"
 #include "lac_mem.h"
 #include "lac_mem_pools.h"
@@ -79,6 +80,36 @@
 #include "icp_sal_poll.h"
 #include "sal_hw_gen.h"
 
+#ifndef ICP_DC_DYN_NOT_SUPPORTED
+/**
+ *****************************************************************************
+ * @ingroup cpaDcDp
+ *      Attach an NS request to the shared intermediate buffers
+ *
+ * @description
+ *      No session is initialised on the NS data plane path, so an instance
+ *      started without intermediate buffers borrows the shared pool of its
+ *      device here. The pool is released by cpaDcStopInstance.
+ *
+ * @param[in]       pOpData          Pointer to a structure containing the
+ *                                   request parameters
+ *
+ *****************************************************************************/
+STATIC void dcDpNsInterBuffAttach(const CpaDcDpOpData *pOpData)
+{
+    sal_compression_service_t *pService =
+        (sal_compression_service_t *)(pOpData->dcInstance);
+
+    if ((NULL != pOpData->pSetupData) && isDcGen2x(pService) &&
+        (CPA_DC_DIR_DECOMPRESS != pOpData->pSetupData->sessDirection) &&
+        (CPA_DC_HT_FULL_DYNAMIC == pOpData->pSetupData->huffType) &&
+        (0 == pService->pInterBuffPtrsArrayPhyAddr))
+    {
+        (void)dcInterBuffPoolAttach(pService);
+    }
+}
+#endif
+
 #ifdef ICP_PARAM_CHECK
 /**
  *****************************************************************************
@@ -279,6 +310,8 @@ STATIC CpaStatus dcDataPlaneParamCheck(const CpaDcDpOpData *pOpData)
 #ifndef ICP_DC_DYN_NOT_SUPPORTED
         if (CPA_DC_HT_FULL_DYNAMIC == huffType)
         {
+            dcDpNsInterBuffAttach(pOpData);
+
             /* Check if Intermediate Buffer Array pointer is NULL */
             if (isDcGen2x(pService) &&
                 ((0 == pService->pInterBuffPtrsArrayPhyAddr) ||
@@ -508,7 +541,7 @@ STATIC CpaStatus dcDpWriteRingMsg(CpaDcDpOpData *pOpData,
         }
         else
         {
-            status = dcNsCreateBaseRequest(
+            status = dcNsGetBaseRequest(
                 pCurrentQatMsg, pService, pOpData->pSetupData);
 
             if (CPA_STATUS_SUCCESS != status)
@@ -618,6 +651,10 @@ CpaStatus cpaDcDpEnqueueOp(CpaDcDpOpData *pOpData,
     /* Check if SAL is initialised otherwise return an error */
     SAL_RUNNING_CHECK(pOpData->dcInstance);
 
+#if !defined(ICP_PARAM_CHECK) && !defined(ICP_DC_DYN_NOT_SUPPORTED)
+    dcDpNsInterBuffAttach(pOpData);
+#endif
+
     trans_handle = ((sal_compression_service_t *)pOpData->dcInstance)
                        ->trans_handle_compression_tx;
 
@@ -789,6 +826,13 @@ CpaStatus cpaDcDpEnqueueOpBatch(const Cpa32U numberRequests,
     /* Check if SAL is initialised otherwise return an error */
     SAL_RUNNING_CHECK(pOpData[0]->dcInstance);
 
+#if !defined(ICP_PARAM_CHECK) && !defined(ICP_DC_DYN_NOT_SUPPORTED)
+    for (i = 0; i < numberRequests; i++)
+    {
+        dcDpNsInterBuffAttach(pOpData[i]);
+    }
+#endif
+
     trans_handle = ((sal_compression_service_t *)pOpData[0]->dcInstance)
                        ->trans_handle_compression_tx;
 
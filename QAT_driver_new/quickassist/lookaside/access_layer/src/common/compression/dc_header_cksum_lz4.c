@@ -59,9 +59,66 @@ static const Cpa32U XXHASH_PRIME32_C = 0xC2B2AE3DU;
 static const Cpa32U XXHASH_PRIME32_D = 0x27D4EB2FU;
 static const Cpa32U XXHASH_PRIME32_E = 0x165667B1U;
 
-#define XXH32_STRIP_SIZE 16
 #define ROTATE_LEFT_32(n, d) ((n << d) | (n >> (-d & 31)))
 
+STATIC INLINE Cpa32U dc_xxh32_read32(const Cpa8U *ptr)
+{
+    return *(const Cpa32U *)ptr;
+}
+
+STATIC INLINE Cpa32U dc_xxh32_round(Cpa32U accumulator, Cpa32U input)
+{
+    accumulator += input * XXHASH_PRIME32_B;
+    accumulator = ROTATE_LEFT_32(accumulator, 13);
+    return accumulator * XXHASH_PRIME32_A;
+}
+
+/* Consume all the full stripes of the input. The four lanes carry no
+ * dependency on each other so the loop keeps four multiplies in flight
+ * and can be vectorised by the compiler. Returns the number of bytes
+ * consumed. */
+STATIC Cpa32U dc_xxh32_consume_stripes(Cpa32U *acc,
+                                       const Cpa8U *ptr,
+                                       Cpa32U dataLength)
+{
+    const Cpa8U *start = ptr;
+    const Cpa8U *limit = ptr + (dataLength & ~(DC_XXH32_STRIPE_SIZE - 1));
+    Cpa32U acc1 = acc[0];
+    Cpa32U acc2 = acc[1];
+    Cpa32U acc3 = acc[2];
+    Cpa32U acc4 = acc[3];
+
+    while (ptr < limit)
+    {
+        acc1 = dc_xxh32_round(acc1, dc_xxh32_read32(ptr));
+        acc2 = dc_xxh32_round(acc2, dc_xxh32_read32(ptr + 4));
+        acc3 = dc_xxh32_round(acc3, dc_xxh32_read32(ptr + 8));
+        acc4 = dc_xxh32_round(acc4, dc_xxh32_read32(ptr + 12));
+        ptr += DC_XXH32_STRIPE_SIZE;
+    }
+
+    acc[0] = acc1;
+    acc[1] = acc2;
+    acc[2] = acc3;
+    acc[3] = acc4;
+
+    return (Cpa32U)(ptr - start);
+}
+
+STATIC INLINE Cpa32U dc_xxh32_merge_lanes(const Cpa32U *acc)
+{
+    return ROTATE_LEFT_32(acc[0], 1) + ROTATE_LEFT_32(acc[1], 7) +
+           ROTATE_LEFT_32(acc[2], 12) + ROTATE_LEFT_32(acc[3], 18);
+}
+
+STATIC INLINE void dc_xxh32_init_lanes(Cpa32U *acc, Cpa32U seed)
+{
+    acc[0] = seed + XXHASH_PRIME32_A + XXHASH_PRIME32_B;
+    acc[1] = seed + XXHASH_PRIME32_B;
+    acc[2] = seed;
+    acc[3] = seed - XXHASH_PRIME32_A;
+}
+
 STATIC Cpa32U dc_hdr_cksum_finalise(Cpa32U xxHash32)
 {
     xxHash32 = xxHash32 ^ (xxHash32 >> 15);
@@ -81,7 +138,7 @@ STATIC Cpa32U dc_hdr_cksum_consume_remaining(Cpa32U xxHash32Accumulator,
      * we have less than 4 bytes left in the buffer */
     while (remainingBytes >= 4)
     {
-        xxHash32Accumulator += *(Cpa32U *)ptr * XXHASH_PRIME32_C;
+        xxHash32Accumulator += dc_xxh32_read32(ptr) * XXHASH_PRIME32_C;
         xxHash32Accumulator =
             ROTATE_LEFT_32(xxHash32Accumulator, 17) * XXHASH_PRIME32_D;
         ptr += 4;
@@ -106,23 +163,31 @@ STATIC CpaStatus dc_hdr_cksum_calculate(const Cpa8U *xxH32input,
                                         Cpa32U *result)
 {
     Cpa32U xxHash32Accumulator = 0;
+    Cpa32U acc[4];
+    Cpa32U consumed = 0;
 #ifdef ICP_PARAM_CHECK
     /* Check for null parameters */
     LAC_CHECK_NULL_PARAM(xxH32input);
     LAC_CHECK_NULL_PARAM(result);
 #endif
 
-    if (dataLength < XXH32_STRIP_SIZE)
+    if (dataLength < DC_XXH32_STRIPE_SIZE)
+    {
         xxHash32Accumulator = seed + XXHASH_PRIME32_E;
-    else /* TODO: Add support for input buffer >= 16. */
-        return CPA_STATUS_FAIL;
+    }
+    else
+    {
+        dc_xxh32_init_lanes(acc, seed);
+        consumed = dc_xxh32_consume_stripes(acc, xxH32input, dataLength);
+        xxHash32Accumulator = dc_xxh32_merge_lanes(acc);
+    }
 
     /* Add data length to accumulator */
     xxHash32Accumulator += (Cpa32U)dataLength;
 
     /* Consume the remaining bytes of input (< 16) */
     *result = dc_hdr_cksum_consume_remaining(
-        xxHash32Accumulator, xxH32input, dataLength);
+        xxHash32Accumulator, xxH32input + consumed, dataLength - consumed);
 
     return CPA_STATUS_SUCCESS;
 }
@@ -146,3 +211,11 @@ CpaStatus dc_hdr_cksum(const void *xxH32input,
 
     return CPA_STATUS_SUCCESS;
 }
+
+CpaStatus dc_xxh32(const void *xxH32input,
+                   const Cpa32U dataLength,
+                   const Cpa32U seed,
+                   Cpa32U *result)
+{
+    return dc_hdr_cksum_calculate(xxH32input, dataLength, seed, result);
+}
@@ -0,0 +1,338 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file dc_inter_buff_pool.c
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Intermediate buffers shared by the compression instances of a device.
+ *      Dynamic compression on devices prior to gen4 needs DRAM intermediate
+ *      buffers, which the firmware uses per compression slice. As the slices
+ *      belong to the device and not to an instance, all the instances of a
+ *      device can share one set. The set is created when the first instance
+ *      needs it and freed with the last reference, instead of every instance
+ *      pinning a private copy passed to cpaDcStartInstance.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_dc.h"
+
+#include "icp_accel_devices.h"
+#include "icp_adf_accel_mgr.h"
+#include "icp_adf_cfg.h"
+#include "icp_buffer_desc.h"
+
+#include "dc_inter_buff_pool.h"
+#include "dc_ns_datapath.h"
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_sal_types.h"
+#include "sal_string_parse.h"
+#include "sal_types_compression.h"
+
+STATIC void dcInterBuffPoolFree(dc_inter_buff_pool_t *pPool)
+{
+    Cpa32U i = 0;
+
+    if (NULL != pPool->pBuffLists)
+    {
+        for (i = 0; i < pPool->numBuffLists; i++)
+        {
+            CpaBufferList *pList = &pPool->pBuffLists[i];
+
+            if (NULL != pList->pBuffers)
+            {
+                LAC_OS_CAFREE(pList->pBuffers->pData);
+            }
+            LAC_OS_CAFREE(pList->pPrivateMetaData);
+        }
+        LAC_OS_FREE(pPool->pBuffLists);
+    }
+    LAC_OS_CAFREE(pPool->pInterBuffPtrsArray);
+    LAC_OS_FREE(pPool);
+}
+
+/* Reads the size of the intermediate buffer lists from the configuration
+ * file, falling back to the default */
+STATIC Cpa32U dcInterBuffPoolGetSize(icp_accel_dev_t *device)
+{
+    char adfGetParam[ADF_CFG_MAX_VAL_LEN_IN_BYTES] = {0};
+    Cpa32U size = 0;
+
+    if (CPA_STATUS_SUCCESS ==
+        icp_adf_cfgGetParamValue(device,
+                                 LAC_CFG_SECTION_GENERAL,
+                                 SAL_CFG_DC_INTER_BUFF_SIZE,
+                                 adfGetParam))
+    {
+        size = (Cpa32U)Sal_Strtoul(adfGetParam, NULL, SAL_CFG_BASE_DEC);
+    }
+
+    return (0 != size) ? size : DC_INTER_BUFF_POOL_DEFAULT_SIZE;
+}
+
+STATIC CpaStatus dcInterBuffPoolCreate(sal_compression_service_t *pService,
+                                       icp_accel_dev_t *device,
+                                       dc_inter_buff_pool_t **ppPool)
+{
+    dc_inter_buff_pool_t *pPool = NULL;
+    icp_buffer_list_desc_t *pBufferListDesc = NULL;
+    CpaBufferList *pList = NULL;
+    CpaPhysicalAddr physAddr = 0;
+    Cpa32U metaSize = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = LAC_OS_MALLOC(&pPool, sizeof(dc_inter_buff_pool_t));
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    LAC_OS_BZERO(pPool, sizeof(dc_inter_buff_pool_t));
+    pPool->numBuffLists = pService->numInterBuffs;
+    pPool->buffListSize = dcInterBuffPoolGetSize(device);
+
+    /* One descriptor with a single flat buffer per list; the metadata is
+     * allocated with descriptor alignment so no adjustment is needed */
+    metaSize = sizeof(icp_buffer_list_desc_t) + sizeof(icp_flat_buffer_desc_t);
+
+    status = LAC_OS_CAMALLOC(&pPool->pInterBuffPtrsArray,
+                             pPool->numBuffLists * sizeof(icp_qat_addr_width_t),
+                             LAC_64BYTE_ALIGNMENT,
+                             pService->nodeAffinity);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        /* The flat buffers follow the array of buffer lists */
+        status = LAC_OS_MALLOC(&pPool->pBuffLists,
+                               pPool->numBuffLists * (sizeof(CpaBufferList) +
+                                                      sizeof(CpaFlatBuffer)));
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        dcInterBuffPoolFree(pPool);
+        return status;
+    }
+    LAC_OS_BZERO(pPool->pBuffLists,
+                 pPool->numBuffLists *
+                     (sizeof(CpaBufferList) + sizeof(CpaFlatBuffer)));
+
+    for (i = 0; i < pPool->numBuffLists; i++)
+    {
+        pList = &pPool->pBuffLists[i];
+        pList->numBuffers = 1;
+        pList->pBuffers =
+            (CpaFlatBuffer *)&pPool->pBuffLists[pPool->numBuffLists] + i;
+
+        status = LAC_OS_CAMALLOC(&pList->pPrivateMetaData,
+                                 metaSize,
+                                 LAC_64BYTE_ALIGNMENT,
+                                 pService->nodeAffinity);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = LAC_OS_CAMALLOC(&pList->pBuffers->pData,
+                                     pPool->buffListSize,
+                                     LAC_64BYTE_ALIGNMENT,
+                                     pService->nodeAffinity);
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            LAC_LOG_ERROR("Can not allocate shared intermediate buffers\n");
+            break;
+        }
+        pList->pBuffers->dataLenInBytes = pPool->buffListSize;
+
+        pBufferListDesc = (icp_buffer_list_desc_t *)pList->pPrivateMetaData;
+        pBufferListDesc->numBuffers = 1;
+        pBufferListDesc->phyBuffers[0].dataLenInBytes = pPool->buffListSize;
+        physAddr = LAC_OS_VIRT_TO_PHYS_INTERNAL(
+            &pService->generic_service_info, pList->pBuffers->pData);
+        pBufferListDesc->phyBuffers[0].phyBuffer =
+            LAC_MEM_CAST_PTR_TO_UINT64(physAddr);
+
+        physAddr = LAC_OS_VIRT_TO_PHYS_INTERNAL(
+            &pService->generic_service_info, pList->pPrivateMetaData);
+        pPool->pInterBuffPtrsArray[i] = LAC_MEM_CAST_PTR_TO_UINT64(physAddr);
+
+        if ((0 == pBufferListDesc->phyBuffers[0].phyBuffer) || (0 == physAddr))
+        {
+            LAC_LOG_ERROR("Unable to get the physical address of the shared "
+                          "intermediate buffers\n");
+            status = CPA_STATUS_FAIL;
+            break;
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pPool->pInterBuffPtrsArrayPhyAddr = LAC_OS_VIRT_TO_PHYS_INTERNAL(
+            &pService->generic_service_info, pPool->pInterBuffPtrsArray);
+        if (0 == pPool->pInterBuffPtrsArrayPhyAddr)
+        {
+            status = CPA_STATUS_FAIL;
+        }
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        dcInterBuffPoolFree(pPool);
+        return status;
+    }
+
+    *ppPool = pPool;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus dcInterBuffPoolInit(sal_t *pSal)
+{
+    pSal->pDcInterBuffPool = NULL;
+    return LAC_INIT_MUTEX(&pSal->dcInterBuffPoolLock);
+}
+
+void dcInterBuffPoolDestroy(sal_t *pSal)
+{
+    if (NULL != pSal->pDcInterBuffPool)
+    {
+        dcInterBuffPoolFree(pSal->pDcInterBuffPool);
+        pSal->pDcInterBuffPool = NULL;
+    }
+    LAC_DESTROY_MUTEX(&pSal->dcInterBuffPoolLock);
+}
+
+CpaStatus dcInterBuffPoolAttach(sal_compression_service_t *pService)
+{
+    icp_accel_dev_t *device = NULL;
+    sal_t *pSal = NULL;
+    dc_inter_buff_pool_t *pPool = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (0 == pService->numInterBuffs)
+    {
+        return CPA_STATUS_SUCCESS;
+    }
+
+    device = icp_adf_getAccelDevByAccelId(pService->acceleratorNum);
+    if ((NULL == device) || (NULL == device->pSalHandle))
+    {
+        LAC_LOG_ERROR("Can not find device for the instance\n");
+        return CPA_STATUS_FAIL;
+    }
+    pSal = (sal_t *)device->pSalHandle;
+
+    status = LAC_LOCK_MUTEX(&pSal->dcInterBuffPoolLock, OSAL_WAIT_FOREVER);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* Checked under the lock: sessions of one instance may race here */
+    if (0 == pService->pInterBuffPtrsArrayPhyAddr)
+    {
+        pPool = pSal->pDcInterBuffPool;
+        if (NULL == pPool)
+        {
+            status = dcInterBuffPoolCreate(pService, device, &pPool);
+            if (CPA_STATUS_SUCCESS == status)
+            {
+                pSal->pDcInterBuffPool = pPool;
+            }
+        }
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            pPool->refCount++;
+            pService->isInterBuffShared = CPA_TRUE;
+            pService->minInterBuffSizeInBytes = pPool->buffListSize;
+            pService->pInterBuffPtrsArray = pPool->pInterBuffPtrsArray;
+            pService->pInterBuffPtrsArrayPhyAddr =
+                pPool->pInterBuffPtrsArrayPhyAddr;
+            /* NS request templates embed the intermediate buffers address */
+            dcNsReqCacheInvalidate(pService);
+        }
+    }
+
+    LAC_UNLOCK_MUTEX(&pSal->dcInterBuffPoolLock);
+    return status;
+}
+
+void dcInterBuffPoolDetach(sal_compression_service_t *pService)
+{
+    icp_accel_dev_t *device = NULL;
+    sal_t *pSal = NULL;
+    dc_inter_buff_pool_t *pPool = NULL;
+
+    if (CPA_TRUE != pService->isInterBuffShared)
+    {
+        return;
+    }
+
+    device = icp_adf_getAccelDevByAccelId(pService->acceleratorNum);
+    if ((NULL == device) || (NULL == device->pSalHandle))
+    {
+        LAC_LOG_ERROR("Can not find device for the instance\n");
+        return;
+    }
+    pSal = (sal_t *)device->pSalHandle;
+
+    if (CPA_STATUS_SUCCESS !=
+        LAC_LOCK_MUTEX(&pSal->dcInterBuffPoolLock, OSAL_WAIT_FOREVER))
+    {
+        return;
+    }
+
+    pService->isInterBuffShared = CPA_FALSE;
+    pService->minInterBuffSizeInBytes = 0;
+    pService->pInterBuffPtrsArray = NULL;
+    pService->pInterBuffPtrsArrayPhyAddr = 0;
+    dcNsReqCacheInvalidate(pService);
+
+    pPool = pSal->pDcInterBuffPool;
+    if ((NULL != pPool) && (0 == --pPool->refCount))
+    {
+        pSal->pDcInterBuffPool = NULL;
+        dcInterBuffPoolFree(pPool);
+    }
+
+    LAC_UNLOCK_MUTEX(&pSal->dcInterBuffPoolLock);
+}
@@ -0,0 +1,2017 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file dc_lz4s_zstd.c
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Conversion of LZ4s into zstd frames. The accelerator does the match
+ *      finding and produces LZ4s; the literals and sequences are then
+ *      re-encoded here with the zstd entropy stages: Huffman coded
+ *      literals and sequences coded with predefined, RLE or block specific
+ *      FSE tables.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_dc_zstd.h"
+
+#include "dc_session.h"
+#include "lac_mem.h"
+#include "lac_sync.h"
+#include "sal_types_compression.h"
+
+#define DC_ZSTD_MAGIC_NUMBER (0xFD2FB528)
+#define DC_ZSTD_MAGIC_NUMBER_SIZE (4)
+/* Largest frame header written: magic, descriptor, window and 4 byte
+ * content size */
+#define DC_ZSTD_FRAME_HEADER_SIZE_MAX (10)
+#define DC_ZSTD_FHD_SINGLE_SEGMENT (0x20)
+#define DC_ZSTD_FHD_FCS_SHIFT (6)
+#define DC_ZSTD_FCS_2_BYTES_OFFSET (256)
+#define DC_ZSTD_FCS_2_BYTES_MAX (0x10000 + DC_ZSTD_FCS_2_BYTES_OFFSET)
+/* 128KB window: exponent 7, mantissa 0. LZ4s offsets never exceed 64KB */
+#define DC_ZSTD_WINDOW_DESCRIPTOR (0x38)
+
+#define DC_ZSTD_BLOCK_SIZE_MAX (128 * 1024)
+#define DC_ZSTD_BLOCK_HEADER_SIZE (3)
+#define DC_ZSTD_BLOCK_TYPE_RAW (0)
+#define DC_ZSTD_BLOCK_TYPE_COMPRESSED (2)
+
+#define DC_ZSTD_MIN_MATCH (3)
+#define DC_ZSTD_REP_NUM (3)
+#define DC_ZSTD_MAX_SEQUENCES (DC_ZSTD_BLOCK_SIZE_MAX / DC_ZSTD_MIN_MATCH + 1)
+#define DC_ZSTD_SEQ_LONG_NUM (0x7F00)
+#define DC_ZSTD_SEQ_MODE_PREDEFINED (0)
+#define DC_ZSTD_SEQ_MODE_RLE (1)
+#define DC_ZSTD_SEQ_MODE_FSE (2)
+#define DC_ZSTD_REP_START_1 (1)
+#define DC_ZSTD_REP_START_2 (4)
+#define DC_ZSTD_REP_START_3 (8)
+
+#define DC_ZSTD_LIT_TYPE_RAW (0)
+#define DC_ZSTD_LIT_TYPE_RLE (1)
+#define DC_ZSTD_LIT_TYPE_HUF (2)
+#define DC_ZSTD_LIT_SIZE_10_BITS (1024)
+#define DC_ZSTD_LIT_SIZE_14_BITS (16 * 1024)
+#define DC_ZSTD_LIT_RAW_1_BYTE_MAX (32)
+#define DC_ZSTD_LIT_RAW_2_BYTES_MAX (4096)
+
+#define DC_ZSTD_HUF_MAX_BITS (11)
+#define DC_ZSTD_HUF_MAX_SYMBOLS (256)
+/* Below this the Huffman tree description costs more than it saves */
+#define DC_ZSTD_HUF_MIN_LITERALS (64)
+#define DC_ZSTD_HUF_NUM_STREAMS (4)
+#define DC_ZSTD_HUF_JUMP_TABLE_SIZE (6)
+#define DC_ZSTD_HUF_STREAM_SIZE_MAX (0xFFFF)
+#define DC_ZSTD_HUF_DIRECT_WEIGHTS_MAX (128)
+#define DC_ZSTD_HUF_FSE_WEIGHTS_MAX (127)
+#define DC_ZSTD_HUF_WEIGHT_LOG (6)
+
+#define DC_ZSTD_FSE_MIN_LOG (5)
+#define DC_ZSTD_FSE_MAX_LOG (9)
+#define DC_ZSTD_FSE_MAX_SYMBOLS (53)
+
+#define DC_ZSTD_LL_LOG (6)
+#define DC_ZSTD_LL_MAX_LOG (9)
+#define DC_ZSTD_LL_MAX_SYMBOL (35)
+#define DC_ZSTD_ML_LOG (6)
+#define DC_ZSTD_ML_MAX_LOG (9)
+#define DC_ZSTD_ML_MAX_SYMBOL (52)
+#define DC_ZSTD_OF_LOG (5)
+#define DC_ZSTD_OF_MAX_LOG (8)
+#define DC_ZSTD_OF_MAX_SYMBOL (28)
+
+/* Sequence codes, in the order of the modes byte and of the table
+ * descriptions */
+#define DC_ZSTD_CODE_LL (0)
+#define DC_ZSTD_CODE_OF (1)
+#define DC_ZSTD_CODE_ML (2)
+#define DC_ZSTD_NUM_CODES (3)
+
+/* Cost estimates are kept in 1/256th of a bit */
+#define DC_ZSTD_COST_SHIFT (8)
+
+#define DC_LZ4S_RUN_MASK (0x0F)
+#define DC_LZ4S_ML_MASK (0x0F)
+#define DC_LZ4S_LIT_SHIFT (4)
+#define DC_LZ4S_OFFSET_SIZE (2)
+#define DC_LZ4S_LEN_CONTINUE (255)
+
+#define DC_ZSTD_MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+/* Default distributions of the predefined FSE tables (RFC 8878 3.1.1.3.2.2) */
+STATIC const Cpa16S dcZstdLLDefaultNorm[DC_ZSTD_LL_MAX_SYMBOL + 1] = {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1};
+
+STATIC const Cpa16S dcZstdMLDefaultNorm[DC_ZSTD_ML_MAX_SYMBOL + 1] = {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1};
+
+STATIC const Cpa16S dcZstdOFDefaultNorm[DC_ZSTD_OF_MAX_SYMBOL + 1] = {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1};
+
+/* Number of extra bits of each literal length and match length code */
+STATIC const Cpa8U dcZstdLLBits[DC_ZSTD_LL_MAX_SYMBOL + 1] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12,
+    13, 14, 15, 16};
+
+STATIC const Cpa8U dcZstdMLBits[DC_ZSTD_ML_MAX_SYMBOL + 1] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16};
+
+/* Codes of the short literal lengths and match lengths. The baselines of
+ * the longer codes are powers of two, see dcZstdLLCode and dcZstdMLCode */
+STATIC const Cpa8U dcZstdLLCodeTable[64] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15,
+    16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 20, 20, 21, 21, 21, 21,
+    22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23,
+    24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24};
+
+STATIC const Cpa8U dcZstdMLCodeTable[128] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 36, 36, 37, 37, 37, 37,
+    38, 38, 38, 38, 38, 38, 38, 38, 39, 39, 39, 39, 39, 39, 39, 39,
+    40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40,
+    41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+    42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42,
+    42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42};
+
+/* Bit stream written from the least significant bit of the first byte.
+ * zstd streams are read backwards so the encoder emits the symbols in the
+ * reverse of the decoding order. */
+typedef struct dc_zstd_bit_writer_s
+{
+    Cpa64U container;
+    Cpa32U numBits;
+    Cpa8U *pStart;
+    Cpa8U *pPos;
+    Cpa8U *pEnd;
+    CpaBoolean overflow;
+} dc_zstd_bit_writer_t;
+
+typedef struct dc_zstd_fse_symbol_s
+{
+    Cpa32S deltaFindState;
+    Cpa32U deltaNbBits;
+} dc_zstd_fse_symbol_t;
+
+typedef struct dc_zstd_fse_table_s
+{
+    CpaBoolean isRle;
+    /* Single symbol: the states carry no bits */
+    Cpa32U tableLog;
+    Cpa16U stateTable[1 << DC_ZSTD_FSE_MAX_LOG];
+    dc_zstd_fse_symbol_t symbolTT[DC_ZSTD_FSE_MAX_SYMBOLS];
+} dc_zstd_fse_table_t;
+
+typedef struct dc_zstd_fse_state_s
+{
+    Cpa32U value;
+    const dc_zstd_fse_table_t *pTable;
+} dc_zstd_fse_state_t;
+
+typedef struct dc_zstd_seq_s
+{
+    Cpa32U litLength;
+    Cpa32U matchLength;
+    Cpa32U offBase;
+    /* Offset + DC_ZSTD_REP_NUM, or 1 to 3 for a repeat offset */
+} dc_zstd_seq_t;
+
+/* Default distribution and limits of a sequence code */
+typedef struct dc_zstd_code_desc_s
+{
+    const Cpa16S *pDefaultNorm;
+    Cpa32U defaultLog;
+    Cpa32U maxSymbol;
+    Cpa32U maxLog;
+} dc_zstd_code_desc_t;
+
+/* Conversion context. The literals and sequences of the block being built
+ * are kept until the block is full, then encoded in one go. */
+typedef struct dc_zstd_ctx_s
+{
+    Cpa8U literals[DC_ZSTD_BLOCK_SIZE_MAX];
+    dc_zstd_seq_t sequences[DC_ZSTD_MAX_SEQUENCES];
+    dc_zstd_fse_table_t defaultTables[DC_ZSTD_NUM_CODES];
+    dc_zstd_fse_table_t blockTables[DC_ZSTD_NUM_CODES];
+    Cpa32U codeCounts[DC_ZSTD_NUM_CODES][DC_ZSTD_FSE_MAX_SYMBOLS];
+    Cpa32U hufCounts[DC_ZSTD_HUF_MAX_SYMBOLS];
+    Cpa8U hufLengths[DC_ZSTD_HUF_MAX_SYMBOLS];
+    Cpa16U hufCodes[DC_ZSTD_HUF_MAX_SYMBOLS];
+    Cpa32U numLiterals;
+    /* Literals of the block, including the pending ones */
+    Cpa32U numSequences;
+    Cpa32U pendingLiterals;
+    /* Literals not yet attached to a sequence */
+    Cpa32U blockSize;
+    /* Decompressed size of the block being built */
+    Cpa32U position;
+    /* Decompressed size of the data converted so far */
+    Cpa32U rep[DC_ZSTD_REP_NUM];
+    /* Repeat offsets, most recent first */
+    Cpa8U *pDst;
+    Cpa8U *pDstEnd;
+    const CpaBufferList *pSrcBuff;
+    Cpa32U srcBufferIndex;
+    Cpa32U srcBufferOffset;
+    /* Position in the source of the block being built */
+} dc_zstd_ctx_t;
+
+STATIC const dc_zstd_code_desc_t dcZstdCodeDesc[DC_ZSTD_NUM_CODES] = {
+    {dcZstdLLDefaultNorm,
+     DC_ZSTD_LL_LOG,
+     DC_ZSTD_LL_MAX_SYMBOL,
+     DC_ZSTD_LL_MAX_LOG},
+    {dcZstdOFDefaultNorm,
+     DC_ZSTD_OF_LOG,
+     DC_ZSTD_OF_MAX_SYMBOL,
+     DC_ZSTD_OF_MAX_LOG},
+    {dcZstdMLDefaultNorm,
+     DC_ZSTD_ML_LOG,
+     DC_ZSTD_ML_MAX_SYMBOL,
+     DC_ZSTD_ML_MAX_LOG}};
+
+STATIC INLINE Cpa32U dcZstdHighBit(Cpa32U value)
+{
+    return 31 - __builtin_clz(value);
+}
+
+STATIC INLINE void dcZstdWriteLE16(Cpa8U *pDst, Cpa32U value)
+{
+    pDst[0] = (Cpa8U)value;
+    pDst[1] = (Cpa8U)(value >> 8);
+}
+
+STATIC INLINE void dcZstdWriteLE24(Cpa8U *pDst, Cpa32U value)
+{
+    dcZstdWriteLE16(pDst, value);
+    pDst[2] = (Cpa8U)(value >> 16);
+}
+
+STATIC INLINE void dcZstdWriteLE32(Cpa8U *pDst, Cpa32U value)
+{
+    dcZstdWriteLE16(pDst, value);
+    dcZstdWriteLE16(pDst + 2, value >> 16);
+}
+
+STATIC void dcZstdBitInit(dc_zstd_bit_writer_t *pBw,
+                          Cpa8U *pDst,
+                          Cpa32U capacity)
+{
+    pBw->container = 0;
+    pBw->numBits = 0;
+    pBw->pStart = pDst;
+    pBw->pPos = pDst;
+    pBw->pEnd = pDst + capacity;
+    pBw->overflow = CPA_FALSE;
+}
+
+STATIC INLINE void dcZstdBitFlush(dc_zstd_bit_writer_t *pBw)
+{
+    while (pBw->numBits >= 8)
+    {
+        if (pBw->pPos < pBw->pEnd)
+        {
+            *pBw->pPos++ = (Cpa8U)pBw->container;
+        }
+        else
+        {
+            pBw->overflow = CPA_TRUE;
+        }
+        pBw->container >>= 8;
+        pBw->numBits -= 8;
+    }
+}
+
+STATIC INLINE void dcZstdBitAdd(dc_zstd_bit_writer_t *pBw,
+                                Cpa32U value,
+                                Cpa32U numBits)
+{
+    pBw->container |= ((Cpa64U)value & (((Cpa64U)1 << numBits) - 1))
+                      << pBw->numBits;
+    pBw->numBits += numBits;
+    if (pBw->numBits >= 32)
+    {
+        dcZstdBitFlush(pBw);
+    }
+}
+
+/* Terminate the stream with the end mark the decoder looks for in the
+ * last byte. Returns the size of the stream, 0 if it did not fit. */
+STATIC Cpa32U dcZstdBitClose(dc_zstd_bit_writer_t *pBw)
+{
+    dcZstdBitAdd(pBw, 1, 1);
+    pBw->numBits += 7;
+    dcZstdBitFlush(pBw);
+
+    if (CPA_TRUE == pBw->overflow)
+    {
+        return 0;
+    }
+    return (Cpa32U)(pBw->pPos - pBw->pStart);
+}
+
+/* Build the encoding table of a normalized distribution. The symbol
+ * spread must match the decoder's exactly. */
+STATIC void dcZstdFseBuildTable(dc_zstd_fse_table_t *pTable,
+                                const Cpa16S *pNorm,
+                                Cpa32U maxSymbol,
+                                Cpa32U tableLog)
+{
+    Cpa8U tableSymbol[1 << DC_ZSTD_FSE_MAX_LOG];
+    Cpa32U cumul[DC_ZSTD_FSE_MAX_SYMBOLS + 1];
+    Cpa32U tableSize = 1 << tableLog;
+    Cpa32U tableMask = tableSize - 1;
+    Cpa32U step = (tableSize >> 1) + (tableSize >> 3) + 3;
+    Cpa32U highThreshold = tableSize - 1;
+    Cpa32U position = 0;
+    Cpa32U symbol = 0;
+    Cpa32U i = 0;
+    Cpa32S total = 0;
+    Cpa32S n = 0;
+
+    pTable->isRle = CPA_FALSE;
+    pTable->tableLog = tableLog;
+
+    /* Low probability symbols take the last cells of the table */
+    cumul[0] = 0;
+    for (symbol = 1; symbol <= maxSymbol + 1; symbol++)
+    {
+        if (-1 == pNorm[symbol - 1])
+        {
+            cumul[symbol] = cumul[symbol - 1] + 1;
+            tableSymbol[highThreshold--] = (Cpa8U)(symbol - 1);
+        }
+        else
+        {
+            cumul[symbol] = cumul[symbol - 1] + pNorm[symbol - 1];
+        }
+    }
+
+    for (symbol = 0; symbol <= maxSymbol; symbol++)
+    {
+        for (n = 0; n < pNorm[symbol]; n++)
+        {
+            tableSymbol[position] = (Cpa8U)symbol;
+            do
+            {
+                position = (position + step) & tableMask;
+            } while (position > highThreshold);
+        }
+    }
+
+    for (i = 0; i < tableSize; i++)
+    {
+        symbol = tableSymbol[i];
+        pTable->stateTable[cumul[symbol]++] = (Cpa16U)(tableSize + i);
+    }
+
+    for (symbol = 0; symbol <= maxSymbol; symbol++)
+    {
+        dc_zstd_fse_symbol_t *pSymbolTT = &pTable->symbolTT[symbol];
+
+        switch (pNorm[symbol])
+        {
+            case 0:
+                pSymbolTT->deltaNbBits = ((tableLog + 1) << 16) - tableSize;
+                pSymbolTT->deltaFindState = 0;
+                break;
+            case -1:
+            case 1:
+                pSymbolTT->deltaNbBits = (tableLog << 16) - tableSize;
+                pSymbolTT->deltaFindState = total - 1;
+                total++;
+                break;
+            default:
+            {
+                Cpa32U maxBitsOut =
+                    tableLog - dcZstdHighBit((Cpa32U)pNorm[symbol] - 1);
+                Cpa32U minStatePlus = (Cpa32U)pNorm[symbol] << maxBitsOut;
+
+                pSymbolTT->deltaNbBits = (maxBitsOut << 16) - minStatePlus;
+                pSymbolTT->deltaFindState = total - pNorm[symbol];
+                total += pNorm[symbol];
+                break;
+            }
+        }
+    }
+}
+
+/* The first symbol encoded sets the state without emitting any bits */
+STATIC INLINE void dcZstdFseInitState(dc_zstd_fse_state_t *pState,
+                                      const dc_zstd_fse_table_t *pTable,
+                                      Cpa32U symbol)
+{
+    const dc_zstd_fse_symbol_t *pSymbolTT = &pTable->symbolTT[symbol];
+    Cpa32U nbBitsOut = (pSymbolTT->deltaNbBits + (1 << 15)) >> 16;
+    Cpa32U value = (nbBitsOut << 16) - pSymbolTT->deltaNbBits;
+
+    pState->pTable = pTable;
+    if (CPA_TRUE == pTable->isRle)
+    {
+        pState->value = 0;
+        return;
+    }
+    pState->value = pTable->stateTable[(Cpa32S)(value >> nbBitsOut) +
+                                       pSymbolTT->deltaFindState];
+}
+
+STATIC INLINE void dcZstdFseEncode(dc_zstd_bit_writer_t *pBw,
+                                   dc_zstd_fse_state_t *pState,
+                                   Cpa32U symbol)
+{
+    const dc_zstd_fse_symbol_t *pSymbolTT = &pState->pTable->symbolTT[symbol];
+    Cpa32U nbBitsOut = 0;
+
+    if (CPA_TRUE == pState->pTable->isRle)
+    {
+        return;
+    }
+    nbBitsOut = (pState->value + pSymbolTT->deltaNbBits) >> 16;
+    dcZstdBitAdd(pBw, pState->value, nbBitsOut);
+    pState->value =
+        pState->pTable->stateTable[(Cpa32S)(pState->value >> nbBitsOut) +
+                                   pSymbolTT->deltaFindState];
+}
+
+STATIC INLINE void dcZstdFseFlushState(dc_zstd_bit_writer_t *pBw,
+                                       const dc_zstd_fse_state_t *pState)
+{
+    if (CPA_FALSE == pState->pTable->isRle)
+    {
+        dcZstdBitAdd(pBw, pState->value, pState->pTable->tableLog);
+    }
+}
+
+/* Write the table description of a normalized distribution in the FSE
+ * header format. Returns the number of bytes written, 0 if it did not
+ * fit. */
+STATIC Cpa32U dcZstdFseWriteNCount(const Cpa16S *pNorm,
+                                   Cpa32U maxSymbol,
+                                   Cpa32U tableLog,
+                                   Cpa8U *pDst,
+                                   Cpa32U capacity)
+{
+    Cpa8U *pOut = pDst;
+    Cpa8U *pEnd = pDst + capacity;
+    Cpa32S tableSize = 1 << tableLog;
+    Cpa32S remaining = tableSize + 1;
+    Cpa32S threshold = tableSize;
+    Cpa32U nbBits = tableLog + 1;
+    Cpa32U bitStream = tableLog - DC_ZSTD_FSE_MIN_LOG;
+    Cpa32U bitCount = 4;
+    Cpa32U symbol = 0;
+    CpaBoolean previousIs0 = CPA_FALSE;
+
+    while ((symbol <= maxSymbol) && (remaining > 1))
+    {
+        Cpa32S count = 0;
+        Cpa32S max = 0;
+
+        if (CPA_TRUE == previousIs0)
+        {
+            Cpa32U start = symbol;
+
+            /* Runs of zero probability symbols are written as repeat
+             * flags of 2 bits, 3 meaning the run goes on */
+            while ((symbol <= maxSymbol) && (0 == pNorm[symbol]))
+            {
+                symbol++;
+            }
+            if (symbol > maxSymbol)
+            {
+                return 0;
+            }
+            while (symbol >= start + 24)
+            {
+                start += 24;
+                bitStream += 0xFFFFU << bitCount;
+                if (pOut + 2 > pEnd)
+                {
+                    return 0;
+                }
+                dcZstdWriteLE16(pOut, bitStream);
+                pOut += 2;
+                bitStream >>= 16;
+            }
+            while (symbol >= start + 3)
+            {
+                start += 3;
+                bitStream += 3U << bitCount;
+                bitCount += 2;
+            }
+            bitStream += (symbol - start) << bitCount;
+            bitCount += 2;
+            if (bitCount > 16)
+            {
+                if (pOut + 2 > pEnd)
+                {
+                    return 0;
+                }
+                dcZstdWriteLE16(pOut, bitStream);
+                pOut += 2;
+                bitStream >>= 16;
+                bitCount -= 16;
+            }
+        }
+
+        count = pNorm[symbol++];
+        max = (2 * threshold - 1) - remaining;
+        remaining -= (count < 0) ? -count : count;
+        count++;
+        if (count >= threshold)
+        {
+            count += max;
+        }
+        bitStream += (Cpa32U)count << bitCount;
+        bitCount += nbBits;
+        bitCount -= (count < max) ? 1 : 0;
+        previousIs0 = (1 == count) ? CPA_TRUE : CPA_FALSE;
+        if (remaining < 1)
+        {
+            return 0;
+        }
+        while (remaining < threshold)
+        {
+            nbBits--;
+            threshold >>= 1;
+        }
+        if (bitCount > 16)
+        {
+            if (pOut + 2 > pEnd)
+            {
+                return 0;
+            }
+            dcZstdWriteLE16(pOut, bitStream);
+            pOut += 2;
+            bitStream >>= 16;
+            bitCount -= 16;
+        }
+    }
+
+    if ((1 != remaining) || (pOut + (bitCount + 7) / 8 > pEnd))
+    {
+        return 0;
+    }
+    pOut[0] = (Cpa8U)bitStream;
+    if (bitCount > 8)
+    {
+        pOut[1] = (Cpa8U)(bitStream >> 8);
+    }
+    pOut += (bitCount + 7) / 8;
+
+    return (Cpa32U)(pOut - pDst);
+}
+
+/* Scale the counts of a histogram to a total of 1 << tableLog. Every
+ * symbol present keeps a probability of at least one cell; what rounding
+ * leaves over goes to the most frequent symbol. */
+STATIC CpaBoolean dcZstdFseNormalize(const Cpa32U *pCounts,
+                                     Cpa32U maxSymbol,
+                                     Cpa32U total,
+                                     Cpa32U tableLog,
+                                     Cpa16S *pNorm)
+{
+    Cpa32S tableSize = 1 << tableLog;
+    Cpa32S sum = 0;
+    Cpa32U largest = 0;
+    Cpa32U s = 0;
+
+    for (s = 0; s <= maxSymbol; s++)
+    {
+        pNorm[s] = 0;
+        if (0 == pCounts[s])
+        {
+            continue;
+        }
+        pNorm[s] = (Cpa16S)(((Cpa64U)pCounts[s] * tableSize + total / 2) /
+                            total);
+        if (0 == pNorm[s])
+        {
+            pNorm[s] = 1;
+        }
+        if (pCounts[s] > pCounts[largest])
+        {
+            largest = s;
+        }
+        sum += pNorm[s];
+    }
+    if (pNorm[largest] + tableSize - sum < 1)
+    {
+        return CPA_FALSE;
+    }
+    pNorm[largest] += (Cpa16S)(tableSize - sum);
+
+    return CPA_TRUE;
+}
+
+/* Compress the Huffman weights with FSE. Two states share the table and
+ * take the weights in turn. Returns the size of the description without
+ * its header byte, 0 if FSE does not apply. */
+STATIC Cpa32U dcZstdHufCompressWeights(const Cpa8U *pWeights,
+                                       Cpa32U numWeights,
+                                       Cpa8U *pDst,
+                                       Cpa32U capacity)
+{
+    Cpa32U counts[DC_ZSTD_HUF_MAX_BITS + 1] = {0};
+    Cpa16S norm[DC_ZSTD_HUF_MAX_BITS + 1] = {0};
+    dc_zstd_fse_table_t table;
+    dc_zstd_fse_state_t states[2];
+    CpaBoolean stateSet[2] = {CPA_FALSE, CPA_FALSE};
+    dc_zstd_bit_writer_t bw;
+    Cpa32U maxWeight = 0;
+    Cpa32U largest = 0;
+    Cpa32U headerSize = 0;
+    Cpa32U streamSize = 0;
+    Cpa32U i = 0;
+
+    if (numWeights <= 2)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < numWeights; i++)
+    {
+        counts[pWeights[i]]++;
+        if (pWeights[i] > maxWeight)
+        {
+            maxWeight = pWeights[i];
+        }
+    }
+    for (i = 0; i <= maxWeight; i++)
+    {
+        if (counts[i] > counts[largest])
+        {
+            largest = i;
+        }
+    }
+    /* A single weight value or no repetition at all: not worth it */
+    if ((counts[largest] == numWeights) || (1 == counts[largest]))
+    {
+        return 0;
+    }
+
+    if (CPA_FALSE == dcZstdFseNormalize(counts,
+                                        maxWeight,
+                                        numWeights,
+                                        DC_ZSTD_HUF_WEIGHT_LOG,
+                                        norm))
+    {
+        return 0;
+    }
+
+    headerSize = dcZstdFseWriteNCount(
+        norm, maxWeight, DC_ZSTD_HUF_WEIGHT_LOG, pDst, capacity);
+    if (0 == headerSize)
+    {
+        return 0;
+    }
+
+    dcZstdFseBuildTable(&table, norm, maxWeight, DC_ZSTD_HUF_WEIGHT_LOG);
+
+    /* Weight i is decoded by state i & 1, the first state being the last
+     * one flushed */
+    dcZstdBitInit(&bw, pDst + headerSize, capacity - headerSize);
+    for (i = numWeights; i > 0; i--)
+    {
+        Cpa32U s = (i - 1) & 1;
+
+        if (CPA_FALSE == stateSet[s])
+        {
+            dcZstdFseInitState(&states[s], &table, pWeights[i - 1]);
+            stateSet[s] = CPA_TRUE;
+        }
+        else
+        {
+            dcZstdFseEncode(&bw, &states[s], pWeights[i - 1]);
+        }
+    }
+    dcZstdFseFlushState(&bw, &states[1]);
+    dcZstdFseFlushState(&bw, &states[0]);
+    streamSize = dcZstdBitClose(&bw);
+    if (0 == streamSize)
+    {
+        return 0;
+    }
+
+    return headerSize + streamSize;
+}
+
+/* Compute the Huffman code lengths of the literals, limited to
+ * DC_ZSTD_HUF_MAX_BITS. The code is kept complete (Kraft sum of one) as the
+ * decoder derives the weight of the last symbol from it. Returns the
+ * longest code length. */
+STATIC Cpa32U dcZstdHufBuildLengths(const Cpa32U *pCounts,
+                                    Cpa32U maxSymbol,
+                                    Cpa8U *pLengths)
+{
+    Cpa32U symbols[DC_ZSTD_HUF_MAX_SYMBOLS];
+    Cpa32S len[DC_ZSTD_HUF_MAX_SYMBOLS];
+    Cpa32S n = 0;
+    Cpa32S i = 0;
+    Cpa32S j = 0;
+    Cpa32S root = 0;
+    Cpa32S leaf = 0;
+    Cpa32S next = 0;
+    Cpa32S avbl = 0;
+    Cpa32S used = 0;
+    Cpa32S depth = 0;
+    Cpa32U s = 0;
+
+    /* Sort the present symbols by increasing count */
+    for (s = 0; s <= maxSymbol; s++)
+    {
+        pLengths[s] = 0;
+        if (0 == pCounts[s])
+        {
+            continue;
+        }
+        for (j = n; (j > 0) && (pCounts[symbols[j - 1]] > pCounts[s]); j--)
+        {
+            symbols[j] = symbols[j - 1];
+        }
+        symbols[j] = s;
+        n++;
+    }
+    for (i = 0; i < n; i++)
+    {
+        len[i] = (Cpa32S)pCounts[symbols[i]];
+    }
+
+    /* In-place minimum redundancy code computation (Moffat and Katajainen).
+     * First pass sets the parent pointers, the second the internal node
+     * depths and the third the leaf depths. */
+    len[0] += len[1];
+    root = 0;
+    leaf = 2;
+    for (next = 1; next < n - 1; next++)
+    {
+        if ((leaf >= n) || (len[root] < len[leaf]))
+        {
+            len[next] = len[root];
+            len[root++] = next;
+        }
+        else
+        {
+            len[next] = len[leaf++];
+        }
+        if ((leaf >= n) || ((root < next) && (len[root] < len[leaf])))
+        {
+            len[next] += len[root];
+            len[root++] = next;
+        }
+        else
+        {
+            len[next] += len[leaf++];
+        }
+    }
+    len[n - 2] = 0;
+    for (next = n - 3; next >= 0; next--)
+    {
+        len[next] = len[len[next]] + 1;
+    }
+    avbl = 1;
+    used = 0;
+    depth = 0;
+    root = n - 2;
+    next = n - 1;
+    while (avbl > 0)
+    {
+        while ((root >= 0) && (len[root] == depth))
+        {
+            used++;
+            root--;
+        }
+        while (avbl > used)
+        {
+            len[next--] = depth;
+            avbl--;
+        }
+        avbl = 2 * used;
+        depth++;
+        used = 0;
+    }
+
+    /* The lengths are now non-increasing. Clamp the longest ones, lengthen
+     * the longest codes still below the limit until the code fits, then
+     * shorten the most frequent of the longest codes to complete it. */
+    if (len[0] > DC_ZSTD_HUF_MAX_BITS)
+    {
+        Cpa32S kraft = 0;
+        const Cpa32S kraftMax = 1 << DC_ZSTD_HUF_MAX_BITS;
+
+        for (i = 0; i < n; i++)
+        {
+            if (len[i] > DC_ZSTD_HUF_MAX_BITS)
+            {
+                len[i] = DC_ZSTD_HUF_MAX_BITS;
+            }
+            kraft += 1 << (DC_ZSTD_HUF_MAX_BITS - len[i]);
+        }
+        while (kraft > kraftMax)
+        {
+            for (i = 0; len[i] >= DC_ZSTD_HUF_MAX_BITS; i++)
+                ;
+            len[i]++;
+            kraft -= 1 << (DC_ZSTD_HUF_MAX_BITS - len[i]);
+        }
+        while (kraft < kraftMax)
+        {
+            for (i = n - 1; len[i] != len[0]; i--)
+                ;
+            kraft += 1 << (DC_ZSTD_HUF_MAX_BITS - len[i]);
+            len[i]--;
+        }
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        pLengths[symbols[i]] = (Cpa8U)len[i];
+    }
+    return (Cpa32U)len[0];
+}
+
+STATIC Cpa32U dcZstdHufEncodeStream(const dc_zstd_ctx_t *pCtx,
+                                    const Cpa8U *pSrc,
+                                    Cpa32U srcLen,
+                                    Cpa8U *pDst,
+                                    Cpa32U capacity)
+{
+    dc_zstd_bit_writer_t bw;
+    Cpa32U i = 0;
+
+    dcZstdBitInit(&bw, pDst, capacity);
+    for (i = srcLen; i > 0; i--)
+    {
+        Cpa8U symbol = pSrc[i - 1];
+
+        dcZstdBitAdd(&bw, pCtx->hufCodes[symbol], pCtx->hufLengths[symbol]);
+    }
+    return dcZstdBitClose(&bw);
+}
+
+/* Write a Huffman compressed literals section. Returns its size, 0 if it
+ * is not smaller than the literals themselves. */
+STATIC Cpa32U dcZstdWriteLiteralsHuf(dc_zstd_ctx_t *pCtx,
+                                     Cpa32U maxSymbol,
+                                     Cpa8U *pDst,
+                                     Cpa32U capacity)
+{
+    Cpa8U weights[DC_ZSTD_HUF_MAX_SYMBOLS];
+    Cpa32U litSize = pCtx->numLiterals;
+    Cpa32U headerSize = 0;
+    Cpa32U sizeFormat = 0;
+    Cpa32U sizeBits = 0;
+    Cpa32U maxBits = 0;
+    Cpa32U treeSize = 0;
+    Cpa32U compSize = 0;
+    Cpa32U nextCode = 0;
+    Cpa32U len = 0;
+    Cpa32U s = 0;
+    Cpa64U header = 0;
+    Cpa8U *pOut = NULL;
+    Cpa8U *pEnd = NULL;
+
+    /* Sizes are at most litSize so the header format follows from it */
+    if (litSize < DC_ZSTD_LIT_SIZE_10_BITS)
+    {
+        headerSize = 3;
+        sizeBits = 10;
+    }
+    else if (litSize < DC_ZSTD_LIT_SIZE_14_BITS)
+    {
+        headerSize = 4;
+        sizeBits = 14;
+        sizeFormat = 2;
+    }
+    else
+    {
+        headerSize = 5;
+        sizeBits = 18;
+        sizeFormat = 3;
+    }
+    if (capacity > headerSize + litSize)
+    {
+        capacity = headerSize + litSize;
+    }
+    if (capacity <= headerSize)
+    {
+        return 0;
+    }
+    pOut = pDst + headerSize;
+    pEnd = pDst + capacity;
+
+    maxBits = dcZstdHufBuildLengths(pCtx->hufCounts, maxSymbol,
+                                    pCtx->hufLengths);
+
+    /* Tree description: weights of all the symbols but the last one */
+    for (s = 0; s < maxSymbol; s++)
+    {
+        weights[s] =
+            pCtx->hufLengths[s] ? (Cpa8U)(maxBits + 1 - pCtx->hufLengths[s])
+                                : 0;
+    }
+    treeSize = dcZstdHufCompressWeights(
+        weights,
+        maxSymbol,
+        pOut + 1,
+        DC_ZSTD_MIN((Cpa32U)(pEnd - pOut - 1), DC_ZSTD_HUF_FSE_WEIGHTS_MAX));
+    if ((0 != treeSize) && ((maxSymbol > DC_ZSTD_HUF_DIRECT_WEIGHTS_MAX) ||
+                            (treeSize < (maxSymbol + 1) / 2)))
+    {
+        pOut[0] = (Cpa8U)treeSize;
+        pOut += treeSize + 1;
+    }
+    else if (maxSymbol <= DC_ZSTD_HUF_DIRECT_WEIGHTS_MAX)
+    {
+        treeSize = (maxSymbol + 1) / 2;
+        if (pOut + treeSize + 1 > pEnd)
+        {
+            return 0;
+        }
+        pOut[0] = (Cpa8U)(DC_ZSTD_HUF_FSE_WEIGHTS_MAX + maxSymbol);
+        for (s = 0; s < maxSymbol; s += 2)
+        {
+            pOut[1 + s / 2] = (Cpa8U)(
+                (weights[s] << 4) | ((s + 1 < maxSymbol) ? weights[s + 1] : 0));
+        }
+        pOut += treeSize + 1;
+    }
+    else
+    {
+        return 0;
+    }
+
+    /* Canonical codes: the longest codes come first and, for a given
+     * length, codes increase with the symbol value */
+    for (len = maxBits; len > 0; len--)
+    {
+        for (s = 0; s <= maxSymbol; s++)
+        {
+            if (pCtx->hufLengths[s] == len)
+            {
+                pCtx->hufCodes[s] = (Cpa16U)nextCode++;
+            }
+        }
+        nextCode >>= 1;
+    }
+
+    if (litSize < DC_ZSTD_LIT_SIZE_10_BITS)
+    {
+        /* Single stream */
+        Cpa32U streamSize = dcZstdHufEncodeStream(
+            pCtx, pCtx->literals, litSize, pOut, (Cpa32U)(pEnd - pOut));
+
+        if (0 == streamSize)
+        {
+            return 0;
+        }
+        pOut += streamSize;
+    }
+    else
+    {
+        /* Four streams behind a jump table holding the size of the first
+         * three */
+        Cpa32U segmentSize = (litSize + 3) / DC_ZSTD_HUF_NUM_STREAMS;
+        Cpa8U *pJumpTable = pOut;
+        Cpa32U i = 0;
+
+        if (pOut + DC_ZSTD_HUF_JUMP_TABLE_SIZE > pEnd)
+        {
+            return 0;
+        }
+        pOut += DC_ZSTD_HUF_JUMP_TABLE_SIZE;
+        for (i = 0; i < DC_ZSTD_HUF_NUM_STREAMS; i++)
+        {
+            Cpa32U offset = i * segmentSize;
+            Cpa32U length = (i < DC_ZSTD_HUF_NUM_STREAMS - 1)
+                                ? segmentSize
+                                : litSize - offset;
+            Cpa32U streamSize =
+                dcZstdHufEncodeStream(pCtx,
+                                      pCtx->literals + offset,
+                                      length,
+                                      pOut,
+                                      (Cpa32U)(pEnd - pOut));
+
+            if ((0 == streamSize) ||
+                (streamSize > DC_ZSTD_HUF_STREAM_SIZE_MAX))
+            {
+                return 0;
+            }
+            if (i < DC_ZSTD_HUF_NUM_STREAMS - 1)
+            {
+                dcZstdWriteLE16(pJumpTable + 2 * i, streamSize);
+            }
+            pOut += streamSize;
+        }
+    }
+
+    compSize = (Cpa32U)(pOut - pDst) - headerSize;
+    if (compSize >= litSize)
+    {
+        return 0;
+    }
+
+    header = DC_ZSTD_LIT_TYPE_HUF | (sizeFormat << 2) |
+             ((Cpa64U)litSize << 4) | ((Cpa64U)compSize << (4 + sizeBits));
+    for (s = 0; s < headerSize; s++)
+    {
+        pDst[s] = (Cpa8U)(header >> (8 * s));
+    }
+
+    return (Cpa32U)(pOut - pDst);
+}
+
+/* Write the literals section of the block: Huffman coded if that pays
+ * off, RLE if there is a single symbol, raw otherwise. Returns its size, 0
+ * if it did not fit. */
+STATIC Cpa32U dcZstdWriteLiterals(dc_zstd_ctx_t *pCtx,
+                                  Cpa8U *pDst,
+                                  Cpa32U capacity)
+{
+    Cpa32U litSize = pCtx->numLiterals;
+    Cpa32U maxSymbol = 0;
+    Cpa32U numSymbols = 0;
+    Cpa32U headerSize = 0;
+    Cpa32U size = 0;
+    Cpa32U type = DC_ZSTD_LIT_TYPE_RAW;
+    Cpa32U i = 0;
+
+    osalMemSet(pCtx->hufCounts, 0, sizeof(pCtx->hufCounts));
+    for (i = 0; i < litSize; i++)
+    {
+        pCtx->hufCounts[pCtx->literals[i]]++;
+    }
+    for (i = 0; i < DC_ZSTD_HUF_MAX_SYMBOLS; i++)
+    {
+        if (pCtx->hufCounts[i])
+        {
+            maxSymbol = i;
+            numSymbols++;
+        }
+    }
+
+    if ((litSize >= DC_ZSTD_HUF_MIN_LITERALS) && (numSymbols > 1))
+    {
+        size = dcZstdWriteLiteralsHuf(pCtx, maxSymbol, pDst, capacity);
+        if (0 != size)
+        {
+            return size;
+        }
+    }
+
+    if (litSize < DC_ZSTD_LIT_RAW_1_BYTE_MAX)
+    {
+        headerSize = 1;
+    }
+    else if (litSize < DC_ZSTD_LIT_RAW_2_BYTES_MAX)
+    {
+        headerSize = 2;
+    }
+    else
+    {
+        headerSize = 3;
+    }
+    if (1 == numSymbols)
+    {
+        type = DC_ZSTD_LIT_TYPE_RLE;
+        size = headerSize + 1;
+    }
+    else
+    {
+        size = headerSize + litSize;
+    }
+    if (size > capacity)
+    {
+        return 0;
+    }
+
+    switch (headerSize)
+    {
+        case 1:
+            pDst[0] = (Cpa8U)(type | (litSize << 3));
+            break;
+        case 2:
+            dcZstdWriteLE16(pDst, type | (1 << 2) | (litSize << 4));
+            break;
+        default:
+            dcZstdWriteLE24(pDst, type | (3 << 2) | (litSize << 4));
+            break;
+    }
+    if (DC_ZSTD_LIT_TYPE_RLE == type)
+    {
+        pDst[headerSize] = pCtx->literals[0];
+    }
+    else
+    {
+        osalMemCopy(pDst + headerSize, pCtx->literals, litSize);
+    }
+
+    return size;
+}
+
+STATIC INLINE Cpa32U dcZstdLLCode(Cpa32U litLength)
+{
+    return (litLength < 64) ? dcZstdLLCodeTable[litLength]
+                            : dcZstdHighBit(litLength) + 19;
+}
+
+STATIC INLINE Cpa32U dcZstdMLCode(Cpa32U mlBase)
+{
+    return (mlBase < 128) ? dcZstdMLCodeTable[mlBase]
+                          : dcZstdHighBit(mlBase) + 36;
+}
+
+/* Approximate log2 of value in 1/256th of a bit */
+STATIC INLINE Cpa32U dcZstdLog2Cost(Cpa32U value)
+{
+    Cpa32U highBit = dcZstdHighBit(value);
+    Cpa32U mantissa = (highBit >= DC_ZSTD_COST_SHIFT)
+                          ? value >> (highBit - DC_ZSTD_COST_SHIFT)
+                          : value << (DC_ZSTD_COST_SHIFT - highBit);
+
+    return (highBit << DC_ZSTD_COST_SHIFT) +
+           (mantissa & ((1 << DC_ZSTD_COST_SHIFT) - 1));
+}
+
+/* Estimated size in 1/256th of a bit of a histogram coded with the given
+ * distribution */
+STATIC Cpa64U dcZstdFseCost(const Cpa32U *pCounts,
+                            Cpa32U maxSymbol,
+                            const Cpa16S *pNorm,
+                            Cpa32U tableLog)
+{
+    Cpa64U cost = 0;
+    Cpa32U s = 0;
+
+    for (s = 0; s <= maxSymbol; s++)
+    {
+        if (pCounts[s])
+        {
+            Cpa32U norm = (pNorm[s] < 0) ? 1 : (Cpa32U)pNorm[s];
+
+            cost += (Cpa64U)pCounts[s] * ((tableLog << DC_ZSTD_COST_SHIFT) -
+                                          dcZstdLog2Cost(norm));
+        }
+    }
+
+    return cost;
+}
+
+/* Choose how one of the sequence codes of the block is coded: RLE when a
+ * single value is used, otherwise a table built from the block when its
+ * description pays for itself, the predefined table by default. Returns
+ * the size of the table description written to pDst. */
+STATIC Cpa32U dcZstdSelectTable(dc_zstd_ctx_t *pCtx,
+                                Cpa32U code,
+                                Cpa32U numSeq,
+                                Cpa32U *pMode,
+                                Cpa8U *pDst,
+                                Cpa32U capacity)
+{
+    const dc_zstd_code_desc_t *pDesc = &dcZstdCodeDesc[code];
+    const Cpa32U *pCounts = pCtx->codeCounts[code];
+    dc_zstd_fse_table_t *pTable = &pCtx->blockTables[code];
+    Cpa16S norm[DC_ZSTD_FSE_MAX_SYMBOLS];
+    Cpa32U maxSymbol = 0;
+    Cpa32U numSymbols = 0;
+    Cpa32S tableLog = pDesc->maxLog;
+    Cpa32S srcLog = 0;
+    Cpa32S minLog = 0;
+    Cpa32U headerSize = 0;
+    Cpa64U cost = 0;
+    Cpa32U s = 0;
+
+    *pMode = DC_ZSTD_SEQ_MODE_PREDEFINED;
+    if (0 == capacity)
+    {
+        return 0;
+    }
+
+    for (s = 0; s <= pDesc->maxSymbol; s++)
+    {
+        if (pCounts[s])
+        {
+            maxSymbol = s;
+            numSymbols++;
+        }
+    }
+    if (1 == numSymbols)
+    {
+        pDst[0] = (Cpa8U)maxSymbol;
+        pTable->isRle = CPA_TRUE;
+        pTable->tableLog = 0;
+        *pMode = DC_ZSTD_SEQ_MODE_RLE;
+        return 1;
+    }
+
+    /* No more accuracy than the number of sequences justifies, but enough
+     * to give every symbol a cell */
+    srcLog = (Cpa32S)dcZstdHighBit(numSeq - 1) - 2;
+    minLog = DC_ZSTD_MIN((Cpa32S)dcZstdHighBit(numSeq) + 1,
+                     (Cpa32S)dcZstdHighBit(maxSymbol) + 2);
+    if (srcLog < tableLog)
+    {
+        tableLog = srcLog;
+    }
+    if (minLog > tableLog)
+    {
+        tableLog = minLog;
+    }
+    if (tableLog < DC_ZSTD_FSE_MIN_LOG)
+    {
+        tableLog = DC_ZSTD_FSE_MIN_LOG;
+    }
+    if (tableLog > (Cpa32S)pDesc->maxLog)
+    {
+        tableLog = pDesc->maxLog;
+    }
+
+    if (CPA_FALSE ==
+        dcZstdFseNormalize(pCounts, maxSymbol, numSeq, tableLog, norm))
+    {
+        return 0;
+    }
+    headerSize =
+        dcZstdFseWriteNCount(norm, maxSymbol, tableLog, pDst, capacity);
+    if (0 == headerSize)
+    {
+        return 0;
+    }
+    cost = dcZstdFseCost(pCounts, maxSymbol, norm, tableLog) +
+           (((Cpa64U)headerSize * 8) << DC_ZSTD_COST_SHIFT);
+    if (cost >= dcZstdFseCost(pCounts,
+                              maxSymbol,
+                              pDesc->pDefaultNorm,
+                              pDesc->defaultLog))
+    {
+        return 0;
+    }
+
+    dcZstdFseBuildTable(pTable, norm, maxSymbol, tableLog);
+    *pMode = DC_ZSTD_SEQ_MODE_FSE;
+    return headerSize;
+}
+
+STATIC INLINE void dcZstdSeqCodes(const dc_zstd_seq_t *pSeq, Cpa32U *pCodes)
+{
+    pCodes[DC_ZSTD_CODE_LL] = dcZstdLLCode(pSeq->litLength);
+    pCodes[DC_ZSTD_CODE_OF] = dcZstdHighBit(pSeq->offBase);
+    pCodes[DC_ZSTD_CODE_ML] =
+        dcZstdMLCode(pSeq->matchLength - DC_ZSTD_MIN_MATCH);
+}
+
+/* Write the extra bits of the three fields of a sequence */
+STATIC INLINE void dcZstdSeqWriteBits(dc_zstd_bit_writer_t *pBw,
+                                      const dc_zstd_seq_t *pSeq,
+                                      const Cpa32U *pCodes)
+{
+    dcZstdBitAdd(pBw, pSeq->litLength, dcZstdLLBits[pCodes[DC_ZSTD_CODE_LL]]);
+    dcZstdBitAdd(pBw,
+                 pSeq->matchLength - DC_ZSTD_MIN_MATCH,
+                 dcZstdMLBits[pCodes[DC_ZSTD_CODE_ML]]);
+    dcZstdBitAdd(pBw, pSeq->offBase, pCodes[DC_ZSTD_CODE_OF]);
+}
+
+/* Write the sequences section of the block. Returns its size, 0 if it did
+ * not fit. */
+STATIC Cpa32U dcZstdWriteSequences(dc_zstd_ctx_t *pCtx,
+                                   Cpa8U *pDst,
+                                   Cpa32U capacity)
+{
+    const dc_zstd_seq_t *pSeq = pCtx->sequences;
+    const dc_zstd_fse_table_t *pTables[DC_ZSTD_NUM_CODES];
+    Cpa32U numSeq = pCtx->numSequences;
+    Cpa32U codes[DC_ZSTD_NUM_CODES];
+    dc_zstd_fse_state_t llState;
+    dc_zstd_fse_state_t mlState;
+    dc_zstd_fse_state_t ofState;
+    dc_zstd_bit_writer_t bw;
+    Cpa32U headerSize = 0;
+    Cpa32U streamSize = 0;
+    Cpa32U modes = 0;
+    Cpa8U *pModes = NULL;
+    Cpa32U n = 0;
+    Cpa32U i = 0;
+
+    if (capacity < 4)
+    {
+        return 0;
+    }
+    if (numSeq < 128)
+    {
+        pDst[0] = (Cpa8U)numSeq;
+        headerSize = 1;
+    }
+    else if (numSeq < DC_ZSTD_SEQ_LONG_NUM)
+    {
+        pDst[0] = (Cpa8U)((numSeq >> 8) + 128);
+        pDst[1] = (Cpa8U)numSeq;
+        headerSize = 2;
+    }
+    else
+    {
+        pDst[0] = 0xFF;
+        dcZstdWriteLE16(pDst + 1, numSeq - DC_ZSTD_SEQ_LONG_NUM);
+        headerSize = 3;
+    }
+    if (0 == numSeq)
+    {
+        return headerSize;
+    }
+
+    osalMemSet(pCtx->codeCounts, 0, sizeof(pCtx->codeCounts));
+    for (n = 0; n < numSeq; n++)
+    {
+        dcZstdSeqCodes(&pSeq[n], codes);
+        for (i = 0; i < DC_ZSTD_NUM_CODES; i++)
+        {
+            pCtx->codeCounts[i][codes[i]]++;
+        }
+    }
+
+    pModes = &pDst[headerSize++];
+    for (i = 0; i < DC_ZSTD_NUM_CODES; i++)
+    {
+        Cpa32U mode = DC_ZSTD_SEQ_MODE_PREDEFINED;
+
+        headerSize += dcZstdSelectTable(
+            pCtx, i, numSeq, &mode, pDst + headerSize, capacity - headerSize);
+        modes |= mode << (6 - 2 * i);
+        pTables[i] = (DC_ZSTD_SEQ_MODE_PREDEFINED == mode)
+                         ? &pCtx->defaultTables[i]
+                         : &pCtx->blockTables[i];
+    }
+    *pModes = (Cpa8U)modes;
+
+    /* The decoder reads the sequences first to last, so they are written
+     * last to first with the fields in reverse order. The states start
+     * from the codes of the last sequence, which are not encoded. */
+    dcZstdBitInit(&bw, pDst + headerSize, capacity - headerSize);
+    dcZstdSeqCodes(&pSeq[numSeq - 1], codes);
+    dcZstdFseInitState(
+        &mlState, pTables[DC_ZSTD_CODE_ML], codes[DC_ZSTD_CODE_ML]);
+    dcZstdFseInitState(
+        &ofState, pTables[DC_ZSTD_CODE_OF], codes[DC_ZSTD_CODE_OF]);
+    dcZstdFseInitState(
+        &llState, pTables[DC_ZSTD_CODE_LL], codes[DC_ZSTD_CODE_LL]);
+    dcZstdSeqWriteBits(&bw, &pSeq[numSeq - 1], codes);
+    for (n = numSeq - 1; n > 0; n--)
+    {
+        const dc_zstd_seq_t *pCur = &pSeq[n - 1];
+
+        dcZstdSeqCodes(pCur, codes);
+        dcZstdFseEncode(&bw, &ofState, codes[DC_ZSTD_CODE_OF]);
+        dcZstdFseEncode(&bw, &mlState, codes[DC_ZSTD_CODE_ML]);
+        dcZstdFseEncode(&bw, &llState, codes[DC_ZSTD_CODE_LL]);
+        dcZstdSeqWriteBits(&bw, pCur, codes);
+    }
+    dcZstdFseFlushState(&bw, &mlState);
+    dcZstdFseFlushState(&bw, &ofState);
+    dcZstdFseFlushState(&bw, &llState);
+    streamSize = dcZstdBitClose(&bw);
+    if (0 == streamSize)
+    {
+        return 0;
+    }
+
+    return headerSize + streamSize;
+}
+
+/* Code an offset, using the repeat offsets when possible, and update the
+ * history the way the decoder will. Without literals the repeat codes are
+ * shifted by one: 1 and 2 select the second and third offsets and 3 the
+ * first one minus one. */
+STATIC Cpa32U dcZstdOffBase(dc_zstd_ctx_t *pCtx,
+                            Cpa32U offset,
+                            Cpa32U litLength)
+{
+    Cpa32U *pRep = pCtx->rep;
+    Cpa32U offBase = offset + DC_ZSTD_REP_NUM;
+    Cpa32U index = 0;
+
+    if (0 != litLength)
+    {
+        if (offset == pRep[0])
+        {
+            offBase = 1;
+        }
+        else if (offset == pRep[1])
+        {
+            offBase = 2;
+        }
+        else if (offset == pRep[2])
+        {
+            offBase = 3;
+        }
+    }
+    else
+    {
+        if (offset == pRep[1])
+        {
+            offBase = 1;
+        }
+        else if (offset == pRep[2])
+        {
+            offBase = 2;
+        }
+        else if (offset == pRep[0] - 1)
+        {
+            offBase = 3;
+        }
+    }
+
+    if (offBase > DC_ZSTD_REP_NUM)
+    {
+        pRep[2] = pRep[1];
+        pRep[1] = pRep[0];
+        pRep[0] = offset;
+        return offBase;
+    }
+
+    index = offBase - 1 + ((0 == litLength) ? 1 : 0);
+    if (0 != index)
+    {
+        if (1 != index)
+        {
+            pRep[2] = pRep[1];
+        }
+        pRep[1] = pRep[0];
+        pRep[0] = offset;
+    }
+    return offBase;
+}
+
+/* Move the source cursor forward, copying the data if pDst is set */
+STATIC CpaStatus dcZstdReadSource(dc_zstd_ctx_t *pCtx,
+                                  Cpa8U *pDst,
+                                  Cpa32U length)
+{
+    const CpaBufferList *pList = pCtx->pSrcBuff;
+
+    while (length > 0)
+    {
+        const CpaFlatBuffer *pFlat = NULL;
+        Cpa32U chunk = 0;
+
+        if (pCtx->srcBufferIndex >= pList->numBuffers)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        pFlat = &pList->pBuffers[pCtx->srcBufferIndex];
+        chunk = DC_ZSTD_MIN(length,
+                            pFlat->dataLenInBytes - pCtx->srcBufferOffset);
+        if ((NULL != pDst) && (0 != chunk))
+        {
+            osalMemCopy(pDst, pFlat->pData + pCtx->srcBufferOffset, chunk);
+            pDst += chunk;
+        }
+        pCtx->srcBufferOffset += chunk;
+        length -= chunk;
+        if (pCtx->srcBufferOffset == pFlat->dataLenInBytes)
+        {
+            pCtx->srcBufferIndex++;
+            pCtx->srcBufferOffset = 0;
+        }
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Encode the block built so far. A block that does not shrink is stored
+ * raw from the source data. */
+STATIC CpaStatus dcZstdFlushBlock(dc_zstd_ctx_t *pCtx, CpaBoolean lastBlock)
+{
+    Cpa8U *pBlock = pCtx->pDst;
+    Cpa32U capacity = (Cpa32U)(pCtx->pDstEnd - pBlock);
+    Cpa32U blockType = DC_ZSTD_BLOCK_TYPE_RAW;
+    Cpa32U blockSize = pCtx->blockSize;
+    Cpa32U litSize = 0;
+    Cpa32U seqSize = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (capacity < DC_ZSTD_BLOCK_HEADER_SIZE)
+    {
+        return CPA_STATUS_FAIL;
+    }
+    capacity -= DC_ZSTD_BLOCK_HEADER_SIZE;
+
+    if (0 != pCtx->blockSize)
+    {
+        Cpa8U *pOut = pBlock + DC_ZSTD_BLOCK_HEADER_SIZE;
+        Cpa32U limit = DC_ZSTD_MIN(capacity, pCtx->blockSize - 1);
+
+        litSize = dcZstdWriteLiterals(pCtx, pOut, limit);
+        if (0 != litSize)
+        {
+            seqSize =
+                dcZstdWriteSequences(pCtx, pOut + litSize, limit - litSize);
+        }
+        if ((0 != litSize) && (0 != seqSize))
+        {
+            blockType = DC_ZSTD_BLOCK_TYPE_COMPRESSED;
+            blockSize = litSize + seqSize;
+        }
+    }
+
+    if (DC_ZSTD_BLOCK_TYPE_RAW == blockType)
+    {
+        if (capacity < blockSize)
+        {
+            return CPA_STATUS_FAIL;
+        }
+        status = dcZstdReadSource(
+            pCtx, pBlock + DC_ZSTD_BLOCK_HEADER_SIZE, blockSize);
+    }
+    else
+    {
+        status = dcZstdReadSource(pCtx, NULL, pCtx->blockSize);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    dcZstdWriteLE24(pBlock,
+                    ((CPA_TRUE == lastBlock) ? 1 : 0) | (blockType << 1) |
+                        (blockSize << 3));
+    pCtx->pDst += DC_ZSTD_BLOCK_HEADER_SIZE + blockSize;
+    pCtx->numLiterals = 0;
+    pCtx->numSequences = 0;
+    pCtx->pendingLiterals = 0;
+    pCtx->blockSize = 0;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC CpaStatus dcZstdAddLiterals(dc_zstd_ctx_t *pCtx,
+                                   const Cpa8U *pLiterals,
+                                   Cpa32U length)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    while (length > 0)
+    {
+        Cpa32U chunk = DC_ZSTD_BLOCK_SIZE_MAX - pCtx->blockSize;
+
+        if (0 == chunk)
+        {
+            status = dcZstdFlushBlock(pCtx, CPA_FALSE);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                return status;
+            }
+            continue;
+        }
+        chunk = DC_ZSTD_MIN(chunk, length);
+        osalMemCopy(pCtx->literals + pCtx->numLiterals, pLiterals, chunk);
+        pCtx->numLiterals += chunk;
+        pCtx->pendingLiterals += chunk;
+        pCtx->blockSize += chunk;
+        pLiterals += chunk;
+        length -= chunk;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Add a match to the block. A match crossing the block boundary is split
+ * in two with the same offset, both parts being at least
+ * DC_ZSTD_MIN_MATCH long. */
+STATIC CpaStatus dcZstdAddMatch(dc_zstd_ctx_t *pCtx,
+                                Cpa32U offset,
+                                Cpa32U length)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    while (length > 0)
+    {
+        Cpa32U chunk = DC_ZSTD_BLOCK_SIZE_MAX - pCtx->blockSize;
+
+        if (length <= chunk)
+        {
+            chunk = length;
+        }
+        else if (length - chunk < DC_ZSTD_MIN_MATCH)
+        {
+            chunk = length - DC_ZSTD_MIN_MATCH;
+        }
+        if (chunk >= DC_ZSTD_MIN_MATCH)
+        {
+            dc_zstd_seq_t *pSeq = &pCtx->sequences[pCtx->numSequences++];
+
+            pSeq->litLength = pCtx->pendingLiterals;
+            pSeq->matchLength = chunk;
+            pSeq->offBase =
+                dcZstdOffBase(pCtx, offset, pCtx->pendingLiterals);
+            pCtx->pendingLiterals = 0;
+            pCtx->blockSize += chunk;
+            length -= chunk;
+        }
+        if (length > 0)
+        {
+            status = dcZstdFlushBlock(pCtx, CPA_FALSE);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                return status;
+            }
+        }
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Read an LZ4s length extension: bytes are added while they are 255 */
+STATIC INLINE CpaStatus dcLz4sReadLength(const Cpa8U **ppIn,
+                                         const Cpa8U *pEnd,
+                                         Cpa32U *pLength)
+{
+    const Cpa8U *pIn = *ppIn;
+    Cpa32U byte = 0;
+
+    do
+    {
+        if (pIn >= pEnd)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        byte = *pIn++;
+        *pLength += byte;
+    } while (DC_LZ4S_LEN_CONTINUE == byte);
+
+    *ppIn = pIn;
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Walk the LZ4s sequences. Each token holds the literal length in its high
+ * nibble and the match length in its low nibble, 15 meaning more length
+ * bytes follow. A match length of 0 carries literals only, otherwise the
+ * match is minMatch - 1 bytes longer than the field. */
+STATIC CpaStatus dcZstdParseLz4s(dc_zstd_ctx_t *pCtx,
+                                 const Cpa8U *pIn,
+                                 Cpa32U inLen,
+                                 Cpa32U minMatch,
+                                 Cpa32U srcLen)
+{
+    const Cpa8U *pEnd = pIn + inLen;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    while (pIn < pEnd)
+    {
+        Cpa32U token = *pIn++;
+        Cpa32U litLength = token >> DC_LZ4S_LIT_SHIFT;
+        Cpa32U matchLength = token & DC_LZ4S_ML_MASK;
+        Cpa32U offset = 0;
+
+        if (DC_LZ4S_RUN_MASK == litLength)
+        {
+            status = dcLz4sReadLength(&pIn, pEnd, &litLength);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                return status;
+            }
+        }
+        if ((litLength > (Cpa32U)(pEnd - pIn)) ||
+            (litLength > srcLen - pCtx->position))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        status = dcZstdAddLiterals(pCtx, pIn, litLength);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+        pIn += litLength;
+        pCtx->position += litLength;
+
+        /* The last sequence has literals only */
+        if (pIn == pEnd)
+        {
+            break;
+        }
+        if ((Cpa32U)(pEnd - pIn) < DC_LZ4S_OFFSET_SIZE)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        offset = pIn[0] | (pIn[1] << 8);
+        pIn += DC_LZ4S_OFFSET_SIZE;
+
+        if (DC_LZ4S_ML_MASK == matchLength)
+        {
+            status = dcLz4sReadLength(&pIn, pEnd, &matchLength);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                return status;
+            }
+        }
+        if (0 == matchLength)
+        {
+            continue;
+        }
+        matchLength += minMatch - 1;
+        if ((0 == offset) || (offset > pCtx->position) ||
+            (matchLength > srcLen - pCtx->position))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        status = dcZstdAddMatch(pCtx, offset, matchLength);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+        pCtx->position += matchLength;
+    }
+
+    return (srcLen == pCtx->position) ? CPA_STATUS_SUCCESS
+                                      : CPA_STATUS_INVALID_PARAM;
+}
+
+/* Frames of up to one block are single segment: the window is the content
+ * size and no window descriptor is needed */
+STATIC Cpa32U dcZstdWriteFrameHeader(Cpa8U *pDst, Cpa32U srcLen)
+{
+    Cpa8U *pOut = pDst;
+
+    dcZstdWriteLE32(pOut, DC_ZSTD_MAGIC_NUMBER);
+    pOut += DC_ZSTD_MAGIC_NUMBER_SIZE;
+
+    if (srcLen <= DC_ZSTD_BLOCK_SIZE_MAX)
+    {
+        if (srcLen < DC_ZSTD_FCS_2_BYTES_OFFSET)
+        {
+            *pOut++ = DC_ZSTD_FHD_SINGLE_SEGMENT;
+            *pOut++ = (Cpa8U)srcLen;
+        }
+        else if (srcLen < DC_ZSTD_FCS_2_BYTES_MAX)
+        {
+            *pOut++ = DC_ZSTD_FHD_SINGLE_SEGMENT | (1 << DC_ZSTD_FHD_FCS_SHIFT);
+            dcZstdWriteLE16(pOut, srcLen - DC_ZSTD_FCS_2_BYTES_OFFSET);
+            pOut += 2;
+        }
+        else
+        {
+            *pOut++ = DC_ZSTD_FHD_SINGLE_SEGMENT | (2 << DC_ZSTD_FHD_FCS_SHIFT);
+            dcZstdWriteLE32(pOut, srcLen);
+            pOut += 4;
+        }
+    }
+    else
+    {
+        *pOut++ = (2 << DC_ZSTD_FHD_FCS_SHIFT);
+        *pOut++ = DC_ZSTD_WINDOW_DESCRIPTOR;
+        dcZstdWriteLE32(pOut, srcLen);
+        pOut += 4;
+    }
+
+    return (Cpa32U)(pOut - pDst);
+}
+
+CpaStatus icp_sal_DcZstdCompressBound(Cpa32U inputSize, Cpa32U *pOutputSize)
+{
+    Cpa64U bound = 0;
+    Cpa32U numBlocks = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pOutputSize);
+#endif
+
+    numBlocks = (inputSize + DC_ZSTD_BLOCK_SIZE_MAX - 1) /
+                DC_ZSTD_BLOCK_SIZE_MAX;
+    if (0 == numBlocks)
+    {
+        numBlocks = 1;
+    }
+    bound = (Cpa64U)inputSize + DC_ZSTD_FRAME_HEADER_SIZE_MAX +
+            ((Cpa64U)numBlocks * DC_ZSTD_BLOCK_HEADER_SIZE);
+    if (bound > 0xFFFFFFFFULL)
+    {
+        LAC_INVALID_PARAM_LOG("inputSize too large");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    *pOutputSize = (Cpa32U)bound;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcLZ4SToZstd(const CpaFlatBuffer *pLz4sBuff,
+                               CpaDcCompMinMatch minMatch,
+                               const CpaBufferList *pSrcBuff,
+                               Cpa32U srcLen,
+                               CpaFlatBuffer *pDestBuff,
+                               Cpa32U *pProduced)
+{
+    dc_zstd_ctx_t *pCtx = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pLz4sBuff);
+    LAC_CHECK_NULL_PARAM(pSrcBuff);
+    LAC_CHECK_NULL_PARAM(pSrcBuff->pBuffers);
+    LAC_CHECK_NULL_PARAM(pDestBuff);
+    LAC_CHECK_NULL_PARAM(pDestBuff->pData);
+    LAC_CHECK_NULL_PARAM(pProduced);
+    if ((0 != pLz4sBuff->dataLenInBytes) && (NULL == pLz4sBuff->pData))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid LZ4s buffer");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if ((CPA_DC_MIN_3_BYTE_MATCH != minMatch) &&
+        (CPA_DC_MIN_4_BYTE_MATCH != minMatch))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid minMatch value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+
+    if (pDestBuff->dataLenInBytes <
+        DC_ZSTD_FRAME_HEADER_SIZE_MAX + DC_ZSTD_BLOCK_HEADER_SIZE)
+    {
+        LAC_LOG_ERROR("Destination buffer too small for a zstd frame");
+        return CPA_STATUS_FAIL;
+    }
+
+    status = LAC_OS_MALLOC(&pCtx, sizeof(dc_zstd_ctx_t));
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_LOG_ERROR("Failed to allocate the zstd conversion context");
+        return status;
+    }
+    pCtx->numLiterals = 0;
+    pCtx->numSequences = 0;
+    pCtx->pendingLiterals = 0;
+    pCtx->blockSize = 0;
+    pCtx->position = 0;
+    pCtx->pSrcBuff = pSrcBuff;
+    pCtx->srcBufferIndex = 0;
+    pCtx->srcBufferOffset = 0;
+    pCtx->pDst = pDestBuff->pData;
+    pCtx->pDstEnd = pDestBuff->pData + pDestBuff->dataLenInBytes;
+    pCtx->rep[0] = DC_ZSTD_REP_START_1;
+    pCtx->rep[1] = DC_ZSTD_REP_START_2;
+    pCtx->rep[2] = DC_ZSTD_REP_START_3;
+    for (i = 0; i < DC_ZSTD_NUM_CODES; i++)
+    {
+        dcZstdFseBuildTable(&pCtx->defaultTables[i],
+                            dcZstdCodeDesc[i].pDefaultNorm,
+                            dcZstdCodeDesc[i].maxSymbol,
+                            dcZstdCodeDesc[i].defaultLog);
+    }
+
+    pCtx->pDst += dcZstdWriteFrameHeader(pCtx->pDst, srcLen);
+
+    status = dcZstdParseLz4s(pCtx,
+                             pLz4sBuff->pData,
+                             pLz4sBuff->dataLenInBytes,
+                             (CPA_DC_MIN_4_BYTE_MATCH == minMatch) ? 4 : 3,
+                             srcLen);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = dcZstdFlushBlock(pCtx, CPA_TRUE);
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        *pProduced = (Cpa32U)(pCtx->pDst - pDestBuff->pData);
+    }
+    else if (CPA_STATUS_INVALID_PARAM == status)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid LZ4s or source data");
+    }
+    else
+    {
+        LAC_LOG_ERROR("Destination buffer too small for the zstd frame");
+    }
+
+    LAC_OS_FREE(pCtx);
+    return status;
+}
+
+CpaStatus icp_sal_DcZstdCompressData(CpaInstanceHandle dcInstance,
+                                     CpaDcSessionHandle pSessionHandle,
+                                     CpaBufferList *pSrcBuff,
+                                     CpaBufferList *pLz4sBuff,
+                                     CpaFlatBuffer *pDestBuff,
+                                     CpaDcRqResults *pResults)
+{
+    dc_session_desc_t *pSessionDesc = NULL;
+    CpaFlatBuffer lz4sData = {0};
+    Cpa32U produced = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pSrcBuff);
+    LAC_CHECK_NULL_PARAM(pLz4sBuff);
+    LAC_CHECK_NULL_PARAM(pLz4sBuff->pBuffers);
+    LAC_CHECK_NULL_PARAM(pDestBuff);
+    LAC_CHECK_NULL_PARAM(pResults);
+#endif
+
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+#endif
+
+    if ((CPA_DC_LZ4S != pSessionDesc->compType) ||
+        (CPA_DC_STATELESS != pSessionDesc->sessState) ||
+        (CPA_DC_DIR_DECOMPRESS == pSessionDesc->sessDirection))
+    {
+        LAC_INVALID_PARAM_LOG("zstd requires a stateless LZ4S compression "
+                              "session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (LacSync_GenWakeupSyncCaller != pSessionDesc->pCompressionCb)
+    {
+        LAC_INVALID_PARAM_LOG("zstd requires a synchronous session");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (1 != pLz4sBuff->numBuffers)
+    {
+        LAC_INVALID_PARAM_LOG("Intermediate buffer list must hold a single "
+                              "flat buffer");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    status = cpaDcCompressData(dcInstance,
+                               pSessionHandle,
+                               pSrcBuff,
+                               pLz4sBuff,
+                               pResults,
+                               CPA_DC_FLUSH_FINAL,
+                               NULL);
+    if ((CPA_STATUS_SUCCESS != status) || (CPA_DC_OK != pResults->status))
+    {
+        return status;
+    }
+
+    lz4sData.pData = pLz4sBuff->pBuffers[0].pData;
+    lz4sData.dataLenInBytes = pResults->produced;
+    status = icp_sal_DcLZ4SToZstd(&lz4sData,
+                                  pSessionDesc->minMatch,
+                                  pSrcBuff,
+                                  pResults->consumed,
+                                  pDestBuff,
+                                  &produced);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pResults->produced = produced;
+    }
+
+    return status;
+}
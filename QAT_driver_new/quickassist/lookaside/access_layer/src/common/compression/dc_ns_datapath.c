@@ -68,6 +68,7 @@
 #include "dc_session.h"
 #include "dc_datapath.h"
 #include "dc_ns_datapath.h"
+#include "dc_inter_buff_pool.h"
 #include "sal_statistics.h"
 #include "lac_common.h"
 #include "lac_mem.h"
@@ -1269,6 +1270,171 @@ CpaStatus dcNsCreateBaseRequest(icp_qat_fw_comp_req_t *pMsg,
     return CPA_STATUS_SUCCESS;
 }
 
+/* FNV-1a step over the four bytes of a setup data field */
+STATIC INLINE Cpa32U dcNsHashField(Cpa32U hash, Cpa32U value)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < sizeof(Cpa32U); i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+/* FNV-1a hash of the setup data. The fields are hashed one by one so the
+ * padding of the structure never reaches the hash. */
+STATIC Cpa32U dcNsSetupDataHash(const CpaDcNsSetupData *pSetupData)
+{
+    Cpa32U hash = 0x811c9dc5;
+
+    hash = dcNsHashField(hash, pSetupData->compLevel);
+    hash = dcNsHashField(hash, pSetupData->compType);
+    hash = dcNsHashField(hash, pSetupData->huffType);
+    hash = dcNsHashField(hash, pSetupData->autoSelectBestHuffmanTree);
+    hash = dcNsHashField(hash, pSetupData->sessDirection);
+    hash = dcNsHashField(hash, pSetupData->sessState);
+    hash = dcNsHashField(hash, pSetupData->windowSize);
+    hash = dcNsHashField(hash, pSetupData->minMatch);
+    hash = dcNsHashField(hash, pSetupData->lz4BlockMaxSize);
+    hash = dcNsHashField(hash, pSetupData->lz4BlockChecksum);
+    hash = dcNsHashField(hash, pSetupData->lz4BlockIndependence);
+    hash = dcNsHashField(hash, pSetupData->checksum);
+    hash = dcNsHashField(hash, pSetupData->accumulateXXHash);
+    return hash;
+}
+
+/* Compare the fields of two setup data, leaving the padding out */
+STATIC CpaBoolean dcNsSetupDataEqual(const CpaDcNsSetupData *pA,
+                                     const CpaDcNsSetupData *pB)
+{
+    if (pA->compLevel != pB->compLevel || pA->compType != pB->compType ||
+        pA->huffType != pB->huffType ||
+        pA->autoSelectBestHuffmanTree != pB->autoSelectBestHuffmanTree ||
+        pA->sessDirection != pB->sessDirection ||
+        pA->sessState != pB->sessState || pA->windowSize != pB->windowSize ||
+        pA->minMatch != pB->minMatch ||
+        pA->lz4BlockMaxSize != pB->lz4BlockMaxSize ||
+        pA->lz4BlockChecksum != pB->lz4BlockChecksum ||
+        pA->lz4BlockIndependence != pB->lz4BlockIndependence ||
+        pA->checksum != pB->checksum ||
+        pA->accumulateXXHash != pB->accumulateXXHash)
+    {
+        return CPA_FALSE;
+    }
+    return CPA_TRUE;
+}
+
+CpaStatus dcNsGetBaseRequest(icp_qat_fw_comp_req_t *pMsg,
+                             sal_compression_service_t *pService,
+                             CpaDcNsSetupData *pSetupData)
+{
+    dc_ns_req_cache_t *pCache = &pService->nsReqCache;
+    dc_ns_req_template_t *pTemplate = NULL;
+    dc_ns_req_template_t *pVictim = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U hash = dcNsSetupDataHash(pSetupData);
+    Cpa64U clock = pCache->clock;
+    Cpa32U seq = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < DC_NS_REQ_CACHE_SIZE; i++)
+    {
+        pTemplate = &pCache->templates[i];
+        seq = pTemplate->seq;
+        __sync_synchronize();
+        if ((seq & 1) || CPA_TRUE != pTemplate->valid ||
+            hash != pTemplate->hash ||
+            CPA_TRUE != dcNsSetupDataEqual(&pTemplate->setupData, pSetupData))
+        {
+            continue;
+        }
+        osalMemCopy((void *)pMsg,
+                    (void *)&pTemplate->request,
+                    LAC_QAT_DC_REQ_SZ_LW * LAC_LONG_WORD_IN_BYTES);
+        __sync_synchronize();
+        if (seq == pTemplate->seq)
+        {
+            /* Only write the stamp when the clock moved since the last use,
+             * a racing stamp is harmless */
+            if (clock != pTemplate->lastUsed)
+            {
+                pTemplate->lastUsed = clock;
+            }
+            return CPA_STATUS_SUCCESS;
+        }
+        break;
+    }
+
+    status = dcNsCreateBaseRequest(pMsg, pService, pSetupData);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* Keep the request for following requests. If another thread is
+     * updating the cache this request does without. */
+    if (0 == __sync_lock_test_and_set(&pCache->lock, 1))
+    {
+        /* Replace an empty template, or the least recently used one */
+        pVictim = &pCache->templates[0];
+        for (i = 0; i < DC_NS_REQ_CACHE_SIZE; i++)
+        {
+            pTemplate = &pCache->templates[i];
+            if (CPA_TRUE != pTemplate->valid)
+            {
+                pVictim = pTemplate;
+                break;
+            }
+            if (pTemplate->lastUsed < pVictim->lastUsed)
+            {
+                pVictim = pTemplate;
+            }
+        }
+
+        pVictim->seq++;
+        __sync_synchronize();
+        osalMemCopy((void *)&pVictim->setupData,
+                    (void *)pSetupData,
+                    sizeof(CpaDcNsSetupData));
+        osalMemCopy((void *)&pVictim->request,
+                    (void *)pMsg,
+                    LAC_QAT_DC_REQ_SZ_LW * LAC_LONG_WORD_IN_BYTES);
+        pVictim->hash = hash;
+        pVictim->lastUsed = ++pCache->clock;
+        pVictim->valid = CPA_TRUE;
+        __sync_synchronize();
+        pVictim->seq++;
+        __sync_lock_release(&pCache->lock);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+void dcNsReqCacheInvalidate(sal_compression_service_t *pService)
+{
+    dc_ns_req_cache_t *pCache = &pService->nsReqCache;
+    dc_ns_req_template_t *pTemplate = NULL;
+    Cpa32U i = 0;
+
+    while (0 != __sync_lock_test_and_set(&pCache->lock, 1))
+    {
+        while (pCache->lock)
+            ;
+    }
+    for (i = 0; i < DC_NS_REQ_CACHE_SIZE; i++)
+    {
+        pTemplate = &pCache->templates[i];
+        pTemplate->seq++;
+        __sync_synchronize();
+        pTemplate->valid = CPA_FALSE;
+        __sync_synchronize();
+        pTemplate->seq++;
+    }
+    __sync_lock_release(&pCache->lock);
+}
+
 STATIC CpaStatus dcNsCreateRequest(dc_compression_cookie_t *pCookie,
                                    sal_compression_service_t *pService,
                                    CpaDcNsSetupData *pSetupData,
@@ -1302,7 +1468,7 @@ STATIC CpaStatus dcNsCreateRequest(dc_compression_cookie_t *pCookie,
 
     pMsg = &pCookie->request;
 
-    status = dcNsCreateBaseRequest(pMsg, pService, pSetupData);
+    status = dcNsGetBaseRequest(pMsg, pService, pSetupData);
 
     if (status != CPA_STATUS_SUCCESS)
     {
@@ -1890,6 +2056,16 @@ CpaStatus cpaDcNsCompressData(CpaInstanceHandle dcInstance,
     /* Check if SAL is initialised otherwise return an error */
     SAL_RUNNING_CHECK(insHandle);
 
+#ifndef ICP_DC_DYN_NOT_SUPPORTED
+    /* Borrow the shared intermediate buffers of the device if the instance
+     * was started without any */
+    if (isDcGen2x(pService) && CPA_DC_HT_FULL_DYNAMIC == pSetupData->huffType &&
+        0 == pService->pInterBuffPtrsArrayPhyAddr)
+    {
+        (void)dcInterBuffPoolAttach(pService);
+    }
+#endif
+
 #ifdef ICP_PARAM_CHECK
     /* Check that the parameters defined in pSetupData are valid for the
      * device */
@@ -73,6 +73,7 @@
 #include "sal_qat_cmn_msg.h"
 #include "sal_hw_gen.h"
 #include "dc_crc64.h"
+#include "dc_inter_buff_pool.h"
 
 
 #ifdef ICP_PARAM_CHECK
@@ -1042,6 +1043,14 @@ CpaStatus dcInitSession(CpaInstanceHandle dcInstance,
     if (isDcGen2x(pService) &&
         (CPA_DC_HT_FULL_DYNAMIC == pSessionData->huffType))
     {
+        /* Without intermediate buffers of its own the instance borrows the
+         * shared ones of its device */
+        if ((NULL == pService->pInterBuffPtrsArray) &&
+            (0 == pService->pInterBuffPtrsArrayPhyAddr))
+        {
+            (void)dcInterBuffPoolAttach(pService);
+        }
+
         /* Test if DRAM is available for the intermediate buffers */
         if ((NULL == pService->pInterBuffPtrsArray) &&
             (0 == pService->pInterBuffPtrsArrayPhyAddr))
@@ -1166,6 +1175,10 @@ CpaStatus dcInitSession(CpaInstanceHandle dcInstance,
     pSessionDesc->minMatch = pSessionData->minMatch;
     pSessionDesc->isDcDp = CPA_FALSE;
     pSessionDesc->minContextSize = minContextSize;
+    pSessionDesc->minCompDestBuffSize =
+        (CPA_DC_HT_FULL_DYNAMIC == pSessionDesc->huffType)
+            ? pService->comp_device_data.minOutputBuffSizeDynamic
+            : pService->comp_device_data.minOutputBuffSize;
     pSessionDesc->isSopForCompressionProcessed = CPA_FALSE;
     pSessionDesc->isSopForDecompressionProcessed = CPA_FALSE;
     pSessionDesc->crcConfig.useProgCrcSetup = CPA_FALSE;
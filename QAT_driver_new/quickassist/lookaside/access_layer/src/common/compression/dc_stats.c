@@ -70,15 +70,34 @@
 #include "sal_types_compression.h"
 #include "dc_stats.h"
 
+#ifndef KERNEL_SPACE
+__thread Cpa32U dcStatsThreadShard = COMPRESSION_STATS_NUM_SHARDS;
+
+STATIC Cpa32U dcStatsNextShard = 0;
+
+Cpa32U dcStatsAssignShard(void)
+{
+    dcStatsThreadShard = __sync_fetch_and_add(&dcStatsNextShard, 1) %
+                         COMPRESSION_STATS_NUM_SHARDS;
+    return dcStatsThreadShard;
+}
+#endif
 
 CpaStatus dcStatsInit(sal_compression_service_t *pService)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
 
-    status = LAC_OS_MALLOC(&(pService->pCompStatsArr),
-                           COMPRESSION_NUM_STATS * sizeof(OsalAtomic));
+    pService->pCompStatsShards =
+        osalMemAllocAligned(0,
+                            COMPRESSION_STATS_NUM_SHARDS *
+                                sizeof(dc_stats_shard_t),
+                            COMPRESSION_STATS_SHARD_ALIGNMENT);
 
-    if (CPA_STATUS_SUCCESS == status)
+    if (NULL == pService->pCompStatsShards)
+    {
+        status = CPA_STATUS_RESOURCE;
+    }
+    else
     {
         COMPRESSION_STATS_RESET(pService);
     }
@@ -88,9 +107,10 @@ CpaStatus dcStatsInit(sal_compression_service_t *pService)
 
 void dcStatsFree(sal_compression_service_t *pService)
 {
-    if (NULL != pService->pCompStatsArr)
+    if (NULL != pService->pCompStatsShards)
     {
-        LAC_OS_FREE(pService->pCompStatsArr);
+        osalMemAlignedFree(pService->pCompStatsShards);
+        pService->pCompStatsShards = NULL;
     }
 }
 
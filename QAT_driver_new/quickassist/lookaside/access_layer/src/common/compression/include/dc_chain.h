@@ -63,6 +63,19 @@
 #define FIRST_DC_CHAIN_ITEM 0
 #define NOT_APPLICABLE 0
 
+/* Maximum number of chaining requests put on the ring in one go */
+#define DC_CHAIN_BATCH_MAX_REQUESTS 32
+
+#ifndef DISABLE_STATS
+#define DC_CHAIN_STATS_ENABLED(pService)                                       \
+    (CPA_TRUE == (pService)->generic_service_info.stats->bDcStatsEnabled)
+#else
+#define DC_CHAIN_STATS_ENABLED(pService) CPA_FALSE
+#endif
+
+#define DC_CHAIN_STAT_ADD(statistic, value, pChainService)                     \
+    __sync_fetch_and_add(&(pChainService)->stats.statistic, (value))
+
 /* List of the different OpData types supported as defined in the DC Chain API
  * header file.
  */
@@ -126,15 +139,23 @@ typedef struct dc_chain_cookie_s
     dc_chain_results_ext_t extResults;
     /**< Extensible results buffer holding consumed and produced data */
     void *pDcRspAddr;
-    /**< chaining compression response buffer */
+    /**< chaining compression response buffer, linked at service start */
     void *pCyRspAddr;
-    /**< chaining hash response buffer */
+    /**< chaining hash response buffer, linked at service start */
     void *pDcCookieAddr;
     /**< chaining compression cookie buffer */
     void *pCyCookieAddr;
-    /**< chaining hash cookie buffer */
+    /**< chaining hash cookie buffer, linked at service start */
     void *callbackTag;
     /**< Opaque data supplied by the client */
+    Cpa64U dcRspPhyAddr;
+    /**< Physical address of the compression response buffer */
+    Cpa64U cyRspPhyAddr;
+    /**< Physical address of the hash response buffer */
+    Cpa64U cyReqPhyAddr;
+    /**< Physical address of the hash request held in the hash cookie */
+    Cpa64U submitTimestamp;
+    /**< Time the request was put on the ring, zero when not measured */
 } dc_chain_cookie_t;
 
 typedef struct dc_chain_session_head_s
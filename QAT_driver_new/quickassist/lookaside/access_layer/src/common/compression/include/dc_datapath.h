@@ -56,6 +56,7 @@
 #include "sal_types_compression.h"
 
 #include "lac_mem_pools.h"
+#include "icp_buffer_desc.h"
 
 #define LAC_QAT_DC_REQ_SZ_LW 32
 #define LAC_QAT_DC_RESP_SZ_LW 8
@@ -217,7 +218,9 @@ typedef struct dc_compression_cookie_s
     CpaBufferList *pUserDestBuff;
     /**< virtual userspace ptr to destination SGL */
     CpaDcCallbackFn pCbFunc;
-    /**< Callback function defined for the traditional sessionless API */
+    /**< Callback function defined for the traditional sessionless API or
+     * for a request that is part of a batch. NULL to use the session
+     * callback */
     CpaDcChecksum checksumType;
     /**< Type of checksum */
     dc_integrity_crc_fw_t dataIntegrityCrcs;
@@ -226,6 +229,75 @@ typedef struct dc_compression_cookie_s
     /**< DC Chain info if DC used as part of a DC Chain operation. */
 } dc_compression_cookie_t;
 
+/* Maximum number of requests submitted for a single Batch and Pack call.
+ * Larger batches are truncated and must be resubmitted by the caller. */
+#define DC_BP_MAX_REQUESTS (32)
+
+/* Maximum number of flat buffers of the destination list that a single
+ * request of a batch can span */
+#define DC_BP_MAX_SLOT_BUFFERS (4)
+
+/* Size of the buffer list descriptor of a Batch and Pack slot */
+#define DC_BP_SLOT_META_SIZE                                                   \
+    (sizeof(icp_buffer_list_desc_t) +                                          \
+     (sizeof(icp_flat_buffer_desc_t) * (DC_BP_MAX_SLOT_BUFFERS + 1)) +         \
+     ICP_DESCRIPTOR_ALIGNMENT_BYTES)
+
+/* Number of Batch and Pack contexts per compression instance */
+#define DC_BP_NUM_BATCHES (16)
+
+/**
+*******************************************************************************
+* @ingroup cpaDc Data Compression
+*      Batch and Pack slot
+* @description
+*      Describes the region of the Batch and Pack destination buffer list
+*      which a request of the batch compresses into. The region is sized to
+*      the compress bound of the request so that the requests can run in
+*      parallel; the outputs are packed together once the batch completes.
+*****************************************************************************/
+typedef struct dc_bp_slot_s
+{
+    Cpa8U destMetaData[DC_BP_SLOT_META_SIZE];
+    /**< Buffer list descriptor for destList. Kept first in the structure so
+     * that it inherits the alignment of the memory pool entry */
+    CpaBufferList destList;
+    /**< Destination buffer list of the request */
+    CpaFlatBuffer destBuffers[DC_BP_MAX_SLOT_BUFFERS];
+    /**< Pieces of the user destination buffers making up the slot */
+    Cpa64U offset;
+    /**< Offset of the slot in the user destination data area */
+} dc_bp_slot_t;
+
+/**
+*******************************************************************************
+* @ingroup cpaDc Data Compression
+*      Batch and Pack context
+* @description
+*      Tracks the requests of a cpaDcBPCompressData call. The context is
+*      allocated from a memory pool of the instance and is freed when the
+*      last request of the batch completes.
+*****************************************************************************/
+typedef struct dc_bp_batch_s
+{
+    dc_bp_slot_t slots[DC_BP_MAX_REQUESTS];
+    /**< Destination slots, one per request */
+    OsalAtomic pendingCbCount;
+    /**< Number of requests of the batch still in flight */
+    CpaStatus status;
+    /**< First error reported by a request of the batch */
+    Cpa32U numRequests;
+    /**< Number of requests submitted */
+    CpaDcCallbackFn pCbFunc;
+    /**< User callback of the session */
+    void *callbackTag;
+    /**< Opaque data supplied by the client */
+    CpaBufferList *pDestBuff;
+    /**< User destination buffer list */
+    CpaDcRqResults *pResults;
+    /**< User array of results */
+} dc_bp_batch_t;
+
 /**
  *****************************************************************************
  * @ingroup Dc_DataCompression
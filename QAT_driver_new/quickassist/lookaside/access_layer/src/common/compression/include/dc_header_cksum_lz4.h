@@ -54,4 +54,21 @@ CpaStatus dc_hdr_cksum(const void *xxH32input,
                        const Cpa32U dataLength,
                        Cpa8U *checksum);
 
+/* Size in bytes of the block of input consumed by one xxhash32 round */
+#define DC_XXH32_STRIPE_SIZE 16
+
+/**
+ * @description
+ *     Calculate xxhash32 over a contiguous block of data.
+ *
+ * @param[in] xxH32input        Virtual addr of src input to calculate hash on.
+ * @param[in] dataLength        Length in bytes the input data is.
+ * @param[in] seed              Seed of the hash.
+ * @param[out] result           xxhash32 of the input.
+ */
+CpaStatus dc_xxh32(const void *xxH32input,
+                   const Cpa32U dataLength,
+                   const Cpa32U seed,
+                   Cpa32U *result);
+
 #endif /* end of DC_HEADER_CKSUM_LZ4_H */
@@ -0,0 +1,143 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file dc_inter_buff_pool.h
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Definition of the intermediate buffer pool shared by the compression
+ *      instances of a device.
+ *
+ *****************************************************************************/
+#ifndef DC_INTER_BUFF_POOL_H
+#define DC_INTER_BUFF_POOL_H
+
+#include "cpa.h"
+#include "lac_sal_types.h"
+#include "sal_types_compression.h"
+
+/* Size of each shared intermediate buffer list when the configuration file
+ * does not set DcInterBuffSize in the GENERAL section */
+#define DC_INTER_BUFF_POOL_DEFAULT_SIZE (128 * 1024)
+
+/* Intermediate buffers of a device, shared by all its compression instances
+ * that did not supply their own to cpaDcStartInstance */
+typedef struct dc_inter_buff_pool_s
+{
+    Cpa32U refCount;
+    /**< Number of instances attached to the pool */
+    Cpa16U numBuffLists;
+    /**< Number of intermediate buffer lists */
+    Cpa32U buffListSize;
+    /**< Size of the single flat buffer of each list in bytes */
+    CpaBufferList *pBuffLists;
+    /**< Array of numBuffLists buffer lists */
+    icp_qat_addr_width_t *pInterBuffPtrsArray;
+    /**< Physical addresses of the buffer list descriptors, as given to the
+     * firmware */
+    CpaPhysicalAddr pInterBuffPtrsArrayPhyAddr;
+    /**< Physical address of pInterBuffPtrsArray */
+} dc_inter_buff_pool_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Initialise the shared intermediate buffer pool of a device
+ *
+ * @description
+ *      This function initialises the lock of the pool. The buffers are only
+ *      allocated when the first instance attaches.
+ *
+ * @param[in,out]   pSal             Pointer to the SAL container of the device
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RESOURCE       Error initialising the lock
+ *****************************************************************************/
+CpaStatus dcInterBuffPoolInit(sal_t *pSal);
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Destroy the shared intermediate buffer pool of a device
+ *
+ * @description
+ *      This function frees the pool if instances that were never stopped
+ *      still hold it and destroys the lock of the pool.
+ *
+ * @param[in,out]   pSal             Pointer to the SAL container of the device
+ *
+ *****************************************************************************/
+void dcInterBuffPoolDestroy(sal_t *pSal);
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Attach an instance to the shared intermediate buffer pool
+ *
+ * @description
+ *      This function points the intermediate buffers of the instance at the
+ *      pool of its device, creating the pool on first use. It does nothing
+ *      if the instance already has intermediate buffers.
+ *
+ * @param[in,out]   pService         Pointer to the compression service
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Device not found or address translation
+ *                                   failed
+ * @retval CPA_STATUS_RESOURCE       Error allocating memory
+ *****************************************************************************/
+CpaStatus dcInterBuffPoolAttach(sal_compression_service_t *pService);
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Detach an instance from the shared intermediate buffer pool
+ *
+ * @description
+ *      This function drops the reference of the instance on the pool of its
+ *      device and frees the pool with its last reference.
+ *
+ * @param[in,out]   pService         Pointer to the compression service
+ *
+ *****************************************************************************/
+void dcInterBuffPoolDetach(sal_compression_service_t *pService);
+
+#endif /* DC_INTER_BUFF_POOL_H */
@@ -79,6 +79,44 @@ CpaStatus dcNsCreateBaseRequest(icp_qat_fw_comp_req_t *pMsg,
                                 sal_compression_service_t *pService,
                                 CpaDcNsSetupData *pSetupData);
 
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Get compression base request
+ *
+ * @description
+ *      This function fills in a compression base request. The request is
+ *      copied from the instance request cache when one of its templates was
+ *      built from identical setup data, otherwise it is constructed with
+ *      dcNsCreateBaseRequest and replaces the least recently used
+ *      template.
+ *
+ * @param[out]      pMsg             Pointer to empty message
+ * @param[in]       pService         Pointer to compression service
+ * @param[in]       pSetupData       Pointer to (de)compression parameters
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_UNSUPPORTED    Unsupported algorithm/feature
+ *****************************************************************************/
+CpaStatus dcNsGetBaseRequest(icp_qat_fw_comp_req_t *pMsg,
+                             sal_compression_service_t *pService,
+                             CpaDcNsSetupData *pSetupData);
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Invalidate the No-Session API request cache
+ *
+ * @description
+ *      This function discards the request templates of an instance. It must
+ *      be called whenever instance parameters used by dcNsCreateBaseRequest
+ *      change.
+ *
+ * @param[in]       pService         Pointer to compression service
+ *
+ *****************************************************************************/
+void dcNsReqCacheInvalidate(sal_compression_service_t *pService);
+
 /**
  *****************************************************************************
  * @ingroup Dc_DataCompression
@@ -237,6 +237,32 @@ typedef struct dc_crc_config_s
     /**< Lookup table to speed up crc calculation at runtime */
 } dc_crc_config_t;
 
+/* Fixed point unit of the adaptive destination sizing ratio */
+#define DC_ADAPTIVE_DEST_RATIO_ONE (1024)
+
+/* Adaptive destination sizing state of a session, see
+ * icp_sal_DcAdaptiveDestEnable */
+typedef struct dc_adaptive_dest_s
+{
+    CpaBoolean enabled;
+    /**< Set once the application opted in for the session */
+    Cpa32U marginPercent;
+    /**< Safety margin added on top of the predicted size */
+    Cpa32U ratio;
+    /**< Running ratio of produced to consumed bytes, in units of
+     * 1/DC_ADAPTIVE_DEST_RATIO_ONE. Zero until the first completion */
+    OsalAtomic numRequests;
+    /**< Compression requests completed on the session */
+    OsalAtomic numOverflows;
+    /**< Compression requests that completed with CPA_DC_OVERFLOW */
+    OsalAtomic numContinuations;
+    /**< Continuation requests submitted to recover from an overflow */
+    OsalAtomic pinnedBytes;
+    /**< Pinned memory currently held by adaptive destination buffers */
+    OsalAtomic peakPinnedBytes;
+    /**< High water mark of pinnedBytes */
+} dc_adaptive_dest_t;
+
 /* Session descriptor structure for compression */
 typedef struct dc_session_desc_s
 {
@@ -315,6 +341,11 @@ typedef struct dc_session_desc_s
      * depends on the previous ones and must be decompressed sequentially */
     dc_crc_config_t crcConfig;
     /**< Configuration data for crc operation */
+    dc_adaptive_dest_t adaptiveDest;
+    /**< Adaptive destination sizing state */
+    Cpa32U minCompDestBuffSize;
+    /**< Minimum destination buffer size of a compression request, resolved
+     * at session init for the requests of trusted callers */
 } dc_session_desc_t;
 
 /**
@@ -521,4 +552,22 @@ CpaStatus dcGetDecompressCommandId(sal_compression_service_t *pService,
 void dcTransContentDescPopulate(icp_qat_fw_comp_req_t *pMsg,
                                 icp_qat_fw_slice_t nextSlice);
 
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Account a compression response for adaptive destination sizing
+ *
+ * @description
+ *      This function folds the consumed and produced byte counts of a
+ *      completed compression request into the running ratio of the session
+ *      and counts overflows. It must only be called for sessions on which
+ *      adaptive destination sizing is enabled.
+ *
+ * @param[in,out]   pSessionDesc     Pointer to the session descriptor
+ * @param[in]       pResults         Results of the completed request
+ *
+ *****************************************************************************/
+void dcAdaptiveDestUpdate(dc_session_desc_t *pSessionDesc,
+                          const CpaDcRqResults *pResults);
+
 #endif /* DC_SESSION_H */
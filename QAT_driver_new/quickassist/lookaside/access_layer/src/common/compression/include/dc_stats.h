@@ -51,32 +51,77 @@
 /* Number of Compression statistics */
 #define COMPRESSION_NUM_STATS (sizeof(CpaDcStats) / sizeof(Cpa64U))
 
+/* Number of shards the Compression statistics are spread over. Each thread
+ * increments the counters of one shard only, the shards are summed when the
+ * statistics are read. */
+#ifdef KERNEL_SPACE
+#define COMPRESSION_STATS_NUM_SHARDS 1
+#else
+#define COMPRESSION_STATS_NUM_SHARDS 16
+#endif
+
+/* Alignment of a stats shard, prevents false sharing between shards */
+#define COMPRESSION_STATS_SHARD_ALIGNMENT 64
+
+/**
+*******************************************************************************
+* @ingroup Dc_DataCompression
+*      Compression statistics shard
+*
+* @description
+*      One copy of all compression counters, indexed the same way as the
+*      fields of CpaDcStats.
+*
+*****************************************************************************/
+typedef struct dc_stats_shard_s
+{
+    volatile Cpa64U stats[COMPRESSION_NUM_STATS];
+} __attribute__((aligned(COMPRESSION_STATS_SHARD_ALIGNMENT))) dc_stats_shard_t;
+
+#ifdef KERNEL_SPACE
+#define COMPRESSION_STATS_SHARD_INDEX() 0
+#else
+/* Shard index of the calling thread, COMPRESSION_STATS_NUM_SHARDS until the
+ * thread increments its first counter */
+extern __thread Cpa32U dcStatsThreadShard;
+
+#define COMPRESSION_STATS_SHARD_INDEX()                                        \
+    (likely(dcStatsThreadShard < COMPRESSION_STATS_NUM_SHARDS)                 \
+         ? dcStatsThreadShard                                                  \
+         : dcStatsAssignShard())
+#endif
+
 #ifndef DISABLE_STATS
-/* Macro to increment a Compression stat (derives offset into array of
- * atomics) */
+/* Macro to increment a Compression stat (derives offset into the stats shard
+ * of the calling thread) */
 #define COMPRESSION_STAT_INC(statistic, pService)                              \
     do                                                                         \
     {                                                                          \
         if (CPA_TRUE == pService->generic_service_info.stats->bDcStatsEnabled) \
         {                                                                      \
-            osalAtomicInc(                                                     \
-                &pService->pCompStatsArr[offsetof(CpaDcStats, statistic) /     \
-                                         sizeof(Cpa64U)]);                     \
+            __sync_fetch_and_add(                                              \
+                &pService->pCompStatsShards[COMPRESSION_STATS_SHARD_INDEX()]   \
+                     .stats[offsetof(CpaDcStats, statistic) / sizeof(Cpa64U)], \
+                1);                                                            \
         }                                                                      \
     } while (0)
 #else
 #define COMPRESSION_STAT_INC(statistic, pService)
 #endif
 
-/* Macro to get all Compression stats (from internal array of atomics) */
+/* Macro to get all Compression stats (sums the stats shards) */
 #define COMPRESSION_STATS_GET(compStats, pService)                             \
     do                                                                         \
     {                                                                          \
-        int i;                                                                 \
+        int i, j;                                                              \
         for (i = 0; i < COMPRESSION_NUM_STATS; i++)                            \
         {                                                                      \
-            ((Cpa64U *)compStats)[i] =                                         \
-                osalAtomicGet(&pService->pCompStatsArr[i]);                    \
+            ((Cpa64U *)compStats)[i] = 0;                                      \
+            for (j = 0; j < COMPRESSION_STATS_NUM_SHARDS; j++)                 \
+            {                                                                  \
+                ((Cpa64U *)compStats)[i] +=                                    \
+                    pService->pCompStatsShards[j].stats[i];                    \
+            }                                                                  \
         }                                                                      \
     } while (0)
 
@@ -84,13 +129,32 @@
 #define COMPRESSION_STATS_RESET(pService)                                      \
     do                                                                         \
     {                                                                          \
-        int i;                                                                 \
-        for (i = 0; i < COMPRESSION_NUM_STATS; i++)                            \
+        int i, j;                                                              \
+        for (j = 0; j < COMPRESSION_STATS_NUM_SHARDS; j++)                     \
         {                                                                      \
-            osalAtomicSet(0, &pService->pCompStatsArr[i]);                     \
+            for (i = 0; i < COMPRESSION_NUM_STATS; i++)                        \
+            {                                                                  \
+                pService->pCompStatsShards[j].stats[i] = 0;                    \
+            }                                                                  \
         }                                                                      \
     } while (0)
 
+#ifndef KERNEL_SPACE
+/**
+*******************************************************************************
+* @ingroup Dc_DataCompression
+*      Assigns a stats shard to the calling thread
+*
+* @description
+*      This function picks the stats shard used by the calling thread. Shards
+*      are handed out in a round-robin manner.
+*
+* @retval Shard index of the calling thread
+*
+*****************************************************************************/
+Cpa32U dcStatsAssignShard(void);
+#endif
+
 /**
 *******************************************************************************
 * @ingroup Dc_DataCompression
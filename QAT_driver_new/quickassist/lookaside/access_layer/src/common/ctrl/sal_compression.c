@@ -74,6 +74,8 @@
 #include "sal_types_compression.h"
 #include "dc_session.h"
 #include "dc_datapath.h"
+#include "dc_ns_datapath.h"
+#include "dc_inter_buff_pool.h"
 #include "dc_stats.h"
 #include "lac_sal.h"
 #include "lac_sal_ctrl.h"
@@ -646,7 +648,24 @@ STATIC CpaStatus SalCtr_DcInstInit(icp_accel_dev_t *device,
     pCompressionService->coreAffinity =
         (Cpa32U)Sal_Strtoul(adfGetParam, NULL, SAL_CFG_BASE_DEC);
 
-    return status;
+    /* Optional, instances check every request in full by default */
+    pCompressionService->trustedCaller = CPA_FALSE;
+    status =
+        Sal_StringParsing(SAL_CFG_DC,
+                          pCompressionService->generic_service_info.instance,
+                          SAL_CFG_TRUSTED_CALLER,
+                          temp_string);
+    LAC_CHECK_STATUS(status);
+    if (CPA_STATUS_SUCCESS ==
+        icp_adf_cfgGetParamValue(device, section, temp_string, adfGetParam))
+    {
+        pCompressionService->trustedCaller =
+            (0 != Sal_Strtoul(adfGetParam, NULL, SAL_CFG_BASE_DEC))
+                ? CPA_TRUE
+                : CPA_FALSE;
+    }
+
+    return CPA_STATUS_SUCCESS;
 }
 
 STATIC void SalCtrl_DcDebugCleanup(icp_accel_dev_t *device,
@@ -821,6 +840,7 @@ CpaStatus SalCtrl_CompressionInit(icp_accel_dev_t *device,
 
     pCompressionService->acceleratorNum = 0;
     pCompressionService->compression_mem_pool = LAC_MEM_POOL_INIT_POOL_ID;
+    pCompressionService->bp_batch_mem_pool = LAC_MEM_POOL_INIT_POOL_ID;
     pCompressionService->trans_handle_compression_tx = NULL;
     pCompressionService->trans_handle_compression_rx = NULL;
     pCompressionService->debug_file = NULL;
@@ -938,6 +958,29 @@ CpaStatus SalCtrl_CompressionInit(icp_accel_dev_t *device,
         goto cleanup;
     }
 
+    status = Sal_StringParsing(SAL_CFG_COMP,
+                               pCompressionService->generic_service_info.instance,
+                               SAL_CFG_BP_BATCH_POOL,
+                               compMemPool);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_LOG_ERROR("Failed to parse Comp_BpBatchPool string\n");
+        goto cleanup;
+    }
+
+    status = Lac_MemPoolCreate(&pCompressionService->bp_batch_mem_pool,
+                               compMemPool,
+                               DC_BP_NUM_BATCHES,
+                               sizeof(dc_bp_batch_t),
+                               LAC_64BYTE_ALIGNMENT,
+                               CPA_FALSE,
+                               pCompressionService->nodeAffinity);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_LOG_ERROR("Failed to create dc batch and pack memory pool\n");
+        goto cleanup;
+    }
+
     /* Init compression statistics */
     status = dcStatsInit(pCompressionService);
     if (CPA_STATUS_SUCCESS != status)
@@ -946,6 +989,8 @@ CpaStatus SalCtrl_CompressionInit(icp_accel_dev_t *device,
         goto cleanup;
     }
 
+    dcNsReqCacheInvalidate(pCompressionService);
+
     /* Initialize Data Compression Cookies */
     Lac_MemPoolInitDcCookies(pCompressionService->compression_mem_pool,
                              pCompressionService);
@@ -1012,6 +1057,11 @@ cleanup:
         Lac_MemPoolDestroy(pCompressionService->compression_mem_pool);
     }
 
+    if (LAC_MEM_POOL_INIT_POOL_ID != pCompressionService->bp_batch_mem_pool)
+    {
+        Lac_MemPoolDestroy(pCompressionService->bp_batch_mem_pool);
+    }
+
     SalCtrl_DcDebugShutdown(device, service);
 
     return status;
@@ -1082,6 +1132,7 @@ CpaStatus SalCtrl_CompressionShutdown(icp_accel_dev_t *device,
 
 
     Lac_MemPoolDestroy(pCompressionService->compression_mem_pool);
+    Lac_MemPoolDestroy(pCompressionService->bp_batch_mem_pool);
 
     status = icp_adf_transReleaseHandle(
         pCompressionService->trans_handle_compression_tx);
@@ -1292,6 +1343,8 @@ CpaStatus SalCtrl_CompressionRestarted(icp_accel_dev_t *device,
         device->dcExtendedFeatures;
     pCompressionService->generic_service_info.state = SAL_SERVICE_STATE_RUNNING;
 
+    dcNsReqCacheInvalidate(pCompressionService);
+
     /* Initialize Data Compression Cookies */
     Lac_MemPoolInitDcCookies(pCompressionService->compression_mem_pool,
                              pCompressionService);
@@ -1612,6 +1665,8 @@ CpaStatus cpaDcStartInstance(CpaInstanceHandle instanceHandle,
 
     pService->pInterBuffPtrsArray = pInterBuffPtrsArray;
     pService->pInterBuffPtrsArrayPhyAddr = pArrayBufferListDescPhyAddr;
+    /* NS request templates embed the intermediate buffers address */
+    dcNsReqCacheInvalidate(pService);
 
     /* Get the full size of the buffer list */
     /* Assumption: all the SGLs allocated by the user have the same size */
@@ -1741,13 +1796,18 @@ CpaStatus cpaDcStopInstance(CpaInstanceHandle instanceHandle)
     pService = (sal_compression_service_t *)insHandle;
 
     /* Free Intermediate Buffer Pointers Array */
-    if (pService->pInterBuffPtrsArray != NULL)
+    if (CPA_TRUE == pService->isInterBuffShared)
+    {
+        dcInterBuffPoolDetach(pService);
+    }
+    else if (pService->pInterBuffPtrsArray != NULL)
     {
         LAC_OS_CAFREE(pService->pInterBuffPtrsArray);
         pService->pInterBuffPtrsArray = 0;
     }
 
     pService->pInterBuffPtrsArrayPhyAddr = 0;
+    dcNsReqCacheInvalidate(pService);
 
     status = cpaDcInstanceGetInfo2(insHandle, &info);
     if (CPA_STATUS_SUCCESS != status)
@@ -1763,6 +1823,8 @@ CpaStatus cpaDcStopInstance(CpaInstanceHandle instanceHandle)
     }
 
     pService->generic_service_info.isInstanceStarted = CPA_FALSE;
+    LacBuffDesc_RegisteredBufferListsInvalidate(
+        &pService->generic_service_info);
 
     /* Decrement dev ref counter */
     icp_qa_dev_put(dev);
@@ -2277,6 +2339,7 @@ CpaStatus cpaDcSetAddressTranslation(const CpaInstanceHandle instanceHandle,
     pService = (sal_service_t *)insHandle;
 
     pService->virt2PhysClient = virtual2Physical;
+    LacBuffDesc_RegisteredBufferListsInvalidate(pService);
 
     return CPA_STATUS_SUCCESS;
 }
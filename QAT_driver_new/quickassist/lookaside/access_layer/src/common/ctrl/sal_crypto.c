@@ -98,6 +98,7 @@
 #include "lac_ec.h"
 #include "lac_sal_types_crypto.h"
 #include "lac_sal.h"
+#include "lac_buffer_desc.h"
 #include "lac_sal_ctrl.h"
 #include "sal_string_parse.h"
 #include "sal_service_state.h"
@@ -2706,6 +2707,8 @@ CpaStatus cpaCyStopInstance(CpaInstanceHandle instanceHandle_in)
 
 
     pService->generic_service_info.isInstanceStarted = CPA_FALSE;
+    LacBuffDesc_RegisteredBufferListsInvalidate(
+        &pService->generic_service_info);
 
     /* Decrement dev ref counter */
     icp_qa_dev_put(dev);
@@ -3359,6 +3362,7 @@ CpaStatus cpaCySetAddressTranslation(const CpaInstanceHandle instanceHandle_in,
     pService = (sal_service_t *)instanceHandle;
 
     pService->virt2PhysClient = virtual2physical;
+    LacBuffDesc_RegisteredBufferListsInvalidate(pService);
 
     return CPA_STATUS_SUCCESS;
 }
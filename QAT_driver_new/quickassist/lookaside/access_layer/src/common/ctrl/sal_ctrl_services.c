@@ -89,6 +89,7 @@
 #include "icp_sal_versions.h"
 #include "sal_misc_error_stats.h"
 #include "icp_qat_fw_comp.h"
+#include "dc_inter_buff_pool.h"
 
 
 #define SAL_USER_SPACE_START_TIMEOUT_MS 120000
@@ -1135,6 +1136,8 @@ STATIC CpaStatus SalCtrl_ServiceEventShutdown(icp_accel_dev_t *device,
         service_container->ver_file = NULL;
     }
 
+    dcInterBuffPoolDestroy(service_container);
+
     /* Free container also */
     osalMemFree(service_container);
     device->pSalHandle = NULL;
@@ -1222,6 +1225,15 @@ STATIC CpaStatus SalCtrl_ServiceEventInit(icp_accel_dev_t *device,
         return status;
     }
 
+    status = dcInterBuffPoolInit(service_container);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        icp_adf_debugRemoveFile(service_container->ver_file);
+        LAC_OS_FREE(service_container->ver_file);
+        osalMemFree(service_container);
+        return status;
+    }
+
 #ifndef ICP_DC_ONLY
     if (SalCtrl_IsServiceEnabled(enabled_services,
                                  SAL_SERVICE_TYPE_CRYPTO_ASYM))
@@ -121,6 +121,82 @@ STATIC void dcChainService_FreeResources(sal_dc_chain_service_t *pChainService)
         }                                                                      \
     } while (0)
 
+/*
+ * @ingroup Dc_Chaining
+ *     Links a crypto cookie and the two response descriptors to every
+ *     chaining cookie so the datapath does not allocate or translate them
+ *     per request. The linked entries are never returned to their pools,
+ *     they are released when the pools are destroyed.
+ *
+ * @param[in]  pCompService        Pointer to compression service instance
+ * @param[in]  pChainService       Pointer to chaining service instance
+ *
+ * @retval CPA_STATUS_SUCCESS      Every chaining cookie was prepared
+ * @retval CPA_STATUS_RESOURCE     A linked entry could not be allocated
+ */
+STATIC CpaStatus dcChainService_PrepareCookies(
+    sal_compression_service_t *pCompService,
+    sal_dc_chain_service_t *pChainService)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    dc_chain_cookie_t *pChainCookie = NULL;
+    dc_chain_cookie_t *pPrepared = NULL;
+    lac_sym_bulk_cookie_t *pCyCookie = NULL;
+    void *pDcRsp = NULL;
+    void *pCyRsp = NULL;
+
+    /* Drain the chaining cookie pool, keeping the cookies on a list
+     * threaded through callbackTag */
+    for (;;)
+    {
+        pChainCookie = (dc_chain_cookie_t *)Lac_MemPoolEntryAlloc(
+            pChainService->dc_chain_cookie_pool);
+        if ((NULL == pChainCookie) ||
+            ((void *)CPA_STATUS_RETRY == (void *)pChainCookie))
+        {
+            break;
+        }
+
+        LAC_OS_BZERO(pChainCookie, sizeof(dc_chain_cookie_t));
+        pChainCookie->callbackTag = pPrepared;
+        pPrepared = pChainCookie;
+
+        pCyCookie = (lac_sym_bulk_cookie_t *)Lac_MemPoolEntryAlloc(
+            pChainService->lac_sym_cookie_pool);
+        pDcRsp = Lac_MemPoolEntryAlloc(pChainService->dc_chain_serv_resp_pool);
+        pCyRsp = Lac_MemPoolEntryAlloc(pChainService->dc_chain_serv_resp_pool);
+        if ((NULL == pCyCookie) || ((void *)CPA_STATUS_RETRY == pCyCookie) ||
+            (NULL == pDcRsp) || ((void *)CPA_STATUS_RETRY == pDcRsp) ||
+            (NULL == pCyRsp) || ((void *)CPA_STATUS_RETRY == pCyRsp))
+        {
+            LAC_LOG_ERROR("Failed to link chaining cookie resources");
+            status = CPA_STATUS_RESOURCE;
+            break;
+        }
+
+        pChainCookie->pCyCookieAddr = pCyCookie;
+        pChainCookie->pDcRspAddr = pDcRsp;
+        pChainCookie->pCyRspAddr = pCyRsp;
+        pChainCookie->dcRspPhyAddr = LAC_OS_VIRT_TO_PHYS_INTERNAL(
+            &pCompService->generic_service_info, pDcRsp);
+        pChainCookie->cyRspPhyAddr = LAC_OS_VIRT_TO_PHYS_INTERNAL(
+            &pCompService->generic_service_info, pCyRsp);
+        pChainCookie->cyReqPhyAddr = LAC_OS_VIRT_TO_PHYS_INTERNAL(
+            &pCompService->generic_service_info, &pCyCookie->qatMsg);
+    }
+
+    /* Return the prepared cookies, on failure the pools are destroyed */
+    while (NULL != pPrepared)
+    {
+        pChainCookie = pPrepared;
+        pPrepared = (dc_chain_cookie_t *)pChainCookie->callbackTag;
+        pChainCookie->callbackTag = NULL;
+        Lac_MemPoolEntryFree(pChainCookie);
+    }
+
+    return status;
+}
+
 /**
  *****************************************************************************
  * @ingroup Dc_Chaining
@@ -167,7 +243,7 @@ CpaStatus dcChainServiceInit(sal_compression_service_t *pCompService,
                                numCompConcurrentReq,
                                sizeof(lac_sym_bulk_cookie_t),
                                LAC_64BYTE_ALIGNMENT,
-                               CPA_FALSE,
+                               CPA_TRUE,
                                pCompService->nodeAffinity);
     LAC_CHECK_STATUS_DC_CHAIN_INIT(status);
 
@@ -202,10 +278,14 @@ CpaStatus dcChainServiceInit(sal_compression_service_t *pCompService,
                                numCompConcurrentReq * DC_CHAIN_MAX_LINK,
                                rspSize,
                                LAC_64BYTE_ALIGNMENT,
-                               CPA_FALSE,
+                               CPA_TRUE,
                                pCompService->nodeAffinity);
     LAC_CHECK_STATUS_DC_CHAIN_INIT(status);
 
+    status = dcChainService_PrepareCookies(pCompService, pChainService);
+    LAC_CHECK_STATUS_DC_CHAIN_INIT(status);
+    LAC_OS_BZERO(&pChainService->stats, sizeof(dc_chain_stats_t));
+
     pCompService->pDcChainService = pChainService;
     status = LacSymQat_HashLookupInit(pCompService);
     LAC_CHECK_STATUS_DC_CHAIN_INIT(status);
@@ -283,4 +283,20 @@ void LacBuffDesc_BufferListZeroFromOffset(CpaBufferList *pBuffList,
                                           Cpa32U offset,
                                           Cpa32U lenToZero);
 
+/**
+*******************************************************************************
+* @ingroup LacBufferDesc
+*      Drop the buffer list registrations of an instance.
+*
+* @description
+*      The buffer lists registered with the instance are written from
+*      scratch on their next use, as for unregistered lists, and registered
+*      again for the instance. To be called whenever the physical addresses
+*      cached in the descriptors may no longer be valid.
+*
+* @param[in] pService            Pointer to generic service
+*
+*****************************************************************************/
+void LacBuffDesc_RegisteredBufferListsInvalidate(sal_service_t *pService);
+
 #endif /* LAC_BUFFER_DESC_H */
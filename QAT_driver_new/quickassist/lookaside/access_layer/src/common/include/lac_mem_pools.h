@@ -147,6 +147,46 @@ typedef struct lac_memblk_bucket_s
 /**< @ingroup LacMemPool
  * 16 bytes including '\\0' terminator to prevent padding in the structure */
 
+#define LAC_MEM_POOL_NUM_MAGAZINES 16
+/**< @ingroup LacMemPool
+ * Number of magazines kept in front of the shared stack of a pool. Threads
+ * are spread over the magazines in a round-robin manner. */
+
+#define LAC_MEM_POOL_MAGAZINE_SIZE 14
+/**< @ingroup LacMemPool
+ * Number of blocks a single magazine can hold. Chosen so that a magazine
+ * fills exactly two cache lines on 64-bit builds. */
+
+#define LAC_MEM_POOL_MAGAZINE_BATCH (LAC_MEM_POOL_MAGAZINE_SIZE / 2)
+/**< @ingroup LacMemPool
+ * Number of blocks moved between a magazine and the shared stack at once */
+
+#define LAC_MEM_POOL_MAGAZINE_MIN_POOL                                         \
+    (LAC_MEM_POOL_NUM_MAGAZINES * LAC_MEM_POOL_MAGAZINE_SIZE)
+/**< @ingroup LacMemPool
+ * Pools with fewer elements than this do not get magazines, as too large a
+ * share of the pool could be held in the per-thread caches. */
+
+#define LAC_MEM_POOL_MAGAZINE_ALIGNMENT 64
+/**< @ingroup LacMemPool
+ * Magazines are cache line aligned to avoid false sharing */
+
+/**< @ingroup LacMemPool
+ *     This structure is a small per-thread cache of free blocks placed in
+ * front of the shared lock-free stack of a pool. Blocks are moved between
+ * the magazine and the stack in batches.
+ */
+typedef struct lac_mem_pool_magazine_s
+{
+    volatile Cpa32U lock;
+    /**< owner lock, only ever taken with a try-lock on the fast path */
+    volatile Cpa32U numBlks;
+    /**< number of blocks currently held in the magazine */
+    lac_mem_blk_t *blks[LAC_MEM_POOL_MAGAZINE_SIZE];
+    /**< cached free blocks */
+} __attribute__((aligned(LAC_MEM_POOL_MAGAZINE_ALIGNMENT)))
+lac_mem_pool_magazine_t;
+
 /**< @ingroup LacMemPool
  *     This structure is used to manage each pool created using this utility
  * feature. The client will maintain a pointer (identifier) to the created
@@ -166,7 +206,11 @@ typedef struct lac_mem_pool_hdr_s
     lac_mem_blk_t **trackBlks;
     /* An array of mem block pointers to track the allocated entries in pool */
     volatile size_t availBlks;
-    /* Number of blocks available for allocation in this pool */
+    /* Number of blocks available for allocation in the shared stack. Blocks
+     * held in magazines are not included, use Lac_MemPoolAvailableEntries
+     * to get the number of blocks available in the whole pool */
+    lac_mem_pool_magazine_t *pMagazines;
+    /* Array of LAC_MEM_POOL_NUM_MAGAZINES magazines or NULL */
     CpaBoolean active;
     /* Indicate the pool is available for allocation */
     OsalAtomic sync;
@@ -323,7 +367,8 @@ void Lac_MemPoolEntryFree(void *entry);
 /**
  *******************************************************************************
  * @ingroup LacMemPool
- * This function returns the number of available entries in a particular pool
+ * This function returns the number of available entries in a particular pool,
+ * including the entries cached in the per-thread magazines of the pool.
  *
  * @blocking
  *      No
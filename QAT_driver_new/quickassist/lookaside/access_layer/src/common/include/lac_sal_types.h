@@ -213,6 +213,9 @@ typedef struct sal_service_s
     /* Cnv Error Injection simulation is enabled */
     enum adf_ring_mode ring_mode;
     /* current instance's user queue mode */
+
+    Cpa32U bufferListRegGen;
+    /* Generation of the buffer list registrations of the instance */
 } sal_service_t;
 /* clang-format on */
 
@@ -245,6 +248,10 @@ typedef struct sal_s
     /**< Container for compression proc debug */
     debug_file_info_t *ver_file;
     /**< Container for version debug file */
+    struct dc_inter_buff_pool_s *pDcInterBuffPool;
+    /**< Intermediate buffers shared by the compression instances */
+    lac_lock_t dcInterBuffPoolLock;
+    /**< Lock protecting pDcInterBuffPool */
 } sal_t;
 
 /**
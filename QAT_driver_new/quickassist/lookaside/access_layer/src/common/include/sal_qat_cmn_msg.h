@@ -279,6 +279,36 @@ CpaStatus SalQatMsg_transPutMsg(icp_comms_trans_handle trans_handle,
                                 Cpa8U service,
                                 Cpa64U *seq_num);
 
+/********************************************************************
+ * @ingroup SalQatMsg_transPutMsgs
+ *
+ * @description
+ *      Puts a batch of messages on the ring with a single doorbell where
+ *      the transport supports it. The messages are put in order and the
+ *      number actually put is returned in pNumPut; on transports that
+ *      cannot reserve the whole batch up front this may be fewer than
+ *      numMsgs.
+ *
+ * @param[in]   trans_handle
+ * @param[in]   ppqat_msgs       array of pointers to the messages
+ * @param[in]   size_in_lws
+ * @param[in]   numMsgs
+ * @param[in]   service
+ * @param[out]  seq_nums         array of numMsgs sequence numbers
+ * @param[out]  pNumPut          number of messages put on the ring
+ *
+ * @return
+ *      CpaStatus
+ *
+ *****************************************/
+CpaStatus SalQatMsg_transPutMsgs(icp_comms_trans_handle trans_handle,
+                                 void **ppqat_msgs,
+                                 Cpa32U size_in_lws,
+                                 Cpa32U numMsgs,
+                                 Cpa8U service,
+                                 Cpa64U *seq_nums,
+                                 Cpa32U *pNumPut);
+
 /********************************************************************
  * @ingroup SalQatMsg_updateQueueTail
  *
@@ -85,6 +85,9 @@
 #define SAL_CFG_SYM_POOL "SymPool"
 #define SAL_CFG_CHAIN_COOKIE_POOL "ChainCookiePool"
 #define SAL_CFG_CHAIN_DESC_POOL "ChainDescPool"
+#define SAL_CFG_BP_BATCH_POOL "BpBatchPool"
+#define SAL_CFG_DC_INTER_BUFF_SIZE "DcInterBuffSize"
+#define SAL_CFG_TRUSTED_CALLER "TrustedCaller"
 
 /**
 *******************************************************************************
@@ -51,6 +51,7 @@
 #include "cpa_dc_dp.h"
 #include "lac_sal_types.h"
 #include "icp_qat_hw.h"
+#include "icp_qat_fw_comp.h"
 #include "icp_buffer_desc.h"
 
 #include "lac_mem_pools.h"
@@ -96,6 +97,27 @@ typedef struct dc_extended_features_s
  *      Contains information required per chaining service instance.
  *
  *****************************************************************************/
+/* Per-stage counters of the chaining service */
+typedef struct dc_chain_stats_s
+{
+    Cpa64U numRequests;
+    /**< Requests put on the ring */
+    Cpa64U numSubmits;
+    /**< Ring tail updates used to put the requests */
+    Cpa64U numRetries;
+    /**< Submissions rejected because the ring was full */
+    Cpa64U numCompleted;
+    /**< Responses processed */
+    Cpa64U buildCycles;
+    /**< Cycles spent building request descriptors */
+    Cpa64U submitCycles;
+    /**< Cycles spent putting requests on the ring */
+    Cpa64U deviceCycles;
+    /**< Cycles between ring submission and response processing */
+    Cpa64U completeCycles;
+    /**< Cycles spent processing responses, client callback included */
+} dc_chain_stats_t;
+
 /* Parameters to provide chaining service */
 typedef struct sal_dc_chain_service_s
 {
@@ -120,6 +142,9 @@ typedef struct sal_dc_chain_service_s
     lac_memory_pool_id_t dc_chain_serv_resp_pool;
     /**< Memory pool ID used for linked crypto and compression request
      * descriptor */
+    dc_chain_stats_t stats;
+    /**< Per-stage counters, updated when compression statistics are
+     * enabled */
 } sal_dc_chain_service_t;
 
 /**
@@ -173,6 +198,57 @@ typedef struct sal_compression_device_data
     CpaBoolean enableStatefulDeflateDecomp;
 } sal_compression_device_data_t;
 
+/* Number of base requests kept by the No-Session API of an instance */
+#define DC_NS_REQ_CACHE_SIZE 8
+
+/**
+ *****************************************************************************
+ * @ingroup SalCtrl
+ *      Request template of the No-Session API
+ *
+ * @description
+ *      Base request built by dcNsCreateBaseRequest for one setup data. The
+ *      sequence number is odd while the template is being rewritten, readers
+ *      retry the build when it changed under them.
+ *
+ *****************************************************************************/
+typedef struct dc_ns_req_template_s
+{
+    volatile Cpa32U seq;
+    /* Sequence number, odd while the template is being updated */
+    Cpa32U hash;
+    /* Hash of the setup data, checked before comparing it */
+    volatile Cpa64U lastUsed;
+    /* Cache clock value of the last lookup that used the template */
+    CpaBoolean valid;
+    /* Indicates the template holds a request */
+    CpaDcNsSetupData setupData;
+    /* Setup data the template was built from */
+    icp_qat_fw_comp_req_t request;
+    /* Base request for the setup data */
+} dc_ns_req_template_t;
+
+/**
+ *****************************************************************************
+ * @ingroup SalCtrl
+ *      Request cache of the No-Session API
+ *
+ * @description
+ *      Least recently used set of request templates. The clock only moves
+ *      when a template is built, so lookups that hit do not write to the
+ *      cache once the template is stamped with the current clock.
+ *
+ *****************************************************************************/
+typedef struct dc_ns_req_cache_s
+{
+    volatile Cpa32U lock;
+    /* Serialises writers of the templates */
+    volatile Cpa64U clock;
+    /* Incremented every time a template is built */
+    dc_ns_req_template_t templates[DC_NS_REQ_CACHE_SIZE];
+    /* Request templates */
+} dc_ns_req_cache_t;
+
 /**
  *****************************************************************************
  * @ingroup SalCtrl
@@ -190,8 +266,14 @@ typedef struct sal_compression_service_s
     /* Memory pool ID used for compression */
     lac_memory_pool_id_t compression_mem_pool;
 
-    /* Pointer to an array of atomic stats for compression */
-    OsalAtomic *pCompStatsArr;
+    /* Memory pool ID used for Batch and Pack contexts */
+    lac_memory_pool_id_t bp_batch_mem_pool;
+
+    /* Pointer to an array of per-thread stats shards for compression */
+    struct dc_stats_shard_s *pCompStatsShards;
+
+    /* Base request cache of the No-Session API */
+    dc_ns_req_cache_t nsReqCache;
 
     /* Size of the DRAM intermediate buffer in bytes */
     Cpa64U minInterBuffSizeInBytes;
@@ -203,6 +285,15 @@ typedef struct sal_compression_service_s
     icp_qat_addr_width_t *pInterBuffPtrsArray;
     CpaPhysicalAddr pInterBuffPtrsArrayPhyAddr;
 
+    /* Set when the intermediate buffers belong to the shared pool of the
+     * device rather than to the application */
+    CpaBoolean isInterBuffShared;
+
+    /* Set from the TrustedCaller key of the instance. Requests are then
+     * only checked for the fields that can change from one request to the
+     * next, the session being checked once at init */
+    CpaBoolean trustedCaller;
+
     icp_comms_trans_handle trans_handle_compression_tx;
     icp_comms_trans_handle trans_handle_compression_rx;
 
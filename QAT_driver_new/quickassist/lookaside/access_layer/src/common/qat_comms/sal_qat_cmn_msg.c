@@ -316,6 +316,55 @@ CpaStatus SalQatMsg_transPutMsg(icp_comms_trans_handle trans_handle,
     return icp_adf_transPutMsg(trans_handle, pqat_msg, size_in_lws, seq_num);
 }
 
+/********************************************************************
+ * @ingroup SalQatMsg_transPutMsgs
+ *
+ * @description
+ *      The user space transport puts the batch behind one tail write,
+ *      or as few descriptors on a shared queue. The kernel transport has
+ *      no batch put, so the messages are put one at a time and the batch
+ *      stops at the first retry.
+ *
+ *****************************************/
+CpaStatus SalQatMsg_transPutMsgs(icp_comms_trans_handle trans_handle,
+                                 void **ppqat_msgs,
+                                 Cpa32U size_in_lws,
+                                 Cpa32U numMsgs,
+                                 Cpa8U service,
+                                 Cpa64U *seq_nums,
+                                 Cpa32U *pNumPut)
+{
+#ifdef KERNEL_SPACE
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    for (i = 0; i < numMsgs; i++)
+    {
+        status = icp_adf_transPutMsg(
+            trans_handle, ppqat_msgs[i], size_in_lws, &seq_nums[i]);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+    }
+    *pNumPut = i;
+    return (i > 0) ? CPA_STATUS_SUCCESS : status;
+#else
+    CpaStatus status = icp_adf_transPutMsgs(trans_handle,
+                                            (Cpa32U **)ppqat_msgs,
+                                            size_in_lws,
+                                            numMsgs,
+                                            seq_nums,
+                                            pNumPut);
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        *pNumPut = 0;
+    }
+    return status;
+#endif
+}
+
 CpaStatus SalQatMsg_updateQueueTail(icp_comms_trans_handle trans_handle)
 {
     return icp_adf_updateQueueTail(trans_handle);
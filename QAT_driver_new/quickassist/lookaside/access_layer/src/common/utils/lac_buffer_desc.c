@@ -58,6 +58,7 @@
 #include "cpa_cy_common.h"
 #include "dc_session.h"
 #include "sal_misc_error_stats.h"
+#include "icp_sal_buffer_reg.h"
 
 
 /*
@@ -76,6 +77,138 @@ typedef enum lac_buff_write_op_e
     WRITE_AND_ALLOW_ZERO_BUFFER,
 } lac_buff_write_op_t;
 
+/* Marks the metadata of a registered buffer list. The list address is mixed
+ * in so metadata copied to or reused by another list is not taken for
+ * registered */
+#define LAC_BUFF_REG_MAGIC (0x5245474255464c53ULL)
+#define LAC_BUFF_REG_TAG(pList)                                                \
+    (LAC_BUFF_REG_MAGIC ^ (Cpa64U)(LAC_ARCH_UINT)(pList))
+
+/* Registration record of a buffer list. It lives in the metadata after the
+ * flat buffer descriptors, whose number the registration stores in the
+ * reserved field of the buffer list descriptor. The descriptor of a
+ * registered list is always at the start of the metadata. */
+typedef struct lac_buff_reg_s
+{
+    sal_service_t *pService;
+    /**< Instance the descriptor was translated for, NULL if stale */
+    Cpa32U generation;
+    /**< Registration generation of the instance when last written */
+    Cpa32U reserved;
+    CpaFlatBuffer *pBuffers;
+    /**< Flat buffer array of the list when registered */
+    void *pMetaData;
+    /**< Metadata of the list when registered */
+    icp_qat_addr_width_t descPhyAddr;
+    /**< Physical address of the buffer list descriptor */
+    Cpa8U *pData[];
+    /**< Address each flat buffer descriptor was translated from */
+} lac_buff_reg_t;
+
+#define LAC_BUFF_REG_GET(pDesc)                                                \
+    ((lac_buff_reg_t *)&(pDesc)->phyBuffers[(pDesc)->reserved])
+
+/* Writes the descriptor of a registered buffer list whose registration is
+ * current. Only the lengths are patched; a buffer is translated again only
+ * if its address changed since the descriptor was written. */
+STATIC CpaStatus
+LacBuffDesc_RegisteredBufferListDescWrite(const CpaBufferList *pUserBufferList,
+                                          Cpa64U *pBufListAlignedPhyAddr,
+                                          Cpa64U *totalDataLenInBytes,
+                                          sal_service_t *pService,
+                                          lac_buff_write_op_t operationType)
+{
+    icp_buffer_list_desc_t *pBufferListDesc =
+        (icp_buffer_list_desc_t *)pUserBufferList->pPrivateMetaData;
+    lac_buff_reg_t *pReg = LAC_BUFF_REG_GET(pBufferListDesc);
+    CpaFlatBuffer *pCurrClientFlatBuffer = pUserBufferList->pBuffers;
+    icp_flat_buffer_desc_t *pCurrFlatBufDesc = pBufferListDesc->phyBuffers;
+    Cpa32U i = 0;
+
+    pBufferListDesc->numBuffers = pUserBufferList->numBuffers;
+
+    for (i = 0; i < pUserBufferList->numBuffers; i++)
+    {
+        pCurrFlatBufDesc->dataLenInBytes =
+            pCurrClientFlatBuffer->dataLenInBytes;
+
+        if (WRITE_AND_GET_SIZE == operationType)
+        {
+            *totalDataLenInBytes += pCurrClientFlatBuffer->dataLenInBytes;
+        }
+
+        if ((pReg->pData[i] != pCurrClientFlatBuffer->pData) ||
+            ((INVALID_PHYSICAL_ADDRESS == pCurrFlatBufDesc->phyBuffer) &&
+             (WRITE_AND_ALLOW_ZERO_BUFFER != operationType)))
+        {
+            pCurrFlatBufDesc->phyBuffer =
+                LAC_MEM_CAST_PTR_TO_UINT64(LAC_OS_VIRT_TO_PHYS_EXTERNAL(
+                    (*pService), pCurrClientFlatBuffer->pData));
+
+            if ((INVALID_PHYSICAL_ADDRESS == pCurrFlatBufDesc->phyBuffer) &&
+                (WRITE_AND_ALLOW_ZERO_BUFFER != operationType))
+            {
+                LAC_LOG_ERROR("Unable to get the physical address of the "
+                              "client buffer\n");
+                return CPA_STATUS_FAIL;
+            }
+            pReg->pData[i] = pCurrClientFlatBuffer->pData;
+        }
+
+        pCurrFlatBufDesc++;
+        pCurrClientFlatBuffer++;
+    }
+
+    *pBufListAlignedPhyAddr = pReg->descPhyAddr;
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Brings the registration record of a buffer list up to date after its
+ * descriptor was written from scratch */
+STATIC void LacBuffDesc_RegisteredBufferListUpdate(
+    const CpaBufferList *pUserBufferList,
+    icp_qat_addr_width_t bufListDescPhyAddr,
+    icp_qat_addr_width_t bufListAlignedPhyAddr,
+    CpaBoolean isPhysicalAddress,
+    sal_service_t *pService)
+{
+    icp_buffer_list_desc_t *pBufferListDesc =
+        (icp_buffer_list_desc_t *)pUserBufferList->pPrivateMetaData;
+    lac_buff_reg_t *pReg = NULL;
+    Cpa32U i = 0;
+
+    /* A descriptor that moved away from the start of the metadata or
+     * outgrew the registration has overwritten the record */
+    if ((bufListAlignedPhyAddr != bufListDescPhyAddr) ||
+        (pUserBufferList->numBuffers > pBufferListDesc->reserved))
+    {
+        pBufferListDesc->resrvd = 0;
+        return;
+    }
+
+    pReg = LAC_BUFF_REG_GET(pBufferListDesc);
+    pReg->pService = (CPA_TRUE == isPhysicalAddress) ? NULL : pService;
+    pReg->generation = pService->bufferListRegGen;
+    pReg->pBuffers = pUserBufferList->pBuffers;
+    pReg->pMetaData = pUserBufferList->pPrivateMetaData;
+    pReg->descPhyAddr = bufListAlignedPhyAddr;
+
+    for (i = 0; i < pBufferListDesc->reserved; i++)
+    {
+        if (i < pUserBufferList->numBuffers)
+        {
+            pReg->pData[i] = pUserBufferList->pBuffers[i].pData;
+        }
+        else
+        {
+            /* Written for another instance or generation */
+            pReg->pData[i] = NULL;
+            pBufferListDesc->phyBuffers[i].phyBuffer =
+                INVALID_PHYSICAL_ADDRESS;
+        }
+    }
+}
+
 /* This function implements the buffer description writes for the traditional
  * APIs */
 STATIC CpaStatus
@@ -92,6 +225,8 @@ LacBuffDesc_CommonBufferListDescWrite(const CpaBufferList *pUserBufferList,
     CpaFlatBuffer *pCurrClientFlatBuffer = NULL;
     icp_buffer_list_desc_t *pBufferListDesc = NULL;
     icp_flat_buffer_desc_t *pCurrFlatBufDesc = NULL;
+    lac_buff_reg_t *pReg = NULL;
+    CpaBoolean isRegistered = CPA_FALSE;
 
     LAC_ENSURE_NOT_NULL(pUserBufferList);
     LAC_ENSURE_NOT_NULL(pUserBufferList->pBuffers);
@@ -104,6 +239,29 @@ LacBuffDesc_CommonBufferListDescWrite(const CpaBufferList *pUserBufferList,
         *totalDataLenInBytes = 0;
     }
 
+    pBufferListDesc =
+        (icp_buffer_list_desc_t *)pUserBufferList->pPrivateMetaData;
+    if (LAC_BUFF_REG_TAG(pUserBufferList) == pBufferListDesc->resrvd)
+    {
+        isRegistered = CPA_TRUE;
+        pReg = LAC_BUFF_REG_GET(pBufferListDesc);
+
+        if ((CPA_FALSE == isPhysicalAddress) && (pService == pReg->pService) &&
+            (pService->bufferListRegGen == pReg->generation) &&
+            (pUserBufferList->pBuffers == pReg->pBuffers) &&
+            (pUserBufferList->pPrivateMetaData == pReg->pMetaData) &&
+            (0 != pUserBufferList->numBuffers) &&
+            (pUserBufferList->numBuffers <= pBufferListDesc->reserved))
+        {
+            return LacBuffDesc_RegisteredBufferListDescWrite(
+                pUserBufferList,
+                pBufListAlignedPhyAddr,
+                totalDataLenInBytes,
+                pService,
+                operationType);
+        }
+    }
+
     numBuffers = pUserBufferList->numBuffers;
     pCurrClientFlatBuffer = pUserBufferList->pBuffers;
 
@@ -190,6 +348,15 @@ LacBuffDesc_CommonBufferListDescWrite(const CpaBufferList *pUserBufferList,
         numBuffers--;
     }
 
+    if (CPA_TRUE == isRegistered)
+    {
+        LacBuffDesc_RegisteredBufferListUpdate(pUserBufferList,
+                                               bufListDescPhyAddr,
+                                               bufListAlignedPhyAddr,
+                                               isPhysicalAddress,
+                                               pService);
+    }
+
     *pBufListAlignedPhyAddr = bufListAlignedPhyAddr;
     return CPA_STATUS_SUCCESS;
 }
@@ -476,3 +643,121 @@ void LacBuffDesc_BufferListZeroFromOffset(CpaBufferList *pBuffList,
 
     } /* end while */
 }
+
+void LacBuffDesc_RegisteredBufferListsInvalidate(sal_service_t *pService)
+{
+    pService->bufferListRegGen++;
+}
+
+CpaStatus icp_sal_BufferListRegMetaSize(const CpaInstanceHandle instanceHandle,
+                                        Cpa32U numBuffers,
+                                        Cpa32U *pSizeInBytes)
+{
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    LAC_CHECK_NULL_PARAM(pSizeInBytes);
+    SAL_CHECK_INSTANCE_TYPE(instanceHandle,
+                            (SAL_SERVICE_TYPE_CRYPTO |
+                             SAL_SERVICE_TYPE_CRYPTO_ASYM |
+                             SAL_SERVICE_TYPE_CRYPTO_SYM |
+                             SAL_SERVICE_TYPE_COMPRESSION));
+
+    if (0 == numBuffers)
+    {
+        LAC_INVALID_PARAM_LOG("Number of Buffers");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+
+    /* The alignment bytes leave room for the list to be written
+     * unregistered should its registration be dropped */
+    *pSizeInBytes = sizeof(icp_buffer_list_desc_t) +
+                    (numBuffers * (sizeof(icp_flat_buffer_desc_t) +
+                                   sizeof(Cpa8U *))) +
+                    sizeof(lac_buff_reg_t) + ICP_DESCRIPTOR_ALIGNMENT_BYTES;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_BufferListRegister(const CpaInstanceHandle instanceHandle,
+                                     CpaBufferList *pBufferList)
+{
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+    icp_buffer_list_desc_t *pBufferListDesc = NULL;
+    icp_qat_addr_width_t bufListDescPhyAddr = 0;
+    Cpa64U bufListAlignedPhyAddr = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+#ifdef ICP_PARAM_CHECK
+    Cpa64U pktSize = 0;
+
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(instanceHandle,
+                            (SAL_SERVICE_TYPE_CRYPTO |
+                             SAL_SERVICE_TYPE_CRYPTO_ASYM |
+                             SAL_SERVICE_TYPE_CRYPTO_SYM |
+                             SAL_SERVICE_TYPE_COMPRESSION));
+
+    status = LacBuffDesc_BufferListVerifyNull(
+        pBufferList, &pktSize, LAC_NO_ALIGNMENT_SHIFT);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+#endif
+
+    bufListDescPhyAddr = (icp_qat_addr_width_t)LAC_OS_VIRT_TO_PHYS_EXTERNAL(
+        (*pService), pBufferList->pPrivateMetaData);
+    if (INVALID_PHYSICAL_ADDRESS == bufListDescPhyAddr)
+    {
+        LAC_LOG_ERROR("Unable to get the physical address of the metadata\n");
+        return CPA_STATUS_FAIL;
+    }
+
+    /* The descriptor of a registered list must start the metadata for the
+     * registration to be found without any address translation */
+    if (LAC_ALIGN_POW2_ROUNDUP(bufListDescPhyAddr,
+                               ICP_DESCRIPTOR_ALIGNMENT_BYTES) !=
+        bufListDescPhyAddr)
+    {
+        LAC_INVALID_PARAM_LOG("Metadata not aligned on "
+                              "ICP_DESCRIPTOR_ALIGNMENT_BYTES");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    pBufferListDesc = (icp_buffer_list_desc_t *)pBufferList->pPrivateMetaData;
+    pBufferListDesc->resrvd = 0;
+
+    /* Buffers without a physical address are translated again on use */
+    status = LacBuffDesc_BufferListDescWriteAndAllowZeroBuffer(
+        pBufferList, &bufListAlignedPhyAddr, CPA_FALSE, pService);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    pBufferListDesc->reserved = pBufferList->numBuffers;
+    LacBuffDesc_RegisteredBufferListUpdate(pBufferList,
+                                           bufListDescPhyAddr,
+                                           bufListAlignedPhyAddr,
+                                           CPA_FALSE,
+                                           pService);
+    pBufferListDesc->resrvd = LAC_BUFF_REG_TAG(pBufferList);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_BufferListUnregister(CpaBufferList *pBufferList)
+{
+    icp_buffer_list_desc_t *pBufferListDesc = NULL;
+
+    LAC_CHECK_NULL_PARAM(pBufferList);
+    LAC_CHECK_NULL_PARAM(pBufferList->pPrivateMetaData);
+
+    pBufferListDesc = (icp_buffer_list_desc_t *)pBufferList->pPrivateMetaData;
+    if (LAC_BUFF_REG_TAG(pBufferList) == pBufferListDesc->resrvd)
+    {
+        pBufferListDesc->resrvd = 0;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
@@ -86,6 +86,65 @@ static inline void push(lock_free_stack_t *stack, lac_mem_blk_t *val)
         &stack->top.atomic, old_top.atomic, new_top.atomic));
 }
 
+/* Pops up to max blocks with a single compare and swap. A chain walked from
+ * a stale top is harmless: blocks are never released while the pool exists
+ * and the counter makes the final compare and swap fail. */
+static inline unsigned int pop_batch(lock_free_stack_t *stack,
+                                     lac_mem_blk_t **blks,
+                                     unsigned int max)
+{
+    pointer_t old_top;
+    pointer_t new_top;
+    lac_mem_blk_t *next;
+    unsigned int num;
+
+    do
+    {
+        old_top.atomic = stack->top.atomic;
+        next = old_top.ptr;
+        for (num = 0; num < max && NULL != next; num++)
+        {
+            blks[num] = next;
+            next = next->pNext;
+        }
+        if (0 == num)
+            return 0;
+
+        new_top.ptr = next;
+        new_top.ctr = old_top.ctr + 1;
+    } while (!__sync_bool_compare_and_swap(
+        &stack->top.atomic, old_top.atomic, new_top.atomic));
+
+    return num;
+}
+
+/* Pushes num blocks with a single compare and swap */
+static inline void push_batch(lock_free_stack_t *stack,
+                              lac_mem_blk_t **blks,
+                              unsigned int num)
+{
+    pointer_t new_top;
+    pointer_t old_top;
+    unsigned int i;
+
+    if (0 == num)
+        return;
+
+    for (i = 0; i + 1 < num; i++)
+    {
+        blks[i]->pNext = blks[i + 1];
+    }
+
+    do
+    {
+        old_top.atomic = stack->top.atomic;
+        blks[num - 1]->pNext = old_top.ptr;
+        new_top.ptr = blks[0];
+        new_top.ctr = old_top.ctr + 1;
+    } while (!__sync_bool_compare_and_swap(
+        &stack->top.atomic, old_top.atomic, new_top.atomic));
+}
+
 static inline lock_free_stack_t init_stack(void)
 {
     lock_free_stack_t stack = {.top.atomic = 0};
@@ -98,6 +98,211 @@ static inline Cpa32U Lac_MemPoolGetElementRealSize(Cpa32U blkSizeInBytes,
     return blkSizeInBytes + addSize;
 }
 
+static inline CpaBoolean Lac_MemPoolMagazineTryLock(
+    lac_mem_pool_magazine_t *pMagazine)
+{
+    return (0 == __sync_lock_test_and_set(&pMagazine->lock, 1)) ? CPA_TRUE
+                                                                : CPA_FALSE;
+}
+
+static inline void Lac_MemPoolMagazineLock(lac_mem_pool_magazine_t *pMagazine)
+{
+    while (CPA_TRUE != Lac_MemPoolMagazineTryLock(pMagazine))
+    {
+        while (pMagazine->lock)
+            ;
+    }
+}
+
+static inline void Lac_MemPoolMagazineUnlock(
+    lac_mem_pool_magazine_t *pMagazine)
+{
+    __sync_lock_release(&pMagazine->lock);
+}
+
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function moves all blocks held in the magazines of a pool back to the
+ * shared stack.
+ ******************************************************************************/
+static void Lac_MemPoolMagazinesFlush(lac_mem_pool_hdr_t *pPoolID)
+{
+    lac_mem_pool_magazine_t *pMagazine = NULL;
+    Cpa32U numBlks = 0;
+    Cpa32U i = 0;
+
+    if (NULL == pPoolID->pMagazines)
+    {
+        return;
+    }
+
+    for (i = 0; i < LAC_MEM_POOL_NUM_MAGAZINES; i++)
+    {
+        pMagazine = &pPoolID->pMagazines[i];
+        Lac_MemPoolMagazineLock(pMagazine);
+        numBlks = pMagazine->numBlks;
+        push_batch(&pPoolID->stack, pMagazine->blks, numBlks);
+        __sync_add_and_fetch(&pPoolID->availBlks, numBlks);
+        pMagazine->numBlks = 0;
+        Lac_MemPoolMagazineUnlock(pMagazine);
+    }
+}
+
+#ifndef KERNEL_SPACE
+static Cpa32U lac_mem_pool_next_magazine = 0;
+/**< @ingroup LacMemPool
+ * Used to spread threads over the magazines of a pool */
+
+static __thread Cpa32U lac_mem_pool_thread_magazine =
+    LAC_MEM_POOL_NUM_MAGAZINES;
+/**< @ingroup LacMemPool
+ * Magazine index of the calling thread, assigned on first use */
+
+static inline lac_mem_pool_magazine_t *Lac_MemPoolThreadMagazine(
+    lac_mem_pool_hdr_t *pPoolID)
+{
+    if (unlikely(lac_mem_pool_thread_magazine >= LAC_MEM_POOL_NUM_MAGAZINES))
+    {
+        lac_mem_pool_thread_magazine =
+            __sync_fetch_and_add(&lac_mem_pool_next_magazine, 1) %
+            LAC_MEM_POOL_NUM_MAGAZINES;
+    }
+    return &pPoolID->pMagazines[lac_mem_pool_thread_magazine];
+}
+
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function takes one block from any magazine of the pool. It is only
+ * used once both the magazine of the calling thread and the shared stack
+ * are found empty, so that blocks cached by other threads are not reported
+ * as unavailable.
+ ******************************************************************************/
+static lac_mem_blk_t *Lac_MemPoolMagazineSteal(lac_mem_pool_hdr_t *pPoolID)
+{
+    lac_mem_pool_magazine_t *pMagazine = NULL;
+    lac_mem_blk_t *pMemBlk = NULL;
+    Cpa32U i = 0;
+
+    for (i = 0; i < LAC_MEM_POOL_NUM_MAGAZINES && NULL == pMemBlk; i++)
+    {
+        pMagazine = &pPoolID->pMagazines[i];
+        if (0 == pMagazine->numBlks)
+        {
+            continue;
+        }
+        Lac_MemPoolMagazineLock(pMagazine);
+        if (pMagazine->numBlks > 0)
+        {
+            pMemBlk = pMagazine->blks[--pMagazine->numBlks];
+        }
+        Lac_MemPoolMagazineUnlock(pMagazine);
+    }
+    return pMemBlk;
+}
+
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function allocates a block through the magazine of the calling thread.
+ * An empty magazine is refilled from the shared stack in a batch. If the
+ * magazine is in use by another thread the shared stack is used directly.
+ ******************************************************************************/
+static lac_mem_blk_t *Lac_MemPoolMagazineAlloc(lac_mem_pool_hdr_t *pPoolID)
+{
+    lac_mem_pool_magazine_t *pMagazine = Lac_MemPoolThreadMagazine(pPoolID);
+    lac_mem_blk_t *pMemBlk = NULL;
+    Cpa32U numBlks = 0;
+
+    if (CPA_TRUE == Lac_MemPoolMagazineTryLock(pMagazine))
+    {
+        if (0 == pMagazine->numBlks)
+        {
+            numBlks = pop_batch(&pPoolID->stack,
+                                pMagazine->blks,
+                                LAC_MEM_POOL_MAGAZINE_BATCH);
+            if (numBlks > 0)
+            {
+                pMagazine->numBlks = numBlks;
+                __sync_sub_and_fetch(&pPoolID->availBlks, numBlks);
+            }
+        }
+        if (pMagazine->numBlks > 0)
+        {
+            pMemBlk = pMagazine->blks[--pMagazine->numBlks];
+        }
+        Lac_MemPoolMagazineUnlock(pMagazine);
+        if (NULL != pMemBlk)
+        {
+            return pMemBlk;
+        }
+    }
+
+    pMemBlk = pop(&pPoolID->stack);
+    if (NULL != pMemBlk)
+    {
+        __sync_sub_and_fetch(&pPoolID->availBlks, 1);
+        return pMemBlk;
+    }
+    return Lac_MemPoolMagazineSteal(pPoolID);
+}
+
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function returns a block to the magazine of the calling thread. A full
+ * magazine is half flushed to the shared stack in a batch. If the magazine is
+ * in use by another thread the block goes straight to the shared stack.
+ ******************************************************************************/
+static void Lac_MemPoolMagazineFree(lac_mem_pool_hdr_t *pPoolID,
+                                    lac_mem_blk_t *pMemBlk)
+{
+    lac_mem_pool_magazine_t *pMagazine = Lac_MemPoolThreadMagazine(pPoolID);
+
+    if (CPA_TRUE == Lac_MemPoolMagazineTryLock(pMagazine))
+    {
+        if (LAC_MEM_POOL_MAGAZINE_SIZE == pMagazine->numBlks)
+        {
+            push_batch(&pPoolID->stack,
+                       &pMagazine->blks[LAC_MEM_POOL_MAGAZINE_SIZE -
+                                        LAC_MEM_POOL_MAGAZINE_BATCH],
+                       LAC_MEM_POOL_MAGAZINE_BATCH);
+            __sync_add_and_fetch(&pPoolID->availBlks,
+                                 LAC_MEM_POOL_MAGAZINE_BATCH);
+            pMagazine->numBlks -= LAC_MEM_POOL_MAGAZINE_BATCH;
+        }
+        pMagazine->blks[pMagazine->numBlks++] = pMemBlk;
+        Lac_MemPoolMagazineUnlock(pMagazine);
+        return;
+    }
+
+    push(&pPoolID->stack, pMemBlk);
+    __sync_add_and_fetch(&pPoolID->availBlks, 1);
+}
+#endif /* KERNEL_SPACE */
+
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function returns the number of free blocks in the shared stack and in
+ * all magazines of a pool.
+ ******************************************************************************/
+static size_t Lac_MemPoolNumAvailBlks(lac_mem_pool_hdr_t *pPoolID)
+{
+    size_t numBlks = pPoolID->availBlks;
+    Cpa32U i = 0;
+
+    if (NULL != pPoolID->pMagazines)
+    {
+        for (i = 0; i < LAC_MEM_POOL_NUM_MAGAZINES; i++)
+        {
+            numBlks += pPoolID->pMagazines[i].numBlks;
+        }
+    }
+    return numBlks;
+}
+
 CpaBoolean Lac_MemPoolTestAndGet(lac_memory_pool_id_t poolID)
 {
     lac_mem_pool_hdr_t *pPoolID = (lac_mem_pool_hdr_t *)poolID;
@@ -181,6 +386,7 @@ CpaStatus Lac_MemPoolCreate(
     }
 
     lac_mem_pools[poolSearch]->availBlks = 0;
+    lac_mem_pools[poolSearch]->pMagazines = NULL;
     lac_mem_pools[poolSearch]->stack = init_stack();
 
     /* Calculate alignment needed for allocation   */
@@ -236,6 +442,29 @@ CpaStatus Lac_MemPoolCreate(
         __sync_add_and_fetch(&lac_mem_pools[poolSearch]->availBlks, 1);
     }
 
+#ifndef KERNEL_SPACE
+    /* Allocate per-thread magazines for pools large enough to afford them */
+    if (numElementsInPool >= LAC_MEM_POOL_MAGAZINE_MIN_POOL)
+    {
+        lac_mem_pools[poolSearch]->pMagazines =
+            osalMemAllocAligned(0,
+                                sizeof(lac_mem_pool_magazine_t) *
+                                    LAC_MEM_POOL_NUM_MAGAZINES,
+                                LAC_MEM_POOL_MAGAZINE_ALIGNMENT);
+        if (NULL == lac_mem_pools[poolSearch]->pMagazines)
+        {
+            Lac_MemPoolCleanUpInternal(lac_mem_pools[poolSearch]);
+            lac_mem_pools[poolSearch] = NULL;
+            LAC_LOG_ERROR("Unable to allocate memory for pool magazines");
+            return CPA_STATUS_RESOURCE;
+        }
+        osalMemSet(lac_mem_pools[poolSearch]->pMagazines,
+                   0,
+                   sizeof(lac_mem_pool_magazine_t) *
+                       LAC_MEM_POOL_NUM_MAGAZINES);
+    }
+#endif
+
     /* Set Pool details in the header */
     (lac_mem_pools[poolSearch])->numElementsInPool = numElementsInPool;
     (lac_mem_pools[poolSearch])->blkSizeInBytes = blkSizeInBytes;
@@ -295,12 +524,24 @@ void *Lac_MemPoolEntryAlloc(lac_memory_pool_id_t poolID)
         return NULL;
 
     /* Remove block from pool */
-    pMemBlkCurrent = pop(&pPoolID->stack);
+#ifndef KERNEL_SPACE
+    if (NULL != pPoolID->pMagazines)
+    {
+        pMemBlkCurrent = Lac_MemPoolMagazineAlloc(pPoolID);
+    }
+    else
+#endif
+    {
+        pMemBlkCurrent = pop(&pPoolID->stack);
+        if (NULL != pMemBlkCurrent)
+        {
+            __sync_sub_and_fetch(&pPoolID->availBlks, 1);
+        }
+    }
     if (NULL == pMemBlkCurrent)
     {
         return (void *)CPA_STATUS_RETRY;
     }
-    __sync_sub_and_fetch(&pPoolID->availBlks, 1);
     pMemBlkCurrent->isInUse = CPA_TRUE;
     return (void *)((LAC_ARCH_UINT)(pMemBlkCurrent) + sizeof(lac_mem_blk_t));
 }
@@ -321,6 +562,13 @@ void Lac_MemPoolEntryFree(void *pEntry)
     pMemBlk = (lac_mem_blk_t *)((LAC_ARCH_UINT)pEntry - sizeof(lac_mem_blk_t));
     pMemBlk->isInUse = CPA_FALSE;
 
+#ifndef KERNEL_SPACE
+    if (NULL != pMemBlk->pPoolID->pMagazines)
+    {
+        Lac_MemPoolMagazineFree(pMemBlk->pPoolID, pMemBlk);
+        return;
+    }
+#endif
     push(&pMemBlk->pPoolID->stack, pMemBlk);
     __sync_add_and_fetch(&pMemBlk->pPoolID->availBlks, 1);
 }
@@ -358,6 +606,8 @@ void Lac_MemPoolCleanUpInternal(lac_mem_pool_hdr_t *pPoolID)
 
     if (pPoolID->trackBlks == NULL)
     {
+        /* Blocks cached in magazines are only reachable from there */
+        Lac_MemPoolMagazinesFlush(pPoolID);
         pCurrentBlk = pop(&pPoolID->stack);
 
         while (pCurrentBlk != NULL)
@@ -377,6 +627,10 @@ void Lac_MemPoolCleanUpInternal(lac_mem_pool_hdr_t *pPoolID)
         }
         LAC_OS_FREE(pPoolID->trackBlks);
     }
+    if (NULL != pPoolID->pMagazines)
+    {
+        osalMemAlignedFree(pPoolID->pMagazines);
+    }
     LAC_OS_FREE(pPoolID);
 }
 
@@ -388,7 +642,7 @@ unsigned int Lac_MemPoolAvailableEntries(lac_memory_pool_id_t poolID)
         LAC_LOG_ERROR("Invalid Pool ID");
         return 0;
     }
-    return pPoolID->availBlks;
+    return Lac_MemPoolNumAvailBlks(pPoolID);
 }
 
 void Lac_MemPoolStatsShow(void)
@@ -415,7 +669,7 @@ void Lac_MemPoolStatsShow(void)
                     lac_mem_pools[index]->numElementsInPool,
                     lac_mem_pools[index]->blkSizeInBytes,
                     lac_mem_pools[index]->blkAlignmentInBytes,
-                    lac_mem_pools[index]->availBlks);
+                    Lac_MemPoolNumAvailBlks(lac_mem_pools[index]));
         }
         index++;
     }
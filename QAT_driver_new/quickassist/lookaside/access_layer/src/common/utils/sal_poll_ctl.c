@@ -0,0 +1,175 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file sal_poll_ctl.c
+ *
+ * @ingroup SalPollCtl
+ *
+ * @description
+ *    Adaptive poll interval controller. The period is bounded by the
+ *    latency target and by the time maxBatch responses take to arrive;
+ *    the arrival rate is tracked as an exponentially weighted average of
+ *    the time between responses.
+ *
+ *****************************************************************************/
+
+#include "cpa.h"
+#include "Osal.h"
+
+#include "lac_common.h"
+
+#include "icp_sal_poll_ctl.h"
+
+#define SAL_POLL_CTL_GAP_WEIGHT_SHIFT (3)
+/**< The average moves by 1/8 of the difference on every sample */
+#define SAL_POLL_CTL_IDLE_GAPS (4)
+/**< Gaps without responses after which the instance is idle */
+
+CpaStatus icp_sal_PollCtlInit(icp_sal_poll_ctl_t *pCtl,
+                              Cpa64U targetLatencyNs,
+                              Cpa64U minPeriodNs,
+                              Cpa64U maxPeriodNs,
+                              Cpa32U maxBatch)
+{
+    LAC_CHECK_NULL_PARAM(pCtl);
+    if (0 == minPeriodNs)
+    {
+        minPeriodNs = ICP_SAL_POLL_CTL_DEFAULT_MIN_PERIOD_NS;
+    }
+    if (0 == maxPeriodNs)
+    {
+        maxPeriodNs = ICP_SAL_POLL_CTL_DEFAULT_MAX_PERIOD_NS;
+    }
+    if (0 == maxBatch)
+    {
+        maxBatch = ICP_SAL_POLL_CTL_DEFAULT_MAX_BATCH;
+    }
+    if (0 == targetLatencyNs || minPeriodNs > maxPeriodNs)
+    {
+        LAC_INVALID_PARAM_LOG("targetLatencyNs");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    osalMemSet(pCtl, 0, sizeof(icp_sal_poll_ctl_t));
+    pCtl->targetLatencyNs = targetLatencyNs;
+    pCtl->minPeriodNs = minPeriodNs;
+    pCtl->maxPeriodNs = maxPeriodNs;
+    pCtl->maxBatch = maxBatch;
+    pCtl->periodNs = minPeriodNs;
+    return CPA_STATUS_SUCCESS;
+}
+
+Cpa64U icp_sal_PollCtlUpdate(icp_sal_poll_ctl_t *pCtl,
+                             Cpa32U responses,
+                             Cpa64U nowNs)
+{
+    Cpa64U latencyPeriod = 0;
+    Cpa64U period = 0;
+    Cpa64U gap = 0;
+
+    if (NULL == pCtl)
+    {
+        return ICP_SAL_POLL_CTL_DEFAULT_MIN_PERIOD_NS;
+    }
+
+    /* The first poll is taken to have come one period after Init */
+    if (0 == pCtl->lastPollNs)
+    {
+        pCtl->idleNs += pCtl->periodNs;
+    }
+    else if (nowNs > pCtl->lastPollNs)
+    {
+        pCtl->idleNs += nowNs - pCtl->lastPollNs;
+    }
+    pCtl->lastPollNs = nowNs;
+    pCtl->polls++;
+
+    if (responses)
+    {
+        Cpa64U sample = pCtl->idleNs / responses;
+
+        pCtl->responses += responses;
+        if (0 == pCtl->gapNs)
+        {
+            pCtl->gapNs = sample;
+        }
+        else
+        {
+            pCtl->gapNs -= pCtl->gapNs >> SAL_POLL_CTL_GAP_WEIGHT_SHIFT;
+            pCtl->gapNs += sample >> SAL_POLL_CTL_GAP_WEIGHT_SHIFT;
+        }
+        pCtl->idleNs = 0;
+    }
+    else
+    {
+        pCtl->emptyPolls++;
+    }
+
+    /* Responses wait half a period on average */
+    latencyPeriod = 2 * pCtl->targetLatencyNs;
+    period = latencyPeriod;
+    /* A lull longer than the average gap means the rate went down */
+    gap = pCtl->gapNs > pCtl->idleNs ? pCtl->gapNs : pCtl->idleNs;
+    if (pCtl->gapNs && (Cpa64U)pCtl->maxBatch * gap < period)
+    {
+        period = (Cpa64U)pCtl->maxBatch * gap;
+    }
+
+    if (0 == responses &&
+        (0 == pCtl->gapNs ||
+         pCtl->idleNs >
+             SAL_POLL_CTL_IDLE_GAPS * (pCtl->gapNs > latencyPeriod
+                                           ? pCtl->gapNs
+                                           : latencyPeriod)))
+    {
+        /* Nothing has arrived for a while, back off */
+        period = pCtl->periodNs * 2;
+    }
+
+    if (period < pCtl->minPeriodNs)
+    {
+        period = pCtl->minPeriodNs;
+    }
+    if (period > pCtl->maxPeriodNs)
+    {
+        period = pCtl->maxPeriodNs;
+    }
+    pCtl->periodNs = period;
+    return period;
+}
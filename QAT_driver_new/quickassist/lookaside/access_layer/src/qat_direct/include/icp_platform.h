@@ -313,5 +313,12 @@ extern char *icp_module_name;
 #define ICP_MUTEX_UNLOCK osalMutexUnlock
 #define ICP_MUTEX_UNINIT osalMutexDestroy
 
+#define ICP_ADAPTIVE_LOCK OsalAdaptiveLock
+#define ICP_ADAPTIVE_LOCK_INIT osalAdaptiveLockInit
+#define ICP_ADAPTIVE_LOCK_LOCK osalAdaptiveLockLock
+#define ICP_ADAPTIVE_LOCK_TRYLOCK osalAdaptiveLockTryLock
+#define ICP_ADAPTIVE_LOCK_UNLOCK osalAdaptiveLockUnlock
+#define ICP_ADAPTIVE_LOCK_UNINIT osalAdaptiveLockDestroy
+
 
 #endif /* ICP_PLATFORM_H */
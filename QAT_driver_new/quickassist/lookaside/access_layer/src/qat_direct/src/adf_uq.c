@@ -144,8 +144,8 @@ CpaStatus adf_uq_put_msg(adf_dev_ring_handle_t *ring)
     return status;
 }
 
-STATIC CpaStatus adf_uq_push_single_desc(adf_dev_ring_handle_t *ring,
-                                         uint32_t nr_req)
+CpaStatus adf_uq_push_single_desc(adf_dev_ring_handle_t *ring,
+                                  uint32_t nr_req)
 {
     CpaStatus status = CPA_STATUS_RETRY;
     void *src_addr = NULL;
@@ -58,7 +58,7 @@
  */
 STATIC subservice_registation_handle_t *pSubsystemTable = NULL;
 STATIC subservice_registation_handle_t *pSubsystemTableHead = NULL;
-STATIC ICP_MUTEX subsystemTableLock = {0};
+STATIC ICP_ADAPTIVE_LOCK subsystemTableLock = {0};
 char *icp_module_name = "ADF_UIO_PROXY";
 
 /* Slepping time before subsystem is started */
@@ -86,25 +86,24 @@ STATIC inline CpaStatus adf_subsystemAdd(
     ICP_CHECK_FOR_NULL_PARAM(subsystem);
 
     subsystem_hdl = pSubsystemTableHead;
-    if (0 == subsystemTableLock)
+    if (NULL == pSubsystemTableHead)
     {
-        ICP_MUTEX_INIT(&subsystemTableLock);
         set_sleep_time(SLEEP_TIME, SLEEP_TIMES);
     }
 
-    ICP_MUTEX_LOCK(&subsystemTableLock);
+    ICP_ADAPTIVE_LOCK_LOCK(&subsystemTableLock);
     /* Search the linked list for the subsystem */
     ICP_FIND_ELEMENT_IN_LIST(subsystem, subsystem_hdl, status);
     if (CPA_STATUS_SUCCESS == status)
     {
         ADF_ERROR("subservice %s already in table.\n",
                   subsystem->subsystem_name);
-        ICP_MUTEX_UNLOCK(&subsystemTableLock);
+        ICP_ADAPTIVE_LOCK_UNLOCK(&subsystemTableLock);
         return CPA_STATUS_FAIL;
     }
     ICP_ADD_ELEMENT_TO_END_OF_LIST(
         subsystem, pSubsystemTable, pSubsystemTableHead);
-    ICP_MUTEX_UNLOCK(&subsystemTableLock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(&subsystemTableLock);
     return CPA_STATUS_SUCCESS;
 }
 
@@ -120,12 +119,12 @@ STATIC inline CpaStatus adf_subsystemRemove(
     ICP_CHECK_FOR_NULL_PARAM(subsystem);
 
     subsystem_hdl = pSubsystemTableHead;
-    ICP_MUTEX_LOCK(&subsystemTableLock);
+    ICP_ADAPTIVE_LOCK_LOCK(&subsystemTableLock);
     ICP_FIND_ELEMENT_IN_LIST(subsystem, subsystem_hdl, status);
     if (CPA_STATUS_SUCCESS != status)
     {
         ADF_ERROR("subservice %s not found.\n", subsystem->subsystem_name);
-        ICP_MUTEX_UNLOCK(&subsystemTableLock);
+        ICP_ADAPTIVE_LOCK_UNLOCK(&subsystemTableLock);
         return CPA_STATUS_FAIL;
     }
     else
@@ -134,11 +133,7 @@ STATIC inline CpaStatus adf_subsystemRemove(
     }
     ICP_REMOVE_ELEMENT_FROM_LIST(
         subsystem, pSubsystemTable, pSubsystemTableHead);
-    ICP_MUTEX_UNLOCK(&subsystemTableLock);
-    if (0 != subsystemTableLock && NULL == pSubsystemTableHead)
-    {
-        ICP_MUTEX_UNINIT(&subsystemTableLock);
-    }
+    ICP_ADAPTIVE_LOCK_UNLOCK(&subsystemTableLock);
     return CPA_STATUS_SUCCESS;
 }
 
@@ -714,9 +709,5 @@ CpaStatus reset_adf_subsystemTable(void)
 {
     pSubsystemTable = NULL;
     pSubsystemTableHead = NULL;
-    if (0 == subsystemTableLock)
-    {
-        return ICP_MUTEX_INIT(&subsystemTableLock);
-    }
-    return CPA_STATUS_SUCCESS;
+    return ICP_ADAPTIVE_LOCK_INIT(&subsystemTableLock);
 }
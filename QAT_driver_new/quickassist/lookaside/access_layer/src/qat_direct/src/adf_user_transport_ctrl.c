@@ -434,7 +434,7 @@ STATIC CpaStatus adf_populate_ring_info(adf_dev_ring_handle_t *pRingHandle,
         return CPA_STATUS_FAIL;
     }
 
-    pRingHandle->user_lock = ICP_MALLOC_GEN(sizeof(ICP_MUTEX));
+    pRingHandle->user_lock = ICP_MALLOC_GEN(sizeof(ICP_ADAPTIVE_LOCK));
 
     if (!pRingHandle->user_lock)
     {
@@ -443,12 +443,12 @@ STATIC CpaStatus adf_populate_ring_info(adf_dev_ring_handle_t *pRingHandle,
         ADF_ERROR("Could not alloc memory for ring lock\n");
         return CPA_STATUS_FAIL;
     }
-    if (OSAL_SUCCESS != ICP_MUTEX_INIT(pRingHandle->user_lock))
+    if (OSAL_SUCCESS != ICP_ADAPTIVE_LOCK_INIT(pRingHandle->user_lock))
     {
         ICP_FREE(pRingHandle->service_name);
         ICP_FREE(pRingHandle->section_name);
         ICP_FREE(pRingHandle->user_lock);
-        ADF_ERROR("Mutex init failed for user_lock\n");
+        ADF_ERROR("Lock init failed for user_lock\n");
         return CPA_STATUS_RESOURCE;
     }
 
@@ -468,7 +468,7 @@ STATIC CpaStatus adf_populate_ring_info(adf_dev_ring_handle_t *pRingHandle,
     {
         ICP_FREE(pRingHandle->service_name);
         ICP_FREE(pRingHandle->section_name);
-        ICP_MUTEX_UNINIT(pRingHandle->user_lock);
+        ICP_ADAPTIVE_LOCK_UNINIT(pRingHandle->user_lock);
         ICP_FREE(pRingHandle->user_lock);
         ADF_ERROR("Failed to populate the ring info\n");
         return CPA_STATUS_FAIL;
@@ -544,13 +544,13 @@ CpaStatus icp_adf_transCreateHandle(icp_accel_dev_t *accel_dev,
      * for at that time, we don't know which device the user will be use */
     if (NULL == bank->bundle)
     {
-        ICP_MUTEX_LOCK(bank->user_bank_lock);
+        ICP_ADAPTIVE_LOCK_LOCK(bank->user_bank_lock);
         if (0 > init_bank_from_accel(accel_dev, bank))
         {
-            ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+            ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
             return CPA_STATUS_FAIL;
         }
-        ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+        ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
     }
 
     if (CPA_STATUS_SUCCESS ==
@@ -709,15 +709,15 @@ CpaStatus icp_adf_transReinitHandle(icp_accel_dev_t *accel_dev,
      * for at that time, we don't know which device the user will be use */
     if (NULL == bank->bundle)
     {
-        ICP_MUTEX_LOCK(bank->user_bank_lock);
+        ICP_ADAPTIVE_LOCK_LOCK(bank->user_bank_lock);
         if (CPA_STATUS_SUCCESS != reinit_bank_from_accel(accel_dev, bank))
         {
-            ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+            ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
             icp_adf_transReleaseHandle(pRingHandle);
             *trans_handle = NULL;
             return CPA_STATUS_FAIL;
         }
-        ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+        ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
     }
     adf_dev_bank_handle_get(bank);
 
@@ -895,7 +895,7 @@ CpaStatus icp_adf_transReleaseHandle(icp_comms_trans_handle trans_handle)
 
     if (NULL != pRingHandle->user_lock)
     {
-        ICP_MUTEX_UNINIT(pRingHandle->user_lock);
+        ICP_ADAPTIVE_LOCK_UNINIT(pRingHandle->user_lock);
         ICP_FREE(pRingHandle->user_lock);
     }
 
@@ -992,6 +992,25 @@ CpaStatus icp_adf_transPutMsg(icp_comms_trans_handle trans_handle,
     return adf_user_put_msg(pRingHandle, inBuf, seq_num);
 }
 
+/*
+ * Put a batch of messages on the transport handle
+ */
+CpaStatus icp_adf_transPutMsgs(icp_comms_trans_handle trans_handle,
+                               Cpa32U **inBufs,
+                               Cpa32U bufLen,
+                               Cpa32U numMsgs,
+                               Cpa64U *seq_nums,
+                               Cpa32U *pNumPut)
+{
+    adf_dev_ring_handle_t *pRingHandle = (adf_dev_ring_handle_t *)trans_handle;
+
+    ICP_CHECK_FOR_NULL_PARAM(trans_handle);
+    ICP_CHECK_PARAM_RANGE(bufLen * ICP_ADF_BYTES_PER_WORD,
+                          pRingHandle->message_size,
+                          pRingHandle->message_size);
+    return adf_user_put_msgs(pRingHandle, inBufs, numMsgs, seq_nums, pNumPut);
+}
+
 /*
  * adf_user_unmap_rings
  * Device is going down - unmap all rings allocated for this device
@@ -1094,7 +1113,7 @@ CpaStatus icp_sal_pollBank(Cpa32U accelId,
     ICP_CHECK_PARAM_LT_MAX(bank_number, accel_dev->maxNumBanks);
     banks = accel_dev->banks;
     bank = &banks[bank_number];
-    ICP_MUTEX_LOCK(bank->user_bank_lock);
+    ICP_ADAPTIVE_LOCK_LOCK(bank->user_bank_lock);
 
     /* Read the ring status CSR to determine which rings are empty. */
     csrVal = READ_CSR_E_STAT_EXT(bank->csr_addr, bank->bank_offset);
@@ -1104,7 +1123,7 @@ CpaStatus icp_sal_pollBank(Cpa32U accelId,
      * are all empty. */
     if (!(csrVal & bank->pollingMask))
     {
-        ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+        ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
         return CPA_STATUS_RETRY;
     }
 
@@ -1145,7 +1164,7 @@ CpaStatus icp_sal_pollBank(Cpa32U accelId,
         }
     }
     /* Return SUCCESS if adf_pollRing returned SUCCESS at any stage */
-    ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
     if (stat_total)
     {
         return CPA_STATUS_SUCCESS;
@@ -1298,7 +1317,7 @@ CpaStatus icp_adf_pollInstance(icp_comms_trans_handle *trans_hnd,
         return CPA_STATUS_FAIL;
     }
 
-    ICP_MUTEX_LOCK(ring_hnd_first->user_lock);
+    ICP_ADAPTIVE_LOCK_LOCK(ring_hnd_first->user_lock);
     csr_base_addr = (Cpa8U *)ring_hnd_first->csr_addr;
 
     for (i = 0; i < num_transHandles; i++)
@@ -1306,7 +1325,7 @@ CpaStatus icp_adf_pollInstance(icp_comms_trans_handle *trans_hnd,
         ring_hnd = (adf_dev_ring_handle_t *)trans_hnd[i];
         if (!ring_hnd)
         {
-            ICP_MUTEX_UNLOCK(ring_hnd_first->user_lock);
+            ICP_ADAPTIVE_LOCK_UNLOCK(ring_hnd_first->user_lock);
             return CPA_STATUS_FAIL;
         }
         /* And with polling ring mask. If the
@@ -1330,7 +1349,7 @@ CpaStatus icp_adf_pollInstance(icp_comms_trans_handle *trans_hnd,
                                  ring_hnd->bank_data->interrupt_mask);
         }
     }
-    ICP_MUTEX_UNLOCK(ring_hnd_first->user_lock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(ring_hnd_first->user_lock);
     /* If any of the rings in the instance had data and was polled
      * return SUCCESS. */
     if (stat_total)
@@ -1359,7 +1378,7 @@ CpaStatus icp_adf_checkRingError(icp_comms_trans_handle *trans_hnd,
         return CPA_STATUS_SUCCESS;
     }
 
-    ICP_MUTEX_LOCK(ring_hnd_first->user_lock);
+    ICP_ADAPTIVE_LOCK_LOCK(ring_hnd_first->user_lock);
 
     for (i = 0; i < num_transHandles; i++)
     {
@@ -1377,7 +1396,7 @@ CpaStatus icp_adf_checkRingError(icp_comms_trans_handle *trans_hnd,
             break;
         }
     }
-    ICP_MUTEX_UNLOCK(ring_hnd_first->user_lock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(ring_hnd_first->user_lock);
 
     return status;
 }
@@ -1441,20 +1460,20 @@ CpaStatus adf_user_transport_init(icp_accel_dev_t *accel_dev)
     for (i = 0; i < accel_dev->maxNumBanks; i++)
     {
         bank = &banks[i];
-        bank->user_bank_lock = ICP_ZALLOC_GEN(sizeof(ICP_MUTEX));
+        bank->user_bank_lock = ICP_ZALLOC_GEN(sizeof(ICP_ADAPTIVE_LOCK));
         if (!bank->user_bank_lock)
         {
             ADF_ERROR("Could not alloc memory for bank mutex\n");
             for (x = i - 1; x >= 0; x--)
             {
                 bank = &banks[x];
-                ICP_MUTEX_UNINIT(bank->user_bank_lock);
+                ICP_ADAPTIVE_LOCK_UNINIT(bank->user_bank_lock);
                 ICP_FREE(bank->user_bank_lock);
             }
             adf_proxy_depopulate_device_info(accel_dev);
             return CPA_STATUS_FAIL;
         }
-        ICP_MUTEX_INIT(bank->user_bank_lock);
+        ICP_ADAPTIVE_LOCK_INIT(bank->user_bank_lock);
     }
     return status;
 }
@@ -1475,9 +1494,9 @@ CpaStatus adf_user_transport_reinit(icp_accel_dev_t *accel_dev)
     for (i = 0; i < accel_dev->maxNumBanks; i++)
     {
         bank = &banks[i];
-        if (OSAL_SUCCESS != ICP_MUTEX_INIT(bank->user_bank_lock))
+        if (OSAL_SUCCESS != ICP_ADAPTIVE_LOCK_INIT(bank->user_bank_lock))
         {
-            ADF_ERROR("Mutex init failed for user_bank_lock\n");
+            ADF_ERROR("Lock init failed for user_bank_lock\n");
             return CPA_STATUS_RESOURCE;
         }
     }
@@ -1507,7 +1526,7 @@ CpaStatus adf_user_transport_exit(icp_accel_dev_t *accel_dev)
 
         if (bank->user_bank_lock)
         {
-            ICP_MUTEX_UNINIT(bank->user_bank_lock);
+            ICP_ADAPTIVE_LOCK_UNINIT(bank->user_bank_lock);
             ICP_FREE(bank->user_bank_lock);
         }
 
@@ -1538,9 +1557,9 @@ CpaStatus adf_user_transport_clean(icp_accel_dev_t *accel_dev)
             uio_free_bundle(bank->bundle);
             bank->bundle = NULL;
         }
-        if ((bank->user_bank_lock) && (*(ICP_MUTEX *)(bank->user_bank_lock)))
+        if (bank->user_bank_lock)
         {
-            ICP_MUTEX_UNINIT(bank->user_bank_lock);
+            ICP_ADAPTIVE_LOCK_UNINIT(bank->user_bank_lock);
         }
         ICP_FREE(bank->rings);
     }
@@ -55,6 +55,21 @@
 CpaStatus adf_user_put_msg(adf_dev_ring_handle_t *pRingHandle,
                            Cpa32U *inBuf,
                            uint64_t *seq_num);
+
+/*
+ * adf_user_put_msgs
+ *
+ * Description
+ * Function puts a batch of messages onto the ring and rings the doorbell
+ * once. The number of messages put is returned in pNumPut: all or none
+ * on a ring, possibly fewer on a shared queue, which takes the batch
+ * as several descriptors.
+ */
+CpaStatus adf_user_put_msgs(adf_dev_ring_handle_t *pRingHandle,
+                            Cpa32U **inBufs,
+                            Cpa32U numMsgs,
+                            uint64_t *seq_nums,
+                            Cpa32U *pNumPut);
 /*
  * adf_user_notify_msgs
  *
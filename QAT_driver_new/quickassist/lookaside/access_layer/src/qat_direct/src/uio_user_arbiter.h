@@ -67,7 +67,7 @@ static __inline__ void adf_update_ring_arb_enable(adf_dev_ring_handle_t *ring)
     int32_t status;
 
     /* Lock the register to enable/disable arbiter */
-    status = ICP_MUTEX_LOCK(ring->bank_data->user_bank_lock);
+    status = ICP_ADAPTIVE_LOCK_LOCK(ring->bank_data->user_bank_lock);
     if (status)
     {
         ADF_ERROR("Failed to lock bank with error %d\n", status);
@@ -76,7 +76,7 @@ static __inline__ void adf_update_ring_arb_enable(adf_dev_ring_handle_t *ring)
 
     WRITE_CSR_ARB_RINGSRVARBEN(
         ring->csr_addr, 0, ring->bank_data->ring_mask & 0xFF);
-    ICP_MUTEX_UNLOCK(ring->bank_data->user_bank_lock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(ring->bank_data->user_bank_lock);
 }
 
 #define adf_update_ring_arb_disable adf_update_ring_arb_enable
@@ -104,7 +104,7 @@ static int adf_reserve_ring(adf_dev_bank_handle_t *bank, uint32_t ring_number)
         return status;
     }
 
-    status = ICP_MUTEX_LOCK(bank->user_bank_lock);
+    status = ICP_ADAPTIVE_LOCK_LOCK(bank->user_bank_lock);
     if (status)
     {
         ADF_ERROR("Failed to lock bank with error %d\n", status);
@@ -118,7 +118,7 @@ static int adf_reserve_ring(adf_dev_bank_handle_t *bank, uint32_t ring_number)
     else
         status = -EBUSY;
 
-    ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
 
     return status;
 }
@@ -128,14 +128,14 @@ static void adf_unreserve_ring(adf_dev_bank_handle_t *bank,
 {
     int status;
 
-    status = ICP_MUTEX_LOCK(bank->user_bank_lock);
+    status = ICP_ADAPTIVE_LOCK_LOCK(bank->user_bank_lock);
     if (status)
     {
         ADF_ERROR("Failed to lock bank with error %d\n", status);
         return;
     }
     bank->ring_mask &= ~(1 << ring_number);
-    ICP_MUTEX_UNLOCK(bank->user_bank_lock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(bank->user_bank_lock);
 }
 
 #ifndef USE_LEGACY_ETRINGMGR
@@ -152,7 +152,7 @@ int32_t adf_user_put_msg(adf_dev_ring_handle_t *ring,
     ICP_CHECK_FOR_NULL_PARAM(inBuf);
     ICP_CHECK_FOR_NULL_PARAM(ring->accel_dev);
 
-    status = ICP_MUTEX_LOCK(ring->user_lock);
+    status = ICP_ADAPTIVE_LOCK_LOCK(ring->user_lock);
     if (status)
     {
         ADF_ERROR("Failed to lock bank with error %d\n", status);
@@ -209,7 +209,120 @@ int32_t adf_user_put_msg(adf_dev_ring_handle_t *ring,
     ring->send_seq++;
 
 adf_user_put_msg_exit:
-    ICP_MUTEX_UNLOCK(ring->user_lock);
+    ICP_ADAPTIVE_LOCK_UNLOCK(ring->user_lock);
+    return status;
+}
+
+int32_t adf_user_put_msgs(adf_dev_ring_handle_t *ring,
+                          uint32_t **inBufs,
+                          uint32_t numMsgs,
+                          uint64_t *seq_nums,
+                          uint32_t *pNumPut)
+{
+    int status = CPA_STATUS_SUCCESS;
+    uint32_t *targetAddr;
+    int64_t flight;
+    uint32_t numPut = 0;
+    uint32_t nr_req = 0;
+    uint32_t i;
+    ICP_CHECK_FOR_NULL_PARAM(ring);
+    ICP_CHECK_FOR_NULL_PARAM(inBufs);
+    ICP_CHECK_FOR_NULL_PARAM(pNumPut);
+    ICP_CHECK_FOR_NULL_PARAM(ring->accel_dev);
+
+    *pNumPut = 0;
+    if (0 == numMsgs)
+    {
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (ring->message_size != ADF_MSG_SIZE_64_BYTES &&
+        ring->message_size != ADF_MSG_SIZE_128_BYTES)
+    {
+        return CPA_STATUS_FAIL;
+    }
+
+    status = ICP_ADAPTIVE_LOCK_LOCK(ring->user_lock);
+    if (status)
+    {
+        ADF_ERROR("Failed to lock bank with error %d\n", status);
+        return CPA_STATUS_FAIL;
+    }
+
+    /* Reserve ring space for the whole batch */
+    flight = __sync_add_and_fetch(ring->in_flight, numMsgs);
+    if (flight > ring->max_requests_inflight)
+    {
+        __sync_sub_and_fetch(ring->in_flight, numMsgs);
+        status = CPA_STATUS_RETRY;
+        goto adf_user_put_msgs_exit;
+    }
+
+    for (i = 0; i < numMsgs; i++)
+    {
+        targetAddr =
+            (uint32_t *)(((UARCH_INT)ring->ring_virt_addr) + ring->tail);
+        if (ring->message_size == ADF_MSG_SIZE_64_BYTES)
+        {
+            adf_memcpy64(targetAddr, inBufs[i]);
+        }
+        else
+        {
+            adf_memcpy128(targetAddr, inBufs[i]);
+        }
+
+        ring->tail = modulo((ring->tail + ring->message_size), ring->modulo);
+
+        if (NULL != seq_nums)
+            seq_nums[i] = ring->send_seq + i;
+
+        if (!ring->is_shared_queue)
+            continue;
+
+        /* A descriptor covers up to ADF_UQ_MAX_BATCH_NR messages and stops
+         * at the end of the ring. A descriptor the queue does not take is
+         * not retried with the lock held: it and the following messages
+         * are dropped and their ring space is released. */
+        nr_req++;
+        if (ADF_UQ_MAX_BATCH_NR == nr_req || 0 == ring->tail ||
+            numMsgs - 1 == i)
+        {
+            status = adf_uq_push_single_desc(ring, nr_req);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                ring->tail = ring->csrTailOffset;
+                break;
+            }
+            numPut += nr_req;
+            nr_req = 0;
+        }
+    }
+
+    if (ring->is_shared_queue)
+    {
+        if (numPut < numMsgs)
+        {
+            __sync_sub_and_fetch(ring->in_flight, numMsgs - numPut);
+        }
+        if (numPut > 0)
+        {
+            status = CPA_STATUS_SUCCESS;
+        }
+    }
+    else
+    {
+        /* Single doorbell for the whole batch */
+        WRITE_CSR_RING_TAIL(
+            ring->csr_addr, ring->bank_offset, ring->ring_num, ring->tail);
+        ring->csrTailOffset = ring->tail;
+        numPut = numMsgs;
+    }
+
+    ring->send_seq += numPut;
+    *pNumPut = numPut;
+
+adf_user_put_msgs_exit:
+    ICP_ADAPTIVE_LOCK_UNLOCK(ring->user_lock);
     return status;
 }
 
@@ -72,6 +72,11 @@ int32_t adf_ring_freebuf(adf_dev_ring_handle_t *ring);
 int32_t adf_user_put_msg(adf_dev_ring_handle_t *ring,
                          uint32_t *inBuf,
                          uint64_t *seq_num);
+int32_t adf_user_put_msgs(adf_dev_ring_handle_t *ring,
+                          uint32_t **inBufs,
+                          uint32_t numMsgs,
+                          uint64_t *seq_nums,
+                          uint32_t *pNumPut);
 CpaBoolean adf_user_check_resp_ring(adf_dev_ring_handle_t *ring);
 int32_t adf_user_notify_msgs(adf_dev_ring_handle_t *ring);
 int32_t adf_user_notify_msgs_poll(adf_dev_ring_handle_t *ring);
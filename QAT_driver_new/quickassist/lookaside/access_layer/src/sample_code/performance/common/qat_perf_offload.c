@@ -0,0 +1,218 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+#include "cpa_sample_code_utils_common.h"
+#include "qat_perf_offload.h"
+
+/* per byte figures are printed in hundredths of a cycle */
+#define QAT_PERF_OFFLOAD_SCALE (100)
+
+static const char *qatPerfOffloadPhaseNames[QAT_PERF_OFFLOAD_NUM_PHASES] = {
+    "Submit", "Poll", "Callback", "Idle"};
+
+void qatPerfOffloadStart(qat_perf_offload_t *pProfile)
+{
+    memset(pProfile, 0, sizeof(qat_perf_offload_t));
+    pProfile->startCycles = sampleCodeTimestamp();
+}
+
+void qatPerfOffloadStop(qat_perf_offload_t *pProfile)
+{
+    perf_cycles_t charged = 0;
+    perf_cycles_t wall = 0;
+    Cpa32U i = 0;
+
+    pProfile->endCycles = sampleCodeTimestamp();
+    wall = pProfile->endCycles - pProfile->startCycles;
+    for (i = 0; i < QAT_PERF_OFFLOAD_NUM_PHASES; i++)
+    {
+        charged += pProfile->cycles[i];
+    }
+    /* what is left is the loop itself, the application would run there */
+    if (wall > charged)
+    {
+        pProfile->cycles[QAT_PERF_OFFLOAD_IDLE] += wall - charged;
+    }
+}
+
+void qatPerfOffloadSubmit(qat_perf_offload_t *pProfile,
+                          perf_cycles_t start,
+                          CpaStatus status,
+                          Cpa32U bytes)
+{
+    perf_cycles_t cycles = sampleCodeTimestamp() - start;
+
+    if (CPA_STATUS_RETRY == status)
+    {
+        pProfile->cycles[QAT_PERF_OFFLOAD_IDLE] += cycles;
+        return;
+    }
+    pProfile->cycles[QAT_PERF_OFFLOAD_SUBMIT] += cycles;
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pProfile->requests++;
+        pProfile->bytes += bytes;
+    }
+}
+
+void qatPerfOffloadPoll(qat_perf_offload_t *pProfile,
+                        perf_cycles_t start,
+                        Cpa32U responses)
+{
+    perf_cycles_t cycles = sampleCodeTimestamp() - start;
+
+    /* the callbacks have been charged already */
+    if (cycles > pProfile->pollCallbackCycles)
+    {
+        cycles -= pProfile->pollCallbackCycles;
+    }
+    else
+    {
+        cycles = 0;
+    }
+    pProfile->pollCallbackCycles = 0;
+    if (0 == responses)
+    {
+        pProfile->cycles[QAT_PERF_OFFLOAD_IDLE] += cycles;
+    }
+    else
+    {
+        pProfile->cycles[QAT_PERF_OFFLOAD_POLL] += cycles;
+    }
+}
+
+void qatPerfOffloadCallback(qat_perf_offload_t *pProfile, perf_cycles_t start)
+{
+    perf_cycles_t cycles = sampleCodeTimestamp() - start;
+
+    pProfile->cycles[QAT_PERF_OFFLOAD_CALLBACK] += cycles;
+    pProfile->pollCallbackCycles += cycles;
+}
+
+void qatPerfOffloadAdd(qat_perf_offload_t *pTotal,
+                       const qat_perf_offload_t *pProfile)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < QAT_PERF_OFFLOAD_NUM_PHASES; i++)
+    {
+        pTotal->cycles[i] += pProfile->cycles[i];
+    }
+    if (0 == pTotal->startCycles || pProfile->startCycles < pTotal->startCycles)
+    {
+        pTotal->startCycles = pProfile->startCycles;
+    }
+    if (pProfile->endCycles > pTotal->endCycles)
+    {
+        pTotal->endCycles = pProfile->endCycles;
+    }
+    pTotal->requests += pProfile->requests;
+    pTotal->bytes += pProfile->bytes;
+    pTotal->swCycles += pProfile->swCycles;
+    pTotal->swBytes += pProfile->swBytes;
+}
+
+void qatPerfOffloadPrintHeader(void)
+{
+    Cpa32U i = 0;
+
+    PRINT("%-7s %-5s", "Size", "Depth");
+    for (i = 0; i < QAT_PERF_OFFLOAD_NUM_PHASES; i++)
+    {
+        PRINT(" %9s", qatPerfOffloadPhaseNames[i]);
+    }
+    PRINT(" %8s %8s %8s %8s\n", "CPU/B", "SW/B", "Idle/B", "Gain/B");
+}
+
+/* Print a signed number of hundredths as a decimal */
+static void qatPerfOffloadPrintFixed(long long value)
+{
+    unsigned long long magnitude =
+        (unsigned long long)(value < 0 ? -value : value);
+
+    PRINT(" %s%4llu.%02llu",
+          value < 0 ? "-" : " ",
+          magnitude / QAT_PERF_OFFLOAD_SCALE,
+          magnitude % QAT_PERF_OFFLOAD_SCALE);
+}
+
+void qatPerfOffloadPrint(const qat_perf_offload_t *pProfile,
+                         Cpa32U requestSize,
+                         Cpa32U queueDepth)
+{
+    perf_cycles_t cpuCycles = 0;
+    long long cpuPerByte = 0;
+    long long swPerByte = 0;
+    long long idlePerByte = 0;
+    Cpa32U i = 0;
+
+    PRINT("%-7u %-5u", requestSize, queueDepth);
+    if (0 == pProfile->requests || 0 == pProfile->bytes)
+    {
+        PRINT(" no request completed\n");
+        return;
+    }
+    for (i = 0; i < QAT_PERF_OFFLOAD_NUM_PHASES; i++)
+    {
+        PRINT(" %9llu", pProfile->cycles[i] / pProfile->requests);
+    }
+
+    /* the thread is busy in submit, poll and callback, in idle it is not */
+    cpuCycles = pProfile->cycles[QAT_PERF_OFFLOAD_SUBMIT] +
+                pProfile->cycles[QAT_PERF_OFFLOAD_POLL] +
+                pProfile->cycles[QAT_PERF_OFFLOAD_CALLBACK];
+    cpuPerByte =
+        (long long)(cpuCycles * QAT_PERF_OFFLOAD_SCALE / pProfile->bytes);
+    idlePerByte = (long long)(pProfile->cycles[QAT_PERF_OFFLOAD_IDLE] *
+                              QAT_PERF_OFFLOAD_SCALE / pProfile->bytes);
+    qatPerfOffloadPrintFixed(cpuPerByte);
+    if (0 == pProfile->swBytes)
+    {
+        PRINT(" %8s", "-");
+        qatPerfOffloadPrintFixed(idlePerByte);
+        PRINT(" %8s\n", "-");
+        return;
+    }
+    swPerByte = (long long)(pProfile->swCycles * QAT_PERF_OFFLOAD_SCALE /
+                            pProfile->swBytes);
+    qatPerfOffloadPrintFixed(swPerByte);
+    qatPerfOffloadPrintFixed(idlePerByte);
+    /* every byte offloaded saves the software cycles and costs the CPU
+     * cycles of the offload */
+    qatPerfOffloadPrintFixed(swPerByte - cpuPerByte);
+    PRINT("\n");
+}
@@ -0,0 +1,209 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+*****************************************************************************
+* @file qat_perf_offload.h
+*
+* @ingroup sample_code
+*
+* @description
+*     Offload cost profiler. The thread that submits the requests also polls
+*     for their responses, and every cycle it spends is charged to one of
+*     four phases: submit, poll, callback or idle. Idle holds the polls that
+*     found nothing and the submissions the ring turned back, which is the
+*     time an application could give to its own work while the accelerator
+*     runs. Against the cycles software takes to do the same work, this
+*     gives the application cycles returned per offloaded byte.
+*
+*****************************************************************************/
+#ifndef QAT_PERF_OFFLOAD_H_
+#define QAT_PERF_OFFLOAD_H_
+
+#include "cpa.h"
+#include "cpa_sample_code_utils_common.h"
+
+typedef enum qat_perf_offload_phase_e
+{
+    QAT_PERF_OFFLOAD_SUBMIT = 0,
+    QAT_PERF_OFFLOAD_POLL,
+    QAT_PERF_OFFLOAD_CALLBACK,
+    QAT_PERF_OFFLOAD_IDLE,
+    QAT_PERF_OFFLOAD_NUM_PHASES
+} qat_perf_offload_phase_t;
+
+typedef struct qat_perf_offload_s
+{
+    perf_cycles_t cycles[QAT_PERF_OFFLOAD_NUM_PHASES];
+    /* callback cycles spent inside the poll being measured */
+    perf_cycles_t pollCallbackCycles;
+    perf_cycles_t startCycles;
+    perf_cycles_t endCycles;
+    Cpa64U requests;
+    Cpa64U bytes;
+    /* software baseline: cycles to process swBytes on the CPU */
+    perf_cycles_t swCycles;
+    Cpa64U swBytes;
+} qat_perf_offload_t;
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Clear a profile and take the start time of the measurement
+ *
+ * @param[in]   pProfile                profile to start
+ *
+ *****************************************************************************/
+void qatPerfOffloadStart(qat_perf_offload_t *pProfile);
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Take the end time of the measurement. The cycles that were not
+ *      charged to a phase are charged to idle.
+ *
+ * @param[in]   pProfile                profile to stop
+ *
+ *****************************************************************************/
+void qatPerfOffloadStop(qat_perf_offload_t *pProfile);
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Charge a submission. A submission the ring turned back is idle time,
+ *      the thread only waits for room.
+ *
+ * @param[in]   pProfile                profile
+ * @param[in]   start                   timestamp taken before the submission
+ * @param[in]   status                  status of the submission
+ * @param[in]   bytes                   bytes of the request
+ *
+ *****************************************************************************/
+void qatPerfOffloadSubmit(qat_perf_offload_t *pProfile,
+                          perf_cycles_t start,
+                          CpaStatus status,
+                          Cpa32U bytes);
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Charge a poll. The callbacks it ran are taken out, and a poll that
+ *      returned no response is idle time.
+ *
+ * @param[in]   pProfile                profile
+ * @param[in]   start                   timestamp taken before the poll
+ * @param[in]   responses               responses the poll returned
+ *
+ *****************************************************************************/
+void qatPerfOffloadPoll(qat_perf_offload_t *pProfile,
+                        perf_cycles_t start,
+                        Cpa32U responses);
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Charge a callback, called at the end of the callback
+ *
+ * @param[in]   pProfile                profile
+ * @param[in]   start                   timestamp taken on entry to the
+ *                                      callback
+ *
+ *****************************************************************************/
+void qatPerfOffloadCallback(qat_perf_offload_t *pProfile, perf_cycles_t start);
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Add the profile of one thread to a total
+ *
+ * @param[in,out] pTotal                sum of the profiles
+ * @param[in]     pProfile              profile to add
+ *
+ *****************************************************************************/
+void qatPerfOffloadAdd(qat_perf_offload_t *pTotal,
+                       const qat_perf_offload_t *pProfile);
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Print the header of the table printed by qatPerfOffloadPrint
+ *
+ *****************************************************************************/
+void qatPerfOffloadPrintHeader(void);
+
+/*****************************************************************************
+ * @file qat_perf_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Print one row of the overlap model: the cycles per request of each
+ *      phase, the CPU cycles per byte of the offload and of software, and
+ *      the cycles per byte the offload returns to the application. A
+ *      negative return means software is cheaper at this point.
+ *
+ * @param[in]   pProfile                profile, summed over the threads
+ * @param[in]   requestSize             bytes per request
+ * @param[in]   queueDepth              requests kept in flight
+ *
+ *****************************************************************************/
+void qatPerfOffloadPrint(const qat_perf_offload_t *pProfile,
+                         Cpa32U requestSize,
+                         Cpa32U queueDepth);
+
+#endif /* QAT_PERF_OFFLOAD_H_ */
@@ -60,6 +60,7 @@
 #include "cpa_cy_sym.h"
 #include "cpa_sample_code_framework.h"
 #include "../common/qat_perf_utils.h"
+#include "icp_sal_poll_ctl.h"
 /*
  *******************************************************************************
  * General performance code settings
@@ -324,6 +325,10 @@ typedef struct compression_test_params_s
     /* the Destination Buffer size obtained using
      * Compress Bound API, for Compress operation */
     Cpa32U dcDestBufferSize;
+    /* adaptive inline polling, used when dcPollLatencyNs_g is set */
+    icp_sal_poll_ctl_t pollCtl;
+    Cpa64U pollCtlResponses;
+    Cpa32U pollCtlSubmissions;
 } compression_test_params_t;
 
 /**
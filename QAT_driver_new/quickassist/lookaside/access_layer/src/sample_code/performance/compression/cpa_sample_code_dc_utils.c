@@ -91,6 +91,9 @@ CpaBoolean gRetainPartials = CPA_FALSE;
 EXPORT_SYMBOL(gRetainPartials);
 long dcPollingThreadsInterval_g = DEFAULT_POLL_INTERVAL_NSEC;
 EXPORT_SYMBOL(dcPollingThreadsInterval_g);
+/* Target latency of the adaptive poll controller, 0 for fixed intervals */
+Cpa32U dcPollLatencyNs_g = 0;
+EXPORT_SYMBOL(dcPollLatencyNs_g);
 CpaBoolean disableAdditionalCmpbufferSize_g = CPA_FALSE;
 EXPORT_SYMBOL(disableAdditionalCmpbufferSize_g);
 
@@ -153,6 +156,27 @@ void setDcPollingThreadsInterval(long interval)
 }
 EXPORT_SYMBOL(setDcPollingThreadsInterval);
 
+void setDcPollLatency(Cpa32U targetLatencyNs)
+{
+    dcPollLatencyNs_g = targetLatencyNs;
+}
+EXPORT_SYMBOL(setDcPollLatency);
+
+Cpa64U sampleCodeDcPollCtlNowNs(void)
+{
+    perf_cycles_t cycles = sampleCodeTimestamp();
+    /* kHz, so a cycle count divided by it is in milliseconds */
+    Cpa64U freq = sampleCodeGetCpuFreq();
+
+    if (0 == freq)
+    {
+        return cycles;
+    }
+    return (cycles / freq) * NUM_NANOSEC_IN_MILLISEC +
+           (cycles % freq) * NUM_NANOSEC_IN_MILLISEC / freq;
+}
+EXPORT_SYMBOL(sampleCodeDcPollCtlNowNs);
+
 
 /*********** Call Back Function **************/
 void dcPerformCallback(void *pCallbackTag, CpaStatus status)
@@ -1266,14 +1290,43 @@ CpaStatus sampleCodeDcGetNode(CpaInstanceHandle instanceHandle, Cpa32U *node)
 }
 EXPORT_SYMBOL(sampleCodeDcGetNode);
 
+#ifdef USER_SPACE
+/* Requests completed on the instance, 0 when statistics are disabled */
+static Cpa64U sampleCodeDcCompleted(CpaInstanceHandle instanceHandle)
+{
+    CpaDcStats dcStats = {0};
+
+    if (CPA_STATUS_SUCCESS != cpaDcGetStats(instanceHandle, &dcStats))
+    {
+        return 0;
+    }
+    return dcStats.numCompCompleted + dcStats.numCompCompletedErrors +
+           dcStats.numDecompCompleted + dcStats.numDecompCompletedErrors;
+}
+#endif
+
 /* Change to a compression callback tag with parameter for poll interval */
 void sampleCodeDcPoll(CpaInstanceHandle instanceHandle_in)
 {
     CpaStatus status = CPA_STATUS_FAIL;
 #ifdef USER_SPACE
     struct timespec reqTime, remTime;
+    icp_sal_poll_ctl_t pollCtl;
+    CpaBoolean adaptive = CPA_FALSE;
+    Cpa64U completed = 0;
+    Cpa64U lastCompleted = 0;
+    Cpa64U period = 0;
+    Cpa32U responses = 0;
+
     reqTime.tv_sec = 0;
     reqTime.tv_nsec = dcPollingThreadsInterval_g;
+    if (0 != dcPollLatencyNs_g &&
+        CPA_STATUS_SUCCESS ==
+            icp_sal_PollCtlInit(&pollCtl, dcPollLatencyNs_g, 0, 0, 0))
+    {
+        adaptive = CPA_TRUE;
+        lastCompleted = sampleCodeDcCompleted(instanceHandle_in);
+    }
 #endif
     while (dc_service_started_g == CPA_TRUE)
     {
@@ -1291,6 +1344,21 @@ void sampleCodeDcPoll(CpaInstanceHandle instanceHandle_in)
             break;
         }
 #ifdef USER_SPACE
+        if (CPA_TRUE == adaptive)
+        {
+            /* Without statistics a successful poll counts as one response */
+            completed = sampleCodeDcCompleted(instanceHandle_in);
+            responses = (Cpa32U)(completed - lastCompleted);
+            if (0 == responses && CPA_STATUS_SUCCESS == status)
+            {
+                responses = 1;
+            }
+            lastCompleted = completed;
+            period = icp_sal_PollCtlUpdate(
+                &pollCtl, responses, sampleCodeDcPollCtlNowNs());
+            reqTime.tv_sec = period / NUM_NANOSEC_IN_SEC;
+            reqTime.tv_nsec = period % NUM_NANOSEC_IN_SEC;
+        }
         nanosleep(&reqTime, &remTime);
 #else
         sampleCodeSleepMilliSec(DEFAULT_POLL_INTERVAL_KERNEL);
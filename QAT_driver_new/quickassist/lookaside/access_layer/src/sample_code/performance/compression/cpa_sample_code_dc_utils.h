@@ -88,6 +88,7 @@
 #define OPERATIONS_POLLING_INTERVAL (10)
 
 extern Cpa32U dcPollingInterval_g;
+extern Cpa32U dcPollLatencyNs_g;
 extern CpaBoolean gUseStatefulLite;
 extern CpaDcChecksum gChecksum;
 extern CpaDcAutoSelectBest gAutoSelectBestMode;
@@ -570,6 +571,8 @@ Cpa32U getCorpusFileIndex(void);
 Cpa32U getSetupCnVRequestFlag(void);
 void setSetupCnVRequestFlag(Cpa32U flag);
 void setDcPollingThreadsInterval(long interval);
+void setDcPollLatency(Cpa32U targetLatencyNs);
+Cpa64U sampleCodeDcPollCtlNowNs(void);
 
 /**
  * *****************************************************************************
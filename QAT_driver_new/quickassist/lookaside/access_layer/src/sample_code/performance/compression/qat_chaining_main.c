@@ -78,6 +78,15 @@
 #endif
 
 #include "icp_sal_poll.h"
+#include "icp_sal_dc_chain.h"
+
+/* Largest number of chaining requests submitted in one batch */
+#define DC_CHAIN_MAX_BATCH_SIZE 64
+
+/* Number of chaining requests submitted per call, 1 disables batching */
+Cpa32U dcChainBatchSize_g = 1;
+CpaStatus setDcChainBatchSize(Cpa32U batchSize);
+CpaStatus printDcChainBatchSize(void);
 
 static CpaStatus qatDcChainInduceOverflow(compression_test_params_t *setup,
                                           CpaDcSessionHandle pSessionHandle,
@@ -215,6 +224,138 @@ static CpaStatus checkCrc32Checksum(Cpa8U *inputBuff,
     return CPA_STATUS_SUCCESS;
 }
 
+/*****************************************************************************
+ * @ingroup sampleCompressionPerf
+ *
+ * @description
+ * Set the number of chaining requests submitted per call. Batches are only
+ * used by asynchronous stateless chaining tests
+ * ***************************************************************************/
+CpaStatus setDcChainBatchSize(Cpa32U batchSize)
+{
+    if ((0 == batchSize) || (batchSize > DC_CHAIN_MAX_BATCH_SIZE))
+    {
+        PRINT_ERR("Chaining batch size must be between 1 and %u\n",
+                  DC_CHAIN_MAX_BATCH_SIZE);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    dcChainBatchSize_g = batchSize;
+    return CPA_STATUS_SUCCESS;
+}
+EXPORT_SYMBOL(setDcChainBatchSize);
+
+/*****************************************************************************
+ * @ingroup sampleCompressionPerf
+ *
+ * @description
+ * Print the number of chaining requests submitted per call
+ * ***************************************************************************/
+CpaStatus printDcChainBatchSize(void)
+{
+    PRINT("Compression Chaining Batch Size: %u\n", dcChainBatchSize_g);
+    return CPA_STATUS_SUCCESS;
+}
+EXPORT_SYMBOL(printDcChainBatchSize);
+
+/* Submits the lists [listNum, listNum + numLists) as batches of chaining
+ * requests, retrying until every list is on the ring */
+static CpaStatus qatDcChainSubmitBatch(compression_test_params_t *setup,
+                                       CpaInstanceInfo2 *pInstanceInfo2,
+                                       CpaDcSessionHandle pSessionHandle,
+                                       CpaBufferList *arrayOfSrcBufferLists,
+                                       CpaBufferList *arrayOfDestBufferLists,
+                                       Cpa32U listNum,
+                                       Cpa32U numLists,
+                                       CpaDcChainRqResults *arrayOfResults,
+                                       CpaDcChainOpData *arrayOfChainOpData)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    icp_sal_dc_chain_batch_op_t batchOps[DC_CHAIN_MAX_BATCH_SIZE];
+    Cpa32U numDone = 0;
+    Cpa32U numSubmitted = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < numLists; i++)
+    {
+        batchOps[i].pSrcBuff = &arrayOfSrcBufferLists[listNum + i];
+        batchOps[i].pDestBuff = &arrayOfDestBufferLists[listNum + i];
+        batchOps[i].pChainOpData =
+            &arrayOfChainOpData[(listNum + i) * setup->numSessions];
+        batchOps[i].pResults = &arrayOfResults[listNum + i];
+        batchOps[i].callbackTag = (void *)setup;
+    }
+
+    while (numDone < numLists)
+    {
+        for (i = numDone; i < numLists; i++)
+        {
+            qatStartLatencyMeasurement(setup->performanceStats,
+                                       setup->performanceStats->submissions +
+                                           i);
+        }
+        numSubmitted = 0;
+        status = icp_sal_DcChainPerformOpBatch(setup->dcInstanceHandle,
+                                               pSessionHandle,
+                                               setup->chainOperation,
+                                               setup->numSessions,
+                                               numLists - numDone,
+                                               &batchOps[numDone],
+                                               &numSubmitted);
+        if (CPA_STATUS_RETRY == status)
+        {
+            qatDcRetryHandler(setup, pInstanceInfo2);
+            if ((sleepTime_enable) && (setup->sleepTime != 0))
+            {
+                sleep_parsing(setup->sleepTime);
+            }
+            /*context switch to give firmware time to process*/
+            AVOID_SOFTLOCKUP;
+            continue;
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("icp_sal_DcChainPerformOpBatch returned status: %d\n",
+                      status);
+            break;
+        }
+        numDone += numSubmitted;
+    }
+    return status;
+}
+
+/* Prints where the time of a chained request was spent on the instance */
+static void qatDcChainPrintStageStats(compression_test_params_t *setup)
+{
+    icp_sal_dc_chain_stats_t chainStats = {0};
+
+    if (CPA_STATUS_SUCCESS !=
+        icp_sal_DcChainGetStats(setup->dcInstanceHandle, &chainStats))
+    {
+        return;
+    }
+    if ((0 == chainStats.numRequests) || (0 == chainStats.numCompleted))
+    {
+        return;
+    }
+    PRINT("Chaining requests per submit: %llu\n",
+          (unsigned long long)(chainStats.numRequests /
+                               chainStats.numSubmits));
+    PRINT("Chaining build cycles per request: %llu\n",
+          (unsigned long long)(chainStats.buildCycles /
+                               chainStats.numRequests));
+    PRINT("Chaining submit cycles per request: %llu\n",
+          (unsigned long long)(chainStats.submitCycles /
+                               chainStats.numRequests));
+    PRINT("Chaining device cycles per request: %llu\n",
+          (unsigned long long)(chainStats.deviceCycles /
+                               chainStats.numCompleted));
+    PRINT("Chaining callback cycles per request: %llu\n",
+          (unsigned long long)(chainStats.completeCycles /
+                               chainStats.numCompleted));
+    PRINT("Chaining ring full retries: %llu\n",
+          (unsigned long long)chainStats.numRetries);
+}
+
 CpaStatus qatDcChainSubmitRequest(compression_test_params_t *setup,
                                   CpaInstanceInfo2 *pInstanceInfo2,
                                   CpaDcSessionDir compressDirection,
@@ -303,6 +444,9 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
     Cpa32U numLoops = 0;
     Cpa32U listNum = 0;
     Cpa32U previousChecksum = 0;
+    Cpa32U numInBatch = 1;
+    Cpa32U i = 0;
+    CpaBoolean useBatch = CPA_FALSE;
     sleeptime_data_t sleeptime_data = {0};
     sleeptime_data.firstRunFlag = 1;
 
@@ -326,6 +470,15 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
     QAT_PERF_CHECK_NULL_POINTER_AND_UPDATE_STATUS(arrayOfResults, status);
     QAT_PERF_CHECK_NULL_POINTER_AND_UPDATE_STATUS(arrayOfChainOpData, status);
 
+    /* Requests of a batch are independent, which rules out stateful and
+     * stateful-lite chaining, and only callbacks report their completion */
+    if ((dcChainBatchSize_g > 1) && (ASYNC == setup->syncFlag) &&
+        (CPA_DC_STATEFUL != setup->setupData.sessState) &&
+        (CPA_TRUE != setup->useStatefulLite))
+    {
+        useBatch = CPA_TRUE;
+    }
+
     if (CPA_STATUS_SUCCESS == status)
     {
         status = qatCompressionE2EInit(setup);
@@ -393,16 +546,36 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
                 }
 
                 /*submit request*/
-                status = qatDcChainSubmitRequest(setup,
-                                                 &instanceInfo2,
-                                                 compressDirection,
-                                                 pSessionHandle,
-                                                 arrayOfSrcBufferLists,
-                                                 arrayOfDestBufferLists,
-                                                 arrayOfCmpBufferLists,
-                                                 listNum,
-                                                 arrayOfResults,
-                                                 arrayOfChainOpData);
+                if (CPA_TRUE == useBatch)
+                {
+                    numInBatch = setup->numLists - listNum;
+                    if (numInBatch > dcChainBatchSize_g)
+                    {
+                        numInBatch = dcChainBatchSize_g;
+                    }
+                    status = qatDcChainSubmitBatch(setup,
+                                                   &instanceInfo2,
+                                                   pSessionHandle,
+                                                   arrayOfSrcBufferLists,
+                                                   arrayOfDestBufferLists,
+                                                   listNum,
+                                                   numInBatch,
+                                                   arrayOfResults,
+                                                   arrayOfChainOpData);
+                }
+                else
+                {
+                    status = qatDcChainSubmitRequest(setup,
+                                                     &instanceInfo2,
+                                                     compressDirection,
+                                                     pSessionHandle,
+                                                     arrayOfSrcBufferLists,
+                                                     arrayOfDestBufferLists,
+                                                     arrayOfCmpBufferLists,
+                                                     listNum,
+                                                     arrayOfResults,
+                                                     arrayOfChainOpData);
+                }
                 /* Check submit status and update thread status*/
                 if (CPA_STATUS_SUCCESS != status)
                 {
@@ -413,7 +586,7 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
                     break;
                 }
 
-                setup->performanceStats->submissions++;
+                setup->performanceStats->submissions += numInBatch;
                 qatLatencyPollForResponses(setup->performanceStats,
                                            setup->performanceStats->submissions,
                                            setup->dcInstanceHandle,
@@ -422,8 +595,8 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
                 if (poll_inline_g && instanceInfo2.isPolled)
                 {
                     /*poll every 'n' requests as set by
-                     * dcPollingInterval_g*/
-                    if (setup->performanceStats->submissions ==
+                     * dcPollingInterval_g, a batch may step over it*/
+                    if (setup->performanceStats->submissions >=
                         setup->performanceStats->nextPoll)
                     {
                         qatDcPollAndSetNextPollCounter(setup);
@@ -440,13 +613,14 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
                 {
                     COUNT_RESPONSES;
                 } /* End of SYNC Flag Check */
-                if (CPA_STATUS_SUCCESS == status)
+                for (i = 0; (i < numInBatch) && (CPA_STATUS_SUCCESS == status);
+                     i++)
                 {
-                    status =
-                        qatDcChainE2EVerify(setup,
-                                            &arrayOfSrcBufferLists[listNum],
-                                            &arrayOfDestBufferLists[listNum],
-                                            &arrayOfResults[listNum]);
+                    status = qatDcChainE2EVerify(
+                        setup,
+                        &arrayOfSrcBufferLists[listNum + i],
+                        &arrayOfDestBufferLists[listNum + i],
+                        &arrayOfResults[listNum + i]);
                 }
                 if (CPA_STATUS_SUCCESS != status)
                 {
@@ -455,6 +629,8 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
                               status);
                     break;
                 }
+                /* the loop increment moves past the last list of the batch */
+                listNum += numInBatch - 1;
             }
             /* number of lists/requests in a file */
             if (CPA_STATUS_SUCCESS != status)
@@ -509,6 +685,10 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
          * caught by the callback function*/
         qatDcChainResponseStatusCheck(setup, arrayOfResults, listNum, &status);
         qatSummariseLatencyMeasurements(setup->performanceStats);
+        if ((CPA_STATUS_SUCCESS == status) && (CPA_TRUE == useBatch))
+        {
+            qatDcChainPrintStageStats(setup);
+        }
         sampleCodeSemaphoreDestroy(&setup->performanceStats->comp);
     } /* if semaphoreInit was successful */
     if (CPA_STATUS_SUCCESS != status)
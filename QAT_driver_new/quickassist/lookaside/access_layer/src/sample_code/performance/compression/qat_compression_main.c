@@ -1239,7 +1239,7 @@ CpaStatus qatCompressData(compression_test_params_t *setup,
                 if (poll_inline_g && instanceInfo2->isPolled)
                 {
                     /*poll every 'n' requests as set by
-                     * dcPollingInterval_g*/
+                     * dcPollingInterval_g or the poll controller*/
                     if (setup->performanceStats->submissions ==
                         setup->performanceStats->nextPoll)
                     {
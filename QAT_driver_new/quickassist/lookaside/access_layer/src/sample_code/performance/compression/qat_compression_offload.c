@@ -0,0 +1,616 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_compression_offload.c
+ *
+ * @ingroup sampleCode
+ *
+ * @description
+ *      Offload cost profile of stateless compression. Each performance
+ *      thread keeps a fixed number of requests in flight, polls its instance
+ *      between submissions and charges every cycle to a phase. The sweep
+ *      runs every request size at every queue depth, then compresses the
+ *      same data with zlib to price the software path.
+ *
+ *****************************************************************************/
+
+#include "cpa_sample_code_dc_utils.h"
+#include "cpa_dc.h"
+#include "qat_compression_main.h"
+#include "icp_sal_poll.h"
+#include "qat_perf_utils.h"
+#include "qat_perf_offload.h"
+#include "qat_compression_zlib.h"
+#include "qat_compression_offload.h"
+
+static const Cpa32U dcOffloadSizes_g[] = {1024,
+                                          4 * 1024,
+                                          16 * 1024,
+                                          DC_OFFLOAD_MAX_REQUEST_BYTES};
+static const Cpa32U dcOffloadDepths_g[] = {1, 4, 16, DC_OFFLOAD_MAX_DEPTH};
+
+#define DC_OFFLOAD_NUM_SIZES                                                   \
+    (sizeof(dcOffloadSizes_g) / sizeof(dcOffloadSizes_g[0]))
+#define DC_OFFLOAD_NUM_DEPTHS                                                  \
+    (sizeof(dcOffloadDepths_g) / sizeof(dcOffloadDepths_g[0]))
+
+struct dc_offload_ctx_s;
+
+/* callback tag of a request, one per buffer */
+typedef struct dc_offload_slot_s
+{
+    struct dc_offload_ctx_s *pCtx;
+    Cpa32U slot;
+} dc_offload_slot_t;
+
+/* the callbacks run on the thread that submits, so nothing here is locked */
+typedef struct dc_offload_ctx_s
+{
+    compression_test_params_t *setup;
+    CpaDcRqResults *results;
+    qat_perf_offload_t *pProfile;
+    dc_offload_slot_t slots[DC_OFFLOAD_MAX_DEPTH];
+    Cpa32U freeSlots[DC_OFFLOAD_MAX_DEPTH];
+    Cpa32U numFree;
+} dc_offload_ctx_t;
+
+/* profiles of all the threads, added up as the threads finish */
+static qat_perf_offload_t dcOffloadTotal_g[DC_OFFLOAD_NUM_SIZES]
+                                          [DC_OFFLOAD_NUM_DEPTHS];
+static sample_code_thread_mutex_t dcOffloadMutex_g;
+
+CpaStatus setupDcOffloadTest(CpaDcCompType algorithm,
+                             CpaDcCompLvl compLevel,
+                             CpaDcHuffType huffmanType,
+                             corpus_type_t corpusType)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    /* the callbacks must run on the thread that submits, so no polling
+     * thread is started for this test */
+    poll_inline_g = CPA_TRUE;
+    memset(dcOffloadTotal_g, 0, sizeof(dcOffloadTotal_g));
+    sample_code_thread_mutex_init(&dcOffloadMutex_g);
+
+    status = setupDcTest(algorithm,
+                         CPA_DC_DIR_COMPRESS,
+                         compLevel,
+                         huffmanType,
+                         CPA_DC_STATELESS,
+                         DEFAULT_COMPRESSION_WINDOW_SIZE,
+                         DC_OFFLOAD_MAX_REQUEST_BYTES,
+                         corpusType,
+                         ASYNC,
+                         1);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        testSetupData_g[testTypeCount_g].performance_function =
+            (performance_func_t)dcOffloadPerformance;
+    }
+    return status;
+}
+EXPORT_SYMBOL(setupDcOffloadTest);
+
+static void dcOffloadCallback(void *pCallbackTag, CpaStatus status)
+{
+    perf_cycles_t start = sampleCodeTimestamp();
+    dc_offload_slot_t *pSlot = (dc_offload_slot_t *)pCallbackTag;
+    dc_offload_ctx_t *pCtx = pSlot->pCtx;
+    perf_data_t *pPerfData = pCtx->setup->performanceStats;
+    CpaDcRqResults *pResults = &pCtx->results[pSlot->slot];
+
+    if (CPA_STATUS_SUCCESS != status || CPA_DC_OK != pResults->status)
+    {
+        PRINT_ERR("Offload request failed, status %d, dc status %d\n",
+                  status,
+                  pResults->status);
+        pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+    }
+    pPerfData->bytesConsumedPerLoop += pResults->consumed;
+    pPerfData->bytesProducedPerLoop += pResults->produced;
+    pCtx->freeSlots[pCtx->numFree++] = pSlot->slot;
+    pPerfData->responses++;
+    qatPerfOffloadCallback(pCtx->pProfile, start);
+}
+
+/* Keep depth requests of size bytes in flight until numRequests are done */
+static CpaStatus dcOffloadRun(dc_offload_ctx_t *pCtx,
+                              CpaDcSessionHandle pSessionHandle,
+                              CpaBufferList *srcBufferListArray,
+                              CpaBufferList *destBufferListArray,
+                              Cpa32U size,
+                              Cpa32U depth,
+                              Cpa32U numRequests,
+                              qat_perf_offload_t *pProfile)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    compression_test_params_t *setup = pCtx->setup;
+    perf_data_t *pPerfData = setup->performanceStats;
+    Cpa64U lastResponse = pPerfData->responses + numRequests;
+    Cpa64U responses = 0;
+    Cpa32U destSize = destBufferListArray[0].pBuffers[0].dataLenInBytes;
+    Cpa32U submitted = 0;
+    Cpa32U slot = 0;
+    perf_cycles_t start = 0;
+
+    pCtx->pProfile = pProfile;
+    qatPerfOffloadStart(pProfile);
+    while (pPerfData->responses < lastResponse &&
+           CPA_STATUS_SUCCESS == pPerfData->threadReturnStatus)
+    {
+        if (submitted < numRequests &&
+            DC_OFFLOAD_MAX_DEPTH - pCtx->numFree < depth)
+        {
+            slot = pCtx->freeSlots[--pCtx->numFree];
+            srcBufferListArray[slot].pBuffers[0].dataLenInBytes = size;
+            destBufferListArray[slot].pBuffers[0].dataLenInBytes = destSize;
+            pCtx->results[slot].checksum =
+                (CPA_DC_ADLER32 == setup->setupData.checksum) ? 1 : 0;
+            start = sampleCodeTimestamp();
+            status = cpaDcCompressData2(setup->dcInstanceHandle,
+                                        pSessionHandle,
+                                        &srcBufferListArray[slot],
+                                        &destBufferListArray[slot],
+                                        &setup->requestOps,
+                                        &pCtx->results[slot],
+                                        &pCtx->slots[slot]);
+            qatPerfOffloadSubmit(pProfile, start, status, size);
+            if (CPA_STATUS_SUCCESS == status)
+            {
+                submitted++;
+                pPerfData->submissions++;
+                continue;
+            }
+            pCtx->freeSlots[pCtx->numFree++] = slot;
+            if (CPA_STATUS_RETRY != status)
+            {
+                PRINT_ERR("Data Compression Failed %d\n\n", status);
+                break;
+            }
+            pPerfData->retries++;
+        }
+
+        /* the queue is full or the ring turned the request back */
+        responses = pPerfData->responses;
+        start = sampleCodeTimestamp();
+        status = icp_sal_DcPollInstance(setup->dcInstanceHandle, 0);
+        qatPerfOffloadPoll(
+            pProfile, start, (Cpa32U)(pPerfData->responses - responses));
+        if (CPA_STATUS_SUCCESS != status && CPA_STATUS_RETRY != status)
+        {
+            PRINT_ERR("Error polling instance %d\n", status);
+            break;
+        }
+        status = CPA_STATUS_SUCCESS;
+        if (CPA_TRUE == stopTestsIsEnabled_g && CPA_TRUE == exitLoopFlag_g)
+        {
+            break;
+        }
+    }
+    qatPerfOffloadStop(pProfile);
+
+    if (CPA_STATUS_SUCCESS != pPerfData->threadReturnStatus)
+    {
+        status = CPA_STATUS_FAIL;
+    }
+    /* collect what is still in flight before the buffers are reused */
+    if (CPA_STATUS_SUCCESS !=
+        dcPollNumOperations(
+            pPerfData, setup->dcInstanceHandle, pPerfData->submissions))
+    {
+        PRINT_ERR("dcPollNumOperations returned an error\n");
+        status = CPA_STATUS_FAIL;
+    }
+    return status;
+}
+
+/* Price the software path: cycles zlib takes to compress size bytes */
+static CpaStatus dcOffloadSoftware(CpaBufferList *srcBufferListArray,
+                                   CpaBufferList *destBufferListArray,
+                                   Cpa32U size,
+                                   qat_perf_offload_t *pProfile)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    struct z_stream_s stream = {0};
+    Cpa32U destSize = destBufferListArray[0].pBuffers[0].dataLenInBytes;
+    Cpa32U i = 0;
+    perf_cycles_t start = 0;
+
+    for (i = 0; i < DC_OFFLOAD_SW_REQUESTS; i++)
+    {
+        memset(&stream, 0, sizeof(struct z_stream_s));
+        status = deflate_init(&stream);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+        /* a software user keeps its stream, so set up is not charged */
+        start = sampleCodeTimestamp();
+        status = deflate_compress(&stream,
+                                  srcBufferListArray[0].pBuffers[0].pData,
+                                  size,
+                                  destBufferListArray[0].pBuffers[0].pData,
+                                  destSize,
+                                  Z_FINISH);
+        pProfile->swCycles += sampleCodeTimestamp() - start;
+        pProfile->swBytes += size;
+        deflate_destroy(&stream);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("Software compression of %u bytes failed\n", size);
+            break;
+        }
+    }
+    return status;
+}
+
+static CpaStatus dcOffloadSweep(compression_test_params_t *setup)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaBufferList *srcBufferListArray = NULL;
+    CpaBufferList *destBufferListArray = NULL;
+    CpaBufferList *cmpBufferListArray = NULL;
+    CpaDcRqResults *resultArray = NULL;
+    CpaDcSessionHandle pSessionHandle = NULL;
+    CpaDcSessionHandle pDecompressSessionHandle = NULL;
+    CpaBufferList contextBuffer = {0};
+    perf_data_t *pPerfData = setup->performanceStats;
+    const corpus_file_t *const fileArray = getFilesInCorpus(setup->corpus);
+    qat_perf_offload_t profiles[DC_OFFLOAD_NUM_SIZES][DC_OFFLOAD_NUM_DEPTHS];
+    qat_perf_offload_t warmup = {0};
+    dc_offload_ctx_t *pCtx = NULL;
+    Cpa32U *bufferSizes = setup->packetSizeInBytesArray;
+    Cpa32U slot = 0;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+
+    pCtx = qaeMemAlloc(sizeof(dc_offload_ctx_t));
+    if (NULL == pCtx)
+    {
+        PRINT_ERR("Unable to allocate memory for the offload context\n");
+        pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+        sampleCodeBarrier();
+        return CPA_STATUS_FAIL;
+    }
+    memset(pCtx, 0, sizeof(dc_offload_ctx_t));
+    memset(profiles, 0, sizeof(profiles));
+    pCtx->setup = setup;
+    for (slot = 0; slot < DC_OFFLOAD_MAX_DEPTH; slot++)
+    {
+        pCtx->slots[slot].pCtx = pCtx;
+        pCtx->slots[slot].slot = slot;
+        pCtx->freeSlots[slot] = slot;
+    }
+    pCtx->numFree = DC_OFFLOAD_MAX_DEPTH;
+
+    status = qatAllocateCompressionLists(setup,
+                                         &srcBufferListArray,
+                                         &destBufferListArray,
+                                         &cmpBufferListArray,
+                                         &resultArray);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pCtx->results = resultArray;
+        status = qatAllocateCompressionFlatBuffers(setup,
+                                                   srcBufferListArray,
+                                                   1,
+                                                   bufferSizes,
+                                                   destBufferListArray,
+                                                   1,
+                                                   bufferSizes,
+                                                   cmpBufferListArray,
+                                                   1,
+                                                   bufferSizes);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("could not allocate all flat buffers for compression\n");
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = PopulateBuffers(
+            srcBufferListArray,
+            setup->numLists,
+            fileArray[setup->corpusFileIndex].corpusBinaryData,
+            fileArray[setup->corpusFileIndex].corpusBinaryDataLen,
+            bufferSizes);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = qatCompressionSessionInit(setup,
+                                           &pSessionHandle,
+                                           &pDecompressSessionHandle,
+                                           &contextBuffer,
+                                           dcOffloadCallback);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("compressionSessionInit returned status %d\n", status);
+        }
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+        sampleCodeBarrier();
+        goto cleanup;
+    }
+
+    setup->requestOps.flushFlag = CPA_DC_FLUSH_FINAL;
+    sampleCodeBarrier();
+    pPerfData->startCyclesTimestamp = sampleCodeTimestamp();
+    status = dcOffloadRun(pCtx,
+                          pSessionHandle,
+                          srcBufferListArray,
+                          destBufferListArray,
+                          DC_OFFLOAD_MAX_REQUEST_BYTES,
+                          DC_OFFLOAD_MAX_DEPTH,
+                          DC_OFFLOAD_WARMUP_REQUESTS,
+                          &warmup);
+    for (i = 0; i < DC_OFFLOAD_NUM_SIZES && CPA_STATUS_SUCCESS == status; i++)
+    {
+        for (j = 0; j < DC_OFFLOAD_NUM_DEPTHS && CPA_STATUS_SUCCESS == status;
+             j++)
+        {
+            status = dcOffloadRun(pCtx,
+                                  pSessionHandle,
+                                  srcBufferListArray,
+                                  destBufferListArray,
+                                  dcOffloadSizes_g[i],
+                                  dcOffloadDepths_g[j],
+                                  DC_OFFLOAD_REQUESTS,
+                                  &profiles[i][j]);
+        }
+    }
+    pPerfData->endCyclesTimestamp = sampleCodeTimestamp();
+    pPerfData->numOperations = pPerfData->submissions;
+
+    /* the software baseline is the same at every depth */
+    for (i = 0; i < DC_OFFLOAD_NUM_SIZES && CPA_STATUS_SUCCESS == status; i++)
+    {
+        status = dcOffloadSoftware(srcBufferListArray,
+                                   destBufferListArray,
+                                   dcOffloadSizes_g[i],
+                                   &profiles[i][0]);
+        for (j = 1; j < DC_OFFLOAD_NUM_DEPTHS; j++)
+        {
+            profiles[i][j].swCycles = profiles[i][0].swCycles;
+            profiles[i][j].swBytes = profiles[i][0].swBytes;
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        sample_code_thread_mutex_lock(&dcOffloadMutex_g);
+        for (i = 0; i < DC_OFFLOAD_NUM_SIZES; i++)
+        {
+            for (j = 0; j < DC_OFFLOAD_NUM_DEPTHS; j++)
+            {
+                qatPerfOffloadAdd(&dcOffloadTotal_g[i][j], &profiles[i][j]);
+            }
+        }
+        sample_code_thread_mutex_unlock(&dcOffloadMutex_g);
+    }
+
+cleanup:
+    if (NULL != pSessionHandle &&
+        CPA_STATUS_SUCCESS !=
+            qatCompressionSessionTeardown(
+                setup, &pSessionHandle, &pDecompressSessionHandle))
+    {
+        PRINT_ERR("compressionSessionTeardown error\n");
+        status = CPA_STATUS_FAIL;
+    }
+    if (NULL != srcBufferListArray)
+    {
+        qatFreeCompressionFlatBuffers(
+            setup, srcBufferListArray, destBufferListArray, cmpBufferListArray);
+        qatFreeFlatBuffersInList(&contextBuffer);
+        qatFreeCompressionLists(setup,
+                                &srcBufferListArray,
+                                &destBufferListArray,
+                                &cmpBufferListArray,
+                                &resultArray);
+    }
+    qaeMemFree((void **)&pCtx);
+    return status;
+}
+
+void dcOffloadPerformance(single_thread_test_data_t *testSetup)
+{
+    compression_test_params_t dcSetup = {0};
+    compression_test_params_t *tmpSetup = NULL;
+    CpaInstanceHandle *instances = NULL;
+    CpaInstanceInfo2 instanceInfo2 = {0};
+    Cpa16U numInstances = 0;
+    CpaStatus status = CPA_STATUS_FAIL;
+    perf_data_t *pPerfData = testSetup->performanceStats;
+
+    tmpSetup = (compression_test_params_t *)(testSetup->setupPtr);
+    testSetup->passCriteria = tmpSetup->passCriteria;
+    dcSetup.passCriteria = tmpSetup->passCriteria;
+    memcpy(&dcSetup.requestOps, &tmpSetup->requestOps, sizeof(CpaDcOpData));
+    dcSetup.corpus = tmpSetup->corpus;
+    dcSetup.corpusFileIndex = tmpSetup->corpusFileIndex;
+    dcSetup.setupData = tmpSetup->setupData;
+    dcSetup.dcSessDir = CPA_DC_DIR_COMPRESS;
+    dcSetup.syncFlag = ASYNC;
+    dcSetup.numLoops = 1;
+    dcSetup.numLists = DC_OFFLOAD_MAX_DEPTH;
+    dcSetup.bufferSize = DC_OFFLOAD_MAX_REQUEST_BYTES;
+    dcSetup.isDpApi = CPA_FALSE;
+    dcSetup.disableAdditionalCmpbufferSize = CPA_TRUE;
+    dcSetup.threadID = testSetup->threadID;
+    dcSetup.performanceStats = pPerfData;
+    pPerfData->averagePacketSizeInBytes = testSetup->packetSize;
+    pPerfData->numLoops = 1;
+    pPerfData->threadReturnStatus = CPA_STATUS_SUCCESS;
+    pPerfData->additionalStatus = CPA_STATUS_SUCCESS;
+
+    status = allocateAndSetArrayOfPacketSizes(&dcSetup.packetSizeInBytesArray,
+                                              DC_OFFLOAD_MAX_REQUEST_BYTES,
+                                              dcSetup.numLists);
+
+    /* released by startThreads, same as dcPerformance */
+    startBarrier();
+    testSetup->statsPrintFunc = NULL;
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+
+    status = cpaDcGetNumInstances(&numInstances);
+    if (CPA_STATUS_SUCCESS != status || 0 == numInstances)
+    {
+        PRINT_ERR(" DC Instances are not present\n");
+        status = CPA_STATUS_FAIL;
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+    instances = qaeMemAlloc(sizeof(CpaInstanceHandle) * numInstances);
+    if (NULL == instances)
+    {
+        PRINT_ERR("Unable to allocate Memory for Instances\n");
+        status = CPA_STATUS_FAIL;
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+    status = cpaDcGetInstances(numInstances, instances);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR(" Unable to get DC instances\n");
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+    dcSetup.dcInstanceHandle =
+        instances[(testSetup->logicalQaInstance) % numInstances];
+    status = sampleCodeDcGetNode(dcSetup.dcInstanceHandle, &dcSetup.node);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcInstanceGetInfo2(dcSetup.dcInstanceHandle,
+                                       &instanceInfo2);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Unable to get the DC instance info\n");
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+    if (!instanceInfo2.isPolled)
+    {
+        PRINT_ERR("The offload profile needs a polled instance\n");
+        status = CPA_STATUS_FAIL;
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+
+    status = dcOffloadSweep(&dcSetup);
+
+err:
+    if (CPA_STATUS_SUCCESS == status &&
+        CPA_STATUS_SUCCESS == pPerfData->threadReturnStatus)
+    {
+        testSetup->statsPrintFunc = (stats_print_func_t)dcOffloadPrintStats;
+    }
+    else
+    {
+        PRINT_ERR("Compression Thread %u FAILED\n", testSetup->threadID);
+        pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+        testSetup->statsPrintFunc =
+            (stats_print_func_t)stopDcServicesFromPrintStats;
+    }
+    if (NULL != dcSetup.packetSizeInBytesArray)
+    {
+        qaeMemFree((void **)&dcSetup.packetSizeInBytesArray);
+    }
+    if (NULL != instances)
+    {
+        qaeMemFree((void **)&instances);
+    }
+    sampleCodeThreadComplete(testSetup->threadID);
+}
+EXPORT_SYMBOL(dcOffloadPerformance);
+
+CpaStatus dcOffloadPrintStats(thread_creation_data_t *data)
+{
+    perf_data_t stats = {0};
+    perf_data_t *pThreadStats = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+
+    status = stopDcServices();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Unable to stop DC services\n");
+        return status;
+    }
+
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        pThreadStats = data->performanceStats[i];
+        if (CPA_STATUS_SUCCESS != pThreadStats->threadReturnStatus)
+        {
+            status = CPA_STATUS_FAIL;
+        }
+        stats.responses += pThreadStats->responses;
+        stats.retries += pThreadStats->retries;
+        clearPerfStats(pThreadStats);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        sample_code_thread_mutex_destroy(&dcOffloadMutex_g);
+        return status;
+    }
+
+    dcPrintTestData((compression_test_params_t *)data->setupPtr);
+    PRINT("Number of threads      %d\n", data->numberOfThreads);
+    PRINT("Total Responses        %llu\n", (unsigned long long)stats.responses);
+    PRINT("Total Retries          %llu\n", (unsigned long long)stats.retries);
+    PRINT("CPU Frequency(kHz)     %llu\n",
+          (unsigned long long)sampleCodeGetCpuFreq());
+    PRINT("Cycles per request, CPU, software, idle and gained cycles per "
+          "byte\n");
+    qatPerfOffloadPrintHeader();
+    for (i = 0; i < DC_OFFLOAD_NUM_SIZES; i++)
+    {
+        for (j = 0; j < DC_OFFLOAD_NUM_DEPTHS; j++)
+        {
+            qatPerfOffloadPrint(&dcOffloadTotal_g[i][j],
+                                dcOffloadSizes_g[i],
+                                dcOffloadDepths_g[j]);
+        }
+    }
+    sample_code_thread_mutex_destroy(&dcOffloadMutex_g);
+    return status;
+}
+EXPORT_SYMBOL(dcOffloadPrintStats);
@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_compression_offload.h
+ *
+ * @ingroup sampleCode
+ *
+ * @description                 This module profiles the CPU cost of
+ *                              offloading stateless compression. Every
+ *                              thread sweeps a set of request sizes and
+ *                              queue depths, polls its instance inline and
+ *                              splits the cycles it spends between submit,
+ *                              poll, callback and idle with the profiler of
+ *                              qat_perf_offload.h. The same requests are
+ *                              compressed in software to give the cycles
+ *                              the offload saves the application.
+ *
+ *****************************************************************************/
+
+#ifndef QAT_COMPRESSION_OFFLOAD_H_
+#define QAT_COMPRESSION_OFFLOAD_H_
+
+#include "cpa_sample_code_dc_perf.h"
+
+/* Requests measured at each size and depth, per thread */
+#define DC_OFFLOAD_REQUESTS (1024)
+/* Requests sent before the sweep to warm the caches and the ring */
+#define DC_OFFLOAD_WARMUP_REQUESTS (128)
+/* Requests compressed in software at each size, per thread */
+#define DC_OFFLOAD_SW_REQUESTS (32)
+/* Deepest queue of the sweep, one buffer per request in flight */
+#define DC_OFFLOAD_MAX_DEPTH (64)
+/* Largest request of the sweep */
+#define DC_OFFLOAD_MAX_REQUEST_BYTES (64 * 1024)
+
+/**
+ *****************************************************************************
+ * @file qat_compression_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description                 register the offload cost profile with the
+ *                              framework. Inline polling is turned on, the
+ *                              profile needs the callbacks to run on the
+ *                              thread that submits.
+ *
+ * @param[in]   algorithm       compression algorithm
+ * @param[in]   compLevel       compression level
+ * @param[in]   huffmanType     static or dynamic Huffman trees
+ * @param[in]   corpusType      corpus the request data is taken from
+ *
+ * @pre                         DC services can be started
+ *
+ * @post                        the test is ready to be started with
+ *                              createStartandWaitForCompletion
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully
+ *
+ * @retval CPA_STATUS_FAIL      the test could not be registered
+ ****************************************************************************/
+CpaStatus setupDcOffloadTest(CpaDcCompType algorithm,
+                             CpaDcCompLvl compLevel,
+                             CpaDcHuffType huffmanType,
+                             corpus_type_t corpusType);
+
+/**
+ *****************************************************************************
+ * @file qat_compression_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description                 performance thread of the offload cost
+ *                              profile, started by the framework on each
+ *                              instance
+ *
+ * @param[in]   testSetup       framework data of the thread
+ ****************************************************************************/
+void dcOffloadPerformance(single_thread_test_data_t *testSetup);
+
+/**
+ *****************************************************************************
+ * @file qat_compression_offload.h
+ *
+ * @ingroup sample_code
+ *
+ * @description                 print the cycles of each phase per request
+ *                              and the overlap model at every size and
+ *                              depth, summed over the threads
+ *
+ * @param[in]   data            framework data of the test
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully
+ *
+ * @retval CPA_STATUS_FAIL      a thread failed or services did not stop
+ ****************************************************************************/
+CpaStatus dcOffloadPrintStats(thread_creation_data_t *data);
+
+#endif /* QAT_COMPRESSION_OFFLOAD_H_ */
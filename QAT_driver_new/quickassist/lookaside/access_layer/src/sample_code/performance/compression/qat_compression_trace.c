@@ -0,0 +1,839 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_compression_trace.c
+ *
+ * @ingroup sampleCode
+ *
+ * @description
+ *      Trace driven stateless compression test. Each performance thread
+ *      loads a trace, submits its requests at the times the trace gives them
+ *      from a pool of DC_TRACE_MAX_INFLIGHT buffers and stamps every request
+ *      with the time it was due and the time its response arrived. When the
+ *      pool is empty or the ring is full the request waits, and the wait
+ *      counts towards its latency as it would for the tenant.
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "cpa_sample_code_dc_utils.h"
+#include "cpa_dc.h"
+#include "qat_compression_main.h"
+#include "icp_sal_poll.h"
+#include "qat_perf_utils.h"
+#include "qat_compression_trace.h"
+
+#define DC_TRACE_USEC_PER_MSEC (1000)
+/* Sleep rather than spin when the next request is further away than this */
+#define DC_TRACE_SLEEP_THRESHOLD_US (200)
+
+typedef struct dc_trace_request_s
+{
+    perf_cycles_t due;
+    /* cycles from the start of the test */
+    Cpa32U bytes;
+} dc_trace_request_t;
+
+struct dc_trace_ctx_s;
+
+/* callback tag of a request, one per buffer of the pool */
+typedef struct dc_trace_slot_s
+{
+    struct dc_trace_ctx_s *pCtx;
+    Cpa32U slot;
+    Cpa32U request;
+} dc_trace_slot_t;
+
+typedef struct dc_trace_ctx_s
+{
+    compression_test_params_t *setup;
+    CpaDcRqResults *results;
+    dc_trace_slot_t slots[DC_TRACE_MAX_INFLIGHT];
+    Cpa32U freeSlots[DC_TRACE_MAX_INFLIGHT];
+    volatile Cpa32U numFree;
+    sample_code_thread_mutex_t mutex;
+} dc_trace_ctx_t;
+
+static char dcTraceFile_g[DC_TRACE_MAX_PATH_LEN] = {0};
+static Cpa32U dcTraceNumFiles_g = 0;
+static Cpa32U dcTraceBytesPerUnit_g = DC_TRACE_DEFAULT_BYTES_PER_UNIT;
+
+/* Name of the trace replayed by a thread, fails if it does not fit */
+static CpaStatus dcTraceFileName(Cpa32U threadId, char *name, Cpa32U len)
+{
+    int written = 0;
+
+    if (0 == dcTraceNumFiles_g)
+    {
+        written = snprintf(name, len, "%s", dcTraceFile_g);
+    }
+    else
+    {
+        written = snprintf(name,
+                           len,
+                           "%s%u",
+                           dcTraceFile_g,
+                           (threadId % dcTraceNumFiles_g) + 1);
+    }
+    if (written < 0 || (Cpa32U)written >= len)
+    {
+        PRINT_ERR("Trace file name %s too long\n", dcTraceFile_g);
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Read a trace into an array of requests, due times are in cycles */
+static CpaStatus dcTraceLoad(const char *name,
+                             dc_trace_request_t **ppRequests,
+                             Cpa32U *pNumRequests,
+                             Cpa32U *pMaxBytes)
+{
+    dc_trace_request_t *pRequests = NULL;
+    Cpa32U numRequests = 0;
+    Cpa32U workSize = 0;
+    Cpa32U intervalUs = 0;
+    Cpa64U dueUs = 0;
+    Cpa64U totalBytes = 0;
+    Cpa64U bytes = 0;
+    Cpa64U freqKHz = sampleCodeGetCpuFreq();
+    FILE *pFile = NULL;
+
+    pFile = fopen(name, "r");
+    if (NULL == pFile)
+    {
+        PRINT_ERR("Cannot open trace %s\n", name);
+        return CPA_STATUS_FAIL;
+    }
+    while (2 == fscanf(pFile, "%u %u", &workSize, &intervalUs))
+    {
+        numRequests++;
+    }
+    if (0 == numRequests)
+    {
+        PRINT_ERR("Trace %s holds no request\n", name);
+        fclose(pFile);
+        return CPA_STATUS_FAIL;
+    }
+    pRequests = qaeMemAlloc(numRequests * sizeof(dc_trace_request_t));
+    if (NULL == pRequests)
+    {
+        PRINT_ERR("Unable to allocate memory for trace %s\n", name);
+        fclose(pFile);
+        return CPA_STATUS_FAIL;
+    }
+
+    rewind(pFile);
+    *pMaxBytes = 0;
+    *pNumRequests = 0;
+    while (*pNumRequests < numRequests &&
+           2 == fscanf(pFile, "%u %u", &workSize, &intervalUs))
+    {
+        bytes = (Cpa64U)workSize * dcTraceBytesPerUnit_g;
+        if (0 == bytes)
+        {
+            bytes = 1;
+        }
+        if (bytes > DC_TRACE_MAX_REQUEST_BYTES)
+        {
+            bytes = DC_TRACE_MAX_REQUEST_BYTES;
+        }
+        /* the per thread byte counters of the framework are 32 bits wide */
+        if (totalBytes + bytes > 0xFFFFFFFFULL)
+        {
+            PRINT("Trace %s truncated to %u requests\n", name, *pNumRequests);
+            break;
+        }
+        totalBytes += bytes;
+        dueUs += intervalUs;
+        pRequests[*pNumRequests].due =
+            dueUs * freqKHz / DC_TRACE_USEC_PER_MSEC;
+        pRequests[*pNumRequests].bytes = (Cpa32U)bytes;
+        if (bytes > *pMaxBytes)
+        {
+            *pMaxBytes = (Cpa32U)bytes;
+        }
+        (*pNumRequests)++;
+    }
+    fclose(pFile);
+    *ppRequests = pRequests;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus setupDcTraceTest(CpaDcCompType algorithm,
+                           CpaDcCompLvl compLevel,
+                           CpaDcHuffType huffmanType,
+                           corpus_type_t corpusType,
+                           const char *traceFile,
+                           Cpa32U bytesPerUnit)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    dc_trace_request_t *pRequests = NULL;
+    char name[DC_TRACE_MAX_PATH_LEN] = {0};
+    struct stat traceStat;
+    Cpa32U numRequests = 0;
+    Cpa32U maxBytes = 0;
+    Cpa32U bufferSize = 0;
+    Cpa32U i = 0;
+
+    if (NULL == traceFile ||
+        strlen(traceFile) + sizeof("4294967295") > sizeof(dcTraceFile_g))
+    {
+        PRINT_ERR("Invalid trace file name\n");
+        return CPA_STATUS_FAIL;
+    }
+    snprintf(dcTraceFile_g, sizeof(dcTraceFile_g), "%s", traceFile);
+    dcTraceBytesPerUnit_g =
+        (0 == bytesPerUnit) ? DC_TRACE_DEFAULT_BYTES_PER_UNIT : bytesPerUnit;
+
+    /* a file is replayed by every thread, a prefix names numbered traces */
+    dcTraceNumFiles_g = 0;
+    if (0 != stat(traceFile, &traceStat) || !S_ISREG(traceStat.st_mode))
+    {
+        for (;;)
+        {
+            snprintf(
+                name, sizeof(name), "%s%u", traceFile, dcTraceNumFiles_g + 1);
+            if (0 != stat(name, &traceStat) || !S_ISREG(traceStat.st_mode))
+            {
+                break;
+            }
+            dcTraceNumFiles_g++;
+        }
+        if (0 == dcTraceNumFiles_g)
+        {
+            PRINT_ERR("Cannot find trace %s or %s1\n", traceFile, traceFile);
+            return CPA_STATUS_FAIL;
+        }
+    }
+
+    /* size the registered buffer to the largest request of all traces */
+    for (i = 0; i < (dcTraceNumFiles_g ? dcTraceNumFiles_g : 1); i++)
+    {
+        status = dcTraceFileName(i, name, sizeof(name));
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = dcTraceLoad(name, &pRequests, &numRequests, &maxBytes);
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return CPA_STATUS_FAIL;
+        }
+        qaeMemFree((void **)&pRequests);
+        if (maxBytes > bufferSize)
+        {
+            bufferSize = maxBytes;
+        }
+    }
+    PRINT("Replaying %s%s (%u trace%s, %u bytes per unit)\n",
+          traceFile,
+          dcTraceNumFiles_g ? "<n>" : "",
+          dcTraceNumFiles_g ? dcTraceNumFiles_g : 1,
+          dcTraceNumFiles_g > 1 ? "s" : "",
+          dcTraceBytesPerUnit_g);
+
+    status = setupDcTest(algorithm,
+                         CPA_DC_DIR_COMPRESS,
+                         compLevel,
+                         huffmanType,
+                         CPA_DC_STATELESS,
+                         DEFAULT_COMPRESSION_WINDOW_SIZE,
+                         bufferSize,
+                         corpusType,
+                         ASYNC,
+                         1);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        testSetupData_g[testTypeCount_g].performance_function =
+            (performance_func_t)dcTracePerformance;
+    }
+    return status;
+}
+EXPORT_SYMBOL(setupDcTraceTest);
+
+static void dcTraceCallback(void *pCallbackTag, CpaStatus status)
+{
+    dc_trace_slot_t *pSlot = (dc_trace_slot_t *)pCallbackTag;
+    dc_trace_ctx_t *pCtx = pSlot->pCtx;
+    perf_data_t *pPerfData = pCtx->setup->performanceStats;
+    CpaDcRqResults *pResults = &pCtx->results[pSlot->slot];
+
+    pPerfData->response_times[pSlot->request] = sampleCodeTimestamp();
+    if (CPA_STATUS_SUCCESS != status || CPA_DC_OK != pResults->status)
+    {
+        PRINT_ERR("Trace request %u failed, status %d, dc status %d\n",
+                  pSlot->request,
+                  status,
+                  pResults->status);
+        pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+    }
+
+    sample_code_thread_mutex_lock(&pCtx->mutex);
+    pPerfData->bytesConsumedPerLoop += pResults->consumed;
+    pPerfData->bytesProducedPerLoop += pResults->produced;
+    pCtx->freeSlots[pCtx->numFree++] = pSlot->slot;
+    pPerfData->responses++;
+    if (pPerfData->responses >= pPerfData->numOperations)
+    {
+        pPerfData->endCyclesTimestamp = sampleCodeTimestamp();
+        sampleCodeSemaphorePost(&pPerfData->comp);
+    }
+    sample_code_thread_mutex_unlock(&pCtx->mutex);
+}
+
+/* Take a buffer of the pool, DC_TRACE_MAX_INFLIGHT when all are in flight */
+static Cpa32U dcTraceGetSlot(dc_trace_ctx_t *pCtx)
+{
+    Cpa32U slot = DC_TRACE_MAX_INFLIGHT;
+
+    sample_code_thread_mutex_lock(&pCtx->mutex);
+    if (pCtx->numFree > 0)
+    {
+        slot = pCtx->freeSlots[--pCtx->numFree];
+    }
+    sample_code_thread_mutex_unlock(&pCtx->mutex);
+    return slot;
+}
+
+static void dcTracePutSlot(dc_trace_ctx_t *pCtx, Cpa32U slot)
+{
+    sample_code_thread_mutex_lock(&pCtx->mutex);
+    pCtx->freeSlots[pCtx->numFree++] = slot;
+    sample_code_thread_mutex_unlock(&pCtx->mutex);
+}
+
+/* Let the responses come in while the thread has nothing to submit */
+static void dcTraceIdle(compression_test_params_t *setup,
+                        CpaBoolean pollInline,
+                        Cpa64U waitUs)
+{
+    if (pollInline)
+    {
+        icp_sal_DcPollInstance(setup->dcInstanceHandle, 0);
+    }
+    else if (waitUs > DC_TRACE_SLEEP_THRESHOLD_US)
+    {
+        usleep(waitUs - DC_TRACE_SLEEP_THRESHOLD_US);
+    }
+    else
+    {
+        AVOID_SOFTLOCKUP;
+    }
+}
+
+static CpaStatus dcTraceReplay(compression_test_params_t *setup,
+                               dc_trace_request_t *pRequests,
+                               Cpa32U numRequests,
+                               CpaBoolean pollInline)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaBufferList *srcBufferListArray = NULL;
+    CpaBufferList *destBufferListArray = NULL;
+    CpaBufferList *cmpBufferListArray = NULL;
+    CpaDcRqResults *resultArray = NULL;
+    CpaDcSessionHandle pSessionHandle = NULL;
+    CpaDcSessionHandle pDecompressSessionHandle = NULL;
+    CpaBufferList contextBuffer = {0};
+    perf_data_t *pPerfData = setup->performanceStats;
+    const corpus_file_t *const fileArray = getFilesInCorpus(setup->corpus);
+    dc_trace_ctx_t *pCtx = NULL;
+    Cpa32U *bufferSizes = setup->packetSizeInBytesArray;
+    Cpa32U destSize = 0;
+    Cpa32U slot = 0;
+    Cpa32U i = 0;
+    perf_cycles_t start = 0;
+    perf_cycles_t now = 0;
+    Cpa64U freqKHz = sampleCodeGetCpuFreq();
+
+    pCtx = qaeMemAlloc(sizeof(dc_trace_ctx_t));
+    if (NULL == pCtx)
+    {
+        PRINT_ERR("Unable to allocate memory for the trace context\n");
+        return CPA_STATUS_FAIL;
+    }
+    memset(pCtx, 0, sizeof(dc_trace_ctx_t));
+    pCtx->setup = setup;
+    sample_code_thread_mutex_init(&pCtx->mutex);
+    for (slot = 0; slot < DC_TRACE_MAX_INFLIGHT; slot++)
+    {
+        pCtx->slots[slot].pCtx = pCtx;
+        pCtx->slots[slot].slot = slot;
+        pCtx->freeSlots[slot] = slot;
+    }
+    pCtx->numFree = DC_TRACE_MAX_INFLIGHT;
+
+    status = qatAllocateCompressionLists(setup,
+                                         &srcBufferListArray,
+                                         &destBufferListArray,
+                                         &cmpBufferListArray,
+                                         &resultArray);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pCtx->results = resultArray;
+        status = qatAllocateCompressionFlatBuffers(setup,
+                                                   srcBufferListArray,
+                                                   1,
+                                                   bufferSizes,
+                                                   destBufferListArray,
+                                                   1,
+                                                   bufferSizes,
+                                                   cmpBufferListArray,
+                                                   1,
+                                                   bufferSizes);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("could not allocate all flat buffers for compression\n");
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        destSize = destBufferListArray[0].pBuffers[0].dataLenInBytes;
+        status = PopulateBuffers(
+            srcBufferListArray,
+            setup->numLists,
+            fileArray[setup->corpusFileIndex].corpusBinaryData,
+            fileArray[setup->corpusFileIndex].corpusBinaryDataLen,
+            bufferSizes);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = qatCompressionSessionInit(setup,
+                                           &pSessionHandle,
+                                           &pDecompressSessionHandle,
+                                           &contextBuffer,
+                                           dcTraceCallback);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("compressionSessionInit returned status %d\n", status);
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = sampleCodeSemaphoreInit(&pPerfData->comp, 0);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+        sampleCodeBarrier();
+        goto cleanup;
+    }
+
+    setup->requestOps.flushFlag = CPA_DC_FLUSH_FINAL;
+    pPerfData->numOperations = numRequests;
+    /* all threads start their trace at the same time */
+    sampleCodeBarrier();
+    start = sampleCodeTimestamp();
+    pPerfData->startCyclesTimestamp = start;
+
+    for (i = 0; i < numRequests; i++)
+    {
+        /* open loop: wait for the due time, never for a response */
+        while ((now = sampleCodeTimestamp()) - start < pRequests[i].due)
+        {
+            dcTraceIdle(setup,
+                        pollInline,
+                        (pRequests[i].due - (now - start)) *
+                            DC_TRACE_USEC_PER_MSEC / freqKHz);
+        }
+        while (DC_TRACE_MAX_INFLIGHT == (slot = dcTraceGetSlot(pCtx)))
+        {
+            dcTraceIdle(setup, pollInline, 0);
+        }
+
+        pCtx->slots[slot].request = i;
+        pPerfData->start_times[i] = start + pRequests[i].due;
+        srcBufferListArray[slot].pBuffers[0].dataLenInBytes =
+            pRequests[i].bytes;
+        destBufferListArray[slot].pBuffers[0].dataLenInBytes = destSize;
+        resultArray[slot].checksum =
+            (CPA_DC_ADLER32 == setup->setupData.checksum) ? 1 : 0;
+        do
+        {
+            status = cpaDcCompressData2(setup->dcInstanceHandle,
+                                        pSessionHandle,
+                                        &srcBufferListArray[slot],
+                                        &destBufferListArray[slot],
+                                        &setup->requestOps,
+                                        &resultArray[slot],
+                                        &pCtx->slots[slot]);
+            if (CPA_STATUS_RETRY == status)
+            {
+                pPerfData->retries++;
+                dcTraceIdle(setup, pollInline, 0);
+            }
+        } while (CPA_STATUS_RETRY == status);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("Data Compression Failed %d\n\n", status);
+            dcTracePutSlot(pCtx, slot);
+            pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+            break;
+        }
+        pPerfData->submissions++;
+        if (CPA_TRUE == stopTestsIsEnabled_g && CPA_TRUE == exitLoopFlag_g)
+        {
+            break;
+        }
+    }
+
+    /* collect the requests in flight before the buffers are freed, the
+     * callback has not posted the semaphore when the replay stopped early */
+    sample_code_thread_mutex_lock(&pCtx->mutex);
+    pPerfData->numOperations = pPerfData->submissions;
+    if (pPerfData->submissions < numRequests &&
+        pPerfData->responses >= pPerfData->numOperations)
+    {
+        pPerfData->endCyclesTimestamp = sampleCodeTimestamp();
+        sampleCodeSemaphorePost(&pPerfData->comp);
+    }
+    sample_code_thread_mutex_unlock(&pCtx->mutex);
+    if (pollInline)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            dcPollNumOperations(
+                pPerfData, setup->dcInstanceHandle, pPerfData->numOperations))
+        {
+            PRINT_ERR("dcPollNumOperations returned an error\n");
+            status = CPA_STATUS_FAIL;
+        }
+    }
+    if (CPA_STATUS_SUCCESS != waitForSemaphore(pPerfData))
+    {
+        PRINT_ERR("waitForSemaphore error\n");
+        status = CPA_STATUS_FAIL;
+    }
+    pPerfData->latencyCount = pPerfData->submissions;
+    sampleCodeSemaphoreDestroy(&pPerfData->comp);
+
+cleanup:
+    if (NULL != pSessionHandle &&
+        CPA_STATUS_SUCCESS !=
+            qatCompressionSessionTeardown(
+                setup, &pSessionHandle, &pDecompressSessionHandle))
+    {
+        PRINT_ERR("compressionSessionTeardown error\n");
+        status = CPA_STATUS_FAIL;
+    }
+    if (NULL != srcBufferListArray)
+    {
+        qatFreeCompressionFlatBuffers(
+            setup, srcBufferListArray, destBufferListArray, cmpBufferListArray);
+        qatFreeFlatBuffersInList(&contextBuffer);
+        qatFreeCompressionLists(setup,
+                                &srcBufferListArray,
+                                &destBufferListArray,
+                                &cmpBufferListArray,
+                                &resultArray);
+    }
+    sample_code_thread_mutex_destroy(&pCtx->mutex);
+    qaeMemFree((void **)&pCtx);
+    return status;
+}
+
+void dcTracePerformance(single_thread_test_data_t *testSetup)
+{
+    compression_test_params_t dcSetup = {0};
+    compression_test_params_t *tmpSetup = NULL;
+    dc_trace_request_t *pRequests = NULL;
+    CpaInstanceHandle *instances = NULL;
+    CpaInstanceInfo2 instanceInfo2 = {0};
+    char name[DC_TRACE_MAX_PATH_LEN] = {0};
+    Cpa16U numInstances = 0;
+    Cpa32U numRequests = 0;
+    Cpa32U maxBytes = 0;
+    CpaStatus status = CPA_STATUS_FAIL;
+    perf_data_t *pPerfData = testSetup->performanceStats;
+
+    tmpSetup = (compression_test_params_t *)(testSetup->setupPtr);
+    testSetup->passCriteria = tmpSetup->passCriteria;
+    dcSetup.passCriteria = tmpSetup->passCriteria;
+    memcpy(&dcSetup.requestOps, &tmpSetup->requestOps, sizeof(CpaDcOpData));
+    dcSetup.corpus = tmpSetup->corpus;
+    dcSetup.corpusFileIndex = tmpSetup->corpusFileIndex;
+    dcSetup.setupData = tmpSetup->setupData;
+    dcSetup.dcSessDir = CPA_DC_DIR_COMPRESS;
+    dcSetup.syncFlag = ASYNC;
+    dcSetup.numLoops = 1;
+    dcSetup.numLists = DC_TRACE_MAX_INFLIGHT;
+    dcSetup.isDpApi = CPA_FALSE;
+    dcSetup.disableAdditionalCmpbufferSize = CPA_TRUE;
+    dcSetup.threadID = testSetup->threadID;
+    dcSetup.performanceStats = pPerfData;
+    pPerfData->averagePacketSizeInBytes = testSetup->packetSize;
+    pPerfData->numLoops = 1;
+    pPerfData->threadReturnStatus = CPA_STATUS_SUCCESS;
+    pPerfData->additionalStatus = CPA_STATUS_SUCCESS;
+
+    status = dcTraceFileName(testSetup->threadID, name, sizeof(name));
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = dcTraceLoad(name, &pRequests, &numRequests, &maxBytes);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        dcSetup.bufferSize = maxBytes;
+        pPerfData->start_times =
+            qaeMemAlloc(numRequests * sizeof(perf_cycles_t));
+        pPerfData->response_times =
+            qaeMemAlloc(numRequests * sizeof(perf_cycles_t));
+        if (NULL == pPerfData->start_times || NULL == pPerfData->response_times)
+        {
+            PRINT_ERR("Unable to allocate memory for latencies\n");
+            status = CPA_STATUS_FAIL;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = allocateAndSetArrayOfPacketSizes(
+            &dcSetup.packetSizeInBytesArray, maxBytes, dcSetup.numLists);
+    }
+
+    /* released by startThreads, same as dcPerformance */
+    startBarrier();
+    testSetup->statsPrintFunc = NULL;
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+
+    status = cpaDcGetNumInstances(&numInstances);
+    if (CPA_STATUS_SUCCESS != status || 0 == numInstances)
+    {
+        PRINT_ERR(" DC Instances are not present\n");
+        status = CPA_STATUS_FAIL;
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+    instances = qaeMemAlloc(sizeof(CpaInstanceHandle) * numInstances);
+    if (NULL == instances)
+    {
+        PRINT_ERR("Unable to allocate Memory for Instances\n");
+        status = CPA_STATUS_FAIL;
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+    status = cpaDcGetInstances(numInstances, instances);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR(" Unable to get DC instances\n");
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+    dcSetup.dcInstanceHandle =
+        instances[(testSetup->logicalQaInstance) % numInstances];
+    status = sampleCodeDcGetNode(dcSetup.dcInstanceHandle, &dcSetup.node);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcInstanceGetInfo2(dcSetup.dcInstanceHandle,
+                                       &instanceInfo2);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Unable to get the DC instance info\n");
+        QAT_PERF_FAIL_WAIT_AND_GOTO_LABEL(testSetup, err);
+    }
+
+    status = dcTraceReplay(&dcSetup,
+                           pRequests,
+                           numRequests,
+                           (poll_inline_g && instanceInfo2.isPolled)
+                               ? CPA_TRUE
+                               : CPA_FALSE);
+
+err:
+    if (CPA_STATUS_SUCCESS == status &&
+        CPA_STATUS_SUCCESS == pPerfData->threadReturnStatus)
+    {
+        testSetup->statsPrintFunc = (stats_print_func_t)dcTracePrintStats;
+    }
+    else
+    {
+        PRINT_ERR("Compression Thread %u FAILED\n", testSetup->threadID);
+        pPerfData->threadReturnStatus = CPA_STATUS_FAIL;
+        qatFreeLatency(pPerfData);
+        testSetup->statsPrintFunc =
+            (stats_print_func_t)stopDcServicesFromPrintStats;
+    }
+    if (NULL != dcSetup.packetSizeInBytesArray)
+    {
+        qaeMemFree((void **)&dcSetup.packetSizeInBytesArray);
+    }
+    if (NULL != instances)
+    {
+        qaeMemFree((void **)&instances);
+    }
+    if (NULL != pRequests)
+    {
+        qaeMemFree((void **)&pRequests);
+    }
+    sampleCodeThreadComplete(testSetup->threadID);
+}
+EXPORT_SYMBOL(dcTracePerformance);
+
+static int dcTraceCompareCycles(const void *a, const void *b)
+{
+    perf_cycles_t x = *(const perf_cycles_t *)a;
+    perf_cycles_t y = *(const perf_cycles_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Print the p-th per mille of a sorted array of latencies in usecs */
+static void dcTracePrintPercentile(const char *label,
+                                   perf_cycles_t *pLatencies,
+                                   Cpa64U numLatencies,
+                                   Cpa32U perMille,
+                                   Cpa64U freqKHz)
+{
+    Cpa64U index = (numLatencies - 1) * perMille / 1000;
+
+    PRINT("%-22s %llu\n",
+          label,
+          (unsigned long long)(pLatencies[index] * DC_TRACE_USEC_PER_MSEC /
+                               freqKHz));
+}
+
+CpaStatus dcTracePrintStats(thread_creation_data_t *data)
+{
+    perf_data_t stats = {0};
+    perf_data_t *pThreadStats = NULL;
+    perf_cycles_t *pLatencies = NULL;
+    perf_cycles_t numOfCycles = 0;
+    Cpa64U numLatencies = 0;
+    Cpa64U bytesConsumed = 0;
+    Cpa64U bytesProduced = 0;
+    Cpa64U freqKHz = sampleCodeGetCpuFreq();
+    Cpa64U throughput = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+
+    status = stopDcServices();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Unable to stop DC services\n");
+        return status;
+    }
+
+    getLongestCycleCount(&stats, data->performanceStats, data->numberOfThreads);
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        pThreadStats = data->performanceStats[i];
+        if (CPA_STATUS_SUCCESS != pThreadStats->threadReturnStatus)
+        {
+            status = CPA_STATUS_FAIL;
+        }
+        numLatencies += pThreadStats->latencyCount;
+    }
+    if (numLatencies > 0 && CPA_STATUS_SUCCESS == status)
+    {
+        pLatencies = qaeMemAlloc(numLatencies * sizeof(perf_cycles_t));
+        if (NULL == pLatencies)
+        {
+            PRINT_ERR("Unable to allocate memory for latencies\n");
+            status = CPA_STATUS_FAIL;
+        }
+    }
+
+    numLatencies = 0;
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        pThreadStats = data->performanceStats[i];
+        if (NULL != pLatencies)
+        {
+            for (j = 0; j < pThreadStats->latencyCount; j++)
+            {
+                pLatencies[numLatencies++] = pThreadStats->response_times[j] -
+                                             pThreadStats->start_times[j];
+            }
+        }
+        stats.responses += pThreadStats->responses;
+        stats.retries += pThreadStats->retries;
+        bytesConsumed += pThreadStats->bytesConsumedPerLoop;
+        bytesProduced += pThreadStats->bytesProducedPerLoop;
+        qatFreeLatency(pThreadStats);
+        clearPerfStats(pThreadStats);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    numOfCycles = stats.endCyclesTimestamp - stats.startCyclesTimestamp;
+    dcPrintTestData((compression_test_params_t *)data->setupPtr);
+    PRINT("Workload               %s%s\n",
+          dcTraceFile_g,
+          dcTraceNumFiles_g ? "<n>" : "");
+    PRINT("Bytes per Unit         %u\n", dcTraceBytesPerUnit_g);
+    PRINT("Number of threads      %d\n", data->numberOfThreads);
+    PRINT("Total Responses        %llu\n", (unsigned long long)stats.responses);
+    PRINT("Total Retries          %llu\n", (unsigned long long)stats.retries);
+    PRINT("Total Cycles           %llu\n", numOfCycles);
+    PRINT("CPU Frequency(kHz)     %llu\n", (unsigned long long)freqKHz);
+    if (numOfCycles > 0)
+    {
+        /* bits per msec are kbps, the product fits 64 bits below 2 EiB */
+        throughput = bytesConsumed * 8 * freqKHz / numOfCycles;
+        PRINT("Throughput(Mbps)       %llu\n",
+              (unsigned long long)(throughput / 1000));
+    }
+    dcCalculateAndPrintCompressionRatio((Cpa32U)bytesConsumed,
+                                        (Cpa32U)bytesProduced);
+    if (NULL != pLatencies)
+    {
+        qsort(pLatencies,
+              numLatencies,
+              sizeof(perf_cycles_t),
+              dcTraceCompareCycles);
+        dcTracePrintPercentile(
+            "p50 Latency (uSecs)", pLatencies, numLatencies, 500, freqKHz);
+        dcTracePrintPercentile(
+            "p90 Latency (uSecs)", pLatencies, numLatencies, 900, freqKHz);
+        dcTracePrintPercentile(
+            "p99 Latency (uSecs)", pLatencies, numLatencies, 990, freqKHz);
+        dcTracePrintPercentile(
+            "p99.9 Latency (uSecs)", pLatencies, numLatencies, 999, freqKHz);
+        dcTracePrintPercentile(
+            "Max. Latency (uSecs)", pLatencies, numLatencies, 1000, freqKHz);
+        qaeMemFree((void **)&pLatencies);
+    }
+    return status;
+}
+EXPORT_SYMBOL(dcTracePrintStats);
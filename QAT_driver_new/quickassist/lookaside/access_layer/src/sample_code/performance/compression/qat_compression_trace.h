@@ -0,0 +1,135 @@
+/****************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_compression_trace.h
+ *
+ * @ingroup sampleCode
+ *
+ * @description                 This module replays request traces against
+ *                              the stateless compression API. A trace holds
+ *                              one "<work size> <interval in usecs>" line
+ *                              per request, the requests are submitted at
+ *                              the time the trace gives them whether or not
+ *                              earlier ones have completed, and the latency
+ *                              of every request is measured from that time.
+ *
+ *****************************************************************************/
+
+#ifndef QAT_COMPRESSION_TRACE_H_
+#define QAT_COMPRESSION_TRACE_H_
+
+#include "cpa_sample_code_dc_perf.h"
+
+/* Bytes of one unit of work in the trace, as for the rate limit tools */
+#define DC_TRACE_DEFAULT_BYTES_PER_UNIT (1024)
+/* Requests of one thread in flight at any time */
+#define DC_TRACE_MAX_INFLIGHT (64)
+/* Requests larger than this are clamped */
+#define DC_TRACE_MAX_REQUEST_BYTES (1024 * 1024)
+#define DC_TRACE_MAX_PATH_LEN (256)
+
+/**
+ *****************************************************************************
+ * @file qat_compression_trace.h
+ *
+ * @ingroup sample_code
+ *
+ * @description                 register a trace driven compression test with
+ *                              the framework. When traceFile names a file
+ *                              every thread replays it, otherwise it is the
+ *                              prefix of numbered traces, <traceFile>1,
+ *                              <traceFile>2 and so on, and the threads are
+ *                              given them in turn.
+ *
+ * @param[in]   algorithm       compression algorithm
+ * @param[in]   compLevel       compression level
+ * @param[in]   huffmanType     static or dynamic Huffman trees
+ * @param[in]   corpusType      corpus the request data is taken from
+ * @param[in]   traceFile       trace file or prefix of the trace files
+ * @param[in]   bytesPerUnit    bytes of one unit of work, 0 for the default
+ *
+ * @pre                         DC services can be started
+ *
+ * @post                        the test is ready to be started with
+ *                              createStartandWaitForCompletion
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully
+ *
+ * @retval CPA_STATUS_FAIL      no trace could be read or the test could not
+ *                              be registered
+ ****************************************************************************/
+CpaStatus setupDcTraceTest(CpaDcCompType algorithm,
+                           CpaDcCompLvl compLevel,
+                           CpaDcHuffType huffmanType,
+                           corpus_type_t corpusType,
+                           const char *traceFile,
+                           Cpa32U bytesPerUnit);
+
+/**
+ *****************************************************************************
+ * @file qat_compression_trace.h
+ *
+ * @ingroup sample_code
+ *
+ * @description                 performance thread of the trace driven test,
+ *                              started by the framework on each instance
+ *
+ * @param[in]   testSetup       framework data of the thread
+ ****************************************************************************/
+void dcTracePerformance(single_thread_test_data_t *testSetup);
+
+/**
+ *****************************************************************************
+ * @file qat_compression_trace.h
+ *
+ * @ingroup sample_code
+ *
+ * @description                 print the throughput and the latency
+ *                              percentiles of all the threads of a trace
+ *                              driven test
+ *
+ * @param[in]   data            framework data of the test
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully
+ *
+ * @retval CPA_STATUS_FAIL      a thread failed or services did not stop
+ ****************************************************************************/
+CpaStatus dcTracePrintStats(thread_creation_data_t *data);
+
+#endif /* QAT_COMPRESSION_TRACE_H_ */
@@ -1568,6 +1568,42 @@ CpaStatus qatSwChainDecompress(compression_test_params_t *setup,
 }
 #endif
 
+/* Converts the period chosen by the poll controller into a number of
+ * submissions, using the submission rate since the previous poll */
+static Cpa64U qatDcAdaptiveNextPoll(compression_test_params_t *setup)
+{
+    perf_data_t *pPerfData = setup->performanceStats;
+    Cpa64U now = sampleCodeDcPollCtlNowNs();
+    Cpa64U lastPoll = setup->pollCtl.lastPollNs;
+    Cpa64U period = 0;
+    Cpa64U submitted = 0;
+
+    /* A new run starts with fresh counters */
+    if (setup->pollCtl.targetLatencyNs != dcPollLatencyNs_g ||
+        pPerfData->submissions < setup->pollCtlSubmissions ||
+        pPerfData->responses < setup->pollCtlResponses)
+    {
+        icp_sal_PollCtlInit(&setup->pollCtl, dcPollLatencyNs_g, 0, 0, 0);
+        setup->pollCtlResponses = 0;
+        setup->pollCtlSubmissions = 0;
+        lastPoll = 0;
+    }
+    period = icp_sal_PollCtlUpdate(
+        &setup->pollCtl,
+        (Cpa32U)(pPerfData->responses - setup->pollCtlResponses),
+        now);
+    submitted = pPerfData->submissions - setup->pollCtlSubmissions;
+    setup->pollCtlResponses = pPerfData->responses;
+    setup->pollCtlSubmissions = pPerfData->submissions;
+
+    if (0 == lastPoll || now <= lastPoll || 0 == submitted)
+    {
+        return dcPollingInterval_g;
+    }
+    submitted = submitted * period / (now - lastPoll);
+    return submitted ? submitted : 1;
+}
+
 void qatDcPollAndSetNextPollCounter(compression_test_params_t *setup)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
@@ -1605,7 +1641,9 @@ void qatDcPollAndSetNextPollCounter(compression_test_params_t *setup)
             AVOID_SOFTLOCKUP;
         }
         setup->performanceStats->nextPoll =
-            setup->performanceStats->submissions + dcPollingInterval_g;
+            setup->performanceStats->submissions +
+            (dcPollLatencyNs_g ? qatDcAdaptiveNextPoll(setup)
+                               : dcPollingInterval_g);
     }
 }
 
@@ -58,6 +58,10 @@
 #include "cpa_sample_code_dc_utils.h"
 #include "cpa_sample_code_dc_dp.h"
 #include "qat_compression_main.h"
+#ifdef USER_SPACE
+#include "qat_compression_trace.h"
+#include "qat_compression_offload.h"
+#endif
 #endif
 #include "cpa_sample_code_sym_perf_dp.h"
 
@@ -137,7 +141,11 @@ option_t optArray[MAX_NUMOPT] = {
     {"getOffloadCost", 0},
     {"includeLZ4", DEFAULT_INCLUDE_LZ4},
     {"compOnly", 0},
-    {"verboseOutput", 1}};
+    {"verboseOutput", 1},
+    {"dcPollLatencyNs", 0},
+    {"dcTrace", 0},
+    {"dcTraceUnit", DC_TRACE_DEFAULT_BYTES_PER_UNIT},
+    {"dcOffloadProfile", 0}};
 
 #define SIGN_OF_LIFE_OPT_ARRAY_POS (0)
 #define RUN_TEST_OPT_ARRAY_POS (1)
@@ -152,6 +160,10 @@ option_t optArray[MAX_NUMOPT] = {
 #define GET_LATENCY_POS (10)
 #define GET_OFFLOAD_COST_POS (11)
 #define RUN_LZ4_TEST_POS (12)
+#define DC_POLL_LATENCY_POS (15)
+#define DC_TRACE_POS (16)
+#define DC_TRACE_UNIT_POS (17)
+#define DC_OFFLOAD_PROFILE_POS (18)
 
 #else /* #ifdef USER_SPACE */
 
@@ -307,6 +319,9 @@ int main(int argc, char *argv[])
     Cpa32U dcBufferSize = 0;
     CpaBoolean dynamicEnabled = CPA_FALSE;
     CpaDcInstanceCapabilities dcCap = {0};
+    const char *dcTraceFile = NULL;
+    Cpa32U dcTraceUnit = 0;
+    Cpa32U dcOffloadProfile = 0;
 #endif
 
     CpaStatus status = CPA_STATUS_FAIL;
@@ -350,6 +365,15 @@ int main(int argc, char *argv[])
     computeLatency = optArray[GET_LATENCY_POS].optValue;
     computeOffloadCost = optArray[GET_OFFLOAD_COST_POS].optValue;
     includeLZ4 = optArray[RUN_LZ4_TEST_POS].optValue;
+#ifdef INCLUDE_COMPRESSION
+    if (optArray[DC_POLL_LATENCY_POS].optValue > 0)
+    {
+        setDcPollLatency(optArray[DC_POLL_LATENCY_POS].optValue);
+    }
+    dcTraceFile = optArray[DC_TRACE_POS].optString;
+    dcTraceUnit = optArray[DC_TRACE_UNIT_POS].optValue;
+    dcOffloadProfile = optArray[DC_OFFLOAD_PROFILE_POS].optValue;
+#endif
 
 #ifndef LATENCY_CODE
     /* If Latency support is not compiled in and the user asks
@@ -1374,11 +1398,60 @@ int main(int argc, char *argv[])
             return CPA_STATUS_FAIL;
         }
     }
+#ifdef USER_SPACE
+    /**************************************************************************
+     * TRACE DRIVEN COMPRESSION TEST, REPLACES THE CORPUS TESTS
+     **************************************************************************/
+    if ((COMPRESSION_CODE & runTests) == COMPRESSION_CODE &&
+        NULL != dcTraceFile && numDcInst > 0)
+    {
+        disableAdditionalCmpbufferSize_g = 1;
+        status = setupDcTraceTest(CPA_DC_DEFLATE,
+                                  SAMPLE_CODE_CPA_DC_L1,
+                                  CPA_DC_HT_STATIC,
+                                  sampleCorpus,
+                                  dcTraceFile,
+                                  dcTraceUnit);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("Error calling setupDcTraceTest\n");
+            return CPA_STATUS_FAIL;
+        }
+        status = createStartandWaitForCompletion(COMPRESSION);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            retStatus = CPA_STATUS_FAIL;
+        }
+    }
+    /**************************************************************************
+     * COMPRESSION OFFLOAD COST PROFILE, REPLACES THE CORPUS TESTS
+     **************************************************************************/
+    if ((COMPRESSION_CODE & runTests) == COMPRESSION_CODE &&
+        0 != dcOffloadProfile && numDcInst > 0)
+    {
+        disableAdditionalCmpbufferSize_g = 1;
+        status = setupDcOffloadTest(CPA_DC_DEFLATE,
+                                    SAMPLE_CODE_CPA_DC_L1,
+                                    CPA_DC_HT_STATIC,
+                                    sampleCorpus);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("Error calling setupDcOffloadTest\n");
+            return CPA_STATUS_FAIL;
+        }
+        status = createStartandWaitForCompletion(COMPRESSION);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            retStatus = CPA_STATUS_FAIL;
+        }
+    }
+#endif
     /**************************************************************************
      * COMPRESSION TESTS CALGARY CORPUS
      **************************************************************************/
 
-    if ((COMPRESSION_CODE & runTests) == COMPRESSION_CODE)
+    if ((COMPRESSION_CODE & runTests) == COMPRESSION_CODE &&
+        NULL == dcTraceFile && 0 == dcOffloadProfile)
     {
 
         if (numDcInst > 0)
@@ -1042,6 +1042,7 @@ int parseArg(int argc, char **argv, option_t *optArray, int numOpt)
     int indexOpt = 0;
     int value = 0;
     char name[CLI_OPT_LEN];
+    char *optString = NULL;
     CpaBoolean matchFound = CPA_FALSE;
 
     if (NULL == optArray)
@@ -1052,7 +1053,12 @@ int parseArg(int argc, char **argv, option_t *optArray, int numOpt)
         if (NULL != argv[indexArgv])
         {
             memset((void *)name, 0, sizeof(name));
-            if (strlen(argv[indexArgv]) > CLI_OPT_LEN)
+            /* only the name is bounded, string values may be paths */
+            optString = strchr(argv[indexArgv], '=');
+            if ((NULL == optString &&
+                 strlen(argv[indexArgv]) > CLI_OPT_LEN) ||
+                (NULL != optString &&
+                 optString - argv[indexArgv] >= CLI_OPT_LEN))
             {
                 PRINT_ERR("input argument %d, exceeds permitted length\n",
                           indexArgv);
@@ -1065,6 +1071,8 @@ int parseArg(int argc, char **argv, option_t *optArray, int numOpt)
                     strncmp(name, optArray[indexOpt].optName, sizeof(name)))
                 {
                     optArray[indexOpt].optValue = value;
+                    optArray[indexOpt].optString =
+                        (NULL != optString) ? optString + 1 : NULL;
                     matchFound = CPA_TRUE;
                 }
             }
@@ -105,12 +105,14 @@ typedef sem_t *sample_code_semaphore_t;
 #define DEFAULT_SIGN_OF_LIFE (0)
 #define USE_V1_CONFIG_FILE (1)
 #define USE_V2_CONFIG_FILE (2)
-#define MAX_NUMOPT (15)
+#define MAX_NUMOPT (19)
 
 typedef struct option_s
 {
     const char optName[CLI_OPT_LEN];
     int optValue;
+    /* text after the '=', for options that are not numbers */
+    const char *optString;
 } option_t;
 
 extern int parseArg(int argc, char **argv, option_t *optArray, int numOpt);
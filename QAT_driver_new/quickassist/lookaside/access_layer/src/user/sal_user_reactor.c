@@ -0,0 +1,879 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file sal_user_reactor.c
+ *
+ * @ingroup SalUserReactor
+ *
+ * @description
+ *      Completion reactor. Every reactor thread busy polls the instances
+ *      that completed requests recently and sleeps in epoll on the file
+ *      descriptors of the others. Polling an epoll mode instance enables
+ *      its ring interrupt again, so an instance is armed simply by not
+ *      polling it any more; the descriptors are edge triggered.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "icp_sal_poll.h"
+#include "icp_sal_reactor.h"
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_sal_types.h"
+
+#define SAL_REACTOR_MAX_EVENTS (64)
+#define SAL_REACTOR_NSEC_PER_SEC (1000000000ULL)
+#define SAL_REACTOR_NSEC_PER_USEC (1000ULL)
+
+struct sal_reactor_s;
+struct sal_reactor_thread_s;
+
+/* Reactor threads watching the same descriptor share one entry */
+typedef struct sal_reactor_fd_s
+{
+    int fd;
+    struct sal_reactor_inst_s *pInsts;
+    /**< Instances of the descriptor, linked by pNextOnFd */
+    struct sal_reactor_fd_s *pNext;
+} sal_reactor_fd_t;
+
+typedef struct sal_reactor_inst_s
+{
+    CpaInstanceHandle instance;
+    CpaBoolean isDc;
+    sal_reactor_fd_t *pFd;
+    /**< NULL in poll mode */
+    struct sal_reactor_thread_s *pThread;
+    Cpa64U lastActiveNs;
+    volatile Cpa32U armed;
+    volatile Cpa32U woken;
+    /**< On the woken stack of the thread */
+    volatile Cpa64U notifyNs;
+    volatile Cpa32U notifying;
+    /**< icp_sal_ReactorNotify calls running on the instance */
+    struct sal_reactor_inst_s *pNext;
+    struct sal_reactor_inst_s *pPrev;
+    struct sal_reactor_inst_s *pNextOnFd;
+    struct sal_reactor_inst_s *pNextWoken;
+} sal_reactor_inst_t;
+
+typedef struct sal_reactor_thread_s
+{
+    struct sal_reactor_s *pReactor;
+    pthread_t tid;
+    CpaBoolean started;
+    int epfd;
+    int evfd;
+    int tfd;
+    pthread_mutex_t lock;
+    /**< Held while polling, callbacks run under it */
+    sal_reactor_inst_t *pInsts;
+    sal_reactor_fd_t *pFds;
+    Cpa32U numInsts;
+    Cpa32U numPollMode;
+    Cpa32U numArmed;
+    sal_reactor_inst_t *volatile pWoken;
+    /**< Instances woken by icp_sal_ReactorNotify */
+    icp_sal_reactor_stats_t stats;
+} sal_reactor_thread_t;
+
+typedef struct sal_reactor_s
+{
+    icp_sal_reactor_config_t config;
+    Cpa64U busyPollNs;
+    Cpa64U createNs;
+    pthread_mutex_t regLock;
+    /**< Serialises registrations, taken before a thread lock */
+    volatile Cpa32U stop;
+    sal_reactor_thread_t threads[];
+} sal_reactor_t;
+
+static Cpa64U SalReactor_nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * SAL_REACTOR_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static void SalReactor_recordLatency(Cpa64U latency,
+                                     Cpa64U *pCount,
+                                     Cpa64U *pTotal,
+                                     Cpa64U *pMax,
+                                     Cpa64U *pHist)
+{
+    Cpa32U bucket = 0;
+
+    while (bucket < ICP_SAL_REACTOR_LATENCY_BUCKETS - 1 &&
+           latency >> (bucket + 1))
+    {
+        bucket++;
+    }
+    (*pCount)++;
+    *pTotal += latency;
+    if (latency > *pMax)
+    {
+        *pMax = latency;
+    }
+    pHist[bucket]++;
+}
+
+static void SalReactor_kick(sal_reactor_thread_t *pThread)
+{
+    Cpa64U one = 1;
+
+    if (write(pThread->evfd, &one, sizeof(one)) != sizeof(one))
+    {
+        /* The counter is already non zero, the thread will wake */
+    }
+}
+
+static CpaStatus SalReactor_poll(sal_reactor_inst_t *pInst, Cpa32U quota)
+{
+#ifndef ICP_DC_ONLY
+    if (!pInst->isDc)
+    {
+        return icp_sal_CyPollInstance(pInst->instance, quota);
+    }
+#endif
+    return icp_sal_DcPollInstance(pInst->instance, quota);
+}
+
+static void SalReactor_wake(sal_reactor_thread_t *pThread,
+                            sal_reactor_inst_t *pInst,
+                            Cpa64U now)
+{
+    __atomic_store_n(&pInst->armed, CPA_FALSE, __ATOMIC_RELEASE);
+    pInst->lastActiveNs = now;
+    pThread->numArmed--;
+}
+
+/* Polls every instance that is not armed. Returns the number still busy
+ * polled; called with the thread lock held. */
+static Cpa32U SalReactor_pollPass(sal_reactor_thread_t *pThread)
+{
+    sal_reactor_t *pReactor = pThread->pReactor;
+    icp_sal_reactor_stats_t *pStats = &pThread->stats;
+    sal_reactor_inst_t *pInst = NULL;
+    Cpa64U now = SalReactor_nowNs();
+    Cpa32U busy = 0;
+
+    for (pInst = pThread->pInsts; NULL != pInst; pInst = pInst->pNext)
+    {
+        CpaStatus status = CPA_STATUS_SUCCESS;
+        Cpa64U notifyNs = 0;
+
+        if (pInst->armed)
+        {
+            continue;
+        }
+        status = SalReactor_poll(pInst, pReactor->config.responseQuota);
+        pStats->polls++;
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            pStats->emptyPolls++;
+            if (now - pInst->lastActiveNs < pReactor->busyPollNs)
+            {
+                busy++;
+                continue;
+            }
+            __atomic_store_n(&pInst->armed, CPA_TRUE, __ATOMIC_SEQ_CST);
+            pThread->numArmed++;
+            pStats->armed++;
+            if (NULL == pInst->pFd)
+            {
+                continue;
+            }
+            /* A response that landed while the last poll re-enabled the
+             * interrupt raises no edge, look once more */
+            status = SalReactor_poll(pInst, pReactor->config.responseQuota);
+            pStats->polls++;
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                pStats->emptyPolls++;
+                continue;
+            }
+            SalReactor_wake(pThread, pInst, now);
+        }
+
+        pInst->lastActiveNs = now;
+        busy++;
+        notifyNs = __atomic_exchange_n(&pInst->notifyNs, 0, __ATOMIC_ACQ_REL);
+        if (notifyNs && now > notifyNs)
+        {
+            SalReactor_recordLatency(now - notifyNs,
+                                     &pStats->complLatencyCount,
+                                     &pStats->complLatencyTotalNs,
+                                     &pStats->complLatencyMaxNs,
+                                     pStats->complLatencyHist);
+        }
+    }
+    return busy;
+}
+
+/* Takes the instances pushed by icp_sal_ReactorNotify. Called with the
+ * thread lock held. */
+static void SalReactor_takeWoken(sal_reactor_thread_t *pThread, Cpa64U now)
+{
+    icp_sal_reactor_stats_t *pStats = &pThread->stats;
+    sal_reactor_inst_t *pInst =
+        __atomic_exchange_n(&pThread->pWoken, NULL, __ATOMIC_ACQ_REL);
+
+    while (NULL != pInst)
+    {
+        sal_reactor_inst_t *pNext = pInst->pNextWoken;
+        Cpa64U notifyNs = __atomic_load_n(&pInst->notifyNs, __ATOMIC_ACQUIRE);
+
+        __atomic_store_n(&pInst->woken, CPA_FALSE, __ATOMIC_RELEASE);
+        if (pInst->armed)
+        {
+            SalReactor_wake(pThread, pInst, now);
+            pStats->notifyWakeups++;
+            if (notifyNs && now > notifyNs)
+            {
+                SalReactor_recordLatency(now - notifyNs,
+                                         &pStats->wakeLatencyCount,
+                                         &pStats->wakeLatencyTotalNs,
+                                         &pStats->wakeLatencyMaxNs,
+                                         pStats->wakeLatencyHist);
+            }
+        }
+        pInst = pNext;
+    }
+}
+
+/* Sleeps until a descriptor, the timer of the poll mode instances or a
+ * notification wakes the thread */
+static void SalReactor_wait(sal_reactor_thread_t *pThread)
+{
+    sal_reactor_t *pReactor = pThread->pReactor;
+    icp_sal_reactor_stats_t *pStats = &pThread->stats;
+    struct epoll_event events[SAL_REACTOR_MAX_EVENTS];
+    sal_reactor_inst_t *pInst = NULL;
+    Cpa64U now = 0;
+    int n = 0;
+    int i = 0;
+
+    if (pThread->numPollMode)
+    {
+        struct itimerspec its = {{0, 0}, {0, 0}};
+        Cpa64U ns = pReactor->config.idlePollUs * SAL_REACTOR_NSEC_PER_USEC;
+
+        its.it_value.tv_sec = ns / SAL_REACTOR_NSEC_PER_SEC;
+        its.it_value.tv_nsec = ns % SAL_REACTOR_NSEC_PER_SEC;
+        if (0 == ns)
+        {
+            its.it_value.tv_nsec = 1;
+        }
+        timerfd_settime(pThread->tfd, 0, &its, NULL);
+    }
+
+    pStats->sleeps++;
+    n = epoll_wait(pThread->epfd, events, SAL_REACTOR_MAX_EVENTS, -1);
+
+    pthread_mutex_lock(&pThread->lock);
+    now = SalReactor_nowNs();
+    for (i = 0; i < n; i++)
+    {
+        sal_reactor_fd_t *pFd = events[i].data.ptr;
+        Cpa64U count = 0;
+
+        if (NULL == pFd)
+        {
+            /* Only clears the counter, the woken stack is taken below */
+            if (read(pThread->evfd, &count, sizeof(count)) < 0)
+            {
+                count = 0;
+            }
+        }
+        else if ((void *)&pThread->tfd == (void *)pFd)
+        {
+            if (read(pThread->tfd, &count, sizeof(count)) < 0)
+            {
+                count = 0;
+            }
+            /* One poll each, they arm again if still idle */
+            for (pInst = pThread->pInsts; NULL != pInst; pInst = pInst->pNext)
+            {
+                if (NULL == pInst->pFd && pInst->armed)
+                {
+                    SalReactor_wake(pThread, pInst, pInst->lastActiveNs);
+                    pStats->timerWakeups++;
+                }
+            }
+        }
+        else
+        {
+            for (pInst = pFd->pInsts; NULL != pInst; pInst = pInst->pNextOnFd)
+            {
+                if (pInst->armed)
+                {
+                    SalReactor_wake(pThread, pInst, now);
+                    pStats->irqWakeups++;
+                }
+            }
+        }
+    }
+    SalReactor_takeWoken(pThread, now);
+    pthread_mutex_unlock(&pThread->lock);
+}
+
+static void *SalReactor_thread(void *pArg)
+{
+    sal_reactor_thread_t *pThread = pArg;
+    sal_reactor_t *pReactor = pThread->pReactor;
+
+    while (!pReactor->stop)
+    {
+        Cpa32U busy = 0;
+
+        pthread_mutex_lock(&pThread->lock);
+        busy = SalReactor_pollPass(pThread);
+        pthread_mutex_unlock(&pThread->lock);
+        if (!busy && !pReactor->stop)
+        {
+            SalReactor_wait(pThread);
+        }
+    }
+    return NULL;
+}
+
+static void SalReactor_closeThread(sal_reactor_thread_t *pThread)
+{
+    if (pThread->epfd >= 0)
+    {
+        close(pThread->epfd);
+    }
+    if (pThread->evfd >= 0)
+    {
+        close(pThread->evfd);
+    }
+    if (pThread->tfd >= 0)
+    {
+        close(pThread->tfd);
+    }
+    pthread_mutex_destroy(&pThread->lock);
+}
+
+static CpaStatus SalReactor_openThread(sal_reactor_t *pReactor, Cpa32U idx)
+{
+    sal_reactor_thread_t *pThread = &pReactor->threads[idx];
+    struct epoll_event event;
+    pthread_attr_t attr;
+    int ret = 0;
+
+    pThread->pReactor = pReactor;
+    pThread->epfd = epoll_create1(EPOLL_CLOEXEC);
+    pThread->evfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    pThread->tfd =
+        timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    pthread_mutex_init(&pThread->lock, NULL);
+    if (pThread->epfd < 0 || pThread->evfd < 0 || pThread->tfd < 0)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(pThread->epfd, EPOLL_CTL_ADD, pThread->evfd, &event))
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    event.data.ptr = &pThread->tfd;
+    if (epoll_ctl(pThread->epfd, EPOLL_CTL_ADD, pThread->tfd, &event))
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+
+    pthread_attr_init(&attr);
+    if (pReactor->config.firstCore >= 0)
+    {
+        cpu_set_t cpus;
+
+        CPU_ZERO(&cpus);
+        CPU_SET(pReactor->config.firstCore + idx, &cpus);
+        pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+    ret = pthread_create(&pThread->tid, &attr, SalReactor_thread, pThread);
+    pthread_attr_destroy(&attr);
+    if (ret)
+    {
+        LAC_LOG_ERROR("Failed to create a reactor thread\n");
+        return CPA_STATUS_RESOURCE;
+    }
+    pThread->started = CPA_TRUE;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_ReactorCreate(const icp_sal_reactor_config_t *pConfig,
+                                icp_sal_reactor_handle_t *pReactor)
+{
+    icp_sal_reactor_config_t config = {1,
+                                       ICP_SAL_REACTOR_DEFAULT_BUSY_POLL_US,
+                                       ICP_SAL_REACTOR_DEFAULT_IDLE_POLL_US,
+                                       0,
+                                       -1};
+    sal_reactor_t *pNew = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    LAC_CHECK_NULL_PARAM(pReactor);
+    if (NULL != pConfig)
+    {
+        config = *pConfig;
+    }
+    if (0 == config.numThreads ||
+        config.numThreads > ICP_SAL_REACTOR_MAX_THREADS)
+    {
+        LAC_INVALID_PARAM_LOG("numThreads");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    status = LAC_OS_MALLOC(&pNew,
+                           sizeof(sal_reactor_t) +
+                               config.numThreads *
+                                   sizeof(sal_reactor_thread_t));
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    osalMemSet(pNew,
+               0,
+               sizeof(sal_reactor_t) +
+                   config.numThreads * sizeof(sal_reactor_thread_t));
+    pNew->config = config;
+    pNew->busyPollNs = config.busyPollUs * SAL_REACTOR_NSEC_PER_USEC;
+    pNew->createNs = SalReactor_nowNs();
+    pthread_mutex_init(&pNew->regLock, NULL);
+    for (i = 0; i < config.numThreads; i++)
+    {
+        pNew->threads[i].epfd = -1;
+        pNew->threads[i].evfd = -1;
+        pNew->threads[i].tfd = -1;
+    }
+
+    for (i = 0; i < config.numThreads && CPA_STATUS_SUCCESS == status; i++)
+    {
+        status = SalReactor_openThread(pNew, i);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        icp_sal_ReactorDestroy(pNew);
+        return status;
+    }
+    *pReactor = pNew;
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Removes an instance from its thread. Called with both locks held. */
+static void SalReactor_remove(sal_reactor_inst_t *pInst)
+{
+    sal_reactor_thread_t *pThread = pInst->pThread;
+    sal_reactor_inst_t **ppPrev = NULL;
+
+    /* The woken stack may still point at the instance */
+    SalReactor_takeWoken(pThread, SalReactor_nowNs());
+
+    if (pInst->pPrev)
+    {
+        pInst->pPrev->pNext = pInst->pNext;
+    }
+    else
+    {
+        pThread->pInsts = pInst->pNext;
+    }
+    if (pInst->pNext)
+    {
+        pInst->pNext->pPrev = pInst->pPrev;
+    }
+    pThread->numInsts--;
+    if (pInst->armed)
+    {
+        /* A notification running now must not push it again */
+        __atomic_store_n(&pInst->armed, CPA_FALSE, __ATOMIC_SEQ_CST);
+        pThread->numArmed--;
+    }
+
+    if (NULL == pInst->pFd)
+    {
+        pThread->numPollMode--;
+        return;
+    }
+    for (ppPrev = &pInst->pFd->pInsts; *ppPrev != pInst;
+         ppPrev = &(*ppPrev)->pNextOnFd)
+    {
+    }
+    *ppPrev = pInst->pNextOnFd;
+    if (NULL == pInst->pFd->pInsts)
+    {
+        sal_reactor_fd_t **ppFd = &pThread->pFds;
+
+        epoll_ctl(pThread->epfd, EPOLL_CTL_DEL, pInst->pFd->fd, NULL);
+        while (*ppFd != pInst->pFd)
+        {
+            ppFd = &(*ppFd)->pNext;
+        }
+        *ppFd = pInst->pFd->pNext;
+        LAC_OS_FREE(pInst->pFd);
+    }
+#ifndef ICP_DC_ONLY
+    if (!pInst->isDc)
+    {
+        icp_sal_CyPutFileDescriptor(pInst->instance, -1);
+        return;
+    }
+#endif
+    icp_sal_DcPutFileDescriptor(pInst->instance, -1);
+}
+
+CpaStatus icp_sal_ReactorDestroy(icp_sal_reactor_handle_t reactor)
+{
+    sal_reactor_t *pReactor = reactor;
+    Cpa32U i = 0;
+
+    LAC_CHECK_NULL_PARAM(pReactor);
+
+    __atomic_store_n(&pReactor->stop, CPA_TRUE, __ATOMIC_RELEASE);
+    for (i = 0; i < pReactor->config.numThreads; i++)
+    {
+        sal_reactor_thread_t *pThread = &pReactor->threads[i];
+
+        if (pThread->started)
+        {
+            SalReactor_kick(pThread);
+            pthread_join(pThread->tid, NULL);
+        }
+        while (NULL != pThread->pInsts)
+        {
+            sal_reactor_inst_t *pInst = pThread->pInsts;
+
+            SalReactor_remove(pInst);
+            LAC_OS_FREE(pInst);
+        }
+        SalReactor_closeThread(pThread);
+    }
+    pthread_mutex_destroy(&pReactor->regLock);
+    LAC_OS_FREE(pReactor);
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Finds the thread and descriptor entry of a new instance. Called with
+ * the registration lock held. */
+static sal_reactor_thread_t *SalReactor_place(sal_reactor_t *pReactor,
+                                              int fd,
+                                              sal_reactor_fd_t **ppFd)
+{
+    sal_reactor_thread_t *pBest = &pReactor->threads[0];
+    Cpa32U i = 0;
+
+    *ppFd = NULL;
+    for (i = 0; i < pReactor->config.numThreads; i++)
+    {
+        sal_reactor_thread_t *pThread = &pReactor->threads[i];
+        sal_reactor_fd_t *pFd = NULL;
+
+        for (pFd = pThread->pFds; fd >= 0 && NULL != pFd; pFd = pFd->pNext)
+        {
+            if (pFd->fd == fd)
+            {
+                *ppFd = pFd;
+                return pThread;
+            }
+        }
+        if (pThread->numInsts < pBest->numInsts)
+        {
+            pBest = pThread;
+        }
+    }
+    return pBest;
+}
+
+CpaStatus icp_sal_ReactorRegister(icp_sal_reactor_handle_t reactor,
+                                  CpaInstanceHandle instance,
+                                  icp_sal_reactor_entry_t *pEntry)
+{
+    sal_reactor_t *pReactor = reactor;
+    sal_service_t *pService = instance;
+    sal_reactor_thread_t *pThread = NULL;
+    sal_reactor_inst_t *pInst = NULL;
+    sal_reactor_fd_t *pFd = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    int fd = -1;
+
+    LAC_CHECK_NULL_PARAM(pReactor);
+    LAC_CHECK_NULL_PARAM(pService);
+    LAC_CHECK_NULL_PARAM(pEntry);
+
+    status = LAC_OS_MALLOC(&pInst, sizeof(sal_reactor_inst_t));
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    osalMemSet(pInst, 0, sizeof(sal_reactor_inst_t));
+    pInst->instance = instance;
+    pInst->isDc = SAL_SERVICE_TYPE_COMPRESSION == pService->type;
+#ifdef ICP_DC_ONLY
+    if (!pInst->isDc)
+    {
+        LAC_OS_FREE(pInst);
+        LAC_INVALID_PARAM_LOG("instance");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    status = icp_sal_DcGetFileDescriptor(instance, &fd);
+#else
+    status = pInst->isDc ? icp_sal_DcGetFileDescriptor(instance, &fd)
+                         : icp_sal_CyGetFileDescriptor(instance, &fd);
+#endif
+    if (CPA_STATUS_UNSUPPORTED == status)
+    {
+        /* Poll mode instance */
+        fd = -1;
+    }
+    else if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pInst);
+        return status;
+    }
+
+    pthread_mutex_lock(&pReactor->regLock);
+    pThread = SalReactor_place(pReactor, fd, &pFd);
+    if (fd >= 0 && NULL == pFd)
+    {
+        struct epoll_event event;
+
+        status = LAC_OS_MALLOC(&pFd, sizeof(sal_reactor_fd_t));
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            pthread_mutex_unlock(&pReactor->regLock);
+            LAC_OS_FREE(pInst);
+            return CPA_STATUS_RESOURCE;
+        }
+        osalMemSet(pFd, 0, sizeof(sal_reactor_fd_t));
+        pFd->fd = fd;
+        event.events = EPOLLIN | EPOLLET;
+        event.data.ptr = pFd;
+        if (epoll_ctl(pThread->epfd, EPOLL_CTL_ADD, fd, &event))
+        {
+            pthread_mutex_unlock(&pReactor->regLock);
+            LAC_LOG_ERROR("Failed to add an instance to the epoll set\n");
+            LAC_OS_FREE(pFd);
+            LAC_OS_FREE(pInst);
+            return CPA_STATUS_FAIL;
+        }
+        pthread_mutex_lock(&pThread->lock);
+        pFd->pNext = pThread->pFds;
+        pThread->pFds = pFd;
+    }
+    else
+    {
+        pthread_mutex_lock(&pThread->lock);
+    }
+
+    pInst->pThread = pThread;
+    pInst->pFd = pFd;
+    pInst->lastActiveNs = SalReactor_nowNs();
+    if (NULL != pFd)
+    {
+        pInst->pNextOnFd = pFd->pInsts;
+        pFd->pInsts = pInst;
+    }
+    else
+    {
+        pThread->numPollMode++;
+    }
+    pInst->pNext = pThread->pInsts;
+    if (pInst->pNext)
+    {
+        pInst->pNext->pPrev = pInst;
+    }
+    pThread->pInsts = pInst;
+    pThread->numInsts++;
+    pthread_mutex_unlock(&pThread->lock);
+    pthread_mutex_unlock(&pReactor->regLock);
+
+    SalReactor_kick(pThread);
+    *pEntry = pInst;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_ReactorUnregister(icp_sal_reactor_handle_t reactor,
+                                    icp_sal_reactor_entry_t entry)
+{
+    sal_reactor_t *pReactor = reactor;
+    sal_reactor_inst_t *pInst = entry;
+    sal_reactor_thread_t *pThread = NULL;
+
+    LAC_CHECK_NULL_PARAM(pReactor);
+    LAC_CHECK_NULL_PARAM(pInst);
+
+    pthread_mutex_lock(&pReactor->regLock);
+    pThread = pInst->pThread;
+    pthread_mutex_lock(&pThread->lock);
+    SalReactor_remove(pInst);
+    pthread_mutex_unlock(&pThread->lock);
+    pthread_mutex_unlock(&pReactor->regLock);
+
+    /* A notification that saw the instance armed before it was removed
+     * may still push it on the woken stack: wait for the ones running,
+     * then take it off before freeing it */
+    while (__atomic_load_n(&pInst->notifying, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+    pthread_mutex_lock(&pThread->lock);
+    SalReactor_takeWoken(pThread, SalReactor_nowNs());
+    pthread_mutex_unlock(&pThread->lock);
+    LAC_OS_FREE(pInst);
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_ReactorNotify(icp_sal_reactor_entry_t entry)
+{
+    sal_reactor_inst_t *pInst = entry;
+    sal_reactor_thread_t *pThread = NULL;
+    Cpa64U expected = 0;
+
+    LAC_CHECK_NULL_PARAM(pInst);
+
+    /* Keeps icp_sal_ReactorUnregister from freeing the instance until
+     * this call is done with it */
+    __atomic_add_fetch(&pInst->notifying, 1, __ATOMIC_SEQ_CST);
+
+    /* Only the oldest submission not yet seen completing is timed */
+    __atomic_compare_exchange_n(&pInst->notifyNs,
+                                &expected,
+                                SalReactor_nowNs(),
+                                CPA_FALSE,
+                                __ATOMIC_ACQ_REL,
+                                __ATOMIC_RELAXED);
+    if (__atomic_load_n(&pInst->armed, __ATOMIC_SEQ_CST) &&
+        !__atomic_exchange_n(&pInst->woken, CPA_TRUE, __ATOMIC_ACQ_REL))
+    {
+        pThread = pInst->pThread;
+        pInst->pNextWoken =
+            __atomic_load_n(&pThread->pWoken, __ATOMIC_ACQUIRE);
+        while (!__atomic_compare_exchange_n(&pThread->pWoken,
+                                            &pInst->pNextWoken,
+                                            pInst,
+                                            CPA_TRUE,
+                                            __ATOMIC_ACQ_REL,
+                                            __ATOMIC_ACQUIRE))
+        {
+        }
+        SalReactor_kick(pThread);
+    }
+    __atomic_sub_fetch(&pInst->notifying, 1, __ATOMIC_RELEASE);
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_ReactorQueryStats(icp_sal_reactor_handle_t reactor,
+                                    icp_sal_reactor_stats_t *pStats)
+{
+    sal_reactor_t *pReactor = reactor;
+    Cpa64U now = SalReactor_nowNs();
+    Cpa32U i = 0;
+    Cpa32U b = 0;
+
+    LAC_CHECK_NULL_PARAM(pReactor);
+    LAC_CHECK_NULL_PARAM(pStats);
+
+    osalMemSet(pStats, 0, sizeof(*pStats));
+    for (i = 0; i < pReactor->config.numThreads; i++)
+    {
+        sal_reactor_thread_t *pThread = &pReactor->threads[i];
+        icp_sal_reactor_stats_t *pT = &pThread->stats;
+        struct timespec ts;
+        clockid_t cid;
+
+        /* Read without the lock, counters may be a pass behind */
+        pStats->polls += pT->polls;
+        pStats->emptyPolls += pT->emptyPolls;
+        pStats->sleeps += pT->sleeps;
+        pStats->irqWakeups += pT->irqWakeups;
+        pStats->notifyWakeups += pT->notifyWakeups;
+        pStats->timerWakeups += pT->timerWakeups;
+        pStats->armed += pT->armed;
+        pStats->wakeLatencyCount += pT->wakeLatencyCount;
+        pStats->wakeLatencyTotalNs += pT->wakeLatencyTotalNs;
+        if (pT->wakeLatencyMaxNs > pStats->wakeLatencyMaxNs)
+        {
+            pStats->wakeLatencyMaxNs = pT->wakeLatencyMaxNs;
+        }
+        pStats->complLatencyCount += pT->complLatencyCount;
+        pStats->complLatencyTotalNs += pT->complLatencyTotalNs;
+        if (pT->complLatencyMaxNs > pStats->complLatencyMaxNs)
+        {
+            pStats->complLatencyMaxNs = pT->complLatencyMaxNs;
+        }
+        for (b = 0; b < ICP_SAL_REACTOR_LATENCY_BUCKETS; b++)
+        {
+            pStats->wakeLatencyHist[b] += pT->wakeLatencyHist[b];
+            pStats->complLatencyHist[b] += pT->complLatencyHist[b];
+        }
+        pStats->numInstances += pThread->numInsts;
+        pStats->numArmed += pThread->numArmed;
+        if (pThread->started && !pthread_getcpuclockid(pThread->tid, &cid) &&
+            !clock_gettime(cid, &ts))
+        {
+            pStats->cpuNs +=
+                (Cpa64U)ts.tv_sec * SAL_REACTOR_NSEC_PER_SEC + ts.tv_nsec;
+        }
+    }
+    pStats->wallNs = (now - pReactor->createNs) * pReactor->config.numThreads;
+    return CPA_STATUS_SUCCESS;
+}
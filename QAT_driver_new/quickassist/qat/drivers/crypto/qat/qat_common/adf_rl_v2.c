@@ -6,6 +6,7 @@
 #include "adf_common_drv.h"
 #include "adf_rl_v2.h"
 #include "adf_rl.h"
+#include "adf_rl_v2_calc.h"
 
 u32 rl_pci_to_vf_num(struct adf_user_sla *sla)
 {
@@ -730,20 +731,6 @@ int rl_v2_delete_user_node(struct adf_accel_dev *accel_dev,
 
 	return ret;
 }
-static bool rl_enough_sla_budget(struct rl_node_info *parent,
-				 struct adf_user_sla *sla)
-{
-	/* Check if less than sla of parent */
-	if (parent->rem_cir < sla->cir)
-		return false;
-
-	/* Check if less than sla of parent */
-	if (parent->max_pir < sla->pir)
-		return false;
-
-	return true;
-}
-
 static bool rl_enough_root_sla_budget(struct adf_accel_dev *accel_dev,
 				      struct rl_node_info *root,
 				      struct adf_user_sla *sla)
@@ -779,114 +766,24 @@ static void rl_update_req_buffer(struct adf_accel_dev *accel_dev,
 	req->svc_type = sla->svc_type;
 }
 
-static u32 rl_calculate_slice_tokens(struct adf_accel_dev *accel_dev,
-				     enum adf_svc_type svc_type, u32 ir)
-{
-	struct adf_hw_device_data *hw_data = accel_dev->hw_device;
-	u64 avail_slice_cycles = 0;
-	u64 allocated_tokens = 0;
-
-	if (!ir)
-		return 0;
-
-	/* Numbers of slice cycles over RL_SCANS_PER_SEC */
-	avail_slice_cycles = hw_data->clock_frequency;
-	avail_slice_cycles *= hw_data->get_slices_for_svc(accel_dev, svc_type);
-	avail_slice_cycles /= hw_data->rl_data.scan_interval;
-
-	switch (svc_type) {
-	case ADF_SVC_ASYM:
-		/* Percent of available tokens allocated */
-		allocated_tokens = avail_slice_cycles * ir /
-				   hw_data->rl_data.slice_reference;
-		break;
-	case ADF_SVC_NONE:
-		break;
-	default:
-		allocated_tokens = avail_slice_cycles * ir /
-				   hw_data->rl_data.max_throughput[svc_type];
-	}
-
-	return allocated_tokens;
-}
-
-static u32 rl_calculate_ae_cycles(struct adf_accel_dev *accel_dev,
-				  enum adf_svc_type svc_type, u32 ir)
-{
-	struct adf_hw_device_data *hw_data = accel_dev->hw_device;
-	u64 allocated_ae_cycles = 0;
-	u64 avail_ae_cycles = 0;
-
-	avail_ae_cycles = hw_data->clock_frequency;
-	avail_ae_cycles *= hw_data->get_num_svc_aes(accel_dev, svc_type);
-	avail_ae_cycles /= hw_data->rl_data.scan_interval;
-
-	if (!ir)
-		return 0;
-
-	switch (svc_type) {
-	case ADF_SVC_ASYM:
-		/* Scale for asym */
-		ir *= hw_data->rl_data.max_throughput[svc_type];
-		ir /= hw_data->rl_data.slice_reference;
-		allocated_ae_cycles =
-			((ir * avail_ae_cycles) /
-			 hw_data->rl_data.max_throughput[svc_type]);
-		break;
-	case ADF_SVC_NONE:
-		break;
-	default:
-		allocated_ae_cycles =
-			((ir * avail_ae_cycles) /
-			 hw_data->rl_data.max_throughput[svc_type]);
-	}
-
-	return allocated_ae_cycles;
-}
-
-static u32 rl_calculate_pci_bw(struct adf_accel_dev *accel_dev,
-			       enum adf_svc_type svc_type, u32 ir, bool bw_out)
+/* Collects the device parameters the budgets of a service derive from */
+static void rl_get_svc_params(struct adf_accel_dev *accel_dev,
+			      enum adf_svc_type svc_type,
+			      struct rl_v2_svc_params *params)
 {
 	struct adf_hw_device_data *hw_data = accel_dev->hw_device;
-	u64 sla_to_bytes = 0;
-	u64 allocated_bw = 0;
-	u64 sla_scaled = 0;
-
-	if (!ir)
-		return 0;
-
-	sla_to_bytes = ir;
 
-	switch (svc_type) {
-	case ADF_SVC_ASYM:
-		/* Scale for asym */
-		sla_to_bytes *= hw_data->rl_data.max_throughput[svc_type];
-		sla_to_bytes /= hw_data->rl_data.slice_reference;
-		sla_to_bytes *= RL_ASYM_TOKEN_SIZE;
-		break;
-	case ADF_SVC_NONE:
-		break;
-	case ADF_SVC_DC:
-		sla_to_bytes *= RL_CONVERT_TO_BYTES;
-		/*
-		 * As higher throughput for decompression
-		 * we multiple by (slice count minus correction)
-		 */
-		if (bw_out)
-			sla_to_bytes *= hw_data->get_slices_for_svc(accel_dev,
-								    svc_type) -
-					hw_data->rl_data.dc_correction;
-		break;
-	default:
-		sla_to_bytes *= RL_CONVERT_TO_BYTES;
-	}
-
-	sla_scaled = sla_to_bytes * hw_data->rl_data.pcie_scale_multiplier;
-	sla_scaled /= hw_data->rl_data.pcie_scale_divisor;
-	allocated_bw = sla_scaled / RL_TOKEN_PCIE_SIZE;
-	allocated_bw /= hw_data->rl_data.scan_interval;
-
-	return allocated_bw;
+	params->svc_type = svc_type;
+	params->clock_frequency = hw_data->clock_frequency;
+	params->num_slices = hw_data->get_slices_for_svc(accel_dev, svc_type);
+	params->num_aes = hw_data->get_num_svc_aes(accel_dev, svc_type);
+	params->scan_interval = hw_data->rl_data.scan_interval;
+	params->max_throughput = svc_type < ADF_SVC_NONE ?
+		hw_data->rl_data.max_throughput[svc_type] : 0;
+	params->slice_reference = hw_data->rl_data.slice_reference;
+	params->dc_correction = hw_data->rl_data.dc_correction;
+	params->pcie_scale_multiplier = hw_data->rl_data.pcie_scale_multiplier;
+	params->pcie_scale_divisor = hw_data->rl_data.pcie_scale_divisor;
 }
 
 static int rl_update_sla_buffer(
@@ -894,33 +791,27 @@ static int rl_update_sla_buffer(
 	struct icp_qat_fw_init_admin_sla_config_params *fw_config_params,
 	struct adf_user_sla *sla, struct rl_rings_info *fw_rings_info)
 {
+	struct rl_v2_svc_params params = { 0 };
+	struct rl_v2_budget budget = { 0 };
 	u32 i = 0;
+	int ret;
+
+	rl_get_svc_params(accel_dev, sla->svc_type, &params);
+	ret = rl_v2_calc_budget(&params, sla, &budget);
 
-	fw_config_params->pcie_in_cir =
-		rl_calculate_pci_bw(accel_dev, sla->svc_type, sla->cir, false);
-	fw_config_params->pcie_out_cir =
-		rl_calculate_pci_bw(accel_dev, sla->svc_type, sla->cir, true);
-	fw_config_params->pcie_in_pir =
-		rl_calculate_pci_bw(accel_dev, sla->svc_type, sla->pir, false);
-	fw_config_params->pcie_out_pir =
-		rl_calculate_pci_bw(accel_dev, sla->svc_type, sla->pir, true);
-
-	fw_config_params->slice_util_cir =
-		rl_calculate_slice_tokens(accel_dev, sla->svc_type, sla->cir);
-	fw_config_params->slice_util_pir =
-		rl_calculate_slice_tokens(accel_dev, sla->svc_type, sla->pir);
-
-	fw_config_params->ae_util_cir =
-		rl_calculate_ae_cycles(accel_dev, sla->svc_type, sla->cir);
-	fw_config_params->ae_util_pir =
-		rl_calculate_ae_cycles(accel_dev, sla->svc_type, sla->pir);
-
-	if (fw_config_params->pcie_in_cir == 0 ||
-	    fw_config_params->slice_util_cir == 0 ||
-	    fw_config_params->ae_util_cir == 0) {
+	fw_config_params->pcie_in_cir = budget.pcie_in_cir;
+	fw_config_params->pcie_out_cir = budget.pcie_out_cir;
+	fw_config_params->pcie_in_pir = budget.pcie_in_pir;
+	fw_config_params->pcie_out_pir = budget.pcie_out_pir;
+	fw_config_params->slice_util_cir = budget.slice_util_cir;
+	fw_config_params->slice_util_pir = budget.slice_util_pir;
+	fw_config_params->ae_util_cir = budget.ae_util_cir;
+	fw_config_params->ae_util_pir = budget.ae_util_pir;
+
+	if (ret) {
 		dev_err(&GET_DEV(accel_dev),
 			"Rate Limiting: SLA value too low\n");
-		return -EINVAL;
+		return ret;
 	}
 
 	if (sla->nodetype == ADF_NODE_LEAF) {
@@ -1078,8 +969,7 @@ static void rl_check_pir_to_cir(struct adf_accel_dev *accel_dev,
 				struct adf_user_sla *sla)
 {
 	/* User can't specify PIR less than CIR */
-	if (sla->pir < sla->cir) {
-		sla->pir = sla->cir;
+	if (rl_v2_fix_pir_to_cir(sla)) {
 		dev_warn(&GET_DEV(accel_dev),
 			 "Rate Limiting: PIR must be >= CIR, setting PIR to CIR automatically\n");
 	}
@@ -1094,16 +984,11 @@ static int rl_add_node_intree(struct adf_accel_dev *accel_dev,
 			      struct rl_node_info *new_node,
 			      struct adf_user_sla *sla)
 {
-	struct adf_hw_device_data *hw_data = accel_dev->hw_device;
-	u32 max_valid =
-		RL_VALIDATE_RET_MAX(sla->svc_type,
-		                    hw_data->rl_data.slice_reference,
-				    hw_data->rl_data.max_throughput[sla->svc_type]);
+	struct rl_v2_svc_params params = { 0 };
 	struct rl_node_info *parent = NULL;
 
-
-	if (RL_VALIDATE_IR(sla->cir, max_valid) ||
-	    RL_VALIDATE_IR(sla->pir, max_valid)) {
+	rl_get_svc_params(accel_dev, sla->svc_type, &params);
+	if (!rl_v2_sla_in_range(&params, sla)) {
 		dev_err(&GET_DEV(accel_dev),
 			"Rate Limiting: User input out of range\n");
 		return -EINVAL;
@@ -1149,7 +1034,7 @@ static int rl_add_node_intree(struct adf_accel_dev *accel_dev,
 	}
 
 	/* Get SLA feasibility, sum of sla of children is less parent's */
-	if (!rl_enough_sla_budget(parent, sla)) {
+	if (!rl_v2_enough_sla_budget(parent, sla)) {
 		dev_err(&GET_DEV(accel_dev),
 			"Rate Limiting: No SLA budget\n");
 		return -EPERM;
@@ -1164,12 +1049,7 @@ static int rl_add_node_intree(struct adf_accel_dev *accel_dev,
 	}
 
 	/* Add to tree */
-	new_node->parent = parent;
-	new_node->rem_cir = sla->cir;
-	new_node->max_pir = sla->pir;
-
-	/* Compute remaining sla after spending */
-	parent->rem_cir -= sla->cir;
+	rl_v2_attach_node(parent, new_node, sla);
 
 	return 0;
 }
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: (BSD-3-Clause OR GPL-2.0-only)
+/* Copyright(c) 2020 - 2024 Intel Corporation */
+
+#include "adf_rl_v2_calc.h"
+
+u32 rl_v2_calc_slice_tokens(const struct rl_v2_svc_params *params, u32 ir)
+{
+	u64 avail_slice_cycles = 0;
+	u64 allocated_tokens = 0;
+
+	if (!ir)
+		return 0;
+
+	/* Numbers of slice cycles over RL_SCANS_PER_SEC */
+	avail_slice_cycles = params->clock_frequency;
+	avail_slice_cycles *= params->num_slices;
+	avail_slice_cycles /= params->scan_interval;
+
+	switch (params->svc_type) {
+	case ADF_SVC_ASYM:
+		/* Percent of available tokens allocated */
+		allocated_tokens = avail_slice_cycles * ir /
+				   params->slice_reference;
+		break;
+	case ADF_SVC_NONE:
+		break;
+	default:
+		allocated_tokens = avail_slice_cycles * ir /
+				   params->max_throughput;
+	}
+
+	return allocated_tokens;
+}
+
+u32 rl_v2_calc_ae_cycles(const struct rl_v2_svc_params *params, u32 ir)
+{
+	u64 allocated_ae_cycles = 0;
+	u64 avail_ae_cycles = 0;
+
+	avail_ae_cycles = params->clock_frequency;
+	avail_ae_cycles *= params->num_aes;
+	avail_ae_cycles /= params->scan_interval;
+
+	if (!ir)
+		return 0;
+
+	switch (params->svc_type) {
+	case ADF_SVC_ASYM:
+		/* Scale for asym */
+		ir *= params->max_throughput;
+		ir /= params->slice_reference;
+		allocated_ae_cycles =
+			((ir * avail_ae_cycles) / params->max_throughput);
+		break;
+	case ADF_SVC_NONE:
+		break;
+	default:
+		allocated_ae_cycles =
+			((ir * avail_ae_cycles) / params->max_throughput);
+	}
+
+	return allocated_ae_cycles;
+}
+
+u32 rl_v2_calc_pci_bw(const struct rl_v2_svc_params *params, u32 ir,
+		      bool bw_out)
+{
+	u64 sla_to_bytes = 0;
+	u64 allocated_bw = 0;
+	u64 sla_scaled = 0;
+
+	if (!ir)
+		return 0;
+
+	sla_to_bytes = ir;
+
+	switch (params->svc_type) {
+	case ADF_SVC_ASYM:
+		/* Scale for asym */
+		sla_to_bytes *= params->max_throughput;
+		sla_to_bytes /= params->slice_reference;
+		sla_to_bytes *= RL_ASYM_TOKEN_SIZE;
+		break;
+	case ADF_SVC_NONE:
+		break;
+	case ADF_SVC_DC:
+		sla_to_bytes *= RL_CONVERT_TO_BYTES;
+		/*
+		 * As higher throughput for decompression
+		 * we multiple by (slice count minus correction)
+		 */
+		if (bw_out)
+			sla_to_bytes *= params->num_slices -
+					params->dc_correction;
+		break;
+	default:
+		sla_to_bytes *= RL_CONVERT_TO_BYTES;
+	}
+
+	sla_scaled = sla_to_bytes * params->pcie_scale_multiplier;
+	sla_scaled /= params->pcie_scale_divisor;
+	allocated_bw = sla_scaled / RL_TOKEN_PCIE_SIZE;
+	allocated_bw /= params->scan_interval;
+
+	return allocated_bw;
+}
+
+/*
+ * Fills in the firmware budgets of an SLA. Returns -EINVAL when the
+ * committed rate is too low to give a non zero budget.
+ */
+int rl_v2_calc_budget(const struct rl_v2_svc_params *params,
+		      const struct adf_user_sla *sla,
+		      struct rl_v2_budget *budget)
+{
+	budget->pcie_in_cir = rl_v2_calc_pci_bw(params, sla->cir, false);
+	budget->pcie_out_cir = rl_v2_calc_pci_bw(params, sla->cir, true);
+	budget->pcie_in_pir = rl_v2_calc_pci_bw(params, sla->pir, false);
+	budget->pcie_out_pir = rl_v2_calc_pci_bw(params, sla->pir, true);
+
+	budget->slice_util_cir = rl_v2_calc_slice_tokens(params, sla->cir);
+	budget->slice_util_pir = rl_v2_calc_slice_tokens(params, sla->pir);
+
+	budget->ae_util_cir = rl_v2_calc_ae_cycles(params, sla->cir);
+	budget->ae_util_pir = rl_v2_calc_ae_cycles(params, sla->pir);
+
+	if (budget->pcie_in_cir == 0 || budget->slice_util_cir == 0 ||
+	    budget->ae_util_cir == 0)
+		return -EINVAL;
+
+	return 0;
+}
+
+/* Checks the rates of an SLA against the maximum of the service */
+bool rl_v2_sla_in_range(const struct rl_v2_svc_params *params,
+			const struct adf_user_sla *sla)
+{
+	u32 max_valid = RL_VALIDATE_RET_MAX(params->svc_type,
+					    params->slice_reference,
+					    params->max_throughput);
+
+	return !(RL_VALIDATE_IR(sla->cir, max_valid) ||
+		 RL_VALIDATE_IR(sla->pir, max_valid));
+}
+
+bool rl_v2_enough_sla_budget(const struct rl_node_info *parent,
+			     const struct adf_user_sla *sla)
+{
+	/* Check if less than sla of parent */
+	if (parent->rem_cir < sla->cir)
+		return false;
+
+	/* Check if less than sla of parent */
+	if (parent->max_pir < sla->pir)
+		return false;
+
+	return true;
+}
+
+/* User can't specify PIR less than CIR, returns true if PIR was raised */
+bool rl_v2_fix_pir_to_cir(struct adf_user_sla *sla)
+{
+	if (sla->pir < sla->cir) {
+		sla->pir = sla->cir;
+		return true;
+	}
+
+	return false;
+}
+
+/* Adds node as a child of parent and spends its CIR from the parent */
+void rl_v2_attach_node(struct rl_node_info *parent,
+		       struct rl_node_info *node,
+		       const struct adf_user_sla *sla)
+{
+	node->parent = parent;
+	node->rem_cir = sla->cir;
+	node->max_pir = sla->pir;
+
+	/* Compute remaining sla after spending */
+	parent->rem_cir -= sla->cir;
+}
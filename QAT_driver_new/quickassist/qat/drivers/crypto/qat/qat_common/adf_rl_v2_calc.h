@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: (BSD-3-Clause OR GPL-2.0-only) */
+/* Copyright(c) 2020 - 2024 Intel Corporation */
+
+#ifndef ADF_RL_V2_CALC_H_
+#define ADF_RL_V2_CALC_H_
+
+/*
+ * Rate limiting v2 budget model. Turns CIR/PIR SLAs into the firmware
+ * budgets of a scan interval and accounts SLAs in the node tree. It only
+ * depends on plain integer math so it also builds in user space, where
+ * the SLA simulator uses it.
+ */
+#ifdef __KERNEL__
+#include <linux/types.h>
+#include <linux/errno.h>
+#else
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include "adf_kernel_types.h"
+#endif
+#include "adf_rl.h"
+#include "adf_rl_v2.h"
+
+/* Device parameters the budgets of a service are derived from */
+struct rl_v2_svc_params {
+	enum adf_svc_type svc_type;
+	u64 clock_frequency;
+	u32 num_slices; /* Slices serving the service */
+	u32 num_aes; /* Acceleration engines serving the service */
+	u32 scan_interval; /* Firmware scans per second */
+	u32 max_throughput; /* Max throughput of the service */
+	u32 slice_reference;
+	u32 dc_correction;
+	u32 pcie_scale_multiplier;
+	u32 pcie_scale_divisor;
+};
+
+/* Firmware budgets of an SLA for one scan interval */
+struct rl_v2_budget {
+	u32 pcie_in_cir;
+	u32 pcie_out_cir;
+	u32 pcie_in_pir;
+	u32 pcie_out_pir;
+	u32 slice_util_cir;
+	u32 slice_util_pir;
+	u32 ae_util_cir;
+	u32 ae_util_pir;
+};
+
+u32 rl_v2_calc_slice_tokens(const struct rl_v2_svc_params *params, u32 ir);
+u32 rl_v2_calc_ae_cycles(const struct rl_v2_svc_params *params, u32 ir);
+u32 rl_v2_calc_pci_bw(const struct rl_v2_svc_params *params, u32 ir,
+		      bool bw_out);
+int rl_v2_calc_budget(const struct rl_v2_svc_params *params,
+		      const struct adf_user_sla *sla,
+		      struct rl_v2_budget *budget);
+bool rl_v2_sla_in_range(const struct rl_v2_svc_params *params,
+			const struct adf_user_sla *sla);
+bool rl_v2_enough_sla_budget(const struct rl_node_info *parent,
+			     const struct adf_user_sla *sla);
+bool rl_v2_fix_pir_to_cir(struct adf_user_sla *sla);
+void rl_v2_attach_node(struct rl_node_info *parent,
+		       struct rl_node_info *node,
+		       const struct adf_user_sla *sla);
+
+#endif /* ADF_RL_V2_CALC_H_ */
@@ -0,0 +1,673 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+#include "layout_planner.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace layout
+{
+
+planner::planner(const spec& sp)
+    : sp(sp)
+    , align(false)
+{
+}
+
+void planner::set_align(bool align) { this->align = align; }
+
+const std::vector<tenant_plan>& planner::get_plans() const { return plans; }
+
+std::string planner::list_to_str(const std::vector<unsigned>& list)
+{
+    std::vector<unsigned> sorted(list);
+    std::stringstream ss;
+
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        size_t j = i;
+        while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1)
+            j++;
+        if (i)
+            ss << ",";
+        ss << sorted[i];
+        if (j > i)
+            ss << "-" << sorted[j];
+        i = j;
+    }
+    return ss.str();
+}
+
+/* adf_ctl hands the sections to the driver in std::map order and the
+ * driver walks them in that order, so banks are given out by name */
+std::vector<size_t> planner::section_order() const
+{
+    std::vector<size_t> order;
+
+    for (size_t i = 0; i < plans.size(); i++)
+        order.push_back(i);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return plans[a].t.section < plans[b].t.section;
+    });
+    return order;
+}
+
+std::vector<bank_service> planner::used_services() const
+{
+    std::vector<bank_service> used;
+
+    for (auto it = plans.begin(); it != plans.end(); ++it)
+    {
+        std::vector<bank_service> need = sp.needs(it->t.service);
+        for (auto n = need.begin(); n != need.end(); ++n)
+        {
+            if (std::find(used.begin(), used.end(), *n) == used.end())
+                used.push_back(*n);
+        }
+    }
+    return used;
+}
+
+unsigned planner::capacity(bank_service service) const
+{
+    unsigned slots = 0;
+
+    for (unsigned b = 0; b < sp.banks; b++)
+    {
+        std::vector<bank_slot> layout = sp.bank_layout(b);
+        for (auto it = layout.begin(); it != layout.end(); ++it)
+        {
+            if (it->service == service)
+                slots += it->instances;
+        }
+    }
+    return slots;
+}
+
+unsigned planner::demand(bank_service service, bool hot_only) const
+{
+    unsigned total = 0;
+
+    for (auto it = plans.begin(); it != plans.end(); ++it)
+    {
+        std::vector<bank_service> need = sp.needs(it->t.service);
+        if (hot_only && !it->hot)
+            continue;
+        if (std::find(need.begin(), need.end(), service) != need.end())
+            total += it->t.instances * it->t.processes;
+    }
+    return total;
+}
+
+unsigned planner::groups(bank_service service) const
+{
+    std::set<unsigned> seen;
+
+    for (unsigned b = 0; b < sp.banks; b++)
+    {
+        std::vector<bank_slot> layout = sp.bank_layout(b);
+        for (auto it = layout.begin(); it != layout.end(); ++it)
+        {
+            if (it->service == service)
+                seen.insert(sp.arb_group(b));
+        }
+    }
+    return seen.size();
+}
+
+void planner::classify()
+{
+    plans.clear();
+    for (auto it = sp.tenants.begin(); it != sp.tenants.end(); ++it)
+    {
+        tenant_plan p;
+        p.t = *it;
+        p.requested = it->instances;
+        p.hot = it->load_gbps >= sp.hot_gbps;
+        plans.push_back(p);
+    }
+}
+
+/* Takes one instance away from the biggest cold tenant using the
+ * service. Hot tenants keep what they asked for. */
+tenant_plan* planner::trim_cold(bank_service service, const std::string& why)
+{
+    tenant_plan* victim = NULL;
+
+    for (auto it = plans.begin(); it != plans.end(); ++it)
+    {
+        std::vector<bank_service> need = sp.needs(it->t.service);
+        if (it->hot || it->t.instances <= 1)
+            continue;
+        if (service != bank_service::NA
+            && std::find(need.begin(), need.end(), service) == need.end())
+            continue;
+        if (!victim
+            || it->t.instances * it->t.processes
+                   > victim->t.instances * victim->t.processes)
+            victim = &*it;
+    }
+    if (!victim)
+        return NULL;
+
+    victim->t.instances--;
+    victim->trimmed = why;
+    return victim;
+}
+
+void planner::fit_capacity()
+{
+    std::vector<bank_service> services = used_services();
+
+    for (auto s = services.begin(); s != services.end(); ++s)
+    {
+        unsigned cap = capacity(*s);
+        unsigned hot = demand(*s, true);
+
+        if (hot > cap)
+        {
+            throw std::runtime_error(
+                std::string("Hot tenants alone need ") + utils::to_string(hot)
+                + " " + spec::name(*s) + " instances, the device has "
+                + utils::to_string(cap));
+        }
+        while (demand(*s, false) > cap)
+        {
+            if (!trim_cold(*s,
+                           std::string("the device only has ")
+                               + utils::to_string(cap) + " "
+                               + spec::name(*s) + " instance slots"))
+            {
+                throw std::runtime_error(
+                    std::string("Tenants need ")
+                    + utils::to_string(demand(*s, false)) + " "
+                    + spec::name(*s) + " instances, the device has "
+                    + utils::to_string(cap));
+            }
+        }
+    }
+}
+
+/* Consecutive instances land on consecutive banks of their service, so
+ * a count that is a multiple of the arbiter groups spreads a hot tenant
+ * evenly. Only grow when it at most doubles the request and fits. */
+void planner::align_arbiters()
+{
+    for (auto it = plans.begin(); it != plans.end(); ++it)
+    {
+        std::vector<bank_service> need = sp.needs(it->t.service);
+        unsigned k = 0;
+
+        if (!it->hot || need.empty())
+            continue;
+        for (auto n = need.begin(); n != need.end(); ++n)
+            k = std::max(k, groups(*n));
+        if (k <= 1 || it->t.instances % k == 0)
+            continue;
+
+        unsigned target = (it->t.instances / k + 1) * k;
+        if (target > 2 * it->t.instances)
+            continue;
+
+        bool fits = true;
+        for (auto n = need.begin(); n != need.end(); ++n)
+        {
+            unsigned extra = (target - it->t.instances) * it->t.processes;
+            if (demand(*n, false) + extra > capacity(*n))
+                fits = false;
+        }
+        if (!fits)
+        {
+            notes.push_back(it->t.section + ": " + utils::to_string(
+                                it->t.instances)
+                            + " instances do not divide over "
+                            + utils::to_string(k)
+                            + " arbiter groups, no room to round up");
+            continue;
+        }
+        notes.push_back(it->t.section + ": hot, rounded up from "
+                        + utils::to_string(it->t.instances) + " to "
+                        + utils::to_string(target)
+                        + " instances so its load spreads over all "
+                        + utils::to_string(k) + " arbiter groups");
+        it->t.instances = target;
+    }
+}
+
+/* Replays adf_cfg_get_ring_pairs() for polled user instances: free
+ * banks are taken first, a used bank is only shared once no free bank
+ * is left, and each instance slot is handed out once. */
+bool planner::assign_banks()
+{
+    unsigned bundles_free = sp.banks;
+    std::vector<size_t> order = section_order();
+
+    banks.assign(sp.banks, bank_state());
+    for (unsigned b = 0; b < sp.banks; b++)
+    {
+        banks[b].free = sp.bank_layout(b);
+        banks[b].used = false;
+    }
+
+    for (auto o = order.begin(); o != order.end(); ++o)
+    {
+        tenant_plan& p = plans[*o];
+        std::vector<bank_service> need = sp.needs(p.t.service);
+        double inst_load =
+            p.t.load_gbps / (p.t.instances * p.t.processes * need.size());
+
+        p.places.clear();
+        for (unsigned proc = 0; proc < p.t.processes; proc++)
+        {
+            for (unsigned i = 0; i < p.t.instances; i++)
+            {
+                placement pl;
+                pl.process = proc;
+                pl.index = i;
+                for (auto n = need.begin(); n != need.end(); ++n)
+                {
+                    bool found = false;
+                    for (unsigned b = 0; b < sp.banks && !found; b++)
+                    {
+                        bank_state& bs = banks[b];
+                        if (bs.used && bundles_free)
+                            continue;
+                        for (auto s = bs.free.begin(); s != bs.free.end();
+                             ++s)
+                        {
+                            if (s->service != *n || !s->instances)
+                                continue;
+                            s->instances--;
+                            if (!bs.used)
+                            {
+                                bs.used = true;
+                                bundles_free--;
+                            }
+                            if (std::find(bs.owners.begin(),
+                                          bs.owners.end(),
+                                          *o) == bs.owners.end())
+                                bs.owners.push_back(*o);
+                            bs.load[*n] += inst_load;
+                            pl.banks.push_back(b);
+                            found = true;
+                            break;
+                        }
+                    }
+                    if (!found)
+                        return false;
+                }
+                p.places.push_back(pl);
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<unsigned> planner::hot_conflicts() const
+{
+    std::vector<unsigned> conflicts;
+
+    for (unsigned b = 0; b < banks.size(); b++)
+    {
+        unsigned hot = 0;
+
+        for (auto o = banks[b].owners.begin(); o != banks[b].owners.end();
+             ++o)
+            hot += plans[*o].hot ? 1 : 0;
+        if (hot > 1)
+            conflicts.push_back(b);
+    }
+    return conflicts;
+}
+
+/* Groups the shared banks by the hot tenants sharing them */
+std::vector<std::string> planner::describe_conflicts() const
+{
+    std::map<std::string, std::vector<unsigned>> groups;
+    std::vector<unsigned> conflicts = hot_conflicts();
+    std::vector<std::string> lines;
+
+    for (auto b = conflicts.begin(); b != conflicts.end(); ++b)
+    {
+        std::string names;
+        for (auto o = banks[*b].owners.begin(); o != banks[*b].owners.end();
+             ++o)
+        {
+            if (plans[*o].hot)
+                names += (names.empty() ? "" : ", ") + plans[*o].t.section;
+        }
+        groups[names].push_back(*b);
+    }
+    for (auto g = groups.begin(); g != groups.end(); ++g)
+        lines.push_back("banks " + list_to_str(g->second) + ": " + g->first);
+    return lines;
+}
+
+void planner::assign_cores()
+{
+    std::vector<int> local;
+    std::vector<int> remote;
+    std::vector<size_t> order;
+    size_t next = 0;
+
+    auto node = sp.nodes.find(sp.device_node);
+    for (auto c = node->second.begin(); c != node->second.end(); ++c)
+    {
+        if (std::find(sp.reserved.begin(), sp.reserved.end(), *c)
+            == sp.reserved.end())
+            local.push_back(*c);
+    }
+    for (auto n = sp.nodes.begin(); n != sp.nodes.end(); ++n)
+    {
+        if (n->first == sp.device_node)
+            continue;
+        for (auto c = n->second.begin(); c != n->second.end(); ++c)
+        {
+            if (std::find(sp.reserved.begin(), sp.reserved.end(), *c)
+                == sp.reserved.end())
+                remote.push_back(*c);
+        }
+    }
+    if (local.empty())
+    {
+        throw std::runtime_error("No usable core on device node "
+                                 + utils::to_string(sp.device_node));
+    }
+
+    /* Hot tenants first, heaviest first, each instance on its own core */
+    for (size_t i = 0; i < plans.size(); i++)
+        order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        if (plans[a].hot != plans[b].hot)
+            return plans[a].hot;
+        return plans[a].t.load_gbps > plans[b].t.load_gbps;
+    });
+
+    size_t remote_next = 0;
+    for (auto o = order.begin(); o != order.end(); ++o)
+    {
+        tenant_plan& p = plans[*o];
+        std::vector<unsigned> spilled, doubled;
+
+        p.cores.clear();
+        if (p.t.node >= 0 && p.t.node != sp.device_node)
+        {
+            warnings.push_back(
+                p.t.section + ": declared on node "
+                + utils::to_string(p.t.node) + " but the device is on node "
+                + utils::to_string(sp.device_node)
+                + ", pin its processes to node "
+                + utils::to_string(sp.device_node)
+                + " or every request crosses the socket link");
+        }
+        for (unsigned i = 0; i < p.t.instances; i++)
+        {
+            if (!p.hot)
+            {
+                /* Cold tenants share what the hot ones left */
+                size_t pool = local.size() - std::min(next, local.size());
+                if (pool)
+                    p.cores.push_back(local[next + i % pool]);
+                else
+                    p.cores.push_back(local[i % local.size()]);
+                continue;
+            }
+            if (next < local.size())
+            {
+                p.cores.push_back(local[next++]);
+            }
+            else if (remote_next < remote.size())
+            {
+                p.cores.push_back(remote[remote_next++]);
+                spilled.push_back(p.cores.back());
+            }
+            else
+            {
+                p.cores.push_back(local[i % local.size()]);
+                doubled.push_back(p.cores.back());
+            }
+        }
+        if (!spilled.empty())
+            warnings.push_back(p.t.section + ": out of local cores, "
+                               + "instances placed on remote cores "
+                               + list_to_str(spilled));
+        if (!doubled.empty())
+            warnings.push_back(p.t.section + ": no free core left, "
+                               + "instances share cores "
+                               + list_to_str(doubled));
+        if (p.hot && p.t.processes > 1)
+        {
+            notes.push_back(p.t.section + ": CoreAffinity is per instance "
+                                          "index, its "
+                            + utils::to_string(p.t.processes)
+                            + " processes share the same cores");
+        }
+    }
+    if (next >= local.size())
+        notes.push_back("hot tenants use every local core, cold tenants "
+                        "share them");
+}
+
+void planner::run()
+{
+    notes.clear();
+    warnings.clear();
+    classify();
+    fit_capacity();
+    if (align)
+        align_arbiters();
+
+    /* Cold tenants given banks ahead of the hot ones push the hot ones
+     * into sharing; trim them for as long as it reduces the overlap */
+    bool fits = assign_banks();
+    std::vector<unsigned> conflicts =
+        fits ? hot_conflicts() : std::vector<unsigned>();
+    while (!fits || !conflicts.empty())
+    {
+        tenant_plan* victim = trim_cold(
+            bank_service::NA,
+            fits ? std::string("hot tenants were sharing banks")
+                 : std::string("the kernel would run out of rings"));
+        if (!victim)
+        {
+            if (!fits)
+                throw std::runtime_error("Instances do not fit the banks");
+            break;
+        }
+
+        bool now_fits = assign_banks();
+        std::vector<unsigned> now =
+            now_fits ? hot_conflicts() : std::vector<unsigned>();
+        if (fits && (!now_fits || now.size() >= conflicts.size()))
+        {
+            victim->t.instances++;
+            if (victim->t.instances == victim->requested)
+                victim->trimmed.clear();
+            assign_banks();
+            break;
+        }
+        fits = now_fits;
+        conflicts = now;
+    }
+
+    std::vector<std::string> shared = describe_conflicts();
+    for (auto c = shared.begin(); c != shared.end(); ++c)
+        warnings.push_back("hot tenants share " + *c);
+
+    for (auto it = plans.begin(); it != plans.end(); ++it)
+    {
+        if (it->t.instances < it->requested)
+            notes.push_back(it->t.section + ": cold, trimmed from "
+                            + utils::to_string(it->requested) + " to "
+                            + utils::to_string(it->t.instances)
+                            + " instances per process, " + it->trimmed);
+    }
+    assign_cores();
+}
+
+bool planner::clean() const { return hot_conflicts().empty(); }
+
+void planner::explain(std::ostream& os) const
+{
+    std::vector<bank_service> services = used_services();
+    auto node = sp.nodes.find(sp.device_node);
+
+    os << "Device " << sp.profile->name << ", " << sp.banks << " banks, "
+       << "ServicesEnabled " << sp.services << ", on node " << sp.device_node
+       << " (" << node->second.size() << " cores)\n";
+    for (auto s = services.begin(); s != services.end(); ++s)
+    {
+        os << "  " << std::left << std::setw(5) << spec::name(*s)
+           << " instance slots " << capacity(*s) << ", used "
+           << demand(*s, false) << " (hot " << demand(*s, true) << ")\n";
+    }
+
+    os << "\nTenants (sections are given banks in name order):\n";
+    std::vector<size_t> order = section_order();
+    for (auto o = order.begin(); o != order.end(); ++o)
+    {
+        const tenant_plan& p = plans[*o];
+        std::vector<unsigned> bank_list, core_list;
+
+        for (auto pl = p.places.begin(); pl != p.places.end(); ++pl)
+            bank_list.insert(bank_list.end(), pl->banks.begin(),
+                             pl->banks.end());
+        for (auto c = p.cores.begin(); c != p.cores.end(); ++c)
+            core_list.push_back(*c);
+
+        os << "  " << std::left << std::setw(12) << p.t.section << " "
+           << (p.t.service == tenant_service::CY ? "cy" : "dc") << " "
+           << (p.hot ? "hot " : "cold") << " " << p.t.instances << "x"
+           << p.t.processes << " " << std::fixed << std::setprecision(1)
+           << p.t.load_gbps << " Gbps  cores " << list_to_str(core_list)
+           << "  banks " << list_to_str(bank_list) << "\n";
+    }
+
+    for (auto s = services.begin(); s != services.end(); ++s)
+    {
+        std::map<unsigned, double> load;
+        std::map<unsigned, unsigned> count;
+        double max = 0, sum = 0;
+
+        for (unsigned b = 0; b < banks.size(); b++)
+        {
+            for (auto sl = banks[b].free.begin(); sl != banks[b].free.end();
+                 ++sl)
+            {
+                if (sl->service != *s)
+                    continue;
+                auto bl = banks[b].load.find(*s);
+                if (bl != banks[b].load.end())
+                    load[sp.arb_group(b)] += bl->second;
+                count[sp.arb_group(b)] += banks[b].used ? 1 : 0;
+            }
+        }
+        for (auto l = load.begin(); l != load.end(); ++l)
+        {
+            max = std::max(max, l->second);
+            sum += l->second;
+        }
+        os << "\nArbiter groups serving " << spec::name(*s) << ": "
+           << load.size();
+        if (sum > 0)
+            os << ", busiest at " << std::setprecision(2)
+               << max * load.size() / sum << "x the mean";
+        os << "\n";
+        if (load.size() <= 8)
+        {
+            for (auto l = load.begin(); l != load.end(); ++l)
+                os << "  group " << l->first << ": " << count[l->first]
+                   << " banks, " << std::setprecision(1) << l->second
+                   << " Gbps\n";
+        }
+    }
+
+    os << "\nDecisions:\n";
+    os << "  - hot means at least " << std::setprecision(1) << sp.hot_gbps
+       << " Gbps; hot instances get dedicated cores on node "
+       << sp.device_node << "\n";
+    for (auto n = notes.begin(); n != notes.end(); ++n)
+        os << "  - " << *n << "\n";
+
+    std::vector<unsigned> conflicts = hot_conflicts();
+    unsigned shared = 0;
+    for (auto b = banks.begin(); b != banks.end(); ++b)
+        shared += b->owners.size() > 1 ? 1 : 0;
+    os << "  - " << shared << " bank(s) shared between sections, "
+       << conflicts.size() << " between hot tenants\n";
+
+    if (!warnings.empty())
+    {
+        os << "\nWarnings:\n";
+        for (auto w = warnings.begin(); w != warnings.end(); ++w)
+            os << "  ! " << *w << "\n";
+    }
+}
+
+} // namespace layout
@@ -0,0 +1,155 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+#ifndef LAYOUT_PLANNER_H
+#define LAYOUT_PLANNER_H
+
+#include "layout_spec.h"
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace layout
+{
+
+/* One instance of one process and the banks the kernel will give it */
+struct placement
+{
+    unsigned process;
+    unsigned index;
+    std::vector<unsigned> banks;
+};
+
+struct tenant_plan
+{
+    tenant t;
+    unsigned requested;
+    bool hot;
+    std::string trimmed;
+    /* Core of each instance index, shared by all processes */
+    std::vector<int> cores;
+    std::vector<placement> places;
+};
+
+class planner
+{
+public:
+    explicit planner(const spec& sp);
+
+    /* Rounds hot tenants up to a multiple of their arbiter groups */
+    void set_align(bool align);
+
+    /* Computes the layout. Throws std::runtime_error when the request
+     * cannot fit the device even after trimming the cold tenants. */
+    void run();
+
+    /* Prints the layout and the reason behind every decision */
+    void explain(std::ostream& os) const;
+
+    /* True when no bank is shared between two hot tenants */
+    bool clean() const;
+
+    const std::vector<tenant_plan>& get_plans() const;
+
+private:
+    planner();
+    planner(planner&);
+    planner& operator=(planner&);
+
+    struct bank_state
+    {
+        std::vector<bank_slot> free;
+        std::vector<size_t> owners;
+        bool used;
+        std::map<bank_service, double> load;
+    };
+
+    void classify();
+    void fit_capacity();
+    void align_arbiters();
+    bool assign_banks();
+    tenant_plan* trim_cold(bank_service service, const std::string& why);
+    void assign_cores();
+    std::vector<unsigned> hot_conflicts() const;
+    std::vector<std::string> describe_conflicts() const;
+
+    unsigned capacity(bank_service service) const;
+    unsigned demand(bank_service service, bool hot_only) const;
+    unsigned groups(bank_service service) const;
+    std::vector<bank_service> used_services() const;
+    std::vector<size_t> section_order() const;
+
+    static std::string list_to_str(const std::vector<unsigned>& list);
+
+    const spec& sp;
+    bool align;
+    std::vector<tenant_plan> plans;
+    std::vector<bank_state> banks;
+    std::vector<std::string> notes;
+    std::vector<std::string> warnings;
+};
+
+} // namespace layout
+
+#endif // LAYOUT_PLANNER_H
@@ -0,0 +1,542 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+#include "layout_spec.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace layout
+{
+
+static const char* sysfs_node_dir = "/sys/devices/system/node";
+static const unsigned num_slots = 4;
+static const double default_hot_gbps = 10.0;
+
+static const device_profile profiles[] = {
+    /* name, banks, rings per bank, slot per bank, arbiter groups */
+    { "4xxx", 64, 2, true, 4 },
+    { "c6xx", 16, 16, false, 16 },
+};
+
+/* Ring pair slot to service map per ServicesEnabled value. The gen4
+ * entries mirror the ADF_4XXX_* masks, the gen2 ones the default map
+ * (the kernel skips rings of a service that is not enabled). Keys are
+ * the sorted form of the services string. */
+static const struct
+{
+    bool gen4;
+    const char* services;
+    bank_service slot[num_slots];
+} svc_maps[] = {
+    { true,
+      "dc",
+      { bank_service::COMP,
+        bank_service::COMP,
+        bank_service::COMP,
+        bank_service::COMP } },
+    { true,
+      "sym",
+      { bank_service::SYM,
+        bank_service::SYM,
+        bank_service::SYM,
+        bank_service::SYM } },
+    { true,
+      "asym",
+      { bank_service::ASYM,
+        bank_service::ASYM,
+        bank_service::ASYM,
+        bank_service::ASYM } },
+    { true,
+      "asym;sym",
+      { bank_service::ASYM,
+        bank_service::SYM,
+        bank_service::ASYM,
+        bank_service::SYM } },
+    { true,
+      "asym;dc",
+      { bank_service::ASYM,
+        bank_service::ASYM,
+        bank_service::COMP,
+        bank_service::COMP } },
+    { true,
+      "dc;sym",
+      { bank_service::SYM,
+        bank_service::SYM,
+        bank_service::COMP,
+        bank_service::COMP } },
+    { false,
+      "cy;dc",
+      { bank_service::CRYPTO,
+        bank_service::CRYPTO,
+        bank_service::NA,
+        bank_service::COMP } },
+    { false,
+      "cy",
+      { bank_service::CRYPTO,
+        bank_service::CRYPTO,
+        bank_service::NA,
+        bank_service::NA } },
+    { false,
+      "dc",
+      { bank_service::NA,
+        bank_service::NA,
+        bank_service::NA,
+        bank_service::COMP } },
+};
+
+static std::string line_error(unsigned line, const std::string& msg)
+{
+    return std::string("line ") + utils::to_string(line) + ": " + msg;
+}
+
+static unsigned to_unsigned(const std::string& s, unsigned line)
+{
+    if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos)
+    {
+        throw std::runtime_error(
+            line_error(line, "\"" + s + "\" is not a number"));
+    }
+    return utils::to_number<unsigned>(s);
+}
+
+static double to_double(const std::string& s, unsigned line)
+{
+    std::stringstream ss(s);
+    double val = 0;
+
+    ss >> val;
+    if (ss.fail() || !ss.eof() || val < 0)
+    {
+        throw std::runtime_error(
+            line_error(line, "\"" + s + "\" is not a valid load"));
+    }
+    return val;
+}
+
+spec::spec()
+    : profile(&profiles[0])
+    , banks(profiles[0].banks)
+    , device_node(0)
+    , services("dc")
+    , hot_gbps(default_hot_gbps)
+{
+    set_services(services, 0);
+}
+
+const char* spec::name(bank_service s)
+{
+    switch (s)
+    {
+        case bank_service::CRYPTO:
+            return "cy";
+        case bank_service::COMP:
+            return "dc";
+        case bank_service::SYM:
+            return "sym";
+        case bank_service::ASYM:
+            return "asym";
+        case bank_service::NA:
+            break;
+    }
+    return "na";
+}
+
+std::vector<int> spec::parse_cpulist(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+
+    while (getline(ss, range, ','))
+    {
+        utils::remove_whitespaces(range);
+        if (range.empty())
+            continue;
+
+        size_t dash = range.find('-');
+        std::string first = range.substr(0, dash);
+        std::string last =
+            dash == std::string::npos ? first : range.substr(dash + 1);
+        if (first.empty() || last.empty()
+            || first.find_first_not_of("0123456789") != std::string::npos
+            || last.find_first_not_of("0123456789") != std::string::npos)
+        {
+            throw std::runtime_error("Invalid cpu list \"" + list + "\"");
+        }
+
+        int lo = utils::to_number<int>(first);
+        int hi = utils::to_number<int>(last);
+        if (lo > hi || hi >= max_nr_cpus)
+        {
+            throw std::runtime_error("Invalid cpu range \"" + range + "\"");
+        }
+        for (int cpu = lo; cpu <= hi; cpu++)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+void spec::set_services(const std::string& val, unsigned line)
+{
+    std::vector<std::string> tokens;
+    std::stringstream ss(val);
+    std::string token, key;
+
+    while (getline(ss, token, ';'))
+    {
+        if (!token.empty())
+            tokens.push_back(token);
+    }
+    std::sort(tokens.begin(), tokens.end());
+    for (size_t i = 0; i < tokens.size(); i++)
+        key += (i ? ";" : "") + tokens[i];
+
+    for (size_t i = 0; i < sizeof(svc_maps) / sizeof(svc_maps[0]); i++)
+    {
+        if (svc_maps[i].gen4 == profile->slot_per_bank
+            && key == svc_maps[i].services)
+        {
+            services = val;
+            slots.assign(svc_maps[i].slot, svc_maps[i].slot + num_slots);
+            return;
+        }
+    }
+    throw std::runtime_error(line_error(line,
+                                        "unsupported ServicesEnabled \"" + val
+                                            + "\" for " + profile->name));
+}
+
+void spec::set_device(const std::string& val, unsigned line)
+{
+    for (size_t i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++)
+    {
+        if (val == profiles[i].name)
+        {
+            profile = &profiles[i];
+            banks = profile->banks;
+            /* Keep the requested services if the family supports them */
+            try
+            {
+                set_services(services, line);
+            }
+            catch (std::runtime_error&)
+            {
+                set_services(profile->slot_per_bank ? "dc" : "cy;dc", line);
+            }
+            return;
+        }
+    }
+    throw std::runtime_error(
+        line_error(line, "unknown device family \"" + val + "\""));
+}
+
+std::vector<bank_slot> spec::bank_layout(unsigned bank) const
+{
+    std::vector<bank_slot> layout;
+
+    if (profile->slot_per_bank)
+    {
+        bank_slot slot = { slots[bank % num_slots],
+                           profile->rings_per_bank / 2 };
+        layout.push_back(slot);
+        return layout;
+    }
+
+    /* Same walk as adf_cfg_init_and_insert_inst(): a crypto instance
+     * takes two ring pair slots (asym and sym) */
+    unsigned per_srv = profile->rings_per_bank / (2 * num_slots);
+    for (unsigned i = 0; i < num_slots; i++)
+    {
+        if (slots[i] != bank_service::NA)
+        {
+            bank_slot slot = { slots[i], per_srv };
+            layout.push_back(slot);
+        }
+        if (slots[i] == bank_service::CRYPTO)
+            i++;
+    }
+    return layout;
+}
+
+std::vector<bank_service> spec::needs(tenant_service service) const
+{
+    std::vector<bank_service> need;
+
+    if (service == tenant_service::DC)
+    {
+        need.push_back(bank_service::COMP);
+        return need;
+    }
+    if (!profile->slot_per_bank)
+    {
+        need.push_back(bank_service::CRYPTO);
+        return need;
+    }
+
+    /* On gen4 a cy instance gets one asym and one sym bank */
+    bool asym = std::find(slots.begin(), slots.end(), bank_service::ASYM)
+                != slots.end();
+    bool sym = std::find(slots.begin(), slots.end(), bank_service::SYM)
+               != slots.end();
+    if (asym)
+        need.push_back(bank_service::ASYM);
+    if (sym)
+        need.push_back(bank_service::SYM);
+    return need;
+}
+
+unsigned spec::arb_group(unsigned bank) const
+{
+    return bank % profile->arb_groups;
+}
+
+void spec::read(const std::string& filename)
+{
+    std::ifstream ifs(filename.c_str(), std::ifstream::in);
+    std::string line;
+    unsigned lineNum = 0;
+
+    if (!ifs.good())
+    {
+        throw std::runtime_error(std::string("Filename ") + filename
+                                 + " cannot be read");
+    }
+
+    while (getline(ifs, line))
+    {
+        std::vector<std::string> words;
+        std::string word;
+
+        lineNum++;
+        line = line.substr(0, line.find('#'));
+        std::stringstream ss(line);
+        while (ss >> word)
+            words.push_back(word);
+        if (words.empty())
+            continue;
+
+        if (words[0] == "device")
+        {
+            if (words.size() < 2 || words.size() % 2)
+                throw std::runtime_error(line_error(
+                    lineNum, "usage: device <name> [banks <n>] [node <id>]"));
+            set_device(words[1], lineNum);
+            for (size_t i = 2; i < words.size(); i += 2)
+            {
+                if (words[i] == "banks")
+                    banks = to_unsigned(words[i + 1], lineNum);
+                else if (words[i] == "node")
+                    device_node = to_unsigned(words[i + 1], lineNum);
+                else
+                    throw std::runtime_error(line_error(
+                        lineNum, "unknown device attribute " + words[i]));
+            }
+        }
+        else if (words[0] == "services" && words.size() == 2)
+        {
+            set_services(words[1], lineNum);
+        }
+        else if (words[0] == "node" && words.size() >= 3)
+        {
+            std::string list;
+            for (size_t i = 2; i < words.size(); i++)
+                list += words[i];
+            nodes[to_unsigned(words[1], lineNum)] = parse_cpulist(list);
+        }
+        else if (words[0] == "reserve" && words.size() >= 2)
+        {
+            std::string list;
+            for (size_t i = 1; i < words.size(); i++)
+                list += words[i];
+            std::vector<int> cpus = parse_cpulist(list);
+            reserved.insert(reserved.end(), cpus.begin(), cpus.end());
+        }
+        else if (words[0] == "hot" && words.size() == 2)
+        {
+            hot_gbps = to_double(words[1], lineNum);
+        }
+        else if (words[0] == "tenant"
+                 && (words.size() == 6 || words.size() == 8))
+        {
+            tenant t;
+
+            t.section = words[1];
+            if (words[2] == "cy")
+                t.service = tenant_service::CY;
+            else if (words[2] == "dc")
+                t.service = tenant_service::DC;
+            else
+                throw std::runtime_error(line_error(
+                    lineNum, "tenant service must be cy or dc"));
+            t.instances = to_unsigned(words[3], lineNum);
+            t.processes = to_unsigned(words[4], lineNum);
+            t.load_gbps = to_double(words[5], lineNum);
+            t.node = -1;
+            t.line = lineNum;
+            if (words.size() == 8)
+            {
+                if (words[6] != "node")
+                    throw std::runtime_error(line_error(
+                        lineNum, "unknown tenant attribute " + words[6]));
+                t.node = to_unsigned(words[7], lineNum);
+            }
+            if (!t.instances || !t.processes)
+                throw std::runtime_error(line_error(
+                    lineNum, "a tenant needs at least one instance"));
+            tenants.push_back(t);
+        }
+        else
+        {
+            throw std::runtime_error(
+                line_error(lineNum, "cannot parse \"" + line + "\""));
+        }
+    }
+}
+
+void spec::read_sysfs_topology()
+{
+    DIR* dir = opendir(sysfs_node_dir);
+    struct dirent* entry;
+
+    if (!dir)
+    {
+        throw std::runtime_error(std::string("Cannot open ")
+                                 + sysfs_node_dir);
+    }
+
+    nodes.clear();
+    while ((entry = readdir(dir)) != NULL)
+    {
+        std::string name(entry->d_name);
+        std::string list;
+
+        if (name.compare(0, 4, "node") || name.size() == 4
+            || name.find_first_not_of("0123456789", 4) != std::string::npos)
+            continue;
+
+        std::ifstream ifs((std::string(sysfs_node_dir) + "/" + name
+                           + "/cpulist").c_str());
+        if (!getline(ifs, list) || list.empty())
+            continue;
+        nodes[utils::to_number<int>(name.substr(4))] = parse_cpulist(list);
+    }
+    closedir(dir);
+}
+
+void spec::validate() const
+{
+    std::set<std::string> names;
+    bool cy = false, dc = false;
+
+    for (auto it = slots.begin(); it != slots.end(); ++it)
+    {
+        cy |= *it == bank_service::SYM || *it == bank_service::ASYM
+              || *it == bank_service::CRYPTO;
+        dc |= *it == bank_service::COMP;
+    }
+
+    if (!banks || banks % num_slots || banks > profile->banks)
+    {
+        throw std::runtime_error(
+            "Number of banks must be a multiple of "
+            + utils::to_string(num_slots) + " and at most "
+            + utils::to_string(profile->banks) + " on " + profile->name);
+    }
+    if (nodes.find(device_node) == nodes.end())
+    {
+        throw std::runtime_error("Device node "
+                                 + utils::to_string(device_node)
+                                 + " has no cores in the topology");
+    }
+    if (tenants.empty())
+    {
+        throw std::runtime_error("No tenant to lay out");
+    }
+
+    for (auto it = tenants.begin(); it != tenants.end(); ++it)
+    {
+        if (!names.insert(it->section).second)
+            throw std::runtime_error(line_error(
+                it->line, "section " + it->section + " defined twice"));
+        if (it->section == "GENERAL" || it->section == "KERNEL"
+            || it->section == "SIOV" || it->section == "INLINE")
+            throw std::runtime_error(line_error(
+                it->line, it->section + " is a reserved section name"));
+        if (it->service == tenant_service::CY && !cy)
+            throw std::runtime_error(line_error(
+                it->line, "cy tenant but no crypto service enabled"));
+        if (it->service == tenant_service::DC && !dc)
+            throw std::runtime_error(line_error(
+                it->line, "dc tenant but dc service is not enabled"));
+        if (it->node >= 0 && nodes.find(it->node) == nodes.end())
+            throw std::runtime_error(
+                line_error(it->line, "unknown node for tenant"));
+    }
+}
+
+} // namespace layout
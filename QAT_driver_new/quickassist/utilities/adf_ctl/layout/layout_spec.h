@@ -0,0 +1,166 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+#ifndef LAYOUT_SPEC_H
+#define LAYOUT_SPEC_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace layout
+{
+
+/* Service types a ring bank can serve, same values as the kernel's
+ * adf_cfg_service_type so the maps below read like the driver ones */
+enum class bank_service
+{
+    NA = 0,
+    CRYPTO,
+    COMP,
+    SYM,
+    ASYM
+};
+
+enum class tenant_service
+{
+    CY,
+    DC
+};
+
+/* Instances of one service a bank can host */
+struct bank_slot
+{
+    bank_service service;
+    unsigned instances;
+};
+
+/* Ring to service layout of a device family */
+struct device_profile
+{
+    const char* name;
+    unsigned banks;
+    unsigned rings_per_bank;
+    /* true: bank n serves only ring pair slot n % 4 (gen4),
+     * false: every bank carries all four slots (gen2) */
+    bool slot_per_bank;
+    /* Number of arbiter groups banks are spread over */
+    unsigned arb_groups;
+};
+
+struct tenant
+{
+    std::string section;
+    tenant_service service;
+    unsigned instances;
+    unsigned processes;
+    double load_gbps;
+    int node;
+    unsigned line;
+};
+
+class spec
+{
+public:
+    spec();
+
+    /* Reads the layout request from a file. Throws std::runtime_error
+     * with the offending line on malformed input. */
+    void read(const std::string& filename);
+
+    /* Replaces the node list with /sys/devices/system/node topology */
+    void read_sysfs_topology();
+
+    /* Checks cross references (service vs tenants, nodes, duplicates) */
+    void validate() const;
+
+    /* Instance slots the kernel creates on a bank, in ring pair order */
+    std::vector<bank_slot> bank_layout(unsigned bank) const;
+
+    /* Bank services one instance of the tenant consumes */
+    std::vector<bank_service> needs(tenant_service service) const;
+
+    unsigned arb_group(unsigned bank) const;
+
+    const device_profile* profile;
+    unsigned banks;
+    int device_node;
+    std::string services;
+    double hot_gbps;
+    std::vector<int> reserved;
+    std::map<int, std::vector<int>> nodes;
+    std::vector<tenant> tenants;
+
+    static std::vector<int> parse_cpulist(const std::string& list);
+    static const char* name(bank_service s);
+
+private:
+    void set_device(const std::string& val, unsigned line);
+    void set_services(const std::string& val, unsigned line);
+
+    /* Service of each ring pair slot */
+    std::vector<bank_service> slots;
+};
+
+} // namespace layout
+
+#endif // LAYOUT_SPEC_H
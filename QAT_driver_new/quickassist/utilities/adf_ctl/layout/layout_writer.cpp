@@ -0,0 +1,307 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+#include "layout_writer.h"
+#include "ini_config.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace layout
+{
+
+writer::writer(const spec& sp, const std::vector<tenant_plan>& plans)
+    : sp(sp)
+    , plans(plans)
+{
+    general.push_back(std::make_pair("ServicesEnabled", sp.services));
+    general.push_back(std::make_pair(constants::config_ver, "2"));
+    general.push_back(std::make_pair("CyNumConcurrentSymRequests", "512"));
+    general.push_back(std::make_pair("CyNumConcurrentAsymRequests", "64"));
+    general.push_back(std::make_pair("statsGeneral", "1"));
+    general.push_back(std::make_pair("AutoResetOnError", "0"));
+    build();
+}
+
+bool writer::quoted(const std::string& key)
+{
+    const std::string suffix(constants::inst_name);
+
+    return key.size() > suffix.size()
+           && key.compare(key.size() - suffix.size(), suffix.size(), suffix)
+                  == 0;
+}
+
+void writer::load_general(const std::string& filename)
+{
+    ini_config::config conf;
+    std::vector<std::pair<unsigned, std::pair<std::string, std::string>>>
+        lines;
+
+    if (!ini_config::config::read_ini(filename, conf))
+    {
+        throw std::runtime_error(std::string("Filename ") + filename
+                                 + " cannot be read");
+    }
+    auto sec = conf.getSections().find(constants::general_sec);
+    if (sec == conf.getSections().end())
+    {
+        throw std::runtime_error(std::string("No ") + constants::general_sec
+                                 + " section in " + filename);
+    }
+
+    /* The parser keeps keys sorted, restore the file order */
+    auto values = sec->second->getValues();
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+        std::string val = it->second->val;
+        if (it->first == "ServicesEnabled")
+            val = sp.services;
+        lines.push_back(
+            std::make_pair(it->second->line, std::make_pair(it->first, val)));
+    }
+    std::sort(lines.begin(), lines.end());
+
+    general.clear();
+    for (auto it = lines.begin(); it != lines.end(); ++it)
+        general.push_back(it->second);
+    if (values.find("ServicesEnabled") == values.end())
+        general.insert(general.begin(),
+                       std::make_pair("ServicesEnabled", sp.services));
+    build();
+}
+
+void writer::build()
+{
+    sections.clear();
+
+    out_section gen = { constants::general_sec, "", general };
+    sections.push_back(gen);
+
+    out_section kernel = { constants::kernel_sec, "", entries() };
+    kernel.values.push_back(std::make_pair(constants::num_cy_inst, "0"));
+    kernel.values.push_back(std::make_pair(constants::num_dc_inst, "0"));
+    sections.push_back(kernel);
+
+    if (sp.profile->slot_per_bank)
+    {
+        out_section siov = { "SIOV", "", entries() };
+        siov.values.push_back(std::make_pair("NumberAdis", "0"));
+        sections.push_back(siov);
+    }
+
+    for (auto p = plans.begin(); p != plans.end(); ++p)
+    {
+        std::stringstream comment;
+        bool cy = p->t.service == tenant_service::CY;
+        const char* prefix = cy ? constants::inst_cy : constants::inst_dc;
+        out_section s = { p->t.section, "", entries() };
+
+        comment << "# " << (p->hot ? "hot" : "cold") << ", " << std::fixed
+                << std::setprecision(1) << p->t.load_gbps << " Gbps";
+        if (p->t.instances != p->requested)
+            comment << ", " << p->requested << " instances requested";
+        s.comment = comment.str();
+
+        s.values.push_back(std::make_pair(
+            constants::num_cy_inst, utils::to_string(cy ? p->t.instances : 0)));
+        s.values.push_back(std::make_pair(
+            constants::num_dc_inst, utils::to_string(cy ? 0 : p->t.instances)));
+        s.values.push_back(std::make_pair(constants::num_process,
+                                          utils::to_string(p->t.processes)));
+        s.values.push_back(std::make_pair(constants::limit_dev_access, "0"));
+        for (unsigned i = 0; i < p->t.instances; i++)
+        {
+            std::string inst = prefix + utils::to_string(i);
+            s.values.push_back(
+                std::make_pair(inst + constants::inst_name, inst));
+            s.values.push_back(std::make_pair(
+                inst + constants::inst_is_polled,
+                utils::to_string(constants::config_resp_poll)));
+            s.values.push_back(
+                std::make_pair(inst + constants::inst_affinity,
+                               utils::to_string(p->cores[i])));
+        }
+        sections.push_back(s);
+    }
+}
+
+void writer::write(const std::string& filename) const
+{
+    std::ofstream ofs(filename.c_str(), std::ofstream::out);
+
+    if (!ofs.good())
+    {
+        throw std::runtime_error(std::string("Filename ") + filename
+                                 + " cannot be written");
+    }
+
+    ofs << "# Generated by adf_layout for " << sp.profile->name << " on node "
+        << sp.device_node << "\n";
+    for (auto s = sections.begin(); s != sections.end(); ++s)
+    {
+        ofs << "\n";
+        if (!s->comment.empty())
+            ofs << s->comment << "\n";
+        ofs << "[" << s->name << "]\n";
+        for (auto v = s->values.begin(); v != s->values.end(); ++v)
+        {
+            if (quoted(v->first))
+                ofs << v->first << " = \"" << v->second << "\"\n";
+            else
+                ofs << v->first << " = " << v->second << "\n";
+        }
+    }
+    ofs.close();
+    if (ofs.fail())
+    {
+        throw std::runtime_error(std::string("Filename ") + filename
+                                 + " cannot be written");
+    }
+}
+
+void writer::validate(const std::string& filename) const
+{
+    ini_config::config conf;
+
+    if (!ini_config::config::read_ini(filename, conf))
+    {
+        throw std::runtime_error(std::string("adf_ctl cannot parse ")
+                                 + filename);
+    }
+
+    auto parsed = conf.getSections();
+    if (parsed.size() != sections.size())
+    {
+        throw std::runtime_error("adf_ctl sees "
+                                 + utils::to_string(parsed.size())
+                                 + " sections, expected "
+                                 + utils::to_string(sections.size()));
+    }
+
+    for (auto s = sections.begin(); s != sections.end(); ++s)
+    {
+        auto sec = parsed.find(s->name);
+        if (sec == parsed.end())
+        {
+            throw std::runtime_error("Section " + s->name
+                                     + " lost by the parser");
+        }
+
+        /* The driver derives <name>_INT_<n> for every process */
+        std::string derived = s->name;
+        for (auto v = s->values.begin(); v != s->values.end(); ++v)
+        {
+            if (v->first == constants::num_process)
+                derived += constants::derived_sec_name + v->second;
+        }
+        if (derived.length() >= ADF_CFG_MAX_SECTION_LEN_IN_BYTES)
+        {
+            throw std::runtime_error("Section " + derived + " too long");
+        }
+
+        auto values = sec->second->getValues();
+        if (values.size() != s->values.size())
+        {
+            throw std::runtime_error("Section " + s->name + " has "
+                                     + utils::to_string(values.size())
+                                     + " keys after parsing, expected "
+                                     + utils::to_string(s->values.size()));
+        }
+        for (auto v = s->values.begin(); v != s->values.end(); ++v)
+        {
+            auto it = values.find(v->first);
+            if (it == values.end() || it->second->val != v->second)
+            {
+                throw std::runtime_error("Key " + s->name + "/" + v->first
+                                         + " does not read back as \""
+                                         + v->second + "\"");
+            }
+            if (v->first.length() >= ADF_CFG_MAX_KEY_LEN_IN_BYTES
+                || v->second.length() >= ADF_CFG_MAX_VAL_LEN_IN_BYTES)
+            {
+                throw std::runtime_error("Key " + s->name + "/" + v->first
+                                         + ": entry too long");
+            }
+            if (!quoted(v->first) && s->name != constants::general_sec
+                && utils::get_value_type(v->second) != ADF_DEC)
+            {
+                throw std::runtime_error("Key " + s->name + "/" + v->first
+                                         + " is not decimal");
+            }
+        }
+    }
+
+    auto gen = parsed.find(constants::general_sec)->second->getValues();
+    auto ver = gen.find(constants::config_ver);
+    if (ver == gen.end() || utils::to_number<int>(ver->second->val) != 2)
+    {
+        throw std::runtime_error("Only version 2 config file supported");
+    }
+}
+
+} // namespace layout
@@ -0,0 +1,195 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+#include <exception>
+#include <getopt.h>
+#include <iostream>
+#include <string>
+
+#include "layout_planner.h"
+#include "layout_spec.h"
+#include "layout_writer.h"
+
+void adf_layout_help()
+{
+    std::cout
+        << "Use of adf_layout: "
+           "adf_layout -s <layout file> [-o <config file>] [-g <config file>] "
+           "[-t] [-a] [-f]\n\n"
+           "-s (--spec) [layout file] - topology, services and tenant load "
+           "to lay out\n"
+           "-o (--output) [config file] - device config to write "
+           "(default: adf_layout.conf)\n"
+           "-g (--general) [config file] - take the [GENERAL] section from "
+           "this config\n"
+           "-t (--topology) - read NUMA nodes and cores from sysfs\n"
+           "-a (--align) - round hot tenants up to a multiple of their "
+           "arbiter groups\n"
+           "-f (--force) - write the config even if hot tenants share "
+           "banks\n\n"
+           "Layout file lines:\n"
+           "  device <4xxx|c6xx> [banks <n>] [node <id>]\n"
+           "  services <ServicesEnabled value>\n"
+           "  node <id> <cpu list>\n"
+           "  reserve <cpu list>\n"
+           "  hot <Gbps>\n"
+           "  tenant <section> <cy|dc> <instances> <processes> <Gbps> "
+           "[node <id>]\n"
+        << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::string spec_file, out_file("adf_layout.conf"), general_file;
+    bool topology = false, align = false, force = false;
+    const char* opts = "s:o:g:tafh";
+    static struct option long_options[] = {
+        { "spec", required_argument, 0, 's' },
+        { "output", required_argument, 0, 'o' },
+        { "general", required_argument, 0, 'g' },
+        { "topology", no_argument, 0, 't' },
+        { "align", no_argument, 0, 'a' },
+        { "force", no_argument, 0, 'f' },
+        { "help", no_argument, 0, 'h' },
+        { 0, 0, 0, 0 }
+    };
+
+    while (true)
+    {
+        int option_index = 0;
+        int c = getopt_long(argc, argv, opts, long_options, &option_index);
+        if (c == -1)
+            break;
+
+        switch (c)
+        {
+            case 's':
+                spec_file = optarg;
+                break;
+            case 'o':
+                out_file = optarg;
+                break;
+            case 'g':
+                general_file = optarg;
+                break;
+            case 't':
+                topology = true;
+                break;
+            case 'a':
+                align = true;
+                break;
+            case 'f':
+                force = true;
+                break;
+            case 'h':
+                adf_layout_help();
+                return 0;
+            default:
+                adf_layout_help();
+                return -1;
+        }
+    }
+
+    if (spec_file.empty() || optind != argc)
+    {
+        adf_layout_help();
+        return -1;
+    }
+
+    try
+    {
+        layout::spec sp;
+
+        sp.read(spec_file);
+        if (topology)
+            sp.read_sysfs_topology();
+        sp.validate();
+
+        layout::planner plan(sp);
+        plan.set_align(align);
+        plan.run();
+        plan.explain(std::cout);
+
+        if (!plan.clean() && !force)
+        {
+            std::cerr << "QAT Error: hot tenants share banks, not writing "
+                      << out_file << " (use -f to write it anyway)"
+                      << std::endl;
+            return -1;
+        }
+
+        layout::writer out(sp, plan.get_plans());
+        if (!general_file.empty())
+            out.load_general(general_file);
+        out.write(out_file);
+        out.validate(out_file);
+        std::cout << "\nWrote " << out_file
+                  << ", adf_ctl's parser reads it back unchanged" << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "QAT Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
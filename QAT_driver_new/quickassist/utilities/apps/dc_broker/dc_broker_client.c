@@ -0,0 +1,505 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "dc_broker.h"
+
+/* Polls of a synchronous request before yielding the CPU */
+#define DC_BROKER_SYNC_SPIN 64
+
+static CpaBoolean dcBrokerAlive(dc_broker_shm_t *pShm)
+{
+    Cpa32S pid = pShm->brokerPid;
+
+    if (!__atomic_load_n(&pShm->running, __ATOMIC_ACQUIRE))
+    {
+        return CPA_FALSE;
+    }
+    if (pid > 0 && kill(pid, 0) && ESRCH == errno)
+    {
+        return CPA_FALSE;
+    }
+    return CPA_TRUE;
+}
+
+CpaStatus dcBrokerClientAttach(const char *pPath,
+                               dc_broker_client_t **ppClient)
+{
+    dc_broker_client_t *pClient = NULL;
+    dc_broker_shm_t *pShm = NULL;
+    struct stat st;
+    Cpa32U i = 0;
+    int fd = -1;
+
+    if (NULL == pPath || NULL == ppClient)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    fd = open(pPath, O_RDWR);
+    if (fd < 0)
+    {
+        DC_BROKER_LOG_ERROR("Cannot open %s: %s\n", pPath, strerror(errno));
+        return CPA_STATUS_RESOURCE;
+    }
+    if (fstat(fd, &st) || (size_t)st.st_size < sizeof(*pShm))
+    {
+        DC_BROKER_LOG_ERROR("%s is not a broker region\n", pPath);
+        close(fd);
+        return CPA_STATUS_FAIL;
+    }
+    pShm = mmap(
+        NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == pShm)
+    {
+        DC_BROKER_LOG_ERROR("Cannot map %s: %s\n", pPath, strerror(errno));
+        close(fd);
+        return CPA_STATUS_RESOURCE;
+    }
+    if (DC_BROKER_MAGIC != pShm->magic ||
+        DC_BROKER_VERSION != pShm->version ||
+        DC_BROKER_RING_SIZE != pShm->ringSize ||
+        (Cpa64U)st.st_size != pShm->shmSize || !dcBrokerAlive(pShm))
+    {
+        DC_BROKER_LOG_ERROR("No broker of this version serves %s\n", pPath);
+        munmap(pShm, st.st_size);
+        close(fd);
+        return CPA_STATUS_FAIL;
+    }
+
+    pClient = calloc(1, sizeof(*pClient));
+    if (NULL == pClient)
+    {
+        munmap(pShm, st.st_size);
+        close(fd);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    for (i = 0; i < pShm->maxClients; i++)
+    {
+        Cpa32U expected = DC_BROKER_SLOT_FREE;
+
+        if (__atomic_compare_exchange_n(&pShm->slots[i].state,
+                                        &expected,
+                                        DC_BROKER_SLOT_CLAIMED,
+                                        CPA_FALSE,
+                                        __ATOMIC_ACQ_REL,
+                                        __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+    if (i == pShm->maxClients)
+    {
+        DC_BROKER_LOG_ERROR("All %u broker slots are in use\n",
+                            pShm->maxClients);
+        free(pClient);
+        munmap(pShm, st.st_size);
+        close(fd);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    pClient->fd = fd;
+    pClient->pShm = pShm;
+    pClient->slotIdx = i;
+    pClient->pSlot = &pShm->slots[i];
+    pClient->pData = (Cpa8U *)pShm + pClient->pSlot->dataOffset;
+    pClient->numPages = pClient->pSlot->dataSize / DC_BROKER_PAGE_SIZE;
+    pClient->pPageRun = calloc(pClient->numPages, sizeof(Cpa32U));
+    if (NULL == pClient->pPageRun)
+    {
+        __atomic_store_n(
+            &pClient->pSlot->state, DC_BROKER_SLOT_FREE, __ATOMIC_RELEASE);
+        free(pClient);
+        munmap(pShm, st.st_size);
+        close(fd);
+        return CPA_STATUS_RESOURCE;
+    }
+    for (i = 0; i < DC_BROKER_RING_SIZE; i++)
+    {
+        pClient->freeTags[i] = DC_BROKER_RING_SIZE - 1 - i;
+    }
+    pClient->numFreeTags = DC_BROKER_RING_SIZE;
+
+    pClient->pSlot->pid = getpid();
+    __atomic_store_n(
+        &pClient->pSlot->state, DC_BROKER_SLOT_ACTIVE, __ATOMIC_RELEASE);
+
+    *ppClient = pClient;
+    return CPA_STATUS_SUCCESS;
+}
+
+void dcBrokerClientDetach(dc_broker_client_t *pClient)
+{
+    if (NULL == pClient)
+    {
+        return;
+    }
+
+    /* The broker drains what is still in flight and frees the slot */
+    __atomic_store_n(
+        &pClient->pSlot->state, DC_BROKER_SLOT_CLOSING, __ATOMIC_RELEASE);
+    munmap(pClient->pShm, pClient->pShm->shmSize);
+    close(pClient->fd);
+    free(pClient->pPageRun);
+    free(pClient);
+}
+
+void *dcBrokerMemAlloc(dc_broker_client_t *pClient, Cpa32U size)
+{
+    Cpa32U pages = 0;
+    Cpa32U start = 0;
+    Cpa32U i = 0;
+
+    if (NULL == pClient || 0 == size)
+    {
+        return NULL;
+    }
+    pages = (size + DC_BROKER_PAGE_SIZE - 1) / DC_BROKER_PAGE_SIZE;
+
+    /* First fit over the pages of the client's area */
+    while (start + pages <= pClient->numPages)
+    {
+        for (i = 0; i < pages; i++)
+        {
+            if (pClient->pPageRun[start + i])
+            {
+                break;
+            }
+        }
+        if (i == pages)
+        {
+            pClient->pPageRun[start] = pages;
+            for (i = 1; i < pages; i++)
+            {
+                pClient->pPageRun[start + i] = DC_BROKER_PAGE_TAIL;
+            }
+            return pClient->pData + (Cpa64U)start * DC_BROKER_PAGE_SIZE;
+        }
+        start += i + 1;
+    }
+    return NULL;
+}
+
+void dcBrokerMemFree(dc_broker_client_t *pClient, void *pMem)
+{
+    Cpa64U off = 0;
+    Cpa32U page = 0;
+    Cpa32U pages = 0;
+    Cpa32U i = 0;
+
+    if (NULL == pClient || NULL == pMem || (Cpa8U *)pMem < pClient->pData)
+    {
+        return;
+    }
+    off = (Cpa8U *)pMem - pClient->pData;
+    page = off / DC_BROKER_PAGE_SIZE;
+    if (off % DC_BROKER_PAGE_SIZE || page >= pClient->numPages)
+    {
+        return;
+    }
+
+    pages = pClient->pPageRun[page];
+    if (0 == pages || DC_BROKER_PAGE_TAIL == pages)
+    {
+        return;
+    }
+    for (i = 0; i < pages; i++)
+    {
+        pClient->pPageRun[page + i] = 0;
+    }
+}
+
+CpaStatus dcBrokerInitSession(dc_broker_client_t *pClient,
+                              dc_broker_session_t *pSession,
+                              const CpaDcSessionSetupData *pSetup,
+                              CpaDcCallbackFn pCallbackFn)
+{
+    if (NULL == pClient || NULL == pSession || NULL == pSetup)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* The broker only shares stateless deflate compression sessions */
+    if (CPA_DC_DEFLATE != pSetup->compType ||
+        CPA_DC_DIR_DECOMPRESS == pSetup->sessDirection ||
+        CPA_DC_STATELESS != pSetup->sessState)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+    if (CPA_DC_NONE != pSetup->checksum && CPA_DC_CRC32 != pSetup->checksum &&
+        CPA_DC_ADLER32 != pSetup->checksum)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    pSession->setup = *pSetup;
+    pSession->pCallbackFn = pCallbackFn;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus dcBrokerFillBufs(dc_broker_client_t *pClient,
+                                  const CpaBufferList *pList,
+                                  dc_broker_buf_t *pBufs,
+                                  Cpa8U *pNum)
+{
+    Cpa8U *pEnd = pClient->pData + pClient->pSlot->dataSize;
+    Cpa32U i = 0;
+
+    if (NULL == pList || NULL == pList->pBuffers || 0 == pList->numBuffers ||
+        pList->numBuffers > DC_BROKER_MAX_FLAT)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    for (i = 0; i < pList->numBuffers; i++)
+    {
+        Cpa8U *pBuf = pList->pBuffers[i].pData;
+        Cpa32U len = pList->pBuffers[i].dataLenInBytes;
+
+        /* Zero copy: buffers must live in the client's shared area */
+        if (NULL == pBuf || pBuf < pClient->pData || pBuf + len > pEnd)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        pBufs[i].offset = pBuf - (Cpa8U *)pClient->pShm;
+        pBufs[i].len = len;
+    }
+    *pNum = pList->numBuffers;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus dcBrokerCompressData2(dc_broker_client_t *pClient,
+                                dc_broker_session_t *pSession,
+                                CpaBufferList *pSrcBuff,
+                                CpaBufferList *pDestBuff,
+                                CpaDcOpData *pOpData,
+                                CpaDcRqResults *pResults,
+                                void *callbackTag)
+{
+    dc_broker_slot_t *pSlot = NULL;
+    dc_broker_req_t *pReq = NULL;
+    dc_broker_pending_t *pPending = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U head = 0;
+    Cpa32U tag = 0;
+    Cpa32U spin = 0;
+
+    if (NULL == pClient || NULL == pSession || NULL == pOpData ||
+        NULL == pResults)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (CPA_DC_FLUSH_FINAL != pOpData->flushFlag &&
+        CPA_DC_FLUSH_FULL != pOpData->flushFlag)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (!dcBrokerAlive(pClient->pShm))
+    {
+        return CPA_STATUS_RESTARTING;
+    }
+
+    pSlot = pClient->pSlot;
+    head = pSlot->reqRing.head;
+    if (0 == pClient->numFreeTags ||
+        head - __atomic_load_n(&pSlot->reqRing.tail, __ATOMIC_ACQUIRE) >=
+            DC_BROKER_RING_SIZE)
+    {
+        return CPA_STATUS_RETRY;
+    }
+
+    pReq = &pSlot->req[head % DC_BROKER_RING_SIZE];
+    status = dcBrokerFillBufs(pClient, pSrcBuff, pReq->src, &pReq->numSrc);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status =
+            dcBrokerFillBufs(pClient, pDestBuff, pReq->dst, &pReq->numDst);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    tag = pClient->freeTags[--pClient->numFreeTags];
+    pPending = &pClient->pending[tag];
+    pPending->pResults = pResults;
+    pPending->callbackTag = callbackTag;
+    pPending->pSession = pSession;
+    pPending->done = CPA_FALSE;
+
+    pReq->tag = tag;
+    pReq->checksum = pResults->checksum;
+    pReq->compLevel = pSession->setup.compLevel;
+    pReq->huffType = pSession->setup.huffType;
+    pReq->checksumType = pSession->setup.checksum;
+    pReq->flushFlag = pOpData->flushFlag;
+    pReq->compressAndVerify = pOpData->compressAndVerify;
+    __atomic_store_n(&pSlot->reqRing.head, head + 1, __ATOMIC_RELEASE);
+
+    if (NULL != pSession->pCallbackFn)
+    {
+        return CPA_STATUS_SUCCESS;
+    }
+
+    /* Synchronous: poll until this request is back */
+    while (!pPending->done)
+    {
+        status = dcBrokerClientPoll(pClient, 0);
+        if (CPA_STATUS_FAIL == status)
+        {
+            return CPA_STATUS_RESTARTING;
+        }
+        if (CPA_STATUS_RETRY == status && ++spin >= DC_BROKER_SYNC_SPIN)
+        {
+            sched_yield();
+            spin = 0;
+        }
+    }
+    status = pPending->status;
+    pClient->freeTags[pClient->numFreeTags++] = tag;
+    return status;
+}
+
+CpaStatus dcBrokerClientPoll(dc_broker_client_t *pClient,
+                             Cpa32U responseQuota)
+{
+    dc_broker_ring_t *pRing = NULL;
+    Cpa32U head = 0;
+    Cpa32U tail = 0;
+    Cpa32U done = 0;
+
+    if (NULL == pClient)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    pRing = &pClient->pSlot->respRing;
+    tail = pRing->tail;
+    head = __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE);
+    while (tail != head && (0 == responseQuota || done < responseQuota))
+    {
+        dc_broker_resp_t *pResp =
+            &pClient->pSlot->resp[tail % DC_BROKER_RING_SIZE];
+        dc_broker_pending_t *pPending = NULL;
+        CpaDcCallbackFn pCallbackFn = NULL;
+        void *callbackTag = NULL;
+        CpaStatus status = CPA_STATUS_SUCCESS;
+
+        tail++;
+        if (pResp->tag >= DC_BROKER_RING_SIZE)
+        {
+            continue;
+        }
+        pPending = &pClient->pending[pResp->tag];
+        pPending->pResults->status = (CpaDcReqStatus)pResp->dcStatus;
+        pPending->pResults->consumed = pResp->consumed;
+        pPending->pResults->produced = pResp->produced;
+        pPending->pResults->checksum = pResp->checksum;
+        pPending->pResults->endOfLastBlock = pResp->endOfLastBlock;
+        pPending->status = pResp->status;
+        done++;
+
+        pCallbackFn = pPending->pSession->pCallbackFn;
+        if (NULL == pCallbackFn)
+        {
+            /* The synchronous caller frees the tag */
+            pPending->done = CPA_TRUE;
+            continue;
+        }
+        callbackTag = pPending->callbackTag;
+        status = pPending->status;
+        pClient->freeTags[pClient->numFreeTags++] = pResp->tag;
+        __atomic_store_n(&pRing->tail, tail, __ATOMIC_RELEASE);
+
+        /* The callback may submit or poll again */
+        pCallbackFn(callbackTag, status);
+        tail = pRing->tail;
+        head = __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE);
+    }
+    __atomic_store_n(&pRing->tail, tail, __ATOMIC_RELEASE);
+
+    if (done)
+    {
+        return CPA_STATUS_SUCCESS;
+    }
+    return dcBrokerAlive(pClient->pShm) ? CPA_STATUS_RETRY : CPA_STATUS_FAIL;
+}
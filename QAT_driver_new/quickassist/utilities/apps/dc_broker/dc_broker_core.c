@@ -0,0 +1,720 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/magic.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "dc_broker.h"
+
+#define DC_BROKER_NSEC_PER_SEC 1000000000ULL
+#define DC_BROKER_NSEC_PER_USEC 1000ULL
+#define DC_BROKER_BYTES_PER_MB (1024ULL * 1024ULL)
+/* Passes between checks for clients that died without detaching */
+#define DC_BROKER_REAP_PERIOD 4096
+/* Empty passes before the broker starts sleeping, and the longest sleep */
+#define DC_BROKER_IDLE_SPIN 1024
+#define DC_BROKER_IDLE_MAX_NS 1000000ULL
+#define DC_BROKER_CRC32_POLY 0xEDB88320
+#define DC_BROKER_ADLER_MOD 65521
+
+#define DC_BROKER_ALIGN(x, a) (((x) + (a)-1) / (a) * (a))
+
+static Cpa32U dcBrokerCrcTable[256];
+static CpaBoolean dcBrokerCrcReady = CPA_FALSE;
+
+Cpa64U dcBrokerNowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * DC_BROKER_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+Cpa32U dcBrokerCrc32(Cpa32U crc, const Cpa8U *pData, Cpa32U len)
+{
+    Cpa32U i = 0;
+    Cpa32U k = 0;
+
+    if (!dcBrokerCrcReady)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            Cpa32U c = i;
+            for (k = 0; k < 8; k++)
+            {
+                c = (c & 1) ? DC_BROKER_CRC32_POLY ^ (c >> 1) : c >> 1;
+            }
+            dcBrokerCrcTable[i] = c;
+        }
+        dcBrokerCrcReady = CPA_TRUE;
+    }
+
+    crc = ~crc;
+    for (i = 0; i < len; i++)
+    {
+        crc = dcBrokerCrcTable[(crc ^ pData[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+Cpa32U dcBrokerAdler32(Cpa32U adler, const Cpa8U *pData, Cpa32U len)
+{
+    Cpa32U a = adler & 0xFFFF;
+    Cpa32U b = adler >> 16;
+    Cpa32U i = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        a = (a + pData[i]) % DC_BROKER_ADLER_MOD;
+        b = (b + a) % DC_BROKER_ADLER_MOD;
+    }
+    return (b << 16) | a;
+}
+
+void dcBrokerSetDefaults(dc_broker_config_t *pConfig)
+{
+    memset(pConfig, 0, sizeof(*pConfig));
+    snprintf(pConfig->path, sizeof(pConfig->path), "%s",
+             DC_BROKER_DEFAULT_PATH);
+    snprintf(pConfig->section, sizeof(pConfig->section), "%s",
+             DC_BROKER_DEFAULT_SECTION);
+    pConfig->maxClients = DC_BROKER_DEFAULT_CLIENTS;
+    pConfig->dataSize = DC_BROKER_DEFAULT_DATA_MB * DC_BROKER_BYTES_PER_MB;
+    pConfig->numInstances = DC_BROKER_DEFAULT_INSTANCES;
+    pConfig->depth = DC_BROKER_DEFAULT_DEPTH;
+    pConfig->quantum = DC_BROKER_DEFAULT_QUANTUM;
+    pConfig->backend = DC_BROKER_BACKEND_QAT;
+    pConfig->emuLatencyUs = 20;
+    pConfig->emuMBps = 2000;
+}
+
+void *dcBrokerDataPtr(dc_broker_t *pBroker, Cpa64U offset)
+{
+    return (Cpa8U *)pBroker->pShm + offset;
+}
+
+/* Refuses to take over a region another broker still serves */
+static CpaBoolean dcBrokerRegionBusy(int fd)
+{
+    dc_broker_shm_t hdr;
+
+    if (pread(fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr))
+    {
+        return CPA_FALSE;
+    }
+    return DC_BROKER_MAGIC == hdr.magic && hdr.running && hdr.brokerPid > 0 &&
+           hdr.brokerPid != getpid() &&
+           !(kill(hdr.brokerPid, 0) && ESRCH == errno);
+}
+
+CpaStatus dcBrokerInit(dc_broker_t *pBroker, const dc_broker_config_t *pConfig)
+{
+    dc_broker_shm_t *pShm = NULL;
+    Cpa64U slotsEnd = 0;
+    Cpa64U perClient = 0;
+    Cpa64U shmSize = 0;
+    Cpa32U maxJobs = 0;
+    Cpa32U i = 0;
+    struct statfs fs;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (NULL == pBroker || NULL == pConfig || 0 == pConfig->maxClients ||
+        pConfig->maxClients > DC_BROKER_MAX_CLIENTS ||
+        0 == pConfig->numInstances ||
+        pConfig->numInstances > DC_BROKER_MAX_INSTANCES ||
+        0 == pConfig->depth || 0 == pConfig->quantum)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    memset(pBroker, 0, sizeof(*pBroker));
+    pBroker->config = *pConfig;
+    pBroker->fd = -1;
+
+    /* Slots, then the data area on its own huge page boundary */
+    slotsEnd = sizeof(dc_broker_shm_t) +
+               (Cpa64U)pConfig->maxClients * sizeof(dc_broker_slot_t);
+    perClient = pConfig->dataSize / pConfig->maxClients;
+    perClient -= perClient % DC_BROKER_PAGE_SIZE;
+    if (0 == perClient)
+    {
+        DC_BROKER_LOG_ERROR("%llu bytes of data cannot serve %u clients\n",
+                            (unsigned long long)pConfig->dataSize,
+                            pConfig->maxClients);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    shmSize = DC_BROKER_ALIGN(slotsEnd, DC_BROKER_HUGEPAGE_SIZE) +
+              DC_BROKER_ALIGN(perClient * pConfig->maxClients,
+                              DC_BROKER_HUGEPAGE_SIZE);
+
+    pBroker->fd = open(pConfig->path, O_RDWR | O_CREAT, 0600);
+    if (pBroker->fd < 0)
+    {
+        DC_BROKER_LOG_ERROR(
+            "Cannot open %s: %s\n", pConfig->path, strerror(errno));
+        return CPA_STATUS_RESOURCE;
+    }
+    if (dcBrokerRegionBusy(pBroker->fd))
+    {
+        DC_BROKER_LOG_ERROR("Another broker serves %s\n", pConfig->path);
+        close(pBroker->fd);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    /* Zero copy to the device needs pinned, huge page backed memory */
+    if (DC_BROKER_BACKEND_QAT == pConfig->backend &&
+        (fstatfs(pBroker->fd, &fs) || HUGETLBFS_MAGIC != fs.f_type))
+    {
+        DC_BROKER_LOG_ERROR("%s must be on hugetlbfs for the QAT backend\n",
+                            pConfig->path);
+        close(pBroker->fd);
+        unlink(pConfig->path);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (ftruncate(pBroker->fd, 0) || ftruncate(pBroker->fd, shmSize))
+    {
+        DC_BROKER_LOG_ERROR(
+            "Cannot size %s: %s\n", pConfig->path, strerror(errno));
+        close(pBroker->fd);
+        return CPA_STATUS_RESOURCE;
+    }
+    pShm = mmap(NULL,
+                shmSize,
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE,
+                pBroker->fd,
+                0);
+    if (MAP_FAILED == pShm)
+    {
+        DC_BROKER_LOG_ERROR(
+            "Cannot map %s: %s\n", pConfig->path, strerror(errno));
+        close(pBroker->fd);
+        return CPA_STATUS_RESOURCE;
+    }
+    (void)mlock(pShm, shmSize);
+
+    pBroker->pShm = pShm;
+    pShm->maxClients = pConfig->maxClients;
+    pShm->ringSize = DC_BROKER_RING_SIZE;
+    pShm->shmSize = shmSize;
+    pShm->dataOffset = DC_BROKER_ALIGN(slotsEnd, DC_BROKER_HUGEPAGE_SIZE);
+    pShm->dataSize = perClient * pConfig->maxClients;
+    pBroker->pData = (Cpa8U *)pShm + pShm->dataOffset;
+
+    maxJobs = pConfig->numInstances * pConfig->depth;
+    pBroker->pDeficit = calloc(pConfig->maxClients, sizeof(Cpa32U));
+    pBroker->pInflight = calloc(pConfig->maxClients, sizeof(Cpa32U));
+    pBroker->pRegions =
+        calloc(pConfig->maxClients, sizeof(dc_broker_region_t));
+    pBroker->pJobs = calloc(maxJobs, sizeof(dc_broker_job_t));
+    if (NULL == pBroker->pDeficit || NULL == pBroker->pInflight ||
+        NULL == pBroker->pRegions || NULL == pBroker->pJobs)
+    {
+        dcBrokerShutdown(pBroker);
+        return CPA_STATUS_RESOURCE;
+    }
+    for (i = 0; i < pConfig->maxClients; i++)
+    {
+        pBroker->pRegions[i].base = pShm->dataOffset + i * perClient;
+        pBroker->pRegions[i].size = perClient;
+        pShm->slots[i].dataOffset = pBroker->pRegions[i].base;
+        pShm->slots[i].dataSize = perClient;
+    }
+    pBroker->pBackend = DC_BROKER_BACKEND_EMU == pConfig->backend
+                            ? &dcBrokerEmuBackend
+                            : &dcBrokerQatBackend;
+    pBroker->numInstances = pConfig->numInstances;
+    status = pBroker->pBackend->init(pBroker);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        DC_BROKER_LOG_ERROR("%s backend failed to start\n",
+                            pBroker->pBackend->name);
+        dcBrokerShutdown(pBroker);
+        return status;
+    }
+
+    /* The backend may have found fewer instances than configured */
+    maxJobs = pBroker->numInstances * pConfig->depth;
+    for (i = 0; i < maxJobs; i++)
+    {
+        pBroker->pJobs[i].pBroker = pBroker;
+        pBroker->pJobs[i].pNext = pBroker->pFreeJobs;
+        pBroker->pFreeJobs = &pBroker->pJobs[i];
+    }
+
+    /* Publish last, clients check the magic and running flag */
+    pShm->brokerPid = getpid();
+    pShm->version = DC_BROKER_VERSION;
+    pShm->magic = DC_BROKER_MAGIC;
+    __atomic_store_n(&pShm->running, 1, __ATOMIC_RELEASE);
+    return CPA_STATUS_SUCCESS;
+}
+
+void dcBrokerComplete(dc_broker_t *pBroker, dc_broker_job_t *pJob)
+{
+    dc_broker_slot_t *pSlot = &pBroker->pShm->slots[pJob->client];
+    Cpa32U state = __atomic_load_n(&pSlot->state, __ATOMIC_ACQUIRE);
+
+    if (DC_BROKER_SLOT_ACTIVE == state)
+    {
+        Cpa32U head = pSlot->respRing.head;
+        dc_broker_resp_t *pResp = &pSlot->resp[head % DC_BROKER_RING_SIZE];
+
+        /* Never full: a client has at most DC_BROKER_RING_SIZE requests
+         * between its request ring, the broker and this ring */
+        pResp->tag = pJob->req.tag;
+        pResp->status = pJob->status;
+        pResp->dcStatus = pJob->results.status;
+        pResp->consumed = pJob->results.consumed;
+        pResp->produced = pJob->results.produced;
+        pResp->checksum = pJob->results.checksum;
+        pResp->endOfLastBlock = pJob->results.endOfLastBlock;
+        pSlot->completed++;
+        pSlot->bytesIn += pJob->results.consumed;
+        pSlot->bytesOut += pJob->results.produced;
+        __atomic_store_n(&pSlot->respRing.head, head + 1, __ATOMIC_RELEASE);
+    }
+
+    pBroker->pInflight[pJob->client]--;
+    pBroker->inst[pJob->inst].inflight--;
+    pBroker->inst[pJob->inst].jobs++;
+    pBroker->inst[pJob->inst].bytes += pJob->bytes;
+    pJob->pNext = pBroker->pFreeJobs;
+    pBroker->pFreeJobs = pJob;
+}
+
+/* The buffer must be inside the region. Written so that no sum can wrap
+ * whatever offset and length the client sends. */
+static CpaBoolean dcBrokerBufValid(const dc_broker_region_t *pRegion,
+                                   const dc_broker_buf_t *pBuf)
+{
+    return pBuf->offset >= pRegion->base &&
+           pBuf->offset - pRegion->base <= pRegion->size &&
+           pBuf->len <= pRegion->size - (pBuf->offset - pRegion->base);
+}
+
+/* Every buffer of a request must be inside the client's own area. pReq is
+ * the broker's copy of the request, pRegion the broker's copy of the area:
+ * the client can rewrite its slot while the request is checked. */
+static CpaBoolean dcBrokerReqValid(const dc_broker_region_t *pRegion,
+                                   const dc_broker_req_t *pReq,
+                                   Cpa64U *pBytes)
+{
+    Cpa32U i = 0;
+
+    if (0 == pReq->numSrc || pReq->numSrc > DC_BROKER_MAX_FLAT ||
+        0 == pReq->numDst || pReq->numDst > DC_BROKER_MAX_FLAT ||
+        pReq->tag >= DC_BROKER_RING_SIZE)
+    {
+        return CPA_FALSE;
+    }
+    *pBytes = 0;
+    for (i = 0; i < DC_BROKER_MAX_FLAT; i++)
+    {
+        if ((i < pReq->numSrc && !dcBrokerBufValid(pRegion, &pReq->src[i])) ||
+            (i < pReq->numDst && !dcBrokerBufValid(pRegion, &pReq->dst[i])))
+        {
+            return CPA_FALSE;
+        }
+        if (i < pReq->numSrc)
+        {
+            *pBytes += pReq->src[i].len;
+        }
+    }
+    return CPA_TRUE;
+}
+
+static Cpa32S dcBrokerPickInstance(dc_broker_t *pBroker)
+{
+    Cpa32S best = -1;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBroker->numInstances; i++)
+    {
+        if (pBroker->inst[i].inflight >= pBroker->config.depth)
+        {
+            continue;
+        }
+        if (best < 0 ||
+            pBroker->inst[i].inflight < pBroker->inst[best].inflight)
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/* Frees the slot of a closing client once nothing is in flight. Requests
+ * it left on its ring are dropped. */
+static void dcBrokerReclaim(dc_broker_t *pBroker, Cpa32U client)
+{
+    dc_broker_slot_t *pSlot = &pBroker->pShm->slots[client];
+
+    pSlot->reqRing.tail = pSlot->reqRing.head;
+    if (pBroker->pInflight[client])
+    {
+        return;
+    }
+    if (pBroker->config.verbose)
+    {
+        DC_BROKER_LOG_USER("client %u (pid %d) left after %llu requests\n",
+                           client,
+                           pSlot->pid,
+                           (unsigned long long)pSlot->completed);
+    }
+    pSlot->reqRing.head = 0;
+    pSlot->reqRing.tail = 0;
+    pSlot->respRing.head = 0;
+    pSlot->respRing.tail = 0;
+    pSlot->submitted = 0;
+    pSlot->completed = 0;
+    pSlot->bytesIn = 0;
+    pSlot->bytesOut = 0;
+    pSlot->pid = 0;
+    /* The next client of the slot must not inherit a rewritten area */
+    pSlot->dataOffset = pBroker->pRegions[client].base;
+    pSlot->dataSize = pBroker->pRegions[client].size;
+    pBroker->pDeficit[client] = 0;
+    __atomic_store_n(&pSlot->state, DC_BROKER_SLOT_FREE, __ATOMIC_RELEASE);
+}
+
+static void dcBrokerReapDead(dc_broker_t *pBroker)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBroker->config.maxClients; i++)
+    {
+        dc_broker_slot_t *pSlot = &pBroker->pShm->slots[i];
+        Cpa32U expected = DC_BROKER_SLOT_ACTIVE;
+
+        if (DC_BROKER_SLOT_ACTIVE != pSlot->state || pSlot->pid <= 0 ||
+            !kill(pSlot->pid, 0) || ESRCH != errno)
+        {
+            continue;
+        }
+        __atomic_compare_exchange_n(&pSlot->state,
+                                    &expected,
+                                    DC_BROKER_SLOT_CLOSING,
+                                    CPA_FALSE,
+                                    __ATOMIC_ACQ_REL,
+                                    __ATOMIC_RELAXED);
+    }
+}
+
+/* Moves requests of one client to the instances while its deficit pays
+ * for them. Sets *pFull when no instance or job can take more. */
+static Cpa32U dcBrokerServe(dc_broker_t *pBroker,
+                            Cpa32U c,
+                            CpaBoolean *pFull)
+{
+    dc_broker_slot_t *pSlot = &pBroker->pShm->slots[c];
+    Cpa32U tail = pSlot->reqRing.tail;
+    Cpa32U head = __atomic_load_n(&pSlot->reqRing.head, __ATOMIC_ACQUIRE);
+    Cpa32U moved = 0;
+
+    while (tail != head)
+    {
+        dc_broker_req_t *pReq = &pSlot->req[tail % DC_BROKER_RING_SIZE];
+        dc_broker_job_t *pJob = pBroker->pFreeJobs;
+        CpaStatus status = CPA_STATUS_SUCCESS;
+        Cpa64U bytes = 0;
+        Cpa32S inst = 0;
+
+        if (NULL == pJob)
+        {
+            *pFull = CPA_TRUE;
+            break;
+        }
+        memcpy(&pJob->req, pReq, sizeof(pJob->req));
+        if (!dcBrokerReqValid(&pBroker->pRegions[c], &pJob->req, &bytes))
+        {
+            status = CPA_STATUS_INVALID_PARAM;
+        }
+        else if (bytes > pBroker->pDeficit[c])
+        {
+            break;
+        }
+
+        inst = dcBrokerPickInstance(pBroker);
+        if (inst < 0)
+        {
+            *pFull = CPA_TRUE;
+            break;
+        }
+
+        pJob->client = c;
+        pJob->inst = inst;
+        pJob->bytes = bytes;
+        pJob->status = status;
+        memset(&pJob->results, 0, sizeof(pJob->results));
+        pBroker->pFreeJobs = pJob->pNext;
+        pBroker->pInflight[c]++;
+        pBroker->inst[inst].inflight++;
+
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = pBroker->pBackend->submit(pBroker, pJob);
+            if (CPA_STATUS_RETRY == status)
+            {
+                pBroker->pInflight[c]--;
+                pBroker->inst[inst].inflight--;
+                pJob->pNext = pBroker->pFreeJobs;
+                pBroker->pFreeJobs = pJob;
+                *pFull = CPA_TRUE;
+                break;
+            }
+        }
+        tail++;
+        __atomic_store_n(&pSlot->reqRing.tail, tail, __ATOMIC_RELEASE);
+        pSlot->submitted++;
+        pBroker->pDeficit[c] -= bytes;
+        moved++;
+
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            pJob->status = status;
+            dcBrokerComplete(pBroker, pJob);
+        }
+    }
+    return moved;
+}
+
+Cpa32U dcBrokerPoll(dc_broker_t *pBroker)
+{
+    dc_broker_shm_t *pShm = pBroker->pShm;
+    CpaBoolean full = CPA_FALSE;
+    Cpa32U moved = 0;
+    Cpa32U n = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBroker->numInstances; i++)
+    {
+        if (pBroker->inst[i].inflight)
+        {
+            pBroker->pBackend->poll(pBroker, i);
+        }
+    }
+    if (0 == ++pBroker->loops % DC_BROKER_REAP_PERIOD)
+    {
+        dcBrokerReapDead(pBroker);
+    }
+
+    /* Deficit round robin: a backlogged client earns a quantum of bytes
+     * when its turn starts and keeps the turn until the quantum no longer
+     * pays for its oldest request. A turn cut short by busy instances
+     * resumes on the next pass. */
+    for (n = 0; n < pBroker->config.maxClients && !full; n++)
+    {
+        Cpa32U c = pBroker->rrNext;
+        dc_broker_slot_t *pSlot = &pShm->slots[c];
+        Cpa32U state = __atomic_load_n(&pSlot->state, __ATOMIC_ACQUIRE);
+        Cpa32U tail = pSlot->reqRing.tail;
+        Cpa32U head = __atomic_load_n(&pSlot->reqRing.head, __ATOMIC_ACQUIRE);
+
+        if (DC_BROKER_SLOT_CLOSING == state)
+        {
+            dcBrokerReclaim(pBroker, c);
+        }
+        if (DC_BROKER_SLOT_ACTIVE == state && tail != head)
+        {
+            if (!pBroker->rrGranted)
+            {
+                pBroker->pDeficit[c] += pBroker->config.quantum;
+                pBroker->rrGranted = CPA_TRUE;
+            }
+            moved += dcBrokerServe(pBroker, c, &full);
+            if (full)
+            {
+                break;
+            }
+        }
+        if (pSlot->reqRing.tail == head)
+        {
+            pBroker->pDeficit[c] = 0;
+        }
+        pBroker->rrNext = (c + 1) % pBroker->config.maxClients;
+        pBroker->rrGranted = CPA_FALSE;
+    }
+    return moved;
+}
+
+CpaStatus dcBrokerRun(dc_broker_t *pBroker)
+{
+    Cpa64U idleNs = 0;
+    Cpa32U idle = 0;
+    Cpa32U i = 0;
+
+    while (!pBroker->stop)
+    {
+        CpaBoolean busy = dcBrokerPoll(pBroker) ? CPA_TRUE : CPA_FALSE;
+
+        for (i = 0; i < pBroker->numInstances && !busy; i++)
+        {
+            busy = pBroker->inst[i].inflight ? CPA_TRUE : CPA_FALSE;
+        }
+        if (busy)
+        {
+            idle = 0;
+            idleNs = 0;
+            continue;
+        }
+
+        /* Spin a little, then back off up to a millisecond */
+        if (++idle > DC_BROKER_IDLE_SPIN)
+        {
+            struct timespec ts;
+
+            idleNs = idleNs ? idleNs * 2 : DC_BROKER_NSEC_PER_USEC;
+            if (idleNs > DC_BROKER_IDLE_MAX_NS)
+            {
+                idleNs = DC_BROKER_IDLE_MAX_NS;
+            }
+            ts.tv_sec = 0;
+            ts.tv_nsec = idleNs;
+            nanosleep(&ts, NULL);
+        }
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+void dcBrokerPrintStats(dc_broker_t *pBroker)
+{
+    Cpa64U jobs = 0;
+    Cpa64U bytes = 0;
+    Cpa32U clients = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBroker->numInstances; i++)
+    {
+        DC_BROKER_LOG_USER("instance %2u: %10llu requests %14llu bytes\n",
+                           i,
+                           (unsigned long long)pBroker->inst[i].jobs,
+                           (unsigned long long)pBroker->inst[i].bytes);
+        jobs += pBroker->inst[i].jobs;
+        bytes += pBroker->inst[i].bytes;
+    }
+    for (i = 0; i < pBroker->config.maxClients; i++)
+    {
+        clients += DC_BROKER_SLOT_ACTIVE == pBroker->pShm->slots[i].state;
+    }
+    DC_BROKER_LOG_USER("total      : %10llu requests %14llu bytes, "
+                       "%u clients attached\n",
+                       (unsigned long long)jobs,
+                       (unsigned long long)bytes,
+                       clients);
+}
+
+void dcBrokerShutdown(dc_broker_t *pBroker)
+{
+    if (NULL == pBroker)
+    {
+        return;
+    }
+    if (NULL != pBroker->pShm)
+    {
+        __atomic_store_n(&pBroker->pShm->running, 0, __ATOMIC_RELEASE);
+    }
+    if (NULL != pBroker->pBackend)
+    {
+        pBroker->pBackend->shutdown(pBroker);
+        pBroker->pBackend = NULL;
+    }
+    if (NULL != pBroker->pShm)
+    {
+        munmap(pBroker->pShm, pBroker->pShm->shmSize);
+        pBroker->pShm = NULL;
+        unlink(pBroker->config.path);
+    }
+    if (pBroker->fd >= 0)
+    {
+        close(pBroker->fd);
+        pBroker->fd = -1;
+    }
+    free(pBroker->pDeficit);
+    free(pBroker->pInflight);
+    free(pBroker->pRegions);
+    free(pBroker->pJobs);
+    pBroker->pDeficit = NULL;
+    pBroker->pInflight = NULL;
+    pBroker->pRegions = NULL;
+    pBroker->pJobs = NULL;
+}
@@ -0,0 +1,313 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "dc_broker.h"
+
+/* Stored deflate block: header byte, LEN and NLEN, then the data */
+#define DC_EMU_BLOCK_HDR 5
+#define DC_EMU_BLOCK_MAX 65535
+#define DC_EMU_NSEC_PER_USEC 1000ULL
+/* 1 MB/s is a byte per microsecond */
+#define DC_EMU_NSEC_PER_BYTE_MBPS 1000ULL
+
+/* Emulated instance: one job at a time, completed in order */
+typedef struct dc_emu_inst_s
+{
+    Cpa64U busyUntil;
+    dc_broker_job_t *pHead;
+    dc_broker_job_t *pTail;
+} dc_emu_inst_t;
+
+/* Position in a scattered buffer list of the shared region */
+typedef struct dc_emu_cursor_s
+{
+    dc_broker_t *pBroker;
+    const dc_broker_buf_t *pBufs;
+    Cpa32U numBufs;
+    Cpa32U buf;
+    Cpa32U off;
+    Cpa64U left;
+} dc_emu_cursor_t;
+
+static void dcEmuCursorInit(dc_emu_cursor_t *pCur,
+                            dc_broker_t *pBroker,
+                            const dc_broker_buf_t *pBufs,
+                            Cpa32U numBufs)
+{
+    Cpa32U i = 0;
+
+    memset(pCur, 0, sizeof(*pCur));
+    pCur->pBroker = pBroker;
+    pCur->pBufs = pBufs;
+    pCur->numBufs = numBufs;
+    for (i = 0; i < numBufs; i++)
+    {
+        pCur->left += pBufs[i].len;
+    }
+}
+
+/* Copies len bytes between the cursor and pMem, either direction. The
+ * source side may be NULL to only update the checksum. */
+static void dcEmuCursorMove(dc_emu_cursor_t *pCur,
+                            Cpa8U *pMem,
+                            Cpa32U len,
+                            CpaBoolean toCursor,
+                            dc_emu_cursor_t *pCopyTo,
+                            Cpa8U checksumType,
+                            Cpa32U *pChecksum)
+{
+    while (len)
+    {
+        const dc_broker_buf_t *pBuf = &pCur->pBufs[pCur->buf];
+        Cpa8U *pAt = NULL;
+        Cpa32U n = pBuf->len - pCur->off;
+
+        if (0 == n)
+        {
+            pCur->buf++;
+            pCur->off = 0;
+            continue;
+        }
+        if (n > len)
+        {
+            n = len;
+        }
+        pAt = (Cpa8U *)dcBrokerDataPtr(pCur->pBroker, pBuf->offset) +
+              pCur->off;
+        if (NULL != pMem)
+        {
+            if (toCursor)
+            {
+                memcpy(pAt, pMem, n);
+            }
+            else
+            {
+                memcpy(pMem, pAt, n);
+            }
+            pMem += n;
+        }
+        if (NULL != pCopyTo)
+        {
+            dcEmuCursorMove(
+                pCopyTo, pAt, n, CPA_TRUE, NULL, CPA_DC_NONE, NULL);
+        }
+        if (CPA_DC_CRC32 == checksumType)
+        {
+            *pChecksum = dcBrokerCrc32(*pChecksum, pAt, n);
+        }
+        else if (CPA_DC_ADLER32 == checksumType)
+        {
+            *pChecksum = dcBrokerAdler32(*pChecksum, pAt, n);
+        }
+        pCur->off += n;
+        pCur->left -= n;
+        len -= n;
+    }
+}
+
+/* Stateless compression into stored blocks. On overflow the blocks that
+ * fit are kept and the result reports what they consumed. */
+static void dcEmuCompress(dc_broker_t *pBroker, dc_broker_job_t *pJob)
+{
+    dc_broker_req_t *pReq = &pJob->req;
+    CpaDcRqResults *pRes = &pJob->results;
+    dc_emu_cursor_t src;
+    dc_emu_cursor_t dst;
+    Cpa32U checksum = pReq->checksum;
+    CpaBoolean last = CPA_FALSE;
+
+    if (CPA_DC_ADLER32 == pReq->checksumType && 0 == checksum)
+    {
+        checksum = 1;
+    }
+    dcEmuCursorInit(&src, pBroker, pReq->src, pReq->numSrc);
+    dcEmuCursorInit(&dst, pBroker, pReq->dst, pReq->numDst);
+    pRes->status = CPA_DC_OK;
+
+    do
+    {
+        Cpa8U hdr[DC_EMU_BLOCK_HDR];
+        Cpa32U len = src.left > DC_EMU_BLOCK_MAX ? DC_EMU_BLOCK_MAX
+                                                 : (Cpa32U)src.left;
+
+        if (dst.left < DC_EMU_BLOCK_HDR + (Cpa64U)len)
+        {
+            if (dst.left <= DC_EMU_BLOCK_HDR)
+            {
+                pRes->status = CPA_DC_OVERFLOW;
+                break;
+            }
+            len = (Cpa32U)dst.left - DC_EMU_BLOCK_HDR;
+            pRes->status = CPA_DC_OVERFLOW;
+        }
+        last = CPA_DC_FLUSH_FINAL == pReq->flushFlag && len == src.left &&
+               CPA_DC_OK == pRes->status;
+
+        hdr[0] = last ? 1 : 0;
+        hdr[1] = len & 0xFF;
+        hdr[2] = len >> 8;
+        hdr[3] = ~hdr[1];
+        hdr[4] = ~hdr[2];
+        dcEmuCursorMove(
+            &dst, hdr, DC_EMU_BLOCK_HDR, CPA_TRUE, NULL, CPA_DC_NONE, NULL);
+        dcEmuCursorMove(
+            &src, NULL, len, CPA_FALSE, &dst, pReq->checksumType, &checksum);
+        pRes->consumed += len;
+        pRes->produced += DC_EMU_BLOCK_HDR + len;
+    } while (src.left && CPA_DC_OK == pRes->status);
+
+    pRes->checksum = checksum;
+    pRes->endOfLastBlock = last;
+}
+
+static CpaStatus dcEmuInit(dc_broker_t *pBroker)
+{
+    pBroker->pBackendPriv =
+        calloc(pBroker->numInstances, sizeof(dc_emu_inst_t));
+    if (NULL == pBroker->pBackendPriv)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    if (pBroker->config.verbose)
+    {
+        DC_BROKER_LOG_USER("%u emulated instances, %u MB/s, %u us latency\n",
+                           pBroker->numInstances,
+                           pBroker->config.emuMBps,
+                           pBroker->config.emuLatencyUs);
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus dcEmuSubmit(dc_broker_t *pBroker, dc_broker_job_t *pJob)
+{
+    dc_emu_inst_t *pInst = (dc_emu_inst_t *)pBroker->pBackendPriv + pJob->inst;
+    Cpa64U now = dcBrokerNowNs();
+    Cpa64U start = pInst->busyUntil > now ? pInst->busyUntil : now;
+
+    dcEmuCompress(pBroker, pJob);
+
+    /* The instance streams one job after the other, the fixed latency
+     * overlaps with the next job */
+    pInst->busyUntil = start;
+    if (pBroker->config.emuMBps)
+    {
+        pInst->busyUntil +=
+            pJob->bytes * DC_EMU_NSEC_PER_BYTE_MBPS / pBroker->config.emuMBps;
+    }
+    pJob->doneNs =
+        pInst->busyUntil + pBroker->config.emuLatencyUs * DC_EMU_NSEC_PER_USEC;
+
+    pJob->pNext = NULL;
+    if (NULL == pInst->pTail)
+    {
+        pInst->pHead = pJob;
+    }
+    else
+    {
+        pInst->pTail->pNext = pJob;
+    }
+    pInst->pTail = pJob;
+    return CPA_STATUS_SUCCESS;
+}
+
+static void dcEmuPoll(dc_broker_t *pBroker, Cpa32U inst)
+{
+    dc_emu_inst_t *pInst = (dc_emu_inst_t *)pBroker->pBackendPriv + inst;
+    Cpa64U now = dcBrokerNowNs();
+
+    while (NULL != pInst->pHead && pInst->pHead->doneNs <= now)
+    {
+        dc_broker_job_t *pJob = pInst->pHead;
+
+        pInst->pHead = pJob->pNext;
+        if (NULL == pInst->pHead)
+        {
+            pInst->pTail = NULL;
+        }
+        dcBrokerComplete(pBroker, pJob);
+    }
+}
+
+static void dcEmuShutdown(dc_broker_t *pBroker)
+{
+    free(pBroker->pBackendPriv);
+    pBroker->pBackendPriv = NULL;
+}
+
+const dc_broker_backend_t dcBrokerEmuBackend = {"emulated",
+                                                dcEmuInit,
+                                                dcEmuSubmit,
+                                                dcEmuPoll,
+                                                dcEmuShutdown};
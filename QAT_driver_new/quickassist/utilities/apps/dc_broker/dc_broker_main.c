@@ -0,0 +1,696 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "dc_broker.h"
+
+#define DC_TEST_DEFAULT_SECONDS 2
+#define DC_TEST_DEPTH 16
+#define DC_TEST_MIN_SIZE 4096
+#define DC_TEST_MAX_SIZE (DC_TEST_MIN_SIZE << 4)
+/* Pages of shared memory a client of the largest requests allocates, a
+ * source and a destination for each request in flight */
+#define DC_TEST_PAGES(bytes)                                                   \
+    (((bytes) + DC_BROKER_PAGE_SIZE - 1) / DC_BROKER_PAGE_SIZE)
+#define DC_TEST_CLIENT_DATA                                                    \
+    (DC_TEST_DEPTH * DC_BROKER_PAGE_SIZE *                                     \
+     (DC_TEST_PAGES(DC_TEST_MAX_SIZE) +                                        \
+      DC_TEST_PAGES(DC_TEST_MAX_SIZE + DC_TEST_MAX_SIZE / 8)))
+/* Polls a client makes for its last responses before giving up */
+#define DC_TEST_DRAIN_POLLS 10000000
+/* Time a raw request of the hostile client may wait for its response */
+#define DC_TEST_RAW_TIMEOUT_NS 1000000000ULL
+#define DC_TEST_LINE 128
+
+static dc_broker_t dcBroker;
+
+static void dcBrokerSigHandler(int sig)
+{
+    dcBroker.stop = 1;
+}
+
+/*
+ ******************************************************************
+ * @ingroup dc_broker
+ *        Display command line argument help string.
+ *
+ * @param[in]  pExe  pointer to name of executable file
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+static void dcBrokerPrintHelp(const char *pExe)
+{
+    DC_BROKER_LOG_USER(
+        "\ndc_broker owns the compression instances and serves client\n"
+        "processes through a shared memory region.\n"
+        "\nUsage:\n"
+        "\t%s [options]\n"
+        "\nOptions:\n"
+        "\t-p <path>     shared memory file, on hugetlbfs for the QAT\n"
+        "\t              backend (default %s)\n"
+        "\t-s <section>  configuration section (default %s)\n"
+        "\t-c <count>    client slots (default %d, max %d)\n"
+        "\t-d <MB>       data area shared by the clients (default %d)\n"
+        "\t-n <count>    instances to use (default %d, max %d)\n"
+        "\t-D <count>    requests in flight per instance (default %d)\n"
+        "\t-Q <bytes>    bytes per client and round (default %d)\n"
+        "\t-e            emulate the instances in software\n"
+        "\t-l <us>       emulated request latency (default 20)\n"
+        "\t-m <MB/s>     emulated instance throughput (default 2000)\n"
+        "\t-T <count>    self test: fork clients against emulated\n"
+        "\t              instances, check their output and fairness\n"
+        "\t-t <seconds>  self test duration (default %d)\n"
+        "\t-v            verbose\n",
+        pExe,
+        DC_BROKER_DEFAULT_PATH,
+        DC_BROKER_DEFAULT_SECTION,
+        DC_BROKER_DEFAULT_CLIENTS,
+        DC_BROKER_MAX_CLIENTS,
+        DC_BROKER_DEFAULT_DATA_MB,
+        DC_BROKER_DEFAULT_INSTANCES,
+        DC_BROKER_MAX_INSTANCES,
+        DC_BROKER_DEFAULT_DEPTH,
+        DC_BROKER_DEFAULT_QUANTUM,
+        DC_TEST_DEFAULT_SECONDS);
+}
+
+/* One outstanding request of a self test client */
+typedef struct dc_test_req_s
+{
+    struct dc_test_client_s *pClient;
+    CpaBufferList src;
+    CpaBufferList dst;
+    CpaFlatBuffer srcFlat;
+    CpaFlatBuffer dstFlat;
+    CpaDcRqResults results;
+    CpaBoolean busy;
+} dc_test_req_t;
+
+typedef struct dc_test_client_s
+{
+    Cpa32U size;
+    Cpa64U completed;
+    Cpa64U bytes;
+    Cpa64U errors;
+    dc_test_req_t reqs[DC_TEST_DEPTH];
+} dc_test_client_t;
+
+static void dcTestFill(Cpa8U *pBuf, Cpa32U len, Cpa32U seq)
+{
+    Cpa32U x = seq * 2654435761U + 1;
+    Cpa32U i = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        x = x * 1103515245 + 12345;
+        pBuf[i] = x >> 16;
+    }
+}
+
+/* Walks the stored blocks of the output and compares them with the
+ * source */
+static CpaBoolean dcTestCheck(dc_test_req_t *pReq, CpaStatus status)
+{
+    const Cpa8U *pIn = pReq->srcFlat.pData;
+    const Cpa8U *pOut = pReq->dstFlat.pData;
+    CpaDcRqResults *pRes = &pReq->results;
+    Cpa32U size = pReq->srcFlat.dataLenInBytes;
+    Cpa32U in = 0;
+    Cpa32U out = 0;
+    CpaBoolean final = CPA_FALSE;
+
+    if (CPA_STATUS_SUCCESS != status || CPA_DC_OK != pRes->status ||
+        pRes->consumed != size || !pRes->endOfLastBlock ||
+        pRes->checksum != dcBrokerCrc32(0, pIn, size))
+    {
+        return CPA_FALSE;
+    }
+    while (!final)
+    {
+        Cpa32U len = 0;
+
+        if (out + 5 > pRes->produced)
+        {
+            return CPA_FALSE;
+        }
+        final = pOut[out] & 1;
+        len = pOut[out + 1] | pOut[out + 2] << 8;
+        if ((pOut[out + 3] | pOut[out + 4] << 8) != (~len & 0xFFFF) ||
+            out + 5 + len > pRes->produced || in + len > size ||
+            memcmp(pOut + out + 5, pIn + in, len))
+        {
+            return CPA_FALSE;
+        }
+        out += 5 + len;
+        in += len;
+    }
+    return in == size && out == pRes->produced;
+}
+
+static void dcTestCallback(void *pCallbackTag, CpaStatus status)
+{
+    dc_test_req_t *pReq = pCallbackTag;
+    dc_test_client_t *pClient = pReq->pClient;
+
+    if (dcTestCheck(pReq, status))
+    {
+        pClient->completed++;
+        pClient->bytes += pReq->srcFlat.dataLenInBytes;
+    }
+    else
+    {
+        pClient->errors++;
+    }
+    pReq->busy = CPA_FALSE;
+}
+
+/* Request a hostile client writes straight into its ring */
+typedef struct dc_test_hostile_s
+{
+    const char *pName;
+    dc_broker_buf_t src;
+    dc_broker_buf_t dst;
+    CpaStatus expected;
+} dc_test_hostile_t;
+
+/* Sends one raw request and waits for its response, 0 when the broker
+ * answered with the expected status */
+static int dcTestRawRequest(dc_broker_client_t *pBc,
+                            const dc_test_hostile_t *pCase)
+{
+    dc_broker_slot_t *pSlot = pBc->pSlot;
+    dc_broker_req_t *pReq = NULL;
+    dc_broker_resp_t *pResp = NULL;
+    Cpa32U head = pSlot->reqRing.head;
+    Cpa32U tail = pSlot->respRing.tail;
+    Cpa64U endNs = 0;
+
+    pReq = &pSlot->req[head % DC_BROKER_RING_SIZE];
+    memset(pReq, 0, sizeof(*pReq));
+    pReq->src[0] = pCase->src;
+    pReq->dst[0] = pCase->dst;
+    pReq->numSrc = 1;
+    pReq->numDst = 1;
+    pReq->compLevel = CPA_DC_L1;
+    pReq->huffType = CPA_DC_HT_STATIC;
+    pReq->checksumType = CPA_DC_CRC32;
+    pReq->flushFlag = CPA_DC_FLUSH_FINAL;
+    __atomic_store_n(&pSlot->reqRing.head, head + 1, __ATOMIC_RELEASE);
+
+    endNs = dcBrokerNowNs() + DC_TEST_RAW_TIMEOUT_NS;
+    while (tail == __atomic_load_n(&pSlot->respRing.head, __ATOMIC_ACQUIRE))
+    {
+        if (dcBrokerNowNs() >= endNs)
+        {
+            DC_BROKER_LOG_ERROR("%s: no response\n", pCase->pName);
+            return 1;
+        }
+    }
+    pResp = &pSlot->resp[tail % DC_BROKER_RING_SIZE];
+    __atomic_store_n(&pSlot->respRing.tail, tail + 1, __ATOMIC_RELEASE);
+    if (pResp->status != pCase->expected)
+    {
+        DC_BROKER_LOG_ERROR("%s: status %d, expected %d\n",
+                            pCase->pName,
+                            pResp->status,
+                            pCase->expected);
+        return 1;
+    }
+    return 0;
+}
+
+/* Plays a client that rewrites its slot to claim the whole region and
+ * sends buffers outside its area, with offsets and lengths picked to wrap
+ * a 64 bit bounds check. The broker must reject all of them and still
+ * serve the last, valid request. Returns the number of failed cases. */
+static Cpa32U dcTestHostile(dc_broker_client_t *pBc, dc_test_req_t *pReq)
+{
+    dc_broker_slot_t *pSlot = pBc->pSlot;
+    Cpa64U base = pSlot->dataOffset;
+    Cpa64U size = pSlot->dataSize;
+    const dc_broker_buf_t src = {
+        (Cpa8U *)pReq->srcFlat.pData - (Cpa8U *)pBc->pShm,
+        pReq->srcFlat.dataLenInBytes,
+        0};
+    const dc_broker_buf_t dst = {
+        (Cpa8U *)pReq->dstFlat.pData - (Cpa8U *)pBc->pShm,
+        pReq->dstFlat.dataLenInBytes,
+        0};
+    const dc_test_hostile_t cases[] = {
+        {"below the area", {base - 64, 64, 0}, dst, CPA_STATUS_INVALID_PARAM},
+        {"across the end",
+         {base + size - 32, 64, 0},
+         dst,
+         CPA_STATUS_INVALID_PARAM},
+        {"wrapping offset", {~0ULL - 31, 64, 0}, dst, CPA_STATUS_INVALID_PARAM},
+        {"oversized length", {base, ~0U, 0}, dst, CPA_STATUS_INVALID_PARAM},
+        {"next client",
+         src,
+         {base + size, DC_BROKER_PAGE_SIZE, 0},
+         CPA_STATUS_INVALID_PARAM},
+        {"wrapping destination", src, {~0ULL, 2, 0}, CPA_STATUS_INVALID_PARAM},
+        {"valid", src, dst, CPA_STATUS_SUCCESS},
+    };
+    Cpa32U failed = 0;
+    Cpa32U i = 0;
+
+    pSlot->dataOffset = 0;
+    pSlot->dataSize = ~0ULL;
+    dcTestFill(pReq->srcFlat.pData, src.len, 0);
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        failed += dcTestRawRequest(pBc, &cases[i]);
+    }
+    pSlot->dataOffset = base;
+    pSlot->dataSize = size;
+    return failed;
+}
+
+/* Self test client: keeps DC_TEST_DEPTH requests of its own size in
+ * flight, checks every response and reports on the pipe */
+static int dcTestClient(const char *pPath,
+                        Cpa32U idx,
+                        Cpa32U seconds,
+                        int reportFd)
+{
+    dc_broker_client_t *pBc = NULL;
+    dc_broker_session_t session;
+    CpaDcSessionSetupData setup;
+    CpaDcOpData opData;
+    dc_test_client_t client;
+    Cpa64U endNs = 0;
+    Cpa32U outstanding = 0;
+    Cpa32U polls = 0;
+    Cpa32U seq = 0;
+    Cpa32U i = 0;
+    char line[DC_TEST_LINE];
+    int len = 0;
+
+    memset(&client, 0, sizeof(client));
+    /* Clients of 4, 16 and 64 KB requests share the instances */
+    client.size = DC_TEST_MIN_SIZE << (2 * (idx % 3));
+    if (CPA_STATUS_SUCCESS != dcBrokerClientAttach(pPath, &pBc))
+    {
+        return 1;
+    }
+
+    memset(&setup, 0, sizeof(setup));
+    setup.compLevel = CPA_DC_L1;
+    setup.compType = CPA_DC_DEFLATE;
+    setup.huffType = CPA_DC_HT_STATIC;
+    setup.sessDirection = CPA_DC_DIR_COMPRESS;
+    setup.sessState = CPA_DC_STATELESS;
+    setup.checksum = CPA_DC_CRC32;
+    memset(&opData, 0, sizeof(opData));
+    opData.flushFlag = CPA_DC_FLUSH_FINAL;
+    if (CPA_STATUS_SUCCESS !=
+        dcBrokerInitSession(pBc, &session, &setup, dcTestCallback))
+    {
+        dcBrokerClientDetach(pBc);
+        return 1;
+    }
+
+    for (i = 0; i < DC_TEST_DEPTH; i++)
+    {
+        dc_test_req_t *pReq = &client.reqs[i];
+
+        pReq->pClient = &client;
+        pReq->srcFlat.dataLenInBytes = client.size;
+        pReq->srcFlat.pData = dcBrokerMemAlloc(pBc, client.size);
+        pReq->dstFlat.dataLenInBytes = client.size + client.size / 8;
+        pReq->dstFlat.pData =
+            dcBrokerMemAlloc(pBc, pReq->dstFlat.dataLenInBytes);
+        if (NULL == pReq->srcFlat.pData || NULL == pReq->dstFlat.pData)
+        {
+            DC_BROKER_LOG_ERROR("client %u: out of shared memory\n", idx);
+            dcBrokerClientDetach(pBc);
+            return 1;
+        }
+        pReq->src.numBuffers = 1;
+        pReq->src.pBuffers = &pReq->srcFlat;
+        pReq->dst.numBuffers = 1;
+        pReq->dst.pBuffers = &pReq->dstFlat;
+    }
+    client.errors += dcTestHostile(pBc, &client.reqs[0]);
+
+    endNs = dcBrokerNowNs() + (Cpa64U)seconds * 1000000000ULL;
+    while (dcBrokerNowNs() < endNs)
+    {
+        for (i = 0; i < DC_TEST_DEPTH; i++)
+        {
+            dc_test_req_t *pReq = &client.reqs[i];
+
+            if (pReq->busy)
+            {
+                continue;
+            }
+            dcTestFill(pReq->srcFlat.pData, client.size, ++seq);
+            pReq->results.checksum = 0;
+            pReq->busy = CPA_TRUE;
+            if (CPA_STATUS_SUCCESS != dcBrokerCompressData2(pBc,
+                                                            &session,
+                                                            &pReq->src,
+                                                            &pReq->dst,
+                                                            &opData,
+                                                            &pReq->results,
+                                                            pReq))
+            {
+                pReq->busy = CPA_FALSE;
+                break;
+            }
+        }
+        if (CPA_STATUS_FAIL == dcBrokerClientPoll(pBc, 0))
+        {
+            client.errors++;
+            break;
+        }
+    }
+
+    /* Collect what is still in flight */
+    do
+    {
+        outstanding = 0;
+        for (i = 0; i < DC_TEST_DEPTH; i++)
+        {
+            outstanding += client.reqs[i].busy;
+        }
+        if (outstanding && CPA_STATUS_FAIL == dcBrokerClientPoll(pBc, 0))
+        {
+            break;
+        }
+    } while (outstanding && ++polls < DC_TEST_DRAIN_POLLS);
+    client.errors += outstanding;
+
+    for (i = 0; i < DC_TEST_DEPTH; i++)
+    {
+        dcBrokerMemFree(pBc, client.reqs[i].srcFlat.pData);
+        dcBrokerMemFree(pBc, client.reqs[i].dstFlat.pData);
+    }
+    dcBrokerClientDetach(pBc);
+
+    len = snprintf(line,
+                   sizeof(line),
+                   "%u %u %llu %llu %llu\n",
+                   idx,
+                   client.size,
+                   (unsigned long long)client.completed,
+                   (unsigned long long)client.bytes,
+                   (unsigned long long)client.errors);
+    if (write(reportFd, line, len) != len)
+    {
+        return 1;
+    }
+    return client.errors ? 1 : 0;
+}
+
+/* Serves the forked clients until they are all gone, then prints what
+ * each got and Jain's fairness index over the bytes */
+static CpaStatus dcTestRun(dc_broker_t *pBroker,
+                           Cpa32U numClients,
+                           Cpa32U seconds)
+{
+    FILE *pReport = NULL;
+    Cpa32U running = 0;
+    Cpa32U reported = 0;
+    Cpa32U i = 0;
+    double sum = 0;
+    double sumSq = 0;
+    int failed = 0;
+    int fds[2];
+    char line[DC_TEST_LINE];
+
+    if (pipe(fds))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    for (i = 0; i < numClients; i++)
+    {
+        pid_t pid = fork();
+
+        if (0 == pid)
+        {
+            close(fds[0]);
+            _exit(dcTestClient(pBroker->config.path, i, seconds, fds[1]));
+        }
+        if (pid < 0)
+        {
+            DC_BROKER_LOG_ERROR("fork failed\n");
+            failed++;
+            break;
+        }
+        running++;
+    }
+    close(fds[1]);
+
+    while (running && !pBroker->stop)
+    {
+        int wstatus = 0;
+
+        if (dcBrokerPoll(pBroker))
+        {
+            continue;
+        }
+        while (waitpid(-1, &wstatus, WNOHANG) > 0)
+        {
+            running--;
+            if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus))
+            {
+                failed++;
+            }
+        }
+    }
+
+    pReport = fdopen(fds[0], "r");
+    if (NULL == pReport)
+    {
+        close(fds[0]);
+        return CPA_STATUS_FAIL;
+    }
+    DC_BROKER_LOG_USER("client  size   requests           bytes  errors\n");
+    while (fgets(line, sizeof(line), pReport))
+    {
+        unsigned idx = 0;
+        unsigned size = 0;
+        unsigned long long completed = 0;
+        unsigned long long bytes = 0;
+        unsigned long long errors = 0;
+
+        if (5 != sscanf(line,
+                        "%u %u %llu %llu %llu",
+                        &idx,
+                        &size,
+                        &completed,
+                        &bytes,
+                        &errors))
+        {
+            continue;
+        }
+        DC_BROKER_LOG_USER("%6u %5u %10llu %15llu %7llu\n",
+                           idx,
+                           size,
+                           completed,
+                           bytes,
+                           errors);
+        sum += bytes;
+        sumSq += (double)bytes * bytes;
+        reported++;
+    }
+    fclose(pReport);
+
+    if (reported && sumSq > 0)
+    {
+        DC_BROKER_LOG_USER("Jain's fairness index over bytes: %.3f\n",
+                           sum * sum / (reported * sumSq));
+    }
+    if (failed || reported != numClients)
+    {
+        DC_BROKER_LOG_ERROR("%u of %u clients failed\n",
+                            failed ? (Cpa32U)failed : numClients - reported,
+                            numClients);
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    dc_broker_config_t config;
+    Cpa32U testClients = 0;
+    Cpa32U testSeconds = DC_TEST_DEFAULT_SECONDS;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    int opt = 0;
+
+    dcBrokerSetDefaults(&config);
+    while (CPA_STATUS_SUCCESS == status &&
+           (opt = getopt(argc, argv, "p:s:c:d:n:D:Q:el:m:T:t:vh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'p':
+                snprintf(config.path, sizeof(config.path), "%s", optarg);
+                break;
+            case 's':
+                snprintf(
+                    config.section, sizeof(config.section), "%s", optarg);
+                break;
+            case 'c':
+                config.maxClients = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                config.dataSize = strtoull(optarg, NULL, 0) * 1024 * 1024;
+                break;
+            case 'n':
+                config.numInstances = strtoul(optarg, NULL, 0);
+                break;
+            case 'D':
+                config.depth = strtoul(optarg, NULL, 0);
+                break;
+            case 'Q':
+                config.quantum = strtoul(optarg, NULL, 0);
+                break;
+            case 'e':
+                config.backend = DC_BROKER_BACKEND_EMU;
+                break;
+            case 'l':
+                config.emuLatencyUs = strtoul(optarg, NULL, 0);
+                break;
+            case 'm':
+                config.emuMBps = strtoul(optarg, NULL, 0);
+                break;
+            case 'T':
+                testClients = strtoul(optarg, NULL, 0);
+                config.backend = DC_BROKER_BACKEND_EMU;
+                break;
+            case 't':
+                testSeconds = strtoul(optarg, NULL, 0);
+                break;
+            case 'v':
+                config.verbose = CPA_TRUE;
+                break;
+            default:
+                status = CPA_STATUS_INVALID_PARAM;
+                break;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status && optind != argc)
+    {
+        status = CPA_STATUS_INVALID_PARAM;
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        dcBrokerPrintHelp(argv[0]);
+        return -1;
+    }
+    if (testClients)
+    {
+        /* Only the forked clients attach, give each room for all its
+         * requests */
+        config.maxClients = testClients;
+        if (config.dataSize < (Cpa64U)testClients * DC_TEST_CLIENT_DATA)
+        {
+            config.dataSize = (Cpa64U)testClients * DC_TEST_CLIENT_DATA;
+        }
+    }
+
+    status = dcBrokerInit(&dcBroker, &config);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return -1;
+    }
+    signal(SIGINT, dcBrokerSigHandler);
+    signal(SIGTERM, dcBrokerSigHandler);
+
+    if (testClients)
+    {
+        status = dcTestRun(&dcBroker, testClients, testSeconds);
+    }
+    else
+    {
+        DC_BROKER_LOG_USER("Serving %u clients on %s with %u %s instances\n",
+                           config.maxClients,
+                           config.path,
+                           dcBroker.numInstances,
+                           dcBroker.pBackend->name);
+        status = dcBrokerRun(&dcBroker);
+    }
+    dcBrokerPrintStats(&dcBroker);
+    dcBrokerShutdown(&dcBroker);
+
+    return CPA_STATUS_SUCCESS == status ? 0 : -1;
+}
@@ -0,0 +1,559 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "dc_broker.h"
+#include "icp_sal_user.h"
+#include "icp_sal_poll.h"
+#include "qae_mem.h"
+
+/* Flat buffers of one list once split at huge page boundaries */
+#define DC_QAT_MAX_FLAT 32
+#define DC_QAT_PAGEMAP "/proc/self/pagemap"
+#define DC_QAT_PFN_MASK ((1ULL << 55) - 1)
+#define DC_QAT_PAGE_PRESENT (1ULL << 63)
+
+typedef struct dc_qat_session_s
+{
+    CpaDcSessionHandle handle;
+    Cpa8U compLevel;
+    Cpa8U huffType;
+    Cpa8U checksumType;
+    CpaBoolean used;
+    Cpa32U inflight;
+    Cpa64U lastUse;
+} dc_qat_session_t;
+
+typedef struct dc_qat_inst_s
+{
+    CpaInstanceHandle handle;
+    CpaBoolean started;
+    dc_qat_session_t sessions[DC_BROKER_MAX_SESSIONS];
+} dc_qat_inst_t;
+
+/* Per job request memory, the flat buffers point into the shared region */
+typedef struct dc_qat_job_s
+{
+    CpaBufferList srcList;
+    CpaBufferList dstList;
+    CpaFlatBuffer srcFlat[DC_QAT_MAX_FLAT];
+    CpaFlatBuffer dstFlat[DC_QAT_MAX_FLAT];
+    CpaDcOpData opData;
+    dc_qat_session_t *pSession;
+} dc_qat_job_t;
+
+typedef struct dc_qat_s
+{
+    dc_qat_inst_t *pInst;
+    Cpa16U numInst;
+    CpaBoolean started;
+    Cpa64U useCount;
+} dc_qat_t;
+
+/* Address translation has no context argument, so the huge page table of
+ * the shared region is global */
+static Cpa8U *dcQatBase = NULL;
+static Cpa64U dcQatSize = 0;
+static Cpa64U *dcQatPhys = NULL;
+
+static CpaPhysicalAddr dcQatVirtToPhys(void *pVirtAddr)
+{
+    Cpa8U *pAddr = pVirtAddr;
+
+    if (pAddr >= dcQatBase && pAddr < dcQatBase + dcQatSize)
+    {
+        Cpa64U off = pAddr - dcQatBase;
+
+        return dcQatPhys[off / DC_BROKER_HUGEPAGE_SIZE] +
+               off % DC_BROKER_HUGEPAGE_SIZE;
+    }
+    return qaeVirtToPhysNUMA(pVirtAddr);
+}
+
+/* Reads the physical address of every huge page of the region. The pages
+ * are populated and locked, so the table stays valid. */
+static CpaStatus dcQatMapRegion(dc_broker_t *pBroker)
+{
+    Cpa64U numPages = pBroker->pShm->shmSize / DC_BROKER_HUGEPAGE_SIZE;
+    Cpa64U i = 0;
+    int fd = -1;
+
+    dcQatPhys = calloc(numPages, sizeof(Cpa64U));
+    if (NULL == dcQatPhys)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    fd = open(DC_QAT_PAGEMAP, O_RDONLY);
+    if (fd < 0)
+    {
+        DC_BROKER_LOG_ERROR("Cannot open %s\n", DC_QAT_PAGEMAP);
+        return CPA_STATUS_FAIL;
+    }
+    for (i = 0; i < numPages; i++)
+    {
+        Cpa64U virt =
+            (Cpa64U)(uintptr_t)pBroker->pShm + i * DC_BROKER_HUGEPAGE_SIZE;
+        Cpa64U entry = 0;
+
+        if (pread(fd,
+                  &entry,
+                  sizeof(entry),
+                  virt / DC_BROKER_PAGE_SIZE * sizeof(entry)) !=
+                (ssize_t)sizeof(entry) ||
+            !(entry & DC_QAT_PAGE_PRESENT) || 0 == (entry & DC_QAT_PFN_MASK))
+        {
+            /* The frame number reads as 0 without CAP_SYS_ADMIN */
+            DC_BROKER_LOG_ERROR("No physical address for huge page %llu\n",
+                                (unsigned long long)i);
+            close(fd);
+            return CPA_STATUS_FAIL;
+        }
+        dcQatPhys[i] = (entry & DC_QAT_PFN_MASK) * DC_BROKER_PAGE_SIZE;
+    }
+    close(fd);
+    dcQatBase = (Cpa8U *)pBroker->pShm;
+    dcQatSize = numPages * DC_BROKER_HUGEPAGE_SIZE;
+    return CPA_STATUS_SUCCESS;
+}
+
+static void dcQatCallback(void *pCallbackTag, CpaStatus status)
+{
+    dc_broker_job_t *pJob = pCallbackTag;
+    dc_qat_job_t *pQatJob = pJob->pPriv;
+
+    pQatJob->pSession->inflight--;
+    pJob->status = status;
+    dcBrokerComplete(pJob->pBroker, pJob);
+}
+
+static void dcQatFreeJobs(dc_broker_t *pBroker)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBroker->numInstances * pBroker->config.depth; i++)
+    {
+        dc_qat_job_t *pQatJob = pBroker->pJobs[i].pPriv;
+
+        if (NULL == pQatJob)
+        {
+            continue;
+        }
+        qaeMemFreeNUMA(&pQatJob->srcList.pPrivateMetaData);
+        qaeMemFreeNUMA(&pQatJob->dstList.pPrivateMetaData);
+        free(pQatJob);
+        pBroker->pJobs[i].pPriv = NULL;
+    }
+}
+
+static CpaStatus dcQatAllocJobs(dc_broker_t *pBroker, Cpa32U node)
+{
+    dc_qat_t *pQat = pBroker->pBackendPriv;
+    Cpa32U metaSize = 0;
+    Cpa32U i = 0;
+
+    if (CPA_STATUS_SUCCESS != cpaDcBufferListGetMetaSize(pQat->pInst[0].handle,
+                                                         DC_QAT_MAX_FLAT,
+                                                         &metaSize))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    for (i = 0; i < pBroker->numInstances * pBroker->config.depth; i++)
+    {
+        dc_qat_job_t *pQatJob = calloc(1, sizeof(dc_qat_job_t));
+
+        if (NULL == pQatJob)
+        {
+            return CPA_STATUS_RESOURCE;
+        }
+        pBroker->pJobs[i].pPriv = pQatJob;
+        pQatJob->srcList.pBuffers = pQatJob->srcFlat;
+        pQatJob->dstList.pBuffers = pQatJob->dstFlat;
+        pQatJob->srcList.pPrivateMetaData =
+            qaeMemAllocNUMA(metaSize, node, DC_BROKER_CACHE_LINE);
+        pQatJob->dstList.pPrivateMetaData =
+            qaeMemAllocNUMA(metaSize, node, DC_BROKER_CACHE_LINE);
+        if (NULL == pQatJob->srcList.pPrivateMetaData ||
+            NULL == pQatJob->dstList.pPrivateMetaData)
+        {
+            return CPA_STATUS_RESOURCE;
+        }
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus dcQatInit(dc_broker_t *pBroker)
+{
+    dc_qat_t *pQat = NULL;
+    CpaInstanceHandle *pHandles = NULL;
+    CpaInstanceInfo2 info;
+    Cpa16U numInter = 0;
+    Cpa16U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pQat = calloc(1, sizeof(dc_qat_t));
+    if (NULL == pQat)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    pBroker->pBackendPriv = pQat;
+
+    status = icp_sal_userStart(pBroker->config.section);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        DC_BROKER_LOG_ERROR("icp_sal_userStart(%s) failed\n",
+                            pBroker->config.section);
+        return status;
+    }
+    pQat->started = CPA_TRUE;
+
+    status = dcQatMapRegion(pBroker);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcGetNumInstances(&pQat->numInst);
+    }
+    if (CPA_STATUS_SUCCESS != status || 0 == pQat->numInst)
+    {
+        DC_BROKER_LOG_ERROR("No compression instance in section %s\n",
+                            pBroker->config.section);
+        return CPA_STATUS_FAIL;
+    }
+    if (pQat->numInst > pBroker->numInstances)
+    {
+        pQat->numInst = pBroker->numInstances;
+    }
+    pBroker->numInstances = pQat->numInst;
+
+    pHandles = calloc(pQat->numInst, sizeof(CpaInstanceHandle));
+    pQat->pInst = calloc(pQat->numInst, sizeof(dc_qat_inst_t));
+    if (NULL == pHandles || NULL == pQat->pInst)
+    {
+        free(pHandles);
+        return CPA_STATUS_RESOURCE;
+    }
+    status = cpaDcGetInstances(pQat->numInst, pHandles);
+    for (i = 0; i < pQat->numInst && CPA_STATUS_SUCCESS == status; i++)
+    {
+        pQat->pInst[i].handle = pHandles[i];
+        status = cpaDcGetNumIntermediateBuffers(pHandles[i], &numInter);
+        if (CPA_STATUS_SUCCESS == status && numInter)
+        {
+            /* Devices that need intermediate buffers are not served */
+            DC_BROKER_LOG_ERROR("Instance %u needs intermediate buffers\n", i);
+            status = CPA_STATUS_UNSUPPORTED;
+            break;
+        }
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = cpaDcSetAddressTranslation(pHandles[i], dcQatVirtToPhys);
+        }
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = cpaDcStartInstance(pHandles[i], 0, NULL);
+            pQat->pInst[i].started = CPA_STATUS_SUCCESS == status;
+        }
+    }
+    free(pHandles);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcInstanceGetInfo2(pQat->pInst[0].handle, &info);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = dcQatAllocJobs(pBroker, info.nodeAffinity);
+    }
+    if (CPA_STATUS_SUCCESS == status && pBroker->config.verbose)
+    {
+        DC_BROKER_LOG_USER("%u instances of section %s\n",
+                           pQat->numInst,
+                           pBroker->config.section);
+    }
+    return status;
+}
+
+/* Finds or sets up the session of the request parameters. The least
+ * recently used idle session makes room for a new one. */
+static dc_qat_session_t *dcQatGetSession(dc_broker_t *pBroker,
+                                         dc_qat_inst_t *pInst,
+                                         const dc_broker_req_t *pReq)
+{
+    dc_qat_t *pQat = pBroker->pBackendPriv;
+    dc_qat_session_t *pVictim = NULL;
+    CpaDcSessionSetupData setup;
+    Cpa32U sessSize = 0;
+    Cpa32U ctxSize = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < DC_BROKER_MAX_SESSIONS; i++)
+    {
+        dc_qat_session_t *pSess = &pInst->sessions[i];
+
+        if (pSess->used && pSess->compLevel == pReq->compLevel &&
+            pSess->huffType == pReq->huffType &&
+            pSess->checksumType == pReq->checksumType)
+        {
+            pSess->lastUse = ++pQat->useCount;
+            return pSess;
+        }
+        if (0 == pSess->inflight &&
+            (NULL == pVictim || !pSess->used ||
+             (pVictim->used && pSess->lastUse < pVictim->lastUse)))
+        {
+            pVictim = pSess;
+        }
+    }
+    if (NULL == pVictim)
+    {
+        return NULL;
+    }
+    if (pVictim->used)
+    {
+        cpaDcRemoveSession(pInst->handle, pVictim->handle);
+        qaeMemFreeNUMA(&pVictim->handle);
+        pVictim->used = CPA_FALSE;
+    }
+
+    memset(&setup, 0, sizeof(setup));
+    setup.compLevel = pReq->compLevel;
+    setup.compType = CPA_DC_DEFLATE;
+    setup.huffType = pReq->huffType;
+    setup.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    setup.sessDirection = CPA_DC_DIR_COMPRESS;
+    setup.sessState = CPA_DC_STATELESS;
+    setup.windowSize = CPA_DC_WINSIZE_32K;
+    setup.checksum = pReq->checksumType;
+    if (CPA_STATUS_SUCCESS !=
+        cpaDcGetSessionSize(pInst->handle, &setup, &sessSize, &ctxSize))
+    {
+        return NULL;
+    }
+    pVictim->handle = qaeMemAllocNUMA(sessSize, 0, DC_BROKER_CACHE_LINE);
+    if (NULL == pVictim->handle)
+    {
+        return NULL;
+    }
+    if (CPA_STATUS_SUCCESS != cpaDcInitSession(pInst->handle,
+                                               pVictim->handle,
+                                               &setup,
+                                               NULL,
+                                               dcQatCallback))
+    {
+        qaeMemFreeNUMA(&pVictim->handle);
+        return NULL;
+    }
+    pVictim->compLevel = pReq->compLevel;
+    pVictim->huffType = pReq->huffType;
+    pVictim->checksumType = pReq->checksumType;
+    pVictim->used = CPA_TRUE;
+    pVictim->lastUse = ++pQat->useCount;
+    return pVictim;
+}
+
+/* Builds a buffer list over the shared region, one flat buffer per
+ * physically contiguous piece */
+static CpaStatus dcQatFillList(dc_broker_t *pBroker,
+                               const dc_broker_buf_t *pBufs,
+                               Cpa32U numBufs,
+                               CpaBufferList *pList)
+{
+    Cpa32U n = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < numBufs; i++)
+    {
+        Cpa64U offset = pBufs[i].offset;
+        Cpa64U left = pBufs[i].len;
+
+        do
+        {
+            Cpa64U room =
+                DC_BROKER_HUGEPAGE_SIZE - offset % DC_BROKER_HUGEPAGE_SIZE;
+            Cpa64U len = left < room ? left : room;
+
+            if (n == DC_QAT_MAX_FLAT)
+            {
+                return CPA_STATUS_INVALID_PARAM;
+            }
+            pList->pBuffers[n].pData = dcBrokerDataPtr(pBroker, offset);
+            pList->pBuffers[n].dataLenInBytes = len;
+            n++;
+            offset += len;
+            left -= len;
+        } while (left);
+    }
+    pList->numBuffers = n;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus dcQatSubmit(dc_broker_t *pBroker, dc_broker_job_t *pJob)
+{
+    dc_qat_t *pQat = pBroker->pBackendPriv;
+    dc_qat_inst_t *pInst = &pQat->pInst[pJob->inst];
+    dc_qat_job_t *pQatJob = pJob->pPriv;
+    dc_qat_session_t *pSess = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = dcQatFillList(
+        pBroker, pJob->req.src, pJob->req.numSrc, &pQatJob->srcList);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = dcQatFillList(
+            pBroker, pJob->req.dst, pJob->req.numDst, &pQatJob->dstList);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    pSess = dcQatGetSession(pBroker, pInst, &pJob->req);
+    if (NULL == pSess)
+    {
+        /* Every session is busy with other parameters */
+        return CPA_STATUS_RETRY;
+    }
+
+    memset(&pQatJob->opData, 0, sizeof(pQatJob->opData));
+    pQatJob->opData.flushFlag = pJob->req.flushFlag;
+    pQatJob->opData.compressAndVerify = pJob->req.compressAndVerify;
+    pQatJob->pSession = pSess;
+    pJob->results.checksum = pJob->req.checksum;
+
+    status = cpaDcCompressData2(pInst->handle,
+                                pSess->handle,
+                                &pQatJob->srcList,
+                                &pQatJob->dstList,
+                                &pQatJob->opData,
+                                &pJob->results,
+                                pJob);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pSess->inflight++;
+    }
+    return status;
+}
+
+static void dcQatPoll(dc_broker_t *pBroker, Cpa32U inst)
+{
+    dc_qat_t *pQat = pBroker->pBackendPriv;
+
+    icp_sal_DcPollInstance(pQat->pInst[inst].handle, 0);
+}
+
+static void dcQatShutdown(dc_broker_t *pBroker)
+{
+    dc_qat_t *pQat = pBroker->pBackendPriv;
+    Cpa32U i = 0;
+    Cpa32U s = 0;
+
+    if (NULL == pQat)
+    {
+        return;
+    }
+    for (i = 0; NULL != pQat->pInst && i < pQat->numInst; i++)
+    {
+        dc_qat_inst_t *pInst = &pQat->pInst[i];
+
+        for (s = 0; s < DC_BROKER_MAX_SESSIONS; s++)
+        {
+            if (pInst->sessions[s].used)
+            {
+                cpaDcRemoveSession(pInst->handle, pInst->sessions[s].handle);
+                qaeMemFreeNUMA(&pInst->sessions[s].handle);
+            }
+        }
+        if (pInst->started)
+        {
+            cpaDcStopInstance(pInst->handle);
+        }
+    }
+    dcQatFreeJobs(pBroker);
+    if (pQat->started)
+    {
+        icp_sal_userStop();
+    }
+    free(pQat->pInst);
+    free(pQat);
+    free(dcQatPhys);
+    dcQatPhys = NULL;
+    dcQatBase = NULL;
+    dcQatSize = 0;
+    pBroker->pBackendPriv = NULL;
+}
+
+const dc_broker_backend_t dcBrokerQatBackend = {"QAT",
+                                                dcQatInit,
+                                                dcQatSubmit,
+                                                dcQatPoll,
+                                                dcQatShutdown};
@@ -0,0 +1,398 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file dc_broker.h
+ *
+ * @description
+ *        DC instance broker. A daemon owns the compression instances and
+ *        many client processes submit through a shared memory region:
+ *        each client gets a lock-free request ring, a response ring and a
+ *        slice of the buffer area, so the data is never copied. Requests
+ *        are multiplexed onto the instances with deficit round robin.
+ *
+ ***************************************************************************/
+#ifndef DC_BROKER_H
+#define DC_BROKER_H
+
+#include <sys/types.h>
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "Osal.h"
+
+#define DC_BROKER_MAGIC 0x44434252 /* "DCBR" */
+#define DC_BROKER_VERSION 1
+
+#define DC_BROKER_DEFAULT_PATH "/dev/shm/dc_broker"
+#define DC_BROKER_DEFAULT_SECTION "SSL"
+#define DC_BROKER_DEFAULT_CLIENTS 256
+#define DC_BROKER_DEFAULT_DATA_MB 256
+#define DC_BROKER_DEFAULT_INSTANCES 4
+#define DC_BROKER_DEFAULT_DEPTH 64
+#define DC_BROKER_DEFAULT_QUANTUM (64 * 1024)
+
+#define DC_BROKER_MAX_CLIENTS 4096
+#define DC_BROKER_MAX_INSTANCES 64
+#define DC_BROKER_MAX_SESSIONS 8
+/* Entries of every request and response ring, a power of 2 */
+#define DC_BROKER_RING_SIZE 64
+#define DC_BROKER_MAX_FLAT 4
+#define DC_BROKER_CACHE_LINE 64
+#define DC_BROKER_PAGE_SIZE 4096
+#define DC_BROKER_HUGEPAGE_SIZE (2 * 1024 * 1024)
+#define DC_BROKER_PAGE_TAIL 0xFFFFFFFF
+
+#define DC_BROKER_LOG_ERROR(format, ...)                                       \
+    osalLog(OSAL_LOG_LVL_ERROR, OSAL_LOG_DEV_STDERR, format, ##__VA_ARGS__)
+
+#define DC_BROKER_LOG_USER(format, ...)                                        \
+    osalLog(OSAL_LOG_LVL_USER, OSAL_LOG_DEV_STDOUT, format, ##__VA_ARGS__)
+
+/* Client slot states. A client claims a free slot, the broker frees it
+ * once the client is closing and nothing is in flight. */
+typedef enum dc_broker_slot_state_e
+{
+    DC_BROKER_SLOT_FREE = 0,
+    DC_BROKER_SLOT_CLAIMED,
+    /**< Taken by a client still setting it up */
+    DC_BROKER_SLOT_ACTIVE,
+    DC_BROKER_SLOT_CLOSING
+    /**< Detached or dead, drained by the broker */
+} dc_broker_slot_state_t;
+
+/* Buffer in the data area, by offset so every process can map it */
+typedef struct dc_broker_buf_s
+{
+    Cpa64U offset;
+    Cpa32U len;
+    Cpa32U reserved;
+} dc_broker_buf_t;
+
+/* Request, the shared memory form of a cpaDcCompressData2() call */
+typedef struct dc_broker_req_s
+{
+    Cpa32U tag;
+    /**< Client pending entry, echoed in the response */
+    Cpa32U checksum;
+    /**< Initial checksum, as pResults->checksum on input */
+    dc_broker_buf_t src[DC_BROKER_MAX_FLAT];
+    dc_broker_buf_t dst[DC_BROKER_MAX_FLAT];
+    Cpa8U numSrc;
+    Cpa8U numDst;
+    Cpa8U compLevel;
+    Cpa8U huffType;
+    Cpa8U checksumType;
+    Cpa8U flushFlag;
+    Cpa8U compressAndVerify;
+    Cpa8U reserved;
+} dc_broker_req_t;
+
+typedef struct dc_broker_resp_s
+{
+    Cpa32U tag;
+    Cpa32S status;
+    /**< CpaStatus of the operation */
+    Cpa32S dcStatus;
+    /**< CpaDcReqStatus */
+    Cpa32U consumed;
+    Cpa32U produced;
+    Cpa32U checksum;
+    Cpa8U endOfLastBlock;
+    Cpa8U reserved[7];
+} dc_broker_resp_t;
+
+/* Single producer, single consumer ring indexes. Both only grow, the
+ * entry is index % DC_BROKER_RING_SIZE. */
+typedef struct dc_broker_ring_s
+{
+    volatile Cpa32U head __attribute__((aligned(DC_BROKER_CACHE_LINE)));
+    /**< Written by the producer */
+    volatile Cpa32U tail __attribute__((aligned(DC_BROKER_CACHE_LINE)));
+    /**< Written by the consumer */
+} dc_broker_ring_t;
+
+typedef struct dc_broker_slot_s
+{
+    volatile Cpa32U state;
+    volatile Cpa32S pid;
+    Cpa64U dataOffset;
+    /**< Buffer area of the client */
+    Cpa64U dataSize;
+    volatile Cpa64U submitted;
+    volatile Cpa64U completed;
+    volatile Cpa64U bytesIn;
+    volatile Cpa64U bytesOut;
+    /**< Updated by the broker */
+    dc_broker_ring_t reqRing;
+    dc_broker_req_t req[DC_BROKER_RING_SIZE];
+    dc_broker_ring_t respRing;
+    dc_broker_resp_t resp[DC_BROKER_RING_SIZE];
+} __attribute__((aligned(DC_BROKER_CACHE_LINE))) dc_broker_slot_t;
+
+/* Start of the shared region, followed by the slots and the data area */
+typedef struct dc_broker_shm_s
+{
+    Cpa32U magic;
+    Cpa32U version;
+    Cpa32U maxClients;
+    Cpa32U ringSize;
+    Cpa64U shmSize;
+    Cpa64U dataOffset;
+    Cpa64U dataSize;
+    volatile Cpa32S brokerPid;
+    volatile Cpa32U running;
+    dc_broker_slot_t slots[] __attribute__((aligned(DC_BROKER_CACHE_LINE)));
+} dc_broker_shm_t;
+
+static inline Cpa32U dcBrokerRingCount(dc_broker_ring_t *pRing)
+{
+    return __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Client library
+ */
+
+/* Session as seen by a client: the broker owns the real sessions and
+ * keys them by these parameters */
+typedef struct dc_broker_session_s
+{
+    CpaDcSessionSetupData setup;
+    CpaDcCallbackFn pCallbackFn;
+    /**< NULL for synchronous operation */
+} dc_broker_session_t;
+
+typedef struct dc_broker_pending_s
+{
+    CpaDcRqResults *pResults;
+    void *callbackTag;
+    dc_broker_session_t *pSession;
+    volatile CpaBoolean done;
+    CpaStatus status;
+} dc_broker_pending_t;
+
+typedef struct dc_broker_client_s
+{
+    int fd;
+    dc_broker_shm_t *pShm;
+    dc_broker_slot_t *pSlot;
+    Cpa32U slotIdx;
+    Cpa8U *pData;
+    /**< Buffer area of this client */
+    Cpa32U numPages;
+    Cpa32U *pPageRun;
+    /**< Per page: 0 free, pages allocated when first of a buffer,
+     * DC_BROKER_PAGE_TAIL otherwise */
+    dc_broker_pending_t pending[DC_BROKER_RING_SIZE];
+    Cpa32U freeTags[DC_BROKER_RING_SIZE];
+    Cpa32U numFreeTags;
+} dc_broker_client_t;
+
+CpaStatus dcBrokerClientAttach(const char *pPath,
+                               dc_broker_client_t **ppClient);
+void dcBrokerClientDetach(dc_broker_client_t *pClient);
+
+/* Buffers handed to dcBrokerCompressData2() must come from here */
+void *dcBrokerMemAlloc(dc_broker_client_t *pClient, Cpa32U size);
+void dcBrokerMemFree(dc_broker_client_t *pClient, void *pMem);
+
+CpaStatus dcBrokerInitSession(dc_broker_client_t *pClient,
+                              dc_broker_session_t *pSession,
+                              const CpaDcSessionSetupData *pSetup,
+                              CpaDcCallbackFn pCallbackFn);
+
+/* Same contract as cpaDcCompressData2(): CPA_STATUS_RETRY when the ring
+ * is full, pResults is valid once the callback runs from
+ * dcBrokerClientPoll(). Synchronous when the session has no callback. */
+CpaStatus dcBrokerCompressData2(dc_broker_client_t *pClient,
+                                dc_broker_session_t *pSession,
+                                CpaBufferList *pSrcBuff,
+                                CpaBufferList *pDestBuff,
+                                CpaDcOpData *pOpData,
+                                CpaDcRqResults *pResults,
+                                void *callbackTag);
+
+/* Like icp_sal_DcPollInstance(): CPA_STATUS_RETRY when nothing completed,
+ * CPA_STATUS_FAIL once the broker is gone. 0 means no limit. */
+CpaStatus dcBrokerClientPoll(dc_broker_client_t *pClient,
+                             Cpa32U responseQuota);
+
+/*
+ * Broker
+ */
+
+typedef enum dc_broker_backend_type_e
+{
+    DC_BROKER_BACKEND_QAT = 0,
+    DC_BROKER_BACKEND_EMU
+    /**< Software instances, stored deflate blocks with a latency model */
+} dc_broker_backend_type_t;
+
+typedef struct dc_broker_config_s
+{
+    char path[FILENAME_MAX];
+    char section[FILENAME_MAX];
+    Cpa32U maxClients;
+    Cpa64U dataSize;
+    Cpa32U numInstances;
+    Cpa32U depth;
+    /**< Requests in flight per instance */
+    Cpa32U quantum;
+    /**< Bytes a client may submit per scheduling round */
+    dc_broker_backend_type_t backend;
+    Cpa32U emuLatencyUs;
+    Cpa32U emuMBps;
+    /**< Throughput of one emulated instance */
+    CpaBoolean verbose;
+} dc_broker_config_t;
+
+struct dc_broker_s;
+
+/* Request taken from a client ring and handed to a backend */
+typedef struct dc_broker_job_s
+{
+    struct dc_broker_s *pBroker;
+    dc_broker_req_t req;
+    Cpa32U client;
+    Cpa32U inst;
+    CpaDcRqResults results;
+    CpaStatus status;
+    Cpa64U doneNs;
+    /**< Completion time, emulated backend */
+    Cpa64U bytes;
+    struct dc_broker_job_s *pNext;
+    void *pPriv;
+    /**< Backend data, e.g. buffer lists */
+} dc_broker_job_t;
+
+typedef struct dc_broker_backend_s
+{
+    const char *name;
+    CpaStatus (*init)(struct dc_broker_s *pBroker);
+    CpaStatus (*submit)(struct dc_broker_s *pBroker, dc_broker_job_t *pJob);
+    /**< CPA_STATUS_RETRY leaves the request on the client ring */
+    void (*poll)(struct dc_broker_s *pBroker, Cpa32U inst);
+    void (*shutdown)(struct dc_broker_s *pBroker);
+} dc_broker_backend_t;
+
+typedef struct dc_broker_inst_s
+{
+    Cpa32U inflight;
+    Cpa64U jobs;
+    Cpa64U bytes;
+    void *pPriv;
+} dc_broker_inst_t;
+
+/* Data area of a client, the broker's own copy of the slot fields the
+ * client could overwrite */
+typedef struct dc_broker_region_s
+{
+    Cpa64U base;
+    Cpa64U size;
+} dc_broker_region_t;
+
+typedef struct dc_broker_s
+{
+    dc_broker_config_t config;
+    int fd;
+    dc_broker_shm_t *pShm;
+    Cpa8U *pData;
+    /**< Data area mapped in the broker */
+    const dc_broker_backend_t *pBackend;
+    void *pBackendPriv;
+    dc_broker_inst_t inst[DC_BROKER_MAX_INSTANCES];
+    Cpa32U numInstances;
+    Cpa32U *pDeficit;
+    Cpa32U *pInflight;
+    dc_broker_region_t *pRegions;
+    dc_broker_job_t *pJobs;
+    dc_broker_job_t *pFreeJobs;
+    Cpa32U rrNext;
+    /**< Client whose turn it is */
+    CpaBoolean rrGranted;
+    /**< The quantum of the current turn was given */
+    Cpa64U loops;
+    volatile Cpa32U stop;
+} dc_broker_t;
+
+void dcBrokerSetDefaults(dc_broker_config_t *pConfig);
+CpaStatus dcBrokerInit(dc_broker_t *pBroker, const dc_broker_config_t *pConfig);
+/* Serves clients until pBroker->stop is set */
+CpaStatus dcBrokerRun(dc_broker_t *pBroker);
+/* One scheduling pass, returns the number of requests moved */
+Cpa32U dcBrokerPoll(dc_broker_t *pBroker);
+void dcBrokerShutdown(dc_broker_t *pBroker);
+void dcBrokerPrintStats(dc_broker_t *pBroker);
+
+/* Called by the backends when a job is done */
+void dcBrokerComplete(dc_broker_t *pBroker, dc_broker_job_t *pJob);
+void *dcBrokerDataPtr(dc_broker_t *pBroker, Cpa64U offset);
+
+Cpa64U dcBrokerNowNs(void);
+Cpa32U dcBrokerCrc32(Cpa32U crc, const Cpa8U *pData, Cpa32U len);
+Cpa32U dcBrokerAdler32(Cpa32U adler, const Cpa8U *pData, Cpa32U len);
+
+extern const dc_broker_backend_t dcBrokerEmuBackend;
+extern const dc_broker_backend_t dcBrokerQatBackend;
+
+#endif /* DC_BROKER_H */
@@ -0,0 +1,237 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file lac_bench.h
+ *
+ * @description
+ *        Benchmarks of the CPU side hot paths of the library. The rings,
+ *        the DMA memory and the instances are emulated, so the benchmarks
+ *        run without a device. Every benchmark is swept over a range of
+ *        thread counts; the results can be saved and compared against a
+ *        baseline to catch regressions.
+ *
+ ***************************************************************************/
+#ifndef LAC_BENCH_H
+#define LAC_BENCH_H
+
+#include <pthread.h>
+#include <stdio.h>
+#include "cpa.h"
+#include "Osal.h"
+#include "lac_bench_mem.h"
+
+#define LAC_BENCH_DEFAULT_MAX_THREADS 1
+#define LAC_BENCH_DEFAULT_REPS 5
+#define LAC_BENCH_DEFAULT_MS 200
+#define LAC_BENCH_DEFAULT_SIZE 4096
+#define LAC_BENCH_DEFAULT_SEGMENTS 4
+#define LAC_BENCH_DEFAULT_TOLERANCE 10
+
+#define LAC_BENCH_MAX_THREADS 256
+#define LAC_BENCH_MAX_REPS 101
+#define LAC_BENCH_MAX_SEGMENTS 64
+#define LAC_BENCH_MAX_SIZE (16 * 1024 * 1024)
+#define LAC_BENCH_MAX_RESULTS 1024
+#define LAC_BENCH_NAME_LEN 32
+
+#define LAC_BENCH_NSEC_PER_SEC 1000000000ULL
+#define LAC_BENCH_NSEC_PER_MSEC 1000000ULL
+#define LAC_BENCH_BYTES_PER_GB 1000000000.0
+
+#define LAC_BENCH_LOG_ERROR(format, ...)                                       \
+    osalLog(OSAL_LOG_LVL_ERROR, OSAL_LOG_DEV_STDERR, format, ##__VA_ARGS__)
+
+#define LAC_BENCH_LOG_USER(format, ...)                                        \
+    osalLog(OSAL_LOG_LVL_USER, OSAL_LOG_DEV_STDOUT, format, ##__VA_ARGS__)
+
+typedef struct lac_bench_config_s
+{
+    Cpa32U maxThreads;
+    /**< Thread counts 1, 2, 4, ... up to and including maxThreads */
+    Cpa32U reps;
+    /**< Timed runs per point, the median is reported */
+    Cpa32U runMs;
+    /**< Target duration of one timed run */
+    Cpa32U size;
+    /**< Bytes of data per operation */
+    Cpa32U segments;
+    /**< Flat buffers the data is split into */
+    Cpa32U tolerance;
+    /**< Slow down, in percent, counted as a regression */
+    CpaBoolean pin;
+    const char *pFilter;
+    /**< Comma separated benchmark names, NULL for all */
+    const char *pOutFile;
+    const char *pBaseFile;
+} lac_bench_config_t;
+
+struct lac_bench_s;
+
+/* One benchmark thread. pShared is set up once per benchmark, pPriv by
+ * each thread for itself. */
+typedef struct lac_bench_thread_s
+{
+    const lac_bench_config_t *pConfig;
+    const struct lac_bench_s *pBench;
+    void *pShared;
+    void *pPriv;
+    Cpa32U idx;
+    Cpa32S cpu;
+    /**< CPU the thread is pinned to, -1 when not pinned */
+    Cpa64U iterations;
+    Cpa64U errors;
+    /**< Operations that did not return CPA_STATUS_SUCCESS */
+    Cpa64U startNs;
+    Cpa64U endNs;
+    CpaStatus status;
+    pthread_t tid;
+    struct lac_bench_run_s *pRun;
+} lac_bench_thread_t;
+
+typedef struct lac_bench_s
+{
+    const char *name;
+    const char *desc;
+    CpaStatus (*init)(const lac_bench_config_t *pConfig, void **ppShared);
+    /**< Optional, called once before the sweep */
+    void (*fini)(void *pShared);
+    CpaStatus (*setup)(lac_bench_thread_t *pThread);
+    /**< Called by every thread before the timed runs */
+    void (*run)(lac_bench_thread_t *pThread, Cpa64U iterations);
+    /**< Performs iterations operations */
+    void (*teardown)(lac_bench_thread_t *pThread);
+    CpaBoolean perByte;
+    /**< An operation processes size bytes, the data rate is reported */
+} lac_bench_t;
+
+/* Median of the timed runs of one benchmark at one thread count */
+typedef struct lac_bench_result_s
+{
+    char name[LAC_BENCH_NAME_LEN];
+    Cpa32U threads;
+    Cpa32U size;
+    double nsPerOp;
+    /**< Mean time of an operation in a thread */
+    double opsPerSec;
+    /**< Operations of all the threads per second of wall time */
+    double gbPerSec;
+    /**< Data rate of all the threads, 0 when not reported */
+    double spread;
+    /**< (max - min) / median of nsPerOp over the runs, in percent */
+    Cpa64U errors;
+} lac_bench_result_t;
+
+extern const lac_bench_t lacBenchList[];
+extern const Cpa32U lacBenchListSize;
+
+Cpa64U lacBenchNowNs(void);
+void lacBenchSetDefaults(lac_bench_config_t *pConfig);
+CpaBoolean lacBenchSelected(const lac_bench_config_t *pConfig,
+                            const char *pName);
+/* Runs the sweep of one benchmark and appends a result per thread count */
+CpaStatus lacBenchSweep(const lac_bench_config_t *pConfig,
+                        const lac_bench_t *pBench,
+                        lac_bench_result_t *pResults,
+                        Cpa32U *pNumResults);
+void lacBenchPrintHeader(void);
+void lacBenchPrintResult(const lac_bench_result_t *pResult);
+CpaStatus lacBenchSave(const char *pPath,
+                       const lac_bench_result_t *pResults,
+                       Cpa32U numResults);
+/* Returns the number of results slower than the baseline by more than
+ * the tolerance, or -1 when the baseline cannot be read */
+Cpa32S lacBenchCompare(const char *pPath,
+                       Cpa32U tolerance,
+                       const lac_bench_result_t *pResults,
+                       Cpa32U numResults);
+
+/*
+ * Emulated device
+ */
+
+/* Pair of emulated request and response rings, one per thread */
+struct lac_bench_rings_s;
+typedef struct lac_bench_rings_s lac_bench_rings_t;
+
+typedef void (*lac_bench_resp_fn_t)(void *pMsg);
+
+CpaStatus lacBenchRingsCreate(Cpa32U numMsgs,
+                              lac_bench_resp_fn_t pRespFn,
+                              lac_bench_rings_t **ppRings);
+void lacBenchRingsDestroy(lac_bench_rings_t *pRings);
+/* Moves the requests the device was notified of to the response ring */
+Cpa32U lacBenchRingsProcess(lac_bench_rings_t *pRings);
+void *lacBenchRingsTx(lac_bench_rings_t *pRings);
+void *lacBenchRingsRx(lac_bench_rings_t *pRings);
+
+/* Compression service and buffer lists backed by emulated memory */
+void *lacBenchDcServiceCreate(void);
+void lacBenchDcServiceDestroy(void *pService);
+CpaStatus lacBenchBufferListCreate(void *pService,
+                                   Cpa8U *pData,
+                                   Cpa32U size,
+                                   Cpa32U segments,
+                                   CpaBufferList **ppList);
+void lacBenchBufferListDestroy(CpaBufferList *pList);
+
+#endif /* LAC_BENCH_H */
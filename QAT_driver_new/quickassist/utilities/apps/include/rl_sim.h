@@ -0,0 +1,272 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file rl_sim.h
+ *
+ * @description
+ *        Rate limiting simulator. Replays tenant traces against an SLA
+ *        tree using the rate limiting v2 budget model of the kernel
+ *        driver, without any QuickAssist hardware.
+ *
+ ***************************************************************************/
+#ifndef RL_SIM_H
+#define RL_SIM_H
+
+#include <stdio.h>
+#include "cpa.h"
+#include "adf_rl_v2_calc.h"
+
+#define RL_SIM_MAX_NAME 32
+#define RL_SIM_MAX_CLUSTERS RL_MAX_CLUSTER
+#define RL_SIM_MAX_LEAVES RL_MAX_LEAF
+
+/* Size of a PCIe token of the budget model, in bytes */
+#define RL_SIM_TOKEN_BYTES RL_TOKEN_PCIE_SIZE
+
+#define RL_SIM_NSEC_PER_SEC 1000000000ULL
+#define RL_SIM_NSEC_PER_USEC 1000ULL
+
+#define RL_SIM_LOG_ERROR(format, ...)                                          \
+    fprintf(stderr, "rl_sim: " format, ##__VA_ARGS__)
+
+/* Request replayed from a trace */
+typedef struct rl_sim_request_s
+{
+    Cpa64U arrivalNs;
+    /**< Arrival time since the start of the trace */
+    Cpa64U bytes;
+    /**< Size of the request */
+    Cpa64U delayNs;
+    /**< Time from arrival to the end of the scan that completed it */
+} rl_sim_request_t;
+
+/* Node of the simulated SLA tree */
+typedef struct rl_sim_node_s
+{
+    char name[RL_SIM_MAX_NAME];
+    /**< Name given in the configuration */
+    struct adf_user_sla sla;
+    /**< SLA of the node */
+    struct rl_node_info info;
+    /**< Budget accounting shared with the kernel driver */
+    struct rl_v2_budget budget;
+    /**< Firmware budgets per scan interval */
+    Cpa32U grantedTokens;
+    /**< Tokens granted in the current scan interval */
+} rl_sim_node_t;
+
+/* Tenant attached to a leaf node */
+typedef struct rl_sim_leaf_s
+{
+    rl_sim_node_t node;
+    /**< Leaf node of the tenant */
+    Cpa32U clusterIdx;
+    /**< Index of the parent cluster */
+    char traceFile[FILENAME_MAX];
+    /**< Trace replayed by the tenant */
+    rl_sim_request_t *pRequests;
+    /**< Requests of the trace */
+    Cpa32U numRequests;
+    /**< Number of requests in the trace */
+    Cpa32U nextArrival;
+    /**< First request that has not arrived yet */
+    Cpa32U head;
+    /**< First request that is not complete */
+    Cpa64U headBytesLeft;
+    /**< Bytes of the head request still to be granted */
+    Cpa64U bytesOffered;
+    /**< Bytes of all the requests of the trace */
+    Cpa64U bytesServed;
+    /**< Bytes granted so far */
+    Cpa64U queuedBytes;
+    /**< Bytes of the arrived requests still to be granted */
+    Cpa64U committedTokens;
+    /**< CIR tokens made available over the simulated time */
+    Cpa64U committedUsedTokens;
+    /**< CIR tokens granted */
+    Cpa64U excessTokens;
+    /**< Tokens granted above CIR */
+    Cpa64U lastCompletionNs;
+    /**< End of the scan that completed the last request */
+} rl_sim_leaf_t;
+
+/* Simulation configuration and state */
+typedef struct rl_sim_s
+{
+    struct rl_v2_svc_params params;
+    /**< Device parameters of the simulated service */
+    rl_sim_node_t root;
+    /**< Root node of the service */
+    rl_sim_node_t clusters[RL_SIM_MAX_CLUSTERS];
+    Cpa32U numClusters;
+    rl_sim_leaf_t leaves[RL_SIM_MAX_LEAVES];
+    Cpa32U numLeaves;
+    Cpa32U bytesPerUnit;
+    /**< Bytes of a trace work size unit */
+    Cpa64U maxDurationNs;
+    /**< Simulation stops after this time, 0 to run the traces to the end */
+    Cpa64U scanNs;
+    /**< Length of a scan interval */
+    Cpa64U numScans;
+    /**< Scan intervals simulated */
+    Cpa64U endNs;
+    /**< Simulated time */
+} rl_sim_t;
+
+/*
+ ******************************************************************
+ * @ingroup rl
+ *        Set the default device parameters
+ *
+ * @description
+ *        This function sets the device parameters of a 4xxx device
+ *        for the service and gives the root node the whole service
+ *        throughput.
+ *
+ * @param[out] pSim      pointer to simulation
+ * @param[in]  svcType   simulated service
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+void rlSimSetDefaults(rl_sim_t *pSim, enum adf_svc_type svcType);
+
+/*
+ ******************************************************************
+ * @ingroup rl
+ *        Add a node to the SLA tree
+ *
+ * @description
+ *        This function checks the SLA of the node with the rules of
+ *        the kernel driver, computes its firmware budgets and spends
+ *        its CIR from the parent node.
+ *
+ * @param[in]  pSim      pointer to simulation
+ * @param[in]  pParent   parent node
+ * @param[in]  pNode     node to add, name and SLA set
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_INVALID_PARAM   SLA out of range or too low
+ * @retval CPA_STATUS_RESOURCE        Not enough budget in the parent
+ *
+ ******************************************************************
+ */
+CpaStatus rlSimAddNode(rl_sim_t *pSim,
+                       rl_sim_node_t *pParent,
+                       rl_sim_node_t *pNode);
+
+/*
+ ******************************************************************
+ * @ingroup rl
+ *        Load the trace of a tenant
+ *
+ * @description
+ *        This function reads a trace made of "<work size> <interval>"
+ *        lines, the interval being the time in microseconds since the
+ *        previous request.
+ *
+ * @param[in]  pSim      pointer to simulation
+ * @param[in]  pLeaf     tenant, traceFile set
+ *
+ * @retval CPA_STATUS_SUCCESS         Operation successful
+ * @retval CPA_STATUS_FAIL            Trace could not be read
+ * @retval CPA_STATUS_RESOURCE        Error allocating memory
+ *
+ ******************************************************************
+ */
+CpaStatus rlSimLoadTrace(rl_sim_t *pSim, rl_sim_leaf_t *pLeaf);
+
+/*
+ ******************************************************************
+ * @ingroup rl
+ *        Run the simulation
+ *
+ * @description
+ *        This function replays the traces scan interval by scan
+ *        interval. In each interval every leaf is granted its pending
+ *        demand up to its CIR, then the spare PIR budget of the
+ *        clusters and of the root is shared equally between the leaves
+ *        that still have demand. Idle periods are skipped.
+ *
+ * @param[in]  pSim      pointer to simulation
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+void rlSimRun(rl_sim_t *pSim);
+
+/*
+ ******************************************************************
+ * @ingroup rl
+ *        Release the simulation
+ *
+ * @param[in]  pSim      pointer to simulation
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+void rlSimFree(rl_sim_t *pSim);
+#endif
@@ -113,6 +113,7 @@
 #define SLA_MGR_ARGS_CNT_DELETE_ALL 3
 #define SLA_MGR_ARGS_CNT_CAPS 3
 #define SLA_MGR_ARGS_CNT_LIST 3
+#define SLA_MGR_ARGS_CNT_REBALANCE 4
 #define SLA_MGR_ARGS_CNT_MIN SLA_MGR_ARGS_CNT_LIST
 #define SLA_MGR_ARGS_CNT_MAX SLA_MGR_ARGS_CNT_CREATE
 #define SLA_MGR_ARGS_CMD 1
@@ -120,6 +121,7 @@
 #define SLA_MGR_ARGS_CREAT_RATE 3
 #define SLA_MGR_ARGS_SLA_ID 3
 #define SLA_MGR_ARGS_UPDATE_RATE 4
+#define SLA_MGR_ARGS_POLICY 3
 
 /* Enumeration for SLA manager commands */
 typedef enum sla_mgr_cmd_s
@@ -130,6 +132,7 @@ typedef enum sla_mgr_cmd_s
     SLA_MGR_CMD_DELETE_ALL,
     SLA_MGR_CMD_GET_CAPS,
     SLA_MGR_CMD_GET_LIST,
+    SLA_MGR_CMD_REBALANCE,
     SLA_MGR_CMD_UNKNOWN
 } sla_mgr_cmd_t;
 
@@ -146,6 +149,7 @@ struct sla_mgr_args
 #endif
     Cpa16U slaId;
     enum adf_svc_type svcType;
+    Cpa8U *pPolicy;
 };
 
 /*
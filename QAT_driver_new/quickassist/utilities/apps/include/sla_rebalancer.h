@@ -0,0 +1,202 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file sla_rebalancer.h
+ *
+ * @description
+ *        SLA rebalancer. Periodically samples the demand of a set of
+ *        tenants and redistributes CIR/PIR between their SLAs within
+ *        the budget of the service.
+ *
+ ***************************************************************************/
+#ifndef SLA_REBALANCER_H
+#define SLA_REBALANCER_H
+
+#include <stdio.h>
+#include "rl_utils.h"
+#include "adf_rl_v2_calc.h"
+#include "sla_manager.h"
+
+#define SLA_REBAL_MAX_TENANTS ADF_MAX_SLA
+#define SLA_REBAL_LINE_SIZE 512
+
+/* Policy defaults */
+#define SLA_REBAL_DEFAULT_INTERVAL_MS 1000
+#define SLA_REBAL_DEFAULT_HYSTERESIS 10
+#define SLA_REBAL_DEFAULT_HEADROOM 20
+#define SLA_REBAL_DEFAULT_SMOOTHING 50
+#define SLA_REBAL_DEFAULT_BYTES_PER_UNIT 1024
+
+/* Telemetry key holding the bandwidth sent to the device, in Mbps */
+#define SLA_REBAL_TL_DEMAND_KEY "bw_in"
+
+#define SLA_REBAL_PERCENT 100
+#define SLA_REBAL_BITS_PER_MBIT 1000000ULL
+#define SLA_REBAL_USEC_PER_MSEC 1000ULL
+#define SLA_REBAL_USEC_PER_SEC 1000000ULL
+
+/* Where the demand of a tenant is read from */
+typedef enum sla_rebal_demand_e
+{
+    SLA_REBAL_DEMAND_SYSFS = 0,
+    /**< "bw_in" of a telemetry file, e.g. telemetry/rp_A_data */
+    SLA_REBAL_DEMAND_TRACE
+    /**< "<work_size> <interval_us>" trace, replayed one interval per
+     * sample */
+} sla_rebal_demand_t;
+
+/* Where the SLAs are updated */
+typedef enum sla_rebal_backend_e
+{
+    SLA_REBAL_BACKEND_DEVICE = 0,
+    /**< SLA ioctls of the QAT driver */
+    SLA_REBAL_BACKEND_LOCAL
+    /**< In memory SLA tree checked like the driver does */
+} sla_rebal_backend_t;
+
+/* Tenant whose SLA is managed by the rebalancer */
+typedef struct sla_rebal_tenant_s
+{
+    Cpa16U slaId;
+    /**< SLA of the tenant */
+    Cpa32U floorCir;
+    /**< CIR the tenant is always guaranteed */
+    Cpa32U maxPir;
+    /**< Highest PIR the tenant may be given */
+    sla_rebal_demand_t demandType;
+    char demandPath[FILENAME_MAX];
+    FILE *pTrace;
+    /**< Trace replayed, SLA_REBAL_DEMAND_TRACE only */
+    Cpa64U traceNowUs;
+    /**< Trace time reached by the previous sample */
+    Cpa64U nextArrivalUs;
+    /**< Arrival of the first trace request not sampled yet */
+    Cpa64U nextBytes;
+    /**< Size of that request */
+    Cpa32U demand;
+    /**< Smoothed demand in SLA units */
+    Cpa32U cir;
+    Cpa32U pir;
+    /**< SLA currently set */
+    Cpa32U targetCir;
+    Cpa32U targetPir;
+    /**< SLA computed for the current interval */
+    struct rl_node_info localNode;
+    /**< Node of the local backend */
+} sla_rebal_tenant_t;
+
+/* Rebalancer policy and state */
+typedef struct sla_rebal_s
+{
+    struct adf_pci_address pciAddr;
+    enum adf_svc_type svcType;
+    sla_rebal_backend_t backend;
+    CpaBoolean dryRun;
+    /**< Log the intended changes without setting them */
+    CpaBoolean realtime;
+    /**< Wait intervalMs between two samples */
+    Cpa32U intervalMs;
+    Cpa32U hysteresis;
+    /**< Percent of the current CIR a change must exceed to be applied */
+    Cpa32U headroom;
+    /**< Percent added to the demand */
+    Cpa32U smoothing;
+    /**< Weight in percent of a new sample in the smoothed demand */
+    Cpa32U iterations;
+    /**< Number of intervals to run, 0 to run until interrupted */
+    Cpa32U bytesPerUnit;
+    /**< Bytes of a trace work size unit */
+    Cpa32U capacity;
+    /**< CIR shared between the tenants */
+    sla_rebal_tenant_t tenants[SLA_REBAL_MAX_TENANTS];
+    Cpa32U numTenants;
+    struct rl_node_info localRoot;
+    /**< Parent node of the local backend */
+    Cpa64U numUpdates;
+    Cpa64U numHeld;
+    /**< Changes applied and changes held back by the hysteresis */
+} sla_rebal_t;
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Run the SLA rebalancer
+ *
+ * @description
+ *        This function reads the rebalancer policy and then, every
+ *        interval, samples the demand of the tenants and updates
+ *        their SLAs. Each tenant keeps its guaranteed floor; the rest
+ *        of the service budget is shared max-min fairly by demand.
+ *        Changes smaller than the hysteresis are held back and
+ *        decreases are applied before increases so that the parent
+ *        budget is never exceeded.
+ *
+ * @param[in]  pUsrArgs  user arguments structure
+ *
+ * @retval CPA_STATUS_SUCCESS    Operation successful
+ * @retval CPA_STATUS_FAIL       Operation failed
+ *
+ ******************************************************************
+ */
+CpaStatus slaMgrRebalance(struct sla_mgr_args *pUsrArgs);
+#endif
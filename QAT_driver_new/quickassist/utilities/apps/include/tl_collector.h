@@ -0,0 +1,331 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * @file tl_collector.h
+ *
+ * @description
+ *        Telemetry collector. Samples the Gen4 telemetry sysfs
+ *        attributes at a fixed rate, keeps rolling time series and
+ *        flags saturated slices and hot ring pairs. Samples can be
+ *        recorded and replayed without a device.
+ *
+ ***************************************************************************/
+#ifndef TL_COLLECTOR_H
+#define TL_COLLECTOR_H
+
+#include <stdio.h>
+#include "rl_utils.h"
+
+#define TL_COL_SYSFS_DIR                                                       \
+    "/sys/devices/pci%4.4x:%2.2x/%4.4x:%2.2x:%2.2x.%1.1x/telemetry"
+#define TL_COL_DEVICE_FILE "device_data"
+#define TL_COL_RP_FILE "rp_%c_data"
+
+/* Ring pairs the firmware reports at a time, rp_A_data to rp_D_data */
+#define TL_COL_MAX_RP 4
+#define TL_COL_MAX_SLICES 24
+#define TL_COL_MAX_WINDOW 64
+#define TL_COL_MAX_LINES 256
+#define TL_COL_MAX_KEY 32
+/* A sysfs attribute is at most a page */
+#define TL_COL_BUF_SIZE 4096
+#define TL_COL_LINE_SIZE 256
+
+/* Defaults */
+#define TL_COL_DEFAULT_INTERVAL_MS 1000
+#define TL_COL_DEFAULT_WINDOW 10
+#define TL_COL_DEFAULT_UTIL_THRESHOLD 90
+#define TL_COL_DEFAULT_HOT_SHARE 50
+
+/* Recording format: a sample line, then each file as a file line followed
+ * by its sysfs content */
+#define TL_COL_REC_SAMPLE "@sample"
+#define TL_COL_REC_FILE "@file"
+
+#define TL_COL_LOG_ERROR(format, ...)                                          \
+    osalLog(OSAL_LOG_LVL_ERROR, OSAL_LOG_DEV_STDERR, format, ##__VA_ARGS__)
+
+#define TL_COL_LOG_USER(format, ...)                                           \
+    osalLog(OSAL_LOG_LVL_USER, OSAL_LOG_DEV_STDOUT, format, ##__VA_ARGS__)
+
+/* Device counters of device_data */
+typedef enum tl_col_dev_field_e
+{
+    TL_COL_DEV_SAMPLE_CNT = 0,
+    TL_COL_DEV_PCI_TRANS_CNT,
+    TL_COL_DEV_MAX_RD_LAT,
+    TL_COL_DEV_RD_LAT_AVG,
+    TL_COL_DEV_MAX_LAT,
+    TL_COL_DEV_LAT_AVG,
+    TL_COL_DEV_BW_IN,
+    TL_COL_DEV_BW_OUT,
+    TL_COL_DEV_PAGE_REQ_LAT_AVG,
+    TL_COL_DEV_TRANS_LAT_AVG,
+    TL_COL_DEV_MAX_TLB_USED,
+    TL_COL_DEV_NUM_COUNTERS
+} tl_col_dev_field_t;
+
+/* Slice types of device_data, util_<type><slice> */
+typedef enum tl_col_slice_e
+{
+    TL_COL_SLICE_CPR = 0,
+    TL_COL_SLICE_DCPR,
+    TL_COL_SLICE_XLT,
+    TL_COL_SLICE_CPH,
+    TL_COL_SLICE_ATH,
+    TL_COL_SLICE_UCS,
+    TL_COL_SLICE_PKE,
+    TL_COL_SLICE_WAT,
+    TL_COL_SLICE_WCP,
+    TL_COL_SLICE_TYPES
+} tl_col_slice_t;
+
+/* Slice utilisations follow the counters in the device fields */
+#define TL_COL_DEV_SLICE_FIELD(type, slice)                                    \
+    (TL_COL_DEV_NUM_COUNTERS + (type)*TL_COL_MAX_SLICES + (slice))
+#define TL_COL_DEV_NUM_FIELDS TL_COL_DEV_SLICE_FIELD(TL_COL_SLICE_TYPES, 0)
+
+/* Counters of rp_<X>_data */
+typedef enum tl_col_rp_field_e
+{
+    TL_COL_RP_SAMPLE_CNT = 0,
+    TL_COL_RP_NUM,
+    TL_COL_RP_PCI_TRANS_CNT,
+    TL_COL_RP_LAT_AVG,
+    TL_COL_RP_BW_IN,
+    TL_COL_RP_BW_OUT,
+    TL_COL_RP_GLOB_DTLB_HIT,
+    TL_COL_RP_GLOB_DTLB_MISS,
+    TL_COL_RP_PAYLD_DTLB_HIT,
+    TL_COL_RP_PAYLD_DTLB_MISS,
+    TL_COL_RP_NUM_FIELDS
+} tl_col_rp_field_t;
+
+/* Layout of a sysfs attribute learnt on the first read */
+typedef struct tl_col_line_s
+{
+    Cpa16S field;
+    /**< Field of the line, -1 if not collected */
+    Cpa8U keyLen;
+    char key[TL_COL_MAX_KEY];
+} tl_col_line_t;
+
+/* Sysfs attribute read every sample */
+typedef struct tl_col_file_s
+{
+    char name[TL_COL_MAX_KEY];
+    /**< Attribute name, e.g. device_data */
+    int fd;
+    /**< Kept open, re-read from offset 0 */
+    char buf[TL_COL_BUF_SIZE];
+    Cpa32U len;
+    tl_col_line_t lines[TL_COL_MAX_LINES];
+    Cpa32U numLines;
+    /**< Lines of the layout learnt */
+} tl_col_file_t;
+
+/* Rolling window of a metric */
+typedef struct tl_col_series_s
+{
+    Cpa64U values[TL_COL_MAX_WINDOW];
+    Cpa64U sum;
+    Cpa32U head;
+    Cpa32U count;
+} tl_col_series_t;
+
+/* Ring pair slot, one of rp_A_data to rp_D_data */
+typedef struct tl_col_rp_s
+{
+    tl_col_file_t file;
+    Cpa64U values[TL_COL_RP_NUM_FIELDS];
+    tl_col_series_t series[TL_COL_RP_NUM_FIELDS];
+    Cpa32S ringPair;
+    /**< Ring pair to select at start, -1 to keep the current one */
+    CpaBoolean active;
+    /**< Slot read in the current sample */
+    CpaBoolean hot;
+} tl_col_rp_t;
+
+/* Collector configuration and state */
+typedef struct tl_col_s
+{
+    struct adf_pci_address pciAddr;
+    char sysfsDir[FILENAME_MAX];
+    FILE *pReplay;
+    /**< Recording replayed instead of the device */
+    char replayLine[TL_COL_LINE_SIZE];
+    /**< Next line of the recording */
+    FILE *pRecord;
+    /**< Recording written, NULL when not recording */
+    CpaBoolean startTelemetry;
+    /**< Start telemetry at init and stop it at close */
+    Cpa32U intervalMs;
+    Cpa32U window;
+    /**< Samples in the rolling windows */
+    Cpa32U utilThreshold;
+    /**< Percent of average utilisation a saturated slice reaches */
+    Cpa32U hotShare;
+    /**< Percent of the device bw_in a hot ring pair takes */
+    tl_col_file_t device;
+    Cpa64U devValues[TL_COL_DEV_NUM_FIELDS];
+    tl_col_series_t devSeries[TL_COL_DEV_NUM_FIELDS];
+    CpaBoolean devSeen[TL_COL_DEV_NUM_FIELDS];
+    CpaBoolean saturated[TL_COL_SLICE_TYPES][TL_COL_MAX_SLICES];
+    tl_col_rp_t rps[TL_COL_MAX_RP];
+    Cpa64U lastSampleCnt;
+    Cpa64U numSamples;
+    /**< Samples added to the series */
+    Cpa64U numStale;
+    /**< Reads that found no new firmware sample */
+    Cpa64U sampleTimeMs;
+    CpaBoolean done;
+    /**< Replay reached its end */
+} tl_col_t;
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Open the telemetry sources
+ *
+ * @description
+ *        This function opens the telemetry attributes of the device,
+ *        starting telemetry and selecting the ring pairs if asked,
+ *        or the recording to replay.
+ *
+ * @param[in]  pCol      collector, configuration set
+ *
+ * @retval CPA_STATUS_SUCCESS    Operation successful
+ * @retval CPA_STATUS_FAIL       Operation failed
+ *
+ ******************************************************************
+ */
+CpaStatus tlColOpen(tl_col_t *pCol);
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Take a sample
+ *
+ * @description
+ *        This function reads all the attributes, records them if
+ *        asked and adds the values to the rolling series. Parsing
+ *        only compares each line with the layout learnt from the
+ *        previous read and converts its value.
+ *
+ * @param[in]  pCol      collector
+ *
+ * @retval CPA_STATUS_SUCCESS    New sample added
+ * @retval CPA_STATUS_RETRY      Firmware has not produced a new sample
+ * @retval CPA_STATUS_FAIL       Read failed, telemetry off or end of
+ *                               the replay
+ *
+ ******************************************************************
+ */
+CpaStatus tlColSample(tl_col_t *pCol);
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Flag saturated slices and hot ring pairs
+ *
+ * @description
+ *        This function reports a slice whose average utilisation
+ *        over the window reaches the threshold, and a ring pair that
+ *        takes the hot share of the device bandwidth while a slice is
+ *        saturated. Each condition is reported when it is raised and
+ *        when it clears.
+ *
+ * @param[in]  pCol      collector
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+void tlColDetect(tl_col_t *pCol);
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Print the rolling averages
+ *
+ * @param[in]  pCol      collector
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+void tlColReport(tl_col_t *pCol);
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Close the telemetry sources
+ *
+ * @param[in]  pCol      collector
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+void tlColClose(tl_col_t *pCol);
+#endif
@@ -0,0 +1,351 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_bench.h"
+
+#include "lac_common.h"
+#include "lac_sal_types.h"
+#include "sal_types_compression.h"
+#include "icp_sal_buffer_reg.h"
+#include "adf_dev_ring_ctl.h"
+#include "adf_platform_common.h"
+#include "adf_platform_acceldev_common.h"
+
+#define LAC_BENCH_CSR_PAGE_SIZE 4096
+#define LAC_BENCH_TX_RING_NUM 0
+#define LAC_BENCH_RX_RING_NUM 1
+
+/*
+ * Emulated rings. A request ring and a response ring share their in
+ * flight counter, like the rings of an instance. The device takes the
+ * requests up to the tail written to the CSR page and returns the first
+ * 64 bytes of each as its response.
+ */
+
+struct lac_bench_rings_s
+{
+    adf_dev_ring_handle_t tx;
+    adf_dev_ring_handle_t rx;
+    icp_accel_dev_t accelDev;
+    OsalAdaptiveLock txLock;
+    OsalAdaptiveLock rxLock;
+    Cpa32U inFlight;
+    Cpa32U *pCsr;
+    /**< CSR page of the emulated bank */
+    Cpa32U devHead;
+    /**< Next request the device reads */
+    Cpa32U devTail;
+    /**< Next response the device writes */
+};
+
+static CpaStatus lacBenchRingInit(lac_bench_rings_t *pRings,
+                                  adf_dev_ring_handle_t *pRing,
+                                  Cpa32U ringNum,
+                                  Cpa32U numMsgs,
+                                  Cpa32U msgSize,
+                                  OsalAdaptiveLock *pLock)
+{
+    Cpa32U ringBytes = numMsgs * msgSize;
+
+    pRing->ring_virt_addr = lacBenchDmaAlloc(ringBytes, ringBytes);
+    if (NULL == pRing->ring_virt_addr)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    memset(pRing->ring_virt_addr, EMPTY_RING_SIG_BYTE, ringBytes);
+    pRing->ring_phys_base_addr = (uintptr_t)pRing->ring_virt_addr;
+    pRing->accel_dev = &pRings->accelDev;
+    pRing->ring_num = ringNum;
+    pRing->ring_size = ringBytes;
+    pRing->message_size = msgSize;
+    pRing->modulo = __builtin_ctz(ringBytes);
+    pRing->csr_addr = pRings->pCsr;
+    pRing->in_flight = &pRings->inFlight;
+    pRing->max_requests_inflight = numMsgs - 1;
+    pRing->min_resps_per_head_write =
+        ((numMsgs >> 1) > MIN_RESPONSES_PER_HEAD_WRITE)
+            ? MIN_RESPONSES_PER_HEAD_WRITE
+            : numMsgs >> 1;
+    pRing->coal_write_count = pRing->min_resps_per_head_write;
+    pRing->resp = ICP_RESP_TYPE_POLL;
+    /* Lets icp_adf_pollInstance() poll the ring */
+    pRing->pollingMask = 1 << ringNum;
+    pRing->pollingInProgress = 1;
+    pRing->user_lock = pLock;
+    if (OSAL_SUCCESS != osalAdaptiveLockInit(pLock))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus lacBenchRingsCreate(Cpa32U numMsgs,
+                              lac_bench_resp_fn_t pRespFn,
+                              lac_bench_rings_t **ppRings)
+{
+    lac_bench_rings_t *pRings = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (numMsgs < 2 || (numMsgs & (numMsgs - 1)))
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    pRings = calloc(1, sizeof(*pRings));
+    if (NULL == pRings)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    pRings->pCsr =
+        lacBenchDmaAlloc(LAC_BENCH_CSR_PAGE_SIZE, LAC_BENCH_CSR_PAGE_SIZE);
+    if (NULL == pRings->pCsr)
+    {
+        free(pRings);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    status = lacBenchRingInit(pRings,
+                              &pRings->tx,
+                              LAC_BENCH_TX_RING_NUM,
+                              numMsgs,
+                              ADF_MSG_SIZE_128_BYTES,
+                              &pRings->txLock);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = lacBenchRingInit(pRings,
+                                  &pRings->rx,
+                                  LAC_BENCH_RX_RING_NUM,
+                                  numMsgs,
+                                  ADF_MSG_SIZE_64_BYTES,
+                                  &pRings->rxLock);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchRingsDestroy(pRings);
+        return status;
+    }
+    pRings->rx.callback = pRespFn;
+    *ppRings = pRings;
+    return CPA_STATUS_SUCCESS;
+}
+
+void lacBenchRingsDestroy(lac_bench_rings_t *pRings)
+{
+    if (NULL == pRings)
+    {
+        return;
+    }
+    if (pRings->tx.user_lock)
+    {
+        osalAdaptiveLockDestroy(&pRings->txLock);
+    }
+    if (pRings->rx.user_lock)
+    {
+        osalAdaptiveLockDestroy(&pRings->rxLock);
+    }
+    lacBenchDmaFree(pRings->tx.ring_virt_addr);
+    lacBenchDmaFree(pRings->rx.ring_virt_addr);
+    lacBenchDmaFree(pRings->pCsr);
+    free(pRings);
+}
+
+Cpa32U lacBenchRingsProcess(lac_bench_rings_t *pRings)
+{
+    adf_dev_ring_handle_t *pTx = &pRings->tx;
+    adf_dev_ring_handle_t *pRx = &pRings->rx;
+    Cpa32U tail = ICP_ADF_CSR_RD(
+        pRings->pCsr,
+        pTx->bank_offset + ICP_RING_CSR_RING_TAIL_OFFSET +
+            (pTx->ring_num << 2));
+    Cpa32U done = 0;
+
+    while (pRings->devHead != tail)
+    {
+        Cpa32U *pResp =
+            (Cpa32U *)((Cpa8U *)pRx->ring_virt_addr + pRings->devTail);
+        Cpa32U *pReq =
+            (Cpa32U *)((Cpa8U *)pTx->ring_virt_addr + pRings->devHead);
+
+        /* The header last, for a thread polling the response ring */
+        memcpy(pResp + 1, pReq + 1, pRx->message_size - sizeof(Cpa32U));
+        __atomic_store_n(pResp, *pReq, __ATOMIC_RELEASE);
+        pRings->devHead =
+            modulo(pRings->devHead + pTx->message_size, pTx->modulo);
+        pRings->devTail =
+            modulo(pRings->devTail + pRx->message_size, pRx->modulo);
+        done++;
+    }
+    return done;
+}
+
+void *lacBenchRingsTx(lac_bench_rings_t *pRings)
+{
+    return &pRings->tx;
+}
+
+void *lacBenchRingsRx(lac_bench_rings_t *pRings)
+{
+    return &pRings->rx;
+}
+
+/*
+ * Emulated compression instance. Only the fields read on the request
+ * path are set: a started gen 4 instance translating addresses with the
+ * user space page table.
+ */
+
+void *lacBenchDcServiceCreate(void)
+{
+    sal_compression_service_t *pService = NULL;
+
+    pService = calloc(1, sizeof(*pService));
+    if (NULL == pService)
+    {
+        return NULL;
+    }
+    pService->generic_service_info.type = SAL_SERVICE_TYPE_COMPRESSION;
+    pService->generic_service_info.state = SAL_SERVICE_STATE_RUNNING;
+    pService->generic_service_info.isInstanceStarted = CPA_TRUE;
+    pService->generic_service_info.gen = GEN4;
+    return pService;
+}
+
+void lacBenchDcServiceDestroy(void *pService)
+{
+    free(pService);
+}
+
+/* The buffers are consecutive slices of pData. The metadata is sized
+ * for registration, which also fits an unregistered list. */
+CpaStatus lacBenchBufferListCreate(void *pService,
+                                   Cpa8U *pData,
+                                   Cpa32U size,
+                                   Cpa32U segments,
+                                   CpaBufferList **ppList)
+{
+    CpaBufferList *pList = NULL;
+    Cpa32U metaSize = 0;
+    Cpa32U offset = 0;
+    Cpa32U i = 0;
+
+    if (0 == segments || size < segments)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (CPA_STATUS_SUCCESS !=
+        icp_sal_BufferListRegMetaSize(pService, segments, &metaSize))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    pList = calloc(1, sizeof(*pList) + segments * sizeof(CpaFlatBuffer));
+    if (NULL == pList)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    pList->pPrivateMetaData =
+        lacBenchDmaAlloc(metaSize, ICP_DESCRIPTOR_ALIGNMENT_BYTES);
+    if (NULL == pList->pPrivateMetaData)
+    {
+        free(pList);
+        return CPA_STATUS_RESOURCE;
+    }
+    pList->pBuffers = (CpaFlatBuffer *)(pList + 1);
+    pList->numBuffers = segments;
+    for (i = 0; i < segments; i++)
+    {
+        Cpa32U len = size / segments;
+
+        if (segments - 1 == i)
+        {
+            len = size - offset;
+        }
+        pList->pBuffers[i].pData = pData + offset;
+        pList->pBuffers[i].dataLenInBytes = len;
+        offset += len;
+    }
+    *ppList = pList;
+    return CPA_STATUS_SUCCESS;
+}
+
+void lacBenchBufferListDestroy(CpaBufferList *pList)
+{
+    if (NULL == pList)
+    {
+        return;
+    }
+    icp_sal_BufferListUnregister(pList);
+    lacBenchDmaFree(pList->pPrivateMetaData);
+    free(pList);
+}
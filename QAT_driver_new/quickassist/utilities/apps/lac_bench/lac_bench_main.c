@@ -0,0 +1,298 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_bench.h"
+
+static lac_bench_result_t lacBenchResults[LAC_BENCH_MAX_RESULTS];
+
+/*
+ ******************************************************************
+ * @ingroup lac_bench
+ *        Display command line argument help string.
+ *
+ * @param[in]  pExe  pointer to name of executable file
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+static void lacBenchPrintHelp(const char *pExe)
+{
+    LAC_BENCH_LOG_USER(
+        "\nlac_bench measures the CPU cost of the library hot paths on\n"
+        "emulated rings and memory, no device is needed.\n"
+        "\nUsage:\n"
+        "\t%s [options]\n"
+        "\nOptions:\n"
+        "\t-T <count>    sweep 1, 2, 4, ... up to count threads\n"
+        "\t              (default %d, max %d)\n"
+        "\t-r <count>    timed runs per point, the median is kept\n"
+        "\t              (default %d, max %d)\n"
+        "\t-d <ms>       duration of a timed run (default %d)\n"
+        "\t-s <bytes>    data per operation (default %d)\n"
+        "\t-g <count>    flat buffers per buffer list (default %d, max %d)\n"
+        "\t-f <names>    comma separated benchmarks to run (default all)\n"
+        "\t-l            list the benchmarks\n"
+        "\t-a            do not pin the threads to CPUs\n"
+        "\t-o <file>     save the results\n"
+        "\t-b <file>     compare against results saved with -o, exit\n"
+        "\t              with an error on a regression\n"
+        "\t-t <percent>  slow down counted as a regression (default %d)\n",
+        pExe,
+        LAC_BENCH_DEFAULT_MAX_THREADS,
+        LAC_BENCH_MAX_THREADS,
+        LAC_BENCH_DEFAULT_REPS,
+        LAC_BENCH_MAX_REPS,
+        LAC_BENCH_DEFAULT_MS,
+        LAC_BENCH_DEFAULT_SIZE,
+        LAC_BENCH_DEFAULT_SEGMENTS,
+        LAC_BENCH_MAX_SEGMENTS,
+        LAC_BENCH_DEFAULT_TOLERANCE);
+}
+
+static void lacBenchPrintList(void)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < lacBenchListSize; i++)
+    {
+        LAC_BENCH_LOG_USER(
+            "%-14s %s\n", lacBenchList[i].name, lacBenchList[i].desc);
+    }
+}
+
+static CpaStatus lacBenchCheckConfig(const lac_bench_config_t *pConfig)
+{
+    if (0 == pConfig->maxThreads ||
+        pConfig->maxThreads > LAC_BENCH_MAX_THREADS)
+    {
+        LAC_BENCH_LOG_ERROR("Invalid thread count %u\n", pConfig->maxThreads);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == pConfig->reps || pConfig->reps > LAC_BENCH_MAX_REPS)
+    {
+        LAC_BENCH_LOG_ERROR("Invalid run count %u\n", pConfig->reps);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == pConfig->runMs)
+    {
+        LAC_BENCH_LOG_ERROR("Invalid run duration\n");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == pConfig->segments || pConfig->segments > LAC_BENCH_MAX_SEGMENTS)
+    {
+        LAC_BENCH_LOG_ERROR("Invalid buffer count %u\n", pConfig->segments);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (pConfig->size < pConfig->segments ||
+        pConfig->size > LAC_BENCH_MAX_SIZE)
+    {
+        LAC_BENCH_LOG_ERROR("Invalid size %u\n", pConfig->size);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    lac_bench_config_t config;
+    Cpa32U numResults = 0;
+    Cpa32U ran = 0;
+    Cpa32U failed = 0;
+    Cpa32S regressions = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaBoolean list = CPA_FALSE;
+    Cpa32U i = 0;
+    int opt = 0;
+
+    lacBenchSetDefaults(&config);
+    while (CPA_STATUS_SUCCESS == status &&
+           (opt = getopt(argc, argv, "T:r:d:s:g:f:lao:b:t:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'T':
+                config.maxThreads = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                config.reps = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                config.runMs = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                config.size = strtoul(optarg, NULL, 0);
+                break;
+            case 'g':
+                config.segments = strtoul(optarg, NULL, 0);
+                break;
+            case 'f':
+                config.pFilter = optarg;
+                break;
+            case 'l':
+                list = CPA_TRUE;
+                break;
+            case 'a':
+                config.pin = CPA_FALSE;
+                break;
+            case 'o':
+                config.pOutFile = optarg;
+                break;
+            case 'b':
+                config.pBaseFile = optarg;
+                break;
+            case 't':
+                config.tolerance = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                status = CPA_STATUS_INVALID_PARAM;
+                break;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status && optind != argc)
+    {
+        status = CPA_STATUS_INVALID_PARAM;
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = lacBenchCheckConfig(&config);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchPrintHelp(argv[0]);
+        return -1;
+    }
+    if (list)
+    {
+        lacBenchPrintList();
+        return 0;
+    }
+
+    lacBenchPrintHeader();
+    for (i = 0; i < lacBenchListSize; i++)
+    {
+        if (!lacBenchSelected(&config, lacBenchList[i].name))
+        {
+            continue;
+        }
+        ran++;
+        if (CPA_STATUS_SUCCESS != lacBenchSweep(&config,
+                                                &lacBenchList[i],
+                                                lacBenchResults,
+                                                &numResults))
+        {
+            failed++;
+        }
+    }
+    if (0 == ran)
+    {
+        LAC_BENCH_LOG_ERROR("No benchmark matches %s\n", config.pFilter);
+        return -1;
+    }
+    for (i = 0; i < numResults; i++)
+    {
+        if (lacBenchResults[i].errors)
+        {
+            failed++;
+        }
+    }
+
+    if (config.pOutFile &&
+        CPA_STATUS_SUCCESS !=
+            lacBenchSave(config.pOutFile, lacBenchResults, numResults))
+    {
+        failed++;
+    }
+    if (config.pBaseFile)
+    {
+        regressions = lacBenchCompare(
+            config.pBaseFile, config.tolerance, lacBenchResults, numResults);
+        if (regressions < 0)
+        {
+            failed++;
+        }
+        else
+        {
+            LAC_BENCH_LOG_USER("%d regressions\n", regressions);
+        }
+    }
+    if (failed)
+    {
+        LAC_BENCH_LOG_ERROR("%u failures\n", failed);
+    }
+
+    return (failed || regressions > 0) ? -1 : 0;
+}
@@ -0,0 +1,241 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "qae_mem_utils_common.h"
+#include "lac_bench_mem.h"
+
+#define LAC_BENCH_DMA_MIN_ALIGN 64
+#define LAC_BENCH_SLAB_SIZE (QAE_NUM_PAGES_PER_ALLOC * QAE_PAGE_SIZE)
+#define LAC_BENCH_SLAB_MAX_UNITS 16
+
+/*
+ * The executable provides the allocator half of the user space memory
+ * driver, so that the library and the translation code built from
+ * qae_mem_utils_common.c run unchanged on ordinary heap memory. Physical
+ * addresses are equal to the virtual ones and are stored in the page
+ * table the driver uses.
+ */
+
+page_table_t g_page_table = {{{0}}};
+
+/* Stored right before the memory handed out */
+typedef struct lac_bench_dma_hdr_s
+{
+    void *pBase;
+    size_t size;
+} lac_bench_dma_hdr_t;
+
+void *lacBenchDmaAlloc(size_t size, size_t align)
+{
+    void *pBase = NULL;
+    uint8_t *pMem = NULL;
+    lac_bench_dma_hdr_t *pHdr = NULL;
+    uintptr_t page = 0;
+
+    if (align < LAC_BENCH_DMA_MIN_ALIGN)
+    {
+        align = LAC_BENCH_DMA_MIN_ALIGN;
+    }
+    if (0 == size || (align & (align - 1)))
+    {
+        return NULL;
+    }
+    if (posix_memalign(&pBase, align, align + size))
+    {
+        return NULL;
+    }
+    pMem = (uint8_t *)pBase + align;
+    pHdr = (lac_bench_dma_hdr_t *)pMem - 1;
+    pHdr->pBase = pBase;
+    pHdr->size = size;
+    memset(pMem, 0, size);
+
+    for (page = (uintptr_t)pMem & QAE_PAGE_MASK;
+         page < (uintptr_t)pMem + size;
+         page += PAGE_SIZE)
+    {
+        store_addr(&g_page_table, page, page);
+    }
+    return pMem;
+}
+
+/* The pages stay in the page table: the one to one translation is right
+ * for any address, and a page may be shared with another allocation */
+void lacBenchDmaFree(void *pMem)
+{
+    lac_bench_dma_hdr_t *pHdr = NULL;
+
+    if (NULL == pMem)
+    {
+        return;
+    }
+    pHdr = (lac_bench_dma_hdr_t *)pMem - 1;
+    __qae_xlat_invalidate();
+    free(pHdr->pBase);
+}
+
+void *qaeMemAllocNUMA(size_t size, int node, size_t phys_alignment_byte)
+{
+    return lacBenchDmaAlloc(size, phys_alignment_byte);
+}
+
+void __qae_memFreeNUMA(void **ptr, bool secure_free)
+{
+    if (NULL == ptr || NULL == *ptr)
+    {
+        return;
+    }
+    if (secure_free)
+    {
+        qae_memzero_explicit(*ptr, ((lac_bench_dma_hdr_t *)*ptr - 1)->size);
+    }
+    lacBenchDmaFree(*ptr);
+    *ptr = NULL;
+}
+
+void *lacBenchSlabCreate(void)
+{
+    block_ctrl_t *pSlab = NULL;
+    const size_t reserved = div_round_up(sizeof(block_ctrl_t), UNIT_SIZE);
+
+    pSlab = lacBenchDmaAlloc(LAC_BENCH_SLAB_SIZE, QAE_PAGE_SIZE);
+    if (NULL == pSlab)
+    {
+        return NULL;
+    }
+    pSlab->mem_info.virt_addr = pSlab;
+    pSlab->mem_info.phy_addr = (uintptr_t)pSlab;
+    pSlab->mem_info.size = LAC_BENCH_SLAB_SIZE;
+    /* Same set up as init_slab_and_alloc() */
+    set_bitmap(pSlab->bitmap, 0, reserved);
+    pSlab->bitmap[LAC_BENCH_SLAB_SIZE / CHUNK_SIZE] = QWORD_ALL_ONE;
+    return pSlab;
+}
+
+void lacBenchSlabDestroy(void *pSlab)
+{
+    lacBenchDmaFree(pSlab);
+}
+
+/* The blocks are not cleared on free, to time the bitmap alone */
+uint64_t lacBenchSlabRun(void *pSlab,
+                         void **ppLive,
+                         uint32_t numLive,
+                         uint64_t iterations,
+                         uint32_t *pSeed)
+{
+    block_ctrl_t *pCtrl = pSlab;
+    uint64_t failed = 0;
+    uint64_t i = 0;
+    uint32_t slot = 0;
+    uint32_t x = *pSeed;
+
+    for (i = 0; i < iterations; i++)
+    {
+        size_t units = 0;
+
+        if (NULL != ppLive[slot])
+        {
+            __qae_mem_free(pCtrl, ppLive[slot], false);
+        }
+        x = x * 1103515245 + 12345;
+        units = 1 + ((x >> 16) % LAC_BENCH_SLAB_MAX_UNITS);
+        ppLive[slot] = __qae_mem_alloc(pCtrl, units * UNIT_SIZE, 0);
+        if (NULL == ppLive[slot])
+        {
+            failed++;
+        }
+        if (++slot == numLive)
+        {
+            slot = 0;
+        }
+    }
+    *pSeed = x;
+    return failed;
+}
+
+void lacBenchSlabDrain(void *pSlab, void **ppLive, uint32_t numLive)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < numLive; i++)
+    {
+        if (NULL != ppLive[i])
+        {
+            __qae_mem_free(pSlab, ppLive[i], false);
+            ppLive[i] = NULL;
+        }
+    }
+}
@@ -0,0 +1,1391 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_bench.h"
+
+#include "cpa_dc.h"
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_mem_pools.h"
+#include "lac_sal_types.h"
+#include "lac_buffer_desc.h"
+#include "sal_types_compression.h"
+#include "icp_sal_buffer_reg.h"
+#include "dc_session.h"
+#include "dc_datapath.h"
+#include "dc_crc32.h"
+#include "dc_crc64.h"
+#include "dc_header_cksum_lz4.h"
+#include "icp_sal_dc_zstd.h"
+#include "icp_sal_reactor.h"
+#include "adf_dev_ring_ctl.h"
+#include "uio_user_ring.h"
+#ifdef LAC_BENCH_ZSTD
+#include <zstd.h>
+#endif
+
+/* Entries of the emulated rings and requests put between two polls */
+#define LAC_BENCH_RING_MSGS 64
+#define LAC_BENCH_RING_BATCH 16
+#define LAC_BENCH_RING_MSG_WORDS (128 / sizeof(Cpa32U))
+/* Request header word, anything but the empty ring signature */
+#define LAC_BENCH_RING_MSG_HDR 0x80000000
+/* Poll period of the idle emulated instance, long enough for every wake
+ * up of the reactor benchmarks to come from icp_sal_ReactorNotify */
+#define LAC_BENCH_REACTOR_IDLE_POLL_US 100000
+/* Entries a thread holds at once in the memory pool benchmark */
+#define LAC_BENCH_POOL_BATCH 16
+#define LAC_BENCH_POOL_BLK_SIZE 512
+#define LAC_BENCH_POOL_BLK_ALIGN 64
+/* Blocks a thread keeps allocated in the slab benchmark */
+#define LAC_BENCH_SLAB_LIVE 32
+/* CRC-64/XZ, reflected, to go through the whole programmable path */
+#define LAC_BENCH_CRC64_POLY 0x42F0E1EBA9EA3693ULL
+/* LZ4 frame descriptor: flags and block size, then an optional content
+ * size and dictionary id, 2 to 14 bytes */
+#define LAC_BENCH_LZ4_DESC_MIN 2
+#define LAC_BENCH_LZ4_DESC_STEP 4
+#define LAC_BENCH_LZ4_DESC_MAX 16
+/* Greedy LZ4s standing in for the one of the device: 4 byte min match
+ * found through a hash of the next 4 bytes, within the 64K window */
+#define LAC_BENCH_LZ4S_MIN_MATCH 4
+#define LAC_BENCH_LZ4S_HASH_LOG 14
+#define LAC_BENCH_LZ4S_HASH_PRIME 2654435761U
+#define LAC_BENCH_LZ4S_MAX_OFFSET 65535
+#define LAC_BENCH_LZ4S_NIBBLE_MAX 15
+#define LAC_BENCH_LZ4S_LEN_CONTINUE 255
+#define LAC_BENCH_LZ4S_LIT_SHIFT 4
+/* Worst case size of the LZ4s of size bytes, all literals */
+#define LAC_BENCH_LZ4S_BOUND(size)                                             \
+    ((size) + (size) / LAC_BENCH_LZ4S_LEN_CONTINUE + 16)
+/* Words per line of the text the zstd benchmarks compress */
+#define LAC_BENCH_TEXT_LINE_WORDS 12
+/* Fastest zstd level tried when looking for the ratio of the conversion */
+#define LAC_BENCH_ZSTD_FAST_LEVEL -10
+
+/* Set up once for the benchmarks of the compression service */
+typedef struct lac_bench_dc_shared_s
+{
+    sal_compression_service_t *pService;
+    Cpa64U *pCrcTable;
+    CpaCrcControlData crcControl;
+    int zstdLevel;
+    /**< Level of software zstd giving the ratio of the conversion */
+} lac_bench_dc_shared_t;
+
+/* Data of a thread: a source and a destination split into segments */
+typedef struct lac_bench_dc_priv_s
+{
+    Cpa8U *pSrcData;
+    Cpa8U *pDstData;
+    CpaBufferList *pSrc;
+    CpaBufferList *pDst;
+    dc_session_desc_t *pSessionDesc;
+    dc_compression_cookie_t *pCookie;
+    CpaDcOpData opData;
+    CpaDcRqResults results;
+    Cpa64U checksum;
+    CpaFlatBuffer lz4s;
+    /**< LZ4s of the source, for the zstd benchmarks */
+    CpaFlatBuffer zstd;
+    Cpa32U zstdSize;
+    /**< Size of the frame the LZ4s converts to */
+#ifdef LAC_BENCH_ZSTD
+    CpaFlatBuffer swZstd;
+    ZSTD_CCtx *pZstdCtx;
+#endif
+} lac_bench_dc_priv_t;
+
+typedef struct lac_bench_ring_priv_s
+{
+    Cpa32U msg[LAC_BENCH_RING_MSG_WORDS] __attribute__((aligned(64)));
+    Cpa32U *pMsgs[LAC_BENCH_RING_BATCH];
+    lac_bench_rings_t *pRings;
+    Cpa64U responses;
+} lac_bench_ring_priv_t;
+
+/* A reactor of one thread polling an emulated instance of its own */
+typedef struct lac_bench_reactor_priv_s
+{
+    Cpa32U msg[LAC_BENCH_RING_MSG_WORDS] __attribute__((aligned(64)));
+    lac_bench_rings_t *pRings;
+    sal_compression_service_t *pService;
+    icp_sal_reactor_handle_t reactor;
+    icp_sal_reactor_entry_t entry;
+    icp_sal_reactor_stats_t start;
+    /**< Statistics when the thread was set up */
+    volatile Cpa64U responses;
+    /**< Counted by the callback, on the reactor thread */
+} lac_bench_reactor_priv_t;
+
+typedef struct lac_bench_pool_shared_s
+{
+    lac_memory_pool_id_t poolId;
+} lac_bench_pool_shared_t;
+
+typedef struct lac_bench_slab_priv_s
+{
+    void *pSlab;
+    void *pLive[LAC_BENCH_SLAB_LIVE];
+    Cpa32U seed;
+} lac_bench_slab_priv_t;
+
+static char lacBenchPoolName[] = "lac_bench";
+
+/*
+ * Rings
+ */
+
+/* The response is the start of the request, which carries the thread
+ * data after its header */
+static void lacBenchRingResp(void *pMsg)
+{
+    lac_bench_ring_priv_t *pPriv = NULL;
+
+    memcpy(&pPriv, (Cpa32U *)pMsg + 2, sizeof(pPriv));
+    pPriv->responses++;
+}
+
+static CpaStatus lacBenchRingSetup(lac_bench_thread_t *pThread)
+{
+    lac_bench_ring_priv_t *pPriv = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    if (posix_memalign((void **)&pPriv, 64, sizeof(*pPriv)))
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    memset(pPriv, 0, sizeof(*pPriv));
+    status = lacBenchRingsCreate(
+        LAC_BENCH_RING_MSGS, lacBenchRingResp, &pPriv->pRings);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        free(pPriv);
+        return status;
+    }
+    pPriv->msg[0] = LAC_BENCH_RING_MSG_HDR;
+    memcpy(&pPriv->msg[2], &pPriv, sizeof(pPriv));
+    for (i = 0; i < LAC_BENCH_RING_BATCH; i++)
+    {
+        pPriv->pMsgs[i] = pPriv->msg;
+    }
+    pThread->pPriv = pPriv;
+    return CPA_STATUS_SUCCESS;
+}
+
+static void lacBenchRingTeardown(lac_bench_thread_t *pThread)
+{
+    lac_bench_ring_priv_t *pPriv = pThread->pPriv;
+
+    lacBenchRingsDestroy(pPriv->pRings);
+    free(pPriv);
+}
+
+/* Common part of the ring benchmarks: puts batches of requests one at a
+ * time or all at once, lets the device answer and polls */
+static void lacBenchRingLoop(lac_bench_thread_t *pThread,
+                             Cpa64U iterations,
+                             CpaBoolean putAll)
+{
+    lac_bench_ring_priv_t *pPriv = pThread->pPriv;
+    adf_dev_ring_handle_t *pTx = lacBenchRingsTx(pPriv->pRings);
+    adf_dev_ring_handle_t *pRx = lacBenchRingsRx(pPriv->pRings);
+    Cpa64U expected = pPriv->responses;
+    Cpa64U done = 0;
+
+    while (done < iterations)
+    {
+        Cpa32U batch = LAC_BENCH_RING_BATCH;
+        Cpa32U numPut = 0;
+        Cpa32U i = 0;
+
+        if (iterations - done < batch)
+        {
+            batch = iterations - done;
+        }
+        if (putAll)
+        {
+            if (CPA_STATUS_SUCCESS !=
+                adf_user_put_msgs(pTx, pPriv->pMsgs, batch, NULL, &numPut))
+            {
+                numPut = 0;
+            }
+            pThread->errors += batch - numPut;
+        }
+        else
+        {
+            for (i = 0; i < batch; i++)
+            {
+                if (CPA_STATUS_SUCCESS !=
+                    adf_user_put_msg(pTx, pPriv->msg, NULL))
+                {
+                    pThread->errors++;
+                }
+            }
+        }
+        lacBenchRingsProcess(pPriv->pRings);
+        adf_user_notify_msgs_poll(pRx);
+        done += batch;
+    }
+    expected += iterations;
+    if (pPriv->responses != expected)
+    {
+        pThread->errors += expected - pPriv->responses;
+        pPriv->responses = expected;
+    }
+}
+
+static void lacBenchRingRun(lac_bench_thread_t *pThread, Cpa64U iterations)
+{
+    lacBenchRingLoop(pThread, iterations, CPA_FALSE);
+}
+
+static void lacBenchRingBatchRun(lac_bench_thread_t *pThread,
+                                 Cpa64U iterations)
+{
+    lacBenchRingLoop(pThread, iterations, CPA_TRUE);
+}
+
+/*
+ * Reactor: every request is a round trip through a reactor thread that
+ * polls the emulated instance, so the time of an operation includes the
+ * wake up of the reactor. Its wake latency and CPU use are printed when
+ * the thread tears down.
+ */
+
+static void lacBenchReactorResp(void *pMsg)
+{
+    lac_bench_reactor_priv_t *pPriv = NULL;
+
+    memcpy(&pPriv, (Cpa32U *)pMsg + 2, sizeof(pPriv));
+    __atomic_add_fetch(&pPriv->responses, 1, __ATOMIC_RELEASE);
+}
+
+static void lacBenchReactorTeardown(lac_bench_thread_t *pThread)
+{
+    lac_bench_reactor_priv_t *pPriv = pThread->pPriv;
+    icp_sal_reactor_stats_t end;
+    Cpa64U wakeups = 0;
+    Cpa64U compls = 0;
+    Cpa64U wallNs = 0;
+
+    if (NULL == pPriv)
+    {
+        return;
+    }
+    /* Not for the calibration, only for the threads of a sweep */
+    if (NULL != pPriv->entry && NULL != pThread->pRun &&
+        CPA_STATUS_SUCCESS ==
+            icp_sal_ReactorQueryStats(pPriv->reactor, &end))
+    {
+        wakeups = end.wakeLatencyCount - pPriv->start.wakeLatencyCount;
+        compls = end.complLatencyCount - pPriv->start.complLatencyCount;
+        wallNs = end.wallNs - pPriv->start.wallNs;
+        LAC_BENCH_LOG_USER(
+            "%s thread %u: %llu wake ups of %.0f ns, completions after "
+            "%.0f ns, reactor CPU %.1f%%\n",
+            pThread->pBench->name,
+            pThread->idx,
+            (unsigned long long)wakeups,
+            wakeups ? (double)(end.wakeLatencyTotalNs -
+                               pPriv->start.wakeLatencyTotalNs) /
+                          wakeups
+                    : 0.0,
+            compls ? (double)(end.complLatencyTotalNs -
+                              pPriv->start.complLatencyTotalNs) /
+                         compls
+                   : 0.0,
+            wallNs ? 100.0 * (end.cpuNs - pPriv->start.cpuNs) / wallNs
+                   : 0.0);
+    }
+    if (NULL != pPriv->entry)
+    {
+        icp_sal_ReactorUnregister(pPriv->reactor, pPriv->entry);
+    }
+    if (NULL != pPriv->reactor)
+    {
+        icp_sal_ReactorDestroy(pPriv->reactor);
+    }
+    if (NULL != pPriv->pService)
+    {
+        lacBenchDcServiceDestroy(pPriv->pService);
+    }
+    lacBenchRingsDestroy(pPriv->pRings);
+    free(pPriv);
+    pThread->pPriv = NULL;
+}
+
+static CpaStatus lacBenchReactorSetup(lac_bench_thread_t *pThread,
+                                      Cpa32U busyPollUs)
+{
+    icp_sal_reactor_config_t config = {
+        1, busyPollUs, LAC_BENCH_REACTOR_IDLE_POLL_US, 0, -1};
+    lac_bench_reactor_priv_t *pPriv = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (posix_memalign((void **)&pPriv, 64, sizeof(*pPriv)))
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    memset(pPriv, 0, sizeof(*pPriv));
+    pThread->pPriv = pPriv;
+    pPriv->msg[0] = LAC_BENCH_RING_MSG_HDR;
+    memcpy(&pPriv->msg[2], &pPriv, sizeof(pPriv));
+    status = lacBenchRingsCreate(
+        LAC_BENCH_RING_MSGS, lacBenchReactorResp, &pPriv->pRings);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pPriv->pService = lacBenchDcServiceCreate();
+        if (NULL == pPriv->pService)
+        {
+            status = CPA_STATUS_RESOURCE;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        /* No file descriptor: the reactor polls it as a poll mode
+         * instance */
+        pPriv->pService->trans_handle_compression_rx =
+            lacBenchRingsRx(pPriv->pRings);
+        status = icp_sal_ReactorCreate(&config, &pPriv->reactor);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_ReactorRegister(
+            pPriv->reactor, pPriv->pService, &pPriv->entry);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_ReactorQueryStats(pPriv->reactor, &pPriv->start);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchReactorTeardown(pThread);
+    }
+    return status;
+}
+
+static CpaStatus lacBenchReactorWakeSetup(lac_bench_thread_t *pThread)
+{
+    return lacBenchReactorSetup(pThread, 0);
+}
+
+static CpaStatus lacBenchReactorBusySetup(lac_bench_thread_t *pThread)
+{
+    return lacBenchReactorSetup(pThread,
+                                ICP_SAL_REACTOR_DEFAULT_BUSY_POLL_US);
+}
+
+/* Puts a request, lets the device answer, notifies the reactor and waits
+ * for its callback */
+static void lacBenchReactorRun(lac_bench_thread_t *pThread,
+                               Cpa64U iterations)
+{
+    lac_bench_reactor_priv_t *pPriv = pThread->pPriv;
+    adf_dev_ring_handle_t *pTx = lacBenchRingsTx(pPriv->pRings);
+    Cpa64U expected = pPriv->responses;
+    Cpa64U done = 0;
+
+    for (done = 0; done < iterations; done++)
+    {
+        if (CPA_STATUS_SUCCESS != adf_user_put_msg(pTx, pPriv->msg, NULL))
+        {
+            pThread->errors++;
+            continue;
+        }
+        lacBenchRingsProcess(pPriv->pRings);
+        icp_sal_ReactorNotify(pPriv->entry);
+        expected++;
+        while (__atomic_load_n(&pPriv->responses, __ATOMIC_ACQUIRE) !=
+               expected)
+        {
+            sched_yield();
+        }
+    }
+}
+
+/*
+ * Memory pool, shared by all the threads like the cookie pools of an
+ * instance
+ */
+
+static CpaStatus lacBenchPoolInit(const lac_bench_config_t *pConfig,
+                                  void **ppShared)
+{
+    lac_bench_pool_shared_t *pShared = NULL;
+    Cpa32U entries = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pShared = calloc(1, sizeof(*pShared));
+    if (NULL == pShared)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    /* Room for the entries held and cached in a magazine by every thread */
+    entries = pConfig->maxThreads *
+                  (LAC_BENCH_POOL_BATCH + LAC_MEM_POOL_MAGAZINE_SIZE) +
+              LAC_MEM_POOL_MAGAZINE_MIN_POOL;
+    status = Lac_MemPoolCreate(&pShared->poolId,
+                               lacBenchPoolName,
+                               entries,
+                               LAC_BENCH_POOL_BLK_SIZE,
+                               LAC_BENCH_POOL_BLK_ALIGN,
+                               CPA_FALSE,
+                               0);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        free(pShared);
+        return status;
+    }
+    *ppShared = pShared;
+    return CPA_STATUS_SUCCESS;
+}
+
+static void lacBenchPoolFini(void *pShared)
+{
+    lac_bench_pool_shared_t *pPool = pShared;
+
+    Lac_MemPoolDestroy(pPool->poolId);
+    free(pPool);
+}
+
+static CpaStatus lacBenchNoSetup(lac_bench_thread_t *pThread)
+{
+    return CPA_STATUS_SUCCESS;
+}
+
+static void lacBenchNoTeardown(lac_bench_thread_t *pThread)
+{
+}
+
+static void lacBenchPoolRun(lac_bench_thread_t *pThread, Cpa64U iterations)
+{
+    lac_bench_pool_shared_t *pPool = pThread->pShared;
+    void *pEntries[LAC_BENCH_POOL_BATCH];
+    Cpa64U done = 0;
+
+    while (done < iterations)
+    {
+        Cpa32U batch = LAC_BENCH_POOL_BATCH;
+        Cpa32U i = 0;
+
+        if (iterations - done < batch)
+        {
+            batch = iterations - done;
+        }
+        for (i = 0; i < batch; i++)
+        {
+            pEntries[i] = Lac_MemPoolEntryAlloc(pPool->poolId);
+            if (NULL == pEntries[i] || (void *)CPA_STATUS_RETRY == pEntries[i])
+            {
+                pEntries[i] = NULL;
+                pThread->errors++;
+            }
+        }
+        for (i = 0; i < batch; i++)
+        {
+            if (NULL != pEntries[i])
+            {
+                Lac_MemPoolEntryFree(pEntries[i]);
+            }
+        }
+        done += batch;
+    }
+}
+
+/*
+ * Slab allocator of the memory driver, one slab per thread like the
+ * thread specific mode of the driver
+ */
+
+static CpaStatus lacBenchSlabSetup(lac_bench_thread_t *pThread)
+{
+    lac_bench_slab_priv_t *pPriv = NULL;
+
+    pPriv = calloc(1, sizeof(*pPriv));
+    if (NULL == pPriv)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    pPriv->pSlab = lacBenchSlabCreate();
+    if (NULL == pPriv->pSlab)
+    {
+        free(pPriv);
+        return CPA_STATUS_RESOURCE;
+    }
+    pPriv->seed = pThread->idx + 1;
+    pThread->pPriv = pPriv;
+    return CPA_STATUS_SUCCESS;
+}
+
+static void lacBenchSlabTeardown(lac_bench_thread_t *pThread)
+{
+    lac_bench_slab_priv_t *pPriv = pThread->pPriv;
+
+    lacBenchSlabDrain(pPriv->pSlab, pPriv->pLive, LAC_BENCH_SLAB_LIVE);
+    lacBenchSlabDestroy(pPriv->pSlab);
+    free(pPriv);
+}
+
+static void lacBenchSlabBenchRun(lac_bench_thread_t *pThread,
+                                 Cpa64U iterations)
+{
+    lac_bench_slab_priv_t *pPriv = pThread->pPriv;
+
+    pThread->errors += lacBenchSlabRun(pPriv->pSlab,
+                                       pPriv->pLive,
+                                       LAC_BENCH_SLAB_LIVE,
+                                       iterations,
+                                       &pPriv->seed);
+}
+
+/*
+ * Compression service: buffer descriptors, requests and checksums
+ */
+
+static CpaStatus lacBenchDcInit(const lac_bench_config_t *pConfig,
+                                void **ppShared)
+{
+    lac_bench_dc_shared_t *pShared = NULL;
+
+    pShared = calloc(1, sizeof(*pShared));
+    if (NULL == pShared)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    pShared->pService = lacBenchDcServiceCreate();
+    if (NULL == pShared->pService ||
+        CPA_STATUS_SUCCESS !=
+            dcGenerateLookupTable(LAC_BENCH_CRC64_POLY, &pShared->pCrcTable))
+    {
+        lacBenchDcServiceDestroy(pShared->pService);
+        free(pShared);
+        return CPA_STATUS_RESOURCE;
+    }
+    pShared->crcControl.polynomial = LAC_BENCH_CRC64_POLY;
+    pShared->crcControl.initialValue = ~0ULL;
+    pShared->crcControl.reflectIn = CPA_TRUE;
+    pShared->crcControl.reflectOut = CPA_TRUE;
+    pShared->crcControl.xorOut = ~0ULL;
+    *ppShared = pShared;
+    return CPA_STATUS_SUCCESS;
+}
+
+static void lacBenchDcFini(void *pShared)
+{
+    lac_bench_dc_shared_t *pDc = pShared;
+
+    LAC_OS_FREE(pDc->pCrcTable);
+    lacBenchDcServiceDestroy(pDc->pService);
+    free(pDc);
+}
+
+static void lacBenchDcTeardown(lac_bench_thread_t *pThread)
+{
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+
+    lacBenchBufferListDestroy(pPriv->pSrc);
+    lacBenchBufferListDestroy(pPriv->pDst);
+    lacBenchDmaFree(pPriv->pSrcData);
+    lacBenchDmaFree(pPriv->pDstData);
+    lacBenchDmaFree(pPriv->pSessionDesc);
+    lacBenchDmaFree(pPriv->pCookie);
+    free(pPriv->lz4s.pData);
+    free(pPriv->zstd.pData);
+#ifdef LAC_BENCH_ZSTD
+    free(pPriv->swZstd.pData);
+    ZSTD_freeCCtx(pPriv->pZstdCtx);
+#endif
+    free(pPriv);
+}
+
+static CpaStatus lacBenchDcSetup(lac_bench_thread_t *pThread)
+{
+    const lac_bench_config_t *pConfig = pThread->pConfig;
+    lac_bench_dc_shared_t *pShared = pThread->pShared;
+    lac_bench_dc_priv_t *pPriv = NULL;
+    dc_session_desc_t *pSessionDesc = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U x = pThread->idx + 1;
+    Cpa32U i = 0;
+
+    pPriv = calloc(1, sizeof(*pPriv));
+    if (NULL == pPriv)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    pThread->pPriv = pPriv;
+    pPriv->pSrcData = lacBenchDmaAlloc(pConfig->size, 0);
+    pPriv->pDstData = lacBenchDmaAlloc(pConfig->size, 0);
+    pPriv->pSessionDesc = lacBenchDmaAlloc(sizeof(dc_session_desc_t), 0);
+    pPriv->pCookie = lacBenchDmaAlloc(sizeof(dc_compression_cookie_t), 0);
+    if (NULL == pPriv->pSrcData || NULL == pPriv->pDstData ||
+        NULL == pPriv->pSessionDesc || NULL == pPriv->pCookie)
+    {
+        lacBenchDcTeardown(pThread);
+        return CPA_STATUS_RESOURCE;
+    }
+    for (i = 0; i < pConfig->size; i++)
+    {
+        x = x * 1103515245 + 12345;
+        pPriv->pSrcData[i] = x >> 16;
+    }
+
+    status = lacBenchBufferListCreate(pShared->pService,
+                                      pPriv->pSrcData,
+                                      pConfig->size,
+                                      pConfig->segments,
+                                      &pPriv->pSrc);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = lacBenchBufferListCreate(pShared->pService,
+                                          pPriv->pDstData,
+                                          pConfig->size,
+                                          pConfig->segments,
+                                          &pPriv->pDst);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchDcTeardown(pThread);
+        return status;
+    }
+
+    /* Stateless deflate compression with a CRC32, as set up by
+     * cpaDcInitSession() */
+    pSessionDesc = pPriv->pSessionDesc;
+    pSessionDesc->compType = CPA_DC_DEFLATE;
+    pSessionDesc->huffType = CPA_DC_HT_STATIC;
+    pSessionDesc->sessDirection = CPA_DC_DIR_COMPRESS;
+    pSessionDesc->sessState = CPA_DC_STATELESS;
+    pSessionDesc->checksumType = CPA_DC_CRC32;
+    pSessionDesc->requestType = DC_REQUEST_FIRST;
+    pPriv->opData.flushFlag = CPA_DC_FLUSH_FINAL;
+    pPriv->opData.compressAndVerify = CPA_TRUE;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus lacBenchBufDescRegSetup(lac_bench_thread_t *pThread)
+{
+    lac_bench_dc_shared_t *pShared = pThread->pShared;
+    lac_bench_dc_priv_t *pPriv = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = lacBenchDcSetup(pThread);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    pPriv = pThread->pPriv;
+    status = icp_sal_BufferListRegister(pShared->pService, pPriv->pSrc);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchDcTeardown(pThread);
+    }
+    return status;
+}
+
+static void lacBenchBufDescRun(lac_bench_thread_t *pThread,
+                               Cpa64U iterations)
+{
+    lac_bench_dc_shared_t *pShared = pThread->pShared;
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa64U phys = 0;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            LacBuffDesc_BufferListDescWrite(
+                pPriv->pSrc,
+                &phys,
+                CPA_FALSE,
+                &pShared->pService->generic_service_info))
+        {
+            pThread->errors++;
+        }
+    }
+}
+
+static void lacBenchDcRequestRun(lac_bench_thread_t *pThread,
+                                 Cpa64U iterations)
+{
+    lac_bench_dc_shared_t *pShared = pThread->pShared;
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        if (CPA_STATUS_SUCCESS != dcCreateRequest(pPriv->pCookie,
+                                                  pShared->pService,
+                                                  pPriv->pSessionDesc,
+                                                  pPriv->pSessionDesc,
+                                                  pPriv->pSrc,
+                                                  pPriv->pDst,
+                                                  &pPriv->results,
+                                                  CPA_DC_FLUSH_FINAL,
+                                                  &pPriv->opData,
+                                                  pPriv,
+                                                  DC_COMPRESSION_REQUEST,
+                                                  DC_CNV))
+        {
+            pThread->errors++;
+        }
+    }
+}
+
+/* The checksum of every pass seeds the next one */
+static void lacBenchCrc32Run(lac_bench_thread_t *pThread, Cpa64U iterations)
+{
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa32U crc = (Cpa32U)pPriv->checksum;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        crc = dcCalculateCrc32(pPriv->pSrc, pThread->pConfig->size, crc);
+    }
+    pPriv->checksum = crc;
+}
+
+static void lacBenchCrc64Run(lac_bench_thread_t *pThread, Cpa64U iterations)
+{
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa64U crc = pPriv->checksum;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        crc = dcCalculateCrc64(pPriv->pSrc, pThread->pConfig->size, crc);
+    }
+    pPriv->checksum = crc;
+}
+
+static void lacBenchProgCrc64Run(lac_bench_thread_t *pThread,
+                                 Cpa64U iterations)
+{
+    lac_bench_dc_shared_t *pShared = pThread->pShared;
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            dcCalculateProgCrc64(&pShared->crcControl,
+                                 pShared->pCrcTable,
+                                 pPriv->pSrc,
+                                 pThread->pConfig->size,
+                                 &pPriv->checksum))
+        {
+            pThread->errors++;
+        }
+    }
+}
+
+/* Header checksum of LZ4 frame descriptors of every possible size */
+static void lacBenchHdrCksumRun(lac_bench_thread_t *pThread,
+                                Cpa64U iterations)
+{
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa32U len = LAC_BENCH_LZ4_DESC_MIN;
+    Cpa8U cksum = 0;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        if (CPA_STATUS_SUCCESS != dc_hdr_cksum(pPriv->pSrcData, len, &cksum))
+        {
+            pThread->errors++;
+        }
+        len += LAC_BENCH_LZ4_DESC_STEP;
+        if (len > LAC_BENCH_LZ4_DESC_MAX)
+        {
+            len = LAC_BENCH_LZ4_DESC_MIN;
+        }
+    }
+    pPriv->checksum = cksum;
+}
+
+/* The hash of every pass seeds the next one */
+static void lacBenchXxh32Run(lac_bench_thread_t *pThread, Cpa64U iterations)
+{
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa32U hash = (Cpa32U)pPriv->checksum;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            dc_xxh32(pPriv->pSrcData, pThread->pConfig->size, hash, &hash))
+        {
+            pThread->errors++;
+        }
+    }
+    pPriv->checksum = hash;
+}
+
+/*
+ * LZ4s to zstd conversion, against software zstd
+ */
+
+static const char *const lacBenchWords[] = {
+    "the ",     "request ",  "ring ",     "of ",      "a ",
+    "buffer ",  "is ",       "to ",       "instance ", "response ",
+    "in ",      "session ",  "and ",      "device ",  "status ",
+    "for ",     "data ",     "with ",     "list ",    "compression ",
+    "polled ",  "offset ",   "not ",      "length ",  "firmware ",
+    "on ",      "memory ",   "returned ", "flat ",    "service ",
+    "queue ",   "error "};
+
+/* Lines of words from a small vocabulary, about as compressible as logs.
+ * Every thread compresses the same text. */
+static void lacBenchTextFill(Cpa8U *pData, Cpa32U size)
+{
+    const Cpa32U numWords = sizeof(lacBenchWords) / sizeof(lacBenchWords[0]);
+    Cpa32U x = 1;
+    Cpa32U words = 0;
+    Cpa32U pos = 0;
+
+    while (pos < size)
+    {
+        const char *pWord = NULL;
+        Cpa32U len = 0;
+
+        x = x * 1103515245 + 12345;
+        pWord = lacBenchWords[(x >> 16) % numWords];
+        if (++words == LAC_BENCH_TEXT_LINE_WORDS)
+        {
+            pWord = "\n";
+            words = 0;
+        }
+        len = strlen(pWord);
+        if (len > size - pos)
+        {
+            len = size - pos;
+        }
+        memcpy(pData + pos, pWord, len);
+        pos += len;
+    }
+}
+
+static Cpa8U *lacBenchLz4sWriteLength(Cpa8U *pOut, Cpa32U length)
+{
+    while (length >= LAC_BENCH_LZ4S_LEN_CONTINUE)
+    {
+        *pOut++ = LAC_BENCH_LZ4S_LEN_CONTINUE;
+        length -= LAC_BENCH_LZ4S_LEN_CONTINUE;
+    }
+    *pOut++ = (Cpa8U)length;
+    return pOut;
+}
+
+/* One sequence. The match length field is the length less min match - 1,
+ * the last sequence has literals only. */
+static Cpa8U *lacBenchLz4sWriteSeq(Cpa8U *pOut,
+                                   const Cpa8U *pLiterals,
+                                   Cpa32U numLiterals,
+                                   Cpa32U offset,
+                                   Cpa32U matchLength)
+{
+    Cpa32U mlField = 0;
+    Cpa8U *pToken = pOut++;
+
+    *pToken = (numLiterals < LAC_BENCH_LZ4S_NIBBLE_MAX
+                   ? numLiterals
+                   : LAC_BENCH_LZ4S_NIBBLE_MAX)
+              << LAC_BENCH_LZ4S_LIT_SHIFT;
+    if (numLiterals >= LAC_BENCH_LZ4S_NIBBLE_MAX)
+    {
+        pOut = lacBenchLz4sWriteLength(pOut,
+                                       numLiterals - LAC_BENCH_LZ4S_NIBBLE_MAX);
+    }
+    memcpy(pOut, pLiterals, numLiterals);
+    pOut += numLiterals;
+    if (0 == matchLength)
+    {
+        return pOut;
+    }
+
+    mlField = matchLength - LAC_BENCH_LZ4S_MIN_MATCH + 1;
+    *pToken |= (mlField < LAC_BENCH_LZ4S_NIBBLE_MAX) ? mlField
+                                                      : LAC_BENCH_LZ4S_NIBBLE_MAX;
+    *pOut++ = offset & 0xFF;
+    *pOut++ = offset >> 8;
+    if (mlField >= LAC_BENCH_LZ4S_NIBBLE_MAX)
+    {
+        pOut = lacBenchLz4sWriteLength(pOut,
+                                       mlField - LAC_BENCH_LZ4S_NIBBLE_MAX);
+    }
+    return pOut;
+}
+
+/* Greedy match finding over pSrc, returns the size of the LZ4s */
+static Cpa32U lacBenchLz4sEncode(const Cpa8U *pSrc,
+                                 Cpa32U srcLen,
+                                 Cpa32U *pTable,
+                                 Cpa8U *pDst)
+{
+    Cpa8U *pOut = pDst;
+    Cpa32U anchor = 0;
+    Cpa32U pos = 0;
+
+    while (srcLen >= LAC_BENCH_LZ4S_MIN_MATCH &&
+           pos <= srcLen - LAC_BENCH_LZ4S_MIN_MATCH)
+    {
+        Cpa32U seq = 0;
+        Cpa32U hash = 0;
+        Cpa32U ref = 0;
+        Cpa32U len = 0;
+
+        memcpy(&seq, pSrc + pos, sizeof(seq));
+        hash = (seq * LAC_BENCH_LZ4S_HASH_PRIME) >>
+               (32 - LAC_BENCH_LZ4S_HASH_LOG);
+        /* Entries are positions plus one, 0 being empty */
+        ref = pTable[hash];
+        pTable[hash] = pos + 1;
+        if (0 == ref || pos - (ref - 1) > LAC_BENCH_LZ4S_MAX_OFFSET ||
+            0 != memcmp(pSrc + ref - 1, pSrc + pos, LAC_BENCH_LZ4S_MIN_MATCH))
+        {
+            pos++;
+            continue;
+        }
+        ref--;
+        len = LAC_BENCH_LZ4S_MIN_MATCH;
+        while (pos + len < srcLen && pSrc[ref + len] == pSrc[pos + len])
+        {
+            len++;
+        }
+        pOut = lacBenchLz4sWriteSeq(
+            pOut, pSrc + anchor, pos - anchor, pos - ref, len);
+        pos += len;
+        anchor = pos;
+    }
+    pOut = lacBenchLz4sWriteSeq(pOut, pSrc + anchor, srcLen - anchor, 0, 0);
+
+    return (Cpa32U)(pOut - pDst);
+}
+
+#ifdef LAC_BENCH_ZSTD
+/* Round trip: libzstd must restore the source from the converted frame */
+static CpaStatus lacBenchZstdCheck(lac_bench_dc_priv_t *pPriv, Cpa32U size)
+{
+    size_t ret = 0;
+
+    ret = ZSTD_decompress(
+        pPriv->pDstData, size, pPriv->zstd.pData, pPriv->zstdSize);
+    if (ZSTD_isError(ret) || ret != size ||
+        0 != memcmp(pPriv->pDstData, pPriv->pSrcData, size))
+    {
+        LAC_BENCH_LOG_ERROR("lz4s_zstd: the frame does not decode to the "
+                            "source, %s\n",
+                            ZSTD_isError(ret) ? ZSTD_getErrorName(ret)
+                                              : "data differs");
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+#endif
+
+/* Text, its LZ4s, and the zstd frame converted from it once, which is
+ * checked with libzstd when built in */
+static CpaStatus lacBenchLz4sZstdSetup(lac_bench_thread_t *pThread)
+{
+    const lac_bench_config_t *pConfig = pThread->pConfig;
+    lac_bench_dc_priv_t *pPriv = NULL;
+    Cpa32U *pTable = NULL;
+    Cpa32U bound = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = lacBenchDcSetup(pThread);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    pPriv = pThread->pPriv;
+    lacBenchTextFill(pPriv->pSrcData, pConfig->size);
+
+    status = icp_sal_DcZstdCompressBound(pConfig->size, &bound);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchDcTeardown(pThread);
+        return status;
+    }
+    pTable = calloc(1 << LAC_BENCH_LZ4S_HASH_LOG, sizeof(*pTable));
+    pPriv->lz4s.pData = malloc(LAC_BENCH_LZ4S_BOUND(pConfig->size));
+    pPriv->zstd.pData = malloc(bound);
+    pPriv->zstd.dataLenInBytes = bound;
+    if (NULL == pTable || NULL == pPriv->lz4s.pData ||
+        NULL == pPriv->zstd.pData)
+    {
+        free(pTable);
+        lacBenchDcTeardown(pThread);
+        return CPA_STATUS_RESOURCE;
+    }
+    pPriv->lz4s.dataLenInBytes = lacBenchLz4sEncode(
+        pPriv->pSrcData, pConfig->size, pTable, pPriv->lz4s.pData);
+    free(pTable);
+
+    status = icp_sal_DcLZ4SToZstd(&pPriv->lz4s,
+                                  CPA_DC_MIN_4_BYTE_MATCH,
+                                  pPriv->pSrc,
+                                  pConfig->size,
+                                  &pPriv->zstd,
+                                  &pPriv->zstdSize);
+#ifdef LAC_BENCH_ZSTD
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = lacBenchZstdCheck(pPriv, pConfig->size);
+    }
+#endif
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchDcTeardown(pThread);
+    }
+    return status;
+}
+
+static void lacBenchLz4sZstdRun(lac_bench_thread_t *pThread,
+                                Cpa64U iterations)
+{
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa32U produced = 0;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        if (CPA_STATUS_SUCCESS != icp_sal_DcLZ4SToZstd(&pPriv->lz4s,
+                                                       CPA_DC_MIN_4_BYTE_MATCH,
+                                                       pPriv->pSrc,
+                                                       pThread->pConfig->size,
+                                                       &pPriv->zstd,
+                                                       &produced) ||
+            produced != pPriv->zstdSize)
+        {
+            pThread->errors++;
+        }
+    }
+}
+
+#ifdef LAC_BENCH_ZSTD
+static CpaStatus lacBenchSwZstdCtxSetup(lac_bench_dc_priv_t *pPriv,
+                                        Cpa32U size)
+{
+    pPriv->swZstd.dataLenInBytes = ZSTD_compressBound(size);
+    pPriv->swZstd.pData = malloc(pPriv->swZstd.dataLenInBytes);
+    pPriv->pZstdCtx = ZSTD_createCCtx();
+    if (NULL == pPriv->swZstd.pData || NULL == pPriv->pZstdCtx)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Looks for the fastest level of software zstd that compresses the text
+ * at least as well as the conversion does */
+static CpaStatus lacBenchSwZstdInit(const lac_bench_config_t *pConfig,
+                                    void **ppShared)
+{
+    lac_bench_dc_shared_t *pShared = NULL;
+    lac_bench_dc_priv_t *pPriv = NULL;
+    lac_bench_thread_t thread;
+    size_t ret = 0;
+    int level = LAC_BENCH_ZSTD_FAST_LEVEL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = lacBenchDcInit(pConfig, ppShared);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    pShared = *ppShared;
+    memset(&thread, 0, sizeof(thread));
+    thread.pConfig = pConfig;
+    thread.pShared = pShared;
+    status = lacBenchLz4sZstdSetup(&thread);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchDcFini(pShared);
+        return status;
+    }
+    pPriv = thread.pPriv;
+    status = lacBenchSwZstdCtxSetup(pPriv, pConfig->size);
+    for (; CPA_STATUS_SUCCESS == status && level <= ZSTD_maxCLevel(); level++)
+    {
+        /* 0 selects the default level */
+        if (0 == level)
+        {
+            continue;
+        }
+        ret = ZSTD_compressCCtx(pPriv->pZstdCtx,
+                                pPriv->swZstd.pData,
+                                pPriv->swZstd.dataLenInBytes,
+                                pPriv->pSrcData,
+                                pConfig->size,
+                                level);
+        if (ZSTD_isError(ret))
+        {
+            status = CPA_STATUS_FAIL;
+        }
+        else if (ret <= pPriv->zstdSize)
+        {
+            break;
+        }
+    }
+    if (level > ZSTD_maxCLevel())
+    {
+        level = ZSTD_maxCLevel();
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pShared->zstdLevel = level;
+        LAC_BENCH_LOG_USER("sw_zstd: %u bytes of text convert to %u, level "
+                           "%d compresses them to %u\n",
+                           pConfig->size,
+                           pPriv->zstdSize,
+                           level,
+                           (Cpa32U)ret);
+    }
+    lacBenchDcTeardown(&thread);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchDcFini(pShared);
+    }
+    return status;
+}
+
+static CpaStatus lacBenchSwZstdSetup(lac_bench_thread_t *pThread)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = lacBenchLz4sZstdSetup(pThread);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    status = lacBenchSwZstdCtxSetup(pThread->pPriv, pThread->pConfig->size);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        lacBenchDcTeardown(pThread);
+    }
+    return status;
+}
+
+static void lacBenchSwZstdRun(lac_bench_thread_t *pThread, Cpa64U iterations)
+{
+    lac_bench_dc_shared_t *pShared = pThread->pShared;
+    lac_bench_dc_priv_t *pPriv = pThread->pPriv;
+    Cpa64U i = 0;
+
+    for (i = 0; i < iterations; i++)
+    {
+        if (ZSTD_isError(ZSTD_compressCCtx(pPriv->pZstdCtx,
+                                           pPriv->swZstd.pData,
+                                           pPriv->swZstd.dataLenInBytes,
+                                           pPriv->pSrcData,
+                                           pThread->pConfig->size,
+                                           pShared->zstdLevel)))
+        {
+            pThread->errors++;
+        }
+    }
+}
+#endif
+
+const lac_bench_t lacBenchList[] = {
+    {"ring",
+     "adf_user_put_msg and adf_user_notify_msgs_poll, per request",
+     NULL,
+     NULL,
+     lacBenchRingSetup,
+     lacBenchRingRun,
+     lacBenchRingTeardown},
+    {"ring_batch",
+     "adf_user_put_msgs and adf_user_notify_msgs_poll, per request",
+     NULL,
+     NULL,
+     lacBenchRingSetup,
+     lacBenchRingBatchRun,
+     lacBenchRingTeardown},
+    {"reactor",
+     "round trip through a reactor woken by icp_sal_ReactorNotify",
+     NULL,
+     NULL,
+     lacBenchReactorWakeSetup,
+     lacBenchReactorRun,
+     lacBenchReactorTeardown},
+    {"reactor_busy",
+     "round trip through a busy polling reactor",
+     NULL,
+     NULL,
+     lacBenchReactorBusySetup,
+     lacBenchReactorRun,
+     lacBenchReactorTeardown},
+    {"mempool",
+     "Lac_MemPoolEntryAlloc and Free on a shared pool",
+     lacBenchPoolInit,
+     lacBenchPoolFini,
+     lacBenchNoSetup,
+     lacBenchPoolRun,
+     lacBenchNoTeardown},
+    {"qae_slab",
+     "__qae_mem_alloc and __qae_mem_free of 1 to 16 KB",
+     NULL,
+     NULL,
+     lacBenchSlabSetup,
+     lacBenchSlabBenchRun,
+     lacBenchSlabTeardown},
+    {"bufdesc",
+     "LacBuffDesc_BufferListDescWrite",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchDcSetup,
+     lacBenchBufDescRun,
+     lacBenchDcTeardown},
+    {"bufdesc_reg",
+     "LacBuffDesc_BufferListDescWrite of a registered list",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchBufDescRegSetup,
+     lacBenchBufDescRun,
+     lacBenchDcTeardown},
+    {"dc_request",
+     "dcCreateRequest, stateless compression with CNV",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchDcSetup,
+     lacBenchDcRequestRun,
+     lacBenchDcTeardown},
+    {"crc32",
+     "dcCalculateCrc32",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchDcSetup,
+     lacBenchCrc32Run,
+     lacBenchDcTeardown,
+     CPA_TRUE},
+    {"crc64",
+     "dcCalculateCrc64",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchDcSetup,
+     lacBenchCrc64Run,
+     lacBenchDcTeardown,
+     CPA_TRUE},
+    {"prog_crc64",
+     "dcCalculateProgCrc64, CRC-64/XZ",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchDcSetup,
+     lacBenchProgCrc64Run,
+     lacBenchDcTeardown,
+     CPA_TRUE},
+    {"hdr_cksum",
+     "dc_hdr_cksum of 2 to 14 byte LZ4 frame descriptors",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchDcSetup,
+     lacBenchHdrCksumRun,
+     lacBenchDcTeardown},
+    {"xxh32",
+     "dc_xxh32, the LZ4 content checksum",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchDcSetup,
+     lacBenchXxh32Run,
+     lacBenchDcTeardown,
+     CPA_TRUE},
+    {"lz4s_zstd",
+     "icp_sal_DcLZ4SToZstd of the LZ4s of text",
+     lacBenchDcInit,
+     lacBenchDcFini,
+     lacBenchLz4sZstdSetup,
+     lacBenchLz4sZstdRun,
+     lacBenchDcTeardown,
+     CPA_TRUE},
+#ifdef LAC_BENCH_ZSTD
+    {"sw_zstd",
+     "ZSTD_compressCCtx of the text, at the ratio of lz4s_zstd",
+     lacBenchSwZstdInit,
+     lacBenchDcFini,
+     lacBenchSwZstdSetup,
+     lacBenchSwZstdRun,
+     lacBenchDcTeardown,
+     CPA_TRUE},
+#endif
+};
+
+const Cpa32U lacBenchListSize = sizeof(lacBenchList) / sizeof(lacBenchList[0]);
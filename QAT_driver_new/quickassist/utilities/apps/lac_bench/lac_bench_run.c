@@ -0,0 +1,657 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_bench.h"
+
+/* Untimed share of a run done by every thread before the first one */
+#define LAC_BENCH_WARMUP_DIV 4
+/* Calibration stops doubling once a run takes this share of runMs */
+#define LAC_BENCH_CALIB_DIV 8
+#define LAC_BENCH_LINE 256
+
+/* State shared by the threads of one point of the sweep */
+typedef struct lac_bench_run_s
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    CpaBoolean ready;
+    /**< Set once the barrier is initialised for the threads started */
+    pthread_barrier_t barrier;
+    Cpa32U reps;
+    CpaBoolean abort;
+} lac_bench_run_t;
+
+Cpa64U lacBenchNowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * LAC_BENCH_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+void lacBenchSetDefaults(lac_bench_config_t *pConfig)
+{
+    memset(pConfig, 0, sizeof(*pConfig));
+    pConfig->maxThreads = LAC_BENCH_DEFAULT_MAX_THREADS;
+    pConfig->reps = LAC_BENCH_DEFAULT_REPS;
+    pConfig->runMs = LAC_BENCH_DEFAULT_MS;
+    pConfig->size = LAC_BENCH_DEFAULT_SIZE;
+    pConfig->segments = LAC_BENCH_DEFAULT_SEGMENTS;
+    pConfig->tolerance = LAC_BENCH_DEFAULT_TOLERANCE;
+    pConfig->pin = CPA_TRUE;
+}
+
+CpaBoolean lacBenchSelected(const lac_bench_config_t *pConfig,
+                            const char *pName)
+{
+    const char *pCur = pConfig->pFilter;
+    size_t len = strlen(pName);
+
+    if (NULL == pCur)
+    {
+        return CPA_TRUE;
+    }
+    while (*pCur)
+    {
+        size_t curLen = strcspn(pCur, ",");
+
+        if (curLen == len && 0 == strncmp(pCur, pName, len))
+        {
+            return CPA_TRUE;
+        }
+        pCur += curLen;
+        if (',' == *pCur)
+        {
+            pCur++;
+        }
+    }
+    return CPA_FALSE;
+}
+
+/* Pins a thread to the idx-th CPU the process may run on */
+static Cpa32S lacBenchPin(pthread_t tid, Cpa32U idx)
+{
+    cpu_set_t allowed;
+    cpu_set_t cpuSet;
+    Cpa32U count = 0;
+    Cpa32S cpu = 0;
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed))
+    {
+        return -1;
+    }
+    idx %= CPU_COUNT(&allowed);
+    for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &allowed) && count++ == idx)
+        {
+            break;
+        }
+    }
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(tid, sizeof(cpuSet), &cpuSet))
+    {
+        return -1;
+    }
+    return cpu;
+}
+
+/*
+ ******************************************************************
+ * @ingroup lac_bench
+ *        Body of a benchmark thread
+ *
+ * @description
+ *        The thread sets itself up and warms up, then performs one
+ *        timed run per rep. The main thread lines the runs up with
+ *        the barrier, so that they all overlap.
+ *
+ ******************************************************************
+ */
+static void *lacBenchThread(void *pArg)
+{
+    lac_bench_thread_t *pThread = pArg;
+    const lac_bench_t *pBench = pThread->pBench;
+    lac_bench_run_t *pRun = pThread->pRun;
+    Cpa32U rep = 0;
+
+    pThread->status = pBench->setup(pThread);
+    pthread_mutex_lock(&pRun->lock);
+    while (!pRun->ready)
+    {
+        pthread_cond_wait(&pRun->cond, &pRun->lock);
+    }
+    pthread_mutex_unlock(&pRun->lock);
+    /* The main thread checks the setup of every thread in between */
+    pthread_barrier_wait(&pRun->barrier);
+    pthread_barrier_wait(&pRun->barrier);
+    if (pRun->abort)
+    {
+        goto out;
+    }
+
+    pBench->run(pThread, pThread->iterations / LAC_BENCH_WARMUP_DIV + 1);
+    pThread->errors = 0;
+    for (rep = 0; rep < pRun->reps; rep++)
+    {
+        pthread_barrier_wait(&pRun->barrier);
+        pThread->startNs = lacBenchNowNs();
+        pBench->run(pThread, pThread->iterations);
+        pThread->endNs = lacBenchNowNs();
+        pthread_barrier_wait(&pRun->barrier);
+    }
+
+out:
+    if (CPA_STATUS_SUCCESS == pThread->status)
+    {
+        pBench->teardown(pThread);
+    }
+    return NULL;
+}
+
+/* Finds how many operations a thread performs in about runMs */
+static CpaStatus lacBenchCalibrate(const lac_bench_config_t *pConfig,
+                                   const lac_bench_t *pBench,
+                                   void *pShared,
+                                   Cpa64U *pIterations)
+{
+    lac_bench_thread_t thread;
+    Cpa64U target = pConfig->runMs * LAC_BENCH_NSEC_PER_MSEC;
+    Cpa64U iterations = 1;
+    Cpa64U elapsed = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    memset(&thread, 0, sizeof(thread));
+    thread.pConfig = pConfig;
+    thread.pBench = pBench;
+    thread.pShared = pShared;
+    thread.cpu = -1;
+    status = pBench->setup(&thread);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    for (;;)
+    {
+        Cpa64U start = lacBenchNowNs();
+
+        pBench->run(&thread, iterations);
+        elapsed = lacBenchNowNs() - start;
+        if (elapsed >= target / LAC_BENCH_CALIB_DIV || iterations >> 62)
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+    pBench->teardown(&thread);
+    if (thread.errors)
+    {
+        LAC_BENCH_LOG_ERROR("%s: %llu of %llu operations failed\n",
+                            pBench->name,
+                            (unsigned long long)thread.errors,
+                            (unsigned long long)iterations);
+        return CPA_STATUS_FAIL;
+    }
+
+    if (elapsed)
+    {
+        iterations = (double)iterations * target / elapsed;
+    }
+    *pIterations = iterations ? iterations : 1;
+    return CPA_STATUS_SUCCESS;
+}
+
+static int lacBenchCmpDouble(const void *pA, const void *pB)
+{
+    double a = *(const double *)pA;
+    double b = *(const double *)pB;
+
+    return (a > b) - (a < b);
+}
+
+/*
+ ******************************************************************
+ * @ingroup lac_bench
+ *        Run one benchmark with a given number of threads
+ *
+ * @description
+ *        The time of an operation is measured in every thread and
+ *        averaged over the threads, the throughput over the wall time
+ *        from the first start to the last end. Both are the medians of
+ *        the reps, which keeps a run disturbed by the system from
+ *        moving the result.
+ *
+ ******************************************************************
+ */
+static CpaStatus lacBenchPoint(const lac_bench_config_t *pConfig,
+                               const lac_bench_t *pBench,
+                               void *pShared,
+                               Cpa64U iterations,
+                               Cpa32U numThreads,
+                               lac_bench_result_t *pResult)
+{
+    lac_bench_thread_t *pThreads = NULL;
+    lac_bench_run_t run;
+    double nsPerOp[LAC_BENCH_MAX_REPS];
+    double opsPerSec[LAC_BENCH_MAX_REPS];
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U started = 0;
+    Cpa32U rep = 0;
+    Cpa32U i = 0;
+
+    pThreads = calloc(numThreads, sizeof(*pThreads));
+    if (NULL == pThreads)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    memset(&run, 0, sizeof(run));
+    run.reps = pConfig->reps;
+    pthread_mutex_init(&run.lock, NULL);
+    pthread_cond_init(&run.cond, NULL);
+
+    memset(pResult, 0, sizeof(*pResult));
+    snprintf(pResult->name, sizeof(pResult->name), "%s", pBench->name);
+    pResult->threads = numThreads;
+    pResult->size = pConfig->size;
+
+    for (i = 0; i < numThreads; i++)
+    {
+        lac_bench_thread_t *pThread = &pThreads[i];
+
+        pThread->pConfig = pConfig;
+        pThread->pBench = pBench;
+        pThread->pShared = pShared;
+        pThread->idx = i;
+        pThread->cpu = -1;
+        pThread->iterations = iterations;
+        pThread->pRun = &run;
+        if (pthread_create(&pThread->tid, NULL, lacBenchThread, pThread))
+        {
+            LAC_BENCH_LOG_ERROR("%s: cannot create thread %u\n",
+                                pBench->name,
+                                i);
+            status = CPA_STATUS_RESOURCE;
+            break;
+        }
+        started++;
+        if (pConfig->pin)
+        {
+            pThread->cpu = lacBenchPin(pThread->tid, i);
+        }
+    }
+
+    /* Threads that could not be created never reach the barrier, the
+     * others are only let through it to tear down */
+    pthread_barrier_init(&run.barrier, NULL, started + 1);
+    pthread_mutex_lock(&run.lock);
+    run.ready = CPA_TRUE;
+    pthread_cond_broadcast(&run.cond);
+    pthread_mutex_unlock(&run.lock);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        run.abort = CPA_TRUE;
+    }
+
+    pthread_barrier_wait(&run.barrier);
+    for (i = 0; i < started; i++)
+    {
+        if (CPA_STATUS_SUCCESS != pThreads[i].status)
+        {
+            LAC_BENCH_LOG_ERROR("%s: setup of thread %u failed, status %d\n",
+                                pBench->name,
+                                i,
+                                pThreads[i].status);
+            status = pThreads[i].status;
+            run.abort = CPA_TRUE;
+        }
+    }
+    pthread_barrier_wait(&run.barrier);
+
+    for (rep = 0; !run.abort && rep < run.reps; rep++)
+    {
+        Cpa64U first = 0;
+        Cpa64U last = 0;
+        double sum = 0;
+
+        pthread_barrier_wait(&run.barrier);
+        pthread_barrier_wait(&run.barrier);
+        for (i = 0; i < numThreads; i++)
+        {
+            lac_bench_thread_t *pThread = &pThreads[i];
+
+            if (0 == i || pThread->startNs < first)
+            {
+                first = pThread->startNs;
+            }
+            if (pThread->endNs > last)
+            {
+                last = pThread->endNs;
+            }
+            sum += (double)(pThread->endNs - pThread->startNs) /
+                   pThread->iterations;
+        }
+        nsPerOp[rep] = sum / numThreads;
+        opsPerSec[rep] = last > first ? (double)numThreads * iterations *
+                                            LAC_BENCH_NSEC_PER_SEC /
+                                            (last - first)
+                                      : 0;
+    }
+
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(pThreads[i].tid, NULL);
+        pResult->errors += pThreads[i].errors;
+    }
+    pthread_barrier_destroy(&run.barrier);
+    pthread_cond_destroy(&run.cond);
+    pthread_mutex_destroy(&run.lock);
+    free(pThreads);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    qsort(nsPerOp, run.reps, sizeof(double), lacBenchCmpDouble);
+    qsort(opsPerSec, run.reps, sizeof(double), lacBenchCmpDouble);
+    pResult->nsPerOp = nsPerOp[run.reps / 2];
+    pResult->opsPerSec = opsPerSec[run.reps / 2];
+    if (pResult->nsPerOp > 0)
+    {
+        pResult->spread = (nsPerOp[run.reps - 1] - nsPerOp[0]) * 100 /
+                          pResult->nsPerOp;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus lacBenchSweep(const lac_bench_config_t *pConfig,
+                        const lac_bench_t *pBench,
+                        lac_bench_result_t *pResults,
+                        Cpa32U *pNumResults)
+{
+    void *pShared = NULL;
+    Cpa64U iterations = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U threads = 1;
+
+    if (pBench->init)
+    {
+        status = pBench->init(pConfig, &pShared);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            LAC_BENCH_LOG_ERROR("%s: init failed, status %d\n",
+                                pBench->name,
+                                status);
+            return status;
+        }
+    }
+
+    status = lacBenchCalibrate(pConfig, pBench, pShared, &iterations);
+    while (CPA_STATUS_SUCCESS == status)
+    {
+        lac_bench_result_t *pResult = &pResults[*pNumResults];
+
+        if (*pNumResults >= LAC_BENCH_MAX_RESULTS)
+        {
+            LAC_BENCH_LOG_ERROR("Too many results\n");
+            status = CPA_STATUS_RESOURCE;
+            break;
+        }
+        status = lacBenchPoint(
+            pConfig, pBench, pShared, iterations, threads, pResult);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+        if (pBench->perByte)
+        {
+            pResult->gbPerSec =
+                pResult->opsPerSec * pResult->size / LAC_BENCH_BYTES_PER_GB;
+        }
+        lacBenchPrintResult(pResult);
+        (*pNumResults)++;
+        if (threads == pConfig->maxThreads)
+        {
+            break;
+        }
+        threads *= 2;
+        if (threads > pConfig->maxThreads)
+        {
+            threads = pConfig->maxThreads;
+        }
+    }
+
+    if (pBench->fini)
+    {
+        pBench->fini(pShared);
+    }
+    return status;
+}
+
+void lacBenchPrintHeader(void)
+{
+    LAC_BENCH_LOG_USER("%-14s %7s %8s %12s %14s %8s %8s %8s\n",
+                       "benchmark",
+                       "threads",
+                       "size",
+                       "ns/op",
+                       "ops/s",
+                       "GB/s",
+                       "spread%",
+                       "errors");
+}
+
+void lacBenchPrintResult(const lac_bench_result_t *pResult)
+{
+    char rate[LAC_BENCH_NAME_LEN] = "-";
+
+    if (pResult->gbPerSec > 0)
+    {
+        snprintf(rate, sizeof(rate), "%.2f", pResult->gbPerSec);
+    }
+    LAC_BENCH_LOG_USER("%-14s %7u %8u %12.1f %14.0f %8s %8.1f %8llu\n",
+                       pResult->name,
+                       pResult->threads,
+                       pResult->size,
+                       pResult->nsPerOp,
+                       pResult->opsPerSec,
+                       rate,
+                       pResult->spread,
+                       (unsigned long long)pResult->errors);
+}
+
+CpaStatus lacBenchSave(const char *pPath,
+                       const lac_bench_result_t *pResults,
+                       Cpa32U numResults)
+{
+    FILE *pFile = NULL;
+    Cpa32U i = 0;
+
+    pFile = fopen(pPath, "w");
+    if (NULL == pFile)
+    {
+        LAC_BENCH_LOG_ERROR("Cannot open %s: %s\n", pPath, strerror(errno));
+        return CPA_STATUS_FAIL;
+    }
+    fprintf(pFile, "# lac_bench results\n# name threads size ns/op ops/s\n");
+    for (i = 0; i < numResults; i++)
+    {
+        fprintf(pFile,
+                "%s %u %u %.3f %.0f\n",
+                pResults[i].name,
+                pResults[i].threads,
+                pResults[i].size,
+                pResults[i].nsPerOp,
+                pResults[i].opsPerSec);
+    }
+    if (fclose(pFile))
+    {
+        LAC_BENCH_LOG_ERROR("Cannot write %s: %s\n", pPath, strerror(errno));
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ ******************************************************************
+ * @ingroup lac_bench
+ *        Compare the results against a baseline
+ *
+ * @description
+ *        Results are matched on the benchmark, the thread count and the
+ *        size; those missing from either side are skipped. Only the
+ *        time of an operation is gated on, the throughput depends on
+ *        how many CPUs the system has free at the time.
+ *
+ ******************************************************************
+ */
+Cpa32S lacBenchCompare(const char *pPath,
+                       Cpa32U tolerance,
+                       const lac_bench_result_t *pResults,
+                       Cpa32U numResults)
+{
+    char line[LAC_BENCH_LINE];
+    FILE *pFile = NULL;
+    Cpa32S regressions = 0;
+    Cpa32U i = 0;
+
+    pFile = fopen(pPath, "r");
+    if (NULL == pFile)
+    {
+        LAC_BENCH_LOG_ERROR("Cannot open %s: %s\n", pPath, strerror(errno));
+        return -1;
+    }
+    LAC_BENCH_LOG_USER("\nAgainst %s, tolerance %u%%:\n", pPath, tolerance);
+    LAC_BENCH_LOG_USER("%-14s %7s %8s %12s %12s %8s\n",
+                       "benchmark",
+                       "threads",
+                       "size",
+                       "base ns/op",
+                       "ns/op",
+                       "change%");
+    while (fgets(line, sizeof(line), pFile))
+    {
+        char name[LAC_BENCH_NAME_LEN];
+        unsigned threads = 0;
+        unsigned size = 0;
+        double nsPerOp = 0;
+        double opsPerSec = 0;
+
+        if ('#' == line[0] ||
+            5 != sscanf(line,
+                        "%31s %u %u %lf %lf",
+                        name,
+                        &threads,
+                        &size,
+                        &nsPerOp,
+                        &opsPerSec) ||
+            nsPerOp <= 0)
+        {
+            continue;
+        }
+        for (i = 0; i < numResults; i++)
+        {
+            const lac_bench_result_t *pResult = &pResults[i];
+            double change = 0;
+            CpaBoolean slower = CPA_FALSE;
+
+            if (strcmp(pResult->name, name) || pResult->threads != threads ||
+                pResult->size != size)
+            {
+                continue;
+            }
+            change = (pResult->nsPerOp - nsPerOp) * 100 / nsPerOp;
+            slower = change > tolerance;
+            LAC_BENCH_LOG_USER("%-14s %7u %8u %12.1f %12.1f %+8.1f%s\n",
+                               name,
+                               threads,
+                               size,
+                               nsPerOp,
+                               pResult->nsPerOp,
+                               change,
+                               slower ? "  REGRESSION" : "");
+            if (slower)
+            {
+                regressions++;
+            }
+            break;
+        }
+    }
+    fclose(pFile);
+    return regressions;
+}
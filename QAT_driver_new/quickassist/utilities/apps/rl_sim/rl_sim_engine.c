@@ -0,0 +1,462 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "rl_sim.h"
+
+/* Device parameters of a 4xxx device */
+#define RL_SIM_4XXX_CLOCK_FREQUENCY (1000 * 1000000ULL)
+#define RL_SIM_4XXX_NUM_SLICES 4
+#define RL_SIM_4XXX_NUM_AES 8
+#define RL_SIM_4XXX_SCANS_PER_SEC 954
+#define RL_SIM_4XXX_SLICE_REF 1000
+#define RL_SIM_4XXX_CNV_SLICE 1
+#define RL_SIM_4XXX_PCIE_SCALE_MUL 102
+#define RL_SIM_4XXX_PCIE_SCALE_DIV 100
+
+static const Cpa32U rlSim4xxxMaxThroughput[ADF_SVC_NONE] = {
+    173750, /* ADF_SVC_ASYM */
+    95000,  /* ADF_SVC_SYM */
+    45000   /* ADF_SVC_DC */
+};
+
+#define RL_SIM_TRACE_GROW 1024
+
+#define RL_SIM_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+void rlSimSetDefaults(rl_sim_t *pSim, enum adf_svc_type svcType)
+{
+    struct rl_v2_svc_params *pParams = &pSim->params;
+
+    pParams->svc_type = svcType;
+    pParams->clock_frequency = RL_SIM_4XXX_CLOCK_FREQUENCY;
+    pParams->num_slices = RL_SIM_4XXX_NUM_SLICES;
+    pParams->num_aes = RL_SIM_4XXX_NUM_AES;
+    pParams->scan_interval = RL_SIM_4XXX_SCANS_PER_SEC;
+    pParams->max_throughput =
+        svcType < ADF_SVC_NONE ? rlSim4xxxMaxThroughput[svcType] : 0;
+    pParams->slice_reference = RL_SIM_4XXX_SLICE_REF;
+    pParams->dc_correction = RL_SIM_4XXX_CNV_SLICE;
+    pParams->pcie_scale_multiplier = RL_SIM_4XXX_PCIE_SCALE_MUL;
+    pParams->pcie_scale_divisor = RL_SIM_4XXX_PCIE_SCALE_DIV;
+
+    /* The root owns the whole service until told otherwise */
+    strncpy(pSim->root.name, "root", RL_SIM_MAX_NAME - 1);
+    pSim->root.sla.svc_type = svcType;
+    pSim->root.sla.nodetype = ADF_NODE_ROOT;
+    pSim->root.sla.cir = RL_VALIDATE_RET_MAX(
+        svcType, pParams->slice_reference, pParams->max_throughput);
+    pSim->root.sla.pir = pSim->root.sla.cir;
+}
+
+/* Gives the root node its SLA once the device parameters are final */
+static CpaStatus rlSimInitRoot(rl_sim_t *pSim)
+{
+    rl_sim_node_t *pRoot = &pSim->root;
+
+    pRoot->sla.svc_type = pSim->params.svc_type;
+    if (!rl_v2_sla_in_range(&pSim->params, &pRoot->sla))
+    {
+        RL_SIM_LOG_ERROR("Root SLA out of range\n");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    rl_v2_fix_pir_to_cir(&pRoot->sla);
+    if (rl_v2_calc_budget(&pSim->params, &pRoot->sla, &pRoot->budget))
+    {
+        RL_SIM_LOG_ERROR("Root SLA value too low\n");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    pRoot->info.nodetype = ADF_NODE_ROOT;
+    pRoot->info.svc_type = pSim->params.svc_type;
+    pRoot->info.sla = pRoot->sla;
+    pRoot->info.rem_cir = pRoot->sla.cir;
+    pRoot->info.max_pir = pRoot->sla.pir;
+    pRoot->info.sla_added = true;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus rlSimAddNode(rl_sim_t *pSim,
+                       rl_sim_node_t *pParent,
+                       rl_sim_node_t *pNode)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (&pSim->root == pParent && !pParent->info.sla_added)
+    {
+        status = rlSimInitRoot(pSim);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+    }
+
+    /* Same checks and order as rl_add_node_intree */
+    pNode->sla.svc_type = pSim->params.svc_type;
+    if (!rl_v2_sla_in_range(&pSim->params, &pNode->sla))
+    {
+        RL_SIM_LOG_ERROR("%s: SLA out of range\n", pNode->name);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (!rl_v2_enough_sla_budget(&pParent->info, &pNode->sla))
+    {
+        RL_SIM_LOG_ERROR("%s: no SLA budget left in %s (%u CIR left)\n",
+                         pNode->name,
+                         pParent->name,
+                         pParent->info.rem_cir);
+        return CPA_STATUS_RESOURCE;
+    }
+    if (rl_v2_fix_pir_to_cir(&pNode->sla))
+    {
+        RL_SIM_LOG_ERROR("%s: PIR must be >= CIR, PIR set to CIR\n",
+                         pNode->name);
+    }
+    if (rl_v2_calc_budget(&pSim->params, &pNode->sla, &pNode->budget))
+    {
+        RL_SIM_LOG_ERROR("%s: SLA value too low\n", pNode->name);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    pNode->info.nodetype = pNode->sla.nodetype;
+    pNode->info.svc_type = pNode->sla.svc_type;
+    pNode->info.sla = pNode->sla;
+    pNode->info.sla_added = true;
+    rl_v2_attach_node(&pParent->info, &pNode->info, &pNode->sla);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus rlSimLoadTrace(rl_sim_t *pSim, rl_sim_leaf_t *pLeaf)
+{
+    rl_sim_request_t *pRequests = NULL;
+    rl_sim_request_t *pGrown = NULL;
+    Cpa32U capacity = 0;
+    Cpa32U workSize = 0;
+    Cpa32U intervalUs = 0;
+    Cpa64U arrivalNs = 0;
+    FILE *pFile = NULL;
+
+    pFile = fopen(pLeaf->traceFile, "r");
+    if (NULL == pFile)
+    {
+        RL_SIM_LOG_ERROR("Cannot open trace %s\n", pLeaf->traceFile);
+        return CPA_STATUS_FAIL;
+    }
+
+    pLeaf->numRequests = 0;
+    while (2 == fscanf(pFile, "%u %u", &workSize, &intervalUs))
+    {
+        if (pLeaf->numRequests == capacity)
+        {
+            capacity += RL_SIM_TRACE_GROW;
+            pGrown = realloc(pRequests, capacity * sizeof(rl_sim_request_t));
+            if (NULL == pGrown)
+            {
+                RL_SIM_LOG_ERROR("Failed to allocate trace memory\n");
+                free(pRequests);
+                fclose(pFile);
+                return CPA_STATUS_RESOURCE;
+            }
+            pRequests = pGrown;
+        }
+        arrivalNs += (Cpa64U)intervalUs * RL_SIM_NSEC_PER_USEC;
+        pRequests[pLeaf->numRequests].arrivalNs = arrivalNs;
+        pRequests[pLeaf->numRequests].bytes =
+            (Cpa64U)workSize * pSim->bytesPerUnit;
+        pRequests[pLeaf->numRequests].delayNs = 0;
+        pLeaf->bytesOffered += pRequests[pLeaf->numRequests].bytes;
+        pLeaf->numRequests++;
+    }
+    fclose(pFile);
+
+    if (0 == pLeaf->numRequests)
+    {
+        RL_SIM_LOG_ERROR("Trace %s holds no request\n", pLeaf->traceFile);
+        free(pRequests);
+        return CPA_STATUS_FAIL;
+    }
+    pLeaf->pRequests = pRequests;
+    pLeaf->headBytesLeft = pRequests[0].bytes;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Moves the requests that arrive before endNs into the leaf queue */
+static void rlSimAdmit(rl_sim_leaf_t *pLeaf, Cpa64U endNs)
+{
+    while (pLeaf->nextArrival < pLeaf->numRequests &&
+           pLeaf->pRequests[pLeaf->nextArrival].arrivalNs < endNs)
+    {
+        pLeaf->queuedBytes += pLeaf->pRequests[pLeaf->nextArrival].bytes;
+        pLeaf->nextArrival++;
+    }
+}
+
+/* Tokens the leaf could use in a scan, limited by its PIR */
+static Cpa32U rlSimDemand(rl_sim_leaf_t *pLeaf)
+{
+    Cpa64U tokens = (pLeaf->queuedBytes + RL_SIM_TOKEN_BYTES - 1) /
+                    RL_SIM_TOKEN_BYTES;
+
+    return RL_SIM_MIN(tokens, (Cpa64U)pLeaf->node.budget.pcie_in_pir);
+}
+
+/* Hands out the tokens of a scan, CIR first then the spare PIR */
+static void rlSimGrant(rl_sim_t *pSim, Cpa32U *pDemand)
+{
+    rl_sim_leaf_t *pLeaf = NULL;
+    rl_sim_node_t *pCluster = NULL;
+    rl_sim_node_t *pRoot = &pSim->root;
+    Cpa32U numWanting[RL_SIM_MAX_CLUSTERS] = { 0 };
+    Cpa32U avail = 0;
+    Cpa32U share = 0;
+    Cpa32U grant = 0;
+    Cpa32U i = 0;
+    CpaBoolean progress = CPA_TRUE;
+
+    pRoot->grantedTokens = 0;
+    for (i = 0; i < pSim->numClusters; i++)
+    {
+        pSim->clusters[i].grantedTokens = 0;
+    }
+
+    /* Committed rate, always affordable as children CIRs fit in their
+     * parent CIR */
+    for (i = 0; i < pSim->numLeaves; i++)
+    {
+        pLeaf = &pSim->leaves[i];
+        grant = RL_SIM_MIN(pDemand[i], pLeaf->node.budget.pcie_in_cir);
+        pLeaf->node.grantedTokens = grant;
+        pLeaf->committedUsedTokens += grant;
+        pSim->clusters[pLeaf->clusterIdx].grantedTokens += grant;
+        pRoot->grantedTokens += grant;
+    }
+
+    /* Share the spare peak budget equally between the leaves that still
+     * have demand, within their cluster and root PIR */
+    while (progress)
+    {
+        progress = CPA_FALSE;
+        memset(numWanting, 0, sizeof(numWanting));
+        for (i = 0; i < pSim->numLeaves; i++)
+        {
+            pLeaf = &pSim->leaves[i];
+            if (pLeaf->node.grantedTokens < pDemand[i])
+            {
+                numWanting[pLeaf->clusterIdx]++;
+            }
+        }
+        for (i = 0; i < pSim->numLeaves; i++)
+        {
+            pLeaf = &pSim->leaves[i];
+            pCluster = &pSim->clusters[pLeaf->clusterIdx];
+            if (pLeaf->node.grantedTokens >= pDemand[i])
+            {
+                continue;
+            }
+            avail = RL_SIM_MIN(
+                pCluster->budget.pcie_in_pir - pCluster->grantedTokens,
+                pRoot->budget.pcie_in_pir - pRoot->grantedTokens);
+            share = avail / numWanting[pLeaf->clusterIdx];
+            if (0 == share)
+            {
+                share = avail;
+            }
+            grant = RL_SIM_MIN(share, pDemand[i] - pLeaf->node.grantedTokens);
+            if (0 == grant)
+            {
+                continue;
+            }
+            pLeaf->node.grantedTokens += grant;
+            pLeaf->excessTokens += grant;
+            pCluster->grantedTokens += grant;
+            pRoot->grantedTokens += grant;
+            progress = CPA_TRUE;
+        }
+    }
+}
+
+/* Completes the queued requests covered by the tokens granted */
+static void rlSimServe(rl_sim_leaf_t *pLeaf, Cpa64U scanEndNs)
+{
+    Cpa64U bytes = (Cpa64U)pLeaf->node.grantedTokens * RL_SIM_TOKEN_BYTES;
+    Cpa64U take = 0;
+    rl_sim_request_t *pRequest = NULL;
+
+    while (bytes > 0 && pLeaf->head < pLeaf->nextArrival)
+    {
+        pRequest = &pLeaf->pRequests[pLeaf->head];
+        take = RL_SIM_MIN(bytes, pLeaf->headBytesLeft);
+        bytes -= take;
+        pLeaf->headBytesLeft -= take;
+        pLeaf->queuedBytes -= take;
+        pLeaf->bytesServed += take;
+        if (0 == pLeaf->headBytesLeft)
+        {
+            pRequest->delayNs = scanEndNs - pRequest->arrivalNs;
+            pLeaf->lastCompletionNs = scanEndNs;
+            pLeaf->head++;
+            if (pLeaf->head < pLeaf->numRequests)
+            {
+                pLeaf->headBytesLeft = pLeaf->pRequests[pLeaf->head].bytes;
+            }
+        }
+    }
+}
+
+void rlSimRun(rl_sim_t *pSim)
+{
+    Cpa32U demand[RL_SIM_MAX_LEAVES] = { 0 };
+    rl_sim_leaf_t *pLeaf = NULL;
+    Cpa64U scan = 0;
+    Cpa64U scanEndNs = 0;
+    Cpa64U nextArrivalNs = 0;
+    CpaBoolean backlog = CPA_FALSE;
+    Cpa32U i = 0;
+
+    pSim->scanNs = RL_SIM_NSEC_PER_SEC / pSim->params.scan_interval;
+    pSim->numScans = 0;
+
+    for (;;)
+    {
+        if (pSim->maxDurationNs && scan * pSim->scanNs >= pSim->maxDurationNs)
+        {
+            break;
+        }
+        scanEndNs = (scan + 1) * pSim->scanNs;
+
+        backlog = CPA_FALSE;
+        for (i = 0; i < pSim->numLeaves; i++)
+        {
+            pLeaf = &pSim->leaves[i];
+            rlSimAdmit(pLeaf, scanEndNs);
+            demand[i] = rlSimDemand(pLeaf);
+            if (demand[i])
+            {
+                backlog = CPA_TRUE;
+            }
+        }
+
+        if (!backlog)
+        {
+            /* Skip to the scan of the next arrival, if any */
+            nextArrivalNs = 0;
+            for (i = 0; i < pSim->numLeaves; i++)
+            {
+                pLeaf = &pSim->leaves[i];
+                if (pLeaf->nextArrival < pLeaf->numRequests &&
+                    (0 == nextArrivalNs ||
+                     pLeaf->pRequests[pLeaf->nextArrival].arrivalNs <
+                         nextArrivalNs))
+                {
+                    nextArrivalNs =
+                        pLeaf->pRequests[pLeaf->nextArrival].arrivalNs;
+                }
+            }
+            if (0 == nextArrivalNs)
+            {
+                break;
+            }
+            scan = nextArrivalNs / pSim->scanNs;
+            continue;
+        }
+
+        rlSimGrant(pSim, demand);
+        for (i = 0; i < pSim->numLeaves; i++)
+        {
+            rlSimServe(&pSim->leaves[i], scanEndNs);
+        }
+        pSim->numScans++;
+        scan++;
+    }
+
+    /* Committed budget is reserved for the whole simulated time */
+    pSim->endNs = scan * pSim->scanNs;
+    for (i = 0; i < pSim->numLeaves; i++)
+    {
+        pLeaf = &pSim->leaves[i];
+        pLeaf->committedTokens = scan * pLeaf->node.budget.pcie_in_cir;
+    }
+}
+
+void rlSimFree(rl_sim_t *pSim)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < pSim->numLeaves; i++)
+    {
+        free(pSim->leaves[i].pRequests);
+        pSim->leaves[i].pRequests = NULL;
+    }
+}
@@ -0,0 +1,489 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "rl_sim.h"
+
+#define RL_SIM_LINE_SIZE 512
+#define RL_SIM_DEFAULT_BYTES_PER_UNIT 1024
+#define RL_SIM_PERCENT(part, total)                                            \
+    ((total) ? (100.0 * (double)(part) / (double)(total)) : 0.0)
+/* Bytes over nanoseconds to megabits per second */
+#define RL_SIM_MBPS(bytes, ns)                                                 \
+    ((ns) ? ((double)(bytes)*8.0 * 1000.0 / (double)(ns)) : 0.0)
+
+static rl_sim_t sim;
+
+static void rlSimUsage(const char *pProgName)
+{
+    printf("Usage: %s [-u bytes_per_unit] [-d max_seconds] <config>\n"
+           "\t-u\tbytes of a trace work size unit (default %u)\n"
+           "\t-d\tstop the simulation after this many seconds\n"
+           "\n"
+           "Configuration lines:\n"
+           "\tdevice <svc|clock_frequency|slices|aes|scan_interval|\n"
+           "\t        max_throughput|slice_reference|dc_correction|\n"
+           "\t        pcie_scale_multiplier|pcie_scale_divisor> <value>\n"
+           "\troot <cir> <pir>\n"
+           "\tcluster <name> <cir> <pir>\n"
+           "\tleaf <name> <cluster> <cir> <pir> <trace_file>\n",
+           pProgName,
+           RL_SIM_DEFAULT_BYTES_PER_UNIT);
+}
+
+static CpaStatus rlSimParseSvc(const char *pValue, enum adf_svc_type *pSvc)
+{
+    if (!strcmp(pValue, "asym"))
+    {
+        *pSvc = ADF_SVC_ASYM;
+    }
+    else if (!strcmp(pValue, "sym"))
+    {
+        *pSvc = ADF_SVC_SYM;
+    }
+    else if (!strcmp(pValue, "dc"))
+    {
+        *pSvc = ADF_SVC_DC;
+    }
+    else
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus rlSimParseDevice(const char *pKey, const char *pValue)
+{
+    struct rl_v2_svc_params *pParams = &sim.params;
+    enum adf_svc_type svcType = ADF_SVC_NONE;
+    unsigned long long value = 0;
+    char *pEnd = NULL;
+
+    if (!strcmp(pKey, "svc"))
+    {
+        if (CPA_STATUS_SUCCESS != rlSimParseSvc(pValue, &svcType))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        /* Service change brings back the device defaults */
+        rlSimSetDefaults(&sim, svcType);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    value = strtoull(pValue, &pEnd, 0);
+    if (*pEnd != '\0')
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (!strcmp(pKey, "clock_frequency"))
+        pParams->clock_frequency = value;
+    else if (!strcmp(pKey, "slices"))
+        pParams->num_slices = value;
+    else if (!strcmp(pKey, "aes"))
+        pParams->num_aes = value;
+    else if (!strcmp(pKey, "scan_interval"))
+        pParams->scan_interval = value;
+    else if (!strcmp(pKey, "max_throughput"))
+        pParams->max_throughput = value;
+    else if (!strcmp(pKey, "slice_reference"))
+        pParams->slice_reference = value;
+    else if (!strcmp(pKey, "dc_correction"))
+        pParams->dc_correction = value;
+    else if (!strcmp(pKey, "pcie_scale_multiplier"))
+        pParams->pcie_scale_multiplier = value;
+    else if (!strcmp(pKey, "pcie_scale_divisor"))
+        pParams->pcie_scale_divisor = value;
+    else
+        return CPA_STATUS_INVALID_PARAM;
+
+    if (!strcmp(pKey, "max_throughput") || !strcmp(pKey, "slice_reference"))
+    {
+        sim.root.sla.cir = RL_VALIDATE_RET_MAX(pParams->svc_type,
+                                               pParams->slice_reference,
+                                               pParams->max_throughput);
+        sim.root.sla.pir = sim.root.sla.cir;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static Cpa32S rlSimFindCluster(const char *pName)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < sim.numClusters; i++)
+    {
+        if (!strcmp(sim.clusters[i].name, pName))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static CpaStatus rlSimReadConfig(const char *pFileName)
+{
+    char line[RL_SIM_LINE_SIZE] = { 0 };
+    char name[RL_SIM_MAX_NAME] = { 0 };
+    char parent[RL_SIM_MAX_NAME] = { 0 };
+    char key[RL_SIM_MAX_NAME] = { 0 };
+    char value[RL_SIM_LINE_SIZE] = { 0 };
+    char trace[RL_SIM_LINE_SIZE] = { 0 };
+    Cpa32U cir = 0;
+    Cpa32U pir = 0;
+    Cpa32U lineNum = 0;
+    Cpa32S clusterIdx = 0;
+    char *pComment = NULL;
+    rl_sim_node_t *pNode = NULL;
+    rl_sim_leaf_t *pLeaf = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    FILE *pFile = NULL;
+
+    pFile = fopen(pFileName, "r");
+    if (NULL == pFile)
+    {
+        RL_SIM_LOG_ERROR("Cannot open %s\n", pFileName);
+        return CPA_STATUS_FAIL;
+    }
+
+    while (CPA_STATUS_SUCCESS == status && fgets(line, sizeof(line), pFile))
+    {
+        lineNum++;
+        pComment = strchr(line, '#');
+        if (pComment)
+        {
+            *pComment = '\0';
+        }
+
+        if (2 == sscanf(line, " device %31s %511s", key, value))
+        {
+            if (sim.numClusters)
+            {
+                RL_SIM_LOG_ERROR("line %u: device set after a cluster\n",
+                                 lineNum);
+                status = CPA_STATUS_INVALID_PARAM;
+                continue;
+            }
+            status = rlSimParseDevice(key, value);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                RL_SIM_LOG_ERROR("line %u: bad device %s %s\n",
+                                 lineNum,
+                                 key,
+                                 value);
+            }
+        }
+        else if (2 == sscanf(line, " root %u %u", &cir, &pir))
+        {
+            if (sim.numClusters)
+            {
+                RL_SIM_LOG_ERROR("line %u: root set after a cluster\n",
+                                 lineNum);
+                status = CPA_STATUS_INVALID_PARAM;
+                continue;
+            }
+            sim.root.sla.cir = cir;
+            sim.root.sla.pir = pir;
+        }
+        else if (3 == sscanf(line, " cluster %31s %u %u", name, &cir, &pir))
+        {
+            if (sim.numClusters == RL_SIM_MAX_CLUSTERS)
+            {
+                RL_SIM_LOG_ERROR("line %u: too many clusters\n", lineNum);
+                status = CPA_STATUS_RESOURCE;
+                continue;
+            }
+            pNode = &sim.clusters[sim.numClusters];
+            snprintf(pNode->name, RL_SIM_MAX_NAME, "%s", name);
+            pNode->sla.nodetype = ADF_NODE_CLUSTER;
+            pNode->sla.cir = cir;
+            pNode->sla.pir = pir;
+            status = rlSimAddNode(&sim, &sim.root, pNode);
+            sim.numClusters++;
+        }
+        else if (5 == sscanf(line,
+                             " leaf %31s %31s %u %u %511s",
+                             name,
+                             parent,
+                             &cir,
+                             &pir,
+                             trace))
+        {
+            clusterIdx = rlSimFindCluster(parent);
+            if (clusterIdx < 0)
+            {
+                RL_SIM_LOG_ERROR("line %u: unknown cluster %s\n",
+                                 lineNum,
+                                 parent);
+                status = CPA_STATUS_INVALID_PARAM;
+                continue;
+            }
+            if (sim.numLeaves == RL_SIM_MAX_LEAVES)
+            {
+                RL_SIM_LOG_ERROR("line %u: too many leaves\n", lineNum);
+                status = CPA_STATUS_RESOURCE;
+                continue;
+            }
+            pLeaf = &sim.leaves[sim.numLeaves];
+            snprintf(pLeaf->node.name, RL_SIM_MAX_NAME, "%s", name);
+            snprintf(pLeaf->traceFile, FILENAME_MAX, "%s", trace);
+            pLeaf->clusterIdx = clusterIdx;
+            pLeaf->node.sla.nodetype = ADF_NODE_LEAF;
+            pLeaf->node.sla.cir = cir;
+            pLeaf->node.sla.pir = pir;
+            status =
+                rlSimAddNode(&sim, &sim.clusters[clusterIdx], &pLeaf->node);
+            if (CPA_STATUS_SUCCESS == status)
+            {
+                sim.numLeaves++;
+                status = rlSimLoadTrace(&sim, pLeaf);
+            }
+        }
+        else if (strspn(line, " \t\r\n") != strlen(line))
+        {
+            RL_SIM_LOG_ERROR("line %u: cannot parse \"%s\"\n", lineNum, line);
+            status = CPA_STATUS_INVALID_PARAM;
+        }
+    }
+    fclose(pFile);
+
+    if (CPA_STATUS_SUCCESS == status && 0 == sim.numLeaves)
+    {
+        RL_SIM_LOG_ERROR("No leaf in %s\n", pFileName);
+        status = CPA_STATUS_INVALID_PARAM;
+    }
+    return status;
+}
+
+static int rlSimCompareDelay(const void *pA, const void *pB)
+{
+    Cpa64U a = *(const Cpa64U *)pA;
+    Cpa64U b = *(const Cpa64U *)pB;
+
+    return (a > b) - (a < b);
+}
+
+static void rlSimPrintBudget(const rl_sim_node_t *pNode)
+{
+    printf("%-12s %8u %8u %10u %10u %8u %8u %10u %10u\n",
+           pNode->name,
+           pNode->sla.cir,
+           pNode->sla.pir,
+           pNode->budget.pcie_in_cir,
+           pNode->budget.pcie_in_pir,
+           pNode->budget.slice_util_cir,
+           pNode->budget.slice_util_pir,
+           pNode->budget.ae_util_cir,
+           pNode->budget.ae_util_pir);
+}
+
+static void rlSimPrintBudgets(void)
+{
+    Cpa32U i = 0;
+
+    printf("Budgets per scan interval (%u scans/s, %llu ns)\n",
+           sim.params.scan_interval,
+           (unsigned long long)sim.scanNs);
+    printf("%-12s %8s %8s %10s %10s %8s %8s %10s %10s\n",
+           "node",
+           "cir",
+           "pir",
+           "pcie_cir",
+           "pcie_pir",
+           "slc_cir",
+           "slc_pir",
+           "ae_cir",
+           "ae_pir");
+    rlSimPrintBudget(&sim.root);
+    for (i = 0; i < sim.numClusters; i++)
+    {
+        rlSimPrintBudget(&sim.clusters[i]);
+    }
+    for (i = 0; i < sim.numLeaves; i++)
+    {
+        rlSimPrintBudget(&sim.leaves[i].node);
+    }
+    printf("\n");
+}
+
+static CpaStatus rlSimPrintResults(void)
+{
+    rl_sim_leaf_t *pLeaf = NULL;
+    Cpa64U *pDelays = NULL;
+    Cpa64U delaySum = 0;
+    Cpa32U numDone = 0;
+    Cpa32U numThrottled = 0;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+
+    printf("Simulated %.3f s, %llu active scans\n",
+           (double)sim.endNs / RL_SIM_NSEC_PER_SEC,
+           (unsigned long long)sim.numScans);
+    printf("%-12s %9s %9s %8s %7s %11s %11s %11s %7s %10s\n",
+           "tenant",
+           "offered",
+           "achieved",
+           "done",
+           "thrtl%",
+           "avg_us",
+           "p99_us",
+           "max_us",
+           "unused%",
+           "excess");
+    for (i = 0; i < sim.numLeaves; i++)
+    {
+        pLeaf = &sim.leaves[i];
+        pDelays = malloc(sizeof(Cpa64U) * (pLeaf->head + 1));
+        if (NULL == pDelays)
+        {
+            RL_SIM_LOG_ERROR("Failed to allocate memory\n");
+            return CPA_STATUS_RESOURCE;
+        }
+        numDone = pLeaf->head;
+        numThrottled = 0;
+        delaySum = 0;
+        for (j = 0; j < numDone; j++)
+        {
+            pDelays[j] = pLeaf->pRequests[j].delayNs;
+            delaySum += pDelays[j];
+            /* Served in the scan it arrived in unless throttled */
+            if (pDelays[j] > sim.scanNs)
+            {
+                numThrottled++;
+            }
+        }
+        qsort(pDelays, numDone, sizeof(Cpa64U), rlSimCompareDelay);
+        printf("%-12s %9.1f %9.1f %8u %7.1f %11.1f %11.1f %11.1f %7.1f "
+               "%10llu\n",
+               pLeaf->node.name,
+               RL_SIM_MBPS(pLeaf->bytesOffered,
+                           pLeaf->pRequests[pLeaf->numRequests - 1].arrivalNs),
+               RL_SIM_MBPS(pLeaf->bytesServed, pLeaf->lastCompletionNs),
+               numDone,
+               RL_SIM_PERCENT(numThrottled, numDone),
+               numDone ? (double)delaySum / numDone / 1000.0 : 0.0,
+               numDone ? (double)pDelays[(numDone * 99) / 100] / 1000.0 : 0.0,
+               numDone ? (double)pDelays[numDone - 1] / 1000.0 : 0.0,
+               RL_SIM_PERCENT(pLeaf->committedTokens -
+                                  pLeaf->committedUsedTokens,
+                              pLeaf->committedTokens),
+               (unsigned long long)pLeaf->excessTokens);
+        free(pDelays);
+    }
+    printf("(offered/achieved in Mbps, delay from arrival to the end of the "
+           "completing scan)\n");
+    return CPA_STATUS_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    int opt = 0;
+
+    rlSimSetDefaults(&sim, ADF_SVC_DC);
+    sim.bytesPerUnit = RL_SIM_DEFAULT_BYTES_PER_UNIT;
+
+    while ((opt = getopt(argc, argv, "u:d:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'u':
+                sim.bytesPerUnit = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                sim.maxDurationNs =
+                    strtoull(optarg, NULL, 0) * RL_SIM_NSEC_PER_SEC;
+                break;
+            default:
+                rlSimUsage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1 || 0 == sim.bytesPerUnit)
+    {
+        rlSimUsage(argv[0]);
+        return 1;
+    }
+
+    status = rlSimReadConfig(argv[optind]);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        rlSimRun(&sim);
+        rlSimPrintBudgets();
+        status = rlSimPrintResults();
+    }
+    rlSimFree(&sim);
+
+    return (CPA_STATUS_SUCCESS == status) ? 0 : 1;
+}
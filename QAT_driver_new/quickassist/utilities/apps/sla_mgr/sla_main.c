@@ -73,12 +73,14 @@
 */
 #include "rl_utils.h"
 #include "sla_manager.h"
+#include "sla_rebalancer.h"
 
 /* Number of arguments for each commands*/
 static int numOfArgCnt[] = {
     SLA_MGR_ARGS_CNT_CREATE, SLA_MGR_ARGS_CNT_UPDATE,
     SLA_MGR_ARGS_CNT_DELETE, SLA_MGR_ARGS_CNT_DELETE_ALL,
-    SLA_MGR_ARGS_CNT_CAPS,   SLA_MGR_ARGS_CNT_LIST
+    SLA_MGR_ARGS_CNT_CAPS,   SLA_MGR_ARGS_CNT_LIST,
+    SLA_MGR_ARGS_CNT_REBALANCE
 };
 
 /*
@@ -139,6 +141,10 @@ static void slaMgrPrintHelp(const Cpa8U *pExe)
     osalLog(OSAL_LOG_LVL_USER, OSAL_LOG_DEV_STDOUT, "\tQuery list of SLAs - ");
     osalLog(
         OSAL_LOG_LVL_USER, OSAL_LOG_DEV_STDOUT, "%s list <pf_addr>\n", pExe);
+#ifndef DISABLE_GEN4_SLA
+    SLA_MGR_LOG_USER("\tRebalance SLAs - %s rebalance <pf_addr> <policy>\n",
+                     pExe);
+#endif
     osalLog(OSAL_LOG_LVL_USER, OSAL_LOG_DEV_STDOUT, "\nOptions:\n");
     osalLog(OSAL_LOG_LVL_USER, OSAL_LOG_DEV_STDOUT, "\tpf_addr           ");
     osalLog(OSAL_LOG_LVL_USER,
@@ -192,6 +198,10 @@ static void slaMgrPrintHelp(const Cpa8U *pExe)
     osalLog(OSAL_LOG_LVL_USER,
             OSAL_LOG_DEV_STDOUT,
             "Value returned by create command\n");
+#ifndef DISABLE_GEN4_SLA
+    SLA_MGR_LOG_USER("\tpolicy            ");
+    SLA_MGR_LOG_USER("Rebalancer policy file, see README\n");
+#endif
 }
 
 /*
@@ -282,6 +292,9 @@ static CpaStatus slaMgrParseParams(Cpa8U **args,
         case SLA_MGR_CMD_DELETE:
             slaMgrStrToSlaId(&pUsrArgs->slaId, args[SLA_MGR_ARGS_SLA_ID]);
             break;
+        case SLA_MGR_CMD_REBALANCE:
+            pUsrArgs->pPolicy = args[SLA_MGR_ARGS_POLICY];
+            break;
         case SLA_MGR_CMD_GET_CAPS:
 
         case SLA_MGR_CMD_GET_LIST:
@@ -349,6 +362,15 @@ int main(int argc, char *argv[])
         case SLA_MGR_CMD_DELETE_ALL:
             status = slaMgrDeleteSlaList(&usrArgs);
             break;
+        case SLA_MGR_CMD_REBALANCE:
+#ifndef DISABLE_GEN4_SLA
+            status = slaMgrRebalance(&usrArgs);
+#else
+            osalLog(OSAL_LOG_LVL_ERROR,
+                    OSAL_LOG_DEV_STDERR,
+                    "Rebalancing needs rate limiting v2\n");
+#endif
+            break;
     }
     if (CPA_STATUS_SUCCESS != status)
     {
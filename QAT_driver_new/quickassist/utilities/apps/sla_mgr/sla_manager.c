@@ -85,9 +85,9 @@
 #include "icp_sal_sla.h"
 
 /* SLA mgr commands */
-static const char *pSlaCommands[] = { "create",     "update", "delete",
-                                      "delete_all", "caps",   "list",
-                                      "unknown" };
+static const char *pSlaCommands[] = { "create", "update",    "delete",
+                                      "delete_all", "caps", "list",
+                                      "rebalance", "unknown" };
 
 /*
  ******************************************************************
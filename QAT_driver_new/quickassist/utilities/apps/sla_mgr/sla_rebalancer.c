@@ -0,0 +1,924 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <limits.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "sla_rebalancer.h"
+#include "icp_sal_sla.h"
+
+#ifndef DISABLE_GEN4_SLA
+
+#define SLA_REBAL_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define SLA_REBAL_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+static volatile sig_atomic_t slaRebalStop = 0;
+
+static void slaRebalSigHandler(int sig)
+{
+    slaRebalStop = 1;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Parse a tenant line of the policy
+ *
+ * @description
+ *        Expected format:
+ *        tenant <sla_id> <floor_cir> <max_pir> <sysfs|trace> <path>
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalParseTenant(sla_rebal_t *pRebal, const char *pLine)
+{
+    sla_rebal_tenant_t *pTenant = NULL;
+    char type[SLA_REBAL_LINE_SIZE] = { 0 };
+    char path[SLA_REBAL_LINE_SIZE] = { 0 };
+    unsigned int slaId = 0;
+    unsigned int floorCir = 0;
+    unsigned int maxPir = 0;
+
+    if (5 != sscanf(pLine,
+                    " tenant %u %u %u %511s %511s",
+                    &slaId,
+                    &floorCir,
+                    &maxPir,
+                    type,
+                    path))
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (SLA_REBAL_MAX_TENANTS == pRebal->numTenants)
+    {
+        SLA_MGR_LOG_ERROR("Too many tenants, max %d\n", SLA_REBAL_MAX_TENANTS);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    pTenant = &pRebal->tenants[pRebal->numTenants];
+    if (!strcmp(type, "sysfs"))
+    {
+        pTenant->demandType = SLA_REBAL_DEMAND_SYSFS;
+    }
+    else if (!strcmp(type, "trace"))
+    {
+        pTenant->demandType = SLA_REBAL_DEMAND_TRACE;
+    }
+    else
+    {
+        SLA_MGR_LOG_ERROR("Unknown demand source %s\n", type);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (maxPir < floorCir)
+    {
+        SLA_MGR_LOG_ERROR("sla_id=%u: max pir below floor cir\n", slaId);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    pTenant->slaId = slaId;
+    pTenant->floorCir = floorCir;
+    pTenant->maxPir = maxPir;
+    snprintf(pTenant->demandPath, FILENAME_MAX, "%s", path);
+    pRebal->numTenants++;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Open the trace of a tenant
+ *
+ * @description
+ *        The trace is replayed in a loop, which would never reach
+ *        the end of an interval if its intervals added up to 0.
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalOpenTrace(sla_rebal_tenant_t *pTenant)
+{
+    unsigned int workSize = 0;
+    unsigned int intervalUs = 0;
+    Cpa64U totalUs = 0;
+
+    pTenant->pTrace = fopen(pTenant->demandPath, "r");
+    if (NULL == pTenant->pTrace)
+    {
+        SLA_MGR_LOG_ERROR("Cannot open %s\n", pTenant->demandPath);
+        return CPA_STATUS_FAIL;
+    }
+    while (2 == fscanf(pTenant->pTrace, "%u %u", &workSize, &intervalUs))
+    {
+        totalUs += intervalUs;
+    }
+    if (0 == totalUs)
+    {
+        SLA_MGR_LOG_ERROR("The intervals of %s add up to 0\n",
+                          pTenant->demandPath);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    rewind(pTenant->pTrace);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Read the rebalancer policy
+ *
+ * @description
+ *        This function reads "<key> <value>" lines and tenant lines,
+ *        '#' starting a comment.
+ *
+ * @param[out] pRebal    rebalancer
+ * @param[in]  pFile     policy file name
+ *
+ * @retval CPA_STATUS_SUCCESS    Operation successful
+ * @retval CPA_STATUS_FAIL       Operation failed
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalReadPolicy(sla_rebal_t *pRebal, const char *pFile)
+{
+    char line[SLA_REBAL_LINE_SIZE] = { 0 };
+    char key[SLA_REBAL_LINE_SIZE] = { 0 };
+    char value[SLA_REBAL_LINE_SIZE] = { 0 };
+    Cpa32U rate = 0;
+    Cpa32U lineNum = 0;
+    Cpa32U i = 0;
+    char *pComment = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    FILE *pPolicy = NULL;
+
+    pPolicy = fopen(pFile, "r");
+    if (NULL == pPolicy)
+    {
+        SLA_MGR_LOG_ERROR("Cannot open policy %s\n", pFile);
+        return CPA_STATUS_FAIL;
+    }
+
+    while (CPA_STATUS_SUCCESS == status &&
+           fgets(line, sizeof(line), pPolicy))
+    {
+        lineNum++;
+        pComment = strchr(line, '#');
+        if (pComment)
+        {
+            *pComment = '\0';
+        }
+        if (2 != sscanf(line, " %511s %511s", key, value))
+        {
+            if (strspn(line, " \t\r\n") != strlen(line))
+            {
+                status = CPA_STATUS_INVALID_PARAM;
+            }
+        }
+        else if (!strcmp(key, "tenant"))
+        {
+            status = slaRebalParseTenant(pRebal, line);
+        }
+        else if (!strcmp(key, "service"))
+        {
+            status = rlStrToSvc(&pRebal->svcType, (Cpa8U *)value);
+        }
+        else if (!strcmp(key, "backend"))
+        {
+            if (!strcmp(value, "device"))
+                pRebal->backend = SLA_REBAL_BACKEND_DEVICE;
+            else if (!strcmp(value, "local"))
+                pRebal->backend = SLA_REBAL_BACKEND_LOCAL;
+            else
+                status = CPA_STATUS_INVALID_PARAM;
+        }
+        else if (CPA_STATUS_SUCCESS != slaMgrStrToRate(&rate, (Cpa8U *)value))
+        {
+            status = CPA_STATUS_INVALID_PARAM;
+        }
+        else if (!strcmp(key, "dry_run"))
+            pRebal->dryRun = rate ? CPA_TRUE : CPA_FALSE;
+        else if (!strcmp(key, "realtime"))
+            pRebal->realtime = rate ? CPA_TRUE : CPA_FALSE;
+        else if (!strcmp(key, "interval_ms"))
+            pRebal->intervalMs = rate;
+        else if (!strcmp(key, "hysteresis"))
+            pRebal->hysteresis = rate;
+        else if (!strcmp(key, "headroom"))
+            pRebal->headroom = rate;
+        else if (!strcmp(key, "smoothing"))
+            pRebal->smoothing = rate;
+        else if (!strcmp(key, "iterations"))
+            pRebal->iterations = rate;
+        else if (!strcmp(key, "bytes_per_unit"))
+            pRebal->bytesPerUnit = rate;
+        else if (!strcmp(key, "capacity"))
+            pRebal->capacity = rate;
+        else
+            status = CPA_STATUS_INVALID_PARAM;
+
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            SLA_MGR_LOG_ERROR("%s:%u: invalid policy line\n", pFile, lineNum);
+        }
+    }
+    fclose(pPolicy);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    if (0 == pRebal->numTenants)
+    {
+        SLA_MGR_LOG_ERROR("No tenant in %s\n", pFile);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    /* Demand is measured in Mbps, asym SLAs are in device utilisation */
+    if (ADF_SVC_SYM != pRebal->svcType && ADF_SVC_DC != pRebal->svcType)
+    {
+        SLA_MGR_LOG_ERROR("Only sym and dc services can be rebalanced\n");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == pRebal->intervalMs || 0 == pRebal->bytesPerUnit ||
+        0 == pRebal->smoothing || SLA_REBAL_PERCENT < pRebal->smoothing)
+    {
+        SLA_MGR_LOG_ERROR("Invalid interval, bytes_per_unit or smoothing\n");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    for (i = 0; CPA_STATUS_SUCCESS == status && i < pRebal->numTenants; i++)
+    {
+        if (SLA_REBAL_DEMAND_TRACE == pRebal->tenants[i].demandType)
+        {
+            status = slaRebalOpenTrace(&pRebal->tenants[i]);
+        }
+    }
+
+    return status;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Read the current SLAs and the budget to share
+ *
+ * @description
+ *        With the device backend the tenants start from their SLA
+ *        on the device and share the CIR still available for the
+ *        service plus their own CIR. With the local backend they
+ *        start from their floor and share the policy capacity.
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalInitSlas(sla_rebal_t *pRebal)
+{
+    struct adf_user_sla_caps caps = { 0 };
+    struct adf_user_slas slas = { 0 };
+    sla_rebal_tenant_t *pTenant = NULL;
+    Cpa32U sumCir = 0;
+    Cpa32U sumFloor = 0;
+    Cpa32U avail = 0;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+
+    if (SLA_REBAL_BACKEND_DEVICE == pRebal->backend)
+    {
+        if (CPA_STATUS_SUCCESS !=
+                icp_sal_userSlaGetCaps(&pRebal->pciAddr, &caps) ||
+            CPA_STATUS_SUCCESS !=
+                icp_sal_userSlaGetList(&pRebal->pciAddr, &slas))
+        {
+            SLA_MGR_LOG_ERROR("Failed to read the SLAs of ");
+            SLA_MGR_LOG_DEV_ERROR(pRebal->pciAddr);
+            return CPA_STATUS_FAIL;
+        }
+        for (i = 0; i < caps.num_services && i < ADF_MAX_SERVICES; i++)
+        {
+            if (caps.services[i].svc_type == pRebal->svcType)
+            {
+                avail = caps.services[i].avail_svc_rate_in_slau;
+            }
+        }
+        for (i = 0; i < pRebal->numTenants; i++)
+        {
+            pTenant = &pRebal->tenants[i];
+            for (j = 0; j < ADF_MAX_SLA; j++)
+            {
+                if (slas.slas[j].pci_addr.bus &&
+                    slas.slas[j].sla_id == pTenant->slaId)
+                {
+                    break;
+                }
+            }
+            if (ADF_MAX_SLA == j ||
+                slas.slas[j].svc_type != pRebal->svcType)
+            {
+                SLA_MGR_LOG_ERROR("No %s SLA with id %d\n",
+                                  rlSvcToStr(pRebal->svcType),
+                                  pTenant->slaId);
+                return CPA_STATUS_FAIL;
+            }
+            pTenant->cir = slas.slas[j].cir;
+            pTenant->pir = slas.slas[j].pir;
+            sumCir += pTenant->cir;
+        }
+        /* A capacity in the policy can only narrow the budget */
+        if (0 == pRebal->capacity || pRebal->capacity > avail + sumCir)
+        {
+            pRebal->capacity = avail + sumCir;
+        }
+    }
+    else
+    {
+        for (i = 0; i < pRebal->numTenants; i++)
+        {
+            pTenant = &pRebal->tenants[i];
+            pTenant->cir = pTenant->floorCir;
+            pTenant->pir = pTenant->maxPir;
+            sumCir += pTenant->cir;
+        }
+    }
+
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        sumFloor += pRebal->tenants[i].floorCir;
+    }
+    if (sumFloor > pRebal->capacity)
+    {
+        SLA_MGR_LOG_ERROR("Floors need %u, only %u to share\n",
+                          sumFloor,
+                          pRebal->capacity);
+        return CPA_STATUS_FAIL;
+    }
+
+    if (SLA_REBAL_BACKEND_LOCAL == pRebal->backend)
+    {
+        if (sumCir > pRebal->capacity)
+        {
+            SLA_MGR_LOG_ERROR("Capacity below the tenant floors\n");
+            return CPA_STATUS_FAIL;
+        }
+        /* Local stand-in of a cluster node owning the tenant leaves */
+        pRebal->localRoot.nodetype = ADF_NODE_CLUSTER;
+        pRebal->localRoot.svc_type = pRebal->svcType;
+        pRebal->localRoot.rem_cir = pRebal->capacity;
+        pRebal->localRoot.max_pir = pRebal->capacity;
+        pRebal->localRoot.sla_added = true;
+        for (i = 0; i < pRebal->numTenants; i++)
+        {
+            pTenant = &pRebal->tenants[i];
+            pTenant->pir = SLA_REBAL_MIN(pTenant->pir, pRebal->capacity);
+            pTenant->localNode.sla.cir = pTenant->cir;
+            pTenant->localNode.sla.pir = pTenant->pir;
+            pTenant->localNode.sla.nodetype = ADF_NODE_LEAF;
+            pTenant->localNode.sla.svc_type = pRebal->svcType;
+            pTenant->localNode.nodetype = ADF_NODE_LEAF;
+            pTenant->localNode.svc_type = pRebal->svcType;
+            pTenant->localNode.sla_added = true;
+            rl_v2_attach_node(&pRebal->localRoot,
+                              &pTenant->localNode,
+                              &pTenant->localNode.sla);
+        }
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Read the bandwidth of a telemetry file
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalReadSysfs(sla_rebal_tenant_t *pTenant,
+                                   Cpa64U *pMbps)
+{
+    char line[SLA_REBAL_LINE_SIZE] = { 0 };
+    char key[SLA_REBAL_LINE_SIZE] = { 0 };
+    unsigned long long value = 0;
+    CpaStatus status = CPA_STATUS_FAIL;
+    FILE *pFile = NULL;
+
+    pFile = fopen(pTenant->demandPath, "r");
+    if (NULL == pFile)
+    {
+        SLA_MGR_LOG_ERROR("Cannot open %s\n", pTenant->demandPath);
+        return CPA_STATUS_FAIL;
+    }
+    while (fgets(line, sizeof(line), pFile))
+    {
+        if (2 == sscanf(line, "%511s %llu", key, &value) &&
+            !strcmp(key, SLA_REBAL_TL_DEMAND_KEY))
+        {
+            *pMbps = value;
+            status = CPA_STATUS_SUCCESS;
+            break;
+        }
+    }
+    fclose(pFile);
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        SLA_MGR_LOG_ERROR("No %s in %s, is telemetry on?\n",
+                          SLA_REBAL_TL_DEMAND_KEY,
+                          pTenant->demandPath);
+    }
+    return status;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Replay one interval of a trace
+ *
+ * @description
+ *        The trace restarts from the beginning when it ends so that
+ *        a daemon can run on it indefinitely. A stop request ends
+ *        the replay early.
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalReadTrace(sla_rebal_t *pRebal,
+                                   sla_rebal_tenant_t *pTenant,
+                                   Cpa64U *pMbps)
+{
+    Cpa64U endUs = 0;
+    Cpa64U bytes = 0;
+    unsigned int workSize = 0;
+    unsigned int intervalUs = 0;
+    CpaBoolean rewound = CPA_FALSE;
+
+    endUs = pTenant->traceNowUs +
+            (Cpa64U)pRebal->intervalMs * SLA_REBAL_USEC_PER_MSEC;
+    while (!slaRebalStop && pTenant->nextArrivalUs < endUs)
+    {
+        bytes += pTenant->nextBytes;
+        pTenant->nextBytes = 0;
+        if (2 != fscanf(pTenant->pTrace, "%u %u", &workSize, &intervalUs))
+        {
+            if (rewound)
+            {
+                SLA_MGR_LOG_ERROR("No request in %s\n", pTenant->demandPath);
+                return CPA_STATUS_FAIL;
+            }
+            rewind(pTenant->pTrace);
+            rewound = CPA_TRUE;
+            continue;
+        }
+        rewound = CPA_FALSE;
+        pTenant->nextArrivalUs += intervalUs;
+        pTenant->nextBytes = (Cpa64U)workSize * pRebal->bytesPerUnit;
+    }
+    pTenant->traceNowUs = endUs;
+
+    *pMbps = bytes * CHAR_BIT * SLA_REBAL_USEC_PER_SEC /
+             ((Cpa64U)pRebal->intervalMs * SLA_REBAL_USEC_PER_MSEC *
+              SLA_REBAL_BITS_PER_MBIT);
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Sample the demand of every tenant
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalSampleDemand(sla_rebal_t *pRebal, CpaBoolean first)
+{
+    sla_rebal_tenant_t *pTenant = NULL;
+    Cpa64U mbps = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        pTenant = &pRebal->tenants[i];
+        if (SLA_REBAL_DEMAND_SYSFS == pTenant->demandType)
+        {
+            status = slaRebalReadSysfs(pTenant, &mbps);
+        }
+        else
+        {
+            status = slaRebalReadTrace(pRebal, pTenant, &mbps);
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+        mbps = SLA_REBAL_MIN(mbps, (Cpa64U)UINT32_MAX);
+
+        /* Exponential moving average, the first sample seeds it */
+        if (first)
+        {
+            pTenant->demand = mbps;
+        }
+        else
+        {
+            pTenant->demand =
+                (mbps * pRebal->smoothing +
+                 (Cpa64U)pTenant->demand *
+                     (SLA_REBAL_PERCENT - pRebal->smoothing)) /
+                SLA_REBAL_PERCENT;
+        }
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Compute the SLAs of the interval
+ *
+ * @description
+ *        Every tenant gets its floor. The rest of the capacity is
+ *        filled level by level: each tenant that still wants more
+ *        gets an equal share until its demand plus headroom, capped
+ *        by its max PIR, is met or the capacity runs out. The PIR
+ *        lets a tenant burst into what is left unallocated.
+ *
+ ******************************************************************
+ */
+static void slaRebalComputeTargets(sla_rebal_t *pRebal)
+{
+    sla_rebal_tenant_t *pTenant = NULL;
+    Cpa32U want[SLA_REBAL_MAX_TENANTS] = { 0 };
+    Cpa64U need = 0;
+    Cpa32U left = pRebal->capacity;
+    Cpa32U numWanting = 0;
+    Cpa32U share = 0;
+    Cpa32U grant = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        pTenant = &pRebal->tenants[i];
+        need = (Cpa64U)pTenant->demand *
+               (SLA_REBAL_PERCENT + pRebal->headroom) / SLA_REBAL_PERCENT;
+        need = SLA_REBAL_MIN(need, (Cpa64U)pTenant->maxPir);
+        need = SLA_REBAL_MAX(need, (Cpa64U)pTenant->floorCir);
+        pTenant->targetCir = pTenant->floorCir;
+        want[i] = need - pTenant->floorCir;
+        left -= pTenant->floorCir;
+        if (want[i])
+        {
+            numWanting++;
+        }
+    }
+
+    while (left && numWanting)
+    {
+        share = SLA_REBAL_MAX(left / numWanting, 1);
+        for (i = 0; i < pRebal->numTenants && left; i++)
+        {
+            if (0 == want[i])
+            {
+                continue;
+            }
+            grant = SLA_REBAL_MIN(SLA_REBAL_MIN(share, want[i]), left);
+            pRebal->tenants[i].targetCir += grant;
+            want[i] -= grant;
+            left -= grant;
+            if (0 == want[i])
+            {
+                numWanting--;
+            }
+        }
+    }
+
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        pTenant = &pRebal->tenants[i];
+        pTenant->targetPir =
+            SLA_REBAL_MIN(pTenant->maxPir, pTenant->targetCir + left);
+    }
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Update an SLA in the local stand-in
+ *
+ * @description
+ *        The leaf gives its CIR back to its parent and takes the new
+ *        one if the parent budget allows it, as on SLA creation.
+ *
+ ******************************************************************
+ */
+static CpaStatus slaRebalLocalUpdate(sla_rebal_t *pRebal,
+                                     sla_rebal_tenant_t *pTenant,
+                                     Cpa32U cir,
+                                     Cpa32U pir)
+{
+    struct rl_node_info *pRoot = &pRebal->localRoot;
+    struct adf_user_sla sla = pTenant->localNode.sla;
+
+    sla.cir = cir;
+    sla.pir = pir;
+    rl_v2_fix_pir_to_cir(&sla);
+
+    pRoot->rem_cir += pTenant->localNode.sla.cir;
+    if (!rl_v2_enough_sla_budget(pRoot, &sla))
+    {
+        pRoot->rem_cir -= pTenant->localNode.sla.cir;
+        return CPA_STATUS_FAIL;
+    }
+    pRoot->rem_cir -= sla.cir;
+    pTenant->localNode.sla = sla;
+    pTenant->localNode.max_pir = sla.pir;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Apply the SLA of one tenant
+ *
+ ******************************************************************
+ */
+static void slaRebalSetSla(sla_rebal_t *pRebal,
+                           sla_rebal_tenant_t *pTenant,
+                           Cpa32U iteration)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    SLA_MGR_LOG_USER("[%u] %ssla_id=%d demand=%u cir %u->%u pir %u->%u\n",
+                     iteration,
+                     pRebal->dryRun ? "(dry run) " : "",
+                     pTenant->slaId,
+                     pTenant->demand,
+                     pTenant->cir,
+                     pTenant->targetCir,
+                     pTenant->pir,
+                     pTenant->targetPir);
+    if (!pRebal->dryRun)
+    {
+        if (SLA_REBAL_BACKEND_DEVICE == pRebal->backend)
+        {
+            status = icp_sal_userSlaUpdateIR(&pRebal->pciAddr,
+                                             pTenant->slaId,
+                                             pTenant->targetCir,
+                                             pTenant->targetPir);
+        }
+        else
+        {
+            status = slaRebalLocalUpdate(pRebal,
+                                         pTenant,
+                                         pTenant->targetCir,
+                                         pTenant->targetPir);
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            SLA_MGR_LOG_ERROR("Failed to update SLA: node_id=%d cir=%d "
+                              "pir=%d\n",
+                              pTenant->slaId,
+                              pTenant->targetCir,
+                              pTenant->targetPir);
+            return;
+        }
+    }
+    /* A dry run follows its own plan */
+    pTenant->cir = pTenant->targetCir;
+    pTenant->pir = pTenant->targetPir;
+    pRebal->numUpdates++;
+}
+
+/*
+ ******************************************************************
+ * @ingroup sla
+ *        Apply the SLAs of the interval
+ *
+ * @description
+ *        CIR changes within the hysteresis are held back, unless
+ *        holding back decreases would overcommit the capacity. All
+ *        decreases go first so that increases find the budget free.
+ *
+ ******************************************************************
+ */
+static void slaRebalApply(sla_rebal_t *pRebal, Cpa32U iteration)
+{
+    sla_rebal_tenant_t *pTenant = NULL;
+    CpaBoolean change[SLA_REBAL_MAX_TENANTS] = { CPA_FALSE };
+    Cpa64U delta = 0;
+    Cpa64U total = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        pTenant = &pRebal->tenants[i];
+        delta = (pTenant->targetCir > pTenant->cir)
+                    ? pTenant->targetCir - pTenant->cir
+                    : pTenant->cir - pTenant->targetCir;
+        change[i] = (pTenant->cir < pTenant->floorCir ||
+                     pTenant->pir > pTenant->maxPir ||
+                     delta * SLA_REBAL_PERCENT >
+                         (Cpa64U)pTenant->cir * pRebal->hysteresis)
+                        ? CPA_TRUE
+                        : CPA_FALSE;
+        if (0 == delta && pTenant->pir == pTenant->targetPir)
+        {
+            change[i] = CPA_FALSE;
+        }
+        else if (!change[i])
+        {
+            pRebal->numHeld++;
+        }
+        total += change[i] ? pTenant->targetCir : pTenant->cir;
+    }
+    if (total > pRebal->capacity)
+    {
+        for (i = 0; i < pRebal->numTenants; i++)
+        {
+            if (pRebal->tenants[i].targetCir < pRebal->tenants[i].cir)
+            {
+                change[i] = CPA_TRUE;
+            }
+        }
+    }
+
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        pTenant = &pRebal->tenants[i];
+        if (change[i] && pTenant->targetCir <= pTenant->cir)
+        {
+            slaRebalSetSla(pRebal, pTenant, iteration);
+        }
+    }
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        pTenant = &pRebal->tenants[i];
+        if (change[i] && pTenant->targetCir > pTenant->cir)
+        {
+            slaRebalSetSla(pRebal, pTenant, iteration);
+        }
+    }
+}
+
+static void slaRebalFree(sla_rebal_t *pRebal)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        if (pRebal->tenants[i].pTrace)
+        {
+            fclose(pRebal->tenants[i].pTrace);
+            pRebal->tenants[i].pTrace = NULL;
+        }
+    }
+}
+
+CpaStatus slaMgrRebalance(struct sla_mgr_args *pUsrArgs)
+{
+    sla_rebal_t *pRebal = NULL;
+    Cpa32U iteration = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pRebal = calloc(1, sizeof(sla_rebal_t));
+    if (NULL == pRebal)
+    {
+        SLA_MGR_LOG_ERROR("Failed to allocate rebalancer\n");
+        return CPA_STATUS_RESOURCE;
+    }
+    rlCopyPciAddr(&pRebal->pciAddr, &pUsrArgs->pciAddr);
+    pRebal->svcType = ADF_SVC_DC;
+    pRebal->realtime = CPA_TRUE;
+    pRebal->intervalMs = SLA_REBAL_DEFAULT_INTERVAL_MS;
+    pRebal->hysteresis = SLA_REBAL_DEFAULT_HYSTERESIS;
+    pRebal->headroom = SLA_REBAL_DEFAULT_HEADROOM;
+    pRebal->smoothing = SLA_REBAL_DEFAULT_SMOOTHING;
+    pRebal->bytesPerUnit = SLA_REBAL_DEFAULT_BYTES_PER_UNIT;
+
+    status = slaRebalReadPolicy(pRebal, (const char *)pUsrArgs->pPolicy);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = slaRebalInitSlas(pRebal);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        slaRebalFree(pRebal);
+        free(pRebal);
+        return CPA_STATUS_FAIL;
+    }
+
+    SLA_MGR_LOG_USER("Rebalancing %u %s SLAs within %u on %s backend%s\n",
+                     pRebal->numTenants,
+                     rlSvcToStr(pRebal->svcType),
+                     pRebal->capacity,
+                     SLA_REBAL_BACKEND_DEVICE == pRebal->backend ? "device"
+                                                                 : "local",
+                     pRebal->dryRun ? ", dry run" : "");
+
+    slaRebalStop = 0;
+    signal(SIGINT, slaRebalSigHandler);
+    signal(SIGTERM, slaRebalSigHandler);
+
+    while (!slaRebalStop &&
+           (0 == pRebal->iterations || iteration < pRebal->iterations))
+    {
+        status = slaRebalSampleDemand(pRebal, 0 == iteration);
+        if (CPA_STATUS_SUCCESS != status || slaRebalStop)
+        {
+            break;
+        }
+        slaRebalComputeTargets(pRebal);
+        slaRebalApply(pRebal, iteration);
+        iteration++;
+        if (pRebal->realtime)
+        {
+            osalSleep(pRebal->intervalMs);
+        }
+    }
+
+    SLA_MGR_LOG_USER("%u intervals, %llu SLA updates, %llu held back\n",
+                     iteration,
+                     (unsigned long long)pRebal->numUpdates,
+                     (unsigned long long)pRebal->numHeld);
+    for (i = 0; i < pRebal->numTenants; i++)
+    {
+        SLA_MGR_LOG_USER("sla_id=%d cir=%u pir=%u\n",
+                         pRebal->tenants[i].slaId,
+                         pRebal->tenants[i].cir,
+                         pRebal->tenants[i].pir);
+    }
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    slaRebalFree(pRebal);
+    free(pRebal);
+
+    return status;
+}
+#endif
@@ -0,0 +1,735 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "tl_collector.h"
+#include "icp_sal_tl.h"
+
+#define TL_COL_MSEC_PER_SEC 1000ULL
+#define TL_COL_NSEC_PER_MSEC 1000000ULL
+#define TL_COL_PERCENT 100ULL
+
+typedef Cpa32S (*tl_col_lookup_t)(const char *pKey);
+
+/* Keys of device_data, in tl_col_dev_field_t order */
+static const char *tlColDevKeys[TL_COL_DEV_NUM_COUNTERS] = {
+    "sample_cnt",
+    "pci_trans_cnt",
+    "max_rd_lat",
+    "rd_lat_acc_avg",
+    "max_lat",
+    "lat_acc_avg",
+    "bw_in",
+    "bw_out",
+    "at_page_req_lat_acc_avg",
+    "at_trans_lat_acc_avg",
+    "at_max_tlb_used"
+};
+
+/* Slice names, in tl_col_slice_t order */
+static const char *tlColSliceNames[TL_COL_SLICE_TYPES] = {
+    "cpr", "dcpr", "xlt", "cph", "ath", "ucs", "pke", "wat", "wcp"
+};
+#define TL_COL_SLICE_PREFIX "util_"
+
+/* Keys of rp_<X>_data, in tl_col_rp_field_t order */
+static const char *tlColRpKeys[TL_COL_RP_NUM_FIELDS] = {
+    "sample_cnt",
+    "rp_num",
+    "pci_trans_cnt",
+    "lat_acc_avg",
+    "bw_in",
+    "bw_out",
+    "at_glob_devtlb_hit",
+    "at_glob_devtlb_miss",
+    "tl_at_payld_devtlb_hit",
+    "tl_at_payld_devtlb_miss"
+};
+
+static Cpa32S tlColLookupDev(const char *pKey)
+{
+    const char *pType = NULL;
+    size_t len = 0;
+    Cpa32U slice = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < TL_COL_DEV_NUM_COUNTERS; i++)
+    {
+        if (!strcmp(pKey, tlColDevKeys[i]))
+        {
+            return i;
+        }
+    }
+
+    /* util_<type><slice> */
+    if (strncmp(pKey, TL_COL_SLICE_PREFIX, strlen(TL_COL_SLICE_PREFIX)))
+    {
+        return -1;
+    }
+    pType = pKey + strlen(TL_COL_SLICE_PREFIX);
+    for (i = 0; i < TL_COL_SLICE_TYPES; i++)
+    {
+        len = strlen(tlColSliceNames[i]);
+        if (!strncmp(pType, tlColSliceNames[i], len) &&
+            isdigit((unsigned char)pType[len]))
+        {
+            slice = strtoul(pType + len, NULL, 10);
+            if (slice < TL_COL_MAX_SLICES)
+            {
+                return TL_COL_DEV_SLICE_FIELD(i, slice);
+            }
+        }
+    }
+    return -1;
+}
+
+static Cpa32S tlColLookupRp(const char *pKey)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < TL_COL_RP_NUM_FIELDS; i++)
+    {
+        if (!strcmp(pKey, tlColRpKeys[i]))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Parse the "<key> <value>" lines of an attribute
+ *
+ * @description
+ *        The attributes print the same keys in the same order on
+ *        every read, so the field of each line is learnt once and
+ *        later reads only check the key in place before converting
+ *        the value. A line that does not match is looked up again.
+ *
+ ******************************************************************
+ */
+static void tlColParse(tl_col_file_t *pFile,
+                       tl_col_lookup_t lookup,
+                       Cpa64U *pValues,
+                       CpaBoolean *pSeen)
+{
+    tl_col_line_t *pLine = NULL;
+    char *p = pFile->buf;
+    char *pEnd = pFile->buf + pFile->len;
+    char *pEol = NULL;
+    char *pSpace = NULL;
+    Cpa32U i = 0;
+
+    for (i = 0; p < pEnd && i < TL_COL_MAX_LINES; i++, p = pEol + 1)
+    {
+        pEol = memchr(p, '\n', pEnd - p);
+        if (NULL == pEol)
+        {
+            pEol = pEnd;
+        }
+        pLine = &pFile->lines[i];
+
+        if (i >= pFile->numLines || 0 == pLine->keyLen ||
+            pLine->keyLen >= pEol - p || ' ' != p[pLine->keyLen] ||
+            memcmp(p, pLine->key, pLine->keyLen))
+        {
+            pSpace = memchr(p, ' ', pEol - p);
+            if (NULL == pSpace || pSpace == p ||
+                pSpace - p >= TL_COL_MAX_KEY)
+            {
+                pLine->keyLen = 0;
+                pLine->field = -1;
+                continue;
+            }
+            pLine->keyLen = pSpace - p;
+            memcpy(pLine->key, p, pLine->keyLen);
+            pLine->key[pLine->keyLen] = '\0';
+            pLine->field = lookup(pLine->key);
+        }
+        if (pLine->field >= 0)
+        {
+            pValues[pLine->field] =
+                strtoull(p + pLine->keyLen + 1, NULL, 10);
+            if (pSeen)
+            {
+                pSeen[pLine->field] = CPA_TRUE;
+            }
+        }
+    }
+    pFile->numLines = i;
+}
+
+static void tlColPush(tl_col_series_t *pSeries, Cpa64U value, Cpa32U window)
+{
+    if (pSeries->count == window)
+    {
+        pSeries->sum -= pSeries->values[pSeries->head];
+    }
+    else
+    {
+        pSeries->count++;
+    }
+    pSeries->values[pSeries->head] = value;
+    pSeries->sum += value;
+    pSeries->head = (pSeries->head + 1) % window;
+}
+
+static Cpa64U tlColAvg(const tl_col_series_t *pSeries)
+{
+    return pSeries->count ? pSeries->sum / pSeries->count : 0;
+}
+
+static Cpa64U tlColMax(const tl_col_series_t *pSeries)
+{
+    Cpa64U max = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pSeries->count; i++)
+    {
+        if (pSeries->values[i] > max)
+        {
+            max = pSeries->values[i];
+        }
+    }
+    return max;
+}
+
+static Cpa64U tlColNowMs(void)
+{
+    struct timespec ts = { 0 };
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * TL_COL_MSEC_PER_SEC + ts.tv_nsec / TL_COL_NSEC_PER_MSEC;
+}
+
+static CpaStatus tlColOpenFile(tl_col_t *pCol,
+                               tl_col_file_t *pFile,
+                               Cpa32S ringPair)
+{
+    char path[FILENAME_MAX] = { 0 };
+    int fd = -1;
+
+    if (snprintf(path, sizeof(path), "%s/%s", pCol->sysfsDir, pFile->name) >=
+        (int)sizeof(path))
+    {
+        TL_COL_LOG_ERROR("Path of %s too long\n", pFile->name);
+        return CPA_STATUS_FAIL;
+    }
+    if (ringPair >= 0)
+    {
+        fd = open(path, O_WRONLY);
+        if (fd < 0 || dprintf(fd, "%d", ringPair) < 0)
+        {
+            TL_COL_LOG_ERROR("Cannot select ring pair %d in %s\n",
+                             ringPair,
+                             path);
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            return CPA_STATUS_FAIL;
+        }
+        close(fd);
+    }
+
+    pFile->fd = open(path, O_RDONLY);
+    if (pFile->fd < 0)
+    {
+        TL_COL_LOG_ERROR("Cannot open %s\n", path);
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus tlColOpen(tl_col_t *pCol)
+{
+    Cpa32U i = 0;
+
+    snprintf(pCol->device.name, TL_COL_MAX_KEY, TL_COL_DEVICE_FILE);
+    pCol->device.fd = -1;
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        snprintf(pCol->rps[i].file.name, TL_COL_MAX_KEY, TL_COL_RP_FILE,
+                 'A' + i);
+        pCol->rps[i].file.fd = -1;
+    }
+    if (pCol->pReplay)
+    {
+        return CPA_STATUS_SUCCESS;
+    }
+
+    snprintf(pCol->sysfsDir,
+             sizeof(pCol->sysfsDir),
+             TL_COL_SYSFS_DIR,
+             pCol->pciAddr.domain_nr,
+             pCol->pciAddr.bus,
+             pCol->pciAddr.domain_nr,
+             pCol->pciAddr.bus,
+             pCol->pciAddr.dev,
+             pCol->pciAddr.func);
+
+    if (pCol->startTelemetry &&
+        CPA_STATUS_SUCCESS != icp_sal_dev_telemetry_start(&pCol->pciAddr))
+    {
+        TL_COL_LOG_ERROR("Failed to start telemetry\n");
+        return CPA_STATUS_FAIL;
+    }
+    if (CPA_STATUS_SUCCESS != tlColOpenFile(pCol, &pCol->device, -1))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            tlColOpenFile(pCol, &pCol->rps[i].file, pCol->rps[i].ringPair))
+        {
+            return CPA_STATUS_FAIL;
+        }
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static void tlColReadFile(tl_col_file_t *pFile)
+{
+    ssize_t len = 0;
+
+    pFile->len = 0;
+    if (pFile->fd < 0)
+    {
+        return;
+    }
+    /* Each read from offset 0 makes sysfs render the attribute again */
+    len = pread(pFile->fd, pFile->buf, TL_COL_BUF_SIZE - 1, 0);
+    if (len > 0)
+    {
+        pFile->len = len;
+    }
+    pFile->buf[pFile->len] = '\0';
+}
+
+static tl_col_file_t *tlColFindFile(tl_col_t *pCol, const char *pName)
+{
+    Cpa32U i = 0;
+
+    if (!strcmp(pName, pCol->device.name))
+    {
+        return &pCol->device;
+    }
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        if (!strcmp(pName, pCol->rps[i].file.name))
+        {
+            return &pCol->rps[i].file;
+        }
+    }
+    return NULL;
+}
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Read the next sample of the recording
+ *
+ ******************************************************************
+ */
+static CpaStatus tlColReadReplay(tl_col_t *pCol)
+{
+    char name[TL_COL_MAX_KEY] = { 0 };
+    unsigned long long seq = 0;
+    unsigned long long timeMs = 0;
+    tl_col_file_t *pFile = NULL;
+    size_t len = 0;
+    Cpa32U i = 0;
+
+    /* Skip up to the next sample */
+    while (strncmp(pCol->replayLine,
+                   TL_COL_REC_SAMPLE,
+                   strlen(TL_COL_REC_SAMPLE)))
+    {
+        if (NULL ==
+            fgets(pCol->replayLine, TL_COL_LINE_SIZE, pCol->pReplay))
+        {
+            pCol->done = CPA_TRUE;
+            return CPA_STATUS_FAIL;
+        }
+    }
+    if (2 != sscanf(pCol->replayLine,
+                    TL_COL_REC_SAMPLE " %llu %llu",
+                    &seq,
+                    &timeMs))
+    {
+        TL_COL_LOG_ERROR("Bad sample line: %s", pCol->replayLine);
+        pCol->done = CPA_TRUE;
+        return CPA_STATUS_FAIL;
+    }
+    pCol->sampleTimeMs = timeMs;
+
+    pCol->device.len = 0;
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        pCol->rps[i].file.len = 0;
+    }
+    pCol->replayLine[0] = '\0';
+    while (fgets(pCol->replayLine, TL_COL_LINE_SIZE, pCol->pReplay))
+    {
+        if (!strncmp(pCol->replayLine,
+                     TL_COL_REC_SAMPLE,
+                     strlen(TL_COL_REC_SAMPLE)))
+        {
+            return CPA_STATUS_SUCCESS;
+        }
+        if (1 == sscanf(pCol->replayLine, TL_COL_REC_FILE " %31s", name))
+        {
+            pFile = tlColFindFile(pCol, name);
+            continue;
+        }
+        len = strlen(pCol->replayLine);
+        if (pFile && pFile->len + len < TL_COL_BUF_SIZE)
+        {
+            memcpy(pFile->buf + pFile->len, pCol->replayLine, len + 1);
+            pFile->len += len;
+        }
+    }
+    pCol->replayLine[0] = '\0';
+    return CPA_STATUS_SUCCESS;
+}
+
+static void tlColRecordFile(tl_col_t *pCol, tl_col_file_t *pFile)
+{
+    if (0 == pFile->len)
+    {
+        return;
+    }
+    fprintf(pCol->pRecord, TL_COL_REC_FILE " %s\n", pFile->name);
+    fwrite(pFile->buf, 1, pFile->len, pCol->pRecord);
+    if ('\n' != pFile->buf[pFile->len - 1])
+    {
+        fputc('\n', pCol->pRecord);
+    }
+}
+
+CpaStatus tlColSample(tl_col_t *pCol)
+{
+    tl_col_rp_t *pRp = NULL;
+    Cpa64U ringPair = 0;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (pCol->pReplay)
+    {
+        status = tlColReadReplay(pCol);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        pCol->sampleTimeMs = tlColNowMs();
+        tlColReadFile(&pCol->device);
+        for (i = 0; i < TL_COL_MAX_RP; i++)
+        {
+            tlColReadFile(&pCol->rps[i].file);
+        }
+    }
+
+    if (pCol->pRecord)
+    {
+        fprintf(pCol->pRecord,
+                TL_COL_REC_SAMPLE " %llu %llu\n",
+                (unsigned long long)(pCol->numSamples + pCol->numStale),
+                (unsigned long long)pCol->sampleTimeMs);
+        tlColRecordFile(pCol, &pCol->device);
+        for (i = 0; i < TL_COL_MAX_RP; i++)
+        {
+            tlColRecordFile(pCol, &pCol->rps[i].file);
+        }
+    }
+
+    pCol->devSeen[TL_COL_DEV_SAMPLE_CNT] = CPA_FALSE;
+    tlColParse(&pCol->device, tlColLookupDev, pCol->devValues, pCol->devSeen);
+    if (!pCol->devSeen[TL_COL_DEV_SAMPLE_CNT])
+    {
+        TL_COL_LOG_ERROR("No telemetry sample, is telemetry on?\n");
+        return CPA_STATUS_FAIL;
+    }
+    /* Telemetry refreshes slower than it may be read */
+    if (pCol->numSamples &&
+        pCol->devValues[TL_COL_DEV_SAMPLE_CNT] == pCol->lastSampleCnt)
+    {
+        pCol->numStale++;
+        return CPA_STATUS_RETRY;
+    }
+    pCol->lastSampleCnt = pCol->devValues[TL_COL_DEV_SAMPLE_CNT];
+
+    for (i = 0; i < TL_COL_DEV_NUM_FIELDS; i++)
+    {
+        if (pCol->devSeen[i])
+        {
+            tlColPush(&pCol->devSeries[i], pCol->devValues[i], pCol->window);
+        }
+    }
+
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        pRp = &pCol->rps[i];
+        pRp->active = CPA_FALSE;
+        if (0 == pRp->file.len)
+        {
+            continue;
+        }
+        ringPair = pRp->values[TL_COL_RP_NUM];
+        pRp->values[TL_COL_RP_NUM] = ~0ULL;
+        tlColParse(&pRp->file, tlColLookupRp, pRp->values, NULL);
+        if (~0ULL == pRp->values[TL_COL_RP_NUM])
+        {
+            continue;
+        }
+        /* Another ring pair was selected, restart its series */
+        if (pRp->series[TL_COL_RP_NUM].count &&
+            ringPair != pRp->values[TL_COL_RP_NUM])
+        {
+            memset(pRp->series, 0, sizeof(pRp->series));
+            pRp->hot = CPA_FALSE;
+        }
+        for (j = 0; j < TL_COL_RP_NUM_FIELDS; j++)
+        {
+            tlColPush(&pRp->series[j], pRp->values[j], pCol->window);
+        }
+        pRp->active = CPA_TRUE;
+    }
+
+    pCol->numSamples++;
+    return CPA_STATUS_SUCCESS;
+}
+
+void tlColDetect(tl_col_t *pCol)
+{
+    tl_col_rp_t *pRp = NULL;
+    Cpa64U util = 0;
+    Cpa64U devBw = tlColAvg(&pCol->devSeries[TL_COL_DEV_BW_IN]);
+    Cpa64U share = 0;
+    Cpa32U field = 0;
+    Cpa32U type = 0;
+    Cpa32U slice = 0;
+    Cpa32U i = 0;
+    CpaBoolean anySaturated = CPA_FALSE;
+    CpaBoolean state = CPA_FALSE;
+
+    for (type = 0; type < TL_COL_SLICE_TYPES; type++)
+    {
+        for (slice = 0; slice < TL_COL_MAX_SLICES; slice++)
+        {
+            field = TL_COL_DEV_SLICE_FIELD(type, slice);
+            if (!pCol->devSeen[field])
+            {
+                continue;
+            }
+            util = tlColAvg(&pCol->devSeries[field]);
+            state = (util >= pCol->utilThreshold) ? CPA_TRUE : CPA_FALSE;
+            if (state != pCol->saturated[type][slice])
+            {
+                TL_COL_LOG_USER("[%llu] slice %s%u %s: avg util %llu%%\n",
+                                (unsigned long long)pCol->numSamples,
+                                tlColSliceNames[type],
+                                slice,
+                                state ? "saturated" : "cleared",
+                                (unsigned long long)util);
+                pCol->saturated[type][slice] = state;
+            }
+            if (state)
+            {
+                anySaturated = CPA_TRUE;
+            }
+        }
+    }
+
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        pRp = &pCol->rps[i];
+        if (!pRp->active)
+        {
+            continue;
+        }
+        share = devBw ? tlColAvg(&pRp->series[TL_COL_RP_BW_IN]) *
+                            TL_COL_PERCENT / devBw
+                      : 0;
+        state = (anySaturated && share >= pCol->hotShare) ? CPA_TRUE
+                                                          : CPA_FALSE;
+        if (state != pRp->hot)
+        {
+            TL_COL_LOG_USER(
+                "[%llu] ring pair %llu %s: %llu%% of device bw_in, "
+                "lat %llu ns (device %llu ns)\n",
+                (unsigned long long)pCol->numSamples,
+                (unsigned long long)pRp->values[TL_COL_RP_NUM],
+                state ? "hot" : "cleared",
+                (unsigned long long)share,
+                (unsigned long long)tlColAvg(&pRp->series[TL_COL_RP_LAT_AVG]),
+                (unsigned long long)tlColAvg(
+                    &pCol->devSeries[TL_COL_DEV_LAT_AVG]));
+            pRp->hot = state;
+        }
+    }
+}
+
+void tlColReport(tl_col_t *pCol)
+{
+    tl_col_rp_t *pRp = NULL;
+    Cpa64U util = 0;
+    Cpa64U maxUtil = 0;
+    Cpa32U field = 0;
+    Cpa32U type = 0;
+    Cpa32U slice = 0;
+    Cpa32U i = 0;
+    CpaBoolean seen = CPA_FALSE;
+
+    TL_COL_LOG_USER(
+        "[%llu] bw_in=%llu bw_out=%llu Mbps lat=%llu ns max_lat=%llu ns",
+        (unsigned long long)pCol->numSamples,
+        (unsigned long long)tlColAvg(&pCol->devSeries[TL_COL_DEV_BW_IN]),
+        (unsigned long long)tlColAvg(&pCol->devSeries[TL_COL_DEV_BW_OUT]),
+        (unsigned long long)tlColAvg(&pCol->devSeries[TL_COL_DEV_LAT_AVG]),
+        (unsigned long long)tlColMax(&pCol->devSeries[TL_COL_DEV_MAX_LAT]));
+
+    /* Busiest slice of each type */
+    for (type = 0; type < TL_COL_SLICE_TYPES; type++)
+    {
+        seen = CPA_FALSE;
+        maxUtil = 0;
+        for (slice = 0; slice < TL_COL_MAX_SLICES; slice++)
+        {
+            field = TL_COL_DEV_SLICE_FIELD(type, slice);
+            if (pCol->devSeen[field])
+            {
+                seen = CPA_TRUE;
+                util = tlColAvg(&pCol->devSeries[field]);
+                maxUtil = (util > maxUtil) ? util : maxUtil;
+            }
+        }
+        if (seen)
+        {
+            TL_COL_LOG_USER(" %s=%llu%%",
+                            tlColSliceNames[type],
+                            (unsigned long long)maxUtil);
+        }
+    }
+    TL_COL_LOG_USER("\n");
+
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        pRp = &pCol->rps[i];
+        if (!pRp->active)
+        {
+            continue;
+        }
+        TL_COL_LOG_USER(
+            "\trp %llu: bw_in=%llu bw_out=%llu Mbps lat=%llu ns%s\n",
+            (unsigned long long)pRp->values[TL_COL_RP_NUM],
+            (unsigned long long)tlColAvg(&pRp->series[TL_COL_RP_BW_IN]),
+            (unsigned long long)tlColAvg(&pRp->series[TL_COL_RP_BW_OUT]),
+            (unsigned long long)tlColAvg(&pRp->series[TL_COL_RP_LAT_AVG]),
+            pRp->hot ? " HOT" : "");
+    }
+}
+
+void tlColClose(tl_col_t *pCol)
+{
+    Cpa32U i = 0;
+
+    if (pCol->device.fd >= 0)
+    {
+        close(pCol->device.fd);
+        pCol->device.fd = -1;
+    }
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        if (pCol->rps[i].file.fd >= 0)
+        {
+            close(pCol->rps[i].file.fd);
+            pCol->rps[i].file.fd = -1;
+        }
+    }
+    if (pCol->startTelemetry && NULL == pCol->pReplay)
+    {
+        icp_sal_dev_telemetry_stop(&pCol->pciAddr);
+    }
+}
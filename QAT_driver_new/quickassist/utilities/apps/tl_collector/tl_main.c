@@ -0,0 +1,300 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ *
+ ****************************************************************************/
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "tl_collector.h"
+
+static volatile sig_atomic_t tlColStop = 0;
+
+static void tlColSigHandler(int sig)
+{
+    tlColStop = 1;
+}
+
+/*
+ ******************************************************************
+ * @ingroup tl
+ *        Display command line argument help string.
+ *
+ * @param[in]  pExe  pointer to name of executable file
+ *
+ * @retval None
+ *
+ ******************************************************************
+ */
+static void tlColPrintHelp(const char *pExe)
+{
+    TL_COL_LOG_USER(
+        "\ntl_collector samples the device telemetry and flags saturated\n"
+        "slices and hot ring pairs.\n"
+        "\nUsage:\n"
+        "\t%s [options] <pf_addr>\n"
+        "\t%s [options] -R <recording>\n"
+        "\nOptions:\n"
+        "\t-i <ms>      sampling interval (default %d)\n"
+        "\t-n <count>   samples to take, 0 until interrupted (default 0)\n"
+        "\t-w <count>   samples in the rolling windows (default %d, max %d)\n"
+        "\t-t <pct>     average slice utilisation flagged as saturated\n"
+        "\t             (default %d)\n"
+        "\t-H <pct>     share of the device bw_in flagging a ring pair as\n"
+        "\t             hot while a slice is saturated (default %d)\n"
+        "\t-p <rp,..>   ring pairs to select in rp_A_data to rp_D_data\n"
+        "\t-s           start telemetry, and stop it on exit\n"
+        "\t-o <file>    record the samples to replay them later\n"
+        "\t-R <file>    replay a recording instead of reading the device\n"
+        "\t-q           only print the flagged conditions\n",
+        pExe,
+        pExe,
+        TL_COL_DEFAULT_INTERVAL_MS,
+        TL_COL_DEFAULT_WINDOW,
+        TL_COL_MAX_WINDOW,
+        TL_COL_DEFAULT_UTIL_THRESHOLD,
+        TL_COL_DEFAULT_HOT_SHARE);
+}
+
+static CpaStatus tlColParseRingPairs(tl_col_t *pCol, char *pList)
+{
+    char *pSave = NULL;
+    char *pToken = NULL;
+    Cpa32U i = 0;
+
+    for (pToken = strtok_r(pList, ",", &pSave); pToken;
+         pToken = strtok_r(NULL, ",", &pSave))
+    {
+        if (TL_COL_MAX_RP == i)
+        {
+            TL_COL_LOG_ERROR("At most %d ring pairs at a time\n",
+                             TL_COL_MAX_RP);
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        pCol->rps[i++].ringPair = strtol(pToken, NULL, 0);
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    tl_col_t *pCol = NULL;
+    Cpa32U numSamples = 0;
+    Cpa32U i = 0;
+    CpaBoolean quiet = CPA_FALSE;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    int opt = 0;
+
+    pCol = calloc(1, sizeof(tl_col_t));
+    if (NULL == pCol)
+    {
+        TL_COL_LOG_ERROR("Failed to allocate collector\n");
+        return -1;
+    }
+    pCol->intervalMs = TL_COL_DEFAULT_INTERVAL_MS;
+    pCol->window = TL_COL_DEFAULT_WINDOW;
+    pCol->utilThreshold = TL_COL_DEFAULT_UTIL_THRESHOLD;
+    pCol->hotShare = TL_COL_DEFAULT_HOT_SHARE;
+    for (i = 0; i < TL_COL_MAX_RP; i++)
+    {
+        pCol->rps[i].ringPair = -1;
+    }
+
+    while (CPA_STATUS_SUCCESS == status &&
+           (opt = getopt(argc, argv, "i:n:w:t:H:p:so:R:qh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':
+                pCol->intervalMs = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                numSamples = strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                pCol->window = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                pCol->utilThreshold = strtoul(optarg, NULL, 0);
+                break;
+            case 'H':
+                pCol->hotShare = strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                status = tlColParseRingPairs(pCol, optarg);
+                break;
+            case 's':
+                pCol->startTelemetry = CPA_TRUE;
+                break;
+            case 'o':
+                pCol->pRecord = fopen(optarg, "w");
+                if (NULL == pCol->pRecord)
+                {
+                    TL_COL_LOG_ERROR("Cannot create %s\n", optarg);
+                    status = CPA_STATUS_FAIL;
+                }
+                break;
+            case 'R':
+                pCol->pReplay = fopen(optarg, "r");
+                if (NULL == pCol->pReplay)
+                {
+                    TL_COL_LOG_ERROR("Cannot open %s\n", optarg);
+                    status = CPA_STATUS_FAIL;
+                }
+                break;
+            case 'q':
+                quiet = CPA_TRUE;
+                break;
+            default:
+                status = CPA_STATUS_INVALID_PARAM;
+                break;
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        if (0 == pCol->window || TL_COL_MAX_WINDOW < pCol->window)
+        {
+            status = CPA_STATUS_INVALID_PARAM;
+        }
+        else if (NULL == pCol->pReplay)
+        {
+            status = (optind == argc - 1)
+                         ? rlStrToPciAddr(&pCol->pciAddr,
+                                          (Cpa8U *)argv[optind])
+                         : CPA_STATUS_INVALID_PARAM;
+        }
+        else if (optind != argc)
+        {
+            status = CPA_STATUS_INVALID_PARAM;
+        }
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        tlColPrintHelp(argv[0]);
+        goto exit;
+    }
+
+    status = tlColOpen(pCol);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        tlColClose(pCol);
+        goto exit;
+    }
+
+    signal(SIGINT, tlColSigHandler);
+    signal(SIGTERM, tlColSigHandler);
+    while (!tlColStop && (0 == numSamples || pCol->numSamples < numSamples))
+    {
+        status = tlColSample(pCol);
+        if (CPA_STATUS_FAIL == status)
+        {
+            break;
+        }
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            tlColDetect(pCol);
+            if (!quiet)
+            {
+                tlColReport(pCol);
+            }
+        }
+        if (NULL == pCol->pReplay)
+        {
+            osalSleep(pCol->intervalMs);
+        }
+    }
+    /* End of a replay is a normal exit */
+    if (pCol->done)
+    {
+        status = CPA_STATUS_SUCCESS;
+    }
+    TL_COL_LOG_USER("%llu samples, %llu stale reads\n",
+                    (unsigned long long)pCol->numSamples,
+                    (unsigned long long)pCol->numStale);
+    tlColClose(pCol);
+
+exit:
+    if (pCol->pRecord)
+    {
+        fclose(pCol->pRecord);
+    }
+    if (pCol->pReplay)
+    {
+        fclose(pCol->pReplay);
+    }
+    free(pCol);
+
+    return (CPA_STATUS_FAIL == status || CPA_STATUS_INVALID_PARAM == status)
+               ? -1
+               : 0;
+}
@@ -299,6 +299,97 @@ int qaeUnregisterDevice(int fd);
  *
  ****************************************************************************/
 void qaeAtFork(void);
+
+/**
+ *****************************************************************************
+ * @ingroup CommonMemoryDriver
+ *      qae_mem_alloc_stats_t
+ *
+ * @description
+ *      Statistics of the user space slab allocator. Requests whose size is
+ *      a power of two multiple of 1K, up to 2M, are served from
+ *      per-size-class free lists when possible; the remaining requests
+ *      search the slab bitmaps.
+ *      External fragmentation of the slabs in use can be derived as
+ *      1 - largestFreeBytes / freeBytes.
+ *
+ ****************************************************************************/
+typedef struct qae_mem_alloc_stats_s
+{
+    uint64_t numAllocs;
+    /* Number of successful qaeMemAllocNUMA calls */
+    uint64_t numSizeClassAllocs;
+    /* Number of allocations served from a size-class free list */
+    uint64_t numFrees;
+    /* Number of frees of blocks whose size has a size class */
+    uint64_t numSizeClassFrees;
+    /* Number of frees parked on a size-class free list */
+    uint64_t allocCycles;
+    /* Total cycles spent in qaeMemAllocNUMA, including lock wait.
+     * Only collected when built with ICP_USDM_ALLOC_STATS */
+    uint64_t maxAllocCycles;
+    /* Longest qaeMemAllocNUMA call in cycles.
+     * Only collected when built with ICP_USDM_ALLOC_STATS */
+    uint64_t slabBytes;
+    /* Memory held by the slabs in use */
+    uint64_t freeBytes;
+    /* Free memory in the slabs in use */
+    uint64_t largestFreeBytes;
+    /* Largest contiguous free area in any slab in use */
+    uint64_t parkedBytes;
+    /* Memory parked on size-class free lists */
+} qae_mem_alloc_stats_t;
+
+/**
+ ***************************************************************************
+ * @ingroup CommonMemoryDriver
+ *      qaeMemGetAllocStats
+ *
+ * @brief
+ *      Returns the statistics of the user space slab allocator. When the
+ *      library is built with ICP_THREAD_SPECIFIC_USDM the statistics cover
+ *      the allocations of the calling thread only.
+ *
+ * @param[out] stats - pointer to the statistics structure to be filled
+ *
+ * @retval 0 on success, negative errno value otherwise
+ *
+ ****************************************************************************/
+int qaeMemGetAllocStats(qae_mem_alloc_stats_t *stats);
+
+/**
+ *****************************************************************************
+ * @ingroup CommonMemoryDriver
+ *      qae_mem_xlat_stats_t
+ *
+ * @description
+ *      Statistics of the per-thread translation caches used by
+ *      qaeVirtToPhysNUMA. A miss costs a walk of the user space page table.
+ *
+ ****************************************************************************/
+typedef struct qae_mem_xlat_stats_s
+{
+    uint64_t hits;
+    /* Number of translations served from a translation cache */
+    uint64_t misses;
+    /* Number of translations which walked the page table */
+} qae_mem_xlat_stats_t;
+
+/**
+ ***************************************************************************
+ * @ingroup CommonMemoryDriver
+ *      qaeMemGetXlatStats
+ *
+ * @brief
+ *      Returns the hit and miss counters of the virtual to physical
+ *      translation caches, summed over all threads of the process.
+ *
+ * @param[out] stats - pointer to the statistics structure to be filled
+ *
+ * @retval 0 on success, negative errno value otherwise
+ *
+ ****************************************************************************/
+int qaeMemGetXlatStats(qae_mem_xlat_stats_t *stats);
 #endif
 
 #ifdef __cplusplus
@@ -92,6 +92,8 @@ size_t g_max_lookup_num = 10;
 page_table_t g_page_table = {{{0}}};
 /* User space hash for fast slab searching */
 slab_list_t g_slab_list[PAGE_SIZE] = {{0}};
+/* Size-class free lists in front of the slab bitmaps */
+STATIC qae_size_class_cache_t g_size_class_cache = {{{0}}};
 
 #ifdef __CLANG_FORMAT__
 /* clang-format on */
@@ -276,6 +278,9 @@ void __qae_free_slab(const int fd, dev_mem_info_t *slab)
     }
 
     __qae_finish_free_slab(fd, &memInfo);
+    /* Only once the slab is unmapped, under the allocator lock, so that
+     * no thread can cache a translation of it after the invalidation */
+    __qae_xlat_invalidate();
 }
 
 API_LOCAL
@@ -315,7 +320,9 @@ void __qae_ResetControl(void)
     /* Reset all control structures. */
     free_page_table_fptr(&g_page_table);
     memset(&g_page_table, 0, sizeof(g_page_table));
+    __qae_xlat_invalidate();
     memset(&g_slab_list, 0, sizeof(g_slab_list));
+    memset(&g_size_class_cache, 0, sizeof(g_size_class_cache));
     g_cache_size = 0;
 
     __qae_pUserCacheHead = NULL;
@@ -395,6 +402,8 @@ void qaeMemDestroy(void)
 
     /* release all control buffers */
     free_page_table_fptr(&g_page_table);
+    __qae_xlat_invalidate();
+    __qae_size_class_reset(&g_size_class_cache);
     __qae_reset_cache(g_fd);
     __qae_destroyList(g_fd, __qae_pUserMemListHead);
     __qae_destroyList(g_fd, __qae_pUserLargeMemListHead);
@@ -448,6 +457,14 @@ void *__qae_alloc_addr(size_t size,
             return NULL;
         size = MAX(size, phys_alignment_byte);
         allocate_pages = div_round_up(size, UNIT_SIZE);
+
+        pVirtAddress = __qae_size_class_pop(&g_size_class_cache,
+                                            allocate_pages * UNIT_SIZE,
+                                            node,
+                                            phys_alignment_byte,
+                                            g_strict_node);
+        if (pVirtAddress)
+            return pVirtAddress;
     }
     else
     {
@@ -455,6 +472,14 @@ void *__qae_alloc_addr(size_t size,
         if (__qae_hugepage_enabled())
             mem_type = HUGE_PAGE;
 
+        pVirtAddress = __qae_size_class_pop(&g_size_class_cache,
+                                            size,
+                                            node,
+                                            phys_alignment_byte,
+                                            g_strict_node);
+        if (pVirtAddress)
+            return pVirtAddress;
+
         p_ctrl_blk =
             __qae_find_slab(g_fd, size, node, &pVirtAddress, phys_align_unit);
 
@@ -526,6 +551,7 @@ void *qaeMemAllocNUMA(size_t size, int node, size_t phys_alignment_byte)
 {
     void *pVirtAddress = NULL;
     int ret = 0;
+    uint64_t start = 0;
 
     if (!size)
     {
@@ -556,6 +582,9 @@ void *qaeMemAllocNUMA(size_t size, int node, size_t phys_alignment_byte)
         return NULL;
     }
 
+#ifdef ICP_USDM_ALLOC_STATS
+    start = qae_rdtsc();
+#endif
     ret = mem_mutex_lock(&mutex);
     if (unlikely(ret))
     {
@@ -567,6 +596,8 @@ void *qaeMemAllocNUMA(size_t size, int node, size_t phys_alignment_byte)
     }
 
     pVirtAddress = __qae_alloc_addr(size, node, phys_alignment_byte);
+    if (pVirtAddress)
+        __qae_size_class_account_alloc(&g_size_class_cache, start);
 
     ret = mem_mutex_unlock(&mutex);
     if (unlikely(ret))
@@ -584,6 +615,7 @@ API_LOCAL
 void __qae_free_addr(void **p_va, bool secure_free)
 {
     dev_mem_info_t *p_ctrl_blk = NULL;
+    int ret = 0;
 
     if (0 != __qae_open())
         return;
@@ -599,9 +631,24 @@ void __qae_free_addr(void **p_va, bool secure_free)
     }
     if (SMALL == p_ctrl_blk->type || HUGE_PAGE == p_ctrl_blk->type)
     {
+        ret = __qae_size_class_push(
+            &g_size_class_cache, p_ctrl_blk, *p_va, secure_free);
+        if (-ENOSPC != ret)
+        {
+            /* Parked on a size-class list or rejected as a double free */
+            *p_va = NULL;
+            return;
+        }
         if (__qae_mem_free((block_ctrl_t *)p_ctrl_blk, *p_va, secure_free))
         {
             p_ctrl_blk->allocations -= 1;
+            /* Only parked blocks left, return them to release the slab */
+            if (p_ctrl_blk->allocations &&
+                p_ctrl_blk->allocations ==
+                    QAE_SIZE_CLASS_PARKED_COUNT(p_ctrl_blk))
+            {
+                __qae_size_class_drain(&g_size_class_cache, p_ctrl_blk);
+            }
         }
         else
         {
@@ -627,6 +674,14 @@ void __qae_free_addr(void **p_va, bool secure_free)
     }
     else
     {
+        ret = __qae_size_class_push(
+            &g_size_class_cache, p_ctrl_blk, *p_va, secure_free);
+        if (-ENOSPC != ret)
+        {
+            /* Parked on a size-class list or rejected as a double free */
+            *p_va = NULL;
+            return;
+        }
         REMOVE_ELEMENT_FROM_LIST(p_ctrl_blk,
                                  __qae_pUserLargeMemListHead,
                                  __qae_pUserLargeMemListTail,
@@ -680,3 +735,39 @@ void __qae_memFreeNUMA(void **ptr, bool secure_free)
     }
     return;
 }
+
+int qaeMemGetAllocStats(qae_mem_alloc_stats_t *stats)
+{
+    int ret = 0;
+
+    if (NULL == stats)
+    {
+        CMD_ERROR(
+            "%s:%d Input parameter cannot be NULL \n", __func__, __LINE__);
+        return -EINVAL;
+    }
+
+    ret = mem_mutex_lock(&mutex);
+    if (ret)
+    {
+        CMD_ERROR("%s:%d Error on thread mutex lock %s\n",
+                  __func__,
+                  __LINE__,
+                  strerror(ret));
+        return -EIO;
+    }
+
+    __qae_size_class_fill_stats(
+        &g_size_class_cache, __qae_pUserMemListHead, stats);
+
+    ret = mem_mutex_unlock(&mutex);
+    if (ret)
+    {
+        CMD_ERROR("%s:%d Error on thread mutex unlock %s\n",
+                  __func__,
+                  __LINE__,
+                  strerror(ret));
+        return -EIO;
+    }
+    return 0;
+}
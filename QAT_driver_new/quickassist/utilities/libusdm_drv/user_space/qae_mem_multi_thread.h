@@ -109,6 +109,7 @@ typedef struct
     size_t g_max_cache;
     size_t g_max_lookup_num;
     slab_list_t g_slab_list[PAGE_SIZE];
+    qae_size_class_cache_t g_size_class_cache;
     int g_strict_node;
     uint32_t numaAllocations_g;
     uint32_t thd_process_id;
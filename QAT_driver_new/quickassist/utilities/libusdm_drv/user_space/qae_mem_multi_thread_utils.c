@@ -237,6 +237,9 @@ void __qae_free_slab(const int fd,
     }
 
     __qae_finish_free_slab(fd, &memInfo);
+    /* Only once the slab is unmapped, under the allocator lock, so that
+     * no thread can cache a translation of it after the invalidation */
+    __qae_xlat_invalidate();
 }
 
 API_LOCAL
@@ -324,6 +327,7 @@ int32_t qaeMemInit()
     }
     free_page_table_fptr(&g_page_table);
     memset(&g_page_table, 0, sizeof(g_page_table));
+    __qae_xlat_invalidate();
 
 #ifdef CACHE_PID
     /* Cache pid */
@@ -399,6 +403,7 @@ void qaeMemDestroy(void)
     qae_mem_info_t *tls_ptr = NULL;
 
     free_page_table_fptr(&g_page_table);
+    __qae_xlat_invalidate();
 #ifdef CACHE_PID
     if (cache_pid != NULL)
     {
@@ -416,6 +421,7 @@ void qaeMemDestroy(void)
     tls_ptr = (qae_mem_info_t *)pthread_getspecific(qae_key);
     if (tls_ptr && qae_mem_inited)
     {
+        __qae_size_class_reset(&tls_ptr->g_size_class_cache);
         __qae_reset_cache(g_fd, (void *)tls_ptr);
         __qae_destroyList(g_fd, tls_ptr->pUserMemListHead, (void *)tls_ptr);
         __qae_destroyList(
@@ -490,6 +496,14 @@ void *__qae_alloc_addr(size_t size,
 
         size = MAX(size, phys_alignment_byte);
         allocate_pages = div_round_up(size, UNIT_SIZE);
+
+        pVirtAddress = __qae_size_class_pop(&tls_ptr->g_size_class_cache,
+                                            allocate_pages * UNIT_SIZE,
+                                            node,
+                                            phys_alignment_byte,
+                                            tls_ptr->g_strict_node);
+        if (pVirtAddress)
+            return pVirtAddress;
     }
     else
     {
@@ -497,6 +511,14 @@ void *__qae_alloc_addr(size_t size,
         if (__qae_hugepage_enabled())
             mem_type = HUGE_PAGE;
 
+        pVirtAddress = __qae_size_class_pop(&tls_ptr->g_size_class_cache,
+                                            size,
+                                            node,
+                                            phys_alignment_byte,
+                                            tls_ptr->g_strict_node);
+        if (pVirtAddress)
+            return pVirtAddress;
+
         p_ctrl_blk = __qae_find_slab(
             g_fd, size, node, &pVirtAddress, phys_align_unit, tls_ptr);
 
@@ -571,6 +593,8 @@ void *__qae_alloc_addr(size_t size,
 void *qaeMemAllocNUMA(size_t size, int node, size_t phys_alignment_byte)
 {
     void *pVirtAddress = NULL;
+    qae_mem_info_t *tls_ptr = NULL;
+    uint64_t start = 0;
 
     if (!size)
     {
@@ -596,6 +620,9 @@ void *qaeMemAllocNUMA(size_t size, int node, size_t phys_alignment_byte)
         return NULL;
     }
 
+#ifdef ICP_USDM_ALLOC_STATS
+    start = qae_rdtsc();
+#endif
     if (0 != qaeMemInit())
         return NULL;
 
@@ -605,6 +632,11 @@ void *qaeMemAllocNUMA(size_t size, int node, size_t phys_alignment_byte)
     }
 
     pVirtAddress = __qae_alloc_addr(size, node, phys_alignment_byte);
+    if (pVirtAddress)
+    {
+        tls_ptr = (qae_mem_info_t *)pthread_getspecific(qae_key);
+        __qae_size_class_account_alloc(&tls_ptr->g_size_class_cache, start);
+    }
     return pVirtAddress;
 }
 
@@ -613,6 +645,7 @@ void __qae_free_addr(void **p_va, bool secure_free)
 {
     dev_mem_info_t *p_ctrl_blk = NULL;
     qae_mem_info_t *tls_ptr;
+    int ret = 0;
 
     tls_ptr = (qae_mem_info_t *)pthread_getspecific(qae_key);
     if (!tls_ptr)
@@ -632,9 +665,25 @@ void __qae_free_addr(void **p_va, bool secure_free)
     }
     if (SMALL == p_ctrl_blk->type || HUGE_PAGE == p_ctrl_blk->type)
     {
+        ret = __qae_size_class_push(
+            &tls_ptr->g_size_class_cache, p_ctrl_blk, *p_va, secure_free);
+        if (-ENOSPC != ret)
+        {
+            /* Parked on a size-class list or rejected as a double free */
+            *p_va = NULL;
+            return;
+        }
         if (__qae_mem_free((block_ctrl_t *)p_ctrl_blk, *p_va, secure_free))
         {
             p_ctrl_blk->allocations -= 1;
+            /* Only parked blocks left, return them to release the slab */
+            if (p_ctrl_blk->allocations &&
+                p_ctrl_blk->allocations ==
+                    QAE_SIZE_CLASS_PARKED_COUNT(p_ctrl_blk))
+            {
+                __qae_size_class_drain(&tls_ptr->g_size_class_cache,
+                                       p_ctrl_blk);
+            }
         }
         else
         {
@@ -662,6 +711,14 @@ void __qae_free_addr(void **p_va, bool secure_free)
     }
     else
     {
+        ret = __qae_size_class_push(
+            &tls_ptr->g_size_class_cache, p_ctrl_blk, *p_va, secure_free);
+        if (-ENOSPC != ret)
+        {
+            /* Parked on a size-class list or rejected as a double free */
+            *p_va = NULL;
+            return;
+        }
         REMOVE_ELEMENT_FROM_LIST(p_ctrl_blk,
                                  tls_ptr->pUserLargeMemListHead,
                                  tls_ptr->pUserLargeMemListTail,
@@ -696,3 +753,32 @@ void __qae_memFreeNUMA(void **ptr, bool secure_free)
 
     return;
 }
+
+int qaeMemGetAllocStats(qae_mem_alloc_stats_t *stats)
+{
+    qae_mem_info_t *tls_ptr = NULL;
+
+    if (NULL == stats)
+    {
+        CMD_ERROR(
+            "%s:%d Input parameter cannot be NULL \n", __func__, __LINE__);
+        return -EINVAL;
+    }
+
+    if (!qae_mem_inited)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return 0;
+    }
+
+    tls_ptr = (qae_mem_info_t *)pthread_getspecific(qae_key);
+    if (NULL == tls_ptr)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return 0;
+    }
+
+    __qae_size_class_fill_stats(
+        &tls_ptr->g_size_class_cache, tls_ptr->pUserMemListHead, stats);
+    return 0;
+}
@@ -94,6 +94,46 @@
 
 load_addr_fptr_t load_addr_fptr = load_addr;
 
+/* Number of entries in the per-thread translation cache, power of 2 */
+#define QAE_XLAT_CACHE_ENTRIES (64)
+
+/* Translation cache entry: page number and physical address of the page */
+typedef struct qae_xlat_entry_s
+{
+    uintptr_t page;
+    uint64_t phys;
+} qae_xlat_entry_t;
+
+/* Direct-mapped virtual to physical translation cache of a thread */
+typedef struct qae_xlat_cache_s
+{
+    qae_xlat_entry_t entries[QAE_XLAT_CACHE_ENTRIES];
+    uint64_t generation;
+    uint64_t hits;
+    uint64_t misses;
+    struct qae_xlat_cache_s *pPrev;
+    struct qae_xlat_cache_s *pNext;
+} qae_xlat_cache_t;
+
+/* Bumped whenever a slab is released; stale thread caches are flushed */
+STATIC volatile uint64_t g_xlat_generation = 1;
+
+#ifndef ICP_WITHOUT_THREAD
+STATIC pthread_key_t xlat_key;
+STATIC pthread_once_t xlat_key_once = PTHREAD_ONCE_INIT;
+STATIC pthread_mutex_t xlat_mutex = PTHREAD_MUTEX_INITIALIZER;
+STATIC __thread qae_xlat_cache_t *xlat_cache = NULL;
+/* List of live thread caches, used to report statistics */
+STATIC qae_xlat_cache_t *xlat_cache_head = NULL;
+STATIC qae_xlat_cache_t *xlat_cache_tail = NULL;
+/* Statistics of the threads which have exited */
+STATIC uint64_t xlat_retired_hits = 0;
+STATIC uint64_t xlat_retired_misses = 0;
+#else
+STATIC qae_xlat_cache_t xlat_cache_single = {{{0}}};
+STATIC qae_xlat_cache_t *xlat_cache = &xlat_cache_single;
+#endif
+
 const uint64_t __qae_bitmask[65] = {
     0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000003ULL,
     0x0000000000000007ULL, 0x000000000000000fULL, 0x000000000000001fULL,
@@ -355,6 +395,344 @@ bool __qae_mem_free(block_ctrl_t *block_ctrl, void *block, bool secure_free)
     return true;
 }
 
+/* __qae_mem_slab_usage function
+ * counts the free blocks of a slab and its largest run of free blocks
+ * input: block_ctrl - pointer to the memory control block
+ * output: free_units - number of free blocks
+ *         largest_run - largest number of contiguous free blocks
+ */
+API_LOCAL
+void __qae_mem_slab_usage(block_ctrl_t *block_ctrl,
+                          size_t *free_units,
+                          size_t *largest_run)
+{
+    const size_t last = block_ctrl->mem_info.size / CHUNK_SIZE;
+    size_t run = 0;
+    size_t pos = 0;
+
+    *free_units = 0;
+    *largest_run = 0;
+
+    for (pos = 0; pos < MIN(last, BITMAP_LEN) * QWORD_WIDTH; pos++)
+    {
+        const uint64_t bit = 1ULL << (pos % QWORD_WIDTH);
+
+        if (block_ctrl->bitmap[pos / QWORD_WIDTH] & bit)
+        {
+            run = 0;
+            continue;
+        }
+        *free_units += 1;
+        run++;
+        if (run > *largest_run)
+            *largest_run = run;
+    }
+}
+
+/* size_class_index function
+ * input: units - number of allocation units of a block
+ * output: size class of the block or -1 if the block size
+ *         is not served by a size class
+ */
+static int32_t size_class_index(const size_t units)
+{
+    int32_t cls = 0;
+
+    if (0 == units || (units & (units - 1)) || units > QAE_SLAB_UNITS)
+    {
+        return -1;
+    }
+    cls = mem_ctzll(units);
+
+    return (cls < QAE_SIZE_CLASS_NUM) ? cls : -1;
+}
+
+/* __qae_size_class_pop function
+ * Takes a block from the head of the size-class list matching size.
+ * The block is returned only if it satisfies the node and physical
+ * alignment constraints, otherwise the caller falls back to the bitmap
+ * search or to a new slab.
+ * input: cache - size-class cache
+ *        size - size requested in bytes
+ *        node - NUMA node requested
+ *        phys_alignment_byte - physical alignment requested in bytes
+ *        strict_node - whether the node must match
+ * output: pointer to the block or NULL
+ */
+API_LOCAL
+void *__qae_size_class_pop(qae_size_class_cache_t *cache,
+                           const size_t size,
+                           const int node,
+                           const size_t phys_alignment_byte,
+                           const int strict_node)
+{
+    const int32_t cls = size_class_index(div_round_up(size, UNIT_SIZE));
+    qae_free_block_t *block = NULL;
+    dev_mem_info_t *slab = NULL;
+    uintptr_t offset = 0;
+
+    if (cls < 0)
+    {
+        return NULL;
+    }
+
+    block = cache->classes[cls].head;
+    if (NULL == block)
+    {
+        return NULL;
+    }
+    slab = block->slab;
+
+    if (strict_node && (slab->nodeId != node))
+    {
+        return NULL;
+    }
+
+    offset = (uintptr_t)block - (uintptr_t)slab->virt_addr;
+    if ((slab->phy_addr + offset) & (phys_alignment_byte - 1))
+    {
+        return NULL;
+    }
+
+    if (LARGE == slab->type)
+    {
+        slab->allocations = 1;
+    }
+    else
+    {
+        ((block_ctrl_t *)slab->virt_addr)->sizes[offset / UNIT_SIZE] &=
+            ~QAE_SIZE_CLASS_PARKED;
+        QAE_SIZE_CLASS_PARKED_COUNT(slab)--;
+    }
+
+    cache->classes[cls].head = block->pNext;
+    cache->classes[cls].count--;
+    cache->numSizeClassAllocs++;
+
+    /* leave the block as it was released */
+    block->pNext = NULL;
+    block->slab = NULL;
+
+    return block;
+}
+
+/* __qae_size_class_push function
+ * Parks a released block on the size-class list matching its size. A
+ * block of a small slab stays allocated in the slab bitmap, a large slab
+ * is parked whole and stays on the list of large slabs in use.
+ * input: cache - size-class cache
+ *        slab - slab the block belongs to
+ *        ptr - block to release
+ *        secure_free - whether the block has to be cleared
+ * output: 0 if the block was parked,
+ *         -ENOSPC if the block is not served by a size class, its list
+ *         is full or it is the last block in use of its slab,
+ *         -EINVAL if the block is already parked
+ */
+API_LOCAL
+int __qae_size_class_push(qae_size_class_cache_t *cache,
+                          dev_mem_info_t *slab,
+                          void *ptr,
+                          bool secure_free)
+{
+    block_ctrl_t *block_ctrl = (block_ctrl_t *)slab->virt_addr;
+    qae_free_block_t *block = ptr;
+    size_t first_block = 0;
+    size_t length = 0;
+    int32_t cls = 0;
+
+    if (LARGE == slab->type)
+    {
+        if (0 == slab->allocations)
+        {
+            CMD_ERROR("%s:%d Invalid block address provided - "
+                      "Possibly double free.\n",
+                      __func__,
+                      __LINE__);
+            return -EINVAL;
+        }
+        if (ptr != slab->virt_addr || slab->size % UNIT_SIZE)
+        {
+            return -ENOSPC;
+        }
+        length = slab->size / UNIT_SIZE;
+    }
+    else
+    {
+        if ((uintptr_t)ptr % UNIT_SIZE)
+        {
+            return -ENOSPC;
+        }
+
+        first_block = ((uintptr_t)ptr - (uintptr_t)block_ctrl) / UNIT_SIZE;
+        length = block_ctrl->sizes[first_block];
+
+        if (length & QAE_SIZE_CLASS_PARKED)
+        {
+            CMD_ERROR("%s:%d Invalid block address provided - "
+                      "Block index = %zu. "
+                      "Possibly double free.\n",
+                      __func__,
+                      __LINE__,
+                      first_block);
+            return -EINVAL;
+        }
+    }
+
+    cls = size_class_index(length);
+    if (cls < 0)
+    {
+        return -ENOSPC;
+    }
+    cache->numFrees++;
+    if ((cache->classes[cls].count + 1) * length * UNIT_SIZE >
+        QAE_SIZE_CLASS_CACHE_BYTES)
+    {
+        return -ENOSPC;
+    }
+
+    if (LARGE == slab->type)
+    {
+        slab->allocations = 0;
+    }
+    else
+    {
+        /* let the release path free the slab */
+        if (slab->allocations <= QAE_SIZE_CLASS_PARKED_COUNT(slab) + 1U)
+        {
+            return -ENOSPC;
+        }
+        block_ctrl->sizes[first_block] |= QAE_SIZE_CLASS_PARKED;
+        QAE_SIZE_CLASS_PARKED_COUNT(slab)++;
+    }
+
+    if (secure_free)
+    {
+#ifndef ICP_DISABLE_SECURE_MEM_FREE
+        qae_memzero_explicit(ptr, length * UNIT_SIZE);
+#endif
+    }
+
+    block->slab = slab;
+    block->pNext = cache->classes[cls].head;
+    cache->classes[cls].head = block;
+    cache->classes[cls].count++;
+    cache->numSizeClassFrees++;
+
+    return 0;
+}
+
+/* __qae_size_class_drain function
+ * Returns the parked blocks of a small slab to its bitmap. Called when the
+ * other blocks of the slab have been freed, so that it can be released.
+ * input: cache - size-class cache
+ *        slab - slab to drain
+ */
+API_LOCAL
+void __qae_size_class_drain(qae_size_class_cache_t *cache,
+                            dev_mem_info_t *slab)
+{
+    block_ctrl_t *block_ctrl = (block_ctrl_t *)slab->virt_addr;
+    qae_free_block_t **p_link = NULL;
+    qae_free_block_t *block = NULL;
+    size_t cls = 0;
+
+    for (cls = 0;
+         cls < QAE_SIZE_CLASS_NUM && QAE_SIZE_CLASS_PARKED_COUNT(slab);
+         cls++)
+    {
+        p_link = &cache->classes[cls].head;
+        while (NULL != (block = *p_link))
+        {
+            if (block->slab != slab)
+            {
+                p_link = &block->pNext;
+                continue;
+            }
+            *p_link = block->pNext;
+            cache->classes[cls].count--;
+            block_ctrl->sizes[((uintptr_t)block - (uintptr_t)block_ctrl) /
+                              UNIT_SIZE] &= ~QAE_SIZE_CLASS_PARKED;
+            QAE_SIZE_CLASS_PARKED_COUNT(slab)--;
+
+            block->pNext = NULL;
+            block->slab = NULL;
+            /* cleared when parked if the free was secure */
+            if (__qae_mem_free(block_ctrl, block, false))
+                slab->allocations -= 1;
+        }
+    }
+}
+
+/* __qae_size_class_reset function
+ * Drops all parked blocks.
+ */
+API_LOCAL
+void __qae_size_class_reset(qae_size_class_cache_t *cache)
+{
+    memset(cache->classes, 0, sizeof(cache->classes));
+}
+
+/* __qae_size_class_account_alloc function
+ * Updates the allocation counters after a request completed.
+ * input: cache - size-class cache
+ *        start - timestamp taken when the request was received
+ */
+API_LOCAL
+void __qae_size_class_account_alloc(qae_size_class_cache_t *cache,
+                                    const uint64_t start)
+{
+#ifdef ICP_USDM_ALLOC_STATS
+    const uint64_t cycles = qae_rdtsc() - start;
+
+    cache->allocCycles += cycles;
+    if (cycles > cache->maxAllocCycles)
+        cache->maxAllocCycles = cycles;
+#else
+    UNUSED(start);
+#endif
+    cache->numAllocs++;
+}
+
+/* __qae_size_class_fill_stats function
+ * Fills the allocator statistics from the size-class cache and the list
+ * of slabs in use.
+ */
+API_LOCAL
+void __qae_size_class_fill_stats(const qae_size_class_cache_t *cache,
+                                 dev_mem_info_t *pSlabList,
+                                 qae_mem_alloc_stats_t *stats)
+{
+    dev_mem_info_t *slab = NULL;
+    size_t cls = 0;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->numAllocs = cache->numAllocs;
+    stats->numSizeClassAllocs = cache->numSizeClassAllocs;
+    stats->numFrees = cache->numFrees;
+    stats->numSizeClassFrees = cache->numSizeClassFrees;
+    stats->allocCycles = cache->allocCycles;
+    stats->maxAllocCycles = cache->maxAllocCycles;
+
+    for (cls = 0; cls < QAE_SIZE_CLASS_NUM; cls++)
+    {
+        stats->parkedBytes +=
+            cache->classes[cls].count * ((uint64_t)UNIT_SIZE << cls);
+    }
+
+    for (slab = pSlabList; slab != NULL; slab = slab->pNext_user)
+    {
+        size_t free_units = 0;
+        size_t largest_run = 0;
+
+        __qae_mem_slab_usage((block_ctrl_t *)slab, &free_units, &largest_run);
+        stats->slabBytes += slab->size;
+        stats->freeBytes += free_units * UNIT_SIZE;
+        if (largest_run * UNIT_SIZE > stats->largestFreeBytes)
+            stats->largestFreeBytes = largest_run * UNIT_SIZE;
+    }
+}
+
 /**************************************
  * Memory functions
  *************************************/
@@ -376,10 +754,136 @@ void qaeMemFree(void **ptr)
     *ptr = NULL;
 }
 
+API_LOCAL
+void __qae_xlat_invalidate(void)
+{
+    __sync_fetch_and_add(&g_xlat_generation, 1);
+}
+
+#ifndef ICP_WITHOUT_THREAD
+static void xlat_cache_destroy(void *cache)
+{
+    qae_xlat_cache_t *p_cache = cache;
+
+    /* a later translation from another key destructor of this thread
+     * must not use the freed cache */
+    xlat_cache = NULL;
+    if (mem_mutex_lock(&xlat_mutex))
+        return;
+    xlat_retired_hits += p_cache->hits;
+    xlat_retired_misses += p_cache->misses;
+    REMOVE_ELEMENT_FROM_LIST(p_cache, xlat_cache_head, xlat_cache_tail, );
+    mem_mutex_unlock(&xlat_mutex);
+    free(p_cache);
+}
+
+static void xlat_make_key(void)
+{
+    pthread_key_create(&xlat_key, xlat_cache_destroy);
+}
+
+/* xlat_cache_create function
+ * allocates the translation cache of the calling thread and
+ * registers it for statistics reporting
+ */
+static qae_xlat_cache_t *xlat_cache_create(void)
+{
+    qae_xlat_cache_t *p_cache = NULL;
+
+    pthread_once(&xlat_key_once, xlat_make_key);
+
+    p_cache = calloc(1, sizeof(qae_xlat_cache_t));
+    if (NULL == p_cache)
+        return NULL;
+
+    if (mem_mutex_lock(&xlat_mutex))
+    {
+        free(p_cache);
+        return NULL;
+    }
+    ADD_ELEMENT_TO_END_LIST(p_cache, xlat_cache_head, xlat_cache_tail, );
+    mem_mutex_unlock(&xlat_mutex);
+
+    pthread_setspecific(xlat_key, p_cache);
+    xlat_cache = p_cache;
+    return p_cache;
+}
+#endif
+
 /*translate a virtual address to a physical address */
 uint64_t qaeVirtToPhysNUMA(void *pVirtAddress)
 {
-    return load_addr_fptr(&g_page_table, pVirtAddress);
+    qae_xlat_cache_t *p_cache = xlat_cache;
+    qae_xlat_entry_t *entry = NULL;
+    const uint64_t generation = g_xlat_generation;
+    const unsigned shift =
+        (load_addr_fptr == load_addr_hpg) ? HUGEPAGE_SHIFT : PAGE_SHIFT;
+    const uintptr_t page = (uintptr_t)pVirtAddress >> shift;
+    const uintptr_t offset =
+        (uintptr_t)pVirtAddress & (((uintptr_t)1 << shift) - 1);
+    uint64_t phys = 0;
+
+#ifndef ICP_WITHOUT_THREAD
+    if (unlikely(NULL == p_cache))
+    {
+        p_cache = xlat_cache_create();
+        if (NULL == p_cache)
+            return load_addr_fptr(&g_page_table, pVirtAddress);
+    }
+#endif
+
+    if (unlikely(p_cache->generation != generation))
+    {
+        memset(p_cache->entries, 0, sizeof(p_cache->entries));
+        p_cache->generation = generation;
+    }
+
+    entry = &p_cache->entries[page & (QAE_XLAT_CACHE_ENTRIES - 1)];
+    if (entry->page == page && entry->phys)
+    {
+        p_cache->hits++;
+        return entry->phys | offset;
+    }
+
+    p_cache->misses++;
+    phys = load_addr_fptr(&g_page_table, pVirtAddress);
+    if (phys)
+    {
+        entry->page = page;
+        entry->phys = phys - offset;
+    }
+    return phys;
+}
+
+int qaeMemGetXlatStats(qae_mem_xlat_stats_t *stats)
+{
+#ifndef ICP_WITHOUT_THREAD
+    qae_xlat_cache_t *p_cache = NULL;
+#endif
+
+    if (NULL == stats)
+    {
+        CMD_ERROR(
+            "%s:%d Input parameter cannot be NULL \n", __func__, __LINE__);
+        return -EINVAL;
+    }
+
+#ifndef ICP_WITHOUT_THREAD
+    if (mem_mutex_lock(&xlat_mutex))
+        return -EIO;
+    stats->hits = xlat_retired_hits;
+    stats->misses = xlat_retired_misses;
+    for (p_cache = xlat_cache_head; p_cache != NULL; p_cache = p_cache->pNext)
+    {
+        stats->hits += p_cache->hits;
+        stats->misses += p_cache->misses;
+    }
+    mem_mutex_unlock(&xlat_mutex);
+#else
+    stats->hits = xlat_cache->hits;
+    stats->misses = xlat_cache->misses;
+#endif
+    return 0;
 }
 
 void qaeMemFreeNUMA(void **ptr)
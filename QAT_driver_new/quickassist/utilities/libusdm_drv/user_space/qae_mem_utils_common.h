@@ -106,6 +106,53 @@ typedef struct
     dev_mem_info_t *tail;
 } slab_list_t;
 
+/* Size classes cover 1K up to the size of a slab (2^0 to 2^11 allocation
+ * units with the default 2 MB slabs). Blocks of the largest class do not
+ * fit in a slab next to its control block, they are whole large slabs. */
+#define QAE_SIZE_CLASS_NUM 12
+/* Number of allocation units in a small slab. */
+#define QAE_SLAB_UNITS (QAE_NUM_PAGES_PER_ALLOC * QAE_PAGE_SIZE / UNIT_SIZE)
+/* Maximum memory parked on a single size-class list, 2 Mb by default. */
+#ifndef QAE_SIZE_CLASS_CACHE_BYTES
+#define QAE_SIZE_CLASS_CACHE_BYTES (0x200000ULL)
+#endif
+/* Flag set in block_ctrl_t sizes[] for blocks parked on a size-class list */
+#define QAE_SIZE_CLASS_PARKED (0x8000)
+/* Number of blocks of a slab parked on size-class lists. It is kept in the
+ * sizes[] entry of the first unit, which holds the control block itself
+ * and is never handed out. */
+#define QAE_SIZE_CLASS_PARKED_COUNT(slab)                                      \
+    (((block_ctrl_t *)(slab)->virt_addr)->sizes[0])
+
+/* Header written at the start of a parked block. */
+typedef struct qae_free_block_s
+{
+    struct qae_free_block_s *pNext;
+    dev_mem_info_t *slab;
+} qae_free_block_t;
+
+typedef struct qae_size_class_s
+{
+    qae_free_block_t *head;
+    size_t count;
+} qae_size_class_t;
+
+/* Segregated-fit front end of the slab allocator. Blocks whose size is a
+ * power of two of UNIT_SIZE are parked on per-size-class free lists when
+ * released, so that the next request of the same size is served in O(1)
+ * without scanning the slab bitmaps. */
+typedef struct qae_size_class_cache_s
+{
+    qae_size_class_t classes[QAE_SIZE_CLASS_NUM];
+    /* Allocator statistics reported by qaeMemGetAllocStats */
+    uint64_t numAllocs;
+    uint64_t numSizeClassAllocs;
+    uint64_t numFrees;
+    uint64_t numSizeClassFrees;
+    uint64_t allocCycles;
+    uint64_t maxAllocCycles;
+} qae_size_class_cache_t;
+
 /* User space page table for fast virtual to physical address translation */
 extern page_table_t g_page_table;
 extern const uint64_t __qae_bitmask[65];
@@ -122,9 +169,67 @@ void *__qae_mem_alloc(block_ctrl_t *block_ctrl, size_t size, size_t align);
 API_LOCAL
 bool __qae_mem_free(block_ctrl_t *block_ctrl, void *block, bool secure_free);
 
+API_LOCAL
+void __qae_mem_slab_usage(block_ctrl_t *block_ctrl,
+                          size_t *free_units,
+                          size_t *largest_run);
+
+/* __qae_size_class_pop function
+ * Takes a block of the size class of size, if the head of its list
+ * satisfies the node and physical alignment requested.
+ */
+API_LOCAL
+void *__qae_size_class_pop(qae_size_class_cache_t *cache,
+                           const size_t size,
+                           const int node,
+                           const size_t phys_alignment_byte,
+                           const int strict_node);
+
+/* __qae_size_class_push function
+ * Parks a released block, small slab block or whole large slab, on the
+ * list of its size class. Returns 0 if the block was parked, -ENOSPC if
+ * the caller has to free it and -EINVAL on a double free.
+ */
+API_LOCAL
+int __qae_size_class_push(qae_size_class_cache_t *cache,
+                          dev_mem_info_t *slab,
+                          void *ptr,
+                          bool secure_free);
+
+/* __qae_size_class_drain function
+ * Returns the parked blocks of a small slab to its bitmap.
+ */
+API_LOCAL
+void __qae_size_class_drain(qae_size_class_cache_t *cache,
+                            dev_mem_info_t *slab);
+
+/* __qae_size_class_reset function
+ * Drops all parked blocks. Must be called whenever the slabs holding
+ * them are released; parked large slabs are still on the list of large
+ * slabs and are released with it.
+ */
+API_LOCAL
+void __qae_size_class_reset(qae_size_class_cache_t *cache);
+
+API_LOCAL
+void __qae_size_class_account_alloc(qae_size_class_cache_t *cache,
+                                    const uint64_t start);
+
+API_LOCAL
+void __qae_size_class_fill_stats(const qae_size_class_cache_t *cache,
+                                 dev_mem_info_t *pSlabList,
+                                 qae_mem_alloc_stats_t *stats);
+
 API_LOCAL
 void __qae_finish_free_slab(const int fd, dev_mem_info_t *slab);
 
+/* __qae_xlat_invalidate function
+ * Invalidates the per-thread virtual to physical translation caches.
+ * Must be called whenever a slab is released or the page table is reset.
+ */
+API_LOCAL
+void __qae_xlat_invalidate(void);
+
 API_LOCAL
 void *__qae_alloc_addr(size_t size,
                        const int node,
@@ -135,6 +240,15 @@ void __qae_free_addr(void **p_va, bool secure_free);
 API_LOCAL
 void __qae_memFreeNUMA(void **ptr, bool secure_free);
 
+static inline uint64_t qae_rdtsc(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
 static inline size_t div_round_up(const size_t n, const size_t d)
 {
     return (n + d - 1) / d;
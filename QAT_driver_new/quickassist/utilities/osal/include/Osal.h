@@ -1260,6 +1260,112 @@ OSAL_PUBLIC OSAL_STATUS osalMutexDestroy(OsalMutex *pMutex);
  */
 OSAL_PUBLIC OSAL_STATUS osalMutexTryLock(OsalMutex *pMutex);
 
+/**
+ * @ingroup Osal
+ *
+ * @brief Initializes an adaptive lock
+ *
+ * @param pLock - adaptive lock handle
+ *
+ * Initializes an adaptive lock and clears its contention counters. An
+ * adaptive lock guards short critical sections: a waiter spins with
+ * exponential backoff for a bounded period and only then sleeps on a futex,
+ * so that a lock held for a few hundred cycles costs no context switch.
+ * A statically zeroed lock may be used without calling this function.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockInit(OsalAdaptiveLock *pLock);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Locks an adaptive lock
+ *
+ * @param pLock - adaptive lock handle
+ *
+ * Locks an adaptive lock, spinning then blocking until it is available.
+ * The lock is not recursive.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockLock(OsalAdaptiveLock *pLock);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Non-blocking attempt to lock an adaptive lock
+ *
+ * @param pLock - adaptive lock handle
+ *
+ * Attempts to lock an adaptive lock, returning immediately with OSAL_SUCCESS
+ * if the lock was successful or OSAL_FAIL if the lock is held
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockTryLock(OsalAdaptiveLock *pLock);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Unlocks an adaptive lock
+ *
+ * @param pLock - adaptive lock handle
+ *
+ * Unlocks an adaptive lock, waking one sleeping waiter if there is any
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockUnlock(OsalAdaptiveLock *pLock);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Destroys an adaptive lock
+ *
+ * @param pLock - adaptive lock handle
+ *
+ * Destroys an adaptive lock; fails if the lock is held
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockDestroy(OsalAdaptiveLock *pLock);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Reads the contention counters of an adaptive lock
+ *
+ * @param pLock - adaptive lock handle
+ * @param pStats - returned counters
+ *
+ * Copies the contention counters of an adaptive lock. The counters are not
+ * read atomically with respect to lock users, so the copy is a snapshot
+ * meant for monitoring.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockStatsGet(OsalAdaptiveLock *pLock,
+                                                 OsalAdaptiveLockStats *pStats);
+
 /**
  * @ingroup Osal
  *
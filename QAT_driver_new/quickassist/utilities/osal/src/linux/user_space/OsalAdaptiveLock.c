@@ -0,0 +1,227 @@
+/**
+ * @file OsalAdaptiveLock.c (linux user space)
+ *
+ * @brief Implementation for adaptive spin-then-block locks
+ *
+ *
+ * @par
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2023 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *  version: QAT20.L.1.2.30-00078
+ */
+
+#include "Osal.h"
+
+
+#ifndef ICP_WITHOUT_THREAD
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/* Lock word states */
+#define OSAL_ADAPTIVE_LOCK_FREE 0
+#define OSAL_ADAPTIVE_LOCK_LOCKED 1
+/* Locked and at least one thread may be waiting on the futex */
+#define OSAL_ADAPTIVE_LOCK_CONTENDED 2
+
+/* Number of pause instructions a waiter spends spinning before it blocks.
+ * The sections guarded by these locks are a few hundred cycles long, so the
+ * owner is normally gone well within this budget. */
+#define OSAL_ADAPTIVE_LOCK_SPIN_MAX 2048
+/* Upper bound of the exponential backoff between two looks at the lock */
+#define OSAL_ADAPTIVE_LOCK_BACKOFF_MAX 64
+
+#if defined(__x86_64__) || defined(__i386__)
+#define OSAL_ADAPTIVE_LOCK_PAUSE() __asm__ __volatile__("pause" ::: "memory")
+#else
+#define OSAL_ADAPTIVE_LOCK_PAUSE() __asm__ __volatile__("" ::: "memory")
+#endif
+
+#define OSAL_ADAPTIVE_LOCK_CAS(pState, oldVal, newVal)                         \
+    __sync_val_compare_and_swap((pState), (oldVal), (newVal))
+
+#define OSAL_ADAPTIVE_LOCK_XCHG(pState, newVal)                                \
+    __atomic_exchange_n((pState), (newVal), __ATOMIC_ACQ_REL)
+
+static void osalAdaptiveLockFutexWait(volatile INT32 *pState, INT32 val)
+{
+    /* Returns straight away if the lock word no longer holds val; a spurious
+     * or interrupted wake up is handled by the caller re-checking the state */
+    syscall(SYS_futex, pState, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static void osalAdaptiveLockFutexWake(volatile INT32 *pState)
+{
+    syscall(SYS_futex, pState, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+#endif
+
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockInit(OsalAdaptiveLock *pLock)
+{
+    OSAL_LOCAL_ENSURE(
+        pLock, "osalAdaptiveLockInit():   Null lock pointer", OSAL_FAIL);
+
+    osalMemSet(pLock, 0, sizeof(OsalAdaptiveLock));
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockLock(OsalAdaptiveLock *pLock)
+{
+#ifndef ICP_WITHOUT_THREAD
+    INT32 state;
+    UINT32 spins = 0;
+    UINT32 backoff = 1;
+    UINT32 i = 0;
+    UINT32 sleeps = 0;
+
+    OSAL_LOCAL_ENSURE(
+        pLock, "osalAdaptiveLockLock():   Null lock pointer", OSAL_FAIL);
+
+    state = OSAL_ADAPTIVE_LOCK_CAS(
+        &pLock->state, OSAL_ADAPTIVE_LOCK_FREE, OSAL_ADAPTIVE_LOCK_LOCKED);
+    if (OSAL_ADAPTIVE_LOCK_FREE == state)
+    {
+        pLock->stats.acquisitions++;
+        return OSAL_SUCCESS;
+    }
+
+    /* Spin, only attempting the atomic when the lock looks free so the
+     * waiters do not keep the cache line bouncing away from the owner */
+    while (spins < OSAL_ADAPTIVE_LOCK_SPIN_MAX)
+    {
+        for (i = 0; i < backoff; i++)
+        {
+            OSAL_ADAPTIVE_LOCK_PAUSE();
+        }
+        spins += backoff;
+        if (backoff < OSAL_ADAPTIVE_LOCK_BACKOFF_MAX)
+        {
+            backoff <<= 1;
+        }
+
+        if (OSAL_ADAPTIVE_LOCK_FREE == pLock->state &&
+            OSAL_ADAPTIVE_LOCK_FREE ==
+                OSAL_ADAPTIVE_LOCK_CAS(&pLock->state,
+                                       OSAL_ADAPTIVE_LOCK_FREE,
+                                       OSAL_ADAPTIVE_LOCK_LOCKED))
+        {
+            pLock->stats.acquisitions++;
+            pLock->stats.contended++;
+            pLock->stats.spinAcquired++;
+            return OSAL_SUCCESS;
+        }
+    }
+
+    /* Block. Marking the lock contended makes the owner wake us on unlock;
+     * since we cannot tell whether other waiters remain, we keep the lock
+     * marked contended when we eventually take it. */
+    state = OSAL_ADAPTIVE_LOCK_XCHG(&pLock->state,
+                                    OSAL_ADAPTIVE_LOCK_CONTENDED);
+    while (OSAL_ADAPTIVE_LOCK_FREE != state)
+    {
+        osalAdaptiveLockFutexWait(&pLock->state,
+                                  OSAL_ADAPTIVE_LOCK_CONTENDED);
+        sleeps++;
+        state = OSAL_ADAPTIVE_LOCK_XCHG(&pLock->state,
+                                        OSAL_ADAPTIVE_LOCK_CONTENDED);
+    }
+
+    pLock->stats.acquisitions++;
+    pLock->stats.contended++;
+    pLock->stats.sleeps += sleeps;
+#endif
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockTryLock(OsalAdaptiveLock *pLock)
+{
+#ifndef ICP_WITHOUT_THREAD
+    OSAL_LOCAL_ENSURE(
+        pLock, "osalAdaptiveLockTryLock():   Null lock pointer", OSAL_FAIL);
+
+    if (OSAL_ADAPTIVE_LOCK_FREE !=
+        OSAL_ADAPTIVE_LOCK_CAS(&pLock->state,
+                               OSAL_ADAPTIVE_LOCK_FREE,
+                               OSAL_ADAPTIVE_LOCK_LOCKED))
+    {
+        return OSAL_FAIL;
+    }
+    pLock->stats.acquisitions++;
+#endif
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockUnlock(OsalAdaptiveLock *pLock)
+{
+#ifndef ICP_WITHOUT_THREAD
+    OSAL_LOCAL_ENSURE(
+        pLock, "osalAdaptiveLockUnlock():   Null lock pointer", OSAL_FAIL);
+
+    if (OSAL_ADAPTIVE_LOCK_CONTENDED ==
+        OSAL_ADAPTIVE_LOCK_XCHG(&pLock->state, OSAL_ADAPTIVE_LOCK_FREE))
+    {
+        /* The lock is no longer ours, count the wake up atomically */
+        __sync_fetch_and_add(&pLock->stats.wakeups, 1);
+        osalAdaptiveLockFutexWake(&pLock->state);
+    }
+#endif
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockDestroy(OsalAdaptiveLock *pLock)
+{
+    OSAL_LOCAL_ENSURE(
+        pLock, "osalAdaptiveLockDestroy():   Null lock pointer", OSAL_FAIL);
+
+#ifndef ICP_WITHOUT_THREAD
+    if (OSAL_ADAPTIVE_LOCK_FREE != pLock->state)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "osalAdaptiveLockDestroy(): lock is held\n");
+        return OSAL_FAIL;
+    }
+#endif
+    osalMemSet(pLock, 0, sizeof(OsalAdaptiveLock));
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalAdaptiveLockStatsGet(OsalAdaptiveLock *pLock,
+                                                 OsalAdaptiveLockStats *pStats)
+{
+    OSAL_LOCAL_ENSURE(
+        pLock, "osalAdaptiveLockStatsGet():   Null lock pointer", OSAL_FAIL);
+    OSAL_LOCAL_ENSURE(
+        pStats, "osalAdaptiveLockStatsGet():   Null stats pointer", OSAL_FAIL);
+
+    osalMemCopy(pStats, &pLock->stats, sizeof(OsalAdaptiveLockStats));
+    return OSAL_SUCCESS;
+}
@@ -96,6 +96,23 @@ typedef void VOID;           /**< alias for void */
 
 typedef volatile INT64 OsalAtomic;
 
+/* Contention counters of an adaptive lock */
+typedef struct OsalAdaptiveLockStats_s
+{
+    UINT64 acquisitions; /**< times the lock was taken */
+    UINT64 contended;    /**< acquisitions that found the lock held */
+    UINT64 spinAcquired; /**< contended acquisitions won while spinning */
+    UINT64 sleeps;       /**< futex waits performed by the waiters */
+    UINT64 wakeups;      /**< futex wake ups issued on unlock */
+} OsalAdaptiveLockStats;
+
+/* Spin-then-block lock; an all-zero object is a valid unlocked lock */
+typedef struct OsalAdaptiveLock_s
+{
+    volatile INT32 state;
+    OsalAdaptiveLockStats stats;
+} OsalAdaptiveLock;
+
 #define likely(x) __builtin_expect(!!(x), 1)
 #define unlikely(x) __builtin_expect(!!(x), 0)
 